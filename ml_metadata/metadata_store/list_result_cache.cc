@@ -0,0 +1,153 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/list_result_cache.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/message.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "ml_metadata/metadata_store/constants.h"
+
+namespace ml_metadata {
+
+ListResultCache::ScopedWrite::ScopedWrite(ListResultCache* cache,
+                                          std::vector<TypeKind> type_kinds)
+    : cache_(cache), type_kinds_(std::move(type_kinds)) {
+  cache_->IncreaseLocalWriteEpochs(type_kinds_);
+}
+
+ListResultCache::ScopedWrite::ScopedWrite(ScopedWrite&& other)
+    : cache_(other.cache_), type_kinds_(std::move(other.type_kinds_)) {
+  other.cache_ = nullptr;
+}
+
+ListResultCache::ScopedWrite::~ScopedWrite() {
+  if (cache_ != nullptr) cache_->IncreaseLocalWriteEpochs(type_kinds_);
+}
+
+ListResultCache::ScopedWrite ListResultCache::StartWrite(
+    std::vector<TypeKind> type_kinds) {
+  return ScopedWrite(this, std::move(type_kinds));
+}
+
+void ListResultCache::IncreaseLocalWriteEpochs(
+    absl::Span<const TypeKind> type_kinds) {
+  for (const TypeKind type_kind : type_kinds) {
+    local_write_epochs_[static_cast<int>(type_kind)].fetch_add(1);
+  }
+}
+
+ListResultCache::WriteEpochs ListResultCache::local_write_epochs() const {
+  WriteEpochs write_epochs;
+  for (int i = 0; i < write_epochs.size(); ++i) {
+    write_epochs[i] = local_write_epochs_[i].load();
+  }
+  return write_epochs;
+}
+
+bool ListResultCache::Lookup(absl::string_view key,
+                             const WriteEpochs& write_epochs,
+                             google::protobuf::Message* response) {
+  std::shared_ptr<const std::string> serialized_response;
+  {
+    const absl::Time now = absl::Now();
+    absl::MutexLock lock(&mutex_);
+    const auto index_it = index_.find(key);
+    if (index_it != index_.end()) {
+      const EntryList::iterator it = index_it->second;
+      bool is_expired = now - it->insert_time > options_.ttl;
+      bool is_current = true;
+      for (int i = 0; i < write_epochs.size(); ++i) {
+        if (!it->depends_on_kinds[i]) continue;
+        // Epochs only increase, so an entry older than the given epochs can
+        // never be served again.
+        is_expired |= it->write_epochs[i] < write_epochs[i];
+        is_current &= it->write_epochs[i] == write_epochs[i];
+      }
+      if (is_expired) {
+        Erase(it);
+      } else if (is_current) {
+        entries_.splice(entries_.begin(), entries_, it);
+        serialized_response = it->serialized_response;
+      }
+    }
+  }
+  // Parses outside of the lock, as responses may be large.
+  if (serialized_response == nullptr ||
+      !response->ParseFromString(*serialized_response)) {
+    num_misses_.fetch_add(1);
+    return false;
+  }
+  num_hits_.fetch_add(1);
+  return true;
+}
+
+void ListResultCache::Insert(absl::string_view key,
+                             const WriteEpochs& write_epochs,
+                             absl::Span<const TypeKind> type_kinds,
+                             const google::protobuf::Message& response) {
+  auto serialized_response = std::make_shared<std::string>();
+  if (!response.SerializeToString(serialized_response.get())) return;
+  const int64_t entry_bytes = key.size() + serialized_response->size();
+  if (entry_bytes > options_.max_num_bytes || options_.max_num_entries <= 0) {
+    return;
+  }
+  Entry entry{std::string(key), std::move(serialized_response), write_epochs,
+              /*depends_on_kinds=*/{}, absl::Now()};
+  for (const TypeKind type_kind : type_kinds) {
+    entry.depends_on_kinds[static_cast<int>(type_kind)] = true;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  const auto index_it = index_.find(key);
+  if (index_it != index_.end()) {
+    Erase(index_it->second);
+  }
+  while (!entries_.empty() &&
+         (entries_.size() >= options_.max_num_entries ||
+          num_bytes_ + entry_bytes > options_.max_num_bytes)) {
+    Erase(std::prev(entries_.end()));
+  }
+  entries_.push_front(std::move(entry));
+  index_.insert({entries_.front().key, entries_.begin()});
+  num_bytes_ += entry_bytes;
+}
+
+int ListResultCache::num_entries() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+int64_t ListResultCache::num_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return num_bytes_;
+}
+
+void ListResultCache::Erase(EntryList::iterator it) {
+  num_bytes_ -= it->key.size() + it->serialized_response->size();
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+}  // namespace ml_metadata
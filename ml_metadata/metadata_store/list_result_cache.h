@@ -0,0 +1,167 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_LIST_RESULT_CACHE_H_
+#define ML_METADATA_METADATA_STORE_LIST_RESULT_CACHE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/message.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "ml_metadata/metadata_store/constants.h"
+
+namespace ml_metadata {
+
+// Caches the serialized responses of list requests, e.g., GetArtifacts, so
+// that identical requests do not rerun their queries. It is thread-safe.
+//
+// An entry is valid as long as the write epochs of the node kinds it depends
+// on are unchanged. The epochs are either the local ones, which the server
+// increases around each of its writes with StartWrite, or the ones stored in
+// the database, which every writer increases on commit. Entries are also
+// dropped once older than the ttl, or when the cache is full, least recently
+// used first.
+//
+// Usage example:
+//
+//   ListResultCache cache;
+//   {
+//     ListResultCache::ScopedWrite write =
+//         cache.StartWrite({TypeKind::ARTIFACT_TYPE});
+//     // write artifacts.
+//   }
+//   const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+//   GetArtifactsResponse response;
+//   if (!cache.Lookup(key, epochs, &response)) {
+//     // read artifacts into `response`.
+//     cache.Insert(key, epochs, {TypeKind::ARTIFACT_TYPE}, response);
+//   }
+class ListResultCache {
+ public:
+  struct Options {
+    // The maximum number of cached responses.
+    int max_num_entries = 1000;
+    // The maximum total size of the cached keys and responses.
+    int64_t max_num_bytes = 64 << 20;
+    // Responses cached longer ago than the ttl are not served.
+    absl::Duration ttl = absl::Seconds(30);
+    // If true, entries are validated against the write epochs stored in the
+    // database, which also account for the writes of other servers and
+    // clients. Otherwise only the writes of this server are accounted for.
+    bool use_database_write_epochs = false;
+  };
+
+  // The write epochs of the node kinds, indexed by TypeKind.
+  using WriteEpochs = std::array<int64_t, 3>;
+
+  // Marks a write of some node kinds as in-flight until it is destroyed. The
+  // local write epochs of the kinds increase both when the write starts and
+  // when it ends, so responses read while it was in-flight are never served
+  // after it ends.
+  class ScopedWrite {
+   public:
+    // Creates a write that is not tracked.
+    ScopedWrite() : cache_(nullptr) {}
+    ScopedWrite(ScopedWrite&& other);
+    ~ScopedWrite();
+
+    ScopedWrite(const ScopedWrite&) = delete;
+    ScopedWrite& operator=(const ScopedWrite&) = delete;
+    ScopedWrite& operator=(ScopedWrite&&) = delete;
+
+   private:
+    friend class ListResultCache;
+    ScopedWrite(ListResultCache* cache, std::vector<TypeKind> type_kinds);
+
+    ListResultCache* cache_;
+    std::vector<TypeKind> type_kinds_;
+  };
+
+  ListResultCache() : ListResultCache(Options()) {}
+  explicit ListResultCache(const Options& options) : options_(options) {}
+
+  // Disallows copy.
+  ListResultCache(const ListResultCache&) = delete;
+  ListResultCache& operator=(const ListResultCache&) = delete;
+
+  const Options& options() const { return options_; }
+
+  // Registers a write of the node kinds `type_kinds` as in-flight.
+  ScopedWrite StartWrite(std::vector<TypeKind> type_kinds);
+
+  // Returns the local write epochs.
+  WriteEpochs local_write_epochs() const;
+
+  // Parses the response cached for `key` into `response`, if the node kinds it
+  // depends on are at the same write epochs as in `write_epochs`, and it has
+  // not expired. Returns whether the response was found.
+  bool Lookup(absl::string_view key, const WriteEpochs& write_epochs,
+              google::protobuf::Message* response);
+
+  // Caches `response` for `key`. `write_epochs` are the epochs read before
+  // the response was computed, and `type_kinds` are the node kinds the
+  // response depends on. Responses larger than the cache are not cached.
+  void Insert(absl::string_view key, const WriteEpochs& write_epochs,
+              absl::Span<const TypeKind> type_kinds,
+              const google::protobuf::Message& response);
+
+  int64_t num_hits() const { return num_hits_.load(); }
+  int64_t num_misses() const { return num_misses_.load(); }
+  int num_entries() const;
+  int64_t num_bytes() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const std::string> serialized_response;
+    WriteEpochs write_epochs;
+    // Whether the entry depends on the node kind, indexed by TypeKind.
+    std::array<bool, 3> depends_on_kinds;
+    absl::Time insert_time;
+  };
+  using EntryList = std::list<Entry>;
+
+  void IncreaseLocalWriteEpochs(absl::Span<const TypeKind> type_kinds);
+
+  // Drops `it` from the cache.
+  void Erase(EntryList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+
+  std::array<std::atomic<int64_t>, 3> local_write_epochs_{};
+  std::atomic<int64_t> num_hits_{0};
+  std::atomic<int64_t> num_misses_{0};
+
+  mutable absl::Mutex mutex_;
+  // Ordered by the last use, most recently used first.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, EntryList::iterator> index_
+      ABSL_GUARDED_BY(mutex_);
+  int64_t num_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_LIST_RESULT_CACHE_H_
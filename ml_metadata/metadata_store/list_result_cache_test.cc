@@ -0,0 +1,141 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/list_result_cache.h"
+
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/constants.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+GetArtifactsResponse ResponseWithUri(const std::string& uri) {
+  GetArtifactsResponse response;
+  response.add_artifacts()->set_uri(uri);
+  return response;
+}
+
+TEST(ListResultCacheTest, ServesResponsesAtTheSameWriteEpochs) {
+  ListResultCache cache;
+  const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+  GetArtifactsResponse response;
+  EXPECT_FALSE(cache.Lookup("key", epochs, &response));
+  cache.Insert("key", epochs, {TypeKind::ARTIFACT_TYPE}, ResponseWithUri("a"));
+
+  ASSERT_TRUE(cache.Lookup("key", epochs, &response));
+  EXPECT_EQ(response.artifacts(0).uri(), "a");
+  EXPECT_FALSE(cache.Lookup("other_key", epochs, &response));
+  EXPECT_EQ(cache.num_hits(), 1);
+  EXPECT_EQ(cache.num_misses(), 2);
+  EXPECT_EQ(cache.num_entries(), 1);
+}
+
+TEST(ListResultCacheTest, WritesInvalidateDependentEntries) {
+  ListResultCache cache;
+  const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+  cache.Insert("artifacts", epochs, {TypeKind::ARTIFACT_TYPE},
+               ResponseWithUri("a"));
+  cache.Insert("executions", epochs, {TypeKind::EXECUTION_TYPE},
+               ResponseWithUri("e"));
+  {
+    ListResultCache::ScopedWrite write =
+        cache.StartWrite({TypeKind::EXECUTION_TYPE});
+  }
+
+  GetArtifactsResponse response;
+  EXPECT_TRUE(cache.Lookup("artifacts", cache.local_write_epochs(), &response));
+  EXPECT_FALSE(
+      cache.Lookup("executions", cache.local_write_epochs(), &response));
+  // Stale entries are dropped.
+  EXPECT_EQ(cache.num_entries(), 1);
+}
+
+TEST(ListResultCacheTest, ResponsesReadDuringWritesAreNotServedAfterwards) {
+  ListResultCache cache;
+  ListResultCache::WriteEpochs epochs;
+  {
+    ListResultCache::ScopedWrite write =
+        cache.StartWrite({TypeKind::ARTIFACT_TYPE});
+    ListResultCache::ScopedWrite moved = std::move(write);
+    epochs = cache.local_write_epochs();
+    cache.Insert("key", epochs, {TypeKind::ARTIFACT_TYPE},
+                 ResponseWithUri("a"));
+  }
+  GetArtifactsResponse response;
+  EXPECT_FALSE(cache.Lookup("key", cache.local_write_epochs(), &response));
+  // The moved write ends once.
+  const int artifact_kind = static_cast<int>(TypeKind::ARTIFACT_TYPE);
+  EXPECT_EQ(cache.local_write_epochs()[artifact_kind],
+            epochs[artifact_kind] + 1);
+}
+
+TEST(ListResultCacheTest, EvictsLeastRecentlyUsedEntries) {
+  ListResultCache::Options options;
+  options.max_num_entries = 2;
+  ListResultCache cache(options);
+  const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+  GetArtifactsResponse response;
+  cache.Insert("a", epochs, {TypeKind::ARTIFACT_TYPE}, ResponseWithUri("a"));
+  cache.Insert("b", epochs, {TypeKind::ARTIFACT_TYPE}, ResponseWithUri("b"));
+  ASSERT_TRUE(cache.Lookup("a", epochs, &response));
+  cache.Insert("c", epochs, {TypeKind::ARTIFACT_TYPE}, ResponseWithUri("c"));
+
+  EXPECT_EQ(cache.num_entries(), 2);
+  EXPECT_TRUE(cache.Lookup("a", epochs, &response));
+  EXPECT_FALSE(cache.Lookup("b", epochs, &response));
+  EXPECT_TRUE(cache.Lookup("c", epochs, &response));
+}
+
+TEST(ListResultCacheTest, RespectsByteLimit) {
+  ListResultCache::Options options;
+  options.max_num_bytes = 100;
+  ListResultCache cache(options);
+  const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+  GetArtifactsResponse response;
+  cache.Insert("large", epochs, {TypeKind::ARTIFACT_TYPE},
+               ResponseWithUri(std::string(200, 'x')));
+  EXPECT_EQ(cache.num_entries(), 0);
+
+  cache.Insert("a", epochs, {TypeKind::ARTIFACT_TYPE},
+               ResponseWithUri(std::string(40, 'a')));
+  cache.Insert("b", epochs, {TypeKind::ARTIFACT_TYPE},
+               ResponseWithUri(std::string(40, 'b')));
+  cache.Insert("c", epochs, {TypeKind::ARTIFACT_TYPE},
+               ResponseWithUri(std::string(40, 'c')));
+  EXPECT_LE(cache.num_bytes(), 100);
+  EXPECT_FALSE(cache.Lookup("a", epochs, &response));
+  EXPECT_TRUE(cache.Lookup("c", epochs, &response));
+}
+
+TEST(ListResultCacheTest, ExpiresEntriesAfterTtl) {
+  ListResultCache::Options options;
+  options.ttl = absl::Milliseconds(1);
+  ListResultCache cache(options);
+  const ListResultCache::WriteEpochs epochs = cache.local_write_epochs();
+  cache.Insert("key", epochs, {TypeKind::ARTIFACT_TYPE}, ResponseWithUri("a"));
+  absl::SleepFor(absl::Milliseconds(5));
+  GetArtifactsResponse response;
+  EXPECT_FALSE(cache.Lookup("key", epochs, &response));
+  EXPECT_EQ(cache.num_entries(), 0);
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -253,6 +253,65 @@ class MetadataAccessObject {
       absl::Span<const int64_t> type_ids,
       absl::flat_hash_map<int64_t, ContextType>& output_parent_types) = 0;
 
+  // Gets the current type catalog version. The version increases whenever a
+  // type is created, a property is added to a type, or a type's external_id or
+  // parent type is changed.
+  // Returns FAILED_PRECONDITION error, if the schema has no type catalog.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindTypeCatalogVersion(int64_t* catalog_version) = 0;
+
+  // Gets the types created or changed after the type catalog version
+  // `catalog_version`, and returns them in `artifact_types`, `execution_types`
+  // and `context_types` respectively. Like the Get*Types APIs, the simple
+  // types are left out.
+  // Returns INVALID_ARGUMENT error, if any of the output vectors is not empty.
+  // Returns FAILED_PRECONDITION error, if the schema has no type catalog.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindTypesChangedAfterCatalogVersion(
+      int64_t catalog_version, std::vector<ArtifactType>* artifact_types,
+      std::vector<ExecutionType>* execution_types,
+      std::vector<ContextType>* context_types) = 0;
+
+  // Increases the write epochs of the node kinds `type_kinds`. Callers
+  // increase the epochs of the node kinds they change before the transaction
+  // commits, so that readers can tell whether results they computed earlier
+  // are stale.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status IncreaseWriteEpochs(
+      absl::Span<const TypeKind> type_kinds) = 0;
+
+  // Gets the write epochs of artifacts, executions and contexts.
+  // Returns FAILED_PRECONDITION error, if the schema has no write epochs.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindWriteEpochs(int64_t* artifact_write_epoch,
+                                       int64_t* execution_write_epoch,
+                                       int64_t* context_write_epoch) = 0;
+
+  // Gets the summaries of the contexts with `context_ids`, one for each id and
+  // in the same order. The ids must be distinct. A summary counts the
+  // executions associated and the artifacts attributed to its context by type
+  // and state. If maintained, see set_maintain_context_summaries(), the
+  // summaries are updated as associations and attributions are created and as
+  // execution and artifact states change.
+  // Returns FAILED_PRECONDITION error, if the schema has no context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindContextSummaries(
+      absl::Span<const int64_t> context_ids,
+      std::vector<ContextSummary>* context_summaries) = 0;
+
+  // Recomputes the summaries of the contexts with `context_ids` from their
+  // associations and attributions. If `context_ids` is empty, recomputes the
+  // summaries of all contexts.
+  // Returns FAILED_PRECONDITION error, if the schema has no context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status RebuildContextSummaries(
+      absl::Span<const int64_t> context_ids) = 0;
+
+  // If `maintain` is true, the writes of associations, attributions and node
+  // states update the context summaries. Otherwise the summaries are left as
+  // they are until RebuildContextSummaries.
+  virtual void set_maintain_context_summaries(bool maintain) = 0;
+
   // Creates an artifact, returns the assigned artifact id. The id field of the
   // artifact is ignored.
   // `skip_type_and_property_validation` is set to be true if the `artifact`'s
@@ -321,6 +380,14 @@ class MetadataAccessObject {
       absl::Span<const int64_t> artifact_ids, std::vector<Artifact>& artifacts,
       std::vector<ArtifactType>& artifact_types) = 0;
 
+  // Gets the last_update_time_since_epoch of the artifacts with
+  // `artifact_ids` keyed by artifact id, without reading the properties.
+  // Not found ids are skipped.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindArtifactLastUpdateTimesById(
+      absl::Span<const int64_t> artifact_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) = 0;
+
   // Gets Artifacts matching the given 'external_ids'.
   // |external_ids| is a list of non-null strings for the given external ids.
   // Returns whatever found when a part of |external_ids| is non-existing.
@@ -395,6 +462,14 @@ class MetadataAccessObject {
   virtual absl::Status FindArtifactByTypeIdAndArtifactName(
       int64_t artifact_type_id, absl::string_view name, Artifact* artifact) = 0;
 
+  // Gets the artifacts of the given type_id with any of the given `names`.
+  // Returns whatever found when a part of `names` is non-existing.
+  // Returns NOT_FOUND error, if none of the names can be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindArtifactsByTypeIdAndArtifactNames(
+      int64_t artifact_type_id, absl::Span<absl::string_view> names,
+      std::vector<Artifact>* artifacts) = 0;
+
   // Gets artifacts by a given type_id.
   // Returns NOT_FOUND error, if the given artifact_type_id cannot be found.
   // Returns detailed INTERNAL error, if query execution fails.
@@ -409,6 +484,14 @@ class MetadataAccessObject {
   virtual absl::Status FindArtifactsByURI(absl::string_view uri,
                                           std::vector<Artifact>* artifacts) = 0;
 
+  // Gets the artifacts with any of the given `uris` with exact match, in a
+  // single query.
+  // Returns whatever found when a part of `uris` is non-existing.
+  // Returns NOT_FOUND error, if none of the uris can be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindArtifactsByURIs(
+      absl::Span<absl::string_view> uris, std::vector<Artifact>* artifacts) = 0;
+
   // Updates an artifact.
   // The `last_update_time_since_epoch` field is determined under the hood
   //  and set to absl::Now().
@@ -474,6 +557,20 @@ class MetadataAccessObject {
       const Artifact& artifact, absl::Time update_timestamp,
       bool force_update_time, const google::protobuf::FieldMask& mask) = 0;
 
+  // Updates an artifact under masking if the stored artifact satisfies
+  // `precondition`. The precondition is checked by the update statement
+  // itself, so no other writer can change the artifact in between.
+  // If `precondition` is not empty, the artifact is always updated and its
+  // `last_update_time_since_epoch` is set to the later of `update_timestamp`
+  // and 1ms after the stored one.
+  // Returns FAILED_PRECONDITION error, if the stored artifact does not satisfy
+  // `precondition`.
+  // Returns the same errors as the overload above otherwise.
+  virtual absl::Status UpdateArtifact(
+      const Artifact& artifact, absl::Time update_timestamp,
+      const google::protobuf::FieldMask& mask,
+      const UpdatePrecondition& precondition) = 0;
+
   // Creates an execution, returns the assigned execution id. The id field of
   // the execution is ignored.
   // `skip_type_and_property_validation` is set to be true if the `execution`'s
@@ -536,6 +633,14 @@ class MetadataAccessObject {
       absl::Span<const int64_t> execution_ids,
       std::vector<Execution>* executions) = 0;
 
+  // Gets the last_update_time_since_epoch of the executions with
+  // `execution_ids` keyed by execution id, without reading the properties.
+  // Not found ids are skipped.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindExecutionLastUpdateTimesById(
+      absl::Span<const int64_t> execution_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) = 0;
+
   // Gets executions matching the given 'external_ids'.
   // |external_ids| is a list of non-null strings for the given external ids.
   // Returns whatever found when a part of |external_ids| is non-existing.
@@ -557,6 +662,14 @@ class MetadataAccessObject {
       int64_t execution_type_id, absl::string_view name,
       Execution* execution) = 0;
 
+  // Gets the executions of the given type_id with any of the given `names`.
+  // Returns whatever found when a part of `names` is non-existing.
+  // Returns NOT_FOUND error, if none of the names can be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindExecutionsByTypeIdAndExecutionNames(
+      int64_t execution_type_id, absl::Span<absl::string_view> names,
+      std::vector<Execution>* executions) = 0;
+
   // Gets executions by a given type_id.
   // Returns NOT_FOUND error, if the given execution_type_id cannot be found.
   // Returns detailed INTERNAL error, if query execution fails.
@@ -633,6 +746,20 @@ class MetadataAccessObject {
       const Execution& execution, absl::Time update_timestamp,
       bool force_update_time, const google::protobuf::FieldMask& mask) = 0;
 
+  // Updates an execution under masking if the stored execution satisfies
+  // `precondition`. The precondition is checked by the update statement
+  // itself, so no other writer can change the execution in between.
+  // If `precondition` is not empty, the execution is always updated and its
+  // `last_update_time_since_epoch` is set to the later of `update_timestamp`
+  // and 1ms after the stored one.
+  // Returns FAILED_PRECONDITION error, if the stored execution does not satisfy
+  // `precondition`.
+  // Returns the same errors as the overload above otherwise.
+  virtual absl::Status UpdateExecution(
+      const Execution& execution, absl::Time update_timestamp,
+      const google::protobuf::FieldMask& mask,
+      const UpdatePrecondition& precondition) = 0;
+
   // Creates a context, returns the assigned context id. The id field of the
   // context is ignored. The name field of the context must not be empty and it
   // should be unique in the same ContextType.
@@ -696,6 +823,14 @@ class MetadataAccessObject {
   virtual absl::Status FindContextsById(absl::Span<const int64_t> context_ids,
                                         std::vector<Context>* context) = 0;
 
+  // Gets the last_update_time_since_epoch of the contexts with `context_ids`
+  // keyed by context id, without reading the properties.
+  // Not found ids are skipped.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindContextLastUpdateTimesById(
+      absl::Span<const int64_t> context_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) = 0;
+
   // Gets contexts matching a collection of external_ids.
   // |external_ids| is a list of non-null strings for the given external ids.
   // Returns whatever found when a part of |external_ids| is non-existing.
@@ -726,6 +861,14 @@ class MetadataAccessObject {
                                                          bool id_only,
                                                          Context* context) = 0;
 
+  // Gets the contexts of the given type_id with any of the given `names`.
+  // Returns whatever found when a part of `names` is non-existing.
+  // Returns NOT_FOUND error, if none of the names can be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status FindContextsByTypeIdAndContextNames(
+      int64_t context_type_id, absl::Span<absl::string_view> names,
+      std::vector<Context>* contexts) = 0;
+
   // Updates a context.
   // The `last_update_time_since_epoch` field is determined under the hood
   //  and set to absl::Now().
@@ -791,6 +934,68 @@ class MetadataAccessObject {
       const Context& context, absl::Time update_timestamp,
       bool force_update_time, const google::protobuf::FieldMask& mask) = 0;
 
+  // Sets the `properties` and `custom_properties` of the nodes with the given
+  // ids, without reading and diffing their stored properties. A property that
+  // exists is replaced. The nodes' last_update_time_since_epoch is set to
+  // `update_timestamp`.
+  // Returns INVALID_ARGUMENT error, if any node cannot be found.
+  // Returns INVALID_ARGUMENT error, if `properties` do not align with the
+  // nodes' types.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status SetArtifactProperties(
+      absl::Span<const int64_t> artifact_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) = 0;
+  virtual absl::Status SetExecutionProperties(
+      absl::Span<const int64_t> execution_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) = 0;
+  virtual absl::Status SetContextProperties(
+      absl::Span<const int64_t> context_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) = 0;
+
+  // Deletes the properties with `property_names` and the custom properties with
+  // `custom_property_names` of the nodes with the given ids, without reading
+  // their stored properties. The nodes' last_update_time_since_epoch is set to
+  // `update_timestamp`.
+  // Returns INVALID_ARGUMENT error, if any node cannot be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status DeleteArtifactProperties(
+      absl::Span<const int64_t> artifact_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) = 0;
+  virtual absl::Status DeleteExecutionProperties(
+      absl::Span<const int64_t> execution_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) = 0;
+  virtual absl::Status DeleteContextProperties(
+      absl::Span<const int64_t> context_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) = 0;
+
+  // Claims up to `max_num_executions` executions of the execution type with
+  // `type_name` and `type_version` whose last_known_state is `current_state`.
+  // The claimed executions are set to `new_state`, get `lease_properties` as
+  // custom properties and have their last_update_time_since_epoch set to
+  // `update_timestamp`. They are returned in `executions` ordered by id.
+  // Executions locked by concurrent claims are skipped where the metadata
+  // source supports row locks; otherwise the claims are serialized.
+  // Returns NOT_FOUND error, if the execution type cannot be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status ClaimExecutions(
+      absl::string_view type_name, std::optional<absl::string_view> type_version,
+      Execution::State current_state, Execution::State new_state,
+      int64_t max_num_executions,
+      const google::protobuf::Map<std::string, Value>& lease_properties,
+      absl::Time update_timestamp, std::vector<Execution>* executions) = 0;
+
   // Creates an event, and returns the assigned event id. Please refer to the
   // docstring for CreateEvent() with the `is_already_validated` flag for more
   // details. This method assumes the event has not been validated yet and sets
@@ -1006,23 +1211,42 @@ class MetadataAccessObject {
   //   away from the starting nodes.
   // b) `direction`: it performs either a single-directional graph traversal or
   //   bidirectional graph traversal based on `direction`.
+  // c) `max_nodes`: it stops adding nodes once the budget is used up, keeping
+  //   the most recently created nodes of the last hop.
   // `read_mask` contains user specified paths of fields that should be included
   // in the output `subgraph`.
   //   If 'artifacts', 'executions', or 'contexts' is specified in `read_mask`,
   //     the dehydrated nodes will be included.
   //   If 'artifact_types', 'execution_types', or 'context_types' is specified
-  //     in `read_mask`, all the node types will be included.
+  //     in `read_mask`, all the node types will be included, or only the
+  //     types changed after `known_type_catalog_version` if it is set.
   //   If 'events', 'associations', or 'attributions' is specified in
   //     `read_mask`, the corresponding edges will be included.
+  // If `is_truncated` is not null, sets it to whether `max_nodes` left out
+  // reachable nodes.
   // Returns INVALID_ARGUMENT error, if no paths are specified in `read_mask`.
   // Returns INVALID_ARGUMENT error, if `starting_nodes` is not specified in
   // `lineage_subgraph_query_options`.
   // Returns INVALID_ARGUMENT error, if `starting_nodes.filter_query` is
   // unspecified or invalid in `lineage_subgraph_query_options`.
+  // Returns FAILED_PRECONDITION error, if `known_type_catalog_version` is set
+  // and the schema has no type catalog.
   // Returns detailed INTERNAL error, if the operation fails.
   virtual absl::Status QueryLineageSubgraph(
       const LineageSubgraphQueryOptions& options,
-      const google::protobuf::FieldMask& read_mask, LineageGraph& subgraph) = 0;
+      const google::protobuf::FieldMask& read_mask,
+      std::optional<int64_t> known_type_catalog_version,
+      LineageGraph& subgraph, bool* is_truncated) = 0;
+
+  // Same as above, with all the node types, and without reporting whether the
+  // subgraph was truncated.
+  absl::Status QueryLineageSubgraph(
+      const LineageSubgraphQueryOptions& options,
+      const google::protobuf::FieldMask& read_mask, LineageGraph& subgraph) {
+    return QueryLineageSubgraph(options, read_mask,
+                                /*known_type_catalog_version=*/absl::nullopt,
+                                subgraph, /*is_truncated=*/nullptr);
+  }
 
 
   // Deletes a list of artifacts by id.
@@ -58,7 +58,7 @@ TEST(MetadataAccessObjectFactory, CreateMetadataAccessObjectAtSchemaVersion9) {
   // Create MetadataAccessObject with default schema_version = library_version,
   // then downgrade the source to 9. Then create an instance of
   // MetadataAccessObject with that query_version.
-  constexpr int64_t kLibSchemaVersion = 10;
+  constexpr int64_t kLibSchemaVersion = 14;
   const int64_t earlier_schema_version = 9;
   SqliteMetadataSourceConfig config;
   std::unique_ptr<MetadataSource> metadata_source =
@@ -99,7 +99,7 @@ TEST(MetadataAccessObjectFactory, CreateMetadataAccessObjectAtSchemaVersion8) {
   // Create MetadataAccessObject with default schema_version = library_version,
   // then downgrade the source to 8. Then create an instance of
   // MetadataAccessObject with that query_version.
-  constexpr int64_t kLibSchemaVersion = 10;
+  constexpr int64_t kLibSchemaVersion = 14;
   const int64_t earlier_schema_version = 8;
   SqliteMetadataSourceConfig config;
   std::unique_ptr<MetadataSource> metadata_source =
@@ -140,7 +140,7 @@ TEST(MetadataAccessObjectFactory, CreateMetadataAccessObjectAtSchemaVersion7) {
   // Create MetadataAccessObject with default schema_version = library_version,
   // then downgrade the source to 7. Then create an instance of
   // MetadataAccessObject with that query_version.
-  constexpr int64_t kLibSchemaVersion = 10;
+  constexpr int64_t kLibSchemaVersion = 14;
   const int64_t earlier_schema_version = 7;
   SqliteMetadataSourceConfig config;
   std::unique_ptr<MetadataSource> metadata_source =
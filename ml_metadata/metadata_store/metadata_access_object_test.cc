@@ -4599,6 +4599,20 @@ TEST_P(MetadataAccessObjectTest, ListNodesFilterWithErrors) {
         << " status is: " << status.code()
         << " status Error is:" << status.message();
   }
+  // testing unknown enum value, which is rejected by the native parser
+  {
+    list_options = ParseTextProtoOrDie<ListOperationOptions>(R"pb(
+      max_result_size: 10,
+      order_by_field: { field: CREATE_TIME is_asc: false }
+      filter_query: "last_known_state = FOO"
+    )pb");
+    std::vector<Execution> got_executions;
+    const absl::Status status = metadata_access_object_->ListExecutions(
+        list_options, &got_executions, &next_page_token);
+    EXPECT_TRUE(absl::IsInvalidArgument(status))
+        << " status is: " << status.code()
+        << " status Error is:" << status.message();
+  }
 }
 
 // Apply the list options to list the `Node`, and compare with the `want_nodes`
@@ -5781,6 +5795,274 @@ TEST_P(MetadataAccessObjectTest, QueryLineageSubgraphFromFilteredExecutions) {
       /*events=*/{want_events[0], want_events[2]});
 }
 
+TEST_P(MetadataAccessObjectTest,
+       QueryLineageSubgraphWithTimeWindowsAndExecutionStates) {
+  ASSERT_EQ(Init(), absl::OkStatus());
+  // Test setup: a0 is consumed by three executions at different times, each
+  // of which outputs an artifact at the time it consumes a0.
+  // a0 -> e0(COMPLETE, t=1000) -> a1
+  //   \-> e1(FAILED, t=5000)  -> a2
+  //   \-> e2(COMPLETE, t=9000) -> a3
+  const ArtifactType artifact_type = CreateTypeFromTextProto<ArtifactType>(
+      "name: 'artifact_type'", *metadata_access_object_,
+      metadata_access_object_container_.get());
+  const ExecutionType execution_type = CreateTypeFromTextProto<ExecutionType>(
+      "name: 'execution_type'", *metadata_access_object_,
+      metadata_access_object_container_.get());
+  std::vector<Artifact> want_artifacts(4);
+  std::vector<Execution> want_executions(3);
+  for (int i = 0; i < 4; i++) {
+    CreateNodeFromTextProto(absl::Substitute("uri: 'uri_$0'", i),
+                            artifact_type.id(), *metadata_access_object_,
+                            metadata_access_object_container_.get(),
+                            want_artifacts[i]);
+  }
+  const std::vector<std::string> execution_states = {"COMPLETE", "FAILED",
+                                                     "COMPLETE"};
+  for (int i = 0; i < 3; i++) {
+    CreateNodeFromTextProto(
+        absl::StrCat("last_known_state: ", execution_states[i]),
+        execution_type.id(), *metadata_access_object_,
+        metadata_access_object_container_.get(), want_executions[i]);
+  }
+  std::vector<Event> want_events(6);
+  for (int i = 0; i < 3; i++) {
+    const int64_t event_time = 1000 + 4000 * i;
+    CreateEventFromTextProto(
+        absl::StrCat("type: INPUT milliseconds_since_epoch: ", event_time),
+        want_artifacts[0], want_executions[i], *metadata_access_object_,
+        metadata_access_object_container_.get(), want_events[2 * i]);
+    CreateEventFromTextProto(
+        absl::StrCat("type: OUTPUT milliseconds_since_epoch: ", event_time),
+        want_artifacts[i + 1], want_executions[i], *metadata_access_object_,
+        metadata_access_object_container_.get(), want_events[2 * i + 1]);
+  }
+  ASSERT_EQ(AddCommitPointIfNeeded(), absl::OkStatus());
+
+  const google::protobuf::FieldMask read_mask =
+      ParseTextProtoOrDie<google::protobuf::FieldMask>(
+          R"pb(
+            paths: "artifacts" paths: "executions" paths: "events"
+          )pb");
+  LineageSubgraphQueryOptions base_options;
+  base_options.mutable_starting_artifacts()->set_filter_query(
+      absl::Substitute("id = $0", want_artifacts[0].id()));
+  base_options.set_max_num_hops(2);
+  base_options.set_direction(LineageSubgraphQueryOptions::DOWNSTREAM);
+
+  {
+    // Only follows the events since t=5000.
+    LineageSubgraphQueryOptions options = base_options;
+    options.mutable_event_time_window()->set_start_time_since_epoch(5000);
+    LineageGraph output_subgraph;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                            output_subgraph),
+              absl::OkStatus());
+    VerifyLineageGraphSkeleton(
+        output_subgraph,
+        {want_artifacts[0].id(), want_artifacts[2].id(),
+         want_artifacts[3].id()},
+        {want_executions[1].id(), want_executions[2].id()},
+        {want_events[2], want_events[3], want_events[4], want_events[5]});
+  }
+  {
+    // Only follows the events before t=5000.
+    LineageSubgraphQueryOptions options = base_options;
+    options.mutable_event_time_window()->set_end_time_since_epoch(5000);
+    LineageGraph output_subgraph;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                            output_subgraph),
+              absl::OkStatus());
+    VerifyLineageGraphSkeleton(
+        output_subgraph, {want_artifacts[0].id(), want_artifacts[1].id()},
+        {want_executions[0].id()}, {want_events[0], want_events[1]});
+  }
+  {
+    // Only follows the COMPLETE executions.
+    LineageSubgraphQueryOptions options = base_options;
+    options.add_execution_states(Execution::COMPLETE);
+    LineageGraph output_subgraph;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                            output_subgraph),
+              absl::OkStatus());
+    VerifyLineageGraphSkeleton(
+        output_subgraph,
+        {want_artifacts[0].id(), want_artifacts[1].id(),
+         want_artifacts[3].id()},
+        {want_executions[0].id(), want_executions[2].id()},
+        {want_events[0], want_events[1], want_events[4], want_events[5]});
+  }
+  {
+    // Combines the predicates.
+    LineageSubgraphQueryOptions options = base_options;
+    options.mutable_event_time_window()->set_start_time_since_epoch(5000);
+    options.add_execution_states(Execution::COMPLETE);
+    LineageGraph output_subgraph;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                            output_subgraph),
+              absl::OkStatus());
+    VerifyLineageGraphSkeleton(
+        output_subgraph, {want_artifacts[0].id(), want_artifacts[3].id()},
+        {want_executions[2].id()}, {want_events[4], want_events[5]});
+  }
+  {
+    // No node was created before t=1, so only the starting node is returned.
+    LineageSubgraphQueryOptions options = base_options;
+    options.mutable_node_create_time_window()->set_end_time_since_epoch(1);
+    LineageGraph output_subgraph;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                            output_subgraph),
+              absl::OkStatus());
+    VerifyLineageGraphSkeleton(output_subgraph, {want_artifacts[0].id()},
+                               /*expected_execution_ids=*/{}, /*events=*/{});
+  }
+  {
+    // An empty time window is rejected.
+    LineageSubgraphQueryOptions options = base_options;
+    options.mutable_event_time_window()->set_start_time_since_epoch(5000);
+    options.mutable_event_time_window()->set_end_time_since_epoch(5000);
+    LineageGraph output_subgraph;
+    EXPECT_TRUE(absl::IsInvalidArgument(
+        metadata_access_object_->QueryLineageSubgraph(options, read_mask,
+                                                      output_subgraph)));
+  }
+}
+
+TEST_P(MetadataAccessObjectTest, QueryLineageSubgraphWithMaxNodes) {
+  ASSERT_EQ(Init(), absl::OkStatus());
+  // Test setup: a0 is consumed by four executions created at different times,
+  // each of which outputs an artifact.
+  // a0 -> e0(t=3000) -> a1
+  //   \-> e1(t=1000) -> a2
+  //   \-> e2(t=2000) -> a3
+  //   \-> e3(t=2000) -> a4
+  const ArtifactType artifact_type = CreateTypeFromTextProto<ArtifactType>(
+      "name: 'artifact_type'", *metadata_access_object_,
+      metadata_access_object_container_.get());
+  const ExecutionType execution_type = CreateTypeFromTextProto<ExecutionType>(
+      "name: 'execution_type'", *metadata_access_object_,
+      metadata_access_object_container_.get());
+  std::vector<Artifact> want_artifacts(5);
+  for (int i = 0; i < 5; i++) {
+    CreateNodeFromTextProto(absl::Substitute("uri: 'uri_$0'", i),
+                            artifact_type.id(), *metadata_access_object_,
+                            metadata_access_object_container_.get(),
+                            want_artifacts[i]);
+  }
+  const std::vector<int64_t> execution_create_times = {3000, 1000, 2000, 2000};
+  std::vector<Execution> want_executions(4);
+  for (int i = 0; i < 4; i++) {
+    want_executions[i].set_type_id(execution_type.id());
+    int64_t execution_id;
+    ASSERT_EQ(metadata_access_object_->CreateExecution(
+                  want_executions[i],
+                  /*skip_type_and_property_validation=*/false,
+                  absl::FromUnixMillis(execution_create_times[i]),
+                  &execution_id),
+              absl::OkStatus());
+    want_executions[i].set_id(execution_id);
+    ASSERT_EQ(AddCommitPointIfNeeded(), absl::OkStatus());
+  }
+  std::vector<Event> want_events(8);
+  for (int i = 0; i < 4; i++) {
+    CreateEventFromTextProto("type: INPUT", want_artifacts[0],
+                             want_executions[i], *metadata_access_object_,
+                             metadata_access_object_container_.get(),
+                             want_events[2 * i]);
+    CreateEventFromTextProto("type: OUTPUT", want_artifacts[i + 1],
+                             want_executions[i], *metadata_access_object_,
+                             metadata_access_object_container_.get(),
+                             want_events[2 * i + 1]);
+  }
+  ASSERT_EQ(AddCommitPointIfNeeded(), absl::OkStatus());
+
+  const google::protobuf::FieldMask read_mask =
+      ParseTextProtoOrDie<google::protobuf::FieldMask>(
+          R"pb(
+            paths: "artifacts" paths: "executions" paths: "events"
+          )pb");
+  LineageSubgraphQueryOptions options;
+  options.mutable_starting_artifacts()->set_filter_query(
+      absl::Substitute("id = $0", want_artifacts[0].id()));
+  options.set_max_num_hops(2);
+  options.set_direction(LineageSubgraphQueryOptions::DOWNSTREAM);
+
+  {
+    // The most recent execution, e0, is kept first. e2 and e3 were created at
+    // the same time, so the one with the smaller id is kept.
+    options.set_max_nodes(3);
+    LineageGraph output_subgraph;
+    bool is_truncated = false;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(
+                  options, read_mask,
+                  /*known_type_catalog_version=*/absl::nullopt,
+                  output_subgraph, &is_truncated),
+              absl::OkStatus());
+    EXPECT_TRUE(is_truncated);
+    VerifyLineageGraphSkeleton(
+        output_subgraph, {want_artifacts[0].id()},
+        {want_executions[0].id(), want_executions[2].id()},
+        {want_events[0], want_events[4]});
+  }
+  {
+    // All the executions fit, but none of the artifacts 2 hops away.
+    options.set_max_nodes(5);
+    LineageGraph output_subgraph;
+    bool is_truncated = false;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(
+                  options, read_mask,
+                  /*known_type_catalog_version=*/absl::nullopt,
+                  output_subgraph, &is_truncated),
+              absl::OkStatus());
+    EXPECT_TRUE(is_truncated);
+    VerifyLineageGraphSkeleton(
+        output_subgraph, {want_artifacts[0].id()},
+        {want_executions[0].id(), want_executions[1].id(),
+         want_executions[2].id(), want_executions[3].id()},
+        {want_events[0], want_events[2], want_events[4], want_events[6]});
+  }
+  {
+    // e0 is an ending node that is not included, so it does not count and
+    // e2 and e3 are kept instead. e1 does not fit any more.
+    LineageSubgraphQueryOptions ending_options = options;
+    ending_options.set_max_nodes(3);
+    ending_options.mutable_ending_executions()->set_filter_query(
+        absl::Substitute("id = $0", want_executions[0].id()));
+    LineageGraph output_subgraph;
+    bool is_truncated = false;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(
+                  ending_options, read_mask,
+                  /*known_type_catalog_version=*/absl::nullopt,
+                  output_subgraph, &is_truncated),
+              absl::OkStatus());
+    EXPECT_TRUE(is_truncated);
+    VerifyLineageGraphSkeleton(
+        output_subgraph, {want_artifacts[0].id()},
+        {want_executions[2].id(), want_executions[3].id()},
+        {want_events[4], want_events[6]});
+  }
+  {
+    // The whole subgraph fits.
+    options.set_max_nodes(9);
+    LineageGraph output_subgraph;
+    bool is_truncated = true;
+    ASSERT_EQ(metadata_access_object_->QueryLineageSubgraph(
+                  options, read_mask,
+                  /*known_type_catalog_version=*/absl::nullopt,
+                  output_subgraph, &is_truncated),
+              absl::OkStatus());
+    EXPECT_FALSE(is_truncated);
+    VerifyLineageGraphSkeleton(
+        output_subgraph,
+        {want_artifacts[0].id(), want_artifacts[1].id(),
+         want_artifacts[2].id(), want_artifacts[3].id(),
+         want_artifacts[4].id()},
+        {want_executions[0].id(), want_executions[1].id(),
+         want_executions[2].id(), want_executions[3].id()},
+        want_events);
+  }
+}
+
 TEST_P(MetadataAccessObjectTest, QueryLineageSubgraphWithFieldMask) {
   ASSERT_EQ(Init(), absl::OkStatus());
   // Test setup: use a simple graph with multiple paths between (a1, e2).
@@ -14,10 +14,106 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/metadata_source.h"
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "ml_metadata/util/return_utils.h"
 
 namespace ml_metadata {
+namespace {
+
+std::atomic<QueryObserver*> query_observer{nullptr};
+std::atomic<TableChangeObserver*> table_change_observer{nullptr};
+
+// Returns the table name in `token`, which may be quoted or followed by a
+// column list, e.g., `Artifact`(.
+absl::string_view GetTableName(absl::string_view token) {
+  token = token.substr(0, token.find('('));
+  if (token.size() >= 2 && (token.front() == '`' || token.front() == '"') &&
+      token.back() == token.front()) {
+    token = token.substr(1, token.size() - 2);
+  }
+  return token;
+}
+
+// Returns the table that `query` inserts into, updates or deletes from, or an
+// empty string if `query` is not such a statement.
+absl::string_view GetChangedTable(absl::string_view query) {
+  enum class Statement { kUnknown, kInsert, kUpdate, kDelete };
+  Statement statement = Statement::kUnknown;
+  bool expects_table = false;
+  int num_tokens = 0;
+  for (absl::string_view token : absl::StrSplit(
+           query, absl::ByAnyChar(" \t\n\r"), absl::SkipEmpty())) {
+    if (expects_table) {
+      return GetTableName(token);
+    }
+    // The table follows the first few tokens, e.g., `INSERT OR IGNORE INTO`.
+    if (++num_tokens > 4) {
+      break;
+    }
+    if (num_tokens == 1) {
+      if (absl::EqualsIgnoreCase(token, "INSERT") ||
+          absl::EqualsIgnoreCase(token, "REPLACE")) {
+        statement = Statement::kInsert;
+      } else if (absl::EqualsIgnoreCase(token, "UPDATE")) {
+        statement = Statement::kUpdate;
+        expects_table = true;
+      } else if (absl::EqualsIgnoreCase(token, "DELETE")) {
+        statement = Statement::kDelete;
+      } else {
+        break;
+      }
+    } else if ((statement == Statement::kInsert &&
+                absl::EqualsIgnoreCase(token, "INTO")) ||
+               (statement == Statement::kDelete &&
+                absl::EqualsIgnoreCase(token, "FROM"))) {
+      expects_table = true;
+    }
+  }
+  return "";
+}
+
+}  // namespace
+
+void MetadataSource::SetQueryObserver(QueryObserver* observer) {
+  query_observer.store(observer, std::memory_order_release);
+}
+
+void MetadataSource::SetTableChangeObserver(TableChangeObserver* observer) {
+  table_change_observer.store(observer, std::memory_order_release);
+}
+
+absl::Status MetadataSource::ExecuteAndCountChangedRows(
+    const std::string& query, RecordSet* results,
+    absl::FunctionRef<absl::Status(RecordSet*)> execute) {
+  if (table_change_observer.load(std::memory_order_acquire) == nullptr) {
+    return execute(results);
+  }
+  const absl::string_view table = GetChangedTable(query);
+  if (table.empty()) {
+    return execute(results);
+  }
+  // The sources report the changed rows in the results.
+  RecordSet changed_rows_results;
+  RecordSet* const query_results =
+      results != nullptr ? results : &changed_rows_results;
+  MLMD_RETURN_IF_ERROR(execute(query_results));
+  const int64_t num_changed_rows = query_results->has_num_affected_rows()
+                                       ? query_results->num_affected_rows()
+                                       : query_results->records_size();
+  if (num_changed_rows > 0) {
+    num_changed_rows_[table] += num_changed_rows;
+  }
+  return absl::OkStatus();
+}
 
 absl::Status MetadataSource::Connect() {
   if (is_connected_)
@@ -35,6 +131,8 @@ absl::Status MetadataSource::Close() {
         "No connection is opened when calling Close().");
   MLMD_RETURN_IF_ERROR(CloseImpl());
   is_connected_ = false;
+  // Closing the connection discards the open transaction.
+  if (transaction_open_) num_rolled_back_transactions_++;
   return absl::OkStatus();
 }
 
@@ -44,7 +142,41 @@ absl::Status MetadataSource::ExecuteQuery(const std::string& query,
     return absl::FailedPreconditionError("No opened connection for querying.");
   if (!transaction_open_)
     return absl::FailedPreconditionError("Transaction not open.");
-  return ExecuteQueryImpl(query, results);
+  return ExecuteAndCountChangedRows(
+      query, results, [this, &query](RecordSet* query_results) {
+        QueryObserver* const observer =
+            query_observer.load(std::memory_order_acquire);
+        if (observer == nullptr) return ExecuteQueryImpl(query, query_results);
+        const absl::Time start_time = absl::Now();
+        const absl::Status status = ExecuteQueryImpl(query, query_results);
+        observer->OnQueryExecuted(query, absl::Now() - start_time);
+        return status;
+      });
+}
+
+absl::Status MetadataSource::ExecuteQuery(
+    const std::string& query, absl::Span<const QueryParameter> parameters,
+    RecordSet* results) {
+  if (!is_connected_)
+    return absl::FailedPreconditionError("No opened connection for querying.");
+  if (!transaction_open_)
+    return absl::FailedPreconditionError("Transaction not open.");
+  if (!SupportsQueryParameters())
+    return absl::UnimplementedError("Query parameters are not supported.");
+  return ExecuteAndCountChangedRows(
+      query, results, [this, &query, parameters](RecordSet* query_results) {
+        QueryObserver* const observer =
+            query_observer.load(std::memory_order_acquire);
+        if (observer == nullptr) {
+          return ExecuteParameterizedQueryImpl(query, parameters,
+                                               query_results);
+        }
+        const absl::Time start_time = absl::Now();
+        const absl::Status status =
+            ExecuteParameterizedQueryImpl(query, parameters, query_results);
+        observer->OnQueryExecuted(query, absl::Now() - start_time);
+        return status;
+      });
 }
 
 absl::Status MetadataSource::Begin() {
@@ -54,6 +186,7 @@ absl::Status MetadataSource::Begin() {
     return absl::FailedPreconditionError("Transaction already open.");
   MLMD_RETURN_IF_ERROR(BeginImpl());
   transaction_open_ = true;
+  num_changed_rows_.clear();
   return absl::OkStatus();
 }
 
@@ -65,6 +198,12 @@ absl::Status MetadataSource::Commit() {
     return absl::FailedPreconditionError("Transaction not open.");
   MLMD_RETURN_IF_ERROR(CommitImpl());
   transaction_open_ = false;
+  if (!num_changed_rows_.empty()) {
+    TableChangeObserver* const observer =
+        table_change_observer.load(std::memory_order_acquire);
+    if (observer != nullptr) observer->OnRowsChanged(num_changed_rows_);
+    num_changed_rows_.clear();
+  }
   return absl::OkStatus();
 }
 
@@ -73,6 +212,9 @@ absl::Status MetadataSource::Rollback() {
     return absl::FailedPreconditionError("No opened connection for querying.");
   if (!transaction_open_)
     return absl::FailedPreconditionError("Transaction not open.");
+  // Counts the transaction even if the rollback fails, as its changes may be
+  // discarded anyway.
+  num_rolled_back_transactions_++;
   MLMD_RETURN_IF_ERROR(RollbackImpl());
   transaction_open_ = false;
   return absl::OkStatus();
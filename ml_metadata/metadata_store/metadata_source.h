@@ -15,18 +15,62 @@ limitations under the License.
 #ifndef ML_METADATA_METADATA_STORE_METADATA_SOURCE_H_
 #define ML_METADATA_METADATA_STORE_METADATA_SOURCE_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ml_metadata/metadata_store/types.h"
 #include "ml_metadata/proto/metadata_source.pb.h"
 
 namespace ml_metadata {
 
+// Receives the text and the latency of the queries executed by any
+// MetadataSource in the process, e.g., to collect the slowest statements.
+// Implementations must be thread-safe.
+class QueryObserver {
+ public:
+  virtual ~QueryObserver() = default;
+
+  // Called after `query` is executed, whether or not it succeeded.
+  virtual void OnQueryExecuted(absl::string_view query,
+                               absl::Duration elapsed) = 0;
+};
+
+// Receives the number of rows that the committed transactions of any
+// MetadataSource in the process changed per table, e.g., to refresh the
+// planner statistics after bulk changes. Implementations must be thread-safe.
+class TableChangeObserver {
+ public:
+  virtual ~TableChangeObserver() = default;
+
+  // Called after a transaction is committed with the rows it inserted,
+  // updated or deleted, keyed by table name. It is not called for
+  // transactions that changed no rows.
+  virtual void OnRowsChanged(
+      const absl::flat_hash_map<std::string, int64_t>& num_changed_rows) = 0;
+};
+
+// A value that is sent to the backend apart from the query text, which refers
+// to it by position, e.g., `$1` for the first parameter in PostgreSQL. See
+// MetadataSource::ExecuteQuery.
+struct QueryParameter {
+  enum class Type { kText, kInt64, kDouble, kBool, kBytes };
+
+  Type type;
+  // The value in network byte order: an 8-byte two's complement integer for
+  // kInt64, an 8-byte IEEE 754 double for kDouble, a single 0 or 1 byte for
+  // kBool, and the raw bytes for kText and kBytes. Not owned.
+  absl::string_view value;
+};
+
 // The base class for all metadata data sources. It provides an interface used
 // by MetadataAccessObject. Each concrete MetadataSource provides a physical
 // backend to persist and query metadata. An implementation of MetadataSource
@@ -85,6 +129,21 @@ class MetadataSource {
   // Returns FAILED_PRECONDITION error, if a transaction has not begun.
   absl::Status ExecuteQuery(const std::string& query, RecordSet* results);
 
+  // Runs a single statement `query` as above, with `parameters` sent apart
+  // from the query text. The values are neither escaped nor parsed as SQL, and
+  // queries that only differ in their values have the same text.
+  // Returns FAILED_PRECONDITION error, if Connection() is not opened.
+  // Returns FAILED_PRECONDITION error, if a transaction has not begun.
+  // Returns UNIMPLEMENTED error, if the source does not support query
+  //   parameters.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status ExecuteQuery(const std::string& query,
+                            absl::Span<const QueryParameter> parameters,
+                            RecordSet* results);
+
+  // Returns true if the source implements ExecuteQuery with parameters.
+  virtual bool SupportsQueryParameters() const { return false; }
+
   // Begins (opens) a transaction.
   // Returns FAILED_PRECONDITION error, if Connection() is not opened.
   // Returns FAILED_PRECONDITION error, if a transaction has already begun.
@@ -109,6 +168,14 @@ class MetadataSource {
   // escaping characters and method depends on the metadata source backend.
   virtual std::string EscapeString(absl::string_view value) const = 0;
 
+  // Appends the escaped `value` to `output`, as EscapeString does. Sources
+  // that can escape in place override it to write directly into `output`
+  // without materializing an intermediate string.
+  virtual void AppendEscapedString(absl::string_view value,
+                                   std::string* output) const {
+    output->append(EscapeString(value));
+  }
+
   // Called by QueryExecutor:EncodeBytes to use a byte encoding routine that
   // depends on the MetadataSource. Most MetadataSources would implement this as
   // std::string that simply wraps and returns the incoming `value` string_view,
@@ -137,6 +204,25 @@ class MetadataSource {
 
   bool is_connected() const { return is_connected_; }
 
+  // Returns the number of transactions that were rolled back, including the
+  // ones left open when the connection was closed. Callers that cache rows
+  // written in a transaction use it to notice that the rows may be gone.
+  int64_t num_rolled_back_transactions() const {
+    return num_rolled_back_transactions_;
+  }
+
+  // Sets the process-wide observer of executed queries, or clears it if
+  // `observer` is nullptr. The observer is not owned and must outlive the
+  // queries executed while it is set.
+  static void SetQueryObserver(QueryObserver* observer);
+
+  // Sets the process-wide observer of the rows changed by committed
+  // transactions, or clears it if `observer` is nullptr. While it is set,
+  // ExecuteQuery counts the rows changed by INSERT, REPLACE, UPDATE and DELETE
+  // statements per table. The observer is not owned and must outlive the
+  // transactions committed while it is set.
+  static void SetTableChangeObserver(TableChangeObserver* observer);
+
  protected:
   bool transaction_open() const { return transaction_open_; }
 
@@ -155,6 +241,13 @@ class MetadataSource {
   virtual absl::Status ExecuteQueryImpl(const std::string& query,
                                         RecordSet* results) = 0;
 
+  // Implementation of executing queries with parameters.
+  virtual absl::Status ExecuteParameterizedQueryImpl(
+      const std::string& query, absl::Span<const QueryParameter> parameters,
+      RecordSet* results) {
+    return absl::UnimplementedError("Query parameters are not supported.");
+  }
+
   // Implementation of opening a transaction.
   virtual absl::Status BeginImpl() = 0;
 
@@ -167,6 +260,17 @@ class MetadataSource {
 
   bool is_connected_ = false;
   bool transaction_open_ = false;
+  int64_t num_rolled_back_transactions_ = 0;
+
+  // Runs `execute` with the results of `query`, and counts the rows it
+  // changed if a TableChangeObserver is set.
+  absl::Status ExecuteAndCountChangedRows(
+      const std::string& query, RecordSet* results,
+      absl::FunctionRef<absl::Status(RecordSet*)> execute);
+
+  // The rows changed per table by the open transaction, which are reported to
+  // the TableChangeObserver on commit.
+  absl::flat_hash_map<std::string, int64_t> num_changed_rows_;
 };
 
 }  // namespace ml_metadata
@@ -14,8 +14,13 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/metadata_source.h"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "ml_metadata/proto/metadata_source.pb.h"
@@ -38,6 +43,17 @@ class MockMetadataSource : public MetadataSource {
               (absl::string_view value), (const));
 };
 
+// Records the rows reported by committed transactions.
+class RecordingTableChangeObserver : public TableChangeObserver {
+ public:
+  void OnRowsChanged(const absl::flat_hash_map<std::string, int64_t>&
+                         num_changed_rows) override {
+    reports.push_back(num_changed_rows);
+  }
+
+  std::vector<absl::flat_hash_map<std::string, int64_t>> reports;
+};
+
 TEST(MetadataSourceTest, ConnectAgainWithoutClose) {
   MockMetadataSource mock_metadata_source;
   EXPECT_CALL(mock_metadata_source, ConnectImpl()).Times(1);
@@ -183,5 +199,47 @@ TEST(MetadataSourceTest, TestBeginWithoutConnect) {
   EXPECT_TRUE(absl::IsFailedPrecondition(s));
 }
 
+TEST(MetadataSourceTest, TestTableChangeObserver) {
+  MockMetadataSource mock_metadata_source;
+  // Every statement changes 2 rows.
+  EXPECT_CALL(mock_metadata_source,
+              ExecuteQueryImpl(::testing::_, ::testing::_))
+      .WillRepeatedly([](const std::string& query, RecordSet* results) {
+        if (results != nullptr) results->set_num_affected_rows(2);
+        return absl::OkStatus();
+      });
+  RecordingTableChangeObserver observer;
+  MetadataSource::SetTableChangeObserver(&observer);
+  ASSERT_EQ(absl::OkStatus(), mock_metadata_source.Connect());
+
+  ASSERT_EQ(absl::OkStatus(), mock_metadata_source.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery(
+                " INSERT INTO `t1`(`c1`) VALUES (1), (2);", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery(
+                "INSERT OR IGNORE INTO t1 VALUES (3);", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery(
+                "UPDATE t2 SET c1 = 1 WHERE c1 = 2;", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery("DELETE FROM \"t3\";", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery("SELECT * FROM t1;", nullptr));
+  ASSERT_EQ(absl::OkStatus(), mock_metadata_source.Commit());
+
+  // The changes of a rolled back transaction are not reported.
+  ASSERT_EQ(absl::OkStatus(), mock_metadata_source.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            mock_metadata_source.ExecuteQuery("DELETE FROM t1;", nullptr));
+  ASSERT_EQ(absl::OkStatus(), mock_metadata_source.Rollback());
+  MetadataSource::SetTableChangeObserver(nullptr);
+
+  ASSERT_EQ(observer.reports.size(), 1);
+  EXPECT_THAT(observer.reports[0],
+              ::testing::UnorderedElementsAre(::testing::Pair("t1", 4),
+                                              ::testing::Pair("t2", 2),
+                                              ::testing::Pair("t3", 2)));
+}
 
 }  // namespace ml_metadata
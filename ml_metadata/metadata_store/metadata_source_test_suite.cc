@@ -15,9 +15,12 @@ limitations under the License.
 #include "ml_metadata/metadata_store/metadata_source_test_suite.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "ml_metadata/metadata_store/constants.h"
 #include "ml_metadata/metadata_store/test_util.h"
@@ -215,6 +218,40 @@ TEST_P(MetadataSourceTestSuite, TestNull) {
   EXPECT_THAT(query_results, EqualsProto(expected_results));
 }
 
+// Test Insert execution with query parameters.
+// Initialization: creates an empty table t1 (c1 INT, c2 VARCHAR(255)) with test
+// schema.
+// Execution: Insert a new row (1, 'it''s') with parameters, if supported.
+// Expectation: all the retrieved rows in t1 are (1, 'it''s').
+TEST_P(MetadataSourceTestSuite, TestInsertWithQueryParameters) {
+  metadata_source_container_->InitTestSchema();
+  EXPECT_EQ(absl::OkStatus(), metadata_source_->Begin());
+  // The int8 parameter 1 in network byte order.
+  const std::string c1("\0\0\0\0\0\0\0\1", 8);
+  const std::vector<QueryParameter> parameters = {
+      {QueryParameter::Type::kInt64, c1},
+      {QueryParameter::Type::kText, "it's"}};
+  if (!metadata_source_->SupportsQueryParameters()) {
+    EXPECT_TRUE(absl::IsUnimplemented(metadata_source_->ExecuteQuery(
+        "INSERT INTO t1 VALUES ($1, $2)", parameters, nullptr)));
+    EXPECT_EQ(absl::OkStatus(), metadata_source_->Commit());
+    return;
+  }
+  EXPECT_EQ(absl::OkStatus(),
+            metadata_source_->ExecuteQuery("INSERT INTO t1 VALUES ($1, $2)",
+                                           parameters, nullptr));
+  RecordSet expected_results = ParseTextProtoOrDie<RecordSet>(
+      R"(column_names: "c1"
+         column_names: "c2"
+         records: { values: "1" values: "it's" })");
+
+  RecordSet query_results;
+  EXPECT_EQ(absl::OkStatus(),
+            metadata_source_->ExecuteQuery("SELECT * FROM t1", &query_results));
+  EXPECT_EQ(absl::OkStatus(), metadata_source_->Commit());
+  EXPECT_THAT(query_results, EqualsProto(expected_results));
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace ml_metadata
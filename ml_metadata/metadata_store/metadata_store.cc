@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -31,6 +32,7 @@ limitations under the License.
 #include "absl/container/node_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
@@ -301,12 +303,16 @@ absl::Status UpsertSimpleTypes(MetadataAccessObject* metadata_access_object) {
 // with artifact.external_id to see if there is existing artifact. If there is
 // existing artifact, repopulate artifact.id as if it's provided to perform an
 // update. If there is no existing artifact, continue to insert.
+// If `precondition` is not empty, an existing artifact is updated only if it
+// satisfies `precondition`, otherwise FAILED_PRECONDITION is returned.
 absl::Status UpsertArtifact(const Artifact& artifact,
                             MetadataAccessObject* metadata_access_object,
                             bool skip_type_and_property_validation,
                             const google::protobuf::FieldMask& mask,
                             bool reuse_artifact_if_already_exist_by_external_id,
-                            int64_t* artifact_id) {
+                            int64_t* artifact_id,
+                            const UpdatePrecondition& precondition =
+                                UpdatePrecondition::default_instance()) {
   CHECK(artifact_id) << "artifact_id should not be null";
 
   Artifact artifact_copy_to_be_upserted(artifact);
@@ -329,8 +335,13 @@ absl::Status UpsertArtifact(const Artifact& artifact,
   }
 
   if (artifact_copy_to_be_upserted.has_id()) {
-    MLMD_RETURN_IF_ERROR(metadata_access_object->UpdateArtifact(
-        artifact_copy_to_be_upserted, mask));
+    if (precondition.ByteSizeLong() > 0) {
+      MLMD_RETURN_IF_ERROR(metadata_access_object->UpdateArtifact(
+          artifact_copy_to_be_upserted, absl::Now(), mask, precondition));
+    } else {
+      MLMD_RETURN_IF_ERROR(metadata_access_object->UpdateArtifact(
+          artifact_copy_to_be_upserted, mask));
+    }
     *artifact_id = artifact_copy_to_be_upserted.id();
   } else {
     MLMD_RETURN_IF_ERROR(metadata_access_object->CreateArtifact(
@@ -354,14 +365,22 @@ absl::Status UpsertArtifact(const Artifact& artifact,
 // of `execution` type and properties.
 // When `force_update_time` is set to true, `last_update_time_since_epoch` is
 // updated even if input execution is the same as stored execution.
+// If `precondition` is not empty, an existing execution is updated only if it
+// satisfies `precondition`, otherwise FAILED_PRECONDITION is returned.
 absl::Status UpsertExecution(const Execution& execution,
                              MetadataAccessObject* metadata_access_object,
                              const bool skip_type_and_property_validation,
                              const bool force_update_time,
                              const google::protobuf::FieldMask& mask,
-                             int64_t* execution_id) {
+                             int64_t* execution_id,
+                             const UpdatePrecondition& precondition =
+                                 UpdatePrecondition::default_instance()) {
   CHECK(execution_id) << "execution_id should not be null";
-  if (execution.has_id()) {
+  if (execution.has_id() && precondition.ByteSizeLong() > 0) {
+    MLMD_RETURN_IF_ERROR(metadata_access_object->UpdateExecution(
+        execution, absl::Now(), mask, precondition));
+    *execution_id = execution.id();
+  } else if (execution.has_id()) {
     MLMD_RETURN_IF_ERROR(metadata_access_object->UpdateExecution(
         execution, force_update_time, mask));
     *execution_id = execution.id();
@@ -372,6 +391,110 @@ absl::Status UpsertExecution(const Execution& execution,
   return absl::OkStatus();
 }
 
+// Returns INVALID_ARGUMENT if `num_preconditions` update preconditions cannot be
+// aligned with `num_nodes` nodes of a Put request.
+absl::Status ValidateUpdatePreconditions(int num_preconditions,
+                                         int num_nodes) {
+  if (num_preconditions != 0 && num_preconditions != num_nodes) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "update_preconditions must be empty or have one precondition per "
+        "node, got ",
+        num_preconditions, " preconditions for ", num_nodes, " nodes."));
+  }
+  return absl::OkStatus();
+}
+
+// The number of nodes committed in one transaction, if ChunkedCommitOptions
+// sets neither limit.
+constexpr int kDefaultMaxNodesPerChunk = 1000;
+
+// Commits `nodes` from `options.resume_from_index` in chunks bounded by
+// `options`, each in its own transaction. `put_node` upserts the node at the
+// given index and returns its id. The ids of the nodes in the committed chunks
+// are appended to `node_ids`, and the progress is recorded in `result`.
+// If a chunk fails after some chunks are committed, returns OK and records the
+// failed chunk and its error in `result`, so that the caller gets the progress
+// to resume from along with the committed ids.
+// Returns INVALID_ARGUMENT error, if `options` are invalid.
+// Returns the error of the first chunk, if it fails and nothing is committed.
+template <typename Node>
+absl::Status CommitInChunks(
+    const google::protobuf::RepeatedPtrField<Node>& nodes,
+    const ChunkedCommitOptions& options,
+    const TransactionOptions& transaction_options,
+    const TransactionExecutor& transaction_executor,
+    const std::function<absl::StatusOr<int64_t>(int)>& put_node,
+    google::protobuf::RepeatedField<int64_t>* node_ids,
+    ChunkedCommitResult* result) {
+  if (options.resume_from_index() < 0 ||
+      options.resume_from_index() > nodes.size()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "resume_from_index must be in [0, ", nodes.size(),
+        "], got ", options.resume_from_index()));
+  }
+  if ((options.has_max_nodes_per_chunk() &&
+       options.max_nodes_per_chunk() <= 0) ||
+      (options.has_max_bytes_per_chunk() &&
+       options.max_bytes_per_chunk() <= 0)) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "The chunk limits must be positive: ", options.ShortDebugString()));
+  }
+  int max_nodes_per_chunk = kDefaultMaxNodesPerChunk;
+  if (options.has_max_nodes_per_chunk()) {
+    max_nodes_per_chunk = options.max_nodes_per_chunk();
+  } else if (options.has_max_bytes_per_chunk()) {
+    max_nodes_per_chunk = nodes.size();
+  }
+
+  int begin = options.resume_from_index();
+  result->set_num_committed_nodes(begin);
+  std::vector<int64_t> chunk_node_ids;
+  while (begin < nodes.size()) {
+    int end = begin;
+    int64_t num_bytes = 0;
+    while (end < nodes.size() && end - begin < max_nodes_per_chunk) {
+      const int64_t node_bytes = nodes.Get(end).ByteSizeLong();
+      if (end > begin && options.has_max_bytes_per_chunk() &&
+          num_bytes + node_bytes > options.max_bytes_per_chunk()) {
+        break;
+      }
+      num_bytes += node_bytes;
+      ++end;
+    }
+    const absl::Status status = transaction_executor.Execute(
+        [&put_node, &chunk_node_ids, begin, end]() -> absl::Status {
+          chunk_node_ids.clear();
+          for (int i = begin; i < end; ++i) {
+            int64_t node_id = -1;
+            MLMD_ASSIGN_OR_RETURN(node_id, put_node(i));
+            chunk_node_ids.push_back(node_id);
+          }
+          return absl::OkStatus();
+        },
+        transaction_options);
+    if (!status.ok()) {
+      if (result->committed_chunks().empty()) {
+        return status;
+      }
+      ChunkedCommitResult::Chunk* failed_chunk = result->mutable_failed_chunk();
+      failed_chunk->set_begin_index(begin);
+      failed_chunk->set_end_index(end);
+      failed_chunk->set_num_bytes(num_bytes);
+      result->set_failed_chunk_error_code(static_cast<int>(status.code()));
+      result->set_failed_chunk_error_message(std::string(status.message()));
+      return absl::OkStatus();
+    }
+    node_ids->Add(chunk_node_ids.begin(), chunk_node_ids.end());
+    ChunkedCommitResult::Chunk* chunk = result->add_committed_chunks();
+    chunk->set_begin_index(begin);
+    chunk->set_end_index(end);
+    chunk->set_num_bytes(num_bytes);
+    result->set_num_committed_nodes(end);
+    begin = end;
+  }
+  return absl::OkStatus();
+}
+
 // Updates or inserts a context.
 // If the context.id is given, it updates the stored context,
 // otherwise, it creates a new context.
@@ -565,6 +688,27 @@ absl::Status GetExternalIdToIdMapping(
   return absl::OkStatus();
 }
 
+// Sorts `nodes` in the order of the first occurrence of their names in
+// `names`. The nodes whose name is not in `names`, e.g., matched by a
+// case-insensitive collation, are kept at the end.
+template <typename Node>
+void SortNodesByNames(absl::Span<const absl::string_view> names,
+                      std::vector<Node>& nodes) {
+  absl::flat_hash_map<absl::string_view, int> name_positions;
+  for (int i = 0; i < names.size(); i++) {
+    name_positions.insert({names[i], i});
+  }
+  auto position = [&](const Node& node) {
+    auto it = name_positions.find(node.name());
+    return it == name_positions.end() ? static_cast<int>(names.size())
+                                      : it->second;
+  };
+  std::stable_sort(nodes.begin(), nodes.end(),
+                   [&](const Node& lhs, const Node& rhs) {
+                     return position(lhs) < position(rhs);
+                   });
+}
+
 // A util to handle type_version in type read/write API requests.
 template <typename T>
 std::optional<std::string> GetRequestTypeVersion(const T& type_request) {
@@ -746,6 +890,99 @@ absl::Status BatchTypeAndPropertyValidation(
   return absl::OkStatus();
 }
 
+// Removes the ids of the nodes that are not changed since the client read them
+// from `ids`, and appends them to `unchanged_ids`. A node is unchanged if its
+// stored last update time equals its time in `known_last_update_times`.
+// The stored times are read without hydrating the nodes by
+// `find_last_update_times`.
+absl::Status RemoveUnchangedNodeIds(
+    const google::protobuf::Map<int64_t, int64_t>& known_last_update_times,
+    std::function<absl::Status(absl::Span<const int64_t>,
+                               absl::flat_hash_map<int64_t, int64_t>&)>
+        find_last_update_times,
+    std::vector<int64_t>& ids,
+    google::protobuf::RepeatedField<int64_t>* unchanged_ids) {
+  if (known_last_update_times.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<int64_t> known_ids;
+  for (const int64_t id : ids) {
+    if (known_last_update_times.find(id) != known_last_update_times.end()) {
+      known_ids.push_back(id);
+    }
+  }
+  absl::flat_hash_map<int64_t, int64_t> stored_last_update_times;
+  MLMD_RETURN_IF_ERROR(
+      find_last_update_times(known_ids, stored_last_update_times));
+  std::vector<int64_t> changed_ids;
+  for (const int64_t id : ids) {
+    const auto known_it = known_last_update_times.find(id);
+    if (known_it == known_last_update_times.end()) {
+      changed_ids.push_back(id);
+      continue;
+    }
+    const auto stored_it = stored_last_update_times.find(id);
+    if (stored_it == stored_last_update_times.end()) {
+      // The node does not exist, so there is nothing to hydrate.
+      continue;
+    }
+    if (stored_it->second == known_it->second) {
+      unchanged_ids->Add(id);
+    } else {
+      changed_ids.push_back(id);
+    }
+  }
+  ids = std::move(changed_ids);
+  return absl::OkStatus();
+}
+
+// A TransactionExecutor that increases the write epochs of `type_kinds` at the
+// end of every successful transaction body, so that the new epochs commit
+// together with the writes they describe. If `increase_write_epochs` is false,
+// it runs the transaction bodies as they are.
+class WriteTransactionExecutor : public TransactionExecutor {
+ public:
+  WriteTransactionExecutor(const TransactionExecutor* transaction_executor,
+                           MetadataAccessObject* metadata_access_object,
+                           bool increase_write_epochs,
+                           std::vector<TypeKind> type_kinds)
+      : transaction_executor_(transaction_executor),
+        metadata_access_object_(metadata_access_object),
+        increase_write_epochs_(increase_write_epochs),
+        type_kinds_(std::move(type_kinds)) {}
+
+  absl::Status Execute(const std::function<absl::Status()>& txn_body,
+                       const TransactionOptions& transaction_options =
+                           TransactionOptions()) const override {
+    if (!increase_write_epochs_) {
+      return transaction_executor_->Execute(txn_body, transaction_options);
+    }
+    return transaction_executor_->Execute(
+        [this, &txn_body]() -> absl::Status {
+          MLMD_RETURN_IF_ERROR(txn_body());
+          return metadata_access_object_->IncreaseWriteEpochs(type_kinds_);
+        },
+        transaction_options);
+  }
+
+ private:
+  const TransactionExecutor* transaction_executor_;
+  MetadataAccessObject* metadata_access_object_;
+  const bool increase_write_epochs_;
+  const std::vector<TypeKind> type_kinds_;
+};
+
+// A TransactionExecutor that runs transaction bodies in the transaction that
+// is already open, so that the calls of a batch share one transaction.
+class OpenTransactionExecutor : public TransactionExecutor {
+ public:
+  absl::Status Execute(const std::function<absl::Status()>& txn_body,
+                       const TransactionOptions& transaction_options =
+                           TransactionOptions()) const override {
+    return txn_body();
+  }
+};
+
 }  // namespace
 
 absl::Status MetadataStore::InitMetadataStore() {
@@ -804,10 +1041,16 @@ absl::Status MetadataStore::PutTypes(const PutTypesRequest& request,
 
 absl::Status MetadataStore::PutArtifactType(
     const PutArtifactTypeRequest& request, PutArtifactTypeResponse* response) {
+  return PutArtifactType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutArtifactType(
+    const TransactionExecutor& transaction_executor,
+    const PutArtifactTypeRequest& request, PutArtifactTypeResponse* response) {
   if (!request.all_fields_match()) {
     return absl::UnimplementedError("Must match all fields.");
   }
-  return transaction_executor_->Execute(
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<ArtifactType> types = {request.artifact_type()};
@@ -825,10 +1068,17 @@ absl::Status MetadataStore::PutArtifactType(
 absl::Status MetadataStore::PutExecutionType(
     const PutExecutionTypeRequest& request,
     PutExecutionTypeResponse* response) {
+  return PutExecutionType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutExecutionType(
+    const TransactionExecutor& transaction_executor,
+    const PutExecutionTypeRequest& request,
+    PutExecutionTypeResponse* response) {
   if (!request.all_fields_match()) {
     return absl::UnimplementedError("Must match all fields.");
   }
-  return transaction_executor_->Execute(
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<ExecutionType> types = {request.execution_type()};
@@ -845,10 +1095,16 @@ absl::Status MetadataStore::PutExecutionType(
 
 absl::Status MetadataStore::PutContextType(const PutContextTypeRequest& request,
                                            PutContextTypeResponse* response) {
+  return PutContextType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutContextType(
+    const TransactionExecutor& transaction_executor,
+    const PutContextTypeRequest& request, PutContextTypeResponse* response) {
   if (!request.all_fields_match()) {
     return absl::UnimplementedError("Must match all fields.");
   }
-  return transaction_executor_->Execute(
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<ContextType> types = {request.context_type()};
@@ -865,7 +1121,13 @@ absl::Status MetadataStore::PutContextType(const PutContextTypeRequest& request,
 
 absl::Status MetadataStore::GetArtifactType(
     const GetArtifactTypeRequest& request, GetArtifactTypeResponse* response) {
-  return transaction_executor_->Execute(
+  return GetArtifactType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetArtifactType(
+    const TransactionExecutor& transaction_executor,
+    const GetArtifactTypeRequest& request, GetArtifactTypeResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         ArtifactType type;
@@ -884,7 +1146,14 @@ absl::Status MetadataStore::GetArtifactType(
 absl::Status MetadataStore::GetExecutionType(
     const GetExecutionTypeRequest& request,
     GetExecutionTypeResponse* response) {
-  return transaction_executor_->Execute(
+  return GetExecutionType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetExecutionType(
+    const TransactionExecutor& transaction_executor,
+    const GetExecutionTypeRequest& request,
+    GetExecutionTypeResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         ExecutionType type;
@@ -902,7 +1171,13 @@ absl::Status MetadataStore::GetExecutionType(
 
 absl::Status MetadataStore::GetContextType(const GetContextTypeRequest& request,
                                            GetContextTypeResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContextType(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContextType(
+    const TransactionExecutor& transaction_executor,
+    const GetContextTypeRequest& request, GetContextTypeResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         return metadata_access_object_->FindTypeByNameAndVersion(
@@ -1063,13 +1338,28 @@ absl::Status MetadataStore::GetContextTypesByExternalIds(
 absl::Status MetadataStore::GetArtifactsByID(
     const GetArtifactsByIDRequest& request,
     GetArtifactsByIDResponse* response) {
-  return transaction_executor_->Execute(
+  return GetArtifactsByID(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetArtifactsByID(
+    const TransactionExecutor& transaction_executor,
+    const GetArtifactsByIDRequest& request,
+    GetArtifactsByIDResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Artifact> artifacts;
         std::vector<ArtifactType> artifact_types;
-        const std::vector<int64_t> ids(request.artifact_ids().begin(),
-                                       request.artifact_ids().end());
+        std::vector<int64_t> ids(request.artifact_ids().begin(),
+                                 request.artifact_ids().end());
+        MLMD_RETURN_IF_ERROR(RemoveUnchangedNodeIds(
+            request.known_last_update_time_since_epoch(),
+            [this](absl::Span<const int64_t> known_ids,
+                   absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+              return metadata_access_object_->FindArtifactLastUpdateTimesById(
+                  known_ids, last_update_times);
+            },
+            ids, response->mutable_unchanged_artifact_ids()));
         const absl::Status status =
             request.populate_artifact_types()
                 ? metadata_access_object_->FindArtifactsById(ids, artifacts,
@@ -1092,12 +1382,27 @@ absl::Status MetadataStore::GetArtifactsByID(
 absl::Status MetadataStore::GetExecutionsByID(
     const GetExecutionsByIDRequest& request,
     GetExecutionsByIDResponse* response) {
-  return transaction_executor_->Execute(
+  return GetExecutionsByID(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetExecutionsByID(
+    const TransactionExecutor& transaction_executor,
+    const GetExecutionsByIDRequest& request,
+    GetExecutionsByIDResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Execution> executions;
-        const std::vector<int64_t> ids(request.execution_ids().begin(),
-                                       request.execution_ids().end());
+        std::vector<int64_t> ids(request.execution_ids().begin(),
+                                 request.execution_ids().end());
+        MLMD_RETURN_IF_ERROR(RemoveUnchangedNodeIds(
+            request.known_last_update_time_since_epoch(),
+            [this](absl::Span<const int64_t> known_ids,
+                   absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+              return metadata_access_object_->FindExecutionLastUpdateTimesById(
+                  known_ids, last_update_times);
+            },
+            ids, response->mutable_unchanged_execution_ids()));
         const absl::Status status =
             metadata_access_object_->FindExecutionsById(ids, &executions);
         if (!status.ok() && !absl::IsNotFound(status)) {
@@ -1112,12 +1417,26 @@ absl::Status MetadataStore::GetExecutionsByID(
 
 absl::Status MetadataStore::GetContextsByID(
     const GetContextsByIDRequest& request, GetContextsByIDResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContextsByID(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContextsByID(
+    const TransactionExecutor& transaction_executor,
+    const GetContextsByIDRequest& request, GetContextsByIDResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Context> contexts;
-        const std::vector<int64_t> ids(request.context_ids().begin(),
-                                       request.context_ids().end());
+        std::vector<int64_t> ids(request.context_ids().begin(),
+                                 request.context_ids().end());
+        MLMD_RETURN_IF_ERROR(RemoveUnchangedNodeIds(
+            request.known_last_update_time_since_epoch(),
+            [this](absl::Span<const int64_t> known_ids,
+                   absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+              return metadata_access_object_->FindContextLastUpdateTimesById(
+                  known_ids, last_update_times);
+            },
+            ids, response->mutable_unchanged_context_ids()));
         const absl::Status status =
             metadata_access_object_->FindContextsById(ids, &contexts);
         if (!status.ok() && !absl::IsNotFound(status)) {
@@ -1132,66 +1451,124 @@ absl::Status MetadataStore::GetContextsByID(
 
 absl::Status MetadataStore::PutArtifacts(const PutArtifactsRequest& request,
                                          PutArtifactsResponse* response) {
-  return transaction_executor_->Execute([this, &request,
-                                         &response]() -> absl::Status {
-    response->Clear();
-    for (const Artifact& artifact : request.artifacts()) {
-      int64_t artifact_id = -1;
-      // Verify the latest_updated_time before upserting the artifact.
-      if (artifact.has_id() &&
-          request.options().abort_if_latest_updated_time_changed()) {
-        Artifact existing_artifact;
-        absl::Status status;
-        {
-          std::vector<Artifact> artifacts;
-          status = metadata_access_object_->FindArtifactsById({artifact.id()},
-                                                              &artifacts);
-          if (status.ok()) {
-            existing_artifact = artifacts.at(0);
-          }
-        }
-        if (!absl::IsNotFound(status)) {
-          MLMD_RETURN_IF_ERROR(status);
-          if (artifact.last_update_time_since_epoch() !=
-              existing_artifact.last_update_time_since_epoch()) {
-            return absl::FailedPreconditionError(absl::StrCat(
-                "`abort_if_latest_updated_time_changed` is set, and the stored "
-                "artifact with id = ",
-                artifact.id(),
-                " has a different last_update_time_since_epoch: ",
-                existing_artifact.last_update_time_since_epoch(),
-                " from the one in the given artifact: ",
-                artifact.last_update_time_since_epoch()));
-          }
-          // If set the option and all check succeeds, we make sure the
-          // timestamp after the update increases.
-          absl::SleepFor(absl::Milliseconds(1));
+  return PutArtifacts(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutArtifacts(
+    const TransactionExecutor& transaction_executor,
+    const PutArtifactsRequest& request, PutArtifactsResponse* response) {
+  MLMD_RETURN_IF_ERROR(ValidateUpdatePreconditions(
+      request.update_preconditions_size(), request.artifacts_size()));
+  // Upserts the artifact at `index` of the request and returns its id.
+  auto put_artifact = [this, &request](int index) -> absl::StatusOr<int64_t> {
+    const Artifact& artifact = request.artifacts(index);
+    int64_t artifact_id = -1;
+    // Verify the latest_updated_time before upserting the artifact.
+    if (artifact.has_id() &&
+        request.options().abort_if_latest_updated_time_changed()) {
+      Artifact existing_artifact;
+      absl::Status status;
+      {
+        std::vector<Artifact> artifacts;
+        status = metadata_access_object_->FindArtifactsById({artifact.id()},
+                                                            &artifacts);
+        if (status.ok()) {
+          existing_artifact = artifacts.at(0);
         }
       }
-      MLMD_RETURN_IF_ERROR(UpsertArtifact(
-          artifact, metadata_access_object_.get(),
-          /*skip_type_and_property_validation=*/false, request.update_mask(),
-          /*reuse_artifact_if_already_exist_by_external_id=*/false,
-          &artifact_id));
-      response->add_artifact_ids(artifact_id);
+      if (!absl::IsNotFound(status)) {
+        MLMD_RETURN_IF_ERROR(status);
+        if (artifact.last_update_time_since_epoch() !=
+            existing_artifact.last_update_time_since_epoch()) {
+          return absl::FailedPreconditionError(absl::StrCat(
+              "`abort_if_latest_updated_time_changed` is set, and the stored "
+              "artifact with id = ",
+              artifact.id(),
+              " has a different last_update_time_since_epoch: ",
+              existing_artifact.last_update_time_since_epoch(),
+              " from the one in the given artifact: ",
+              artifact.last_update_time_since_epoch()));
+        }
+        // If set the option and all check succeeds, we make sure the
+        // timestamp after the update increases.
+        absl::SleepFor(absl::Milliseconds(1));
+      }
     }
-    return absl::OkStatus();
-  },
-  request.transaction_options());
+    MLMD_RETURN_IF_ERROR(UpsertArtifact(
+        artifact, metadata_access_object_.get(),
+        /*skip_type_and_property_validation=*/false, request.update_mask(),
+        /*reuse_artifact_if_already_exist_by_external_id=*/false,
+        &artifact_id,
+        request.update_preconditions().empty()
+            ? UpdatePrecondition::default_instance()
+            : request.update_preconditions(index)));
+    return artifact_id;
+  };
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::ARTIFACT_TYPE});
+  if (request.has_chunked_commit_options()) {
+    response->Clear();
+    return CommitInChunks(
+        request.artifacts(), request.chunked_commit_options(),
+        request.transaction_options(), write_executor, put_artifact,
+        response->mutable_artifact_ids(),
+        response->mutable_chunked_commit_result());
+  }
+  return write_executor.Execute(
+      [&request, &response, &put_artifact]() -> absl::Status {
+        response->Clear();
+        for (int i = 0; i < request.artifacts_size(); ++i) {
+          int64_t artifact_id = -1;
+          MLMD_ASSIGN_OR_RETURN(artifact_id, put_artifact(i));
+          response->add_artifact_ids(artifact_id);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
 }
 
 absl::Status MetadataStore::PutExecutions(const PutExecutionsRequest& request,
                                           PutExecutionsResponse* response) {
-  return transaction_executor_->Execute(
-      [this, &request, &response]() -> absl::Status {
+  return PutExecutions(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutExecutions(
+    const TransactionExecutor& transaction_executor,
+    const PutExecutionsRequest& request, PutExecutionsResponse* response) {
+  MLMD_RETURN_IF_ERROR(ValidateUpdatePreconditions(
+      request.update_preconditions_size(), request.executions_size()));
+  // Upserts the execution at `index` of the request and returns its id.
+  auto put_execution = [this, &request](int index) -> absl::StatusOr<int64_t> {
+    int64_t execution_id = -1;
+    MLMD_RETURN_IF_ERROR(UpsertExecution(
+        request.executions(index), metadata_access_object_.get(),
+        /*skip_type_and_property_validation=*/false,
+        /*force_update_time=*/false, request.update_mask(), &execution_id,
+        request.update_preconditions().empty()
+            ? UpdatePrecondition::default_instance()
+            : request.update_preconditions(index)));
+    return execution_id;
+  };
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE});
+  if (request.has_chunked_commit_options()) {
+    response->Clear();
+    return CommitInChunks(
+        request.executions(), request.chunked_commit_options(),
+        request.transaction_options(), write_executor, put_execution,
+        response->mutable_execution_ids(),
+        response->mutable_chunked_commit_result());
+  }
+  return write_executor.Execute(
+      [&request, &response, &put_execution]() -> absl::Status {
         response->Clear();
-        for (const Execution& execution : request.executions()) {
+        for (int i = 0; i < request.executions_size(); ++i) {
           int64_t execution_id = -1;
-          MLMD_RETURN_IF_ERROR(
-              UpsertExecution(execution, metadata_access_object_.get(),
-                              /*skip_type_and_property_validation=*/false,
-                              /*force_update_time=*/false,
-                              request.update_mask(), &execution_id));
+          MLMD_ASSIGN_OR_RETURN(execution_id, put_execution(i));
           response->add_execution_ids(execution_id);
         }
         return absl::OkStatus();
@@ -1201,15 +1578,39 @@ absl::Status MetadataStore::PutExecutions(const PutExecutionsRequest& request,
 
 absl::Status MetadataStore::PutContexts(const PutContextsRequest& request,
                                         PutContextsResponse* response) {
-  return transaction_executor_->Execute(
-      [this, &request, &response]() -> absl::Status {
+  return PutContexts(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutContexts(
+    const TransactionExecutor& transaction_executor,
+    const PutContextsRequest& request, PutContextsResponse* response) {
+  // Upserts the context at `index` of the request and returns its id.
+  auto put_context = [this, &request](int index) -> absl::StatusOr<int64_t> {
+    int64_t context_id = -1;
+    MLMD_RETURN_IF_ERROR(
+        UpsertContext(request.contexts(index), metadata_access_object_.get(),
+                      /*skip_type_and_property_validation=*/false,
+                      request.update_mask(), &context_id));
+    return context_id;
+  };
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::CONTEXT_TYPE});
+  if (request.has_chunked_commit_options()) {
+    response->Clear();
+    return CommitInChunks(
+        request.contexts(), request.chunked_commit_options(),
+        request.transaction_options(), write_executor, put_context,
+        response->mutable_context_ids(),
+        response->mutable_chunked_commit_result());
+  }
+  return write_executor.Execute(
+      [&request, &response, &put_context]() -> absl::Status {
         response->Clear();
-        for (const Context& context : request.contexts()) {
+        for (int i = 0; i < request.contexts_size(); ++i) {
           int64_t context_id = -1;
-          MLMD_RETURN_IF_ERROR(
-              UpsertContext(context, metadata_access_object_.get(),
-                            /*skip_type_and_property_validation=*/false,
-                            request.update_mask(), &context_id));
+          MLMD_ASSIGN_OR_RETURN(context_id, put_context(i));
           response->add_context_ids(context_id);
         }
         return absl::OkStatus();
@@ -1248,7 +1649,17 @@ absl::Status MetadataStore::Create(
 
 absl::Status MetadataStore::PutEvents(const PutEventsRequest& request,
                                       PutEventsResponse* response) {
-  return transaction_executor_->Execute(
+  return PutEvents(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutEvents(
+    const TransactionExecutor& transaction_executor,
+    const PutEventsRequest& request, PutEventsResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE});
+  return write_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         for (const Event& event : request.events()) {
@@ -1263,8 +1674,19 @@ absl::Status MetadataStore::PutEvents(const PutEventsRequest& request,
 
 absl::Status MetadataStore::PutExecution(const PutExecutionRequest& request,
                                          PutExecutionResponse* response) {
-  return transaction_executor_->Execute([this, &request,
-                                         &response]() -> absl::Status {
+  return PutExecution(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutExecution(
+    const TransactionExecutor& transaction_executor,
+    const PutExecutionRequest& request, PutExecutionResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE,
+       TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute([this, &request, &response]() -> absl::Status {
     response->Clear();
     if (!request.has_execution()) {
       return absl::InvalidArgumentError(
@@ -1359,7 +1781,13 @@ absl::Status MetadataStore::PutExecution(const PutExecutionRequest& request,
 absl::Status MetadataStore::PutLineageSubgraph(
     const PutLineageSubgraphRequest& request,
     PutLineageSubgraphResponse* response) {
-  return transaction_executor_->Execute(
+  const WriteTransactionExecutor write_executor(
+      transaction_executor_.get(), metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE,
+       TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
 
@@ -1481,7 +1909,14 @@ absl::Status MetadataStore::PutLineageSubgraph(
 absl::Status MetadataStore::GetEventsByExecutionIDs(
     const GetEventsByExecutionIDsRequest& request,
     GetEventsByExecutionIDsResponse* response) {
-  return transaction_executor_->Execute(
+  return GetEventsByExecutionIDs(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetEventsByExecutionIDs(
+    const TransactionExecutor& transaction_executor,
+    const GetEventsByExecutionIDsRequest& request,
+    GetEventsByExecutionIDsResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Event> events;
@@ -1506,7 +1941,14 @@ absl::Status MetadataStore::GetEventsByExecutionIDs(
 absl::Status MetadataStore::GetEventsByArtifactIDs(
     const GetEventsByArtifactIDsRequest& request,
     GetEventsByArtifactIDsResponse* response) {
-  return transaction_executor_->Execute(
+  return GetEventsByArtifactIDs(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetEventsByArtifactIDs(
+    const TransactionExecutor& transaction_executor,
+    const GetEventsByArtifactIDsRequest& request,
+    GetEventsByArtifactIDsResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Event> events;
@@ -1530,7 +1972,13 @@ absl::Status MetadataStore::GetEventsByArtifactIDs(
 
 absl::Status MetadataStore::GetExecutions(const GetExecutionsRequest& request,
                                           GetExecutionsResponse* response) {
-  return transaction_executor_->Execute(
+  return GetExecutions(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetExecutions(
+    const TransactionExecutor& transaction_executor,
+    const GetExecutionsRequest& request, GetExecutionsResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Execution> executions;
@@ -1563,7 +2011,13 @@ absl::Status MetadataStore::GetExecutions(const GetExecutionsRequest& request,
 
 absl::Status MetadataStore::GetArtifacts(const GetArtifactsRequest& request,
                                          GetArtifactsResponse* response) {
-  return transaction_executor_->Execute(
+  return GetArtifacts(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetArtifacts(
+    const TransactionExecutor& transaction_executor,
+    const GetArtifactsRequest& request, GetArtifactsResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Artifact> artifacts;
@@ -1597,7 +2051,13 @@ absl::Status MetadataStore::GetArtifacts(const GetArtifactsRequest& request,
 
 absl::Status MetadataStore::GetContexts(const GetContextsRequest& request,
                                         GetContextsResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContexts(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContexts(
+    const TransactionExecutor& transaction_executor,
+    const GetContextsRequest& request, GetContextsResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Context> contexts;
@@ -1738,20 +2198,20 @@ absl::Status MetadataStore::GetArtifactsByURI(
   return transaction_executor_->Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
-        absl::flat_hash_set<std::string> uris(request.uris().begin(),
-                                              request.uris().end());
-        for (const std::string& uri : uris) {
-          std::vector<Artifact> artifacts;
-          const absl::Status status =
-              metadata_access_object_->FindArtifactsByURI(uri, &artifacts);
-          if (!status.ok() && !absl::IsNotFound(status)) {
-            // If any none NotFound error returned, we do early stopping as
-            // the query execution has internal db errors.
-            return status;
-          }
-          for (const Artifact& artifact : artifacts) {
-            *response->mutable_artifacts()->Add() = artifact;
-          }
+        absl::flat_hash_set<absl::string_view> unique_uris(
+            request.uris().begin(), request.uris().end());
+        std::vector<absl::string_view> uris(unique_uris.begin(),
+                                            unique_uris.end());
+        // Looks up all the uris with a single query instead of one per uri.
+        std::vector<Artifact> artifacts;
+        const absl::Status status =
+            metadata_access_object_->FindArtifactsByURIs(absl::MakeSpan(uris),
+                                                         &artifacts);
+        if (!status.ok() && !absl::IsNotFound(status)) {
+          return status;
+        }
+        for (Artifact& artifact : artifacts) {
+          *response->add_artifacts() = std::move(artifact);
         }
         return absl::OkStatus();
       },
@@ -1800,7 +2260,14 @@ absl::Status MetadataStore::GetArtifactsByType(
 absl::Status MetadataStore::GetArtifactByTypeAndName(
     const GetArtifactByTypeAndNameRequest& request,
     GetArtifactByTypeAndNameResponse* response) {
-  return transaction_executor_->Execute(
+  return GetArtifactByTypeAndName(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetArtifactByTypeAndName(
+    const TransactionExecutor& transaction_executor,
+    const GetArtifactByTypeAndNameRequest& request,
+    GetArtifactByTypeAndNameResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         int64_t artifact_type_id;
@@ -1827,6 +2294,42 @@ absl::Status MetadataStore::GetArtifactByTypeAndName(
       request.transaction_options());
 }
 
+absl::Status MetadataStore::GetArtifactsByTypeAndNames(
+    const GetArtifactsByTypeAndNamesRequest& request,
+    GetArtifactsByTypeAndNamesResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        int64_t artifact_type_id;
+        absl::Status status =
+            metadata_access_object_->FindTypeIdByNameAndVersion(
+                request.type_name(), GetRequestTypeVersion(request),
+                TypeKind::ARTIFACT_TYPE, &artifact_type_id);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        std::vector<absl::string_view> artifact_names(
+            request.artifact_names().begin(), request.artifact_names().end());
+        std::vector<Artifact> artifacts;
+        status =
+            metadata_access_object_->FindArtifactsByTypeIdAndArtifactNames(
+                artifact_type_id, absl::MakeSpan(artifact_names), &artifacts);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        SortNodesByNames<Artifact>(artifact_names, artifacts);
+        for (Artifact& artifact : artifacts) {
+          *response->add_artifacts() = std::move(artifact);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
 absl::Status MetadataStore::GetArtifactsByExternalIds(
     const GetArtifactsByExternalIdsRequest& request,
     GetArtifactsByExternalIdsResponse* response) {
@@ -1894,7 +2397,14 @@ absl::Status MetadataStore::GetExecutionsByType(
 absl::Status MetadataStore::GetExecutionByTypeAndName(
     const GetExecutionByTypeAndNameRequest& request,
     GetExecutionByTypeAndNameResponse* response) {
-  return transaction_executor_->Execute(
+  return GetExecutionByTypeAndName(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetExecutionByTypeAndName(
+    const TransactionExecutor& transaction_executor,
+    const GetExecutionByTypeAndNameRequest& request,
+    GetExecutionByTypeAndNameResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         int64_t execution_type_id;
@@ -1921,6 +2431,42 @@ absl::Status MetadataStore::GetExecutionByTypeAndName(
       request.transaction_options());
 }
 
+absl::Status MetadataStore::GetExecutionsByTypeAndNames(
+    const GetExecutionsByTypeAndNamesRequest& request,
+    GetExecutionsByTypeAndNamesResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        int64_t execution_type_id;
+        absl::Status status =
+            metadata_access_object_->FindTypeIdByNameAndVersion(
+                request.type_name(), GetRequestTypeVersion(request),
+                TypeKind::EXECUTION_TYPE, &execution_type_id);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        std::vector<absl::string_view> execution_names(
+            request.execution_names().begin(), request.execution_names().end());
+        std::vector<Execution> executions;
+        status =
+            metadata_access_object_->FindExecutionsByTypeIdAndExecutionNames(
+                execution_type_id, absl::MakeSpan(execution_names), &executions);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        SortNodesByNames<Execution>(execution_names, executions);
+        for (Execution& execution : executions) {
+          *response->add_executions() = std::move(execution);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
 absl::Status MetadataStore::GetExecutionsByExternalIds(
     const GetExecutionsByExternalIdsRequest& request,
     GetExecutionsByExternalIdsResponse* response) {
@@ -1993,7 +2539,14 @@ absl::Status MetadataStore::GetContextsByType(
 absl::Status MetadataStore::GetContextByTypeAndName(
     const GetContextByTypeAndNameRequest& request,
     GetContextByTypeAndNameResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContextByTypeAndName(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContextByTypeAndName(
+    const TransactionExecutor& transaction_executor,
+    const GetContextByTypeAndNameRequest& request,
+    GetContextByTypeAndNameResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         int64_t context_type_id;
@@ -2021,6 +2574,42 @@ absl::Status MetadataStore::GetContextByTypeAndName(
       request.transaction_options());
 }
 
+absl::Status MetadataStore::GetContextsByTypeAndNames(
+    const GetContextsByTypeAndNamesRequest& request,
+    GetContextsByTypeAndNamesResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        int64_t context_type_id;
+        absl::Status status =
+            metadata_access_object_->FindTypeIdByNameAndVersion(
+                request.type_name(), GetRequestTypeVersion(request),
+                TypeKind::CONTEXT_TYPE, &context_type_id);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        std::vector<absl::string_view> context_names(
+            request.context_names().begin(), request.context_names().end());
+        std::vector<Context> contexts;
+        status =
+            metadata_access_object_->FindContextsByTypeIdAndContextNames(
+                context_type_id, absl::MakeSpan(context_names), &contexts);
+        if (absl::IsNotFound(status)) {
+          return absl::OkStatus();
+        } else if (!status.ok()) {
+          return status;
+        }
+        SortNodesByNames<Context>(context_names, contexts);
+        for (Context& context : contexts) {
+          *response->add_contexts() = std::move(context);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
 absl::Status MetadataStore::GetContextsByExternalIds(
     const GetContextsByExternalIdsRequest& request,
     GetContextsByExternalIdsResponse* response) {
@@ -2045,10 +2634,111 @@ absl::Status MetadataStore::GetContextsByExternalIds(
       request.transaction_options());
 }
 
+absl::Status MetadataStore::SetProperties(const SetPropertiesRequest& request,
+                                          SetPropertiesResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      transaction_executor_.get(), metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE,
+       TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        const absl::Time update_timestamp = absl::Now();
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->SetArtifactProperties(
+            request.artifact_ids(), request.properties(),
+            request.custom_properties(), update_timestamp));
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->SetExecutionProperties(
+            request.execution_ids(), request.properties(),
+            request.custom_properties(), update_timestamp));
+        return metadata_access_object_->SetContextProperties(
+            request.context_ids(), request.properties(),
+            request.custom_properties(), update_timestamp);
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::DeleteProperties(
+    const DeletePropertiesRequest& request,
+    DeletePropertiesResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      transaction_executor_.get(), metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE,
+       TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        const absl::Time update_timestamp = absl::Now();
+        const std::vector<std::string> property_names(
+            request.property_names().begin(), request.property_names().end());
+        const std::vector<std::string> custom_property_names(
+            request.custom_property_names().begin(),
+            request.custom_property_names().end());
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->DeleteArtifactProperties(
+            request.artifact_ids(), property_names, custom_property_names,
+            update_timestamp));
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->DeleteExecutionProperties(
+            request.execution_ids(), property_names, custom_property_names,
+            update_timestamp));
+        return metadata_access_object_->DeleteContextProperties(
+            request.context_ids(), property_names, custom_property_names,
+            update_timestamp);
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::ClaimExecutions(
+    const ClaimExecutionsRequest& request, ClaimExecutionsResponse* response) {
+  if (request.type_name().empty()) {
+    return absl::InvalidArgumentError("type_name must be set.");
+  }
+  if (request.max_num_executions() <= 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "max_num_executions must be positive, but got ",
+        request.max_num_executions(), "."));
+  }
+  const WriteTransactionExecutor write_executor(
+      transaction_executor_.get(), metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE});
+  return write_executor.Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        std::vector<Execution> executions;
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->ClaimExecutions(
+            request.type_name(), GetRequestTypeVersion(request),
+            request.current_state(), request.new_state(),
+            request.max_num_executions(), request.lease_properties(),
+            absl::Now(), &executions));
+        for (Execution& execution : executions) {
+          *response->add_executions() = std::move(execution);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
 absl::Status MetadataStore::PutAttributionsAndAssociations(
     const PutAttributionsAndAssociationsRequest& request,
     PutAttributionsAndAssociationsResponse* response) {
-  return transaction_executor_->Execute(
+  return PutAttributionsAndAssociations(*transaction_executor_, request,
+                                        response);
+}
+
+absl::Status MetadataStore::PutAttributionsAndAssociations(
+    const TransactionExecutor& transaction_executor,
+    const PutAttributionsAndAssociationsRequest& request,
+    PutAttributionsAndAssociationsResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::EXECUTION_TYPE,
+       TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         for (const Attribution& attribution : request.attributions()) {
@@ -2069,7 +2759,18 @@ absl::Status MetadataStore::PutAttributionsAndAssociations(
 absl::Status MetadataStore::PutParentContexts(
     const PutParentContextsRequest& request,
     PutParentContextsResponse* response) {
-  return transaction_executor_->Execute(
+  return PutParentContexts(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::PutParentContexts(
+    const TransactionExecutor& transaction_executor,
+    const PutParentContextsRequest& request,
+    PutParentContextsResponse* response) {
+  const WriteTransactionExecutor write_executor(
+      &transaction_executor, metadata_access_object_.get(),
+      enable_database_write_epochs_,
+      {TypeKind::CONTEXT_TYPE});
+  return write_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         for (const ParentContext& parent_context : request.parent_contexts()) {
@@ -2084,7 +2785,14 @@ absl::Status MetadataStore::PutParentContexts(
 absl::Status MetadataStore::GetContextsByArtifact(
     const GetContextsByArtifactRequest& request,
     GetContextsByArtifactResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContextsByArtifact(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContextsByArtifact(
+    const TransactionExecutor& transaction_executor,
+    const GetContextsByArtifactRequest& request,
+    GetContextsByArtifactResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Context> contexts;
@@ -2101,7 +2809,14 @@ absl::Status MetadataStore::GetContextsByArtifact(
 absl::Status MetadataStore::GetContextsByExecution(
     const GetContextsByExecutionRequest& request,
     GetContextsByExecutionResponse* response) {
-  return transaction_executor_->Execute(
+  return GetContextsByExecution(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetContextsByExecution(
+    const TransactionExecutor& transaction_executor,
+    const GetContextsByExecutionRequest& request,
+    GetContextsByExecutionResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Context> contexts;
@@ -2118,7 +2833,14 @@ absl::Status MetadataStore::GetContextsByExecution(
 absl::Status MetadataStore::GetArtifactsByContext(
     const GetArtifactsByContextRequest& request,
     GetArtifactsByContextResponse* response) {
-  return transaction_executor_->Execute(
+  return GetArtifactsByContext(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetArtifactsByContext(
+    const TransactionExecutor& transaction_executor,
+    const GetArtifactsByContextRequest& request,
+    GetArtifactsByContextResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Artifact> artifacts;
@@ -2145,7 +2867,14 @@ absl::Status MetadataStore::GetArtifactsByContext(
 absl::Status MetadataStore::GetExecutionsByContext(
     const GetExecutionsByContextRequest& request,
     GetExecutionsByContextResponse* response) {
-  return transaction_executor_->Execute(
+  return GetExecutionsByContext(*transaction_executor_, request, response);
+}
+
+absl::Status MetadataStore::GetExecutionsByContext(
+    const TransactionExecutor& transaction_executor,
+    const GetExecutionsByContextRequest& request,
+    GetExecutionsByContextResponse* response) {
+  return transaction_executor.Execute(
       [this, &request, &response]() -> absl::Status {
         response->Clear();
         std::vector<Execution> executions;
@@ -2286,9 +3015,256 @@ absl::Status MetadataStore::GetLineageSubgraph(
   return transaction_executor_->Execute(
       [&]() -> absl::Status {
         response->Clear();
-        return metadata_access_object_->QueryLineageSubgraph(
+        bool is_truncated = false;
+        std::optional<int64_t> known_type_catalog_version;
+        if (request.has_known_type_catalog_version()) {
+          known_type_catalog_version = request.known_type_catalog_version();
+        }
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->QueryLineageSubgraph(
             request.lineage_subgraph_query_options(), read_mask,
-            *response->mutable_lineage_subgraph());
+            known_type_catalog_version, *response->mutable_lineage_subgraph(),
+            &is_truncated));
+        if (is_truncated) {
+          response->set_is_truncated(true);
+        }
+        int64_t type_catalog_version = 0;
+        const absl::Status status =
+            metadata_access_object_->FindTypeCatalogVersion(
+                &type_catalog_version);
+        // Without a known version, the type catalog version is best-effort,
+        // as clients of an earlier schema have no type catalog.
+        if (absl::IsFailedPrecondition(status) &&
+            !known_type_catalog_version.has_value()) {
+          return absl::OkStatus();
+        }
+        MLMD_RETURN_IF_ERROR(status);
+        response->set_type_catalog_version(type_catalog_version);
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::GetTypeCatalog(const GetTypeCatalogRequest& request,
+                                           GetTypeCatalogResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        int64_t type_catalog_version = 0;
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->FindTypeCatalogVersion(
+            &type_catalog_version));
+        response->set_type_catalog_version(type_catalog_version);
+        if (request.known_type_catalog_version() >= type_catalog_version) {
+          return absl::OkStatus();
+        }
+        std::vector<ArtifactType> artifact_types;
+        std::vector<ExecutionType> execution_types;
+        std::vector<ContextType> context_types;
+        MLMD_RETURN_IF_ERROR(
+            metadata_access_object_->FindTypesChangedAfterCatalogVersion(
+                request.known_type_catalog_version(), &artifact_types,
+                &execution_types, &context_types));
+        absl::c_move(artifact_types, google::protobuf::RepeatedPtrFieldBackInserter(
+                                         response->mutable_artifact_types()));
+        absl::c_move(execution_types,
+                     google::protobuf::RepeatedPtrFieldBackInserter(
+                         response->mutable_execution_types()));
+        absl::c_move(context_types, google::protobuf::RepeatedPtrFieldBackInserter(
+                                        response->mutable_context_types()));
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::ExecuteBatch(const ExecuteBatchRequest& request,
+                                         ExecuteBatchResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        // The calls open no transactions of their own while the batch runs.
+        const OpenTransactionExecutor batch_executor;
+        for (int i = 0; i < request.calls_size(); ++i) {
+          const absl::Status status = ExecuteBatchCall(
+              batch_executor, request.calls(i), response->add_results());
+          if (!status.ok()) {
+            return absl::Status(
+                status.code(),
+                absl::StrCat("Call ", i, " of the batch failed: ",
+                             status.message()));
+          }
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::ExecuteBatchCall(
+    const TransactionExecutor& transaction_executor,
+    const ExecuteBatchRequest::Call& call,
+    ExecuteBatchResponse::Result* result) {
+  // Chunked commits need transactions of their own.
+  if (call.put_artifacts().has_chunked_commit_options() ||
+      call.put_executions().has_chunked_commit_options() ||
+      call.put_contexts().has_chunked_commit_options()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Chunked commits cannot run in a batch: ", call.ShortDebugString()));
+  }
+  switch (call.request_case()) {
+    case ExecuteBatchRequest::Call::kPutArtifactType:
+      return PutArtifactType(transaction_executor, call.put_artifact_type(),
+                             result->mutable_put_artifact_type());
+    case ExecuteBatchRequest::Call::kPutExecutionType:
+      return PutExecutionType(transaction_executor, call.put_execution_type(),
+                              result->mutable_put_execution_type());
+    case ExecuteBatchRequest::Call::kPutContextType:
+      return PutContextType(transaction_executor, call.put_context_type(),
+                            result->mutable_put_context_type());
+    case ExecuteBatchRequest::Call::kGetArtifactType:
+      return GetArtifactType(transaction_executor, call.get_artifact_type(),
+                             result->mutable_get_artifact_type());
+    case ExecuteBatchRequest::Call::kGetExecutionType:
+      return GetExecutionType(transaction_executor, call.get_execution_type(),
+                              result->mutable_get_execution_type());
+    case ExecuteBatchRequest::Call::kGetContextType:
+      return GetContextType(transaction_executor, call.get_context_type(),
+                            result->mutable_get_context_type());
+    case ExecuteBatchRequest::Call::kPutArtifacts:
+      return PutArtifacts(transaction_executor, call.put_artifacts(),
+                          result->mutable_put_artifacts());
+    case ExecuteBatchRequest::Call::kPutExecutions:
+      return PutExecutions(transaction_executor, call.put_executions(),
+                           result->mutable_put_executions());
+    case ExecuteBatchRequest::Call::kPutContexts:
+      return PutContexts(transaction_executor, call.put_contexts(),
+                         result->mutable_put_contexts());
+    case ExecuteBatchRequest::Call::kPutEvents:
+      return PutEvents(transaction_executor, call.put_events(),
+                       result->mutable_put_events());
+    case ExecuteBatchRequest::Call::kPutExecution:
+      return PutExecution(transaction_executor, call.put_execution(),
+                          result->mutable_put_execution());
+    case ExecuteBatchRequest::Call::kPutAttributionsAndAssociations:
+      return PutAttributionsAndAssociations(
+          transaction_executor, call.put_attributions_and_associations(),
+          result->mutable_put_attributions_and_associations());
+    case ExecuteBatchRequest::Call::kPutParentContexts:
+      return PutParentContexts(transaction_executor, call.put_parent_contexts(),
+                               result->mutable_put_parent_contexts());
+    case ExecuteBatchRequest::Call::kGetArtifactsById:
+      return GetArtifactsByID(transaction_executor, call.get_artifacts_by_id(),
+                              result->mutable_get_artifacts_by_id());
+    case ExecuteBatchRequest::Call::kGetExecutionsById:
+      return GetExecutionsByID(transaction_executor,
+                               call.get_executions_by_id(),
+                               result->mutable_get_executions_by_id());
+    case ExecuteBatchRequest::Call::kGetContextsById:
+      return GetContextsByID(transaction_executor, call.get_contexts_by_id(),
+                             result->mutable_get_contexts_by_id());
+    case ExecuteBatchRequest::Call::kGetArtifacts:
+      return GetArtifacts(transaction_executor, call.get_artifacts(),
+                          result->mutable_get_artifacts());
+    case ExecuteBatchRequest::Call::kGetExecutions:
+      return GetExecutions(transaction_executor, call.get_executions(),
+                           result->mutable_get_executions());
+    case ExecuteBatchRequest::Call::kGetContexts:
+      return GetContexts(transaction_executor, call.get_contexts(),
+                         result->mutable_get_contexts());
+    case ExecuteBatchRequest::Call::kGetArtifactByTypeAndName:
+      return GetArtifactByTypeAndName(
+          transaction_executor, call.get_artifact_by_type_and_name(),
+          result->mutable_get_artifact_by_type_and_name());
+    case ExecuteBatchRequest::Call::kGetExecutionByTypeAndName:
+      return GetExecutionByTypeAndName(
+          transaction_executor, call.get_execution_by_type_and_name(),
+          result->mutable_get_execution_by_type_and_name());
+    case ExecuteBatchRequest::Call::kGetContextByTypeAndName:
+      return GetContextByTypeAndName(
+          transaction_executor, call.get_context_by_type_and_name(),
+          result->mutable_get_context_by_type_and_name());
+    case ExecuteBatchRequest::Call::kGetEventsByArtifactIds:
+      return GetEventsByArtifactIDs(
+          transaction_executor, call.get_events_by_artifact_ids(),
+          result->mutable_get_events_by_artifact_ids());
+    case ExecuteBatchRequest::Call::kGetEventsByExecutionIds:
+      return GetEventsByExecutionIDs(
+          transaction_executor, call.get_events_by_execution_ids(),
+          result->mutable_get_events_by_execution_ids());
+    case ExecuteBatchRequest::Call::kGetContextsByArtifact:
+      return GetContextsByArtifact(transaction_executor,
+                                   call.get_contexts_by_artifact(),
+                                   result->mutable_get_contexts_by_artifact());
+    case ExecuteBatchRequest::Call::kGetContextsByExecution:
+      return GetContextsByExecution(
+          transaction_executor, call.get_contexts_by_execution(),
+          result->mutable_get_contexts_by_execution());
+    case ExecuteBatchRequest::Call::kGetArtifactsByContext:
+      return GetArtifactsByContext(transaction_executor,
+                                   call.get_artifacts_by_context(),
+                                   result->mutable_get_artifacts_by_context());
+    case ExecuteBatchRequest::Call::kGetExecutionsByContext:
+      return GetExecutionsByContext(
+          transaction_executor, call.get_executions_by_context(),
+          result->mutable_get_executions_by_context());
+    case ExecuteBatchRequest::Call::REQUEST_NOT_SET:
+      break;
+  }
+  return absl::InvalidArgumentError(
+      absl::StrCat("The call has no request: ", call.ShortDebugString()));
+}
+
+absl::Status MetadataStore::GetWriteEpochs(const GetWriteEpochsRequest& request,
+                                           GetWriteEpochsResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &response]() -> absl::Status {
+        response->Clear();
+        int64_t artifact_write_epoch = 0;
+        int64_t execution_write_epoch = 0;
+        int64_t context_write_epoch = 0;
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->FindWriteEpochs(
+            &artifact_write_epoch, &execution_write_epoch,
+            &context_write_epoch));
+        response->set_artifact_write_epoch(artifact_write_epoch);
+        response->set_execution_write_epoch(execution_write_epoch);
+        response->set_context_write_epoch(context_write_epoch);
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::GetContextSummaries(
+    const GetContextSummariesRequest& request,
+    GetContextSummariesResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        std::vector<int64_t> context_ids;
+        absl::flat_hash_set<int64_t> seen_context_ids;
+        for (const int64_t context_id : request.context_ids()) {
+          if (seen_context_ids.insert(context_id).second) {
+            context_ids.push_back(context_id);
+          }
+        }
+        if (context_ids.empty()) {
+          return absl::OkStatus();
+        }
+        std::vector<ContextSummary> context_summaries;
+        MLMD_RETURN_IF_ERROR(metadata_access_object_->FindContextSummaries(
+            context_ids, &context_summaries));
+        for (ContextSummary& context_summary : context_summaries) {
+          *response->add_context_summaries() = std::move(context_summary);
+        }
+        return absl::OkStatus();
+      },
+      request.transaction_options());
+}
+
+absl::Status MetadataStore::RebuildContextSummaries(
+    const RebuildContextSummariesRequest& request,
+    RebuildContextSummariesResponse* response) {
+  return transaction_executor_->Execute(
+      [this, &request, &response]() -> absl::Status {
+        response->Clear();
+        return metadata_access_object_->RebuildContextSummaries(
+            request.context_ids());
       },
       request.transaction_options());
 }
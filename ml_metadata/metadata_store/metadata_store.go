@@ -613,6 +613,22 @@ func (store *Store) GetContextByTypeAndName(typeName string, contextName string)
 	return resp.GetContext(), err
 }
 
+// ExecuteBatch runs `calls` in order in a single transaction, and returns their
+// results index-aligned with `calls`. The batch crosses into the cc library
+// once, so it costs much less than issuing the calls one by one when they are
+// small. The TransactionOptions of the calls are ignored.
+//
+// It returns an error if any of the calls fails, in which case none of them is
+// committed.
+func (store *Store) ExecuteBatch(calls []*apipb.ExecuteBatchRequest_Call) ([]*apipb.ExecuteBatchResponse_Result, error) {
+	req := &apipb.ExecuteBatchRequest{
+		Calls: calls,
+	}
+	resp := &apipb.ExecuteBatchResponse{}
+	err := store.callMetadataStoreWrapMethod(wrap.ExecuteBatch, req, resp)
+	return resp.GetResults(), err
+}
+
 type metadataStoreMethod func(wrap.Ml_metadata_MetadataStore, string, wrap.Absl_Status) string
 
 // callMetadataStoreWrapMethod calls a `metadataStoreMethod` in cc library.
@@ -250,6 +250,30 @@ class MetadataStore : public MetadataStoreServiceInterface {
   absl::Status PutContexts(const PutContextsRequest& request,
                            PutContextsResponse* response) override;
 
+  // Sets properties and custom properties of the given nodes without reading
+  // their stored properties.
+  // Returns INVALID_ARGUMENT error, if any node cannot be found.
+  // Returns INVALID_ARGUMENT error, if given property names and types do not
+  // align with the types of the nodes.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status SetProperties(const SetPropertiesRequest& request,
+                             SetPropertiesResponse* response) override;
+
+  // Deletes properties and custom properties of the given nodes by name.
+  // Returns INVALID_ARGUMENT error, if any node cannot be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status DeleteProperties(const DeletePropertiesRequest& request,
+                                DeletePropertiesResponse* response) override;
+
+  // Claims up to max_num_executions executions of a type in current_state,
+  // sets them to new_state with the lease properties and returns them.
+  // Returns INVALID_ARGUMENT error, if type_name is not given or
+  // max_num_executions is not positive.
+  // Returns NOT_FOUND error, if the execution type cannot be found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status ClaimExecutions(const ClaimExecutionsRequest& request,
+                               ClaimExecutionsResponse* response) override;
+
   // Inserts events into the database.
   //
   // The execution_id and artifact_id must already exist.
@@ -328,6 +352,9 @@ class MetadataStore : public MetadataStoreServiceInterface {
 
   // Gets a list of artifacts by ID.
   // If no artifact with an ID exists, the artifact is skipped.
+  // If `known_last_update_time_since_epoch` is given, the artifacts not changed
+  // since then are checked without hydration, and returned as
+  // `unchanged_artifact_ids`.
   // Sets the error field if any other internal errors are returned.
   // Returns detailed INTERNAL error, if query execution fails.
   absl::Status GetArtifactsByID(const GetArtifactsByIDRequest& request,
@@ -362,6 +389,15 @@ class MetadataStore : public MetadataStoreServiceInterface {
       const GetArtifactByTypeAndNameRequest& request,
       GetArtifactByTypeAndNameResponse* response) override;
 
+  // Gets the artifacts of a given type and names with a single query. Each
+  // found artifact is returned once, in the order of the first occurrence of
+  // its name, and the names without a matching artifact are skipped. If the
+  // type is not found, it returns OK and empty response.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetArtifactsByTypeAndNames(
+      const GetArtifactsByTypeAndNamesRequest& request,
+      GetArtifactsByTypeAndNamesResponse* response) override;
+
   // Gets all the artifacts matching the given URIs. If no artifacts found, it
   // returns OK and empty response.
   // Returns detailed INTERNAL error, if query execution fails.
@@ -370,6 +406,9 @@ class MetadataStore : public MetadataStoreServiceInterface {
 
   // Gets a list of executions by ID.
   // If no execution with an ID exists, the execution is skipped.
+  // If `known_last_update_time_since_epoch` is given, the executions not
+  // changed since then are checked without hydration, and returned as
+  // `unchanged_execution_ids`.
   // Sets the error field if any other internal errors are returned.
   // Returns detailed INTERNAL error, if query execution fails.
   absl::Status GetExecutionsByID(const GetExecutionsByIDRequest& request,
@@ -395,6 +434,15 @@ class MetadataStore : public MetadataStoreServiceInterface {
       const GetExecutionByTypeAndNameRequest& request,
       GetExecutionByTypeAndNameResponse* response) override;
 
+  // Gets the executions of a given type and names with a single query. Each
+  // found execution is returned once, in the order of the first occurrence of
+  // its name, and the names without a matching execution are skipped. If the
+  // type is not found, it returns OK and empty response.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetExecutionsByTypeAndNames(
+      const GetExecutionsByTypeAndNamesRequest& request,
+      GetExecutionsByTypeAndNamesResponse* response) override;
+
   // Gets a list of executions using external_ids.
   // |external_ids| is a list of non-null strings for the given external ids.
   // Returns INVALID_ARGUMENT error, if any of the |external_ids| is empty.
@@ -406,6 +454,9 @@ class MetadataStore : public MetadataStoreServiceInterface {
 
   // Gets a list of contexts by ID.
   // If no context with an ID exists, the context is skipped.
+  // If `known_last_update_time_since_epoch` is given, the contexts not changed
+  // since then are checked without hydration, and returned as
+  // `unchanged_context_ids`.
   // Sets the error field if any other internal errors are returned.
   // Returns detailed INTERNAL error, if query execution fails.
   absl::Status GetContextsByID(const GetContextsByIDRequest& request,
@@ -430,6 +481,15 @@ class MetadataStore : public MetadataStoreServiceInterface {
       const GetContextByTypeAndNameRequest& request,
       GetContextByTypeAndNameResponse* response) override;
 
+  // Gets the contexts of a given type and names with a single query. Each found
+  // context is returned once, in the order of the first occurrence of its name,
+  // and the names without a matching context are skipped. If the type is not
+  // found, it returns OK and empty response.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetContextsByTypeAndNames(
+      const GetContextsByTypeAndNamesRequest& request,
+      GetContextsByTypeAndNamesResponse* response) override;
+
   // Gets a list of contexts using external_ids.
   // |external_ids| is a list of non-null strings for the given external ids.
   // Returns INVALID_ARGUMENT error, if any of the |external_ids| is empty.
@@ -526,7 +586,64 @@ class MetadataStore : public MetadataStoreServiceInterface {
       const GetLineageSubgraphRequest& request,
       GetLineageSubgraphResponse* response) override;
 
-
+  // Gets the current type catalog version, and the types created or changed
+  // after `known_type_catalog_version` in the request.
+  // Returns FAILED_PRECONDITION error, if the schema has no type catalog.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetTypeCatalog(const GetTypeCatalogRequest& request,
+                              GetTypeCatalogResponse* response) override;
+
+  // Gets the write epochs of artifacts, executions and contexts. The epochs
+  // only move with the writes of stores that have database write epochs
+  // enabled, see set_enable_database_write_epochs().
+  // Returns FAILED_PRECONDITION error, if the schema has no write epochs.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetWriteEpochs(const GetWriteEpochsRequest& request,
+                              GetWriteEpochsResponse* response) override;
+
+  // Gets the number of executions and artifacts of the given contexts, by type
+  // and state, in one summary per distinct context id. The summaries are only
+  // kept up to date by stores with context summaries enabled, see
+  // set_enable_context_summaries().
+  // Returns FAILED_PRECONDITION error, if the schema has no context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status GetContextSummaries(
+      const GetContextSummariesRequest& request,
+      GetContextSummariesResponse* response) override;
+
+  // Recomputes the summaries of the given contexts, or of all contexts if no
+  // context id is given, from their associations and attributions.
+  // Returns FAILED_PRECONDITION error, if the schema has no context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status RebuildContextSummaries(
+      const RebuildContextSummariesRequest& request,
+      RebuildContextSummariesResponse* response) override;
+
+  // Runs the calls of the request in order in a single transaction, and
+  // returns their responses in the same order. Language bindings use it to
+  // cross into the library once for many small calls.
+  // Returns INVALID_ARGUMENT error, if a call has no request, or sets
+  // chunked_commit_options.
+  // Returns the error of the first failed call, annotated with its index, in
+  // which case none of the calls is committed.
+  absl::Status ExecuteBatch(const ExecuteBatchRequest& request,
+                            ExecuteBatchResponse* response);
+
+  // If `enable` is true, every write increases the write epochs stored in the
+  // database of the node kinds it changes, in the transaction of the write.
+  // This serializes the writes of each node kind on one row, so it is off by
+  // default, and only needed if readers use GetWriteEpochs.
+  void set_enable_database_write_epochs(bool enable) {
+    enable_database_write_epochs_ = enable;
+  }
+
+  // If `enable` is true, the writes of associations, attributions and node
+  // states update the context summaries returned by GetContextSummaries, in
+  // the transaction of the write. It is off by default, as it adds an upsert
+  // of the summary rows to each of those writes.
+  void set_enable_context_summaries(bool enable) {
+    metadata_access_object_->set_maintain_context_summaries(enable);
+  }
 
  private:
   // To construct the object, see Create(...).
@@ -534,9 +651,118 @@ class MetadataStore : public MetadataStoreServiceInterface {
                 std::unique_ptr<MetadataAccessObject> metadata_access_object,
                 std::unique_ptr<TransactionExecutor> transaction_executor);
 
+  // Runs `call` with `transaction_executor`, and sets its response in
+  // `result`.
+  absl::Status ExecuteBatchCall(const TransactionExecutor& transaction_executor,
+                                const ExecuteBatchRequest::Call& call,
+                                ExecuteBatchResponse::Result* result);
+
+  // The calls that ExecuteBatch runs, with their transactions run by
+  // `transaction_executor`. The public methods of the same names run them
+  // with `transaction_executor_`.
+  absl::Status PutArtifactType(const TransactionExecutor& transaction_executor,
+                               const PutArtifactTypeRequest& request,
+                               PutArtifactTypeResponse* response);
+  absl::Status PutExecutionType(const TransactionExecutor& transaction_executor,
+                                const PutExecutionTypeRequest& request,
+                                PutExecutionTypeResponse* response);
+  absl::Status PutContextType(const TransactionExecutor& transaction_executor,
+                              const PutContextTypeRequest& request,
+                              PutContextTypeResponse* response);
+  absl::Status GetArtifactType(const TransactionExecutor& transaction_executor,
+                               const GetArtifactTypeRequest& request,
+                               GetArtifactTypeResponse* response);
+  absl::Status GetExecutionType(const TransactionExecutor& transaction_executor,
+                                const GetExecutionTypeRequest& request,
+                                GetExecutionTypeResponse* response);
+  absl::Status GetContextType(const TransactionExecutor& transaction_executor,
+                              const GetContextTypeRequest& request,
+                              GetContextTypeResponse* response);
+  absl::Status PutArtifacts(const TransactionExecutor& transaction_executor,
+                            const PutArtifactsRequest& request,
+                            PutArtifactsResponse* response);
+  absl::Status PutExecutions(const TransactionExecutor& transaction_executor,
+                             const PutExecutionsRequest& request,
+                             PutExecutionsResponse* response);
+  absl::Status PutContexts(const TransactionExecutor& transaction_executor,
+                           const PutContextsRequest& request,
+                           PutContextsResponse* response);
+  absl::Status PutEvents(const TransactionExecutor& transaction_executor,
+                         const PutEventsRequest& request,
+                         PutEventsResponse* response);
+  absl::Status PutExecution(const TransactionExecutor& transaction_executor,
+                            const PutExecutionRequest& request,
+                            PutExecutionResponse* response);
+  absl::Status PutAttributionsAndAssociations(
+      const TransactionExecutor& transaction_executor,
+      const PutAttributionsAndAssociationsRequest& request,
+      PutAttributionsAndAssociationsResponse* response);
+  absl::Status PutParentContexts(
+      const TransactionExecutor& transaction_executor,
+      const PutParentContextsRequest& request,
+      PutParentContextsResponse* response);
+  absl::Status GetArtifactsByID(const TransactionExecutor& transaction_executor,
+                                const GetArtifactsByIDRequest& request,
+                                GetArtifactsByIDResponse* response);
+  absl::Status GetExecutionsByID(
+      const TransactionExecutor& transaction_executor,
+      const GetExecutionsByIDRequest& request,
+      GetExecutionsByIDResponse* response);
+  absl::Status GetContextsByID(const TransactionExecutor& transaction_executor,
+                               const GetContextsByIDRequest& request,
+                               GetContextsByIDResponse* response);
+  absl::Status GetArtifacts(const TransactionExecutor& transaction_executor,
+                            const GetArtifactsRequest& request,
+                            GetArtifactsResponse* response);
+  absl::Status GetExecutions(const TransactionExecutor& transaction_executor,
+                             const GetExecutionsRequest& request,
+                             GetExecutionsResponse* response);
+  absl::Status GetContexts(const TransactionExecutor& transaction_executor,
+                           const GetContextsRequest& request,
+                           GetContextsResponse* response);
+  absl::Status GetArtifactByTypeAndName(
+      const TransactionExecutor& transaction_executor,
+      const GetArtifactByTypeAndNameRequest& request,
+      GetArtifactByTypeAndNameResponse* response);
+  absl::Status GetExecutionByTypeAndName(
+      const TransactionExecutor& transaction_executor,
+      const GetExecutionByTypeAndNameRequest& request,
+      GetExecutionByTypeAndNameResponse* response);
+  absl::Status GetContextByTypeAndName(
+      const TransactionExecutor& transaction_executor,
+      const GetContextByTypeAndNameRequest& request,
+      GetContextByTypeAndNameResponse* response);
+  absl::Status GetEventsByArtifactIDs(
+      const TransactionExecutor& transaction_executor,
+      const GetEventsByArtifactIDsRequest& request,
+      GetEventsByArtifactIDsResponse* response);
+  absl::Status GetEventsByExecutionIDs(
+      const TransactionExecutor& transaction_executor,
+      const GetEventsByExecutionIDsRequest& request,
+      GetEventsByExecutionIDsResponse* response);
+  absl::Status GetContextsByArtifact(
+      const TransactionExecutor& transaction_executor,
+      const GetContextsByArtifactRequest& request,
+      GetContextsByArtifactResponse* response);
+  absl::Status GetContextsByExecution(
+      const TransactionExecutor& transaction_executor,
+      const GetContextsByExecutionRequest& request,
+      GetContextsByExecutionResponse* response);
+  absl::Status GetArtifactsByContext(
+      const TransactionExecutor& transaction_executor,
+      const GetArtifactsByContextRequest& request,
+      GetArtifactsByContextResponse* response);
+  absl::Status GetExecutionsByContext(
+      const TransactionExecutor& transaction_executor,
+      const GetExecutionsByContextRequest& request,
+      GetExecutionsByContextResponse* response);
+
   std::unique_ptr<MetadataSource> metadata_source_;
   std::unique_ptr<MetadataAccessObject> metadata_access_object_;
   std::unique_ptr<TransactionExecutor> transaction_executor_;
+
+  // Whether writes increase the write epochs stored in the database.
+  bool enable_database_write_epochs_ = false;
 };
 
 }  // namespace ml_metadata
@@ -0,0 +1,361 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/metadata_store_admin_service_impl.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <glog/logging.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/sqlite_metadata_source.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+#ifdef MLMD_ENABLE_GPERFTOOLS
+#include "gperftools/malloc_extension.h"
+#include "gperftools/profiler.h"
+#endif
+
+namespace ml_metadata {
+namespace {
+
+constexpr int64_t kMaxCpuProfileSeconds = 120;
+
+// The interval of the progress logs of a backup.
+constexpr absl::Duration kBackupProgressLogInterval = absl::Seconds(10);
+
+// The interval of the progress messages streamed to the client of a backup.
+constexpr absl::Duration kBackupProgressMessageInterval = absl::Seconds(1);
+
+// Returns the file name of a profile of `kind` collected now.
+std::string ProfileFileName(absl::string_view kind) {
+  return absl::StrCat(kind, ".", getpid(), ".",
+                      absl::FormatTime("%Y%m%d-%H%M%S", absl::Now(),
+                                       absl::UTCTimeZone()),
+                      ".prof");
+}
+
+#ifdef MLMD_ENABLE_GPERFTOOLS
+// Collects a CPU profile for `duration` into `response`, or until the client
+// cancels the call.
+::grpc::Status CollectCpuProfile(::grpc::ServerContext* context,
+                                 absl::Duration duration,
+                                 ProfileResponse* response) {
+  const std::string file_name = ProfileFileName("cpu");
+  const std::string path =
+      (std::filesystem::temp_directory_path() / file_name).string();
+  if (!ProfilerStart(path.c_str())) {
+    return ::grpc::Status(::grpc::StatusCode::INTERNAL,
+                          absl::StrCat("Cannot start the profiler: ", path));
+  }
+  const absl::Time deadline = absl::Now() + duration;
+  while (absl::Now() < deadline && !context->IsCancelled()) {
+    absl::SleepFor(std::min(absl::Milliseconds(100), deadline - absl::Now()));
+  }
+  ProfilerStop();
+  std::ifstream profile(path, std::ios::binary);
+  std::stringstream content;
+  content << profile.rdbuf();
+  std::remove(path.c_str());
+  if (context->IsCancelled()) {
+    return ::grpc::Status(::grpc::StatusCode::CANCELLED,
+                          "The CPU profile is cancelled.");
+  }
+  response->set_file_name(file_name);
+  response->set_content(content.str());
+  LOG(INFO) << "Collected a CPU profile of " << duration << ", "
+            << response->content().size() << " bytes.";
+  return ::grpc::Status::OK;
+}
+#endif
+
+// Fills `cache_statistics` with the counters of `cache`, which is a
+// ListResultCache or a SerializedNodeCache.
+template <typename Cache>
+void SetCacheStatistics(
+    const Cache& cache,
+    GetServerStatsResponse::CacheStatistics* cache_statistics) {
+  cache_statistics->set_num_hits(cache.num_hits());
+  cache_statistics->set_num_misses(cache.num_misses());
+  cache_statistics->set_num_entries(cache.num_entries());
+  cache_statistics->set_num_bytes(cache.num_bytes());
+}
+
+// Fills `response` with `progress`.
+void SetBackupProgress(const SqliteMetadataSource::BackupProgress& progress,
+                       BackupSqliteDatabaseResponse* response) {
+  response->set_num_copied_pages(progress.num_copied_pages);
+  response->set_num_pages(progress.num_total_pages);
+  response->set_page_size_bytes(progress.page_size_bytes);
+  response->set_num_steps(progress.num_steps);
+  response->set_num_restarts(progress.num_restarts);
+  response->set_elapsed_milliseconds(
+      absl::ToInt64Milliseconds(progress.elapsed_time));
+}
+
+// Returns the path of the backup `file_name` in `backup_directory`.
+// Returns INVALID_ARGUMENT error, if `file_name` is not a plain file name,
+//   which could name a file outside of the directory or a sqlite3 uri.
+// Returns ALREADY_EXISTS error, if the file exists and `overwrite` is false.
+// Returns FAILED_PRECONDITION error, if the backups are disabled, or if the
+//   file exists but is not a regular file, e.g., a symlink.
+absl::StatusOr<std::string> GetBackupPath(absl::string_view backup_directory,
+                                          absl::string_view file_name,
+                                          const bool overwrite) {
+  if (backup_directory.empty()) {
+    return absl::FailedPreconditionError(
+        "The backups are disabled, restart the server with "
+        "--sqlite_backup_directory.");
+  }
+  if (file_name.empty() || file_name == "." || file_name == ".." ||
+      absl::StrContains(file_name, '/') ||
+      absl::StartsWith(file_name, "file:")) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "destination_file_name must be a plain file name, got '", file_name,
+        "'."));
+  }
+  const std::filesystem::path path =
+      std::filesystem::path(std::string(backup_directory)) /
+      std::string(file_name);
+  std::error_code error;
+  const std::filesystem::file_status status =
+      std::filesystem::symlink_status(path, error);
+  if (status.type() == std::filesystem::file_type::not_found) {
+    return path.string();
+  }
+  if (error) {
+    return absl::InternalError(absl::StrCat(
+        "Cannot inspect the backup destination ", path.string(), ": ",
+        error.message()));
+  }
+  if (!std::filesystem::is_regular_file(status)) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "The backup destination ", path.string(), " is not a regular file."));
+  }
+  if (!overwrite) {
+    return absl::AlreadyExistsError(
+        absl::StrCat("The backup destination ", path.string(),
+                     " exists, set overwrite to replace it."));
+  }
+  return path.string();
+}
+
+}  // namespace
+
+MetadataStoreAdminServiceImpl::MetadataStoreAdminServiceImpl(
+    const ServerStats* server_stats, const ConnectionConfig& connection_config,
+    const std::string& backup_directory,
+    const PlannerStatisticsMaintainer* planner_statistics_maintainer,
+    const ListResultCache* list_result_cache,
+    const SerializedNodeCache* serialized_node_cache,
+    const TenantStoreManager* tenant_store_manager)
+    : server_stats_(server_stats),
+      connection_config_(connection_config),
+      backup_directory_(backup_directory),
+      planner_statistics_maintainer_(planner_statistics_maintainer),
+      list_result_cache_(list_result_cache),
+      serialized_node_cache_(serialized_node_cache),
+      tenant_store_manager_(tenant_store_manager) {}
+
+::grpc::Status MetadataStoreAdminServiceImpl::ProfileCpu(
+    ::grpc::ServerContext* context, const ProfileCpuRequest* request,
+    ProfileResponse* response) {
+  if (request->duration_seconds() <= 0 ||
+      request->duration_seconds() > kMaxCpuProfileSeconds) {
+    return ::grpc::Status(
+        ::grpc::StatusCode::INVALID_ARGUMENT,
+        absl::StrCat("duration_seconds must be in (0, ", kMaxCpuProfileSeconds,
+                     "], got ", request->duration_seconds()));
+  }
+#ifdef MLMD_ENABLE_GPERFTOOLS
+  if (!cpu_profile_mutex_.TryLock()) {
+    return ::grpc::Status(::grpc::StatusCode::ABORTED,
+                          "Another CPU profile is being collected.");
+  }
+  const ::grpc::Status status = CollectCpuProfile(
+      context, absl::Seconds(request->duration_seconds()), response);
+  cpu_profile_mutex_.Unlock();
+  return status;
+#else
+  return ::grpc::Status(
+      ::grpc::StatusCode::UNIMPLEMENTED,
+      "The server is not built with a CPU profiler, rebuild it with "
+      "--define=with_gperftools=true.");
+#endif
+}
+
+::grpc::Status MetadataStoreAdminServiceImpl::ProfileHeap(
+    ::grpc::ServerContext* context, const ProfileHeapRequest* request,
+    ProfileResponse* response) {
+#ifdef MLMD_ENABLE_GPERFTOOLS
+  std::string content;
+  MallocExtension::instance()->GetHeapSample(&content);
+  if (content.empty()) {
+    return ::grpc::Status(
+        ::grpc::StatusCode::FAILED_PRECONDITION,
+        "Heap sampling is not enabled, restart the server with "
+        "TCMALLOC_SAMPLE_PARAMETER set, e.g., to 524288.");
+  }
+  response->set_file_name(ProfileFileName("heap"));
+  response->set_content(std::move(content));
+  return ::grpc::Status::OK;
+#else
+  return ::grpc::Status(
+      ::grpc::StatusCode::UNIMPLEMENTED,
+      "The server is not built with tcmalloc, rebuild it with "
+      "--define=with_gperftools=true.");
+#endif
+}
+
+::grpc::Status MetadataStoreAdminServiceImpl::GetServerStats(
+    ::grpc::ServerContext* context, const GetServerStatsRequest* request,
+    GetServerStatsResponse* response) {
+  server_stats_->Snapshot(response);
+  if (planner_statistics_maintainer_ != nullptr) {
+    planner_statistics_maintainer_->Snapshot(response);
+  }
+  if (list_result_cache_ != nullptr) {
+    SetCacheStatistics(*list_result_cache_,
+                       response->mutable_list_result_cache());
+  }
+  if (serialized_node_cache_ != nullptr) {
+    SetCacheStatistics(*serialized_node_cache_,
+                       response->mutable_serialized_node_cache());
+  }
+  if (tenant_store_manager_ != nullptr) {
+    response->set_num_tenant_connections(
+        tenant_store_manager_->num_connections());
+    response->set_num_idle_tenant_connections(
+        tenant_store_manager_->num_idle_connections());
+  }
+  return ::grpc::Status::OK;
+}
+
+::grpc::Status MetadataStoreAdminServiceImpl::BackupSqliteDatabase(
+    ::grpc::ServerContext* context, const BackupSqliteDatabaseRequest* request,
+    ::grpc::ServerWriter<BackupSqliteDatabaseResponse>* writer) {
+  const absl::StatusOr<std::string> destination =
+      GetBackupPath(backup_directory_, request->destination_file_name(),
+                    request->overwrite());
+  if (!destination.ok()) {
+    // Note: the absl and grpc status codes align with each other.
+    return ::grpc::Status(
+        static_cast<::grpc::StatusCode>(destination.status().code()),
+        std::string(destination.status().message()));
+  }
+  ConnectionConfig connection_config = connection_config_;
+  if (tenant_store_manager_ != nullptr) {
+    if (request->tenant().empty()) {
+      return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                            "tenant must be given on a multi-tenant server.");
+    }
+    const absl::Status status = tenant_store_manager_->GetConnectionConfig(
+        request->tenant(), &connection_config);
+    if (!status.ok()) {
+      return ::grpc::Status(::grpc::StatusCode::NOT_FOUND,
+                            std::string(status.message()));
+    }
+  } else if (!request->tenant().empty()) {
+    return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                          "tenant is only supported on a multi-tenant server.");
+  }
+  // An in-memory database of the server cannot be opened by another
+  // connection.
+  const SqliteMetadataSourceConfig& sqlite_config = connection_config.sqlite();
+  if (!connection_config.has_sqlite() ||
+      sqlite_config.filename_uri().empty() ||
+      sqlite_config.filename_uri() == ":memory:") {
+    return ::grpc::Status(::grpc::StatusCode::FAILED_PRECONDITION,
+                          "The server does not use a SQLite database file.");
+  }
+  // Reads through a connection of its own, so the backup does not depend on
+  // the connection mode of the server.
+  SqliteMetadataSourceConfig source_config;
+  source_config.set_filename_uri(sqlite_config.filename_uri());
+  source_config.set_connection_mode(SqliteMetadataSourceConfig::READONLY);
+  SqliteMetadataSource source(source_config);
+  absl::Status status = source.Connect();
+  if (!status.ok()) {
+    return ::grpc::Status(::grpc::StatusCode::INTERNAL,
+                          std::string(status.message()));
+  }
+
+  LOG(INFO) << "Backing up " << sqlite_config.filename_uri() << " to "
+            << *destination;
+  absl::Time last_log_time = absl::Now();
+  absl::Time last_message_time = absl::Now();
+  SqliteMetadataSource::BackupProgress progress;
+  status = source.Backup(
+      *destination, request->pages_per_step(),
+      absl::Milliseconds(request->sleep_milliseconds()),
+      request->max_num_restarts(),
+      [context, writer, &last_log_time, &last_message_time](
+          const SqliteMetadataSource::BackupProgress& step_progress) {
+        if (absl::Now() - last_log_time >= kBackupProgressLogInterval) {
+          last_log_time = absl::Now();
+          LOG(INFO) << "Backup copied " << step_progress.num_copied_pages
+                    << " of " << step_progress.num_total_pages << " pages in "
+                    << step_progress.elapsed_time << ".";
+        }
+        if (absl::Now() - last_message_time >=
+            kBackupProgressMessageInterval) {
+          last_message_time = absl::Now();
+          BackupSqliteDatabaseResponse response;
+          SetBackupProgress(step_progress, &response);
+          // The write fails once the client is gone.
+          if (!writer->Write(response)) return false;
+        }
+        return !context->IsCancelled();
+      },
+      &progress);
+  if (!status.ok()) {
+    LOG(WARNING) << "Backup failed: " << status;
+    // Note: the absl and grpc status codes align with each other.
+    return ::grpc::Status(static_cast<::grpc::StatusCode>(status.code()),
+                          std::string(status.message()));
+  }
+
+  const int64_t num_bytes = progress.num_total_pages * progress.page_size_bytes;
+  BackupSqliteDatabaseResponse response;
+  SetBackupProgress(progress, &response);
+  if (progress.elapsed_time > absl::ZeroDuration()) {
+    response.set_bytes_per_second(
+        num_bytes / absl::ToDoubleSeconds(progress.elapsed_time));
+  }
+  response.set_done(true);
+  LOG(INFO) << "Backed up " << num_bytes << " bytes in "
+            << progress.elapsed_time << ".";
+  // The backup is complete even if the client is gone before it is told.
+  writer->Write(response);
+  return ::grpc::Status::OK;
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,100 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_METADATA_STORE_ADMIN_SERVICE_IMPL_H_
+#define ML_METADATA_METADATA_STORE_METADATA_STORE_ADMIN_SERVICE_IMPL_H_
+
+#include <string>
+
+#include <grpcpp/support/sync_stream.h>
+#include "absl/synchronization/mutex.h"
+#include "ml_metadata/metadata_store/list_result_cache.h"
+#include "ml_metadata/metadata_store/planner_statistics_maintainer.h"
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+#include "ml_metadata/metadata_store/server_stats.h"
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+#include "ml_metadata/proto/metadata_store_admin.grpc.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+namespace ml_metadata {
+
+// A gRPC service that implements MetadataStoreAdminService defined in
+// proto/metadata_store_admin.proto. It is thread-safe.
+//
+// The profiles are collected with gperftools, which is only available when the
+// server is built with `--define=with_gperftools=true`. Heap profiles further
+// require tcmalloc heap sampling, e.g., `TCMALLOC_SAMPLE_PARAMETER=524288`.
+class MetadataStoreAdminServiceImpl final
+    : public MetadataStoreAdminService::Service {
+ public:
+  // `server_stats` is not owned and must outlive the service.
+  // `connection_config` is the database of the server, which
+  // BackupSqliteDatabase copies into `backup_directory`. The backups are
+  // disabled if `backup_directory` is empty.
+  // `planner_statistics_maintainer` is not owned and must outlive the service,
+  // or is nullptr if the maintenance is disabled.
+  // `list_result_cache` and `serialized_node_cache` are not owned and must
+  // outlive the service, or are nullptr if the caches are disabled.
+  // `tenant_store_manager` is not owned and must outlive the service, or is
+  // nullptr if the server is not multi-tenant. If set, BackupSqliteDatabase
+  // copies the database of the requested tenant instead of
+  // `connection_config`.
+  MetadataStoreAdminServiceImpl(
+      const ServerStats* server_stats,
+      const ConnectionConfig& connection_config,
+      const std::string& backup_directory,
+      const PlannerStatisticsMaintainer* planner_statistics_maintainer,
+      const ListResultCache* list_result_cache,
+      const SerializedNodeCache* serialized_node_cache,
+      const TenantStoreManager* tenant_store_manager);
+
+  // default & copy constructors are disallowed.
+  MetadataStoreAdminServiceImpl() = delete;
+  MetadataStoreAdminServiceImpl(const MetadataStoreAdminServiceImpl&) = delete;
+  MetadataStoreAdminServiceImpl& operator=(
+      const MetadataStoreAdminServiceImpl&) = delete;
+
+  ::grpc::Status ProfileCpu(::grpc::ServerContext* context,
+                            const ProfileCpuRequest* request,
+                            ProfileResponse* response) override;
+
+  ::grpc::Status ProfileHeap(::grpc::ServerContext* context,
+                             const ProfileHeapRequest* request,
+                             ProfileResponse* response) override;
+
+  ::grpc::Status GetServerStats(::grpc::ServerContext* context,
+                                const GetServerStatsRequest* request,
+                                GetServerStatsResponse* response) override;
+
+  ::grpc::Status BackupSqliteDatabase(
+      ::grpc::ServerContext* context,
+      const BackupSqliteDatabaseRequest* request,
+      ::grpc::ServerWriter<BackupSqliteDatabaseResponse>* writer) override;
+
+ private:
+  const ServerStats* const server_stats_;
+  const ConnectionConfig connection_config_;
+  const std::string backup_directory_;
+  const PlannerStatisticsMaintainer* const planner_statistics_maintainer_;
+  const ListResultCache* const list_result_cache_;
+  const SerializedNodeCache* const serialized_node_cache_;
+  const TenantStoreManager* const tenant_store_manager_;
+  // Held while a CPU profile is collected, as the profiler is process-wide.
+  absl::Mutex cpu_profile_mutex_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_METADATA_STORE_ADMIN_SERVICE_IMPL_H_
@@ -0,0 +1,170 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/metadata_store_admin_service_impl.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "grpcpp/client_context.h"
+#include "grpcpp/server.h"
+#include "grpcpp/server_builder.h"
+#include "grpcpp/support/channel_arguments.h"
+#include "grpcpp/support/sync_stream.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "ml_metadata/metadata_store/server_stats.h"
+#include "ml_metadata/metadata_store/sqlite_metadata_source.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.grpc.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+class MetadataStoreAdminServiceImplTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    connection_config_.mutable_sqlite()->set_filename_uri(
+        absl::StrCat(::testing::TempDir(), "/", test_name, ".db"));
+    std::remove(connection_config_.sqlite().filename_uri().c_str());
+    SqliteMetadataSource source(connection_config_.sqlite());
+    ASSERT_EQ(source.Connect(), absl::OkStatus());
+    ASSERT_EQ(source.Begin(), absl::OkStatus());
+    ASSERT_EQ(source.ExecuteQuery("CREATE TABLE t1 (c1 INT);", nullptr),
+              absl::OkStatus());
+    ASSERT_EQ(source.Commit(), absl::OkStatus());
+
+    backup_directory_ =
+        absl::StrCat(::testing::TempDir(), "/", test_name, "_backups");
+    std::filesystem::remove_all(backup_directory_);
+    std::filesystem::create_directories(backup_directory_);
+  }
+
+  void TearDown() override {
+    if (server_ != nullptr) server_->Shutdown();
+  }
+
+  // Serves a MetadataStoreAdminServiceImpl that writes its backups to
+  // `backup_directory` in process, and connects `stub_` to it.
+  void StartServer(const std::string& backup_directory) {
+    service_ = std::make_unique<MetadataStoreAdminServiceImpl>(
+        &server_stats_, connection_config_, backup_directory,
+        /*planner_statistics_maintainer=*/nullptr,
+        /*list_result_cache=*/nullptr, /*serialized_node_cache=*/nullptr,
+        /*tenant_store_manager=*/nullptr);
+    ::grpc::ServerBuilder builder;
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(server_, nullptr);
+    stub_ = MetadataStoreAdminService::NewStub(
+        server_->InProcessChannel(::grpc::ChannelArguments()));
+  }
+
+  // Calls BackupSqliteDatabase with `request`, and returns the streamed
+  // `responses`.
+  ::grpc::Status Backup(const BackupSqliteDatabaseRequest& request,
+                        std::vector<BackupSqliteDatabaseResponse>* responses) {
+    ::grpc::ClientContext context;
+    std::unique_ptr<::grpc::ClientReader<BackupSqliteDatabaseResponse>>
+        reader = stub_->BackupSqliteDatabase(&context, request);
+    BackupSqliteDatabaseResponse response;
+    while (reader->Read(&response)) responses->push_back(response);
+    return reader->Finish();
+  }
+
+  ConnectionConfig connection_config_;
+  std::string backup_directory_;
+  ServerStats server_stats_;
+  std::unique_ptr<MetadataStoreAdminServiceImpl> service_;
+  std::unique_ptr<::grpc::Server> server_;
+  std::unique_ptr<MetadataStoreAdminService::Stub> stub_;
+};
+
+TEST_F(MetadataStoreAdminServiceImplTest, BackupIsDisabledWithoutDirectory) {
+  StartServer(/*backup_directory=*/"");
+  BackupSqliteDatabaseRequest request;
+  request.set_destination_file_name("backup.db");
+  std::vector<BackupSqliteDatabaseResponse> responses;
+  EXPECT_EQ(Backup(request, &responses).error_code(),
+            ::grpc::StatusCode::FAILED_PRECONDITION);
+}
+
+TEST_F(MetadataStoreAdminServiceImplTest,
+       BackupRejectsDestinationsOutsideTheDirectory) {
+  StartServer(backup_directory_);
+  for (const char* file_name :
+       {"", "..", "../backup.db", "sub/backup.db", "/tmp/backup.db",
+        "file:backup.db?mode=memory"}) {
+    BackupSqliteDatabaseRequest request;
+    request.set_destination_file_name(file_name);
+    std::vector<BackupSqliteDatabaseResponse> responses;
+    EXPECT_EQ(Backup(request, &responses).error_code(),
+              ::grpc::StatusCode::INVALID_ARGUMENT)
+        << file_name;
+  }
+}
+
+TEST_F(MetadataStoreAdminServiceImplTest, BackupOverwritesOnlyIfRequested) {
+  StartServer(backup_directory_);
+  BackupSqliteDatabaseRequest request;
+  request.set_destination_file_name("backup.db");
+  request.set_pages_per_step(1);
+  request.set_sleep_milliseconds(0);
+  std::vector<BackupSqliteDatabaseResponse> responses;
+  ASSERT_TRUE(Backup(request, &responses).ok());
+  ASSERT_FALSE(responses.empty());
+  // Only the last message reports the complete backup.
+  for (size_t i = 0; i + 1 < responses.size(); ++i) {
+    EXPECT_FALSE(responses[i].done());
+  }
+  const BackupSqliteDatabaseResponse& last_response = responses.back();
+  EXPECT_TRUE(last_response.done());
+  EXPECT_GT(last_response.num_pages(), 0);
+  EXPECT_EQ(last_response.num_copied_pages(), last_response.num_pages());
+  EXPECT_TRUE(std::filesystem::is_regular_file(
+      std::filesystem::path(backup_directory_) / "backup.db"));
+
+  responses.clear();
+  EXPECT_EQ(Backup(request, &responses).error_code(),
+            ::grpc::StatusCode::ALREADY_EXISTS);
+  request.set_overwrite(true);
+  responses.clear();
+  EXPECT_TRUE(Backup(request, &responses).ok());
+  ASSERT_FALSE(responses.empty());
+  EXPECT_TRUE(responses.back().done());
+}
+
+TEST_F(MetadataStoreAdminServiceImplTest, BackupRefusesSymlinks) {
+  StartServer(backup_directory_);
+  const std::filesystem::path link =
+      std::filesystem::path(backup_directory_) / "link.db";
+  std::filesystem::create_symlink(connection_config_.sqlite().filename_uri(),
+                                  link);
+  BackupSqliteDatabaseRequest request;
+  request.set_destination_file_name("link.db");
+  request.set_overwrite(true);
+  std::vector<BackupSqliteDatabaseResponse> responses;
+  EXPECT_EQ(Backup(request, &responses).error_code(),
+            ::grpc::StatusCode::FAILED_PRECONDITION);
+}
+
+}  // namespace
+}  // namespace ml_metadata
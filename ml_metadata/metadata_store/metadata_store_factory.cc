@@ -14,8 +14,17 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/metadata_store_factory.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/const_init.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "ml_metadata/metadata_store/metadata_store.h"
 #include "ml_metadata/metadata_store/transaction_executor.h"
 #include "ml_metadata/metadata_store/mysql_metadata_source.h"
@@ -41,10 +50,79 @@ absl::Status CreateMySQLMetadataStore(const MySQLDatabaseConfig& config,
       migration_options.enable_upgrade_migration());
 }
 
+// Guards the SQLite schema template of the process.
+ABSL_CONST_INIT absl::Mutex sqlite_schema_template_mutex(absl::kConstInit);
+
+// The image of an initialized in-memory SQLite store, or nullptr before it is
+// built. Never freed.
+std::shared_ptr<const std::string>* sqlite_schema_template
+    ABSL_GUARDED_BY(sqlite_schema_template_mutex) = nullptr;
+
+// Returns true if the store of `config` can be cloned from the schema
+// template, i.e., it asks for it and uses a writable in-memory database.
+bool UseSqliteSchemaTemplate(const SqliteMetadataSourceConfig& config) {
+  if (!config.clone_from_schema_template()) {
+    return false;
+  }
+  if (!config.filename_uri().empty() && config.filename_uri() != ":memory:") {
+    return false;
+  }
+  switch (config.connection_mode()) {
+    case SqliteMetadataSourceConfig::UNKNOWN:
+    case SqliteMetadataSourceConfig::READWRITE:
+    case SqliteMetadataSourceConfig::READWRITE_OPENCREATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the image of an in-memory SQLite store that has the schema of the
+// library and the simple types. The image is built by the first call, and
+// shared by all the later ones.
+absl::StatusOr<std::shared_ptr<const std::string>> GetSqliteSchemaTemplate() {
+  absl::MutexLock lock(&sqlite_schema_template_mutex);
+  if (sqlite_schema_template != nullptr) {
+    return *sqlite_schema_template;
+  }
+  auto metadata_source =
+      std::make_unique<SqliteMetadataSource>(SqliteMetadataSourceConfig());
+  SqliteMetadataSource* source = metadata_source.get();
+  auto transaction_executor =
+      std::make_unique<RdbmsTransactionExecutor>(metadata_source.get());
+  std::unique_ptr<MetadataStore> store;
+  MLMD_RETURN_IF_ERROR(MetadataStore::Create(
+      util::GetSqliteMetadataSourceQueryConfig(), /*migration_options=*/{},
+      std::move(metadata_source), std::move(transaction_executor), &store));
+  MLMD_RETURN_IF_ERROR(store->InitMetadataStore());
+  absl::StatusOr<std::string> image = source->Serialize();
+  if (!image.ok()) {
+    return image.status();
+  }
+  sqlite_schema_template = new std::shared_ptr<const std::string>(
+      std::make_shared<const std::string>(*std::move(image)));
+  return *sqlite_schema_template;
+}
+
 absl::Status CreateSqliteMetadataStore(
     const SqliteMetadataSourceConfig& config,
     const MigrationOptions& migration_options,
     std::unique_ptr<MetadataStore>* result) {
+  if (UseSqliteSchemaTemplate(config)) {
+    absl::StatusOr<std::shared_ptr<const std::string>> schema_template =
+        GetSqliteSchemaTemplate();
+    if (!schema_template.ok()) {
+      return schema_template.status();
+    }
+    auto metadata_source = std::make_unique<SqliteMetadataSource>(
+        config, *std::move(schema_template));
+    auto transaction_executor =
+        std::make_unique<RdbmsTransactionExecutor>(metadata_source.get());
+    // The cloned database already has the schema and the simple types.
+    return MetadataStore::Create(
+        util::GetSqliteMetadataSourceQueryConfig(), migration_options,
+        std::move(metadata_source), std::move(transaction_executor), result);
+  }
   auto metadata_source = std::make_unique<SqliteMetadataSource>(config);
   auto transaction_executor =
       std::make_unique<RdbmsTransactionExecutor>(metadata_source.get());
@@ -72,11 +150,10 @@ absl::Status CreatePostgreSQLMetadataStore(
 }
 
 
-}  // namespace
-
-absl::Status CreateMetadataStore(const ConnectionConfig& config,
-                                 const MigrationOptions& options,
-                                 std::unique_ptr<MetadataStore>* result) {
+// Creates the MetadataStore of the backend selected by `config`.
+absl::Status CreateMetadataStoreForBackend(
+    const ConnectionConfig& config, const MigrationOptions& options,
+    std::unique_ptr<MetadataStore>* result) {
   switch (config.config_case()) {
     case ConnectionConfig::CONFIG_NOT_SET:
       // TODO(b/123345695): make this longer when that bug is resolved.
@@ -98,6 +175,18 @@ absl::Status CreateMetadataStore(const ConnectionConfig& config,
   }
 }
 
+}  // namespace
+
+absl::Status CreateMetadataStore(const ConnectionConfig& config,
+                                 const MigrationOptions& options,
+                                 std::unique_ptr<MetadataStore>* result) {
+  MLMD_RETURN_IF_ERROR(CreateMetadataStoreForBackend(config, options, result));
+  (*result)->set_enable_database_write_epochs(
+      config.enable_database_write_epochs());
+  (*result)->set_enable_context_summaries(config.enable_context_summaries());
+  return absl::OkStatus();
+}
+
 absl::Status CreateMetadataStore(const ConnectionConfig& config,
                                  std::unique_ptr<MetadataStore>* result) {
   return CreateMetadataStore(config, {}, result);
@@ -73,5 +73,39 @@ TEST(MetadataStoreFactoryTest, CreateSQLiteMetadataStore) {
   TestPutAndGetArtifactType(connection_config);
 }
 
+TEST(MetadataStoreFactoryTest, CreateSQLiteMetadataStoreFromSchemaTemplate) {
+  ConnectionConfig connection_config;
+  connection_config.mutable_sqlite()->set_clone_from_schema_template(true);
+  TestPutAndGetArtifactType(connection_config);
+
+  // Each store is a private copy of the template with the simple types.
+  std::unique_ptr<MetadataStore> store1;
+  ASSERT_EQ(absl::OkStatus(),
+            CreateMetadataStore(connection_config, &store1));
+  std::unique_ptr<MetadataStore> store2;
+  ASSERT_EQ(absl::OkStatus(),
+            CreateMetadataStore(connection_config, &store2));
+  PutArtifactTypeRequest put_request =
+      ParseTextProtoOrDie<PutArtifactTypeRequest>(
+          R"(
+            all_fields_match: true
+            artifact_type: { name: 'test_type' }
+          )");
+  PutArtifactTypeResponse put_response;
+  ASSERT_EQ(absl::OkStatus(),
+            store1->PutArtifactType(put_request, &put_response));
+
+  GetArtifactTypeRequest get_request;
+  get_request.set_type_name("test_type");
+  GetArtifactTypeResponse get_response;
+  EXPECT_EQ(absl::OkStatus(),
+            store1->GetArtifactType(get_request, &get_response));
+  EXPECT_TRUE(absl::IsNotFound(
+      store2->GetArtifactType(get_request, &get_response)));
+  get_request.set_type_name("mlmd.Dataset");
+  EXPECT_EQ(absl::OkStatus(),
+            store2->GetArtifactType(get_request, &get_response));
+}
+
 }  // namespace testing
 }  // namespace ml_metadata
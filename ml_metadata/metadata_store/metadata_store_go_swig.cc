@@ -663,6 +663,13 @@ string GetExecutionsByContext(ml_metadata::MetadataStore* metadata_store,
       request, status);
 }
 
+string ExecuteBatch(ml_metadata::MetadataStore* metadata_store,
+                    const string& request, absl::Status* status) {
+  return AccessMetadataStore(metadata_store,
+                             &ml_metadata::MetadataStore::ExecuteBatch,
+                             request, status);
+}
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -1499,6 +1506,27 @@ _gostring_ _wrap_GetExecutionsByContext_metadata_store_go_wrap_111d7b2874b915fe(
   return _swig_go_result;
 }
 
+_gostring_ _wrap_ExecuteBatch_metadata_store_go_wrap_111d7b2874b915fe(
+    ml_metadata::MetadataStore *_swig_go_0, _gostring_ _swig_go_1,
+    absl::Status *_swig_go_2) {
+  ml_metadata::MetadataStore *arg1 = (ml_metadata::MetadataStore *) 0 ;
+  string *arg2 = 0 ;
+  absl::Status *arg3 = (absl::Status *) 0 ;
+  string result;
+  _gostring_ _swig_go_result;
+
+  arg1 = *(ml_metadata::MetadataStore **)&_swig_go_0;
+
+  string arg2_str(_swig_go_1.p, _swig_go_1.n);
+  arg2 = &arg2_str;
+
+  arg3 = *(absl::Status **)&_swig_go_2;
+
+  result = ExecuteBatch(arg1,(string const &)*arg2,arg3);
+  _swig_go_result = Swig_AllocateString((&result)->data(), (&result)->length());
+  return _swig_go_result;
+}
+
 absl::Status *_wrap_CreateABSLStatus_metadata_store_go_wrap_111d7b2874b915fe() {
   absl::Status *result = 0 ;
   absl::Status *_swig_go_result;
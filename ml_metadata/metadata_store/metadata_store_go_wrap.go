@@ -119,6 +119,8 @@ typedef _gostring_ swig_type_73;
 typedef _gostring_ swig_type_74;
 typedef _gostring_ swig_type_75;
 typedef _gostring_ swig_type_76;
+typedef _gostring_ swig_type_77;
+typedef _gostring_ swig_type_78;
 extern void _wrap_Swig_free_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1);
 extern uintptr_t _wrap_Swig_malloc_metadata_store_go_wrap_111d7b2874b915fe(swig_intgo arg1);
 extern uintptr_t _wrap_CreateMetadataStore_metadata_store_go_wrap_111d7b2874b915fe(swig_type_1 arg1, uintptr_t arg2);
@@ -160,10 +162,11 @@ extern swig_type_68 _wrap_GetContextsByArtifact_metadata_store_go_wrap_111d7b287
 extern swig_type_70 _wrap_GetContextsByExecution_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1, swig_type_71 arg2, uintptr_t arg3);
 extern swig_type_72 _wrap_GetArtifactsByContext_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1, swig_type_73 arg2, uintptr_t arg3);
 extern swig_type_74 _wrap_GetExecutionsByContext_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1, swig_type_75 arg2, uintptr_t arg3);
+extern swig_type_76 _wrap_ExecuteBatch_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1, swig_type_77 arg2, uintptr_t arg3);
 extern uintptr_t _wrap_CreateABSLStatus_metadata_store_go_wrap_111d7b2874b915fe(void);
 extern void _wrap_DestroyABSLStatus_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1);
 extern _Bool _wrap_IsOk_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1);
-extern swig_type_76 _wrap_ErrorMessage_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1);
+extern swig_type_78 _wrap_ErrorMessage_metadata_store_go_wrap_111d7b2874b915fe(uintptr_t arg1);
 #undef intgo
 */
 import "C"
@@ -779,6 +782,21 @@ func GetExecutionsByContext(arg1 Ml_metadata_MetadataStore, arg2 string, arg3 Ab
 	return swig_r_1
 }
 
+func ExecuteBatch(arg1 Ml_metadata_MetadataStore, arg2 string, arg3 Absl_Status) (_swig_ret string) {
+	var swig_r string
+	_swig_i_0 := arg1.Swigcptr()
+	_swig_i_1 := arg2
+	_swig_i_2 := arg3.Swigcptr()
+	swig_r_p := C._wrap_ExecuteBatch_metadata_store_go_wrap_111d7b2874b915fe(C.uintptr_t(_swig_i_0), *(*C.swig_type_77)(unsafe.Pointer(&_swig_i_1)), C.uintptr_t(_swig_i_2))
+	swig_r = *(*string)(unsafe.Pointer(&swig_r_p))
+	if Swig_escape_always_false {
+		Swig_escape_val = arg2
+	}
+	var swig_r_1 string
+	swig_r_1 = swigCopyString(swig_r)
+	return swig_r_1
+}
+
 func CreateABSLStatus() (_swig_ret Absl_Status) {
 	var swig_r Absl_Status
 	swig_r = (Absl_Status)(SwigcptrAbsl_Status(C._wrap_CreateABSLStatus_metadata_store_go_wrap_111d7b2874b915fe()))
@@ -0,0 +1,118 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Binary that recomputes the context summaries of an ml.metadata store from
+// its associations and attributions. The summaries are created when a store
+// is upgraded to the schema that introduced them, and are kept up to date by
+// the stores with enable_context_summaries in their ConnectionConfig. Run it
+// to repair the summaries after writes of clients that use an earlier schema
+// version or do not enable the option, e.g.,
+//
+//   metadata_store_rebuild_context_summaries \
+//     --metadata_store_server_config_file=/path/to/config.pbtxt \
+//     --context_ids=1,2,3
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include <glog/logging.h>
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/text_format.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/metadata_store_factory.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+DEFINE_string(metadata_store_server_config_file, "",
+              "The MetadataStoreServerConfig text proto file, whose "
+              "connection_config is the store to rebuild the summaries of.");
+DEFINE_string(context_ids, "",
+              "A comma separated list of the context ids to rebuild the "
+              "summaries of. If empty, the summaries of all contexts are "
+              "rebuilt.");
+DEFINE_bool(enable_database_upgrade, false,
+            "Whether to upgrade the database schema before rebuilding the "
+            "summaries. The upgrade computes the summaries as well.");
+
+namespace {
+
+// Parses the connection config of the server config file `filename`, and
+// returns true if it is successful in populating `connection_config`.
+bool ParseConnectionConfig(const std::string& filename,
+                           ml_metadata::ConnectionConfig* connection_config) {
+  std::ifstream input_file_stream(filename);
+  if (!input_file_stream) {
+    return false;
+  }
+  google::protobuf::io::IstreamInputStream file_stream(&input_file_stream);
+  ml_metadata::MetadataStoreServerConfig server_config;
+  if (!google::protobuf::TextFormat::Parse(&file_stream, &server_config)) {
+    return false;
+  }
+  *connection_config = server_config.connection_config();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  ml_metadata::ConnectionConfig connection_config;
+  CHECK(ParseConnectionConfig(FLAGS_metadata_store_server_config_file,
+                              &connection_config))
+      << "Unable to read the connection config from "
+         "--metadata_store_server_config_file.";
+  ml_metadata::RebuildContextSummariesRequest request;
+  for (const absl::string_view context_id :
+       absl::StrSplit(FLAGS_context_ids, ',', absl::SkipEmpty())) {
+    int64_t id;
+    CHECK(absl::SimpleAtoi(context_id, &id))
+        << "Invalid context id in --context_ids: " << context_id;
+    request.add_context_ids(id);
+  }
+
+  ml_metadata::MigrationOptions migration_options;
+  migration_options.set_enable_upgrade_migration(
+      FLAGS_enable_database_upgrade);
+  std::unique_ptr<ml_metadata::MetadataStore> metadata_store;
+  absl::Status status = ml_metadata::CreateMetadataStore(
+      connection_config, migration_options, &metadata_store);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to connect to the store: " << status;
+    return -1;
+  }
+
+  ml_metadata::RebuildContextSummariesResponse response;
+  status = metadata_store->RebuildContextSummaries(request, &response);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to rebuild the context summaries: " << status;
+    return -1;
+  }
+  if (request.context_ids().empty()) {
+    LOG(INFO) << "Rebuilt the summaries of all contexts.";
+  } else {
+    LOG(INFO) << "Rebuilt the summaries of " << request.context_ids_size()
+              << " contexts.";
+  }
+  return 0;
+}
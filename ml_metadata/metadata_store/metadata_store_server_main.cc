@@ -23,19 +23,29 @@ limitations under the License.
 
 #include "gflags/gflags.h"
 #include <glog/logging.h>
+#include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
+#include "absl/time/time.h"
 #include "grpcpp/security/server_credentials.h"
 #include "grpcpp/server.h"
 #include "grpcpp/server_builder.h"
+#include "ml_metadata/metadata_store/list_result_cache.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
 #include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/metadata_store_admin_service_impl.h"
 #include "ml_metadata/metadata_store/metadata_store_factory.h"
 #include "ml_metadata/metadata_store/metadata_store_service_impl.h"
+#include "ml_metadata/metadata_store/planner_statistics_maintainer.h"
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+#include "ml_metadata/metadata_store/server_stats.h"
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 
@@ -81,11 +91,9 @@ void AddGrpcChannelArgs(const string& channel_arguments_str,
   }
 }
 
-// Parses config file if provided and returns true if it is successful in
-// populating service_config.
-bool ParseMetadataStoreServerConfigOrDie(
-    const std::string& filename,
-    ml_metadata::MetadataStoreServerConfig* server_config) {
+// Returns true if the ascii protobuf in `filename` was parsed into `message`.
+bool ParseTextProtoFile(const std::string& filename,
+                        google::protobuf::Message* message) {
   if (filename.empty()) {
     return false;
   }
@@ -96,12 +104,20 @@ bool ParseMetadataStoreServerConfigOrDie(
   }
 
   google::protobuf::io::IstreamInputStream file_stream(&input_file_stream);
-  if (!google::protobuf::TextFormat::Parse(&file_stream, server_config)) {
+  if (!google::protobuf::TextFormat::Parse(&file_stream, message)) {
     return false;
   }
   return true;
 }
 
+// Parses config file if provided and returns true if it is successful in
+// populating service_config.
+bool ParseMetadataStoreServerConfigOrDie(
+    const std::string& filename,
+    ml_metadata::MetadataStoreServerConfig* server_config) {
+  return ParseTextProtoFile(filename, server_config);
+}
+
 // Returns true if passed parameters were used to construct mysql connection
 // config and set it to service_config. Returns false if host, port and database
 // were set and dies if only some of them were provided.
@@ -263,6 +279,88 @@ DEFINE_string(grpc_channel_arguments, "",
               "A comma separated list of arguments to be passed to the grpc "
               "server. (e.g. grpc.max_connection_age_ms=2000)");
 
+// admin service options
+DEFINE_bool(enable_admin_service, false,
+            "If true, serves MetadataStoreAdminService on localhost at "
+            "--admin_grpc_port, to profile the server and inspect its live "
+            "state. (default false)");
+DEFINE_int32(admin_grpc_port, 8081,
+             "Port on localhost to listen on for the admin gRPC API. "
+             "(default 8081)");
+DEFINE_string(sqlite_backup_directory, "",
+              "If non-empty, the directory on the server host that "
+              "BackupSqliteDatabase of the admin service writes the backups "
+              "to. Otherwise the backups are disabled.");
+
+// list result cache options
+DEFINE_bool(enable_list_result_cache, false,
+            "If true, caches the responses of GetArtifacts, GetExecutions and "
+            "GetContexts, and serves identical requests from the cache until "
+            "nodes of the kinds they depend on change. (default false)");
+DEFINE_int32(list_result_cache_max_entries, 1000,
+             "The maximum number of cached list responses. (default 1000)");
+DEFINE_int64(list_result_cache_max_bytes, 64 << 20,
+             "The maximum total size in bytes of the cached list responses. "
+             "(default 64MiB)");
+DEFINE_int32(list_result_cache_ttl_seconds, 30,
+             "Cached list responses older than this are not served. "
+             "(default 30)");
+DEFINE_bool(list_result_cache_use_database_write_epochs, false,
+            "If true, validates cached list responses against the write "
+            "epochs stored in the database, which accounts for writes of "
+            "other servers and clients at the cost of a query per request. "
+            "The writes of this server then increase the epochs in the "
+            "database, and other writers need enable_database_write_epochs "
+            "in their ConnectionConfig. Otherwise only the writes of this "
+            "server are accounted for. (default false)");
+
+// serialized node cache options
+DEFINE_bool(enable_serialized_node_cache, false,
+            "If true, caches the wire format of the nodes returned by "
+            "GetArtifactsByID, GetExecutionsByID and GetContextsByID, and "
+            "splices the cached bytes of unchanged nodes into their "
+            "responses. These methods then run their queries on a pool of "
+            "--serialized_node_cache_num_threads threads. (default false)");
+DEFINE_int64(serialized_node_cache_max_bytes, 256 << 20,
+             "The maximum total size in bytes of the cached nodes. "
+             "(default 256MiB)");
+DEFINE_int32(serialized_node_cache_num_threads, 16,
+             "The number of threads that run the queries of the methods "
+             "served with the serialized node cache. (default 16)");
+
+// planner statistics maintenance options
+DEFINE_bool(enable_planner_statistics_maintenance, false,
+            "If true, counts the rows changed per table, and runs ANALYZE on "
+            "the tables with many changed rows in a low-priority background "
+            "thread, so that the query planner does not work with stale "
+            "statistics after bulk changes. (default false)");
+DEFINE_int64(planner_statistics_min_changed_rows, 10000,
+             "A table is analyzed once this many of its rows changed. "
+             "(default 10000)");
+DEFINE_int64(planner_statistics_max_analyze_interval_seconds, 86400,
+             "A table with fewer changed rows is analyzed once this long "
+             "passed since it was last analyzed. (default 86400)");
+
+// multi-tenant options
+DEFINE_string(tenant_registry_file, "",
+              "If non-empty, read an ascii TenantRegistry protobuf from the "
+              "file name, and serve each request with the database of the "
+              "tenant named by its `mlmd-tenant` gRPC metadata instead of the "
+              "configured metadata source.");
+DEFINE_int32(tenant_max_connections, 100,
+             "The maximum number of open connections across the tenants. "
+             "(default 100)");
+DEFINE_int32(tenant_max_idle_connections, 20,
+             "The maximum number of idle connections kept for reuse across "
+             "the tenants. The idle connections of the least recently used "
+             "tenants are closed first. (default 20)");
+DEFINE_int32(tenant_idle_timeout_seconds, 300,
+             "Idle tenant connections unused for longer than this are "
+             "closed. (default 300)");
+DEFINE_int32(tenant_idle_sweep_interval_seconds, 30,
+             "How often idle tenant connections are checked for expiry "
+             "while the server is not serving requests. (default 30)");
+
 // A list of valid metadata source config types, each item has corresponded
 // argument value defined by flag metadata_source_config_type.
 enum class SourceConfigType {
@@ -501,6 +599,10 @@ int main(int argc, char** argv) {
     LOG(ERROR) << "grpc_port is invalid: " << (FLAGS_grpc_port);
     return -1;
   }
+  if ((FLAGS_enable_admin_service) && (FLAGS_admin_grpc_port) <= 0) {
+    LOG(ERROR) << "admin_grpc_port is invalid: " << (FLAGS_admin_grpc_port);
+    return -1;
+  }
 
   const std::string metadata_source_config_type =
       (FLAGS_metadata_source_config_type);
@@ -537,6 +639,10 @@ int main(int argc, char** argv) {
       server_config_status.value();
   ml_metadata::ConnectionConfig connection_config =
       server_config.connection_config();
+  if ((FLAGS_enable_list_result_cache) &&
+      (FLAGS_list_result_cache_use_database_write_epochs)) {
+    connection_config.set_enable_database_write_epochs(true);
+  }
 
   // Creates a metadata_store in the main thread and init schema if necessary.
   std::unique_ptr<ml_metadata::MetadataStore> metadata_store;
@@ -557,8 +663,71 @@ int main(int argc, char** argv) {
   // At this point, schema initialization and migration are done.
   metadata_store.reset();
 
+  std::unique_ptr<ml_metadata::ServerStats> server_stats;
+  if ((FLAGS_enable_admin_service)) {
+    server_stats = absl::make_unique<ml_metadata::ServerStats>();
+    ml_metadata::MetadataSource::SetQueryObserver(server_stats.get());
+  }
+  std::unique_ptr<ml_metadata::ListResultCache> list_result_cache;
+  if ((FLAGS_enable_list_result_cache)) {
+    ml_metadata::ListResultCache::Options cache_options;
+    cache_options.max_num_entries = (FLAGS_list_result_cache_max_entries);
+    cache_options.max_num_bytes = (FLAGS_list_result_cache_max_bytes);
+    cache_options.ttl = absl::Seconds((FLAGS_list_result_cache_ttl_seconds));
+    cache_options.use_database_write_epochs =
+        (FLAGS_list_result_cache_use_database_write_epochs);
+    list_result_cache =
+        absl::make_unique<ml_metadata::ListResultCache>(cache_options);
+  }
+  std::unique_ptr<ml_metadata::SerializedNodeCache> serialized_node_cache;
+  if ((FLAGS_enable_serialized_node_cache)) {
+    ml_metadata::SerializedNodeCache::Options cache_options;
+    cache_options.max_num_bytes = (FLAGS_serialized_node_cache_max_bytes);
+    serialized_node_cache =
+        absl::make_unique<ml_metadata::SerializedNodeCache>(cache_options);
+  }
+  std::unique_ptr<ml_metadata::TenantStoreManager> tenant_store_manager;
+  if (!(FLAGS_tenant_registry_file).empty()) {
+    CHECK(list_result_cache == nullptr && serialized_node_cache == nullptr)
+        << "The caches cannot be enabled with --tenant_registry_file.";
+    ml_metadata::TenantRegistry tenant_registry;
+    CHECK(ParseTextProtoFile((FLAGS_tenant_registry_file), &tenant_registry))
+        << "Unable to parse the tenant registry file "
+        << (FLAGS_tenant_registry_file);
+    ml_metadata::TenantStoreManager::Options tenant_options;
+    tenant_options.max_num_connections = (FLAGS_tenant_max_connections);
+    tenant_options.max_num_idle_connections =
+        (FLAGS_tenant_max_idle_connections);
+    tenant_options.idle_timeout =
+        absl::Seconds((FLAGS_tenant_idle_timeout_seconds));
+    tenant_options.idle_sweep_interval =
+        absl::Seconds((FLAGS_tenant_idle_sweep_interval_seconds));
+    CHECK_EQ(absl::OkStatus(),
+             ml_metadata::TenantStoreManager::Create(
+                 tenant_registry, tenant_options, &tenant_store_manager));
+  }
+  std::unique_ptr<ml_metadata::PlannerStatisticsMaintainer>
+      planner_statistics_maintainer;
+  if ((FLAGS_enable_planner_statistics_maintenance)) {
+    CHECK(tenant_store_manager == nullptr)
+        << "The planner statistics maintenance cannot be enabled with "
+           "--tenant_registry_file.";
+    ml_metadata::PlannerStatisticsMaintainer::Options maintainer_options;
+    maintainer_options.min_changed_rows =
+        (FLAGS_planner_statistics_min_changed_rows);
+    maintainer_options.max_analyze_interval =
+        absl::Seconds((FLAGS_planner_statistics_max_analyze_interval_seconds));
+    planner_statistics_maintainer =
+        absl::make_unique<ml_metadata::PlannerStatisticsMaintainer>(
+            connection_config, maintainer_options);
+    ml_metadata::MetadataSource::SetTableChangeObserver(
+        planner_statistics_maintainer.get());
+    planner_statistics_maintainer->Start();
+  }
   ml_metadata::MetadataStoreServiceImpl metadata_store_service(
-      connection_config);
+      connection_config, server_stats.get(), list_result_cache.get(),
+      serialized_node_cache.get(), tenant_store_manager.get(),
+      (FLAGS_serialized_node_cache_num_threads));
 
   const string server_address =
       absl::StrCat("0.0.0.0:", (FLAGS_grpc_port));
@@ -576,6 +745,28 @@ int main(int argc, char** argv) {
   std::unique_ptr<::grpc::Server> server(builder.BuildAndStart());
   LOG(INFO) << "Server listening on " << server_address;
 
+  // The admin service is only reachable from the host, without credentials.
+  std::unique_ptr<ml_metadata::MetadataStoreAdminServiceImpl> admin_service;
+  std::unique_ptr<::grpc::Server> admin_server;
+  if ((FLAGS_enable_admin_service)) {
+    const string admin_server_address =
+        absl::StrCat("127.0.0.1:", (FLAGS_admin_grpc_port));
+    admin_service =
+        absl::make_unique<ml_metadata::MetadataStoreAdminServiceImpl>(
+            server_stats.get(), connection_config,
+            (FLAGS_sqlite_backup_directory),
+            planner_statistics_maintainer.get(), list_result_cache.get(),
+            serialized_node_cache.get(), tenant_store_manager.get());
+    ::grpc::ServerBuilder admin_builder;
+    admin_builder.AddListeningPort(admin_server_address,
+                                   ::grpc::InsecureServerCredentials());
+    admin_builder.RegisterService(admin_service.get());
+    admin_server = admin_builder.BuildAndStart();
+    CHECK(admin_server != nullptr)
+        << "Cannot start the admin server on " << admin_server_address;
+    LOG(INFO) << "Admin server listening on " << admin_server_address;
+  }
+
   // keep the program running until the server shuts down.
   server->Wait();
 
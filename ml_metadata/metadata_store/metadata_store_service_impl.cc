@@ -14,14 +14,43 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/metadata_store_service_impl.h"
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <glog/logging.h>
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/repeated_field.h"
+#include <grpcpp/impl/codegen/proto_buffer_reader.h>
+#include <grpcpp/impl/codegen/server_callback_handlers.h>
+#include <grpcpp/support/slice.h>
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "ml_metadata/metadata_store/constants.h"
+#include "ml_metadata/metadata_store/list_result_cache.h"
 #include "ml_metadata/metadata_store/metadata_store.h"
 #include "ml_metadata/metadata_store/metadata_store_factory.h"
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+#include "ml_metadata/metadata_store/server_stats.h"
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+#include "ml_metadata/metadata_store/thread_pool.h"
 
 namespace ml_metadata {
 namespace {
 
+// The client metadata key whose values label the requests in the server stats.
+constexpr char kRequestTagMetadataKey[] = "mlmd-request-tag";
+
+// The gRPC metadata key of the tenant of a request to a multi-tenant server.
+constexpr char kTenantMetadataKey[] = "mlmd-tenant";
+
 // Converts from absl Status to GRPC Status.
 ::grpc::Status ToGRPCStatus(const ::absl::Status& status) {
   // Note: the absl and grpc status codes align with each other.
@@ -29,25 +58,412 @@ namespace {
                         std::string(status.message()));
 }
 
-// Creates a store on demand. The store created does not handle migration.
-::grpc::Status ConnectMetadataStore(
-    const ConnectionConfig& connection_config,
-    std::unique_ptr<MetadataStore>* metadata_store) {
-  return ToGRPCStatus(CreateMetadataStore(connection_config, metadata_store));
+// Closes `metadata_store` instead of giving it back to the pool of its tenant,
+// if it failed with `status` for a reason other than the request, as its
+// database connection may be broken.
+void DiscardIfBroken(const ::grpc::Status& status,
+                     TenantStoreManager::ScopedStore* metadata_store) {
+  switch (status.error_code()) {
+    case ::grpc::StatusCode::OK:
+    case ::grpc::StatusCode::INVALID_ARGUMENT:
+    case ::grpc::StatusCode::NOT_FOUND:
+    case ::grpc::StatusCode::ALREADY_EXISTS:
+    case ::grpc::StatusCode::FAILED_PRECONDITION:
+    case ::grpc::StatusCode::OUT_OF_RANGE:
+    case ::grpc::StatusCode::UNIMPLEMENTED:
+      return;
+    default:
+      metadata_store->Discard();
+  }
+}
+
+// Returns the key of the list request of `method` with `options` in the list
+// result cache. The defaults of the options are made explicit, so that
+// requests that only differ in unset defaults share a key.
+std::string ListResultCacheKey(absl::string_view method,
+                               const ListOperationOptions& options) {
+  ListOperationOptions normalized_options = options;
+  normalized_options.set_max_result_size(options.max_result_size());
+  ListOperationOptions::OrderByField* order_by_field =
+      normalized_options.mutable_order_by_field();
+  order_by_field->set_field(options.order_by_field().field());
+  order_by_field->set_is_asc(options.order_by_field().is_asc());
+  return absl::StrCat(method, ":", normalized_options.SerializeAsString());
+}
+
+// Returns a slice of `bytes` that shares their ownership instead of copying
+// them.
+::grpc::Slice SharedSlice(std::shared_ptr<const std::string> bytes) {
+  auto* owner = new std::shared_ptr<const std::string>(std::move(bytes));
+  return ::grpc::Slice(
+      const_cast<char*>((*owner)->data()), (*owner)->size(),
+      [](void* owner) {
+        delete static_cast<std::shared_ptr<const std::string>*>(owner);
+      },
+      owner);
 }
 
+// Describes GetArtifactsByID for ServeNodesByID.
+struct GetArtifactsByIDMethod {
+  using Request = GetArtifactsByIDRequest;
+  using Response = GetArtifactsByIDResponse;
+  static constexpr char kName[] = "GetArtifactsByID";
+  static constexpr TypeKind kTypeKind = TypeKind::ARTIFACT_TYPE;
+
+  static const google::protobuf::RepeatedField<int64_t>& Ids(
+      const Request& request) {
+    return request.artifact_ids();
+  }
+  // The artifact types are only populated for hydrated artifacts, so requests
+  // of the types are not served from the cache.
+  static bool UsesCache(const Request& request) {
+    return !request.populate_artifact_types();
+  }
+  static google::protobuf::RepeatedPtrField<Artifact>* Nodes(
+      Response* response) {
+    return response->mutable_artifacts();
+  }
+  static google::protobuf::RepeatedField<int64_t>* UnchangedIds(
+      Response* response) {
+    return response->mutable_unchanged_artifact_ids();
+  }
+  static absl::Status Get(MetadataStore* metadata_store,
+                          const Request& request, Response* response) {
+    return metadata_store->GetArtifactsByID(request, response);
+  }
+};
+static_assert(GetArtifactsByIDResponse::kArtifactsFieldNumber ==
+                  SerializedNodeCache::kNodesFieldNumber,
+              "The cached artifacts must be encoded as the response field.");
+
+// Describes GetExecutionsByID for ServeNodesByID.
+struct GetExecutionsByIDMethod {
+  using Request = GetExecutionsByIDRequest;
+  using Response = GetExecutionsByIDResponse;
+  static constexpr char kName[] = "GetExecutionsByID";
+  static constexpr TypeKind kTypeKind = TypeKind::EXECUTION_TYPE;
+
+  static const google::protobuf::RepeatedField<int64_t>& Ids(
+      const Request& request) {
+    return request.execution_ids();
+  }
+  static bool UsesCache(const Request& request) { return true; }
+  static google::protobuf::RepeatedPtrField<Execution>* Nodes(
+      Response* response) {
+    return response->mutable_executions();
+  }
+  static google::protobuf::RepeatedField<int64_t>* UnchangedIds(
+      Response* response) {
+    return response->mutable_unchanged_execution_ids();
+  }
+  static absl::Status Get(MetadataStore* metadata_store,
+                          const Request& request, Response* response) {
+    return metadata_store->GetExecutionsByID(request, response);
+  }
+};
+static_assert(GetExecutionsByIDResponse::kExecutionsFieldNumber ==
+                  SerializedNodeCache::kNodesFieldNumber,
+              "The cached executions must be encoded as the response field.");
+
+// Describes GetContextsByID for ServeNodesByID.
+struct GetContextsByIDMethod {
+  using Request = GetContextsByIDRequest;
+  using Response = GetContextsByIDResponse;
+  static constexpr char kName[] = "GetContextsByID";
+  static constexpr TypeKind kTypeKind = TypeKind::CONTEXT_TYPE;
+
+  static const google::protobuf::RepeatedField<int64_t>& Ids(
+      const Request& request) {
+    return request.context_ids();
+  }
+  static bool UsesCache(const Request& request) { return true; }
+  static google::protobuf::RepeatedPtrField<Context>* Nodes(
+      Response* response) {
+    return response->mutable_contexts();
+  }
+  static google::protobuf::RepeatedField<int64_t>* UnchangedIds(
+      Response* response) {
+    return response->mutable_unchanged_context_ids();
+  }
+  static absl::Status Get(MetadataStore* metadata_store,
+                          const Request& request, Response* response) {
+    return metadata_store->GetContextsByID(request, response);
+  }
+};
+static_assert(GetContextsByIDResponse::kContextsFieldNumber ==
+                  SerializedNodeCache::kNodesFieldNumber,
+              "The cached contexts must be encoded as the response field.");
+
 }  // namespace
 
 MetadataStoreServiceImpl::MetadataStoreServiceImpl(
-    const ConnectionConfig& connection_config)
-    : connection_config_(connection_config) {}
+    const ConnectionConfig& connection_config, ServerStats* server_stats,
+    ListResultCache* list_result_cache,
+    SerializedNodeCache* serialized_node_cache,
+    TenantStoreManager* tenant_store_manager, const int num_serving_threads)
+    : connection_config_(connection_config),
+      server_stats_(server_stats),
+      list_result_cache_(list_result_cache),
+      serialized_node_cache_(serialized_node_cache),
+      tenant_store_manager_(tenant_store_manager) {
+  if (serialized_node_cache_ != nullptr) {
+    serving_thread_pool_ = std::make_unique<ThreadPool>(num_serving_threads);
+    RegisterServeNodesByID<GetArtifactsByIDMethod>();
+    RegisterServeNodesByID<GetExecutionsByIDMethod>();
+    RegisterServeNodesByID<GetContextsByIDMethod>();
+  }
+}
+
+template <typename Method>
+void MetadataStoreServiceImpl::RegisterServeNodesByID() {
+  // The handlers of the service are indexed in the order of the methods in
+  // the proto.
+  const int method_index = Method::Request::descriptor()
+                               ->file()
+                               ->FindServiceByName("MetadataStoreService")
+                               ->FindMethodByName(Method::kName)
+                               ->index();
+  MarkMethodRawCallback(
+      method_index,
+      new ::grpc::internal::CallbackUnaryHandler<::grpc::ByteBuffer,
+                                                 ::grpc::ByteBuffer>(
+          [this](::grpc::CallbackServerContext* context,
+                 const ::grpc::ByteBuffer* request,
+                 ::grpc::ByteBuffer* response) {
+            ::grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+            // The store calls block, so they must not run on the callback
+            // thread. The context, request and response stay valid until
+            // the reactor is finished.
+            serving_thread_pool_->Schedule(
+                [this, context, request, response, reactor]() {
+                  reactor->Finish(
+                      ServeNodesByID<Method>(context, *request, response));
+                });
+            return reactor;
+          }));
+}
+
+template <typename Method>
+::grpc::Status MetadataStoreServiceImpl::ServeNodesByID(
+    ::grpc::CallbackServerContext* context,
+    const ::grpc::ByteBuffer& raw_request, ::grpc::ByteBuffer* raw_response) {
+  typename Method::Request request;
+  {
+    ::grpc::ByteBuffer request_buffer = raw_request;
+    ::grpc::ProtoBufferReader reader(&request_buffer);
+    if (!request.ParseFromZeroCopyStream(&reader)) {
+      return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                            "Failed to parse the request.");
+    }
+  }
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, Method::kName, request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+
+  // Sends the last update times of the cached nodes as known to the store, so
+  // that it returns the ids of the unchanged ones instead of hydrating them.
+  // The nodes the client already knows are left to the client.
+  typename Method::Request store_request = request;
+  absl::flat_hash_map<int64_t, SerializedNodeCache::CachedNode> cached_nodes;
+  const bool uses_cache = Method::UsesCache(request);
+  if (uses_cache) {
+    for (const int64_t id : Method::Ids(request)) {
+      if (request.known_last_update_time_since_epoch().count(id) > 0 ||
+          cached_nodes.contains(id)) {
+        continue;
+      }
+      absl::optional<SerializedNodeCache::CachedNode> cached_node =
+          serialized_node_cache_->Lookup(Method::kTypeKind, id);
+      if (!cached_node.has_value()) continue;
+      (*store_request.mutable_known_last_update_time_since_epoch())[id] =
+          cached_node->last_update_time_since_epoch;
+      cached_nodes.insert({id, *std::move(cached_node)});
+    }
+  }
+  typename Method::Response response;
+  const ::grpc::Status transaction_status = ToGRPCStatus(
+      Method::Get(metadata_store.get(), store_request, &response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << Method::kName
+                 << " failed: " << transaction_status.error_message();
+    return transaction_status;
+  }
+
+  // The encoded nodes of the response, keyed by id.
+  absl::flat_hash_map<int64_t, std::shared_ptr<const std::string>>
+      serialized_nodes;
+  for (const auto& node : *Method::Nodes(&response)) {
+    auto serialized_node = std::make_shared<const std::string>(
+        SerializedNodeCache::SerializeNode(node));
+    if (uses_cache) {
+      serialized_node_cache_->Insert(Method::kTypeKind, node.id(),
+                                     node.last_update_time_since_epoch(),
+                                     serialized_node);
+    }
+    serialized_nodes.insert({node.id(), std::move(serialized_node)});
+  }
+  Method::Nodes(&response)->Clear();
+  google::protobuf::RepeatedField<int64_t> unchanged_ids;
+  unchanged_ids.Swap(Method::UnchangedIds(&response));
+  for (const int64_t id : unchanged_ids) {
+    const auto it = cached_nodes.find(id);
+    if (it == cached_nodes.end()) {
+      Method::UnchangedIds(&response)->Add(id);
+    } else {
+      serialized_nodes.insert({id, it->second.serialized_node});
+    }
+  }
+
+  // Fields may come in any order on the wire, so the nodes are appended after
+  // the rest of the response, in the order of the requested ids.
+  std::vector<::grpc::Slice> slices;
+  slices.reserve(serialized_nodes.size() + 1);
+  slices.push_back(::grpc::Slice(response.SerializeAsString()));
+  for (const int64_t id : Method::Ids(request)) {
+    const auto it = serialized_nodes.find(id);
+    if (it == serialized_nodes.end()) continue;
+    slices.push_back(SharedSlice(std::move(it->second)));
+    serialized_nodes.erase(it);
+  }
+  *raw_response = ::grpc::ByteBuffer(slices.data(), slices.size());
+  return ::grpc::Status::OK;
+}
+
+::grpc::Status MetadataStoreServiceImpl::ConnectMetadataStore(
+    ::grpc::ServerContextBase* context,
+    TenantStoreManager::ScopedStore* metadata_store) {
+  if (tenant_store_manager_ == nullptr) {
+    // Creates a store on demand. The store created does not handle migration.
+    std::unique_ptr<MetadataStore> store;
+    const absl::Status status = CreateMetadataStore(connection_config_, &store);
+    if (!status.ok()) return ToGRPCStatus(status);
+    *metadata_store = TenantStoreManager::ScopedStore(std::move(store));
+    return ::grpc::Status::OK;
+  }
+  const auto tenant = context->client_metadata().find(kTenantMetadataKey);
+  if (tenant == context->client_metadata().end()) {
+    return ::grpc::Status(
+        ::grpc::StatusCode::INVALID_ARGUMENT,
+        absl::StrCat("The request must select a tenant with the ",
+                     kTenantMetadataKey, " metadata."));
+  }
+  return ToGRPCStatus(tenant_store_manager_->Acquire(
+      absl::string_view(tenant->second.data(), tenant->second.size()),
+      metadata_store));
+}
+
+ServerStats::ScopedRequest MetadataStoreServiceImpl::TrackRequest(
+    ::grpc::ServerContextBase* context, absl::string_view method,
+    const google::protobuf::Message& request) {
+  if (server_stats_ == nullptr) return ServerStats::ScopedRequest();
+  std::vector<std::string> tags;
+  const google::protobuf::FieldDescriptor* options_field =
+      request.GetDescriptor()->FindFieldByName("transaction_options");
+  if (options_field != nullptr &&
+      options_field->message_type() == TransactionOptions::descriptor()) {
+    const auto& options = static_cast<const TransactionOptions&>(
+        request.GetReflection()->GetMessage(request, options_field));
+    if (options.has_tag()) tags.push_back(options.tag());
+  }
+  const auto client_tags =
+      context->client_metadata().equal_range(kRequestTagMetadataKey);
+  for (auto it = client_tags.first; it != client_tags.second; ++it) {
+    tags.emplace_back(it->second.data(), it->second.size());
+  }
+  return server_stats_->StartRequest(method, std::move(tags));
+}
+
+ListResultCache::ScopedWrite MetadataStoreServiceImpl::TrackWrite(
+    std::vector<TypeKind> type_kinds) {
+  if (list_result_cache_ == nullptr) return ListResultCache::ScopedWrite();
+  return list_result_cache_->StartWrite(std::move(type_kinds));
+}
+
+::grpc::Status MetadataStoreServiceImpl::ServeListRequest(
+    ::grpc::ServerContextBase* context, absl::string_view method,
+    const ListOperationOptions& options,
+    TypeKind type_kind,
+    const std::function<absl::Status(MetadataStore*)>& list,
+    google::protobuf::Message* response) {
+  bool use_cache = list_result_cache_ != nullptr;
+  std::string cache_key;
+  ListResultCache::WriteEpochs write_epochs;
+  if (use_cache) {
+    cache_key = ListResultCacheKey(method, options);
+    if (!list_result_cache_->options().use_database_write_epochs) {
+      write_epochs = list_result_cache_->local_write_epochs();
+      if (list_result_cache_->Lookup(cache_key, write_epochs, response)) {
+        return ::grpc::Status::OK;
+      }
+    }
+  }
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  if (use_cache && list_result_cache_->options().use_database_write_epochs) {
+    // The epochs are read before the nodes, so a write committed in between
+    // makes the cached response stale rather than wrong.
+    GetWriteEpochsResponse epochs_response;
+    const absl::Status epochs_status = metadata_store->GetWriteEpochs(
+        GetWriteEpochsRequest(), &epochs_response);
+    if (!epochs_status.ok()) {
+      LOG(WARNING) << "Failed to read the write epochs, " << method
+                   << " is not cached: " << epochs_status;
+      use_cache = false;
+    } else {
+      write_epochs[static_cast<int>(TypeKind::EXECUTION_TYPE)] =
+          epochs_response.execution_write_epoch();
+      write_epochs[static_cast<int>(TypeKind::ARTIFACT_TYPE)] =
+          epochs_response.artifact_write_epoch();
+      write_epochs[static_cast<int>(TypeKind::CONTEXT_TYPE)] =
+          epochs_response.context_write_epoch();
+      if (list_result_cache_->Lookup(cache_key, write_epochs, response)) {
+        return ::grpc::Status::OK;
+      }
+    }
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(list(metadata_store.get()));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << method << " failed: "
+                 << transaction_status.error_message();
+    return transaction_status;
+  }
+  if (use_cache) {
+    // Filters may refer to the neighborhood of the nodes, i.e., any kind.
+    std::vector<TypeKind> depends_on_kinds = {type_kind};
+    if (!options.filter_query().empty()) {
+      depends_on_kinds = {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+                          TypeKind::CONTEXT_TYPE};
+    }
+    list_result_cache_->Insert(cache_key, write_epochs, depends_on_kinds,
+                               *response);
+  }
+  return transaction_status;
+}
 
 ::grpc::Status MetadataStoreServiceImpl::PutArtifactType(
     ::grpc::ServerContext* context, const PutArtifactTypeRequest* request,
     PutArtifactTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutArtifactType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -56,6 +472,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutArtifactType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutArtifactType failed: "
                  << transaction_status.error_message();
   }
@@ -65,9 +482,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactType(
     ::grpc::ServerContext* context, const GetArtifactTypeRequest* request,
     GetArtifactTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -76,6 +495,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactType failed: "
                  << transaction_status.error_message();
   }
@@ -85,9 +505,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactTypesByID(
     ::grpc::ServerContext* context, const GetArtifactTypesByIDRequest* request,
     GetArtifactTypesByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactTypesByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -96,6 +518,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactTypesByID(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactTypesByID failed: "
                  << transaction_status.error_message();
   }
@@ -105,9 +528,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactTypes(
     ::grpc::ServerContext* context, const GetArtifactTypesRequest* request,
     GetArtifactTypesResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactTypes", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -116,6 +541,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactTypes(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactTypes failed: "
                  << transaction_status.error_message();
   }
@@ -125,9 +551,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutExecutionType(
     ::grpc::ServerContext* context, const PutExecutionTypeRequest* request,
     PutExecutionTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutExecutionType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -136,6 +564,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutExecutionType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutExecutionType failed: "
                  << transaction_status.error_message();
   }
@@ -145,9 +574,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetExecutionType(
     ::grpc::ServerContext* context, const GetExecutionTypeRequest* request,
     GetExecutionTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -156,6 +587,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionType failed: "
                  << transaction_status.error_message();
   }
@@ -165,9 +597,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetExecutionTypesByID(
     ::grpc::ServerContext* context, const GetExecutionTypesByIDRequest* request,
     GetExecutionTypesByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionTypesByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -176,6 +610,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionTypesByID(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionTypesByID failed: "
                  << transaction_status.error_message();
   }
@@ -185,9 +620,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetExecutionTypes(
     ::grpc::ServerContext* context, const GetExecutionTypesRequest* request,
     GetExecutionTypesResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionTypes", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -196,6 +633,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionTypes(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionTypesByID failed: "
                  << transaction_status.error_message();
   }
@@ -205,9 +643,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutContextType(
     ::grpc::ServerContext* context, const PutContextTypeRequest* request,
     PutContextTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutContextType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -216,6 +656,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutContextType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutContextType failed: "
                  << transaction_status.error_message();
   }
@@ -225,9 +666,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetContextType(
     ::grpc::ServerContext* context, const GetContextTypeRequest* request,
     GetContextTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -236,6 +679,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextType failed: "
                  << transaction_status.error_message();
   }
@@ -245,9 +689,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetContextTypesByID(
     ::grpc::ServerContext* context, const GetContextTypesByIDRequest* request,
     GetContextTypesByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextTypesByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -256,6 +702,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextTypesByID(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextTypesByID failed: "
                  << transaction_status.error_message();
   }
@@ -265,9 +712,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetContextTypes(
     ::grpc::ServerContext* context, const GetContextTypesRequest* request,
     GetContextTypesResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextTypes", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -276,6 +725,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextTypes(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextTypes failed: "
                  << transaction_status.error_message();
   }
@@ -285,9 +735,13 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutArtifacts(
     ::grpc::ServerContext* context, const PutArtifactsRequest* request,
     PutArtifactsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutArtifacts", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::ARTIFACT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -296,6 +750,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutArtifacts(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutArtifacts failed: "
                  << transaction_status.error_message();
   }
@@ -305,9 +760,13 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutExecutions(
     ::grpc::ServerContext* context, const PutExecutionsRequest* request,
     PutExecutionsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutExecutions", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::EXECUTION_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -316,6 +775,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutExecutions(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutExecutions failed: "
                  << transaction_status.error_message();
   }
@@ -325,9 +785,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutTypes(
     ::grpc::ServerContext* context, const PutTypesRequest* request,
     PutTypesResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutTypes", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -336,6 +798,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutTypes(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutTypes failed: " << transaction_status.error_message();
   }
   return transaction_status;
@@ -344,9 +807,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactsByID(
     ::grpc::ServerContext* context, const GetArtifactsByIDRequest* request,
     GetArtifactsByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -355,6 +820,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactsByID(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactsByID failed: "
                  << transaction_status.error_message();
   }
@@ -364,9 +830,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetExecutionsByID(
     ::grpc::ServerContext* context, const GetExecutionsByIDRequest* request,
     GetExecutionsByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionsByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -375,6 +843,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionsByID(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionsByID failed: "
                  << transaction_status.error_message();
   }
@@ -384,9 +853,13 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutEvents(
     ::grpc::ServerContext* context, const PutEventsRequest* request,
     PutEventsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutEvents", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -395,6 +868,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutEvents(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutEvents failed: " << transaction_status.error_message();
   }
   return transaction_status;
@@ -403,9 +877,14 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutExecution(
     ::grpc::ServerContext* context, const PutExecutionRequest* request,
     PutExecutionResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutExecution", *request);
+  const ListResultCache::ScopedWrite tracked_write = TrackWrite(
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -414,6 +893,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutExecution(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutExecution failed: "
                  << transaction_status.error_message();
   }
@@ -424,9 +904,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetEventsByArtifactIDsRequest* request,
     GetEventsByArtifactIDsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetEventsByArtifactIDs", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -435,6 +917,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetEventsByArtifactIDs(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetEventsByArtifactIDs failed: "
                  << transaction_status.error_message();
   }
@@ -445,9 +928,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetEventsByExecutionIDsRequest* request,
     GetEventsByExecutionIDsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetEventsByExecutionIDs", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -456,6 +941,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetEventsByExecutionIDs(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetEventsByExecutionIDs failed: "
                  << transaction_status.error_message();
   }
@@ -465,29 +951,24 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifacts(
     ::grpc::ServerContext* context, const GetArtifactsRequest* request,
     GetArtifactsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
-  const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
-  if (!connection_status.ok()) {
-    LOG(WARNING) << "Failed to connect to the database: "
-                 << connection_status.error_message();
-    return connection_status;
-  }
-  const ::grpc::Status transaction_status =
-      ToGRPCStatus(metadata_store->GetArtifacts(*request, response));
-  if (!transaction_status.ok()) {
-    LOG(WARNING) << "GetArtifacts failed: "
-                 << transaction_status.error_message();
-  }
-  return transaction_status;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifacts", *request);
+  return ServeListRequest(
+      context, "GetArtifacts", request->options(), TypeKind::ARTIFACT_TYPE,
+      [request, response](MetadataStore* metadata_store) {
+        return metadata_store->GetArtifacts(*request, response);
+      },
+      response);
 }
 
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactsByType(
     ::grpc::ServerContext* context, const GetArtifactsByTypeRequest* request,
     GetArtifactsByTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -496,6 +977,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactsByType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactsByType failed: "
                  << transaction_status.error_message();
   }
@@ -506,9 +988,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetArtifactByTypeAndNameRequest* request,
     GetArtifactByTypeAndNameResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactByTypeAndName", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -517,18 +1001,45 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetArtifactByTypeAndName(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactByTypeAndName failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
+::grpc::Status MetadataStoreServiceImpl::GetArtifactsByTypeAndNames(
+    ::grpc::ServerContext* context,
+    const GetArtifactsByTypeAndNamesRequest* request,
+    GetArtifactsByTypeAndNamesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByTypeAndNames", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status = ToGRPCStatus(
+      metadata_store->GetArtifactsByTypeAndNames(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetArtifactsByTypeAndNames failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactsByURI(
     ::grpc::ServerContext* context, const GetArtifactsByURIRequest* request,
     GetArtifactsByURIResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByURI", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -537,6 +1048,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactsByURI(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactsByURI failed: "
                  << transaction_status.error_message();
   }
@@ -547,9 +1059,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetArtifactsByExternalIdsRequest* request,
     GetArtifactsByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -558,6 +1072,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetArtifactsByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactsByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -568,9 +1083,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetExecutionsByExternalIdsRequest* request,
     GetExecutionsByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionsByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -579,6 +1096,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetExecutionsByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionsByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -589,9 +1107,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetContextsByExternalIdsRequest* request,
     GetContextsByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -600,6 +1120,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetContextsByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextsByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -610,9 +1131,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetArtifactTypesByExternalIdsRequest* request,
     GetArtifactTypesByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactTypesByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -621,6 +1144,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetArtifactTypesByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactTypesByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -631,9 +1155,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetExecutionTypesByExternalIdsRequest* request,
     GetExecutionTypesByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionTypesByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -642,6 +1168,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetExecutionTypesByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionTypesByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -652,9 +1179,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetContextTypesByExternalIdsRequest* request,
     GetContextTypesByExternalIdsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextTypesByExternalIds", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -663,6 +1192,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetContextTypesByExternalIds(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextTypesByExternalIds failed: "
                  << transaction_status.error_message();
   }
@@ -672,29 +1202,24 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetExecutions(
     ::grpc::ServerContext* context, const GetExecutionsRequest* request,
     GetExecutionsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
-  const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
-  if (!connection_status.ok()) {
-    LOG(WARNING) << "Failed to connect to the database: "
-                 << connection_status.error_message();
-    return connection_status;
-  }
-  const ::grpc::Status transaction_status =
-      ToGRPCStatus(metadata_store->GetExecutions(*request, response));
-  if (!transaction_status.ok()) {
-    LOG(WARNING) << "GetExecutions failed: "
-                 << transaction_status.error_message();
-  }
-  return transaction_status;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutions", *request);
+  return ServeListRequest(
+      context, "GetExecutions", request->options(), TypeKind::EXECUTION_TYPE,
+      [request, response](MetadataStore* metadata_store) {
+        return metadata_store->GetExecutions(*request, response);
+      },
+      response);
 }
 
 ::grpc::Status MetadataStoreServiceImpl::GetExecutionsByType(
     ::grpc::ServerContext* context, const GetExecutionsByTypeRequest* request,
     GetExecutionsByTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionsByType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -703,6 +1228,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionsByType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionsByType failed: "
                  << transaction_status.error_message();
   }
@@ -713,9 +1239,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetExecutionByTypeAndNameRequest* request,
     GetExecutionByTypeAndNameResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionByTypeAndName", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -724,18 +1252,47 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetExecutionByTypeAndName(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionByTypeAndName failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
+::grpc::Status MetadataStoreServiceImpl::GetExecutionsByTypeAndNames(
+    ::grpc::ServerContext* context,
+    const GetExecutionsByTypeAndNamesRequest* request,
+    GetExecutionsByTypeAndNamesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionsByTypeAndNames", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status = ToGRPCStatus(
+      metadata_store->GetExecutionsByTypeAndNames(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetExecutionsByTypeAndNames failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
 ::grpc::Status MetadataStoreServiceImpl::PutContexts(
     ::grpc::ServerContext* context, const PutContextsRequest* request,
     PutContextsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutContexts", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -744,58 +1301,134 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutContexts(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutContexts failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
-::grpc::Status MetadataStoreServiceImpl::GetContextsByID(
-    ::grpc::ServerContext* context, const GetContextsByIDRequest* request,
-    GetContextsByIDResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+::grpc::Status MetadataStoreServiceImpl::SetProperties(
+    ::grpc::ServerContext* context, const SetPropertiesRequest* request,
+    SetPropertiesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "SetProperties", *request);
+  const ListResultCache::ScopedWrite tracked_write = TrackWrite(
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
     return connection_status;
   }
   const ::grpc::Status transaction_status =
-      ToGRPCStatus(metadata_store->GetContextsByID(*request, response));
+      ToGRPCStatus(metadata_store->SetProperties(*request, response));
   if (!transaction_status.ok()) {
-    LOG(WARNING) << "GetContextsByID failed: "
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "SetProperties failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
-::grpc::Status MetadataStoreServiceImpl::GetContexts(
-    ::grpc::ServerContext* context, const GetContextsRequest* request,
-    GetContextsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+::grpc::Status MetadataStoreServiceImpl::DeleteProperties(
+    ::grpc::ServerContext* context, const DeletePropertiesRequest* request,
+    DeletePropertiesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "DeleteProperties", *request);
+  const ListResultCache::ScopedWrite tracked_write = TrackWrite(
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->DeleteProperties(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "DeleteProperties failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
+::grpc::Status MetadataStoreServiceImpl::ClaimExecutions(
+    ::grpc::ServerContext* context, const ClaimExecutionsRequest* request,
+    ClaimExecutionsResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "ClaimExecutions", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::EXECUTION_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->ClaimExecutions(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "ClaimExecutions failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
+::grpc::Status MetadataStoreServiceImpl::GetContextsByID(
+    ::grpc::ServerContext* context, const GetContextsByIDRequest* request,
+    GetContextsByIDResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByID", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
     return connection_status;
   }
   const ::grpc::Status transaction_status =
-      ToGRPCStatus(metadata_store->GetContexts(*request, response));
+      ToGRPCStatus(metadata_store->GetContextsByID(*request, response));
   if (!transaction_status.ok()) {
-    LOG(WARNING) << "GetContexts failed: "
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetContextsByID failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
+::grpc::Status MetadataStoreServiceImpl::GetContexts(
+    ::grpc::ServerContext* context, const GetContextsRequest* request,
+    GetContextsResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContexts", *request);
+  return ServeListRequest(
+      context, "GetContexts", request->options(), TypeKind::CONTEXT_TYPE,
+      [request, response](MetadataStore* metadata_store) {
+        return metadata_store->GetContexts(*request, response);
+      },
+      response);
+}
+
 ::grpc::Status MetadataStoreServiceImpl::GetContextsByType(
     ::grpc::ServerContext* context, const GetContextsByTypeRequest* request,
     GetContextsByTypeResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByType", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -804,6 +1437,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextsByType(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextsByType failed: "
                  << transaction_status.error_message();
   }
@@ -814,9 +1448,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetContextByTypeAndNameRequest* request,
     GetContextByTypeAndNameResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextByTypeAndName", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -825,19 +1461,49 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextByTypeAndName(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextByTypeAndName failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
 
+::grpc::Status MetadataStoreServiceImpl::GetContextsByTypeAndNames(
+    ::grpc::ServerContext* context,
+    const GetContextsByTypeAndNamesRequest* request,
+    GetContextsByTypeAndNamesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByTypeAndNames", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status = ToGRPCStatus(
+      metadata_store->GetContextsByTypeAndNames(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetContextsByTypeAndNames failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
 ::grpc::Status MetadataStoreServiceImpl::PutAttributionsAndAssociations(
     ::grpc::ServerContext* context,
     const PutAttributionsAndAssociationsRequest* request,
     PutAttributionsAndAssociationsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutAttributionsAndAssociations", *request);
+  const ListResultCache::ScopedWrite tracked_write = TrackWrite(
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -846,6 +1512,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->PutAttributionsAndAssociations(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutAttributionsAndAssociations failed: "
                  << transaction_status.error_message();
   }
@@ -855,9 +1522,13 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutParentContexts(
     ::grpc::ServerContext* context, const PutParentContextsRequest* request,
     PutParentContextsResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutParentContexts", *request);
+  const ListResultCache::ScopedWrite tracked_write =
+      TrackWrite({TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -866,6 +1537,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->PutParentContexts(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutParentContexts failed: "
                  << transaction_status.error_message();
   }
@@ -875,9 +1547,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetContextsByArtifact(
     ::grpc::ServerContext* context, const GetContextsByArtifactRequest* request,
     GetContextsByArtifactResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByArtifact", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -886,6 +1560,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextsByArtifact(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextsByArtifact failed: "
                  << transaction_status.error_message();
   }
@@ -896,9 +1571,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetContextsByExecutionRequest* request,
     GetContextsByExecutionResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextsByExecution", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -907,6 +1584,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetContextsByExecution(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetContextsByExecution failed: "
                  << transaction_status.error_message();
   }
@@ -916,9 +1594,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetArtifactsByContext(
     ::grpc::ServerContext* context, const GetArtifactsByContextRequest* request,
     GetArtifactsByContextResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetArtifactsByContext", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -927,6 +1607,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetArtifactsByContext(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetArtifactsByContext failed: "
                  << transaction_status.error_message();
   }
@@ -937,9 +1618,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetExecutionsByContextRequest* request,
     GetExecutionsByContextResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetExecutionsByContext", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -948,6 +1631,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetExecutionsByContext(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetExecutionsByContext failed: "
                  << transaction_status.error_message();
   }
@@ -958,9 +1642,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetParentContextsByContextRequest* request,
     GetParentContextsByContextResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetParentContextsByContext", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -969,6 +1655,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetParentContextsByContext(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetParentContextsByContext failed: "
                  << transaction_status.error_message();
   }
@@ -979,9 +1666,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
     ::grpc::ServerContext* context,
     const GetChildrenContextsByContextRequest* request,
     GetChildrenContextsByContextResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetChildrenContextsByContext", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -990,6 +1679,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->GetChildrenContextsByContext(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetChildrenContextsByContext failed: "
                  << transaction_status.error_message();
   }
@@ -999,9 +1689,14 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::PutLineageSubgraph(
     ::grpc::ServerContext* context, const PutLineageSubgraphRequest* request,
     PutLineageSubgraphResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "PutLineageSubgraph", *request);
+  const ListResultCache::ScopedWrite tracked_write = TrackWrite(
+      {TypeKind::EXECUTION_TYPE, TypeKind::ARTIFACT_TYPE,
+       TypeKind::CONTEXT_TYPE});
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -1010,6 +1705,7 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status = ToGRPCStatus(
       metadata_store->PutLineageSubgraph(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "PutLineageSubgraph failed: "
                  << transaction_status.error_message();
   }
@@ -1019,9 +1715,11 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
 ::grpc::Status MetadataStoreServiceImpl::GetLineageSubgraph(
     ::grpc::ServerContext* context, const GetLineageSubgraphRequest* request,
     GetLineageSubgraphResponse* response) {
-  std::unique_ptr<MetadataStore> metadata_store;
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetLineageSubgraph", *request);
+  TenantStoreManager::ScopedStore metadata_store;
   const ::grpc::Status connection_status =
-      ConnectMetadataStore(connection_config_, &metadata_store);
+      ConnectMetadataStore(context, &metadata_store);
   if (!connection_status.ok()) {
     LOG(WARNING) << "Failed to connect to the database: "
                  << connection_status.error_message();
@@ -1030,9 +1728,103 @@ MetadataStoreServiceImpl::MetadataStoreServiceImpl(
   const ::grpc::Status transaction_status =
       ToGRPCStatus(metadata_store->GetLineageSubgraph(*request, response));
   if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
     LOG(WARNING) << "GetLineageSubgraph failed: "
                  << transaction_status.error_message();
   }
   return transaction_status;
 }
+
+::grpc::Status MetadataStoreServiceImpl::GetTypeCatalog(
+    ::grpc::ServerContext* context, const GetTypeCatalogRequest* request,
+    GetTypeCatalogResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetTypeCatalog", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->GetTypeCatalog(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetTypeCatalog failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
+::grpc::Status MetadataStoreServiceImpl::GetWriteEpochs(
+    ::grpc::ServerContext* context, const GetWriteEpochsRequest* request,
+    GetWriteEpochsResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetWriteEpochs", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->GetWriteEpochs(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetWriteEpochs failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
+::grpc::Status MetadataStoreServiceImpl::GetContextSummaries(
+    ::grpc::ServerContext* context, const GetContextSummariesRequest* request,
+    GetContextSummariesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "GetContextSummaries", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->GetContextSummaries(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "GetContextSummaries failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
+
+::grpc::Status MetadataStoreServiceImpl::RebuildContextSummaries(
+    ::grpc::ServerContext* context,
+    const RebuildContextSummariesRequest* request,
+    RebuildContextSummariesResponse* response) {
+  const ServerStats::ScopedRequest tracked_request =
+      TrackRequest(context, "RebuildContextSummaries", *request);
+  TenantStoreManager::ScopedStore metadata_store;
+  const ::grpc::Status connection_status =
+      ConnectMetadataStore(context, &metadata_store);
+  if (!connection_status.ok()) {
+    LOG(WARNING) << "Failed to connect to the database: "
+                 << connection_status.error_message();
+    return connection_status;
+  }
+  const ::grpc::Status transaction_status =
+      ToGRPCStatus(metadata_store->RebuildContextSummaries(*request, response));
+  if (!transaction_status.ok()) {
+    DiscardIfBroken(transaction_status, &metadata_store);
+    LOG(WARNING) << "RebuildContextSummaries failed: "
+                 << transaction_status.error_message();
+  }
+  return transaction_status;
+}
 }  // namespace ml_metadata
@@ -15,7 +15,22 @@ limitations under the License.
 #ifndef ML_METADATA_METADATA_STORE_METADATA_STORE_SERVICE_IMPL_H_
 #define ML_METADATA_METADATA_STORE_METADATA_STORE_SERVICE_IMPL_H_
 
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "google/protobuf/message.h"
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "ml_metadata/metadata_store/constants.h"
+#include "ml_metadata/metadata_store/list_result_cache.h"
 #include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+#include "ml_metadata/metadata_store/server_stats.h"
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+#include "ml_metadata/metadata_store/thread_pool.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/proto/metadata_store_service.grpc.pb.h"
 
@@ -24,11 +39,30 @@ namespace ml_metadata {
 // A metadata store gRPC server that implements MetadataStoreService defined in
 // proto/metadata_store_service.proto. It is thread-safe.
 // Note, concurrent call to methods in different threads are sequential.
-// TODO(b/123039345) Add a connection pool in metadata_store or grpc service.
 class MetadataStoreServiceImpl final
     : public MetadataStoreService::Service {
  public:
-  explicit MetadataStoreServiceImpl(const ConnectionConfig& connection_config);
+  // If `server_stats` is not nullptr, the requests being served are tracked
+  // in it. If `list_result_cache` is not nullptr, the responses of
+  // GetArtifacts, GetExecutions and GetContexts are cached in it. If
+  // `serialized_node_cache` is not nullptr, GetArtifactsByID,
+  // GetExecutionsByID and GetContextsByID are served in wire format, and the
+  // nodes they return are cached in it. Their store calls then run on a pool
+  // of `num_serving_threads` threads, which the service owns, instead of on
+  // the gRPC callback threads. If `tenant_store_manager` is not
+  // nullptr, the requests are served by the stores of the tenant in their
+  // `mlmd-tenant` metadata, and `connection_config` is not used. A store that
+  // fails for a reason other than the request is closed rather than reused.
+  // The caches are not partitioned by tenant, so they must not be used with a
+  // `tenant_store_manager`. None of the pointers is owned, and all must
+  // outlive the service.
+  explicit MetadataStoreServiceImpl(
+      const ConnectionConfig& connection_config,
+      ServerStats* server_stats = nullptr,
+      ListResultCache* list_result_cache = nullptr,
+      SerializedNodeCache* serialized_node_cache = nullptr,
+      TenantStoreManager* tenant_store_manager = nullptr,
+      int num_serving_threads = 16);
 
   // default & copy constructors are disallowed.
   MetadataStoreServiceImpl() = delete;
@@ -166,6 +200,11 @@ class MetadataStoreServiceImpl final
       const GetArtifactByTypeAndNameRequest* request,
       GetArtifactByTypeAndNameResponse* response) override;
 
+  ::grpc::Status GetArtifactsByTypeAndNames(
+      ::grpc::ServerContext* context,
+      const GetArtifactsByTypeAndNamesRequest* request,
+      GetArtifactsByTypeAndNamesResponse* response) override;
+
   ::grpc::Status GetArtifactsByURI(
       ::grpc::ServerContext* context, const GetArtifactsByURIRequest* request,
       GetArtifactsByURIResponse* response) override;
@@ -183,10 +222,27 @@ class MetadataStoreServiceImpl final
       const GetExecutionByTypeAndNameRequest* request,
       GetExecutionByTypeAndNameResponse* response) override;
 
+  ::grpc::Status GetExecutionsByTypeAndNames(
+      ::grpc::ServerContext* context,
+      const GetExecutionsByTypeAndNamesRequest* request,
+      GetExecutionsByTypeAndNamesResponse* response) override;
+
   ::grpc::Status PutContexts(::grpc::ServerContext* context,
                              const PutContextsRequest* request,
                              PutContextsResponse* response) override;
 
+  ::grpc::Status SetProperties(::grpc::ServerContext* context,
+                               const SetPropertiesRequest* request,
+                               SetPropertiesResponse* response) override;
+
+  ::grpc::Status DeleteProperties(::grpc::ServerContext* context,
+                                  const DeletePropertiesRequest* request,
+                                  DeletePropertiesResponse* response) override;
+
+  ::grpc::Status ClaimExecutions(::grpc::ServerContext* context,
+                                 const ClaimExecutionsRequest* request,
+                                 ClaimExecutionsResponse* response) override;
+
   ::grpc::Status GetContextsByID(::grpc::ServerContext* context,
                                  const GetContextsByIDRequest* request,
                                  GetContextsByIDResponse* response) override;
@@ -204,6 +260,11 @@ class MetadataStoreServiceImpl final
       const GetContextByTypeAndNameRequest* request,
       GetContextByTypeAndNameResponse* response) override;
 
+  ::grpc::Status GetContextsByTypeAndNames(
+      ::grpc::ServerContext* context,
+      const GetContextsByTypeAndNamesRequest* request,
+      GetContextsByTypeAndNamesResponse* response) override;
+
   ::grpc::Status PutAttributionsAndAssociations(
       ::grpc::ServerContext* context,
       const PutAttributionsAndAssociationsRequest* request,
@@ -251,8 +312,76 @@ class MetadataStoreServiceImpl final
       ::grpc::ServerContext* context, const GetLineageSubgraphRequest* request,
       GetLineageSubgraphResponse* response) override;
 
+  ::grpc::Status GetTypeCatalog(::grpc::ServerContext* context,
+                                const GetTypeCatalogRequest* request,
+                                GetTypeCatalogResponse* response) override;
+
+  ::grpc::Status GetWriteEpochs(::grpc::ServerContext* context,
+                                const GetWriteEpochsRequest* request,
+                                GetWriteEpochsResponse* response) override;
+
+  ::grpc::Status GetContextSummaries(
+      ::grpc::ServerContext* context, const GetContextSummariesRequest* request,
+      GetContextSummariesResponse* response) override;
+
+  ::grpc::Status RebuildContextSummaries(
+      ::grpc::ServerContext* context,
+      const RebuildContextSummariesRequest* request,
+      RebuildContextSummariesResponse* response) override;
+
  private:
+  // Lends a store to serve the request of `context` in `metadata_store`:
+  // a store of the request's tenant from `tenant_store_manager_` if set,
+  // otherwise a new store connected with `connection_config_`.
+  ::grpc::Status ConnectMetadataStore(
+      ::grpc::ServerContextBase* context,
+      TenantStoreManager::ScopedStore* metadata_store);
+
+  // Tracks the request of `method` in `server_stats_` until the returned
+  // object is destroyed. The request is labeled by its
+  // `transaction_options.tag` and the `mlmd-request-tag` client metadata.
+  ServerStats::ScopedRequest TrackRequest(
+      ::grpc::ServerContextBase* context, absl::string_view method,
+      const google::protobuf::Message& request);
+
+  // Marks a write of the node kinds `type_kinds` as in-flight in
+  // `list_result_cache_` until the returned object is destroyed.
+  ListResultCache::ScopedWrite TrackWrite(std::vector<TypeKind> type_kinds);
+
+  // Serves the list request of `method` with `options` from
+  // `list_result_cache_` if possible. Otherwise runs `list` on a store,
+  // and caches the `response` it fills. `type_kind` is the kind of the listed
+  // nodes.
+  ::grpc::Status ServeListRequest(
+      ::grpc::ServerContextBase* context, absl::string_view method,
+      const ListOperationOptions& options,
+      TypeKind type_kind,
+      const std::function<absl::Status(MetadataStore*)>& list,
+      google::protobuf::Message* response);
+
+  // Serves the GetArtifactsByID, GetExecutionsByID or GetContextsByID request
+  // in `raw_request`, as described by `Method`. The nodes that did not change
+  // since they were cached in `serialized_node_cache_` are not hydrated, and
+  // their cached bytes are spliced into `raw_response` as is. The other nodes
+  // are cached.
+  template <typename Method>
+  ::grpc::Status ServeNodesByID(::grpc::CallbackServerContext* context,
+                                const ::grpc::ByteBuffer& raw_request,
+                                ::grpc::ByteBuffer* raw_response);
+
+  // Serves `Method` with ServeNodesByID on `serving_thread_pool_` instead of
+  // its synchronous handler.
+  template <typename Method>
+  void RegisterServeNodesByID();
+
   const ConnectionConfig connection_config_;
+  ServerStats* const server_stats_;
+  ListResultCache* const list_result_cache_;
+  SerializedNodeCache* const serialized_node_cache_;
+  TenantStoreManager* const tenant_store_manager_;
+  // Runs ServeNodesByID. It is declared last, so that it finishes the
+  // requests in flight before the other members are destroyed.
+  std::unique_ptr<ThreadPool> serving_thread_pool_;
 };
 
 }  // namespace ml_metadata
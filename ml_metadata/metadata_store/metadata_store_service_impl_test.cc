@@ -0,0 +1,315 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/metadata_store_service_impl.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "grpcpp/channel.h"
+#include "grpcpp/client_context.h"
+#include "grpcpp/server.h"
+#include "grpcpp/server_builder.h"
+#include "grpcpp/support/channel_arguments.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/metadata_store_factory.h"
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+#include "ml_metadata/metadata_store/test_util.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_service.grpc.pb.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+using ::ml_metadata::testing::EqualsProto;
+
+class MetadataStoreServiceImplTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    connection_config_.mutable_sqlite()->set_filename_uri(absl::StrCat(
+        ::testing::TempDir(), "/",
+        ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+        ".db"));
+    CreateDatabase(connection_config_);
+  }
+
+  void TearDown() override {
+    if (server_ != nullptr) server_->Shutdown();
+  }
+
+  // Creates an empty SQLite database at `connection_config`.
+  static void CreateDatabase(const ConnectionConfig& connection_config) {
+    std::remove(connection_config.sqlite().filename_uri().c_str());
+    std::unique_ptr<MetadataStore> metadata_store;
+    ASSERT_EQ(CreateMetadataStore(connection_config, &metadata_store),
+              absl::OkStatus());
+    ASSERT_EQ(metadata_store->InitMetadataStoreIfNotExists(),
+              absl::OkStatus());
+  }
+
+  // Serves a MetadataStoreServiceImpl backed by `serialized_node_cache` and
+  // `tenant_store_manager` in process, and connects `stub_` to it.
+  void StartServer(SerializedNodeCache* serialized_node_cache,
+                   TenantStoreManager* tenant_store_manager = nullptr) {
+    service_ = std::make_unique<MetadataStoreServiceImpl>(
+        connection_config_, /*server_stats=*/nullptr,
+        /*list_result_cache=*/nullptr, serialized_node_cache,
+        tenant_store_manager);
+    ::grpc::ServerBuilder builder;
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(server_, nullptr);
+    stub_ = MetadataStoreService::NewStub(
+        server_->InProcessChannel(::grpc::ChannelArguments()));
+  }
+
+  // Calls `method` on `stub_` with a fresh client context, on behalf of
+  // `tenant` if not empty.
+  template <typename Request, typename Response>
+  ::grpc::Status Call(::grpc::Status (MetadataStoreService::Stub::*method)(
+                          ::grpc::ClientContext*, const Request&, Response*),
+                      const Request& request, Response* response,
+                      const std::string& tenant = "") {
+    ::grpc::ClientContext context;
+    if (!tenant.empty()) context.AddMetadata("mlmd-tenant", tenant);
+    return (stub_.get()->*method)(&context, request, response);
+  }
+
+  ConnectionConfig connection_config_;
+  std::unique_ptr<MetadataStoreServiceImpl> service_;
+  std::unique_ptr<::grpc::Server> server_;
+  std::unique_ptr<MetadataStoreService::Stub> stub_;
+};
+
+TEST_F(MetadataStoreServiceImplTest, GetArtifactsByIDUsesSerializedNodeCache) {
+  SerializedNodeCache serialized_node_cache;
+  StartServer(&serialized_node_cache);
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifactType,
+                   put_type_request, &put_type_response)
+                  .ok());
+  PutArtifactsRequest put_request;
+  Artifact* artifact = put_request.add_artifacts();
+  artifact->set_type_id(put_type_response.type_id());
+  artifact->set_uri("uri");
+  PutArtifactsResponse put_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifacts, put_request,
+                   &put_response)
+                  .ok());
+
+  GetArtifactsByIDRequest get_request;
+  get_request.add_artifact_ids(put_response.artifact_ids(0));
+  GetArtifactsByIDResponse first_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetArtifactsByID, get_request,
+                   &first_response)
+                  .ok());
+  ASSERT_EQ(first_response.artifacts_size(), 1);
+  EXPECT_EQ(first_response.artifacts(0).uri(), "uri");
+  EXPECT_EQ(serialized_node_cache.num_hits(), 0);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+
+  GetArtifactsByIDResponse second_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetArtifactsByID, get_request,
+                   &second_response)
+                  .ok());
+  EXPECT_THAT(second_response, EqualsProto(first_response));
+  EXPECT_EQ(serialized_node_cache.num_hits(), 1);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+}
+
+TEST_F(MetadataStoreServiceImplTest,
+       GetExecutionsByIDUsesSerializedNodeCache) {
+  SerializedNodeCache serialized_node_cache;
+  StartServer(&serialized_node_cache);
+  PutExecutionTypeRequest put_type_request;
+  put_type_request.mutable_execution_type()->set_name("execution_type");
+  PutExecutionTypeResponse put_type_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutExecutionType,
+                   put_type_request, &put_type_response)
+                  .ok());
+  PutExecutionsRequest put_request;
+  Execution* execution = put_request.add_executions();
+  execution->set_type_id(put_type_response.type_id());
+  execution->set_last_known_state(Execution::RUNNING);
+  PutExecutionsResponse put_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutExecutions, put_request,
+                   &put_response)
+                  .ok());
+
+  GetExecutionsByIDRequest get_request;
+  get_request.add_execution_ids(put_response.execution_ids(0));
+  GetExecutionsByIDResponse first_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetExecutionsByID,
+                   get_request, &first_response)
+                  .ok());
+  ASSERT_EQ(first_response.executions_size(), 1);
+  EXPECT_EQ(first_response.executions(0).last_known_state(),
+            Execution::RUNNING);
+  EXPECT_EQ(serialized_node_cache.num_hits(), 0);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+
+  GetExecutionsByIDResponse second_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetExecutionsByID,
+                   get_request, &second_response)
+                  .ok());
+  EXPECT_THAT(second_response, EqualsProto(first_response));
+  EXPECT_EQ(serialized_node_cache.num_hits(), 1);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+}
+
+TEST_F(MetadataStoreServiceImplTest, GetContextsByIDUsesSerializedNodeCache) {
+  SerializedNodeCache serialized_node_cache;
+  StartServer(&serialized_node_cache);
+  PutContextTypeRequest put_type_request;
+  put_type_request.mutable_context_type()->set_name("context_type");
+  PutContextTypeResponse put_type_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutContextType,
+                   put_type_request, &put_type_response)
+                  .ok());
+  PutContextsRequest put_request;
+  Context* context = put_request.add_contexts();
+  context->set_type_id(put_type_response.type_id());
+  context->set_name("context");
+  PutContextsResponse put_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutContexts, put_request,
+                   &put_response)
+                  .ok());
+
+  GetContextsByIDRequest get_request;
+  get_request.add_context_ids(put_response.context_ids(0));
+  GetContextsByIDResponse first_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetContextsByID, get_request,
+                   &first_response)
+                  .ok());
+  ASSERT_EQ(first_response.contexts_size(), 1);
+  EXPECT_EQ(first_response.contexts(0).name(), "context");
+  EXPECT_EQ(serialized_node_cache.num_hits(), 0);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+
+  GetContextsByIDResponse second_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetContextsByID, get_request,
+                   &second_response)
+                  .ok());
+  EXPECT_THAT(second_response, EqualsProto(first_response));
+  EXPECT_EQ(serialized_node_cache.num_hits(), 1);
+  EXPECT_EQ(serialized_node_cache.num_misses(), 1);
+}
+
+TEST_F(MetadataStoreServiceImplTest, ReportsFailedChunkOfChunkedCommit) {
+  StartServer(/*serialized_node_cache=*/nullptr);
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifactType,
+                   put_type_request, &put_type_response)
+                  .ok());
+  PutArtifactsRequest put_request;
+  for (int i = 0; i < 6; ++i) {
+    Artifact* artifact = put_request.add_artifacts();
+    artifact->set_type_id(put_type_response.type_id());
+    artifact->set_uri(absl::StrCat("uri_", i));
+  }
+  // The artifact at index 2 has an unknown type, so the second chunk fails.
+  put_request.mutable_artifacts(2)->set_type_id(put_type_response.type_id() +
+                                                100);
+  put_request.mutable_chunked_commit_options()->set_max_nodes_per_chunk(2);
+
+  // The progress reaches the client, as the call itself succeeds.
+  PutArtifactsResponse put_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifacts, put_request,
+                   &put_response)
+                  .ok());
+  EXPECT_EQ(put_response.artifact_ids_size(), 2);
+  ASSERT_TRUE(put_response.chunked_commit_result().has_failed_chunk());
+  EXPECT_EQ(put_response.chunked_commit_result().failed_chunk().begin_index(),
+            2);
+
+  // Resumes with the returned fields only.
+  put_request.mutable_artifacts(2)->set_type_id(put_type_response.type_id());
+  put_request.mutable_chunked_commit_options()->set_resume_from_index(
+      put_response.chunked_commit_result().num_committed_nodes());
+  PutArtifactsResponse resumed_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifacts, put_request,
+                   &resumed_response)
+                  .ok());
+  EXPECT_EQ(resumed_response.artifact_ids_size(), 4);
+  EXPECT_EQ(resumed_response.chunked_commit_result().num_committed_nodes(), 6);
+  EXPECT_FALSE(resumed_response.chunked_commit_result().has_failed_chunk());
+
+  GetArtifactsRequest get_request;
+  GetArtifactsResponse get_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetArtifacts, get_request,
+                   &get_response)
+                  .ok());
+  EXPECT_EQ(get_response.artifacts_size(), 6);
+}
+
+TEST_F(MetadataStoreServiceImplTest, RoutesRequestsByTenantMetadata) {
+  // Each tenant has a database file of its own.
+  TenantRegistry registry;
+  for (const std::string tenant : {"a", "b"}) {
+    TenantRegistry::Tenant* registered_tenant = registry.add_tenants();
+    registered_tenant->set_name(tenant);
+    registered_tenant->mutable_connection_config()
+        ->mutable_sqlite()
+        ->set_filename_uri(absl::StrCat(
+            connection_config_.sqlite().filename_uri(), ".", tenant));
+    CreateDatabase(registered_tenant->connection_config());
+  }
+  std::unique_ptr<TenantStoreManager> tenant_store_manager;
+  ASSERT_EQ(TenantStoreManager::Create(registry, TenantStoreManager::Options(),
+                                       &tenant_store_manager),
+            absl::OkStatus());
+  StartServer(/*serialized_node_cache=*/nullptr, tenant_store_manager.get());
+
+  PutArtifactTypeRequest put_request;
+  put_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::PutArtifactType, put_request,
+                   &put_response, "a")
+                  .ok());
+
+  GetArtifactTypeRequest get_request;
+  get_request.set_type_name("artifact_type");
+  GetArtifactTypeResponse get_response;
+  ASSERT_TRUE(Call(&MetadataStoreService::Stub::GetArtifactType, get_request,
+                   &get_response, "a")
+                  .ok());
+  EXPECT_EQ(get_response.artifact_type().id(), put_response.type_id());
+  // The type is only in the database of `a`.
+  EXPECT_EQ(Call(&MetadataStoreService::Stub::GetArtifactType, get_request,
+                 &get_response, "b")
+                .error_code(),
+            ::grpc::StatusCode::NOT_FOUND);
+  // A request must select a tenant.
+  EXPECT_EQ(Call(&MetadataStoreService::Stub::GetArtifactType, get_request,
+                 &get_response)
+                .error_code(),
+            ::grpc::StatusCode::INVALID_ARGUMENT);
+  // The stores are reused across the requests of a tenant.
+  EXPECT_EQ(tenant_store_manager->num_connections(), 2);
+  EXPECT_EQ(tenant_store_manager->num_idle_connections(), 2);
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -42,6 +42,9 @@ class MetadataStoreServiceInterface {
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutTypes)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutContextType)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutContexts)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(SetProperties)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(DeleteProperties)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(ClaimExecutions)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutAttributionsAndAssociations)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutParentContexts)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(PutLineageSubgraph)
@@ -65,12 +68,15 @@ class MetadataStoreServiceInterface {
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextsByID)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetArtifactsByType)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetArtifactByTypeAndName)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetArtifactsByTypeAndNames)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetArtifactsByExternalIds)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetExecutionsByType)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetExecutionByTypeAndName)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetExecutionsByTypeAndNames)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetExecutionsByExternalIds)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextsByType)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextByTypeAndName)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextsByTypeAndNames)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextsByExternalIds)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetArtifactsByURI)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetEventsByExecutionIDs)
@@ -87,6 +93,10 @@ class MetadataStoreServiceInterface {
   // traffic.
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetLineageGraph)
   METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetLineageSubgraph)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetTypeCatalog)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetWriteEpochs)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(GetContextSummaries)
+  METADATA_STORE_SERVICE_INTERFACE_DECLARE(RebuildContextSummaries)
 
 #undef METADATA_STORE_SERVICE_INTERFACE_DECLARE
 };
@@ -0,0 +1,84 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Binary that writes an immutable SQLite snapshot of a live ml.metadata store,
+// for read-heavy offline analysis. The snapshot is served by opening it with
+// the IMMUTABLE_SNAPSHOT connection mode of SqliteMetadataSourceConfig, e.g.,
+// from a metadata_store_server with the config file:
+//
+//   connection_config {
+//     sqlite {
+//       filename_uri: "/path/to/snapshot.db"
+//       connection_mode: IMMUTABLE_SNAPSHOT
+//     }
+//   }
+
+#include <fstream>
+#include <string>
+
+#include "gflags/gflags.h"
+#include <glog/logging.h>
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/text_format.h"
+#include "absl/status/status.h"
+#include "ml_metadata/metadata_store/snapshot_util.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+DEFINE_string(metadata_store_server_config_file, "",
+              "The MetadataStoreServerConfig text proto file, whose "
+              "connection_config is the store to take the snapshot of.");
+DEFINE_string(snapshot_filename, "",
+              "The file to write the SQLite snapshot to. It must not exist or "
+              "be an empty database.");
+
+namespace {
+
+// Parses the connection config of the server config file `filename`, and
+// returns true if it is successful in populating `connection_config`.
+bool ParseConnectionConfig(const std::string& filename,
+                           ml_metadata::ConnectionConfig* connection_config) {
+  std::ifstream input_file_stream(filename);
+  if (!input_file_stream) {
+    return false;
+  }
+  google::protobuf::io::IstreamInputStream file_stream(&input_file_stream);
+  ml_metadata::MetadataStoreServerConfig server_config;
+  if (!google::protobuf::TextFormat::Parse(&file_stream, &server_config)) {
+    return false;
+  }
+  *connection_config = server_config.connection_config();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  CHECK(!FLAGS_snapshot_filename.empty()) << "--snapshot_filename is required.";
+  ml_metadata::ConnectionConfig connection_config;
+  CHECK(ParseConnectionConfig(FLAGS_metadata_store_server_config_file,
+                              &connection_config))
+      << "Unable to read the connection config from "
+         "--metadata_store_server_config_file.";
+
+  const absl::Status status = ml_metadata::CreateSqliteSnapshot(
+      connection_config, FLAGS_snapshot_filename);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to create the snapshot: " << status;
+    return -1;
+  }
+  LOG(INFO) << "Wrote the snapshot to " << FLAGS_snapshot_filename;
+  return 0;
+}
@@ -54,6 +54,8 @@ constexpr int64_t kTestNumArtifactsInLongLineageGraph = 4;
 constexpr int64_t kTestNumExecutionsInLongLineageGraph = 3;
 constexpr int64_t kTestNumContextsInLongLineageGraph = 3;
 
+using ::testing::Gt;
+using ::testing::IsEmpty;
 using ::testing::SizeIs;
 using ::testing::UnorderedElementsAreArray;
 using ::testing::UnorderedPointwise;
@@ -1454,6 +1456,56 @@ TEST(MetadataStoreExtendedTest, GetLineageSubgraphErrors) {
     EXPECT_TRUE(absl::IsNotFound(status));
   }
 }
+
+TEST(MetadataStoreExtendedTest, GetLineageSubgraphWithKnownTypeCatalogVersion) {
+  std::unique_ptr<MetadataStore> metadata_store = CreateMetadataStore();
+  int64_t min_creation_time;
+  std::vector<Artifact> want_artifacts;
+  std::vector<Execution> want_executions;
+  ASSERT_EQ(CreateLineageGraph(*metadata_store, min_creation_time,
+                               want_artifacts, want_executions),
+            absl::OkStatus());
+  GetLineageSubgraphRequest req;
+  req.mutable_lineage_subgraph_query_options()
+      ->mutable_starting_artifacts()
+      ->set_filter_query("uri = 'uri://foo/a4'");
+  req.mutable_lineage_subgraph_query_options()->set_max_num_hops(20);
+  GetLineageSubgraphResponse resp;
+  ASSERT_EQ(metadata_store->GetLineageSubgraph(req, &resp), absl::OkStatus());
+  const int64_t type_catalog_version = resp.type_catalog_version();
+  EXPECT_GT(type_catalog_version, 0);
+  EXPECT_THAT(resp.lineage_subgraph().artifact_types(), SizeIs(1));
+
+  // The client already has the types of the current version.
+  req.set_known_type_catalog_version(type_catalog_version);
+  ASSERT_EQ(metadata_store->GetLineageSubgraph(req, &resp), absl::OkStatus());
+  EXPECT_EQ(resp.type_catalog_version(), type_catalog_version);
+  EXPECT_THAT(resp.lineage_subgraph().artifacts(), SizeIs(Gt(0)));
+  EXPECT_THAT(resp.lineage_subgraph().artifact_types(), IsEmpty());
+  EXPECT_THAT(resp.lineage_subgraph().execution_types(), IsEmpty());
+  EXPECT_THAT(resp.lineage_subgraph().context_types(), IsEmpty());
+
+  // Only the changed type is returned after adding a property to it.
+  GetArtifactTypesByIDRequest get_type_req;
+  get_type_req.add_type_ids(want_artifacts[0].type_id());
+  GetArtifactTypesByIDResponse get_type_resp;
+  ASSERT_EQ(metadata_store->GetArtifactTypesByID(get_type_req, &get_type_resp),
+            absl::OkStatus());
+  PutArtifactTypeRequest put_type_req;
+  *put_type_req.mutable_artifact_type() = get_type_resp.artifact_types(0);
+  (*put_type_req.mutable_artifact_type()->mutable_properties())["new_p"] =
+      STRING;
+  put_type_req.set_can_add_fields(true);
+  PutArtifactTypeResponse put_type_resp;
+  ASSERT_EQ(metadata_store->PutArtifactType(put_type_req, &put_type_resp),
+            absl::OkStatus());
+  ASSERT_EQ(metadata_store->GetLineageSubgraph(req, &resp), absl::OkStatus());
+  EXPECT_GT(resp.type_catalog_version(), type_catalog_version);
+  ASSERT_THAT(resp.lineage_subgraph().artifact_types(), SizeIs(1));
+  EXPECT_EQ(resp.lineage_subgraph().artifact_types(0).id(),
+            want_artifacts[0].type_id());
+  EXPECT_THAT(resp.lineage_subgraph().execution_types(), IsEmpty());
+}
 }  // namespace
 
 INSTANTIATE_TEST_SUITE_P(
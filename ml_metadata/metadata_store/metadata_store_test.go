@@ -23,6 +23,7 @@ import (
 	"google.golang.org/protobuf/proto"
 	"google.golang.org/protobuf/testing/protocmp"
 	mdpb "ml_metadata/proto/metadata_store_go_proto"
+	apipb "ml_metadata/proto/metadata_store_service_go_proto"
 )
 
 var artifactCmpOpts = []cmp.Option{
@@ -42,7 +43,7 @@ var contextCmpOpts = []cmp.Option{
 
 // createStore creates a store and returns it if there is no error.
 // It also takes care of closing it automatically.
-func createStore(t *testing.T) *Store {
+func createStore(t testing.TB) *Store {
 	t.Helper()
 
 	store, err := NewStore(&mdpb.ConnectionConfig{
@@ -1557,3 +1558,118 @@ func TestPutDuplicatedAttributionsAndEmptyAssociations(t *testing.T) {
 		t.Errorf("GetArtifactsByContext returned result is incorrect. want: %v, got: %v", wantArtifact, gotArtifacts[0])
 	}
 }
+
+func TestExecuteBatch(t *testing.T) {
+	store := createStore(t)
+	typeID := putAndGetArtifactTypeID(t, store, "test_type")
+
+	wantArtifact := &mdpb.Artifact{TypeId: proto.Int64(int64(typeID)), Uri: proto.String("testuri://batch")}
+	results, err := store.ExecuteBatch([]*apipb.ExecuteBatchRequest_Call{
+		{Request: &apipb.ExecuteBatchRequest_Call_PutArtifacts{
+			PutArtifacts: &apipb.PutArtifactsRequest{Artifacts: []*mdpb.Artifact{wantArtifact}},
+		}},
+		{Request: &apipb.ExecuteBatchRequest_Call_GetArtifactType{
+			GetArtifactType: &apipb.GetArtifactTypeRequest{TypeName: proto.String("test_type")},
+		}},
+	})
+	if err != nil {
+		t.Fatalf("ExecuteBatch failed: %v", err)
+	}
+	if len(results) != 2 {
+		t.Fatalf("ExecuteBatch returned %v results, want 2", len(results))
+	}
+	ids := results[0].GetPutArtifacts().GetArtifactIds()
+	if len(ids) != 1 {
+		t.Fatalf("ExecuteBatch returned artifact ids %v, want 1 id", ids)
+	}
+	if got := results[1].GetGetArtifactType().GetArtifactType().GetId(); got != int64(typeID) {
+		t.Errorf("ExecuteBatch returned type id %v, want %v", got, typeID)
+	}
+	gotArtifacts, err := store.GetArtifactsByID([]ArtifactID{ArtifactID(ids[0])})
+	if err != nil {
+		t.Fatalf("GetArtifactsByID failed: %v", err)
+	}
+	wantArtifact.Id = proto.Int64(ids[0])
+	wantArtifact.Type = proto.String("test_type")
+	if wantArtifacts := []*mdpb.Artifact{wantArtifact}; !cmp.Equal(wantArtifacts, gotArtifacts, artifactCmpOpts...) {
+		t.Errorf("store.GetArtifactsByID(%v) = %v, want: %v", ids, gotArtifacts, wantArtifacts)
+	}
+
+	// A failed call rolls back the whole batch.
+	_, err = store.ExecuteBatch([]*apipb.ExecuteBatchRequest_Call{
+		{Request: &apipb.ExecuteBatchRequest_Call_PutArtifacts{
+			PutArtifacts: &apipb.PutArtifactsRequest{Artifacts: []*mdpb.Artifact{{TypeId: proto.Int64(int64(typeID))}}},
+		}},
+		{Request: &apipb.ExecuteBatchRequest_Call_GetArtifactType{
+			GetArtifactType: &apipb.GetArtifactTypeRequest{TypeName: proto.String("unknown_type")},
+		}},
+	})
+	if err == nil {
+		t.Errorf("ExecuteBatch with an unknown type name should fail")
+	}
+	allArtifacts, err := store.GetArtifacts()
+	if err != nil {
+		t.Fatalf("GetArtifacts failed: %v", err)
+	}
+	if len(allArtifacts) != 1 {
+		t.Errorf("GetArtifacts returned %v artifacts, want 1", len(allArtifacts))
+	}
+}
+
+// setUpBenchmarkArtifacts creates a store with `n` artifacts, and returns it
+// with the artifact ids.
+func setUpBenchmarkArtifacts(b *testing.B, n int) (*Store, []ArtifactID) {
+	b.Helper()
+	store := createStore(b)
+	typeID, err := store.PutArtifactType(&mdpb.ArtifactType{Name: proto.String("benchmark_type")}, &PutTypeOptions{AllFieldsMustMatch: true})
+	if err != nil {
+		b.Fatalf("PutArtifactType failed: %v", err)
+	}
+	artifacts := make([]*mdpb.Artifact, n)
+	for i := range artifacts {
+		artifacts[i] = &mdpb.Artifact{TypeId: proto.Int64(int64(typeID))}
+	}
+	ids, err := store.PutArtifacts(artifacts)
+	if err != nil {
+		b.Fatalf("PutArtifacts failed: %v", err)
+	}
+	return store, ids
+}
+
+const benchmarkCallsPerOp = 100
+
+// BenchmarkGetArtifactsByIDOneByOne and BenchmarkGetArtifactsByIDInBatch issue
+// the same small lookups, one per call and all in one ExecuteBatch. The
+// difference is the per-call cost of crossing cgo and running a transaction.
+// Run them with `go test -bench=GetArtifactsByID`.
+func BenchmarkGetArtifactsByIDOneByOne(b *testing.B) {
+	store, ids := setUpBenchmarkArtifacts(b, benchmarkCallsPerOp)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for _, id := range ids {
+			if _, err := store.GetArtifactsByID([]ArtifactID{id}); err != nil {
+				b.Fatalf("GetArtifactsByID failed: %v", err)
+			}
+		}
+	}
+}
+
+func BenchmarkGetArtifactsByIDInBatch(b *testing.B) {
+	store, ids := setUpBenchmarkArtifacts(b, benchmarkCallsPerOp)
+	calls := make([]*apipb.ExecuteBatchRequest_Call, len(ids))
+	for i, id := range ids {
+		calls[i] = &apipb.ExecuteBatchRequest_Call{Request: &apipb.ExecuteBatchRequest_Call_GetArtifactsById{
+			GetArtifactsById: &apipb.GetArtifactsByIDRequest{ArtifactIds: []int64{int64(id)}},
+		}}
+	}
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		results, err := store.ExecuteBatch(calls)
+		if err != nil {
+			b.Fatalf("ExecuteBatch failed: %v", err)
+		}
+		if len(results) != len(calls) {
+			b.Fatalf("ExecuteBatch returned %v results, want %v", len(results), len(calls))
+		}
+	}
+}
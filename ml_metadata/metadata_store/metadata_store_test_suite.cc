@@ -2001,7 +2001,159 @@ TEST_P(MetadataStoreTestSuite, PutArtifactsGetArtifactsByExternalIds) {
   }
 }
 
-// Test creating an artifact and then updating one of its properties.
+// Test that nodes known at their stored last update time are reported as
+// unchanged instead of being returned again.
+TEST_P(MetadataStoreTestSuite, GetNodesByIDWithKnownLastUpdateTimes) {
+  PutArtifactTypeRequest put_artifact_type_request;
+  put_artifact_type_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_artifact_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifactType(put_artifact_type_request,
+                                             &put_artifact_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  for (int i = 0; i < 2; ++i) {
+    Artifact* artifact = put_artifacts_request.add_artifacts();
+    artifact->set_type_id(put_artifact_type_response.type_id());
+    artifact->set_uri(absl::StrCat("uri_", i));
+  }
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  GetArtifactsByIDRequest get_artifacts_request;
+  get_artifacts_request.mutable_artifact_ids()->CopyFrom(
+      put_artifacts_response.artifact_ids());
+  GetArtifactsByIDResponse get_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_artifacts_request,
+                                              &get_artifacts_response));
+  ASSERT_THAT(get_artifacts_response.artifacts(), SizeIs(2));
+  const Artifact& unchanged_artifact = get_artifacts_response.artifacts(0);
+  const Artifact& changed_artifact = get_artifacts_response.artifacts(1);
+
+  // The first artifact is known at its stored time, and the second one at an
+  // earlier time, e.g., before its last update.
+  auto& known_times =
+      *get_artifacts_request.mutable_known_last_update_time_since_epoch();
+  known_times[unchanged_artifact.id()] =
+      unchanged_artifact.last_update_time_since_epoch();
+  known_times[changed_artifact.id()] =
+      changed_artifact.last_update_time_since_epoch() - 1;
+  GetArtifactsByIDResponse conditional_get_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(
+                get_artifacts_request, &conditional_get_artifacts_response));
+  EXPECT_THAT(conditional_get_artifacts_response.artifacts(),
+              ElementsAre(EqualsProto(changed_artifact)));
+  EXPECT_THAT(conditional_get_artifacts_response.unchanged_artifact_ids(),
+              ElementsAre(unchanged_artifact.id()));
+
+  PutContextTypeRequest put_context_type_request;
+  put_context_type_request.mutable_context_type()->set_name("context_type");
+  PutContextTypeResponse put_context_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutContextType(put_context_type_request,
+                                            &put_context_type_response));
+  PutContextsRequest put_contexts_request;
+  Context* context = put_contexts_request.add_contexts();
+  context->set_type_id(put_context_type_response.type_id());
+  context->set_name("context");
+  PutContextsResponse put_contexts_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutContexts(
+                                  put_contexts_request, &put_contexts_response));
+  GetContextsByIDRequest get_contexts_request;
+  get_contexts_request.add_context_ids(put_contexts_response.context_ids(0));
+  GetContextsByIDResponse get_contexts_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextsByID(
+                                  get_contexts_request, &get_contexts_response));
+  ASSERT_THAT(get_contexts_response.contexts(), SizeIs(1));
+  (*get_contexts_request.mutable_known_last_update_time_since_epoch())
+      [put_contexts_response.context_ids(0)] =
+          get_contexts_response.contexts(0).last_update_time_since_epoch();
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextsByID(
+                                  get_contexts_request, &get_contexts_response));
+  EXPECT_THAT(get_contexts_response.contexts(), IsEmpty());
+  EXPECT_THAT(get_contexts_response.unchanged_context_ids(),
+              ElementsAre(put_contexts_response.context_ids(0)));
+
+  PutExecutionTypeRequest put_execution_type_request;
+  put_execution_type_request.mutable_execution_type()->set_name(
+      "execution_type");
+  PutExecutionTypeResponse put_execution_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutionType(put_execution_type_request,
+                                              &put_execution_type_response));
+  PutExecutionsRequest put_executions_request;
+  put_executions_request.add_executions()->set_type_id(
+      put_execution_type_response.type_id());
+  PutExecutionsResponse put_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(put_executions_request,
+                                           &put_executions_response));
+  GetExecutionsByIDRequest get_executions_request;
+  get_executions_request.add_execution_ids(
+      put_executions_response.execution_ids(0));
+  GetExecutionsByIDResponse get_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetExecutionsByID(get_executions_request,
+                                               &get_executions_response));
+  ASSERT_THAT(get_executions_response.executions(), SizeIs(1));
+  (*get_executions_request.mutable_known_last_update_time_since_epoch())
+      [put_executions_response.execution_ids(0)] =
+          get_executions_response.executions(0).last_update_time_since_epoch();
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetExecutionsByID(get_executions_request,
+                                               &get_executions_response));
+  EXPECT_THAT(get_executions_response.executions(), IsEmpty());
+  EXPECT_THAT(get_executions_response.unchanged_execution_ids(),
+              ElementsAre(put_executions_response.execution_ids(0)));
+}
+
+// Test that back-to-back updates, e.g., within the same millisecond, still
+// move the last update time forward, so it can be used as an etag.
+TEST_P(MetadataStoreTestSuite, PutArtifactsUpdateAdvancesLastUpdateTime) {
+  PutArtifactTypeRequest put_artifact_type_request;
+  put_artifact_type_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_artifact_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifactType(put_artifact_type_request,
+                                             &put_artifact_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  Artifact* artifact = put_artifacts_request.add_artifacts();
+  artifact->set_type_id(put_artifact_type_response.type_id());
+  artifact->set_uri("uri_0");
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  artifact->set_id(put_artifacts_response.artifact_ids(0));
+
+  GetArtifactsByIDRequest get_artifacts_request;
+  get_artifacts_request.add_artifact_ids(artifact->id());
+  GetArtifactsByIDResponse get_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_artifacts_request,
+                                              &get_artifacts_response));
+  ASSERT_THAT(get_artifacts_response.artifacts(), SizeIs(1));
+  int64_t last_update_time =
+      get_artifacts_response.artifacts(0).last_update_time_since_epoch();
+  for (int i = 1; i <= 5; ++i) {
+    artifact->set_uri(absl::StrCat("uri_", i));
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->PutArtifacts(put_artifacts_request,
+                                            &put_artifacts_response));
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetArtifactsByID(get_artifacts_request,
+                                                &get_artifacts_response));
+    ASSERT_THAT(get_artifacts_response.artifacts(), SizeIs(1));
+    EXPECT_GT(
+        get_artifacts_response.artifacts(0).last_update_time_since_epoch(),
+        last_update_time);
+    last_update_time =
+        get_artifacts_response.artifacts(0).last_update_time_since_epoch();
+  }
+}
+
 TEST_P(MetadataStoreTestSuite, PutArtifactsUpdateGetArtifactsByID) {
   const PutArtifactTypeRequest put_artifact_type_request =
       ParseTextProtoOrDie<PutArtifactTypeRequest>(
@@ -2509,6 +2661,813 @@ TEST_P(MetadataStoreTestSuite, PutArtifactsWhenLatestUpdatedTimeChanged) {
   EXPECT_THAT(update_artifact_response.artifact_ids(), SizeIs(0));
 }
 
+TEST_P(MetadataStoreTestSuite, PutArtifactsInChunks) {
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  for (int i = 0; i < 5; ++i) {
+    Artifact* artifact = put_artifacts_request.add_artifacts();
+    artifact->set_type_id(put_type_response.type_id());
+    artifact->set_uri(absl::StrCat("uri_", i));
+  }
+  // The artifact at index 3 has an unknown type, so its chunk fails.
+  put_artifacts_request.mutable_artifacts(3)->set_type_id(
+      put_type_response.type_id() + 100);
+  put_artifacts_request.mutable_chunked_commit_options()
+      ->set_max_nodes_per_chunk(2);
+  // The failure of the second chunk is reported in the response, along with
+  // the ids of the first chunk.
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  EXPECT_THAT(put_artifacts_response.artifact_ids(), SizeIs(2));
+  const ChunkedCommitResult& failed_result =
+      put_artifacts_response.chunked_commit_result();
+  EXPECT_EQ(failed_result.num_committed_nodes(), 2);
+  ASSERT_THAT(failed_result.committed_chunks(), SizeIs(1));
+  ASSERT_TRUE(failed_result.has_failed_chunk());
+  EXPECT_EQ(failed_result.failed_chunk().begin_index(), 2);
+  EXPECT_EQ(failed_result.failed_chunk().end_index(), 4);
+  EXPECT_NE(failed_result.failed_chunk_error_code(),
+            static_cast<int>(absl::StatusCode::kOk));
+  EXPECT_FALSE(failed_result.failed_chunk_error_message().empty());
+  GetArtifactsResponse get_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifacts({}, &get_artifacts_response));
+  EXPECT_THAT(get_artifacts_response.artifacts(), SizeIs(2));
+
+  // Resumes from the failed chunk after fixing the artifact.
+  put_artifacts_request.mutable_artifacts(3)->set_type_id(
+      put_type_response.type_id());
+  put_artifacts_request.mutable_chunked_commit_options()
+      ->set_resume_from_index(failed_result.num_committed_nodes());
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  EXPECT_THAT(put_artifacts_response.artifact_ids(), SizeIs(3));
+  const ChunkedCommitResult& result =
+      put_artifacts_response.chunked_commit_result();
+  EXPECT_EQ(result.num_committed_nodes(), 5);
+  ASSERT_THAT(result.committed_chunks(), SizeIs(2));
+  EXPECT_EQ(result.committed_chunks(0).begin_index(), 2);
+  EXPECT_EQ(result.committed_chunks(0).end_index(), 4);
+  EXPECT_EQ(result.committed_chunks(1).begin_index(), 4);
+  EXPECT_EQ(result.committed_chunks(1).end_index(), 5);
+  EXPECT_FALSE(result.has_failed_chunk());
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifacts({}, &get_artifacts_response));
+  EXPECT_THAT(get_artifacts_response.artifacts(), SizeIs(5));
+}
+
+TEST_P(MetadataStoreTestSuite, PutArtifactsInChunksFailsIfFirstChunkFails) {
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  for (int i = 0; i < 3; ++i) {
+    Artifact* artifact = put_artifacts_request.add_artifacts();
+    artifact->set_type_id(put_type_response.type_id());
+    artifact->set_uri(absl::StrCat("uri_", i));
+  }
+  // Nothing is committed if the first chunk fails, so the call fails.
+  put_artifacts_request.mutable_artifacts(0)->set_type_id(
+      put_type_response.type_id() + 100);
+  put_artifacts_request.mutable_chunked_commit_options()
+      ->set_max_nodes_per_chunk(2);
+  PutArtifactsResponse put_artifacts_response;
+  EXPECT_FALSE(metadata_store_
+                   ->PutArtifacts(put_artifacts_request,
+                                  &put_artifacts_response)
+                   .ok());
+  GetArtifactsResponse get_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifacts({}, &get_artifacts_response));
+  EXPECT_THAT(get_artifacts_response.artifacts(), SizeIs(0));
+}
+
+TEST_P(MetadataStoreTestSuite, GetTypeCatalog) {
+  PutArtifactTypeRequest put_artifact_type_request;
+  put_artifact_type_request.mutable_artifact_type()->set_name("artifact_type");
+  PutArtifactTypeResponse put_artifact_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifactType(put_artifact_type_request,
+                                             &put_artifact_type_response));
+  GetTypeCatalogResponse get_catalog_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetTypeCatalog({}, &get_catalog_response));
+  const int64_t version = get_catalog_response.type_catalog_version();
+  EXPECT_GT(version, 0);
+  EXPECT_THAT(get_catalog_response.artifact_types(), SizeIs(1));
+
+  PutExecutionTypeRequest put_execution_type_request;
+  put_execution_type_request.mutable_execution_type()->set_name(
+      "execution_type");
+  PutExecutionTypeResponse put_execution_type_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutionType(put_execution_type_request,
+                                              &put_execution_type_response));
+  // Putting an unchanged type does not change the catalog.
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifactType(put_artifact_type_request,
+                                             &put_artifact_type_response));
+
+  GetTypeCatalogRequest get_catalog_request;
+  get_catalog_request.set_known_type_catalog_version(version);
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetTypeCatalog(
+                                  get_catalog_request, &get_catalog_response));
+  EXPECT_GT(get_catalog_response.type_catalog_version(), version);
+  EXPECT_THAT(get_catalog_response.artifact_types(), IsEmpty());
+  ASSERT_THAT(get_catalog_response.execution_types(), SizeIs(1));
+  EXPECT_EQ(get_catalog_response.execution_types(0).id(),
+            put_execution_type_response.type_id());
+  EXPECT_THAT(get_catalog_response.context_types(), IsEmpty());
+
+  // No types are returned when the known version is the current one.
+  get_catalog_request.set_known_type_catalog_version(
+      get_catalog_response.type_catalog_version());
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetTypeCatalog(
+                                  get_catalog_request, &get_catalog_response));
+  EXPECT_EQ(get_catalog_response.type_catalog_version(),
+            get_catalog_request.known_type_catalog_version());
+  EXPECT_THAT(get_catalog_response.execution_types(), IsEmpty());
+}
+
+TEST_P(MetadataStoreTestSuite, SetAndDeleteProperties) {
+  const PutArtifactTypeRequest put_type_request =
+      ParseTextProtoOrDie<PutArtifactTypeRequest>(R"pb(
+        artifact_type: {
+          name: 'test_type'
+          properties { key: 'p' value: INT }
+        }
+      )pb");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  put_artifacts_request.add_artifacts()->set_type_id(
+      put_type_response.type_id());
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  const int64_t artifact_id = put_artifacts_response.artifact_ids(0);
+
+  SetPropertiesRequest set_request;
+  set_request.add_artifact_ids(artifact_id);
+  (*set_request.mutable_properties())["p"].set_int_value(1);
+  (*set_request.mutable_custom_properties())["c"].set_string_value("foo");
+  SetPropertiesResponse set_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  // Setting again replaces the stored properties.
+  (*set_request.mutable_properties())["p"].set_int_value(2);
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  GetArtifactsByIDRequest get_request;
+  get_request.add_artifact_ids(artifact_id);
+  GetArtifactsByIDResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_EQ(get_response.artifacts(0).properties().at("p").int_value(), 2);
+  EXPECT_EQ(
+      get_response.artifacts(0).custom_properties().at("c").string_value(),
+      "foo");
+
+  // A property that is not defined in the type is rejected.
+  SetPropertiesRequest invalid_set_request = set_request;
+  (*invalid_set_request.mutable_properties())["unknown"].set_int_value(1);
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->SetProperties(invalid_set_request, &set_response)));
+  // A node that does not exist is rejected.
+  invalid_set_request = set_request;
+  invalid_set_request.add_context_ids(artifact_id + 100);
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->SetProperties(invalid_set_request, &set_response)));
+
+  DeletePropertiesRequest delete_request;
+  delete_request.add_artifact_ids(artifact_id);
+  delete_request.add_custom_property_names("c");
+  DeletePropertiesResponse delete_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->DeleteProperties(
+                                  delete_request, &delete_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_EQ(get_response.artifacts(0).properties().at("p").int_value(), 2);
+  EXPECT_THAT(get_response.artifacts(0).custom_properties(), IsEmpty());
+}
+
+TEST_P(MetadataStoreTestSuite, SetAndDeletePropertiesOfManyNodes) {
+  // The nodes have two types which both define the property.
+  std::vector<int64_t> type_ids;
+  for (const char* type_name : {"type_a", "type_b"}) {
+    PutArtifactTypeRequest put_type_request;
+    put_type_request.mutable_artifact_type()->set_name(type_name);
+    (*put_type_request.mutable_artifact_type()->mutable_properties())["p"] =
+        INT;
+    PutArtifactTypeResponse put_type_response;
+    ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                    put_type_request, &put_type_response));
+    type_ids.push_back(put_type_response.type_id());
+  }
+  PutArtifactsRequest put_artifacts_request;
+  for (int i = 0; i < 3; ++i) {
+    Artifact* artifact = put_artifacts_request.add_artifacts();
+    artifact->set_type_id(type_ids[i % 2]);
+    (*artifact->mutable_custom_properties())["kept"].set_int_value(i);
+  }
+  (*put_artifacts_request.mutable_artifacts(0)->mutable_properties())["p"]
+      .set_int_value(1);
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+
+  SetPropertiesRequest set_request;
+  set_request.mutable_artifact_ids()->CopyFrom(
+      put_artifacts_response.artifact_ids());
+  (*set_request.mutable_properties())["p"].set_int_value(2);
+  (*set_request.mutable_custom_properties())["c"].set_string_value("foo");
+  SetPropertiesResponse set_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  GetArtifactsByIDRequest get_request;
+  get_request.mutable_artifact_ids()->CopyFrom(
+      put_artifacts_response.artifact_ids());
+  GetArtifactsByIDResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(3));
+  for (const Artifact& artifact : get_response.artifacts()) {
+    EXPECT_EQ(artifact.properties().at("p").int_value(), 2);
+    EXPECT_EQ(artifact.custom_properties().at("c").string_value(), "foo");
+    EXPECT_THAT(artifact.custom_properties(), SizeIs(2));
+  }
+
+  // Deleting from some of the nodes keeps the properties of the others.
+  DeletePropertiesRequest delete_request;
+  delete_request.add_artifact_ids(put_artifacts_response.artifact_ids(0));
+  delete_request.add_artifact_ids(put_artifacts_response.artifact_ids(1));
+  delete_request.add_property_names("p");
+  delete_request.add_custom_property_names("c");
+  delete_request.add_custom_property_names("unknown");
+  DeletePropertiesResponse delete_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->DeleteProperties(
+                                  delete_request, &delete_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(3));
+  for (const Artifact& artifact : get_response.artifacts()) {
+    EXPECT_TRUE(artifact.custom_properties().contains("kept"));
+    if (artifact.id() == put_artifacts_response.artifact_ids(2)) {
+      EXPECT_EQ(artifact.properties().at("p").int_value(), 2);
+      EXPECT_TRUE(artifact.custom_properties().contains("c"));
+    } else {
+      EXPECT_THAT(artifact.properties(), IsEmpty());
+      EXPECT_FALSE(artifact.custom_properties().contains("c"));
+    }
+  }
+}
+
+TEST_P(MetadataStoreTestSuite, ClaimExecutions) {
+  PutExecutionTypeRequest put_type_request;
+  put_type_request.mutable_execution_type()->set_name("task");
+  PutExecutionTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutExecutionType(
+                                  put_type_request, &put_type_response));
+  PutExecutionsRequest put_executions_request;
+  for (const Execution::State state :
+       {Execution::NEW, Execution::NEW, Execution::COMPLETE, Execution::NEW}) {
+    Execution* execution = put_executions_request.add_executions();
+    execution->set_type_id(put_type_response.type_id());
+    execution->set_last_known_state(state);
+  }
+  PutExecutionsResponse put_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(put_executions_request,
+                                           &put_executions_response));
+  const auto& ids = put_executions_response.execution_ids();
+
+  ClaimExecutionsRequest claim_request;
+  claim_request.set_type_name("task");
+  claim_request.set_max_num_executions(2);
+  (*claim_request.mutable_lease_properties())["worker"].set_string_value("w1");
+  ClaimExecutionsResponse claim_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->ClaimExecutions(
+                                  claim_request, &claim_response));
+  ASSERT_THAT(claim_response.executions(), SizeIs(2));
+  EXPECT_EQ(claim_response.executions(0).id(), ids[0]);
+  EXPECT_EQ(claim_response.executions(1).id(), ids[1]);
+  for (const Execution& execution : claim_response.executions()) {
+    EXPECT_EQ(execution.last_known_state(), Execution::RUNNING);
+    EXPECT_EQ(execution.custom_properties().at("worker").string_value(),
+              "w1");
+  }
+
+  // The next claim skips the claimed and the COMPLETE executions.
+  (*claim_request.mutable_lease_properties())["worker"].set_string_value("w2");
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->ClaimExecutions(
+                                  claim_request, &claim_response));
+  ASSERT_THAT(claim_response.executions(), SizeIs(1));
+  EXPECT_EQ(claim_response.executions(0).id(), ids[3]);
+  EXPECT_EQ(
+      claim_response.executions(0).custom_properties().at("worker")
+          .string_value(),
+      "w2");
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->ClaimExecutions(
+                                  claim_request, &claim_response));
+  EXPECT_THAT(claim_response.executions(), IsEmpty());
+
+  claim_request.set_max_num_executions(0);
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->ClaimExecutions(claim_request, &claim_response)));
+  claim_request.set_max_num_executions(1);
+  claim_request.set_type_name("unknown_type");
+  EXPECT_TRUE(absl::IsNotFound(
+      metadata_store_->ClaimExecutions(claim_request, &claim_response)));
+}
+
+TEST_P(MetadataStoreTestSuite, GetWriteEpochs) {
+  GetWriteEpochsResponse before;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetWriteEpochs({}, &before));
+
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  put_artifacts_request.add_artifacts()->set_type_id(
+      put_type_response.type_id());
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+
+  // The epochs do not move unless database write epochs are enabled.
+  GetWriteEpochsResponse after_disabled_put;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetWriteEpochs({}, &after_disabled_put));
+  EXPECT_THAT(after_disabled_put, EqualsProto(before));
+
+  metadata_store_->set_enable_database_write_epochs(true);
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+
+  // Only the epoch of the written node kind increases, and type changes do
+  // not count as writes.
+  GetWriteEpochsResponse after_put;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetWriteEpochs({}, &after_put));
+  EXPECT_EQ(after_put.artifact_write_epoch(),
+            before.artifact_write_epoch() + 1);
+  EXPECT_EQ(after_put.execution_write_epoch(),
+            before.execution_write_epoch());
+  EXPECT_EQ(after_put.context_write_epoch(), before.context_write_epoch());
+
+  // Failed writes are rolled back together with their epochs.
+  put_artifacts_request.mutable_artifacts(0)->set_type_id(
+      put_type_response.type_id() + 1);
+  EXPECT_FALSE(metadata_store_
+                   ->PutArtifacts(put_artifacts_request,
+                                  &put_artifacts_response)
+                   .ok());
+  GetWriteEpochsResponse after_failure;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetWriteEpochs({}, &after_failure));
+  EXPECT_THAT(after_failure, EqualsProto(after_put));
+}
+
+TEST_P(MetadataStoreTestSuite, GetContextSummaries) {
+  metadata_store_->set_enable_context_summaries(true);
+  PutTypesRequest put_types_request = ParseTextProtoOrDie<PutTypesRequest>(R"(
+    artifact_types: { name: 'artifact_type' }
+    execution_types: { name: 'execution_type' }
+    context_types: { name: 'context_type' }
+  )");
+  PutTypesResponse put_types_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutTypes(put_types_request, &put_types_response));
+  const int64_t artifact_type_id = put_types_response.artifact_type_ids(0);
+  const int64_t execution_type_id = put_types_response.execution_type_ids(0);
+
+  // Puts two executions with an output artifact each in the same context.
+  int64_t context_id = 0;
+  std::vector<int64_t> execution_ids;
+  for (const Execution::State state : {Execution::NEW, Execution::RUNNING}) {
+    PutExecutionRequest put_execution_request;
+    put_execution_request.mutable_execution()->set_type_id(execution_type_id);
+    put_execution_request.mutable_execution()->set_last_known_state(state);
+    PutExecutionRequest::ArtifactAndEvent* artifact_and_event =
+        put_execution_request.add_artifact_event_pairs();
+    artifact_and_event->mutable_artifact()->set_type_id(artifact_type_id);
+    artifact_and_event->mutable_artifact()->set_state(Artifact::LIVE);
+    artifact_and_event->mutable_event()->set_type(Event::OUTPUT);
+    Context* context = put_execution_request.add_contexts();
+    context->set_type_id(put_types_response.context_type_ids(0));
+    context->set_name("context");
+    if (context_id != 0) {
+      context->set_id(context_id);
+    }
+    PutExecutionResponse put_execution_response;
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->PutExecution(put_execution_request,
+                                            &put_execution_response));
+    context_id = put_execution_response.context_ids(0);
+    execution_ids.push_back(put_execution_response.execution_id());
+  }
+
+  ContextSummary want_summary;
+  want_summary.set_context_id(context_id);
+  ContextSummary::ExecutionCount* new_executions =
+      want_summary.add_execution_counts();
+  new_executions->set_type_id(execution_type_id);
+  new_executions->set_last_known_state(Execution::NEW);
+  new_executions->set_num_executions(1);
+  ContextSummary::ExecutionCount* running_executions =
+      want_summary.add_execution_counts();
+  running_executions->set_type_id(execution_type_id);
+  running_executions->set_last_known_state(Execution::RUNNING);
+  running_executions->set_num_executions(1);
+  ContextSummary::ArtifactCount* live_artifacts =
+      want_summary.add_artifact_counts();
+  live_artifacts->set_type_id(artifact_type_id);
+  live_artifacts->set_state(Artifact::LIVE);
+  live_artifacts->set_num_artifacts(2);
+  ContextSummary unknown_context_summary;
+  unknown_context_summary.set_context_id(context_id + 1);
+
+  // Repeated ids get a single summary, and unknown ids get empty ones.
+  GetContextSummariesRequest get_request;
+  get_request.add_context_ids(context_id);
+  get_request.add_context_ids(context_id + 1);
+  get_request.add_context_ids(context_id);
+  GetContextSummariesResponse get_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextSummaries(
+                                  get_request, &get_response));
+  EXPECT_THAT(get_response.context_summaries(),
+              ElementsAre(EqualsProto(want_summary),
+                          EqualsProto(unknown_context_summary)));
+
+  // A state change moves the execution to its new state.
+  PutExecutionsRequest put_executions_request;
+  Execution* execution = put_executions_request.add_executions();
+  execution->set_id(execution_ids[0]);
+  execution->set_type_id(execution_type_id);
+  execution->set_last_known_state(Execution::COMPLETE);
+  PutExecutionsResponse put_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(put_executions_request,
+                                           &put_executions_response));
+  new_executions->set_last_known_state(Execution::COMPLETE);
+  std::swap(*want_summary.mutable_execution_counts(0),
+            *want_summary.mutable_execution_counts(1));
+  get_request.clear_context_ids();
+  get_request.add_context_ids(context_id);
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextSummaries(
+                                  get_request, &get_response));
+  EXPECT_THAT(get_response.context_summaries(),
+              ElementsAre(EqualsProto(want_summary)));
+
+  // Rebuilding the summaries from the associations and attributions keeps
+  // the incrementally maintained counts.
+  RebuildContextSummariesResponse rebuild_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->RebuildContextSummaries({}, &rebuild_response));
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextSummaries(
+                                  get_request, &get_response));
+  EXPECT_THAT(get_response.context_summaries(),
+              ElementsAre(EqualsProto(want_summary)));
+}
+
+TEST_P(MetadataStoreTestSuite, ContextSummariesAreOnlyMaintainedIfEnabled) {
+  PutTypesRequest put_types_request = ParseTextProtoOrDie<PutTypesRequest>(R"(
+    execution_types: { name: 'execution_type' }
+    context_types: { name: 'context_type' }
+  )");
+  PutTypesResponse put_types_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutTypes(put_types_request, &put_types_response));
+  PutExecutionRequest put_execution_request;
+  put_execution_request.mutable_execution()->set_type_id(
+      put_types_response.execution_type_ids(0));
+  put_execution_request.mutable_execution()->set_last_known_state(
+      Execution::NEW);
+  Context* context = put_execution_request.add_contexts();
+  context->set_type_id(put_types_response.context_type_ids(0));
+  context->set_name("context");
+  PutExecutionResponse put_execution_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecution(put_execution_request,
+                                          &put_execution_response));
+
+  // The association is not counted while the summaries are disabled.
+  GetContextSummariesRequest get_request;
+  get_request.add_context_ids(put_execution_response.context_ids(0));
+  GetContextSummariesResponse get_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextSummaries(
+                                  get_request, &get_response));
+  ASSERT_EQ(get_response.context_summaries_size(), 1);
+  EXPECT_EQ(get_response.context_summaries(0).execution_counts_size(), 0);
+
+  // Rebuilding the summaries counts it.
+  RebuildContextSummariesResponse rebuild_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->RebuildContextSummaries({}, &rebuild_response));
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->GetContextSummaries(
+                                  get_request, &get_response));
+  ASSERT_EQ(get_response.context_summaries_size(), 1);
+  ASSERT_EQ(get_response.context_summaries(0).execution_counts_size(), 1);
+  EXPECT_EQ(
+      get_response.context_summaries(0).execution_counts(0).num_executions(),
+      1);
+}
+
+TEST_P(MetadataStoreTestSuite, ExecuteBatch) {
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+
+  ExecuteBatchRequest batch_request;
+  Artifact* artifact = batch_request.add_calls()
+                           ->mutable_put_artifacts()
+                           ->add_artifacts();
+  artifact->set_type_id(put_type_response.type_id());
+  artifact->set_uri("testuri://batch");
+  batch_request.add_calls()->mutable_get_artifact_type()->set_type_name(
+      "test_type");
+  ExecuteBatchResponse batch_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->ExecuteBatch(batch_request, &batch_response));
+  ASSERT_THAT(batch_response.results(), SizeIs(2));
+  ASSERT_THAT(batch_response.results(0).put_artifacts().artifact_ids(),
+              SizeIs(1));
+  EXPECT_EQ(batch_response.results(1).get_artifact_type().artifact_type().id(),
+            put_type_response.type_id());
+
+  // A failed call rolls back the calls before it.
+  ExecuteBatchRequest failing_request;
+  *failing_request.add_calls() = batch_request.calls(0);
+  failing_request.add_calls()->mutable_get_artifact_type()->set_type_name(
+      "unknown_type");
+  EXPECT_TRUE(absl::IsNotFound(
+      metadata_store_->ExecuteBatch(failing_request, &batch_response)));
+  GetArtifactsByURIRequest get_request;
+  get_request.add_uris("testuri://batch");
+  GetArtifactsByURIResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByURI(get_request, &get_response));
+  EXPECT_THAT(get_response.artifacts(), SizeIs(1));
+
+  ExecuteBatchRequest empty_call_request;
+  empty_call_request.add_calls();
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->ExecuteBatch(empty_call_request, &batch_response)));
+
+  ExecuteBatchRequest chunked_request;
+  *chunked_request.add_calls() = batch_request.calls(0);
+  chunked_request.mutable_calls(0)
+      ->mutable_put_artifacts()
+      ->mutable_chunked_commit_options()
+      ->set_max_nodes_per_chunk(1);
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->ExecuteBatch(chunked_request, &batch_response)));
+}
+
+// Test that property names that differ only in case are distinct properties.
+TEST_P(MetadataStoreTestSuite, PutArtifactsWithPropertyNamesDifferingInCase) {
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  Artifact* artifact = put_artifacts_request.add_artifacts();
+  artifact->set_type_id(put_type_response.type_id());
+  (*artifact->mutable_custom_properties())["name"].set_int_value(1);
+  (*artifact->mutable_custom_properties())["Name"].set_int_value(2);
+  (*artifact->mutable_custom_properties())["NAME"].set_int_value(3);
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+
+  GetArtifactsByIDRequest get_request;
+  get_request.add_artifact_ids(put_artifacts_response.artifact_ids(0));
+  GetArtifactsByIDResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_THAT(get_response.artifacts(0),
+              EqualsProto(*artifact,
+                          /*ignore_fields=*/{"id", "type",
+                                             "create_time_since_epoch",
+                                             "last_update_time_since_epoch"}));
+}
+
+// Test that a property and a custom property with the same name are set and
+// deleted independently.
+TEST_P(MetadataStoreTestSuite, SetAndDeletePropertiesWithSharedName) {
+  const PutArtifactTypeRequest put_type_request =
+      ParseTextProtoOrDie<PutArtifactTypeRequest>(R"pb(
+        artifact_type: {
+          name: 'test_type'
+          properties { key: 'x' value: INT }
+        }
+      )pb");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  Artifact* artifact = put_artifacts_request.add_artifacts();
+  artifact->set_type_id(put_type_response.type_id());
+  (*artifact->mutable_properties())["x"].set_int_value(1);
+  (*artifact->mutable_custom_properties())["x"].set_string_value("foo");
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  const int64_t artifact_id = put_artifacts_response.artifact_ids(0);
+  GetArtifactsByIDRequest get_request;
+  get_request.add_artifact_ids(artifact_id);
+  GetArtifactsByIDResponse get_response;
+
+  // Setting the custom property keeps the property.
+  SetPropertiesRequest set_request;
+  set_request.add_artifact_ids(artifact_id);
+  (*set_request.mutable_custom_properties())["x"].set_string_value("bar");
+  SetPropertiesResponse set_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_EQ(get_response.artifacts(0).properties().at("x").int_value(), 1);
+  EXPECT_EQ(
+      get_response.artifacts(0).custom_properties().at("x").string_value(),
+      "bar");
+
+  // Setting the property keeps the custom property.
+  set_request.clear_custom_properties();
+  (*set_request.mutable_properties())["x"].set_int_value(2);
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_EQ(get_response.artifacts(0).properties().at("x").int_value(), 2);
+  EXPECT_EQ(
+      get_response.artifacts(0).custom_properties().at("x").string_value(),
+      "bar");
+
+  // Deleting the custom property keeps the property.
+  DeletePropertiesRequest delete_request;
+  delete_request.add_artifact_ids(artifact_id);
+  delete_request.add_custom_property_names("x");
+  DeletePropertiesResponse delete_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->DeleteProperties(
+                                  delete_request, &delete_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_EQ(get_response.artifacts(0).properties().at("x").int_value(), 2);
+  EXPECT_THAT(get_response.artifacts(0).custom_properties(), IsEmpty());
+
+  // Deleting the property keeps a newly set custom property.
+  set_request.clear_properties();
+  (*set_request.mutable_custom_properties())["x"].set_string_value("baz");
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->SetProperties(set_request, &set_response));
+  delete_request.clear_custom_property_names();
+  delete_request.add_property_names("x");
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->DeleteProperties(
+                                  delete_request, &delete_response));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  EXPECT_THAT(get_response.artifacts(0).properties(), IsEmpty());
+  EXPECT_EQ(
+      get_response.artifacts(0).custom_properties().at("x").string_value(),
+      "baz");
+}
+
+TEST_P(MetadataStoreTestSuite, PutArtifactsWithUpdatePreconditions) {
+  PutArtifactTypeRequest put_type_request;
+  put_type_request.mutable_artifact_type()->set_name("test_type");
+  PutArtifactTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutArtifactType(
+                                  put_type_request, &put_type_response));
+  PutArtifactsRequest put_artifacts_request;
+  Artifact* artifact = put_artifacts_request.add_artifacts();
+  artifact->set_type_id(put_type_response.type_id());
+  artifact->set_state(Artifact::PENDING);
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+  const int64_t artifact_id = put_artifacts_response.artifact_ids(0);
+
+  // Marks the PENDING artifact LIVE.
+  PutArtifactsRequest update_request =
+      ParseTextProtoOrDie<PutArtifactsRequest>(R"pb(
+        artifacts { state: LIVE }
+        update_mask { paths: "state" }
+        update_preconditions { states: 1 }
+      )pb");
+  update_request.mutable_artifacts(0)->set_id(artifact_id);
+  PutArtifactsResponse update_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(update_request, &update_response));
+  EXPECT_THAT(update_response.artifact_ids(), ElementsAre(artifact_id));
+
+  GetArtifactsByIDRequest get_request;
+  get_request.add_artifact_ids(artifact_id);
+  GetArtifactsByIDResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.artifacts(), SizeIs(1));
+  const Artifact live_artifact = get_response.artifacts(0);
+  EXPECT_EQ(live_artifact.state(), Artifact::LIVE);
+
+  // The artifact is no longer PENDING, so the same update fails, and the
+  // stored artifact is unchanged.
+  update_request.mutable_artifacts(0)->set_state(Artifact::DELETED);
+  EXPECT_TRUE(absl::IsFailedPrecondition(
+      metadata_store_->PutArtifacts(update_request, &update_response)));
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetArtifactsByID(get_request, &get_response));
+  EXPECT_THAT(get_response.artifacts(0), EqualsProto(live_artifact));
+
+  // A stale last_update_time_since_epoch fails as well.
+  update_request.mutable_update_preconditions(0)->Clear();
+  update_request.mutable_update_preconditions(0)
+      ->set_last_update_time_since_epoch(
+          live_artifact.last_update_time_since_epoch() - 1);
+  EXPECT_TRUE(absl::IsFailedPrecondition(
+      metadata_store_->PutArtifacts(update_request, &update_response)));
+
+  // The preconditions must be index-aligned with the artifacts.
+  update_request.add_update_preconditions();
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      metadata_store_->PutArtifacts(update_request, &update_response)));
+}
+
+TEST_P(MetadataStoreTestSuite, PutExecutionsWithUpdatePreconditions) {
+  PutExecutionTypeRequest put_type_request;
+  put_type_request.mutable_execution_type()->set_name("test_type");
+  PutExecutionTypeResponse put_type_response;
+  ASSERT_EQ(absl::OkStatus(), metadata_store_->PutExecutionType(
+                                  put_type_request, &put_type_response));
+  PutExecutionsRequest put_executions_request;
+  Execution* execution = put_executions_request.add_executions();
+  execution->set_type_id(put_type_response.type_id());
+  execution->set_last_known_state(Execution::NEW);
+  PutExecutionsResponse put_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(put_executions_request,
+                                           &put_executions_response));
+  const int64_t execution_id = put_executions_response.execution_ids(0);
+  GetExecutionsByIDRequest get_request;
+  get_request.add_execution_ids(execution_id);
+  GetExecutionsByIDResponse get_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetExecutionsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.executions(), SizeIs(1));
+  const Execution new_execution = get_response.executions(0);
+
+  // Two schedulers read the NEW execution, and try to claim it.
+  PutExecutionsRequest claim_request;
+  Execution* running_execution = claim_request.add_executions();
+  running_execution->set_id(execution_id);
+  running_execution->set_last_known_state(Execution::RUNNING);
+  UpdatePrecondition* precondition = claim_request.add_update_preconditions();
+  precondition->set_last_update_time_since_epoch(
+      new_execution.last_update_time_since_epoch());
+  precondition->add_states(Execution::NEW);
+  PutExecutionsResponse claim_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(claim_request, &claim_response));
+  EXPECT_THAT(claim_response.execution_ids(), ElementsAre(execution_id));
+  EXPECT_TRUE(absl::IsFailedPrecondition(
+      metadata_store_->PutExecutions(claim_request, &claim_response)));
+
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->GetExecutionsByID(get_request, &get_response));
+  ASSERT_THAT(get_response.executions(), SizeIs(1));
+  EXPECT_EQ(get_response.executions(0).last_known_state(), Execution::RUNNING);
+  EXPECT_GT(get_response.executions(0).last_update_time_since_epoch(),
+            new_execution.last_update_time_since_epoch());
+}
+
 // Test creating an execution and then updating one of its properties.
 TEST_P(MetadataStoreTestSuite, PutExecutionsUpdateGetExecutionsByID) {
   const PutExecutionTypeRequest put_execution_type_request =
@@ -3653,6 +4612,122 @@ TEST_P(MetadataStoreTestSuite, GetArtifactByURI) {
   }
 }
 
+TEST_P(MetadataStoreTestSuite, GetNodesByTypeAndNames) {
+  const PutTypesRequest put_types_request =
+      ParseTextProtoOrDie<PutTypesRequest>(R"pb(
+        artifact_types: { name: 'artifact_type' }
+        execution_types: { name: 'execution_type' }
+        context_types: { name: 'context_type' }
+      )pb");
+  PutTypesResponse put_types_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutTypes(put_types_request, &put_types_response));
+
+  PutArtifactsRequest put_artifacts_request =
+      ParseTextProtoOrDie<PutArtifactsRequest>(R"pb(
+        artifacts: { name: 'a1' }
+        artifacts: { name: 'a2' }
+        artifacts: { name: 'a3' }
+      )pb");
+  for (Artifact& artifact : *put_artifacts_request.mutable_artifacts()) {
+    artifact.set_type_id(put_types_response.artifact_type_ids(0));
+  }
+  PutArtifactsResponse put_artifacts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutArtifacts(put_artifacts_request,
+                                          &put_artifacts_response));
+
+  PutExecutionsRequest put_executions_request =
+      ParseTextProtoOrDie<PutExecutionsRequest>(R"pb(
+        executions: { name: 'e1' }
+        executions: { name: 'e2' }
+      )pb");
+  for (Execution& execution : *put_executions_request.mutable_executions()) {
+    execution.set_type_id(put_types_response.execution_type_ids(0));
+  }
+  PutExecutionsResponse put_executions_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutExecutions(put_executions_request,
+                                           &put_executions_response));
+
+  PutContextsRequest put_contexts_request =
+      ParseTextProtoOrDie<PutContextsRequest>(R"pb(
+        contexts: { name: 'c1' }
+        contexts: { name: 'c2' }
+      )pb");
+  for (Context& context : *put_contexts_request.mutable_contexts()) {
+    context.set_type_id(put_types_response.context_type_ids(0));
+  }
+  PutContextsResponse put_contexts_response;
+  ASSERT_EQ(absl::OkStatus(),
+            metadata_store_->PutContexts(put_contexts_request,
+                                         &put_contexts_response));
+
+  {
+    // The nodes are returned in the order of the names, and the unknown
+    // names are skipped.
+    GetArtifactsByTypeAndNamesRequest request =
+        ParseTextProtoOrDie<GetArtifactsByTypeAndNamesRequest>(R"pb(
+          type_name: 'artifact_type'
+          artifact_names: [ 'a3', 'unknown', 'a1' ]
+        )pb");
+    GetArtifactsByTypeAndNamesResponse response;
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetArtifactsByTypeAndNames(request, &response));
+    ASSERT_THAT(response.artifacts(), SizeIs(2));
+    EXPECT_EQ(response.artifacts(0).name(), "a3");
+    EXPECT_EQ(response.artifacts(0).id(),
+              put_artifacts_response.artifact_ids(2));
+    EXPECT_EQ(response.artifacts(1).name(), "a1");
+    EXPECT_EQ(response.artifacts(1).type(), "artifact_type");
+  }
+
+  {
+    GetExecutionsByTypeAndNamesRequest request =
+        ParseTextProtoOrDie<GetExecutionsByTypeAndNamesRequest>(R"pb(
+          type_name: 'execution_type'
+          execution_names: [ 'e2', 'e1', 'e2' ]
+        )pb");
+    GetExecutionsByTypeAndNamesResponse response;
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetExecutionsByTypeAndNames(request, &response));
+    ASSERT_THAT(response.executions(), SizeIs(2));
+    EXPECT_EQ(response.executions(0).name(), "e2");
+    EXPECT_EQ(response.executions(1).name(), "e1");
+  }
+
+  {
+    GetContextsByTypeAndNamesRequest request =
+        ParseTextProtoOrDie<GetContextsByTypeAndNamesRequest>(R"pb(
+          type_name: 'context_type'
+          context_names: [ 'c1', 'c2' ]
+        )pb");
+    GetContextsByTypeAndNamesResponse response;
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetContextsByTypeAndNames(request, &response));
+    ASSERT_THAT(response.contexts(), SizeIs(2));
+    EXPECT_EQ(response.contexts(0).name(), "c1");
+    EXPECT_EQ(response.contexts(1).name(), "c2");
+  }
+
+  {
+    // Unknown type or names return an empty response.
+    GetContextsByTypeAndNamesRequest request =
+        ParseTextProtoOrDie<GetContextsByTypeAndNamesRequest>(R"pb(
+          type_name: 'unknown_type' context_names: 'c1'
+        )pb");
+    GetContextsByTypeAndNamesResponse response;
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetContextsByTypeAndNames(request, &response));
+    EXPECT_THAT(response.contexts(), SizeIs(0));
+    request.set_type_name("context_type");
+    request.set_context_names(0, "unknown");
+    ASSERT_EQ(absl::OkStatus(),
+              metadata_store_->GetContextsByTypeAndNames(request, &response));
+    EXPECT_THAT(response.contexts(), SizeIs(0));
+  }
+}
+
 TEST_P(MetadataStoreTestSuite, PutArtifactsGetArtifactsWithEmptyArtifact) {
   const PutArtifactTypeRequest put_artifact_type_request =
       ParseTextProtoOrDie<PutArtifactTypeRequest>(
@@ -161,14 +161,16 @@ Status MySqlMetadataSource::ConnectImpl() {
   }
 
   mysql_options(db_, MYSQL_DEFAULT_AUTH, "mysql_native_password");
-  // Connect to the MYSQL server.
+  // Connect to the MYSQL server. CLIENT_FOUND_ROWS makes mysql_affected_rows
+  // count the rows an UPDATE matched rather than the rows it changed, so a
+  // conditional update that writes the stored values still counts as applied.
   db_ = mysql_real_connect(
           db_, config_.host().empty() ? nullptr : config_.host().c_str(),
           config_.user().empty() ? nullptr : config_.user().c_str(),
           config_.password().empty() ? nullptr : config_.password().c_str(),
           /*db=*/nullptr, config_.port(),
           config_.socket().empty() ? nullptr : config_.socket().c_str(),
-          /*clientflag=*/0UL);
+          /*clientflag=*/CLIENT_FOUND_ROWS);
 
   if (!db_) {
     LOG(ERROR)
@@ -355,6 +357,10 @@ Status MySqlMetadataSource::ConvertMySqlRowSetToRecordSet(
   RecordSet record_set;
 
   if (result_set_ == nullptr) {
+    // The statement returns no rows, e.g., an UPDATE.
+    if (record_set_out != nullptr) {
+      record_set_out->set_num_affected_rows(mysql_affected_rows(db_));
+    }
     return absl::OkStatus();
   }
 
@@ -407,6 +413,20 @@ std::string MySqlMetadataSource::EscapeString(absl::string_view value) const {
   return result;
 }
 
+void MySqlMetadataSource::AppendEscapedString(absl::string_view value,
+                                              std::string* output) const {
+  CHECK(db_ != nullptr);
+  // Escapes into the tail of `output`, sized for the worst case, and shrinks
+  // it back to the escaped length.
+  const size_t offset = output->size();
+  output->resize(offset + value.length() * 2 + 1);
+  const unsigned long escaped_length = mysql_real_escape_string(  // NOLINT
+      db_, &(*output)[offset], value.data(), value.length());
+  CHECK(escaped_length != -1UL)
+      << "NO_BACKSLASH_ESCAPES SQL mode should not be enabled.";
+  output->resize(offset + escaped_length);
+}
+
 std::string MySqlMetadataSource::EncodeBytes(absl::string_view value) const {
   return SqliteEncodeBytes(value);
 }
@@ -45,6 +45,10 @@ class MySqlMetadataSource : public MetadataSource {
   // the metadata source is not connected.
   std::string EscapeString(absl::string_view value) const final;
 
+  // Escapes `value` as EscapeString does directly into `output`.
+  void AppendEscapedString(absl::string_view value,
+                           std::string* output) const final;
+
   // SQL sources use base64 encoding.
   std::string EncodeBytes(absl::string_view value) const final;
 
@@ -0,0 +1,214 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/planner_statistics_maintainer.h"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/metadata_store/mysql_metadata_source.h"
+#include "ml_metadata/metadata_store/postgresql_metadata_source.h"
+#include "ml_metadata/metadata_store/sqlite_metadata_source.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+#include "ml_metadata/util/return_utils.h"
+
+namespace ml_metadata {
+namespace {
+
+// Creates a source connected to the database of `config` in `source`, or
+// leaves it nullptr if the database cannot be analyzed by another connection.
+absl::Status ConnectSource(const ConnectionConfig& config,
+                           std::unique_ptr<MetadataSource>* source) {
+  switch (config.config_case()) {
+    case ConnectionConfig::kMysql:
+      *source = std::make_unique<MySqlMetadataSource>(config.mysql());
+      break;
+    case ConnectionConfig::kSqlite:
+      if (config.sqlite().filename_uri().empty() ||
+          config.sqlite().filename_uri() == ":memory:") {
+        return absl::OkStatus();
+      }
+      *source = std::make_unique<SqliteMetadataSource>(config.sqlite());
+      break;
+    case ConnectionConfig::kPostgresql:
+      *source = std::make_unique<PostgreSQLMetadataSource>(config.postgresql());
+      break;
+    default:
+      return absl::OkStatus();
+  }
+  return (*source)->Connect();
+}
+
+// Returns the statement that refreshes the planner statistics of `table`.
+std::string GetAnalyzeQuery(const ConnectionConfig& config,
+                            const std::string& table) {
+  if (config.config_case() == ConnectionConfig::kMysql) {
+    return absl::StrCat("ANALYZE TABLE `", table, "`;");
+  }
+  return absl::StrCat("ANALYZE ", table, ";");
+}
+
+// Analyzes `table` in a transaction of `source`.
+absl::Status AnalyzeTable(const ConnectionConfig& config,
+                          const std::string& table, MetadataSource& source) {
+  MLMD_RETURN_IF_ERROR(source.Begin());
+  absl::Status status =
+      source.ExecuteQuery(GetAnalyzeQuery(config, table), nullptr);
+  if (status.ok()) {
+    return source.Commit();
+  }
+  status.Update(source.Rollback());
+  return status;
+}
+
+}  // namespace
+
+PlannerStatisticsMaintainer::PlannerStatisticsMaintainer(
+    const ConnectionConfig& connection_config, const Options& options)
+    : connection_config_(connection_config),
+      options_(options),
+      creation_time_(absl::Now()) {}
+
+PlannerStatisticsMaintainer::~PlannerStatisticsMaintainer() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopped_ = true;
+    stop_requested_.SignalAll();
+  }
+  if (thread_.joinable()) thread_.join();
+}
+
+void PlannerStatisticsMaintainer::OnRowsChanged(
+    const absl::flat_hash_map<std::string, int64_t>& num_changed_rows) {
+  absl::MutexLock lock(&mutex_);
+  for (const auto& [table, num_rows] : num_changed_rows) {
+    auto [it, inserted] = tables_.try_emplace(table);
+    if (inserted) it->second.last_analyze_time = creation_time_;
+    it->second.num_changed_rows += num_rows;
+  }
+}
+
+void PlannerStatisticsMaintainer::Start() {
+  CHECK(!thread_.joinable()) << "The maintainer is already started.";
+  thread_ = std::thread([this]() { Run(); });
+}
+
+void PlannerStatisticsMaintainer::Run() {
+#ifdef __linux__
+  // Linux applies the nice value to the calling thread only.
+  if (setpriority(PRIO_PROCESS, syscall(SYS_gettid), /*prio=*/19) != 0) {
+    LOG(WARNING) << "Cannot lower the priority of the planner statistics "
+                    "maintenance thread.";
+  }
+#endif
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      // A spurious wakeup only makes the next check early.
+      if (!stopped_) {
+        stop_requested_.WaitWithTimeout(&mutex_, options_.check_interval);
+      }
+      if (stopped_) return;
+    }
+    const absl::Status status = AnalyzeDueTables();
+    if (!status.ok()) {
+      LOG(WARNING) << "Planner statistics maintenance failed: " << status;
+    }
+  }
+}
+
+absl::Status PlannerStatisticsMaintainer::AnalyzeDueTables() {
+  // The tables that are due, and their changed rows when they were picked.
+  std::vector<std::pair<std::string, int64_t>> due_tables;
+  {
+    const absl::Time now = absl::Now();
+    absl::MutexLock lock(&mutex_);
+    for (const auto& [name, table] : tables_) {
+      if (table.num_changed_rows >= options_.min_changed_rows ||
+          (table.num_changed_rows > 0 &&
+           now - table.last_analyze_time >= options_.max_analyze_interval)) {
+        due_tables.push_back({name, table.num_changed_rows});
+      }
+    }
+  }
+  if (due_tables.empty()) return absl::OkStatus();
+  std::sort(due_tables.begin(), due_tables.end());
+
+  std::unique_ptr<MetadataSource> source;
+  MLMD_RETURN_IF_ERROR(ConnectSource(connection_config_, &source));
+  if (source == nullptr) return absl::OkStatus();
+  absl::Status status;
+  for (const auto& [name, num_changed_rows] : due_tables) {
+    const absl::Status table_status =
+        AnalyzeTable(connection_config_, name, *source);
+    const absl::Time now = absl::Now();
+    absl::MutexLock lock(&mutex_);
+    Table& table = tables_[name];
+    table.last_analyze_status = table_status;
+    if (table_status.ok()) {
+      // Keeps the rows changed while the table was analyzed.
+      table.num_changed_rows -= num_changed_rows;
+      table.last_analyze_time = now;
+      table.analyzed = true;
+      table.num_analyses++;
+    } else {
+      status.Update(table_status);
+    }
+  }
+  return status;
+}
+
+void PlannerStatisticsMaintainer::Snapshot(
+    GetServerStatsResponse* response) const {
+  absl::MutexLock lock(&mutex_);
+  std::vector<const std::pair<const std::string, Table>*> tables;
+  tables.reserve(tables_.size());
+  for (const auto& entry : tables_) tables.push_back(&entry);
+  std::sort(tables.begin(), tables.end(),
+            [](const auto* a, const auto* b) { return a->first < b->first; });
+  for (const auto* entry : tables) {
+    const Table& table = entry->second;
+    GetServerStatsResponse::TableStatistics* statistics =
+        response->add_table_statistics();
+    statistics->set_table(entry->first);
+    statistics->set_num_changed_rows(table.num_changed_rows);
+    if (table.analyzed) {
+      statistics->set_last_analyze_time_since_epoch(
+          absl::ToUnixMillis(table.last_analyze_time));
+    }
+    statistics->set_num_analyses(table.num_analyses);
+    if (!table.last_analyze_status.ok()) {
+      statistics->set_last_analyze_error(
+          std::string(table.last_analyze_status.message()));
+    }
+  }
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,120 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_PLANNER_STATISTICS_MAINTAINER_H_
+#define ML_METADATA_METADATA_STORE_PLANNER_STATISTICS_MAINTAINER_H_
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+
+// Keeps the planner statistics of a database fresh after bulk changes, e.g.,
+// large imports or retention deletes, which otherwise leave the planner with
+// stale row estimates until someone runs ANALYZE manually. It is thread-safe.
+//
+// As a TableChangeObserver, it counts the rows that the committed transactions
+// of the process changed per table. A table is analyzed once
+// `min_changed_rows` of its rows changed, or once `max_analyze_interval`
+// passed since it was last analyzed with some of its rows changed. The tables
+// are analyzed one at a time by a background thread of the lowest scheduling
+// priority, on a connection of its own, with `ANALYZE TABLE` for MySQL and
+// `ANALYZE` for SQLite and PostgreSQL. SQLite's `PRAGMA optimize` is not used,
+// as it only considers the tables queried on the connection that runs it.
+//
+// Usage example:
+//
+//   PlannerStatisticsMaintainer maintainer(connection_config, {});
+//   MetadataSource::SetTableChangeObserver(&maintainer);
+//   maintainer.Start();
+class PlannerStatisticsMaintainer : public TableChangeObserver {
+ public:
+  struct Options {
+    // A table is analyzed once this many of its rows changed.
+    int64_t min_changed_rows = 10000;
+    // A table with fewer changed rows is analyzed once this long passed since
+    // it was last analyzed, or since the maintainer was created.
+    absl::Duration max_analyze_interval = absl::Hours(24);
+    // How often the background thread looks for tables to analyze.
+    absl::Duration check_interval = absl::Minutes(1);
+  };
+
+  // `connection_config` is the database of the observed sources. In-memory
+  // SQLite databases are never analyzed, as they cannot be shared with
+  // another connection.
+  PlannerStatisticsMaintainer(const ConnectionConfig& connection_config,
+                              const Options& options);
+
+  // Stops the background thread, if started.
+  ~PlannerStatisticsMaintainer() override;
+
+  // Disallows copy.
+  PlannerStatisticsMaintainer(const PlannerStatisticsMaintainer&) = delete;
+  PlannerStatisticsMaintainer& operator=(const PlannerStatisticsMaintainer&) =
+      delete;
+
+  void OnRowsChanged(
+      const absl::flat_hash_map<std::string, int64_t>& num_changed_rows)
+      override;
+
+  // Starts the background thread that calls AnalyzeDueTables every
+  // `check_interval`. Must be called at most once.
+  void Start();
+
+  // Analyzes the tables that are due, in the calling thread.
+  // Returns detailed INTERNAL error, if connecting to the database or
+  //   analyzing a table fails. The other due tables are still analyzed.
+  absl::Status AnalyzeDueTables();
+
+  // Fills the `table_statistics` of `response`.
+  void Snapshot(GetServerStatsResponse* response) const;
+
+ private:
+  struct Table {
+    int64_t num_changed_rows = 0;
+    // When the table was last analyzed, or when the maintainer was created.
+    absl::Time last_analyze_time;
+    bool analyzed = false;
+    int64_t num_analyses = 0;
+    absl::Status last_analyze_status;
+  };
+
+  // Runs AnalyzeDueTables every `check_interval` until stopped.
+  void Run();
+
+  const ConnectionConfig connection_config_;
+  const Options options_;
+  const absl::Time creation_time_;
+
+  mutable absl::Mutex mutex_;
+  // Signaled when the maintainer is stopped.
+  absl::CondVar stop_requested_;
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::flat_hash_map<std::string, Table> tables_ ABSL_GUARDED_BY(mutex_);
+  std::thread thread_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_PLANNER_STATISTICS_MAINTAINER_H_
@@ -0,0 +1,151 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/planner_statistics_maintainer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/metadata_store/sqlite_metadata_source.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+class PlannerStatisticsMaintainerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    connection_config_.mutable_sqlite()->set_filename_uri(absl::StrCat(
+        ::testing::TempDir(), "/",
+        ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+        ".db"));
+    source_ = std::make_unique<SqliteMetadataSource>(
+        connection_config_.sqlite());
+    ASSERT_EQ(absl::OkStatus(), source_->Connect());
+    RunTransaction({"DROP TABLE IF EXISTS t1;",
+                    "CREATE TABLE t1 (c1 INT PRIMARY KEY);"});
+  }
+
+  void TearDown() override {
+    MetadataSource::SetTableChangeObserver(nullptr);
+  }
+
+  void RunTransaction(const std::vector<std::string>& queries,
+                      RecordSet* results = nullptr) {
+    ASSERT_EQ(absl::OkStatus(), source_->Begin());
+    for (const std::string& query : queries) {
+      ASSERT_EQ(absl::OkStatus(), source_->ExecuteQuery(query, results));
+    }
+    ASSERT_EQ(absl::OkStatus(), source_->Commit());
+  }
+
+  // Returns whether sqlite3 has planner statistics of t1.
+  bool HasStatistics() {
+    RecordSet results;
+    RunTransaction({"SELECT COUNT(*) FROM sqlite_master "
+                    "WHERE name = 'sqlite_stat1';"},
+                   &results);
+    if (results.records(0).values(0) == "0") return false;
+    results.Clear();
+    RunTransaction({"SELECT COUNT(*) FROM sqlite_stat1 WHERE tbl = 't1';"},
+                   &results);
+    return results.records(0).values(0) != "0";
+  }
+
+  ConnectionConfig connection_config_;
+  std::unique_ptr<SqliteMetadataSource> source_;
+};
+
+TEST_F(PlannerStatisticsMaintainerTest, AnalyzesTablesPastThreshold) {
+  PlannerStatisticsMaintainer::Options options;
+  options.min_changed_rows = 3;
+  options.max_analyze_interval = absl::InfiniteDuration();
+  PlannerStatisticsMaintainer maintainer(connection_config_, options);
+  MetadataSource::SetTableChangeObserver(&maintainer);
+
+  RunTransaction({"INSERT INTO t1 VALUES (1), (2);"});
+  ASSERT_EQ(absl::OkStatus(), maintainer.AnalyzeDueTables());
+  EXPECT_FALSE(HasStatistics());
+
+  RunTransaction({"INSERT INTO t1 VALUES (3);"});
+  GetServerStatsResponse response;
+  maintainer.Snapshot(&response);
+  ASSERT_EQ(response.table_statistics_size(), 1);
+  EXPECT_EQ(response.table_statistics(0).table(), "t1");
+  EXPECT_EQ(response.table_statistics(0).num_changed_rows(), 3);
+  EXPECT_FALSE(
+      response.table_statistics(0).has_last_analyze_time_since_epoch());
+
+  ASSERT_EQ(absl::OkStatus(), maintainer.AnalyzeDueTables());
+  EXPECT_TRUE(HasStatistics());
+  response.Clear();
+  maintainer.Snapshot(&response);
+  ASSERT_EQ(response.table_statistics_size(), 1);
+  EXPECT_EQ(response.table_statistics(0).num_changed_rows(), 0);
+  EXPECT_EQ(response.table_statistics(0).num_analyses(), 1);
+  EXPECT_TRUE(
+      response.table_statistics(0).has_last_analyze_time_since_epoch());
+  EXPECT_FALSE(response.table_statistics(0).has_last_analyze_error());
+}
+
+TEST_F(PlannerStatisticsMaintainerTest, AnalyzesChangedTablesOnSchedule) {
+  PlannerStatisticsMaintainer::Options options;
+  options.max_analyze_interval = absl::ZeroDuration();
+  PlannerStatisticsMaintainer maintainer(connection_config_, options);
+  MetadataSource::SetTableChangeObserver(&maintainer);
+
+  // Unchanged tables are not analyzed.
+  ASSERT_EQ(absl::OkStatus(), maintainer.AnalyzeDueTables());
+  EXPECT_FALSE(HasStatistics());
+
+  RunTransaction({"INSERT INTO t1 VALUES (1);"});
+  ASSERT_EQ(absl::OkStatus(), maintainer.AnalyzeDueTables());
+  EXPECT_TRUE(HasStatistics());
+}
+
+TEST_F(PlannerStatisticsMaintainerTest, RunsInBackground) {
+  PlannerStatisticsMaintainer::Options options;
+  options.min_changed_rows = 1;
+  options.check_interval = absl::Milliseconds(10);
+  PlannerStatisticsMaintainer maintainer(connection_config_, options);
+  MetadataSource::SetTableChangeObserver(&maintainer);
+  maintainer.Start();
+
+  RunTransaction({"INSERT INTO t1 VALUES (1);"});
+  GetServerStatsResponse response;
+  for (int i = 0; i < 500; i++) {
+    response.Clear();
+    maintainer.Snapshot(&response);
+    if (response.table_statistics_size() == 1 &&
+        response.table_statistics(0).num_analyses() > 0) {
+      break;
+    }
+    absl::SleepFor(absl::Milliseconds(10));
+  }
+  ASSERT_EQ(response.table_statistics_size(), 1);
+  EXPECT_EQ(response.table_statistics(0).num_analyses(), 1);
+}
+
+}  // namespace
+}  // namespace ml_metadata
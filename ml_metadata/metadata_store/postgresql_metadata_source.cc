@@ -23,6 +23,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
@@ -43,6 +44,31 @@ constexpr absl::string_view kBeginTransaction = "BEGIN";
 constexpr absl::string_view kCommitTransaction = "COMMIT";
 constexpr absl::string_view kRollbackTransaction = "ROLLBACK";
 
+// The OIDs of the built-in types of the query parameters, from
+// catalog/pg_type.h.
+constexpr Oid kBoolOid = 16;
+constexpr Oid kByteaOid = 17;
+constexpr Oid kInt8Oid = 20;
+constexpr Oid kTextOid = 25;
+constexpr Oid kFloat8Oid = 701;
+
+// Returns the OID of the type of a query parameter.
+Oid GetParameterTypeOid(QueryParameter::Type type) {
+  switch (type) {
+    case QueryParameter::Type::kText:
+      return kTextOid;
+    case QueryParameter::Type::kInt64:
+      return kInt8Oid;
+    case QueryParameter::Type::kDouble:
+      return kFloat8Oid;
+    case QueryParameter::Type::kBool:
+      return kBoolOid;
+    case QueryParameter::Type::kBytes:
+      return kByteaOid;
+  }
+  LOG(FATAL) << "Unknown query parameter type: " << static_cast<int>(type);
+}
+
 // Checks if config is valid.
 absl::Status CheckConfig(const PostgreSQLDatabaseConfig& config) {
   std::vector<std::string> config_errors;
@@ -74,6 +100,18 @@ absl::Status BuildErrorStatus(const absl::StatusCode status_code,
       status_code,
       absl::StrCat("PostgreSQL metadata source error: ", error_message));
 }
+
+// Builds the error status of a failed `res`. A deadlock (SQLSTATE 40P01) is
+// reported as ABORTED for the client side to retry, and any other failure as
+// INTERNAL.
+absl::Status BuildResultErrorStatus(const PGresult* res) {
+  const char* sql_state = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+  const absl::StatusCode status_code =
+      sql_state != nullptr && absl::string_view(sql_state) == "40P01"
+          ? absl::StatusCode::kAborted
+          : absl::StatusCode::kInternal;
+  return BuildErrorStatus(status_code, PQresultErrorMessage(res));
+}
 }  // namespace
 
 PostgreSQLMetadataSource::PostgreSQLMetadataSource(
@@ -96,6 +134,13 @@ absl::Status PostgreSQLMetadataSource::ConvertResultToRecordSet(
     return absl::OkStatus();
   }
 
+  // The statement returns no rows, e.g., an UPDATE.
+  int64_t num_affected_rows;
+  if (PQresultStatus(res) == PGRES_COMMAND_OK &&
+      absl::SimpleAtoi(PQcmdTuples(res), &num_affected_rows)) {
+    record_set_ptr->set_num_affected_rows(num_affected_rows);
+  }
+
   int num_rows = PQntuples(res);
   int num_cols = PQnfields(res);
   bool is_column_name_initted =
@@ -121,14 +166,16 @@ absl::Status PostgreSQLMetadataSource::ConvertResultToRecordSet(
 absl::Status PostgreSQLMetadataSource::RunPostgresqlStatement(
     const std::string& query) {
   DiscardResultSet();
-  PGresult* res = PQexec(conn_, query.c_str());
+  return StoreResult(PQexec(conn_, query.c_str()));
+}
+
+absl::Status PostgreSQLMetadataSource::StoreResult(PGresult* res) {
   if (PQresultStatus(res) != PGRES_COMMAND_OK &&
       PQresultStatus(res) != PGRES_TUPLES_OK) {
-    const std::string error_str = std::string(PQresultErrorMessage(res));
-    LOG(ERROR) << "Execution failed: " << error_str;
+    const absl::Status status = BuildResultErrorStatus(res);
+    LOG(ERROR) << "Execution failed: " << status.message();
     PQclear(res);
-    MLMD_RETURN_IF_ERROR(
-        BuildErrorStatus(absl::StatusCode::kInternal, error_str));
+    return status;
   }
 
   pg_result_ = res;
@@ -148,6 +195,36 @@ absl::Status PostgreSQLMetadataSource::ExecuteQueryImpl(
   return absl::OkStatus();
 }
 
+absl::Status PostgreSQLMetadataSource::ExecuteParameterizedQueryImpl(
+    const std::string& query, absl::Span<const QueryParameter> parameters,
+    RecordSet* results) {
+  DiscardResultSet();
+  // The layout of QueryParameter::value is the binary format of the
+  // parameter types, so the values are passed without being copied.
+  const int num_parameters = parameters.size();
+  std::vector<Oid> types(num_parameters);
+  std::vector<const char*> values(num_parameters);
+  std::vector<int> lengths(num_parameters);
+  const std::vector<int> formats(num_parameters, /*binary=*/1);
+  for (int i = 0; i < num_parameters; i++) {
+    types[i] = GetParameterTypeOid(parameters[i].type);
+    // A null pointer would be sent as a NULL value.
+    values[i] = parameters[i].value.data() != nullptr
+                    ? parameters[i].value.data()
+                    : "";
+    lengths[i] = parameters[i].value.size();
+  }
+  MLMD_RETURN_IF_ERROR(StoreResult(PQexecParams(
+      conn_, query.c_str(), num_parameters, types.data(), values.data(),
+      lengths.data(), formats.data(), /*resultFormat=*/0)));
+
+  MLMD_RETURN_WITH_CONTEXT_IF_ERROR(
+      ConvertResultToRecordSet(pg_result_, results),
+      "ConvertResultToRecordSet for query", query);
+
+  return absl::OkStatus();
+}
+
 std::string buildConnectionConfig(const PostgreSQLDatabaseConfig& config,
                                   bool& use_default_db) {
   std::string connection_config;
@@ -52,6 +52,9 @@ class PostgreSQLMetadataSource : public MetadataSource {
 
   std::string GetDbName() const;
 
+  // Query parameters are sent with PQexecParams.
+  bool SupportsQueryParameters() const final { return true; }
+
  private:
   // Converts the PGresult in `pg_result_` to `record_set_out`.
   absl::Status ConvertResultToRecordSet(PGresult* res,
@@ -60,14 +63,30 @@ class PostgreSQLMetadataSource : public MetadataSource {
   // Runs the given query and stores the PGresult in pg_result_.
   // Any existing PGresult in `pg_result_` is cleaned up prior to issuing
   // the given query.
-  // Returns an INTERNAL error upon any errors from the PostgreSQL backend.
+  // Returns an ABORTED error if the PostgreSQL backend detected a deadlock.
+  // Returns an INTERNAL error upon any other errors from the backend.
   absl::Status RunPostgresqlStatement(const std::string& query);
 
+  // Stores `res` in `pg_result_` if the statement succeeded, and frees it
+  // otherwise.
+  // Returns an ABORTED error if the PostgreSQL backend detected a deadlock.
+  // Returns an INTERNAL error upon any other errors from the backend.
+  absl::Status StoreResult(PGresult* res);
+
   // Executes a SQL statement and returns the rows if any.
-  // Returns an INTERNAL error upon any errors from the PostgreSQL backend.
+  // Returns an ABORTED error if the PostgreSQL backend detected a deadlock.
+  // Returns an INTERNAL error upon any other errors from the backend.
   absl::Status ExecuteQueryImpl(const std::string& query,
                                 RecordSet* results) final;
 
+  // Executes a SQL statement with PQexecParams, which sends `parameters` in
+  // the binary format with their type OIDs, and returns the rows if any.
+  // Returns an ABORTED error if the PostgreSQL backend detected a deadlock.
+  // Returns an INTERNAL error upon any other errors from the backend.
+  absl::Status ExecuteParameterizedQueryImpl(
+      const std::string& query, absl::Span<const QueryParameter> parameters,
+      RecordSet* results) final;
+
   // Create PostgreSQL connection based on database config and whether to use
   // default db. PostgreSQL connection requires providing a dbname, however,
   // the MLMD db might not exist when connection happens. So we need to connect
@@ -98,7 +117,6 @@ class PostgreSQLMetadataSource : public MetadataSource {
   // Rollbacks the currently open transaction.
   absl::Status RollbackImpl() final;
 
-
   // Discards any existing PGresult in `pg_result_`.
   void DiscardResultSet();
 
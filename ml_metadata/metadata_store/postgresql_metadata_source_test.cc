@@ -15,9 +15,12 @@ limitations under the License.
 
 #include "ml_metadata/metadata_store/postgresql_metadata_source.h"
 
+#include <string>
+
 #include "gflags/gflags.h"
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "ml_metadata/metadata_store/metadata_source_test_suite.h"
 #include "ml_metadata/metadata_store/test_postgresql_metadata_source_initializer.h"
 
@@ -77,6 +80,29 @@ class PostgreSQLMetadataSourceContainer : public MetadataSourceContainer {
   PostgreSQLMetadataSource* metadata_source_;
 };
 
+// Test that a deadlock is reported as ABORTED, so that clients retry it.
+TEST(PostgreSQLMetadataSourceExtendedTest, TestDeadlockIsAborted) {
+  auto metadata_source_initializer =
+      GetTestPostgreSQLMetadataSourceInitializer();
+  PostgreSQLMetadataSource* metadata_source =
+      metadata_source_initializer->Init();
+  ASSERT_EQ(absl::OkStatus(), metadata_source->Connect());
+  // Raises the error that the backend reports on a detected deadlock.
+  const std::string deadlock_query =
+      "DO $$ BEGIN RAISE EXCEPTION 'deadlock' "
+      "USING ERRCODE = 'deadlock_detected'; END $$;";
+  ASSERT_EQ(absl::OkStatus(), metadata_source->Begin());
+  EXPECT_TRUE(absl::IsAborted(
+      metadata_source->ExecuteQuery(deadlock_query, nullptr)));
+  ASSERT_EQ(absl::OkStatus(), metadata_source->Rollback());
+  // Other errors remain INTERNAL.
+  ASSERT_EQ(absl::OkStatus(), metadata_source->Begin());
+  EXPECT_TRUE(absl::IsInternal(metadata_source->ExecuteQuery(
+      "SELECT * FROM table_does_not_exist", nullptr)));
+  ASSERT_EQ(absl::OkStatus(), metadata_source->Rollback());
+  metadata_source_initializer->Cleanup();
+}
+
 }  // namespace
 
 INSTANTIATE_TEST_SUITE_P(
@@ -14,12 +14,14 @@ limitations under the License.
 
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "google/protobuf/struct.pb.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/text_format.h"
 #include "google/protobuf/util/json_util.h"
+#include "absl/base/casts.h"
 #include "absl/status/status.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
@@ -34,17 +36,33 @@ limitations under the License.
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/query/filter_query_ast_resolver.h"
 #include "ml_metadata/query/filter_query_builder.h"
+#include "ml_metadata/query/native_filter_query_parser.h"
 #include "ml_metadata/util/return_utils.h"
 #include "ml_metadata/util/struct_utils.h"
 
 namespace ml_metadata {
+namespace {
+
+// Returns `value` as 8 bytes in network byte order.
+std::string BigEndianBytes(uint64_t value) {
+  std::string bytes(sizeof(value), '\0');
+  for (int i = sizeof(value) - 1; i >= 0; i--) {
+    bytes[i] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+  return bytes;
+}
+
+}  // namespace
 
 PostgreSQLQueryExecutor::PostgreSQLQueryExecutor(
     const MetadataSourceQueryConfig& query_config, MetadataSource* source,
     int64_t query_version)
     : QueryExecutor(query_version),
       query_config_(query_config),
-      metadata_source_(source) {}
+      compiled_queries_(CompileTemplateQueries(query_config_)),
+      metadata_source_(source),
+      property_names_(source) {}
 
 absl::Status PostgreSQLQueryExecutor::InsertAttributionDirect(
     int64_t context_id, int64_t artifact_id, int64_t* attribution_id) {
@@ -162,6 +180,110 @@ absl::Status PostgreSQLQueryExecutor::SelectParentTypesByTypeID(
   return ExecuteQuery(query_config_.select_parent_type_by_type_id(),
                       {Bind(type_ids)}, record_set);
 }
+
+absl::Status PostgreSQLQueryExecutor::UpdateTypeCatalogVersion(
+    int64_t type_id) {
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.increase_type_catalog_version()));
+  int64_t catalog_version = 0;
+  MLMD_RETURN_IF_ERROR(SelectTypeCatalogVersion(&catalog_version));
+  return ExecuteQuery(query_config_.upsert_type_catalog_version(),
+                      {Bind(type_id), Bind(catalog_version)});
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectTypeCatalogVersion(
+    int64_t* catalog_version) {
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.select_type_catalog_version(),
+                                    {}, &record_set));
+  if (record_set.records_size() != 1 ||
+      !absl::SimpleAtoi(record_set.records(0).values(0), catalog_version)) {
+    return absl::InternalError(absl::StrCat(
+        "Cannot read the type catalog version: ", record_set.DebugString()));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectTypesChangedAfterCatalogVersion(
+    int64_t catalog_version, RecordSet* record_set) {
+  return ExecuteQuery(query_config_.select_types_changed_after_catalog_version(),
+                      {Bind(catalog_version)}, record_set);
+}
+
+absl::Status PostgreSQLQueryExecutor::IncreaseWriteEpochs(
+    absl::Span<const TypeKind> type_kinds) {
+  if (type_kinds.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<int64_t> type_kind_values;
+  for (const TypeKind type_kind : type_kinds) {
+    type_kind_values.push_back(static_cast<int64_t>(type_kind));
+  }
+  return ExecuteQuery(query_config_.increase_write_epochs(),
+                      {Bind(type_kind_values)});
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectWriteEpochs(RecordSet* record_set) {
+  return ExecuteQuery(query_config_.select_write_epochs(), {}, record_set);
+}
+
+absl::Status PostgreSQLQueryExecutor::UpdateContextSummariesByExecutions(
+    absl::Span<const int64_t> execution_ids, const int64_t delta) {
+  if (execution_ids.empty()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(query_config_.update_context_summaries_by_executions(),
+                      {Bind(delta), Bind(execution_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::UpdateContextSummariesByArtifacts(
+    absl::Span<const int64_t> artifact_ids, const int64_t delta) {
+  if (artifact_ids.empty()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(query_config_.update_context_summaries_by_artifacts(),
+                      {Bind(delta), Bind(artifact_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::IncreaseContextSummaryByAssociation(
+    const int64_t context_id, const int64_t execution_id) {
+  return ExecuteQuery(query_config_.increase_context_summary_by_association(),
+                      {Bind(context_id), Bind(execution_id)});
+}
+
+absl::Status PostgreSQLQueryExecutor::IncreaseContextSummaryByAttribution(
+    const int64_t context_id, const int64_t artifact_id) {
+  return ExecuteQuery(query_config_.increase_context_summary_by_attribution(),
+                      {Bind(context_id), Bind(artifact_id)});
+}
+
+absl::Status PostgreSQLQueryExecutor::RefreshContextSummaries(
+    absl::Span<const int64_t> context_ids) {
+  if (context_ids.empty()) {
+    return absl::OkStatus();
+  }
+  MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.delete_context_summaries(),
+                                    {Bind(context_ids)}));
+  return ExecuteQuery(query_config_.insert_context_summaries(),
+                      {Bind(context_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::RebuildContextSummaries(
+    absl::Span<const int64_t> context_ids) {
+  if (!context_ids.empty()) {
+    return RefreshContextSummaries(context_ids);
+  }
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.delete_all_context_summaries()));
+  return ExecuteQuery(query_config_.insert_all_context_summaries());
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectContextSummaries(
+    absl::Span<const int64_t> context_ids, RecordSet* record_set) {
+  return ExecuteQuery(query_config_.select_context_summaries(),
+                      {Bind(context_ids)}, record_set);
+}
+
 absl::Status PostgreSQLQueryExecutor::InsertEventPath(
     int64_t event_id, const Event::Path::Step& step) {
   // Inserts a path into the EventPath table. It has 4 parameters
@@ -348,6 +470,9 @@ absl::Status PostgreSQLQueryExecutor::DowngradeMetadataSource(
                      ". The current library does not know how to downgrade it. "
                      "Please upgrade the library to downgrade the schema."));
   }
+  // The downgrade drops the PropertyName table, and an upgrade afterwards
+  // interns the names again with new ids.
+  property_names_.Clear();
   // perform downgrade
   const auto& migration_schemes = query_config_.migration_schemes();
   while (db_version > to_schema_version) {
@@ -374,21 +499,35 @@ absl::Status PostgreSQLQueryExecutor::DowngradeMetadataSource(
   return absl::OkStatus();
 }
 std::string PostgreSQLQueryExecutor::Bind(const char* value) {
-  return absl::StrCat("'", metadata_source_->EscapeString(value), "'");
+  return Bind(absl::string_view(value));
 }
 std::string PostgreSQLQueryExecutor::Bind(absl::string_view value) {
-  return absl::StrCat("'", metadata_source_->EscapeString(value), "'");
+  std::string result;
+  AppendString(value, &result);
+  return result;
 }
 std::string PostgreSQLQueryExecutor::Bind(int value) {
   return std::to_string(value);
 }
 std::string PostgreSQLQueryExecutor::Bind(int64_t value) {
-  return std::to_string(value);
+  if (!metadata_source_->SupportsQueryParameters()) {
+    return std::to_string(value);
+  }
+  return BindParameter(QueryParameter::Type::kInt64,
+                       BigEndianBytes(static_cast<uint64_t>(value)));
 }
 std::string PostgreSQLQueryExecutor::Bind(double value) {
-  return std::to_string(value);
+  if (!metadata_source_->SupportsQueryParameters()) {
+    return std::to_string(value);
+  }
+  return BindParameter(QueryParameter::Type::kDouble,
+                       BigEndianBytes(absl::bit_cast<uint64_t>(value)));
 }
 std::string PostgreSQLQueryExecutor::Bind(const google::protobuf::Any& value) {
+  if (metadata_source_->SupportsQueryParameters()) {
+    return BindParameter(QueryParameter::Type::kBytes,
+                         value.SerializeAsString());
+  }
   return absl::StrCat(
       "decode('",
       metadata_source_->EscapeString(
@@ -396,7 +535,11 @@ std::string PostgreSQLQueryExecutor::Bind(const google::protobuf::Any& value) {
       "', 'base64')");
 }
 std::string PostgreSQLQueryExecutor::Bind(bool value) {
-  return value ? "TRUE" : "FALSE";
+  if (!metadata_source_->SupportsQueryParameters()) {
+    return value ? "TRUE" : "FALSE";
+  }
+  return BindParameter(QueryParameter::Type::kBool,
+                       std::string(1, value ? '\x01' : '\x00'));
 }
 // Utility method to bind an Event::Type enum value to a SQL clause.
 // Event::Type is an enum (integer), EscapeString is not applicable.
@@ -415,26 +558,54 @@ std::string PostgreSQLQueryExecutor::Bind(Artifact::State value) {
 std::string PostgreSQLQueryExecutor::Bind(Execution::State value) {
   return std::to_string((int)value);
 }
+void PostgreSQLQueryExecutor::AppendString(absl::string_view value,
+                                           std::string* output) {
+  if (metadata_source_->SupportsQueryParameters()) {
+    output->append(
+        BindParameter(QueryParameter::Type::kText, std::string(value)));
+    return;
+  }
+  output->reserve(output->size() + value.size() + 2);
+  output->push_back('\'');
+  metadata_source_->AppendEscapedString(value, output);
+  output->push_back('\'');
+}
 std::string PostgreSQLQueryExecutor::Bind(absl::Span<const int64_t> value) {
   return absl::StrJoin(value, ", ");
 }
+
+void PostgreSQLQueryExecutor::BindPrecondition(
+    const UpdatePrecondition& precondition,
+    std::vector<std::string>* parameters) {
+  parameters->push_back(
+      precondition.has_last_update_time_since_epoch()
+          ? Bind(precondition.last_update_time_since_epoch())
+          : "NULL");
+  parameters->push_back(Bind(precondition.states_size()));
+  parameters->push_back(precondition.states().empty()
+                            ? "NULL"
+                            : absl::StrJoin(precondition.states(), ", "));
+}
 std::string PostgreSQLQueryExecutor::Bind(absl::Span<absl::string_view> value) {
-  std::vector<std::string> escape_string_value;
-  escape_string_value.reserve(value.size());
+  std::string result;
   for (const auto& v : value) {
-    escape_string_value.push_back(Bind(v));
+    if (!result.empty()) result.append(", ");
+    AppendString(v, &result);
   }
-  return absl::StrJoin(escape_string_value, ", ");
+  return result;
 }
 std::string PostgreSQLQueryExecutor::Bind(
     absl::Span<std::pair<absl::string_view, absl::string_view>> value) {
-  std::vector<std::string> escape_string_value;
-  escape_string_value.reserve(value.size());
+  std::string result;
   for (const auto& v : value) {
-    escape_string_value.push_back(
-        absl::StrCat("(", Bind(v.first), ",", Bind(v.second), ")"));
+    if (!result.empty()) result.append(", ");
+    result.push_back('(');
+    AppendString(v.first, &result);
+    result.push_back(',');
+    AppendString(v.second, &result);
+    result.push_back(')');
   }
-  return absl::StrJoin(escape_string_value, ", ");
+  return result;
 }
 std::string PostgreSQLQueryExecutor::BindValue(const Value& value) {
   switch (value.value_case()) {
@@ -496,18 +667,39 @@ std::string PostgreSQLQueryExecutor::Bind(const ArtifactStructType* message) {
   }
 }
 
+std::string PostgreSQLQueryExecutor::BindParameter(QueryParameter::Type type,
+                                                   std::string value) {
+  bound_parameters_.push_back({type, std::move(value)});
+  return absl::StrCat("$", bound_parameters_.size());
+}
+
+absl::Status PostgreSQLQueryExecutor::RunQuery(const std::string& query,
+                                               RecordSet* record_set) {
+  if (bound_parameters_.empty()) {
+    return metadata_source_->ExecuteQuery(query, record_set);
+  }
+  query_parameters_.clear();
+  for (const BoundParameter& parameter : bound_parameters_) {
+    query_parameters_.push_back({parameter.type, parameter.value});
+  }
+  const absl::Status status =
+      metadata_source_->ExecuteQuery(query, query_parameters_, record_set);
+  bound_parameters_.clear();
+  return status;
+}
 absl::Status PostgreSQLQueryExecutor::ExecuteQuery(const std::string& query) {
   RecordSet record_set;
-  return metadata_source_->ExecuteQuery(query, &record_set);
+  return RunQuery(query, &record_set);
 }
 absl::Status PostgreSQLQueryExecutor::ExecuteQuery(const std::string& query,
                                                    RecordSet* record_set) {
-  return metadata_source_->ExecuteQuery(query, record_set);
+  return RunQuery(query, record_set);
 }
 absl::Status PostgreSQLQueryExecutor::ExecuteQuery(
     const MetadataSourceQueryConfig::TemplateQuery& template_query,
     absl::Span<const std::string> parameters, RecordSet* record_set) {
   if (parameters.size() > 10) {
+    bound_parameters_.clear();
     return absl::InvalidArgumentError(
         "Template query has too many parameters (at most 10 is supported).");
   }
@@ -518,13 +710,16 @@ absl::Status PostgreSQLQueryExecutor::ExecuteQuery(
                << "parameters size (" << parameters.size()
                << "): " << template_query.DebugString();
   }
-  std::vector<std::pair<const std::string, const std::string>> replacements;
-  replacements.reserve(parameters.size());
-  for (int i = 0; i < parameters.size(); i++) {
-    replacements.push_back({absl::StrCat("$", i), parameters[i]});
+  const auto it = compiled_queries_.find(&template_query);
+  if (it != compiled_queries_.end()) {
+    it->second.ComposeInto(parameters, &query_buffer_);
+  } else {
+    // Templates built outside of `query_config_`, e.g., the ones for earlier
+    // schema versions, are split on use.
+    CompiledTemplateQuery(template_query)
+        .ComposeInto(parameters, &query_buffer_);
   }
-  return metadata_source_->ExecuteQuery(
-      absl::StrReplaceAll(template_query.query(), replacements), record_set);
+  return RunQuery(query_buffer_, record_set);
 }
 absl::Status PostgreSQLQueryExecutor::IsCompatible(int64_t db_version,
                                                    int64_t lib_version,
@@ -555,6 +750,16 @@ absl::Status PostgreSQLQueryExecutor::InitMetadataSource() {
       ExecuteQuery(query_config_.create_parent_context_table()));
   MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.create_association_table()));
   MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.create_attribution_table()));
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.create_type_catalog_table()));
+  MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.insert_type_catalog()));
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.create_property_name_table()));
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.create_write_epoch_table()));
+  MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.insert_write_epochs()));
+  MLMD_RETURN_IF_ERROR(
+      ExecuteQuery(query_config_.create_context_summary_table()));
   for (const MetadataSourceQueryConfig::TemplateQuery& index_query :
        query_config_.secondary_indices()) {
     const absl::Status status = ExecuteQuery(index_query);
@@ -609,6 +814,264 @@ absl::Status PostgreSQLQueryExecutor::CheckTableResult(
   }
   return absl::OkStatus();
 }
+absl::Status PostgreSQLQueryExecutor::InternPropertyName(
+    absl::string_view name, int64_t* name_id) {
+  std::optional<int64_t> existing_name_id = property_names_.Find(name);
+  if (!existing_name_id.has_value()) {
+    MLMD_RETURN_IF_ERROR(
+        ExecuteQuery(query_config_.insert_property_name(), {Bind(name)}));
+    MLMD_RETURN_IF_ERROR(SelectPropertyNameId(name, &existing_name_id));
+    if (!existing_name_id.has_value()) {
+      return absl::InternalError(
+          absl::StrCat("Cannot find the interned property name: ", name));
+    }
+  }
+  *name_id = *existing_name_id;
+  return absl::OkStatus();
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectPropertyNameId(
+    absl::string_view name, std::optional<int64_t>* name_id) {
+  *name_id = property_names_.Find(name);
+  if (name_id->has_value()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(ExecuteQuery(query_config_.select_property_name_id(),
+                                    {Bind(name)}, &record_set));
+  if (record_set.records_size() == 0) {
+    return absl::OkStatus();
+  }
+  int64_t id = 0;
+  if (!absl::SimpleAtoi(record_set.records(0).values(0), &id)) {
+    return absl::InternalError(
+        absl::StrCat("Cannot parse the id of the property name: ",
+                     record_set.DebugString()));
+  }
+  property_names_.Insert(name, id);
+  *name_id = id;
+  return absl::OkStatus();
+}
+
+absl::Status PostgreSQLQueryExecutor::SelectPropertyNameIds(
+    absl::Span<const std::string> names, std::vector<int64_t>* name_ids) {
+  name_ids->clear();
+  for (const std::string& name : names) {
+    std::optional<int64_t> name_id;
+    MLMD_RETURN_IF_ERROR(SelectPropertyNameId(name, &name_id));
+    if (name_id.has_value()) {
+      name_ids->push_back(*name_id);
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertArtifactProperty(
+    int64_t artifact_id, absl::string_view artifact_property_name,
+    bool is_custom_property, const Value& property_value) {
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(artifact_property_name, &name_id));
+  return ExecuteQuery(query_config_.insert_artifact_property(),
+                      {BindDataType(property_value), Bind(artifact_id),
+                       Bind(name_id), Bind(is_custom_property),
+                       BindValue(property_value)});
+}
+
+absl::Status PostgreSQLQueryExecutor::UpdateArtifactProperty(
+    int64_t artifact_id, absl::string_view property_name,
+    const Value& property_value) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(property_name, &name_id));
+  // No property has a name that has never been stored.
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(query_config_.update_artifact_property(),
+                      {BindDataType(property_value), BindValue(property_value),
+                       Bind(artifact_id), Bind(*name_id)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteArtifactProperty(
+    int64_t artifact_id, absl::string_view property_name,
+    bool is_custom_property) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(property_name, &name_id));
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_artifact_property(),
+      {Bind(artifact_id), Bind(*name_id), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertExecutionProperty(
+    int64_t execution_id, absl::string_view name, bool is_custom_property,
+    const Value& value) {
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(name, &name_id));
+  return ExecuteQuery(query_config_.insert_execution_property(),
+                      {BindDataType(value), Bind(execution_id), Bind(name_id),
+                       Bind(is_custom_property), BindValue(value)});
+}
+
+absl::Status PostgreSQLQueryExecutor::UpdateExecutionProperty(
+    int64_t execution_id, absl::string_view name, const Value& value) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(name, &name_id));
+  // No property has a name that has never been stored.
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(query_config_.update_execution_property(),
+                      {BindDataType(value), BindValue(value),
+                       Bind(execution_id), Bind(*name_id)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteExecutionProperty(
+    int64_t execution_id, absl::string_view name, bool is_custom_property) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(name, &name_id));
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_execution_property(),
+      {Bind(execution_id), Bind(*name_id), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertContextProperty(
+    int64_t context_id, absl::string_view name, bool custom_property,
+    const Value& value) {
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(name, &name_id));
+  return ExecuteQuery(query_config_.insert_context_property(),
+                      {BindDataType(value), Bind(context_id), Bind(name_id),
+                       Bind(custom_property), BindValue(value)});
+}
+
+absl::Status PostgreSQLQueryExecutor::UpdateContextProperty(
+    int64_t context_id, absl::string_view property_name,
+    const Value& property_value) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(property_name, &name_id));
+  // No property has a name that has never been stored.
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(query_config_.update_context_property(),
+                      {BindDataType(property_value), BindValue(property_value),
+                       Bind(context_id), Bind(*name_id)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteContextProperty(
+    const int64_t context_id, absl::string_view property_name,
+    bool is_custom_property) {
+  std::optional<int64_t> name_id;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameId(property_name, &name_id));
+  if (!name_id.has_value()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_context_property(),
+      {Bind(context_id), Bind(*name_id), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertArtifactsProperty(
+    absl::Span<const int64_t> artifact_ids, absl::string_view name,
+    bool is_custom_property, const Value& value) {
+  if (artifact_ids.empty()) {
+    return absl::OkStatus();
+  }
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(name, &name_id));
+  return ExecuteQuery(query_config_.insert_artifacts_property(),
+                      {BindDataType(value), Bind(name_id),
+                       Bind(is_custom_property), BindValue(value),
+                       Bind(artifact_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteArtifactsProperties(
+    absl::Span<const int64_t> artifact_ids, absl::Span<const std::string> names,
+    bool is_custom_property) {
+  if (artifact_ids.empty() || names.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<int64_t> name_ids;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameIds(names, &name_ids));
+  // No property has a name that has never been stored.
+  if (name_ids.empty()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_artifacts_properties(),
+      {Bind(artifact_ids), Bind(name_ids), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertExecutionsProperty(
+    absl::Span<const int64_t> execution_ids, absl::string_view name,
+    bool is_custom_property, const Value& value) {
+  if (execution_ids.empty()) {
+    return absl::OkStatus();
+  }
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(name, &name_id));
+  return ExecuteQuery(query_config_.insert_executions_property(),
+                      {BindDataType(value), Bind(name_id),
+                       Bind(is_custom_property), BindValue(value),
+                       Bind(execution_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteExecutionsProperties(
+    absl::Span<const int64_t> execution_ids,
+    absl::Span<const std::string> names, bool is_custom_property) {
+  if (execution_ids.empty() || names.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<int64_t> name_ids;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameIds(names, &name_ids));
+  // No property has a name that has never been stored.
+  if (name_ids.empty()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_executions_properties(),
+      {Bind(execution_ids), Bind(name_ids), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::InsertContextsProperty(
+    absl::Span<const int64_t> context_ids, absl::string_view name,
+    bool is_custom_property, const Value& value) {
+  if (context_ids.empty()) {
+    return absl::OkStatus();
+  }
+  int64_t name_id = 0;
+  MLMD_RETURN_IF_ERROR(InternPropertyName(name, &name_id));
+  return ExecuteQuery(query_config_.insert_contexts_property(),
+                      {BindDataType(value), Bind(name_id),
+                       Bind(is_custom_property), BindValue(value),
+                       Bind(context_ids)});
+}
+
+absl::Status PostgreSQLQueryExecutor::DeleteContextsProperties(
+    absl::Span<const int64_t> context_ids, absl::Span<const std::string> names,
+    bool is_custom_property) {
+  if (context_ids.empty() || names.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<int64_t> name_ids;
+  MLMD_RETURN_IF_ERROR(SelectPropertyNameIds(names, &name_ids));
+  // No property has a name that has never been stored.
+  if (name_ids.empty()) {
+    return absl::OkStatus();
+  }
+  return ExecuteQuery(
+      query_config_.delete_contexts_properties(),
+      {Bind(context_ids), Bind(name_ids), Bind(is_custom_property)});
+}
+
+absl::Status PostgreSQLQueryExecutor::CheckPropertyNameTable() {
+  return CheckTableResult(query_config_.check_property_name_table());
+}
 absl::Status PostgreSQLQueryExecutor::CheckTypeTable() {
   return CheckTableResult(query_config_.check_type_table());
 }
@@ -680,6 +1143,7 @@ absl::Status PostgreSQLQueryExecutor::InitMetadataSourceIfNotExists(
   checks.push_back({CheckTypeTable(), "type_table"});
   checks.push_back({CheckParentTypeTable(), "parent_type_table"});
   checks.push_back({CheckTypePropertyTable(), "type_property_table"});
+  checks.push_back({CheckPropertyNameTable(), "property_name_table"});
   checks.push_back({CheckArtifactTable(), "artifact_table"});
   checks.push_back({CheckArtifactPropertyTable(), "artifact_property_table"});
   checks.push_back({CheckExecutionTable(), "execution_table"});
@@ -871,7 +1335,7 @@ absl::Status PostgreSQLQueryExecutor::ListNodeIDsUsingOptions(
   std::string sql_query;
   int64_t query_version = query_schema_version().has_value()
                               ? query_schema_version().value()
-                              : kSchemaVersionTen;
+                              : query_config_.schema_version();
   std::optional<absl::string_view> node_table_alias;
   if (std::is_same<Node, Artifact>::value) {
     sql_query = "SELECT id FROM Artifact WHERE";
@@ -886,29 +1350,45 @@ absl::Status PostgreSQLQueryExecutor::ListNodeIDsUsingOptions(
 
   if (options.has_filter_query() && !options.filter_query().empty()) {
     node_table_alias = ml_metadata::FilterQueryBuilder<Node>::kBaseTableAlias;
-    ml_metadata::FilterQueryAstResolver<Node> ast_resolver(
+    std::string from_clause;
+    std::string where_clause;
+    // The common queries are parsed natively without the ZetaSQL analyzer.
+    // Only the queries outside of the supported subset fall back to ZetaSQL.
+    ml_metadata::NativeFilterQueryParser<Node> native_parser(
         options.filter_query());
-    const absl::Status ast_gen_status = ast_resolver.Resolve();
-    if (!ast_gen_status.ok()) {
-      return absl::InvalidArgumentError(
-          absl::StrCat("Invalid `filter_query`: ", ast_gen_status.message()));
+    const absl::Status native_parse_status = native_parser.Parse();
+    if (!native_parse_status.ok() &&
+        !absl::IsUnimplemented(native_parse_status)) {
+      return native_parse_status;
     }
-    // Generate SQL
-    ml_metadata::FilterQueryBuilder<Node> query_builder;
-    const absl::Status sql_gen_status =
-        ast_resolver.GetAst()->Accept(&query_builder);
-    if (!sql_gen_status.ok()) {
-      return absl::InvalidArgumentError(
-          absl::StrCat("Failed to construct valid SQL from `filter_query`: ",
-                       sql_gen_status.message()));
+    if (native_parse_status.ok()) {
+      from_clause = native_parser.GetFromClause(query_version);
+      where_clause = native_parser.GetWhereClause();
+    } else {
+      ml_metadata::FilterQueryAstResolver<Node> ast_resolver(
+          options.filter_query());
+      const absl::Status ast_gen_status = ast_resolver.Resolve();
+      if (!ast_gen_status.ok()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Invalid `filter_query`: ", ast_gen_status.message()));
+      }
+      // Generate SQL
+      ml_metadata::FilterQueryBuilder<Node> query_builder;
+      const absl::Status sql_gen_status =
+          ast_resolver.GetAst()->Accept(&query_builder);
+      if (!sql_gen_status.ok()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Failed to construct valid SQL from `filter_query`: ",
+                         sql_gen_status.message()));
+      }
+      // TODO(b/257334039): remove query_version-conditional logic
+      from_clause = query_builder.GetFromClause(query_version);
+      where_clause = query_builder.GetWhereClause();
     }
     sql_query = absl::Substitute(
         "SELECT distinct $0.id, $0.create_time_since_epoch FROM $1 WHERE $2 "
         "AND ",
-        *node_table_alias,
-        // TODO(b/257334039): remove query_version-conditional logic
-        query_builder.GetFromClause(query_version),
-        query_builder.GetWhereClause());
+        *node_table_alias, from_clause, where_clause);
   }
 
   if (candidate_ids) {
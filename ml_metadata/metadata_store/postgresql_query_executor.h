@@ -16,6 +16,7 @@ limitations under the License.
 #define THIRD_PARTY_ML_METADATA_METADATA_STORE_POSTGRESQL_QUERY_EXECUTOR_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -23,10 +24,14 @@ limitations under the License.
 #include "google/protobuf/text_format.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/metadata_store/property_name_dictionary.h"
 #include "ml_metadata/metadata_store/query_config_executor.h"
 #include "ml_metadata/metadata_store/query_executor.h"
+#include "ml_metadata/metadata_store/template_query.h"
 #include "ml_metadata/proto/metadata_source.pb.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/util/return_utils.h"
@@ -37,6 +42,11 @@ namespace ml_metadata {
 // encoded in MetadataSourceQueryConfig. This class binds the relevant arguments
 // for each query using the Bind() methods. See notes on constructor for various
 // ways to construct this object.
+//
+// If the MetadataSource supports query parameters, the strings, int64_t,
+// doubles, booleans and protos are bound as typed parameters instead of SQL
+// literals, so they are never escaped, and the query text does not depend on
+// their values.
 class PostgreSQLQueryExecutor : public QueryExecutor {
  public:
   // Note that the query config and the MetadataSource must be compatible.
@@ -48,7 +58,10 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
   // The MetadataSource is not owned by this object, and must outlast it.
   PostgreSQLQueryExecutor(const MetadataSourceQueryConfig& query_config,
                           MetadataSource* source)
-      : query_config_(query_config), metadata_source_(source) {}
+      : query_config_(query_config),
+        compiled_queries_(CompileTemplateQueries(query_config_)),
+        metadata_source_(source),
+        property_names_(source) {}
 
   // A `query_version` can be passed to the PostgreSQLQueryExecutor to work with
   // an existing db with an earlier schema version.
@@ -158,6 +171,38 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
   absl::Status SelectParentTypesByTypeID(absl::Span<const int64_t> type_ids,
                                          RecordSet* record_set) final;
 
+  absl::Status UpdateTypeCatalogVersion(int64_t type_id) final;
+
+  absl::Status SelectTypeCatalogVersion(int64_t* catalog_version) final;
+
+  absl::Status SelectTypesChangedAfterCatalogVersion(
+      int64_t catalog_version, RecordSet* record_set) final;
+
+  absl::Status IncreaseWriteEpochs(absl::Span<const TypeKind> type_kinds) final;
+
+  absl::Status SelectWriteEpochs(RecordSet* record_set) final;
+
+  absl::Status UpdateContextSummariesByExecutions(
+      absl::Span<const int64_t> execution_ids, int64_t delta) final;
+
+  absl::Status UpdateContextSummariesByArtifacts(
+      absl::Span<const int64_t> artifact_ids, int64_t delta) final;
+
+  absl::Status IncreaseContextSummaryByAssociation(int64_t context_id,
+                                                   int64_t execution_id) final;
+
+  absl::Status IncreaseContextSummaryByAttribution(int64_t context_id,
+                                                   int64_t artifact_id) final;
+
+  absl::Status RefreshContextSummaries(
+      absl::Span<const int64_t> context_ids) final;
+
+  absl::Status RebuildContextSummaries(
+      absl::Span<const int64_t> context_ids) final;
+
+  absl::Status SelectContextSummaries(absl::Span<const int64_t> context_ids,
+                                      RecordSet* record_set) final;
+
   // Gets the last inserted id.
   absl::Status SelectLastInsertID(int64_t* id);
 
@@ -184,6 +229,19 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(artifact_ids)}, record_set);
   }
 
+  absl::Status SelectArtifactLastUpdateTimesByID(
+      absl::Span<const int64_t> artifact_ids, RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifact_last_update_time_by_id(),
+                        {Bind(artifact_ids)}, record_set);
+  }
+
+  absl::Status SelectArtifactIDsByRecency(
+      absl::Span<const int64_t> artifact_ids, int64_t limit,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifact_ids_by_recency(),
+                        {Bind(artifact_ids), Bind(limit)}, record_set);
+  }
+
   absl::Status SelectArtifactsByExternalIds(
       absl::Span<absl::string_view> external_ids, RecordSet* record_set) {
     MLMD_RETURN_IF_ERROR(
@@ -199,6 +257,13 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(artifact_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectArtifactsByTypeIDAndArtifactNames(
+      int64_t artifact_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifacts_by_type_id_and_names(),
+                        {Bind(artifact_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status SelectArtifactsByTypeID(int64_t artifact_type_id,
                                        RecordSet* record_set) final {
     return ExecuteQuery(query_config_.select_artifacts_by_type_id(),
@@ -211,28 +276,52 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         record_set);
   }
 
+  absl::Status SelectArtifactsByURIs(absl::Span<absl::string_view> uris,
+                                     RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifacts_by_uris(), {Bind(uris)},
+                        record_set);
+  }
+
   absl::Status UpdateArtifactDirect(
       int64_t artifact_id, int64_t type_id, const std::string& uri,
       const std::optional<Artifact::State>& state,
       std::optional<absl::string_view> external_id,
-      const absl::Time update_time) final {
+      const absl::Time update_time, const UpdatePrecondition& precondition,
+      int updated_columns) final {
+    if (precondition.ByteSizeLong() > 0) {
+      std::vector<std::string> parameters = {
+          Bind(artifact_id), Bind(type_id), Bind(uri), Bind(state),
+          Bind(external_id), Bind(absl::ToUnixMillis(update_time))};
+      BindPrecondition(precondition, &parameters);
+      parameters.push_back(Bind(updated_columns));
+      RecordSet record_set;
+      MLMD_RETURN_IF_ERROR(
+          ExecuteQuery(query_config_.update_artifact_with_precondition(),
+                       parameters, &record_set));
+      return CheckConditionalUpdate("artifact", artifact_id, precondition,
+                                    record_set);
+    }
     return ExecuteQuery(
         query_config_.update_artifact(),
         {Bind(artifact_id), Bind(type_id), Bind(uri), Bind(state),
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateArtifactLastUpdateTime(
+      absl::Span<const int64_t> artifact_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_artifact_last_update_time(),
+        {Bind(artifact_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
+  absl::Status CheckPropertyNameTable() final;
+
   absl::Status CheckArtifactPropertyTable() final;
 
   absl::Status InsertArtifactProperty(int64_t artifact_id,
                                       absl::string_view artifact_property_name,
                                       bool is_custom_property,
-                                      const Value& property_value) final {
-    return ExecuteQuery(query_config_.insert_artifact_property(),
-                        {BindDataType(property_value), Bind(artifact_id),
-                         Bind(artifact_property_name), Bind(is_custom_property),
-                         BindValue(property_value)});
-  }
+                                      const Value& property_value) final;
 
   absl::Status SelectArtifactPropertyByArtifactID(
       absl::Span<const int64_t> artifact_ids, RecordSet* record_set) final {
@@ -246,18 +335,19 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
 
   absl::Status UpdateArtifactProperty(int64_t artifact_id,
                                       absl::string_view property_name,
-                                      const Value& property_value) final {
-    return ExecuteQuery(
-        query_config_.update_artifact_property(),
-        {BindDataType(property_value), BindValue(property_value),
-         Bind(artifact_id), Bind(property_name)});
-  }
+                                      const Value& property_value) final;
 
   absl::Status DeleteArtifactProperty(int64_t artifact_id,
-                                      absl::string_view property_name) final {
-    return ExecuteQuery(query_config_.delete_artifact_property(),
-                        {Bind(artifact_id), Bind(property_name)});
-  }
+                                      absl::string_view property_name,
+                                      bool is_custom_property) final;
+
+  absl::Status InsertArtifactsProperty(
+      absl::Span<const int64_t> artifact_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteArtifactsProperties(
+      absl::Span<const int64_t> artifact_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckExecutionTable() final;
 
@@ -281,6 +371,20 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(execution_ids)}, record_set);
   }
 
+  absl::Status SelectExecutionLastUpdateTimesByID(
+      absl::Span<const int64_t> execution_ids, RecordSet* record_set) final {
+    return ExecuteQuery(
+        query_config_.select_execution_last_update_time_by_id(),
+        {Bind(execution_ids)}, record_set);
+  }
+
+  absl::Status SelectExecutionIDsByRecency(
+      absl::Span<const int64_t> execution_ids, int64_t limit,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_execution_ids_by_recency(),
+                        {Bind(execution_ids), Bind(limit)}, record_set);
+  }
+
   absl::Status SelectExecutionsByExternalIds(absl::Span<absl::string_view> ids,
                                              RecordSet* record_set) final {
     MLMD_RETURN_IF_ERROR(
@@ -296,6 +400,13 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(execution_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectExecutionsByTypeIDAndExecutionNames(
+      int64_t execution_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_executions_by_type_id_and_names(),
+                        {Bind(execution_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status SelectExecutionsByTypeID(int64_t execution_type_id,
                                         RecordSet* record_set) final {
     return ExecuteQuery(query_config_.select_executions_by_type_id(),
@@ -306,23 +417,60 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
       int64_t execution_id, int64_t type_id,
       const std::optional<Execution::State>& last_known_state,
       std::optional<absl::string_view> external_id,
-      const absl::Time update_time) final {
+      const absl::Time update_time, const UpdatePrecondition& precondition,
+      int updated_columns) final {
+    if (precondition.ByteSizeLong() > 0) {
+      std::vector<std::string> parameters = {
+          Bind(execution_id), Bind(type_id), Bind(last_known_state),
+          Bind(external_id), Bind(absl::ToUnixMillis(update_time))};
+      BindPrecondition(precondition, &parameters);
+      parameters.push_back(Bind(updated_columns));
+      RecordSet record_set;
+      MLMD_RETURN_IF_ERROR(
+          ExecuteQuery(query_config_.update_execution_with_precondition(),
+                       parameters, &record_set));
+      return CheckConditionalUpdate("execution", execution_id, precondition,
+                                    record_set);
+    }
     return ExecuteQuery(
         query_config_.update_execution(),
         {Bind(execution_id), Bind(type_id), Bind(last_known_state),
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateExecutionLastUpdateTime(
+      absl::Span<const int64_t> execution_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_execution_last_update_time(),
+        {Bind(execution_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
+  // Row locks of SELECT ... FOR UPDATE SKIP LOCKED serialize the claims.
+  absl::Status LockExecutionTableForClaim() final { return absl::OkStatus(); }
+
+  absl::Status SelectExecutionIdsForClaim(int64_t type_id,
+                                          Execution::State state,
+                                          int64_t max_num_executions,
+                                          RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_execution_ids_for_claim(),
+                        {Bind(type_id), Bind(state), Bind(max_num_executions)},
+                        record_set);
+  }
+
+  absl::Status UpdateExecutionsState(absl::Span<const int64_t> execution_ids,
+                                     Execution::State state,
+                                     absl::Time update_time) final {
+    return ExecuteQuery(query_config_.update_executions_state(),
+                        {Bind(execution_ids), Bind(state),
+                         Bind(absl::ToUnixMillis(update_time))});
+  }
+
   absl::Status CheckExecutionPropertyTable() final;
 
   absl::Status InsertExecutionProperty(int64_t execution_id,
                                        absl::string_view name,
                                        bool is_custom_property,
-                                       const Value& value) final {
-    return ExecuteQuery(query_config_.insert_execution_property(),
-                        {BindDataType(value), Bind(execution_id), Bind(name),
-                         Bind(is_custom_property), BindValue(value)});
-  }
+                                       const Value& value) final;
 
   absl::Status SelectExecutionPropertyByExecutionID(
       absl::Span<const int64_t> execution_ids, RecordSet* record_set) final {
@@ -336,17 +484,19 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
 
   absl::Status UpdateExecutionProperty(int64_t execution_id,
                                        absl::string_view name,
-                                       const Value& value) final {
-    return ExecuteQuery(query_config_.update_execution_property(),
-                        {BindDataType(value), BindValue(value),
-                         Bind(execution_id), Bind(name)});
-  }
+                                       const Value& value) final;
 
   absl::Status DeleteExecutionProperty(int64_t execution_id,
-                                       absl::string_view name) final {
-    return ExecuteQuery(query_config_.delete_execution_property(),
-                        {Bind(execution_id), Bind(name)});
-  }
+                                       absl::string_view name,
+                                       bool is_custom_property) final;
+
+  absl::Status InsertExecutionsProperty(
+      absl::Span<const int64_t> execution_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteExecutionsProperties(
+      absl::Span<const int64_t> execution_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckContextTable() final;
 
@@ -369,6 +519,12 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(context_ids)}, record_set);
   }
 
+  absl::Status SelectContextLastUpdateTimesByID(
+      absl::Span<const int64_t> context_ids, RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_context_last_update_time_by_id(),
+                        {Bind(context_ids)}, record_set);
+  }
+
   absl::Status SelectContextsByExternalIds(
       absl::Span<absl::string_view> external_ids, RecordSet* record_set) final {
     MLMD_RETURN_IF_ERROR(
@@ -390,6 +546,13 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(context_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectContextsByTypeIDAndContextNames(
+      int64_t context_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_contexts_by_type_id_and_names(),
+                        {Bind(context_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status UpdateContextDirect(int64_t existing_context_id, int64_t type_id,
                                    const std::string& context_name,
                                    std::optional<absl::string_view> external_id,
@@ -400,15 +563,18 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateContextLastUpdateTime(
+      absl::Span<const int64_t> context_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_context_last_update_time(),
+        {Bind(context_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
   absl::Status CheckContextPropertyTable() final;
 
   absl::Status InsertContextProperty(int64_t context_id, absl::string_view name,
                                      bool custom_property,
-                                     const Value& value) final {
-    return ExecuteQuery(query_config_.insert_context_property(),
-                        {BindDataType(value), Bind(context_id), Bind(name),
-                         Bind(custom_property), BindValue(value)});
-  }
+                                     const Value& value) final;
 
   absl::Status SelectContextPropertyByContextID(
       absl::Span<const int64_t> context_ids, RecordSet* record_set) final {
@@ -424,18 +590,19 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
 
   absl::Status UpdateContextProperty(int64_t context_id,
                                      absl::string_view property_name,
-                                     const Value& property_value) final {
-    return ExecuteQuery(
-        query_config_.update_context_property(),
-        {BindDataType(property_value), BindValue(property_value),
-         Bind(context_id), Bind(property_name)});
-  }
+                                     const Value& property_value) final;
 
   absl::Status DeleteContextProperty(const int64_t context_id,
-                                     absl::string_view property_name) final {
-    return ExecuteQuery(query_config_.delete_context_property(),
-                        {Bind(context_id), Bind(property_name)});
-  }
+                                     absl::string_view property_name,
+                                     bool is_custom_property) final;
+
+  absl::Status InsertContextsProperty(
+      absl::Span<const int64_t> context_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteContextsProperties(
+      absl::Span<const int64_t> context_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckEventTable() final;
 
@@ -462,6 +629,41 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
                         {Bind(execution_ids)}, event_record_set);
   }
 
+  absl::Status SelectLineageEventByArtifactIDs(
+      absl::Span<const int64_t> artifact_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds,
+      absl::Span<const int> execution_states, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) final {
+    return ExecuteQuery(
+        query_config_.select_lineage_event_by_artifact_ids(),
+        {Bind(artifact_ids), Bind(event_start_time_milliseconds),
+         Bind(event_end_time_milliseconds), Bind(node_start_time_milliseconds),
+         Bind(node_end_time_milliseconds),
+         Bind(static_cast<int>(execution_states.size())),
+         execution_states.empty() ? "NULL"
+                                  : absl::StrJoin(execution_states, ", "),
+         Bind(limit), Bind(offset)},
+        event_record_set);
+  }
+
+  absl::Status SelectLineageEventByExecutionIDs(
+      absl::Span<const int64_t> execution_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) final {
+    return ExecuteQuery(
+        query_config_.select_lineage_event_by_execution_ids(),
+        {Bind(execution_ids), Bind(event_start_time_milliseconds),
+         Bind(event_end_time_milliseconds), Bind(node_start_time_milliseconds),
+         Bind(node_end_time_milliseconds), Bind(limit), Bind(offset)},
+        event_record_set);
+  }
+
   absl::Status CheckEventPathTable() final;
 
   absl::Status InsertEventPath(int64_t event_id,
@@ -526,15 +728,17 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
   absl::Status CheckMLMDEnvTable() final;
 
   // Insert the schema version.
+  // The schema version queries have two statements, which cannot have
+  // parameters, so the version is inlined.
   absl::Status InsertSchemaVersion(int64_t schema_version) final {
     return ExecuteQuery(query_config_.insert_schema_version(),
-                        {Bind(schema_version)});
+                        {absl::StrCat(schema_version)});
   }
 
   // Update the schema version.
   absl::Status UpdateSchemaVersion(int64_t schema_version) final {
     return ExecuteQuery(query_config_.update_schema_version(),
-                        {Bind(schema_version)});
+                        {absl::StrCat(schema_version)});
   }
 
   absl::Status CheckTablesIn_V0_13_2() final;
@@ -620,6 +824,14 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
   // Utility method to bind an string_view value to a SQL clause.
   std::string Bind(absl::string_view value);
 
+  // Appends `value` to `output` as a text parameter, or as a quoted and
+  // escaped literal if the source does not support query parameters.
+  void AppendString(absl::string_view value, std::string* output);
+
+  // Adds `value` to the parameters of the next query that RunQuery runs, and
+  // returns the `$n` placeholder of the parameter in that query.
+  std::string BindParameter(QueryParameter::Type type, std::string value);
+
   // Utility method to bind an string_view value to a SQL clause.
   std::string Bind(const char* value);
 
@@ -663,6 +875,12 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
   // fit into SQL IN(...) clause.
   std::string Bind(absl::Span<const int64_t> value);
 
+  // Appends the parameters of `precondition` in the conditional update
+  // queries to `parameters`: the expected last_update_time_since_epoch, the
+  // number of expected states, and the expected states.
+  void BindPrecondition(const UpdatePrecondition& precondition,
+                        std::vector<std::string>* parameters);
+
   // Utility method to bind a string_view vector to a string joined with ","
   // that can fit into SQL IN(...) clause.
   std::string Bind(absl::Span<absl::string_view> value);
@@ -717,6 +935,11 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
     return SelectLastInsertID(last_insert_id);
   }
 
+  // Runs a composed query with the parameters bound since the previous query,
+  // which its `$n` placeholders refer to, and then drops the parameters. The
+  // errors are the ones of MetadataSource::ExecuteQuery.
+  absl::Status RunQuery(const std::string& query, RecordSet* record_set);
+
   // Executes a query without arguments.
   // Results consist of zero or more rows represented in RecordSet.
   // Returns FAILED_PRECONDITION error, if Connection() is not opened.
@@ -768,11 +991,50 @@ class PostgreSQLQueryExecutor : public QueryExecutor {
       std::optional<absl::Span<const int64_t>> candidate_ids,
       RecordSet* record_set);
 
+  // Gets the id of the property name `name` in the PropertyName table, and
+  // adds the name to the table first if it is new.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status InternPropertyName(absl::string_view name, int64_t* name_id);
+
+  // Gets the id of the property name `name` in the PropertyName table. Sets
+  // `name_id` to nullopt if no property with the name has been stored.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status SelectPropertyNameId(absl::string_view name,
+                                    std::optional<int64_t>* name_id);
+
+  // Gets the ids of the stored property names in `names` into `name_ids`.
+  // Names that have never been stored are skipped.
+  absl::Status SelectPropertyNameIds(absl::Span<const std::string> names,
+                                     std::vector<int64_t>* name_ids);
+
   MetadataSourceQueryConfig query_config_;
 
+  // The templates of `query_config_`, split into segments at construction.
+  CompiledTemplateQueryMap compiled_queries_;
+
+  // Reusable buffer the template queries are composed into before execution.
+  std::string query_buffer_;
+
+  struct BoundParameter {
+    QueryParameter::Type type;
+    std::string value;
+  };
+
+  // The parameters bound by BindParameter since the previous query, the one
+  // at index i for placeholder `$i+1`.
+  std::vector<BoundParameter> bound_parameters_;
+
+  // Reusable buffer of the parameters that RunQuery passes to the source,
+  // which point into `bound_parameters_`.
+  std::vector<QueryParameter> query_parameters_;
+
   // This object does not own the MetadataSource.
   MetadataSource* metadata_source_;
 
+  // The ids of the property names that were read or interned via
+  // `metadata_source_`.
+  PropertyNameDictionary property_names_;
+
   // Delegates EncodeBytes to metadata_source_
   // Encodes value and returns the result as a string
   std::string EncodeBytes(absl::string_view value) const {
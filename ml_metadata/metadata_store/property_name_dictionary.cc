@@ -0,0 +1,51 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/property_name_dictionary.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace ml_metadata {
+
+std::optional<int64_t> PropertyNameDictionary::Find(absl::string_view name) {
+  DropIfRolledBack();
+  auto it = name_ids_.find(name);
+  if (it == name_ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void PropertyNameDictionary::Insert(absl::string_view name, int64_t name_id) {
+  DropIfRolledBack();
+  if (name_ids_.size() >= kMaxNumCachedNames) {
+    name_ids_.clear();
+  }
+  name_ids_.insert_or_assign(std::string(name), name_id);
+}
+
+void PropertyNameDictionary::DropIfRolledBack() {
+  const int64_t num_rolled_back_transactions =
+      source_->num_rolled_back_transactions();
+  if (num_rolled_back_transactions != num_rolled_back_transactions_) {
+    name_ids_.clear();
+    num_rolled_back_transactions_ = num_rolled_back_transactions;
+  }
+}
+
+}  // namespace ml_metadata
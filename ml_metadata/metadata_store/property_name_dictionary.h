@@ -0,0 +1,78 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef THIRD_PARTY_ML_METADATA_METADATA_STORE_PROPERTY_NAME_DICTIONARY_H_
+#define THIRD_PARTY_ML_METADATA_METADATA_STORE_PROPERTY_NAME_DICTIONARY_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+
+namespace ml_metadata {
+
+// Caches the ids of the property names interned in the PropertyName table, so
+// that writing a property does not need a query to translate its name.
+//
+// The ids are read or interned in the transactions of a MetadataSource. An id
+// interned in a transaction that is rolled back afterwards is gone, so the
+// cache drops all the ids whenever the source rolled back a transaction since
+// they were cached. Ids that are committed never change.
+//
+// This class is thread-unsafe.
+class PropertyNameDictionary {
+ public:
+  // The maximum number of cached names. The cache is dropped once it is full,
+  // which bounds its memory for stores that use unbounded property names.
+  static constexpr int kMaxNumCachedNames = 10000;
+
+  // The MetadataSource is not owned by this object, and must outlast it.
+  explicit PropertyNameDictionary(const MetadataSource* source)
+      : source_(source),
+        num_rolled_back_transactions_(source->num_rolled_back_transactions()) {}
+
+  // Disallows copy.
+  PropertyNameDictionary(const PropertyNameDictionary&) = delete;
+  PropertyNameDictionary& operator=(const PropertyNameDictionary&) = delete;
+
+  // Returns the cached id of the property name `name`, or nullopt if it is
+  // not cached.
+  std::optional<int64_t> Find(absl::string_view name);
+
+  // Caches `name_id` as the id of the property name `name`. The id must have
+  // been read or interned in the current or a committed transaction.
+  void Insert(absl::string_view name, int64_t name_id);
+
+  // Drops all the cached ids, e.g., after the PropertyName table is dropped.
+  void Clear() { name_ids_.clear(); }
+
+  // Returns the number of cached names.
+  int size() const { return name_ids_.size(); }
+
+ private:
+  // Drops the cached ids if the source rolled back a transaction since they
+  // were cached.
+  void DropIfRolledBack();
+
+  const MetadataSource* source_;
+  int64_t num_rolled_back_transactions_;
+  absl::flat_hash_map<std::string, int64_t> name_ids_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // THIRD_PARTY_ML_METADATA_METADATA_STORE_PROPERTY_NAME_DICTIONARY_H_
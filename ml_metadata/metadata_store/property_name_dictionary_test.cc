@@ -0,0 +1,123 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/property_name_dictionary.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+using ::testing::Eq;
+using ::testing::Optional;
+
+// A source that only tracks its transactions.
+class FakeTransactionalSource : public MetadataSource {
+ public:
+  std::string EscapeString(absl::string_view value) const override {
+    return std::string(value);
+  }
+  std::string EncodeBytes(absl::string_view value) const override {
+    return std::string(value);
+  }
+  absl::StatusOr<std::string> DecodeBytes(
+      absl::string_view value) const override {
+    return std::string(value);
+  }
+
+ private:
+  absl::Status ConnectImpl() override { return absl::OkStatus(); }
+  absl::Status CloseImpl() override { return absl::OkStatus(); }
+  absl::Status ExecuteQueryImpl(const std::string& query,
+                                RecordSet* results) override {
+    return absl::OkStatus();
+  }
+  absl::Status BeginImpl() override { return absl::OkStatus(); }
+  absl::Status CommitImpl() override { return absl::OkStatus(); }
+  absl::Status RollbackImpl() override { return absl::OkStatus(); }
+};
+
+TEST(PropertyNameDictionaryTest, KeepsIdsOfCommittedTransactions) {
+  FakeTransactionalSource source;
+  ASSERT_EQ(source.Connect(), absl::OkStatus());
+  PropertyNameDictionary property_names(&source);
+  EXPECT_EQ(property_names.Find("p1"), std::nullopt);
+
+  ASSERT_EQ(source.Begin(), absl::OkStatus());
+  property_names.Insert("p1", 1);
+  property_names.Insert("p2", 2);
+  EXPECT_THAT(property_names.Find("p1"), Optional(Eq(1)));
+  ASSERT_EQ(source.Commit(), absl::OkStatus());
+
+  ASSERT_EQ(source.Begin(), absl::OkStatus());
+  EXPECT_THAT(property_names.Find("p1"), Optional(Eq(1)));
+  EXPECT_THAT(property_names.Find("p2"), Optional(Eq(2)));
+  EXPECT_EQ(property_names.Find("p3"), std::nullopt);
+  ASSERT_EQ(source.Commit(), absl::OkStatus());
+}
+
+TEST(PropertyNameDictionaryTest, DropsIdsAfterRollback) {
+  FakeTransactionalSource source;
+  ASSERT_EQ(source.Connect(), absl::OkStatus());
+  PropertyNameDictionary property_names(&source);
+
+  ASSERT_EQ(source.Begin(), absl::OkStatus());
+  property_names.Insert("p1", 1);
+  ASSERT_EQ(source.Commit(), absl::OkStatus());
+  ASSERT_EQ(source.Begin(), absl::OkStatus());
+  property_names.Insert("p2", 2);
+  ASSERT_EQ(source.Rollback(), absl::OkStatus());
+  EXPECT_EQ(source.num_rolled_back_transactions(), 1);
+
+  // The rolled back transaction may have interned "p2", so every id is read
+  // again.
+  EXPECT_EQ(property_names.Find("p2"), std::nullopt);
+  EXPECT_EQ(property_names.Find("p1"), std::nullopt);
+  EXPECT_EQ(property_names.size(), 0);
+}
+
+TEST(PropertyNameDictionaryTest, DropsIdsAfterClosingOpenTransaction) {
+  FakeTransactionalSource source;
+  ASSERT_EQ(source.Connect(), absl::OkStatus());
+  PropertyNameDictionary property_names(&source);
+
+  ASSERT_EQ(source.Begin(), absl::OkStatus());
+  property_names.Insert("p1", 1);
+  ASSERT_EQ(source.Close(), absl::OkStatus());
+  EXPECT_EQ(property_names.Find("p1"), std::nullopt);
+}
+
+TEST(PropertyNameDictionaryTest, BoundsNumberOfCachedNames) {
+  FakeTransactionalSource source;
+  PropertyNameDictionary property_names(&source);
+  for (int i = 0; i < PropertyNameDictionary::kMaxNumCachedNames; i++) {
+    property_names.Insert(absl::StrCat("p", i), i);
+  }
+  EXPECT_EQ(property_names.size(), PropertyNameDictionary::kMaxNumCachedNames);
+  property_names.Insert("last", -1);
+  EXPECT_EQ(property_names.size(), 1);
+  EXPECT_THAT(property_names.Find("last"), Optional(Eq(-1)));
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -24,9 +25,12 @@ limitations under the License.
 #include "google/protobuf/text_format.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/metadata_store/property_name_dictionary.h"
 #include "ml_metadata/metadata_store/query_executor.h"
+#include "ml_metadata/metadata_store/template_query.h"
 #include "ml_metadata/proto/metadata_source.pb.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/util/return_utils.h"
@@ -35,6 +39,10 @@ namespace ml_metadata {
 
 constexpr int kSchemaVersionNine = 9;
 constexpr int kSchemaVersionTen = 10;
+constexpr int kSchemaVersionEleven = 11;
+constexpr int kSchemaVersionTwelve = 12;
+constexpr int kSchemaVersionThirteen = 13;
+constexpr int kSchemaVersionFourteen = 14;
 
 // Prepares a template query used for earlier query schema version.
 inline absl::Status GetTemplateQueryOrDie(
@@ -290,6 +298,138 @@ static constexpr absl::string_view kSelectContextPropertyByContextId = R"pb(
 // END ContextProperty queries
 
 }  // namespace v7_v8_v9
+
+// Before v12, the property tables store the property names instead of the
+// ids of the names in the PropertyName table.
+namespace v10_v11 {
+
+// BEGIN ArtifactProperty queries
+
+static constexpr absl::string_view kCheckArtifactPropertyTable = R"pb(
+  query: " SELECT `artifact_id`, `name`, `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `byte_value`, "
+         "        `proto_value`, `bool_value` "
+         " FROM `ArtifactProperty` LIMIT 1; "
+)pb";
+
+static constexpr absl::string_view kInsertArtifactProperty = R"pb(
+  query: " INSERT INTO `ArtifactProperty`( "
+         "   `artifact_id`, `name`, `is_custom_property`, `$0` "
+         ") VALUES($1, $2, $3, $4);"
+  parameter_num: 5
+)pb";
+
+static constexpr absl::string_view kSelectArtifactPropertyByArtifactId = R"pb(
+  query: " SELECT `artifact_id` as `id`, `name` as `key`, "
+         "        `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `proto_value`,"
+         "        `bool_value` "
+         " from `ArtifactProperty` "
+         " WHERE `artifact_id` IN ($0); "
+  parameter_num: 1
+)pb";
+
+static constexpr absl::string_view kUpdateArtifactProperty = R"pb(
+  query: " UPDATE `ArtifactProperty` "
+         " SET `$0` = $1 "
+         " WHERE `artifact_id` = $2 and `name` = $3;"
+  parameter_num: 4
+)pb";
+
+static constexpr absl::string_view kDeleteArtifactProperty = R"pb(
+  query: " DELETE FROM `ArtifactProperty` "
+         " WHERE `artifact_id` = $0 and `name` = $1 "
+         "   and `is_custom_property` = $2;"
+  parameter_num: 3
+)pb";
+
+// END ArtifactProperty queries
+
+// BEGIN ExecutionProperty queries
+
+static constexpr absl::string_view kCheckExecutionPropertyTable = R"pb(
+  query: " SELECT `execution_id`, `name`, `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `byte_value`, "
+         "        `proto_value`, `bool_value` "
+         " FROM `ExecutionProperty` LIMIT 1; "
+)pb";
+
+static constexpr absl::string_view kInsertExecutionProperty = R"pb(
+  query: " INSERT INTO `ExecutionProperty`( "
+         "   `execution_id`, `name`, `is_custom_property`, `$0` "
+         ") VALUES($1, $2, $3, $4);"
+  parameter_num: 5
+)pb";
+
+static constexpr absl::string_view kSelectExecutionPropertyByExecutionId = R"pb(
+  query: " SELECT `execution_id` as `id`, `name` as `key`, "
+         "        `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `proto_value`,"
+         "        `bool_value` "
+         " from `ExecutionProperty` "
+         " WHERE `execution_id` IN ($0); "
+  parameter_num: 1
+)pb";
+
+static constexpr absl::string_view kUpdateExecutionProperty = R"pb(
+  query: " UPDATE `ExecutionProperty` "
+         " SET `$0` = $1 "
+         " WHERE `execution_id` = $2 and `name` = $3;"
+  parameter_num: 4
+)pb";
+
+static constexpr absl::string_view kDeleteExecutionProperty = R"pb(
+  query: " DELETE FROM `ExecutionProperty` "
+         " WHERE `execution_id` = $0 and `name` = $1 "
+         "   and `is_custom_property` = $2;"
+  parameter_num: 3
+)pb";
+
+// END ExecutionProperty queries
+
+// BEGIN ContextProperty queries
+
+static constexpr absl::string_view kCheckContextPropertyTable = R"pb(
+  query: " SELECT `context_id`, `name`, `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `byte_value`, "
+         "        `proto_value`, `bool_value` "
+         " FROM `ContextProperty` LIMIT 1; "
+)pb";
+
+static constexpr absl::string_view kInsertContextProperty = R"pb(
+  query: " INSERT INTO `ContextProperty`( "
+         "   `context_id`, `name`, `is_custom_property`, `$0` "
+         ") VALUES($1, $2, $3, $4);"
+  parameter_num: 5
+)pb";
+
+static constexpr absl::string_view kSelectContextPropertyByContextId = R"pb(
+  query: " SELECT `context_id` as `id`, `name` as `key`, "
+         "        `is_custom_property`, "
+         "        `int_value`, `double_value`, `string_value`, `proto_value`,"
+         "        `bool_value` "
+         " from `ContextProperty` "
+         " WHERE `context_id` IN ($0); "
+  parameter_num: 1
+)pb";
+
+static constexpr absl::string_view kUpdateContextProperty = R"pb(
+  query: " UPDATE `ContextProperty` "
+         " SET `$0` = $1 "
+         " WHERE `context_id` = $2 and `name` = $3;"
+  parameter_num: 4
+)pb";
+
+static constexpr absl::string_view kDeleteContextProperty = R"pb(
+  query: " DELETE FROM `ContextProperty` "
+         " WHERE `context_id` = $0 and `name` = $1 "
+         "   and `is_custom_property` = $2;"
+  parameter_num: 3
+)pb";
+
+// END ContextProperty queries
+
+}  // namespace v10_v11
 }  // namespace property_query
 
 // A SQL version of the QueryExecutor. The text of most queries are
@@ -317,7 +457,10 @@ class QueryConfigExecutor : public QueryExecutor {
   // The MetadataSource is not owned by this object, and must outlast it.
   QueryConfigExecutor(const MetadataSourceQueryConfig& query_config,
                       MetadataSource* source)
-      : query_config_(query_config), metadata_source_(source) {}
+      : query_config_(query_config),
+        compiled_queries_(CompileTemplateQueries(query_config_)),
+        metadata_source_(source),
+        property_names_(source) {}
 
   // A `query_version` can be passed to the QueryConfigExecutor to work with
   // an existing db with an earlier schema version.
@@ -428,6 +571,38 @@ class QueryConfigExecutor : public QueryExecutor {
   absl::Status SelectParentTypesByTypeID(absl::Span<const int64_t> type_ids,
                                          RecordSet* record_set) final;
 
+  absl::Status UpdateTypeCatalogVersion(int64_t type_id) final;
+
+  absl::Status SelectTypeCatalogVersion(int64_t* catalog_version) final;
+
+  absl::Status SelectTypesChangedAfterCatalogVersion(
+      int64_t catalog_version, RecordSet* record_set) final;
+
+  absl::Status IncreaseWriteEpochs(absl::Span<const TypeKind> type_kinds) final;
+
+  absl::Status SelectWriteEpochs(RecordSet* record_set) final;
+
+  absl::Status UpdateContextSummariesByExecutions(
+      absl::Span<const int64_t> execution_ids, int64_t delta) final;
+
+  absl::Status UpdateContextSummariesByArtifacts(
+      absl::Span<const int64_t> artifact_ids, int64_t delta) final;
+
+  absl::Status IncreaseContextSummaryByAssociation(int64_t context_id,
+                                                   int64_t execution_id) final;
+
+  absl::Status IncreaseContextSummaryByAttribution(int64_t context_id,
+                                                   int64_t artifact_id) final;
+
+  absl::Status RefreshContextSummaries(
+      absl::Span<const int64_t> context_ids) final;
+
+  absl::Status RebuildContextSummaries(
+      absl::Span<const int64_t> context_ids) final;
+
+  absl::Status SelectContextSummaries(absl::Span<const int64_t> context_ids,
+                                      RecordSet* record_set) final;
+
   // Gets the last inserted id.
   absl::Status SelectLastInsertID(int64_t* id);
 
@@ -487,6 +662,19 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(artifact_ids)}, record_set);
   }
 
+  absl::Status SelectArtifactLastUpdateTimesByID(
+      absl::Span<const int64_t> artifact_ids, RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifact_last_update_time_by_id(),
+                        {Bind(artifact_ids)}, record_set);
+  }
+
+  absl::Status SelectArtifactIDsByRecency(
+      absl::Span<const int64_t> artifact_ids, int64_t limit,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifact_ids_by_recency(),
+                        {Bind(artifact_ids), Bind(limit)}, record_set);
+  }
+
   absl::Status SelectArtifactsByExternalIds(
       absl::Span<absl::string_view> external_ids, RecordSet* record_set) {
     MLMD_RETURN_IF_ERROR(
@@ -502,6 +690,13 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(artifact_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectArtifactsByTypeIDAndArtifactNames(
+      int64_t artifact_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifacts_by_type_id_and_names(),
+                        {Bind(artifact_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status SelectArtifactsByTypeID(int64_t artifact_type_id,
                                        RecordSet* record_set) final {
     return ExecuteQuery(query_config_.select_artifacts_by_type_id(),
@@ -514,11 +709,33 @@ class QueryConfigExecutor : public QueryExecutor {
                         record_set);
   }
 
+  absl::Status SelectArtifactsByURIs(absl::Span<absl::string_view> uris,
+                                     RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_artifacts_by_uris(), {Bind(uris)},
+                        record_set);
+  }
+
   absl::Status UpdateArtifactDirect(
       int64_t artifact_id, int64_t type_id, const std::string& uri,
       const std::optional<Artifact::State>& state,
       std::optional<absl::string_view> external_id,
-      const absl::Time update_time) final {
+      const absl::Time update_time, const UpdatePrecondition& precondition,
+      int updated_columns) final {
+    if (precondition.ByteSizeLong() > 0) {
+      MLMD_RETURN_IF_ERROR(
+          VerifyCurrentQueryVersionIsAtLeast(kSchemaVersionNine));
+      std::vector<std::string> parameters = {
+          Bind(artifact_id), Bind(type_id), Bind(uri), Bind(state),
+          Bind(external_id), Bind(absl::ToUnixMillis(update_time))};
+      BindPrecondition(precondition, &parameters);
+      parameters.push_back(Bind(updated_columns));
+      RecordSet record_set;
+      MLMD_RETURN_IF_ERROR(
+          ExecuteQuery(query_config_.update_artifact_with_precondition(),
+                       parameters, &record_set));
+      return CheckConditionalUpdate("artifact", artifact_id, precondition,
+                                    record_set);
+    }
     // TODO(b/248836219): Cleanup the fat-client after fully migrated to V9+.
     if (query_schema_version().has_value() &&
         query_schema_version().value() < kSchemaVersionNine) {
@@ -535,14 +752,30 @@ class QueryConfigExecutor : public QueryExecutor {
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateArtifactLastUpdateTime(
+      absl::Span<const int64_t> artifact_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_artifact_last_update_time(),
+        {Bind(artifact_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
+  absl::Status CheckPropertyNameTable() final {
+    return ExecuteQuery(query_config_.check_property_name_table());
+  }
+
   absl::Status CheckArtifactPropertyTable() final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery check_artifact_property_table;
     if (query_schema_version().has_value() &&
         query_schema_version().value() < kSchemaVersionTen) {
       MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
           property_query::v7_v8_v9::kCheckArtifactPropertyTable.data(),
           check_artifact_property_table));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kCheckArtifactPropertyTable.data(),
+          check_artifact_property_table));
     } else {
       check_artifact_property_table =
           query_config_.check_artifact_property_table();
@@ -553,16 +786,11 @@ class QueryConfigExecutor : public QueryExecutor {
   absl::Status InsertArtifactProperty(int64_t artifact_id,
                                       absl::string_view artifact_property_name,
                                       bool is_custom_property,
-                                      const Value& property_value) final {
-    return ExecuteQuery(query_config_.insert_artifact_property(),
-                        {BindDataType(property_value), Bind(artifact_id),
-                         Bind(artifact_property_name), Bind(is_custom_property),
-                         BindValue(property_value)});
-  }
+                                      const Value& property_value) final;
 
   absl::Status SelectArtifactPropertyByArtifactID(
       absl::Span<const int64_t> artifact_ids, RecordSet* record_set) final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery
         select_artifact_property_by_artifact_id;
     if (query_schema_version().has_value() &&
@@ -570,6 +798,11 @@ class QueryConfigExecutor : public QueryExecutor {
       MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
           property_query::v7_v8_v9::kSelectArtifactPropertyByArtifactId.data(),
           select_artifact_property_by_artifact_id));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kSelectArtifactPropertyByArtifactId.data(),
+          select_artifact_property_by_artifact_id));
     } else {
       select_artifact_property_by_artifact_id =
           query_config_.select_artifact_property_by_artifact_id();
@@ -580,18 +813,19 @@ class QueryConfigExecutor : public QueryExecutor {
 
   absl::Status UpdateArtifactProperty(int64_t artifact_id,
                                       absl::string_view property_name,
-                                      const Value& property_value) final {
-    return ExecuteQuery(
-        query_config_.update_artifact_property(),
-        {BindDataType(property_value), BindValue(property_value),
-         Bind(artifact_id), Bind(property_name)});
-  }
+                                      const Value& property_value) final;
 
   absl::Status DeleteArtifactProperty(int64_t artifact_id,
-                                      absl::string_view property_name) final {
-    return ExecuteQuery(query_config_.delete_artifact_property(),
-                        {Bind(artifact_id), Bind(property_name)});
-  }
+                                      absl::string_view property_name,
+                                      bool is_custom_property) final;
+
+  absl::Status InsertArtifactsProperty(
+      absl::Span<const int64_t> artifact_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteArtifactsProperties(
+      absl::Span<const int64_t> artifact_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckExecutionTable() final {
     return ExecuteQuery(query_config_.check_execution_table());
@@ -648,6 +882,20 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(execution_ids)}, record_set);
   }
 
+  absl::Status SelectExecutionLastUpdateTimesByID(
+      absl::Span<const int64_t> execution_ids, RecordSet* record_set) final {
+    return ExecuteQuery(
+        query_config_.select_execution_last_update_time_by_id(),
+        {Bind(execution_ids)}, record_set);
+  }
+
+  absl::Status SelectExecutionIDsByRecency(
+      absl::Span<const int64_t> execution_ids, int64_t limit,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_execution_ids_by_recency(),
+                        {Bind(execution_ids), Bind(limit)}, record_set);
+  }
+
   absl::Status SelectExecutionsByExternalIds(absl::Span<absl::string_view> ids,
                                              RecordSet* record_set) final {
     MLMD_RETURN_IF_ERROR(
@@ -663,6 +911,13 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(execution_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectExecutionsByTypeIDAndExecutionNames(
+      int64_t execution_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_executions_by_type_id_and_names(),
+                        {Bind(execution_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status SelectExecutionsByTypeID(int64_t execution_type_id,
                                         RecordSet* record_set) final {
     return ExecuteQuery(query_config_.select_executions_by_type_id(),
@@ -673,7 +928,23 @@ class QueryConfigExecutor : public QueryExecutor {
       int64_t execution_id, int64_t type_id,
       const std::optional<Execution::State>& last_known_state,
       std::optional<absl::string_view> external_id,
-      const absl::Time update_time) final {
+      const absl::Time update_time, const UpdatePrecondition& precondition,
+      int updated_columns) final {
+    if (precondition.ByteSizeLong() > 0) {
+      MLMD_RETURN_IF_ERROR(
+          VerifyCurrentQueryVersionIsAtLeast(kSchemaVersionNine));
+      std::vector<std::string> parameters = {
+          Bind(execution_id), Bind(type_id), Bind(last_known_state),
+          Bind(external_id), Bind(absl::ToUnixMillis(update_time))};
+      BindPrecondition(precondition, &parameters);
+      parameters.push_back(Bind(updated_columns));
+      RecordSet record_set;
+      MLMD_RETURN_IF_ERROR(
+          ExecuteQuery(query_config_.update_execution_with_precondition(),
+                       parameters, &record_set));
+      return CheckConditionalUpdate("execution", execution_id, precondition,
+                                    record_set);
+    }
     // TODO(b/248836219): Cleanup the fat-client after fully migrated to V9+.
     if (query_schema_version().has_value() &&
         query_schema_version().value() < kSchemaVersionNine) {
@@ -692,14 +963,50 @@ class QueryConfigExecutor : public QueryExecutor {
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateExecutionLastUpdateTime(
+      absl::Span<const int64_t> execution_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_execution_last_update_time(),
+        {Bind(execution_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
+  absl::Status LockExecutionTableForClaim() final {
+    if (!query_config_.has_lock_execution_table_for_claim()) {
+      return absl::OkStatus();
+    }
+    return ExecuteQuery(query_config_.lock_execution_table_for_claim());
+  }
+
+  absl::Status SelectExecutionIdsForClaim(int64_t type_id,
+                                          Execution::State state,
+                                          int64_t max_num_executions,
+                                          RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_execution_ids_for_claim(),
+                        {Bind(type_id), Bind(state), Bind(max_num_executions)},
+                        record_set);
+  }
+
+  absl::Status UpdateExecutionsState(absl::Span<const int64_t> execution_ids,
+                                     Execution::State state,
+                                     absl::Time update_time) final {
+    return ExecuteQuery(query_config_.update_executions_state(),
+                        {Bind(execution_ids), Bind(state),
+                         Bind(absl::ToUnixMillis(update_time))});
+  }
+
   absl::Status CheckExecutionPropertyTable() final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery check_execution_property_table;
     if (query_schema_version().has_value() &&
         query_schema_version().value() < kSchemaVersionTen) {
       MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
           property_query::v7_v8_v9::kCheckExecutionPropertyTable.data(),
           check_execution_property_table));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kCheckExecutionPropertyTable.data(),
+          check_execution_property_table));
     } else {
       check_execution_property_table =
           query_config_.check_execution_property_table();
@@ -710,15 +1017,11 @@ class QueryConfigExecutor : public QueryExecutor {
   absl::Status InsertExecutionProperty(int64_t execution_id,
                                        absl::string_view name,
                                        bool is_custom_property,
-                                       const Value& value) final {
-    return ExecuteQuery(query_config_.insert_execution_property(),
-                        {BindDataType(value), Bind(execution_id), Bind(name),
-                         Bind(is_custom_property), BindValue(value)});
-  }
+                                       const Value& value) final;
 
   absl::Status SelectExecutionPropertyByExecutionID(
       absl::Span<const int64_t> execution_ids, RecordSet* record_set) final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery
         select_execution_property_by_execution_id;
     if (query_schema_version().has_value() &&
@@ -727,6 +1030,11 @@ class QueryConfigExecutor : public QueryExecutor {
           property_query::v7_v8_v9::kSelectExecutionPropertyByExecutionId
               .data(),
           select_execution_property_by_execution_id));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kSelectExecutionPropertyByExecutionId.data(),
+          select_execution_property_by_execution_id));
     } else {
       select_execution_property_by_execution_id =
           query_config_.select_execution_property_by_execution_id();
@@ -737,17 +1045,19 @@ class QueryConfigExecutor : public QueryExecutor {
 
   absl::Status UpdateExecutionProperty(int64_t execution_id,
                                        absl::string_view name,
-                                       const Value& value) final {
-    return ExecuteQuery(query_config_.update_execution_property(),
-                        {BindDataType(value), BindValue(value),
-                         Bind(execution_id), Bind(name)});
-  }
+                                       const Value& value) final;
 
   absl::Status DeleteExecutionProperty(int64_t execution_id,
-                                       absl::string_view name) final {
-    return ExecuteQuery(query_config_.delete_execution_property(),
-                        {Bind(execution_id), Bind(name)});
-  }
+                                       absl::string_view name,
+                                       bool is_custom_property) final;
+
+  absl::Status InsertExecutionsProperty(
+      absl::Span<const int64_t> execution_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteExecutionsProperties(
+      absl::Span<const int64_t> execution_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckContextTable() final {
     return ExecuteQuery(query_config_.check_context_table());
@@ -801,6 +1111,12 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(context_ids)}, record_set);
   }
 
+  absl::Status SelectContextLastUpdateTimesByID(
+      absl::Span<const int64_t> context_ids, RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_context_last_update_time_by_id(),
+                        {Bind(context_ids)}, record_set);
+  }
+
   absl::Status SelectContextsByExternalIds(
       absl::Span<absl::string_view> external_ids, RecordSet* record_set) final {
     MLMD_RETURN_IF_ERROR(
@@ -822,6 +1138,13 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(context_type_id), Bind(name)}, record_set);
   }
 
+  absl::Status SelectContextsByTypeIDAndContextNames(
+      int64_t context_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) final {
+    return ExecuteQuery(query_config_.select_contexts_by_type_id_and_names(),
+                        {Bind(context_type_id), Bind(names)}, record_set);
+  }
+
   absl::Status UpdateContextDirect(int64_t existing_context_id, int64_t type_id,
                                    const std::string& context_name,
                                    std::optional<absl::string_view> external_id,
@@ -843,14 +1166,26 @@ class QueryConfigExecutor : public QueryExecutor {
          Bind(external_id), Bind(absl::ToUnixMillis(update_time))});
   }
 
+  absl::Status UpdateContextLastUpdateTime(
+      absl::Span<const int64_t> context_ids, absl::Time update_time) final {
+    return ExecuteQuery(
+        query_config_.update_context_last_update_time(),
+        {Bind(context_ids), Bind(absl::ToUnixMillis(update_time))});
+  }
+
   absl::Status CheckContextPropertyTable() final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery check_context_property_table;
     if (query_schema_version().has_value() &&
         query_schema_version().value() < kSchemaVersionTen) {
       MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
           property_query::v7_v8_v9::kCheckContextPropertyTable.data(),
           check_context_property_table));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kCheckContextPropertyTable.data(),
+          check_context_property_table));
     } else {
       check_context_property_table =
           query_config_.check_context_property_table();
@@ -860,15 +1195,11 @@ class QueryConfigExecutor : public QueryExecutor {
 
   absl::Status InsertContextProperty(int64_t context_id, absl::string_view name,
                                      bool custom_property,
-                                     const Value& value) final {
-    return ExecuteQuery(query_config_.insert_context_property(),
-                        {BindDataType(value), Bind(context_id), Bind(name),
-                         Bind(custom_property), BindValue(value)});
-  }
+                                     const Value& value) final;
 
   absl::Status SelectContextPropertyByContextID(
       absl::Span<const int64_t> context_ids, RecordSet* record_set) final {
-    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V10+.
+    // TODO(b/257334039): Cleanup the fat-client after fully migrated to V12+.
     MetadataSourceQueryConfig::TemplateQuery
         select_context_property_by_context_id;
     if (query_schema_version().has_value() &&
@@ -876,6 +1207,11 @@ class QueryConfigExecutor : public QueryExecutor {
       MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
           property_query::v7_v8_v9::kSelectContextPropertyByContextId.data(),
           select_context_property_by_context_id));
+    } else if (query_schema_version().has_value() &&
+               query_schema_version().value() < kSchemaVersionTwelve) {
+      MLMD_RETURN_IF_ERROR(GetTemplateQueryOrDie(
+          property_query::v10_v11::kSelectContextPropertyByContextId.data(),
+          select_context_property_by_context_id));
     } else {
       select_context_property_by_context_id =
           query_config_.select_context_property_by_context_id();
@@ -886,18 +1222,19 @@ class QueryConfigExecutor : public QueryExecutor {
 
   absl::Status UpdateContextProperty(int64_t context_id,
                                      absl::string_view property_name,
-                                     const Value& property_value) final {
-    return ExecuteQuery(
-        query_config_.update_context_property(),
-        {BindDataType(property_value), BindValue(property_value),
-         Bind(context_id), Bind(property_name)});
-  }
+                                     const Value& property_value) final;
 
   absl::Status DeleteContextProperty(const int64_t context_id,
-                                     absl::string_view property_name) final {
-    return ExecuteQuery(query_config_.delete_context_property(),
-                        {Bind(context_id), Bind(property_name)});
-  }
+                                     absl::string_view property_name,
+                                     bool is_custom_property) final;
+
+  absl::Status InsertContextsProperty(
+      absl::Span<const int64_t> context_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) final;
+
+  absl::Status DeleteContextsProperties(
+      absl::Span<const int64_t> context_ids,
+      absl::Span<const std::string> names, bool is_custom_property) final;
 
   absl::Status CheckEventTable() final {
     return ExecuteQuery(query_config_.check_event_table());
@@ -926,6 +1263,41 @@ class QueryConfigExecutor : public QueryExecutor {
                         {Bind(execution_ids)}, event_record_set);
   }
 
+  absl::Status SelectLineageEventByArtifactIDs(
+      absl::Span<const int64_t> artifact_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds,
+      absl::Span<const int> execution_states, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) final {
+    return ExecuteQuery(
+        query_config_.select_lineage_event_by_artifact_ids(),
+        {Bind(artifact_ids), Bind(event_start_time_milliseconds),
+         Bind(event_end_time_milliseconds), Bind(node_start_time_milliseconds),
+         Bind(node_end_time_milliseconds),
+         Bind(static_cast<int>(execution_states.size())),
+         execution_states.empty() ? "NULL"
+                                  : absl::StrJoin(execution_states, ", "),
+         Bind(limit), Bind(offset)},
+        event_record_set);
+  }
+
+  absl::Status SelectLineageEventByExecutionIDs(
+      absl::Span<const int64_t> execution_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) final {
+    return ExecuteQuery(
+        query_config_.select_lineage_event_by_execution_ids(),
+        {Bind(execution_ids), Bind(event_start_time_milliseconds),
+         Bind(event_end_time_milliseconds), Bind(node_start_time_milliseconds),
+         Bind(node_end_time_milliseconds), Bind(limit), Bind(offset)},
+        event_record_set);
+  }
+
   absl::Status CheckEventPathTable() final {
     return ExecuteQuery(query_config_.check_event_path_table());
   }
@@ -1100,6 +1472,9 @@ class QueryConfigExecutor : public QueryExecutor {
   // Utility method to bind an string_view value to a SQL clause.
   std::string Bind(absl::string_view value);
 
+  // Appends the quoted and escaped `value` to `output`.
+  void AppendQuotedString(absl::string_view value, std::string* output);
+
   // Utility method to bind an string_view value to a SQL clause.
   std::string Bind(const char* value);
 
@@ -1143,6 +1518,12 @@ class QueryConfigExecutor : public QueryExecutor {
   // fit into SQL IN(...) clause.
   std::string Bind(absl::Span<const int64_t> value);
 
+  // Appends the parameters of `precondition` in the conditional update
+  // queries to `parameters`: the expected last_update_time_since_epoch, the
+  // number of expected states, and the expected states.
+  void BindPrecondition(const UpdatePrecondition& precondition,
+                        std::vector<std::string>* parameters);
+
   // Utility method to bind a string_view vector to a string joined with ","
   // that can fit into SQL IN(...) clause.
   std::string Bind(absl::Span<absl::string_view> value);
@@ -1249,11 +1630,44 @@ class QueryConfigExecutor : public QueryExecutor {
       std::optional<absl::Span<const int64_t>> candidate_ids,
       RecordSet* record_set);
 
+  // Gets the id of the property name `name` in the PropertyName table, and
+  // adds the name to the table first if it is new.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status InternPropertyName(absl::string_view name, int64_t* name_id);
+
+  // Gets the id of the property name `name` in the PropertyName table. Sets
+  // `name_id` to nullopt if no property with the name has been stored.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status SelectPropertyNameId(absl::string_view name,
+                                    std::optional<int64_t>* name_id);
+
+  // Gets the ids of the stored property names in `names` into `name_ids`.
+  // Names that have never been stored are skipped.
+  absl::Status SelectPropertyNameIds(absl::Span<const std::string> names,
+                                     std::vector<int64_t>* name_ids);
+
+  // Returns true if the property tables of the query schema version store the
+  // property names instead of their ids, i.e., the version is earlier than v12.
+  bool UsesPropertyNamesInPropertyTables() const {
+    return query_schema_version().has_value() &&
+           query_schema_version().value() < kSchemaVersionTwelve;
+  }
+
   MetadataSourceQueryConfig query_config_;
 
+  // The templates of `query_config_`, split into segments at construction.
+  CompiledTemplateQueryMap compiled_queries_;
+
+  // Reusable buffer the template queries are composed into before execution.
+  std::string query_buffer_;
+
   // This object does not own the MetadataSource.
   MetadataSource* metadata_source_;
 
+  // The ids of the property names that were read or interned via
+  // `metadata_source_`.
+  PropertyNameDictionary property_names_;
+
   // Delegate EncodeBytes to metadata_source_
   // Encodes value and returns the result as a string
   std::string EncodeBytes(absl::string_view value) const {
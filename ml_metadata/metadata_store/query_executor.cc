@@ -75,6 +75,19 @@ absl::Status QueryExecutor::CheckSchemaVersionAlignsWithQueryVersion() {
   return absl::OkStatus();
 }
 
+absl::Status QueryExecutor::CheckConditionalUpdate(
+    absl::string_view node_kind, int64_t id,
+    const UpdatePrecondition& precondition, const RecordSet& record_set) {
+  const int64_t num_updated_rows = record_set.has_num_affected_rows()
+                                       ? record_set.num_affected_rows()
+                                       : record_set.records_size();
+  if (num_updated_rows > 0) return absl::OkStatus();
+  return absl::FailedPreconditionError(absl::StrCat(
+      "The stored ", node_kind, " with id = ", id,
+      " does not satisfy the update precondition: ",
+      precondition.ShortDebugString()));
+}
+
 bool QueryExecutor::IsQuerySchemaVersionEquals(int64_t schema_version) const {
   return query_schema_version_ && *query_schema_version_ == schema_version;
 }
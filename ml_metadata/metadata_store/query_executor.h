@@ -47,6 +47,16 @@ namespace ml_metadata {
 // Some methods might add additional columns
 class QueryExecutor {
  public:
+  // The attribute columns that a conditional update of a node writes, as bits
+  // of `updated_columns`. The other attribute columns keep their stored
+  // values, so that the update cannot overwrite them with stale values.
+  enum UpdatedColumn : int {
+    kUriColumn = 1 << 0,
+    kStateColumn = 1 << 1,
+    kExternalIdColumn = 1 << 2,
+    kAllColumns = kUriColumn | kStateColumn | kExternalIdColumn,
+  };
+
   // By default, for any empty db, the head schema should be used to init new
   // db instances. Giving an optional `query_schema_version` allows the query
   // executor to work with an existing db with an earlier schema version other
@@ -278,6 +288,114 @@ class QueryExecutor {
   virtual absl::Status SelectParentTypesByTypeID(
       absl::Span<const int64_t> type_ids, RecordSet* record_set) = 0;
 
+  // Increases the type catalog version, and records it as the version in which
+  // the type with `type_id` is last created or changed. The row of the catalog
+  // version stays locked until the transaction ends, so concurrent type
+  // changes get their versions in commit order.
+  // Returns OK without recording a version, if the query schema version is
+  // earlier than the one that introduced the type catalog.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status UpdateTypeCatalogVersion(int64_t type_id) = 0;
+
+  // Gets the current type catalog version.
+  // Returns FAILED_PRECONDITION error, if the query schema version is earlier
+  // than the one that introduced the type catalog.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status SelectTypeCatalogVersion(int64_t* catalog_version) = 0;
+
+  // Gets the types created or changed after the type catalog version
+  // `catalog_version`. Each record has:
+  // Column 0: int: type_id
+  // Column 1: int: type_kind
+  // Returns FAILED_PRECONDITION error, if the query schema version is earlier
+  // than the one that introduced the type catalog.
+  virtual absl::Status SelectTypesChangedAfterCatalogVersion(
+      int64_t catalog_version, RecordSet* record_set) = 0;
+
+  // Increases the write epochs of the node kinds `type_kinds`. The rows of the
+  // epochs stay locked until the transaction ends, so concurrent writes of a
+  // node kind get their epochs in commit order.
+  // Returns OK without increasing the epochs, if the query schema version is
+  // earlier than the one that introduced the write epochs.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status IncreaseWriteEpochs(
+      absl::Span<const TypeKind> type_kinds) = 0;
+
+  // Gets the write epochs of all node kinds. Each record has:
+  // Column 0: int: type_kind
+  // Column 1: int: epoch
+  // Returns FAILED_PRECONDITION error, if the query schema version is earlier
+  // than the one that introduced the write epochs.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status SelectWriteEpochs(RecordSet* record_set) = 0;
+
+  // Adds `delta` to the context summary counters of the executions with
+  // `execution_ids`, in the summaries of all the contexts they are associated
+  // to. The executions are counted under their current type and
+  // last_known_state, so a state change is applied by removing the executions
+  // before the change and adding them back after it.
+  // Returns OK without changing the summaries, if the query schema version is
+  // earlier than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status UpdateContextSummariesByExecutions(
+      absl::Span<const int64_t> execution_ids, int64_t delta) = 0;
+
+  // Adds `delta` to the context summary counters of the artifacts with
+  // `artifact_ids`, in the summaries of all the contexts they are attributed
+  // to. The artifacts are counted under their current type and state.
+  // Returns OK without changing the summaries, if the query schema version is
+  // earlier than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status UpdateContextSummariesByArtifacts(
+      absl::Span<const int64_t> artifact_ids, int64_t delta) = 0;
+
+  // Counts the execution `execution_id` in the summary of the context
+  // `context_id`, after an association between them is inserted.
+  // Returns OK without changing the summaries, if the query schema version is
+  // earlier than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status IncreaseContextSummaryByAssociation(
+      int64_t context_id, int64_t execution_id) = 0;
+
+  // Counts the artifact `artifact_id` in the summary of the context
+  // `context_id`, after an attribution between them is inserted.
+  // Returns OK without changing the summaries, if the query schema version is
+  // earlier than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status IncreaseContextSummaryByAttribution(
+      int64_t context_id, int64_t artifact_id) = 0;
+
+  // Recomputes the summaries of the contexts with `context_ids` from their
+  // associations and attributions.
+  // Returns OK without changing the summaries, if the query schema version is
+  // earlier than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status RefreshContextSummaries(
+      absl::Span<const int64_t> context_ids) = 0;
+
+  // Recomputes the summaries of the contexts with `context_ids`, or of all
+  // contexts if `context_ids` is empty, from the associations and
+  // attributions.
+  // Returns FAILED_PRECONDITION error, if the query schema version is earlier
+  // than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status RebuildContextSummaries(
+      absl::Span<const int64_t> context_ids) = 0;
+
+  // Gets the non-zero context summary counters of the contexts with
+  // `context_ids`, ordered by context_id. Each record has:
+  // Column 0: int: context_id
+  // Column 1: int: type_kind, i.e., executions or artifacts
+  // Column 2: int: type_id
+  // Column 3: int: state, i.e., last_known_state of executions, or state of
+  //                artifacts
+  // Column 4: int: num_nodes
+  // Returns FAILED_PRECONDITION error, if the query schema version is earlier
+  // than the one that introduced the context summaries.
+  // Returns detailed INTERNAL error, if query execution fails.
+  virtual absl::Status SelectContextSummaries(
+      absl::Span<const int64_t> context_ids, RecordSet* record_set) = 0;
+
   // Checks the existence of the Artifact table.
   virtual absl::Status CheckArtifactTable() = 0;
 
@@ -306,6 +424,18 @@ class QueryExecutor {
   virtual absl::Status SelectArtifactsByID(absl::Span<const int64_t> ids,
                                            RecordSet* record_set) = 0;
 
+  // Gets the last update times of the artifacts with `ids`, without reading
+  // their properties. Not found ids are skipped. Each record has:
+  // Column 0: int: id
+  // Column 1: int: last update time (since epoch)
+  virtual absl::Status SelectArtifactLastUpdateTimesByID(
+      absl::Span<const int64_t> ids, RecordSet* record_set) = 0;
+
+  // Gets at most `limit` of the artifact `ids`, the most recently created
+  // first and then by ascending id. Each record has the artifact id.
+  virtual absl::Status SelectArtifactIDsByRecency(
+      absl::Span<const int64_t> ids, int64_t limit, RecordSet* record_set) = 0;
+
   // Gets artifacts from the database by their external_ids. Not found
   // external_ids are skipped.
   virtual absl::Status SelectArtifactsByExternalIds(
@@ -317,6 +447,12 @@ class QueryExecutor {
       int64_t artifact_type_id, absl::string_view name,
       RecordSet* record_set) = 0;
 
+  // Gets artifacts from the Artifact table by their type_id and names.
+  // Returns a list of artifact IDs.
+  virtual absl::Status SelectArtifactsByTypeIDAndArtifactNames(
+      int64_t artifact_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) = 0;
+
   // Gets artifacts from the Artifact table by their type_id.
   // Returns a list of artifact IDs.
   virtual absl::Status SelectArtifactsByTypeID(int64_t artifact_type_id,
@@ -327,16 +463,35 @@ class QueryExecutor {
   virtual absl::Status SelectArtifactsByURI(absl::string_view uri,
                                             RecordSet* record_set) = 0;
 
+  // Gets artifacts from the Artifact table by their uris.
+  // Returns a list of artifact IDs.
+  virtual absl::Status SelectArtifactsByURIs(absl::Span<absl::string_view> uris,
+                                             RecordSet* record_set) = 0;
+
   // Updates an artifact in the database.
+  // If `precondition` is not empty, the artifact is updated only if the stored
+  // one satisfies it, and only the `updated_columns` are written.
+  // Returns FAILED_PRECONDITION error, if the stored artifact does not satisfy
+  // the `precondition`.
   virtual absl::Status UpdateArtifactDirect(
       int64_t artifact_id, int64_t type_id, const std::string& uri,
       const std::optional<Artifact::State>& state,
-      std::optional<absl::string_view> external_id, absl::Time update_time) = 0;
+      std::optional<absl::string_view> external_id, absl::Time update_time,
+      const UpdatePrecondition& precondition, int updated_columns) = 0;
+
+  // Sets the last_update_time_since_epoch of the artifacts with `artifact_ids`
+  // to `update_time`, without reading nor changing their other fields.
+  virtual absl::Status UpdateArtifactLastUpdateTime(
+      absl::Span<const int64_t> artifact_ids, absl::Time update_time) = 0;
+
+  // Checks the existence of the PropertyName table.
+  virtual absl::Status CheckPropertyNameTable() = 0;
 
   // Checks the existence of the ArtifactProperty table.
   virtual absl::Status CheckArtifactPropertyTable() = 0;
 
   // Insert a property of an artifact into the database.
+  // The property name is added to the PropertyName table if it is new.
   virtual absl::Status InsertArtifactProperty(
       int64_t artifact_id, absl::string_view artifact_property_name,
       bool is_custom_property, const Value& property_value) = 0;
@@ -352,9 +507,26 @@ class QueryExecutor {
                                               absl::string_view property_name,
                                               const Value& property_value) = 0;
 
-  // Deletes a property of an artifact.
-  virtual absl::Status DeleteArtifactProperty(
-      int64_t artifact_id, absl::string_view property_name) = 0;
+  // Deletes a property of an artifact. Only the property in the space given
+  // by `is_custom_property` is deleted, so a property and a custom property
+  // can share a name.
+  virtual absl::Status DeleteArtifactProperty(int64_t artifact_id,
+                                              absl::string_view property_name,
+                                              bool is_custom_property) = 0;
+
+  // Inserts a property with the same `value` to each of the artifacts with
+  // `artifact_ids` in one statement. The property name is added to the
+  // PropertyName table if it is new.
+  virtual absl::Status InsertArtifactsProperty(
+      absl::Span<const int64_t> artifact_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) = 0;
+
+  // Deletes the properties with `names` in the space given by
+  // `is_custom_property` of the artifacts with `artifact_ids` in one
+  // statement.
+  virtual absl::Status DeleteArtifactsProperties(
+      absl::Span<const int64_t> artifact_ids,
+      absl::Span<const std::string> names, bool is_custom_property) = 0;
 
   // Checks the existence of the Execution table.
   virtual absl::Status CheckExecutionTable() = 0;
@@ -382,6 +554,19 @@ class QueryExecutor {
   virtual absl::Status SelectExecutionsByID(
       absl::Span<const int64_t> execution_ids, RecordSet* record_set) = 0;
 
+  // Gets the last update times of the executions with `execution_ids`,
+  // without reading their properties. Not found ids are skipped. Each record
+  // has:
+  // Column 0: int: id
+  // Column 1: int: last update time (since epoch)
+  virtual absl::Status SelectExecutionLastUpdateTimesByID(
+      absl::Span<const int64_t> execution_ids, RecordSet* record_set) = 0;
+
+  // Gets at most `limit` of the execution `ids`, the most recently created
+  // first and then by ascending id. Each record has the execution id.
+  virtual absl::Status SelectExecutionIDsByRecency(
+      absl::Span<const int64_t> ids, int64_t limit, RecordSet* record_set) = 0;
+
   // Gets executions based on the given external_ids. Not found
   // external_ids are skipped.
   virtual absl::Status SelectExecutionsByExternalIds(
@@ -392,20 +577,59 @@ class QueryExecutor {
       int64_t execution_type_id, absl::string_view name,
       RecordSet* record_set) = 0;
 
+  // Gets executions from the database by their type_id and names.
+  virtual absl::Status SelectExecutionsByTypeIDAndExecutionNames(
+      int64_t execution_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) = 0;
+
   // Gets an execution from the database by its type_id.
   virtual absl::Status SelectExecutionsByTypeID(int64_t execution_type_id,
                                                 RecordSet* record_set) = 0;
 
   // Updates an execution in the database.
+  // If `precondition` is not empty, the execution is updated only if the
+  // stored one satisfies it, and only the `updated_columns` are written.
+  // Returns FAILED_PRECONDITION error, if the stored execution does not satisfy
+  // the `precondition`.
   virtual absl::Status UpdateExecutionDirect(
       int64_t execution_id, int64_t type_id,
       const std::optional<Execution::State>& last_known_state,
-      std::optional<absl::string_view> external_id, absl::Time update_time) = 0;
+      std::optional<absl::string_view> external_id, absl::Time update_time,
+      const UpdatePrecondition& precondition, int updated_columns) = 0;
+
+  // Sets the last_update_time_since_epoch of the executions with
+  // `execution_ids` to `update_time`, without reading nor changing their other
+  // fields.
+  virtual absl::Status UpdateExecutionLastUpdateTime(
+      absl::Span<const int64_t> execution_ids, absl::Time update_time) = 0;
+
+  // Takes the write lock of the database before executions are claimed, on
+  // metadata sources that cannot lock the claimed rows, e.g., SQLite. It is a
+  // no-op on the others. It must be the first query of the transaction, so
+  // that a concurrent claim waits for the lock instead of failing to upgrade
+  // its read lock.
+  virtual absl::Status LockExecutionTableForClaim() = 0;
+
+  // Gets the ids of up to `max_num_executions` executions of type `type_id`
+  // whose last_known_state is `state`, ordered by id. Their rows stay locked
+  // until the transaction ends, and rows locked by concurrent transactions are
+  // skipped where the metadata source supports it.
+  virtual absl::Status SelectExecutionIdsForClaim(int64_t type_id,
+                                                  Execution::State state,
+                                                  int64_t max_num_executions,
+                                                  RecordSet* record_set) = 0;
+
+  // Sets the last_known_state of the executions with `execution_ids` to
+  // `state`, and their last_update_time_since_epoch to `update_time`.
+  virtual absl::Status UpdateExecutionsState(
+      absl::Span<const int64_t> execution_ids, Execution::State state,
+      absl::Time update_time) = 0;
 
   // Checks the existence of the ExecutionProperty table.
   virtual absl::Status CheckExecutionPropertyTable() = 0;
 
   // Insert a property of an execution from the database.
+  // The property name is added to the PropertyName table if it is new.
   virtual absl::Status InsertExecutionProperty(int64_t execution_id,
                                                absl::string_view name,
                                                bool is_custom_property,
@@ -422,9 +646,25 @@ class QueryExecutor {
                                                absl::string_view name,
                                                const Value& value) = 0;
 
-  // Deletes a property of an execution.
+  // Deletes a property of an execution in the space given by
+  // `is_custom_property`.
   virtual absl::Status DeleteExecutionProperty(int64_t execution_id,
-                                               absl::string_view name) = 0;
+                                               absl::string_view name,
+                                               bool is_custom_property) = 0;
+
+  // Inserts a property with the same `value` to each of the executions with
+  // `execution_ids` in one statement. The property name is added to the
+  // PropertyName table if it is new.
+  virtual absl::Status InsertExecutionsProperty(
+      absl::Span<const int64_t> execution_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) = 0;
+
+  // Deletes the properties with `names` in the space given by
+  // `is_custom_property` of the executions with `execution_ids` in one
+  // statement.
+  virtual absl::Status DeleteExecutionsProperties(
+      absl::Span<const int64_t> execution_ids,
+      absl::Span<const std::string> names, bool is_custom_property) = 0;
 
   // Checks the existence of the Context table.
   virtual absl::Status CheckContextTable() = 0;
@@ -450,6 +690,13 @@ class QueryExecutor {
   virtual absl::Status SelectContextsByID(absl::Span<const int64_t> context_ids,
                                           RecordSet* record_set) = 0;
 
+  // Gets the last update times of the contexts with `context_ids`, without
+  // reading their properties. Not found ids are skipped. Each record has:
+  // Column 0: int: id
+  // Column 1: int: last update time (since epoch)
+  virtual absl::Status SelectContextLastUpdateTimesByID(
+      absl::Span<const int64_t> context_ids, RecordSet* record_set) = 0;
+
   // Gets contexts from the database by their external_ids. Not found
   // external_ids are skipped.
   virtual absl::Status SelectContextsByExternalIds(
@@ -464,6 +711,11 @@ class QueryExecutor {
       int64_t context_type_id, absl::string_view name,
       RecordSet* record_set) = 0;
 
+  // Gets contexts from the Context table by their type_id and names.
+  virtual absl::Status SelectContextsByTypeIDAndContextNames(
+      int64_t context_type_id, absl::Span<absl::string_view> names,
+      RecordSet* record_set) = 0;
+
   // Updates a context in the Context table.
   virtual absl::Status UpdateContextDirect(
       int64_t existing_context_id, int64_t type_id,
@@ -471,10 +723,16 @@ class QueryExecutor {
       std::optional<absl::string_view> external_id,
       const absl::Time update_time) = 0;
 
+  // Sets the last_update_time_since_epoch of the contexts with `context_ids`
+  // to `update_time`, without reading nor changing their other fields.
+  virtual absl::Status UpdateContextLastUpdateTime(
+      absl::Span<const int64_t> context_ids, absl::Time update_time) = 0;
+
   // Checks the existence of the ContextProperty table.
   virtual absl::Status CheckContextPropertyTable() = 0;
 
   // Insert a property of a context into the database.
+  // The property name is added to the PropertyName table if it is new.
   virtual absl::Status InsertContextProperty(int64_t context_id,
                                              absl::string_view name,
                                              bool custom_property,
@@ -490,9 +748,25 @@ class QueryExecutor {
                                              absl::string_view property_name,
                                              const Value& property_value) = 0;
 
-  // Deletes a property of a context.
-  virtual absl::Status DeleteContextProperty(
-      const int64_t context_id, absl::string_view property_name) = 0;
+  // Deletes a property of a context in the space given by
+  // `is_custom_property`.
+  virtual absl::Status DeleteContextProperty(const int64_t context_id,
+                                             absl::string_view property_name,
+                                             bool is_custom_property) = 0;
+
+  // Inserts a property with the same `value` to each of the contexts with
+  // `context_ids` in one statement. The property name is added to the
+  // PropertyName table if it is new.
+  virtual absl::Status InsertContextsProperty(
+      absl::Span<const int64_t> context_ids, absl::string_view name,
+      bool is_custom_property, const Value& value) = 0;
+
+  // Deletes the properties with `names` in the space given by
+  // `is_custom_property` of the contexts with `context_ids` in one
+  // statement.
+  virtual absl::Status DeleteContextsProperties(
+      absl::Span<const int64_t> context_ids,
+      absl::Span<const std::string> names, bool is_custom_property) = 0;
 
   // Checks the existence of the Event table.
   virtual absl::Status CheckEventTable() = 0;
@@ -511,6 +785,38 @@ class QueryExecutor {
   virtual absl::Status SelectEventByExecutionIDs(
       absl::Span<const int64_t> execution_ids, RecordSet* event_record_set) = 0;
 
+  // Gets the events from the Event table of a collection of artifact ids,
+  // whose milliseconds_since_epoch is in [event_start_time_milliseconds,
+  // event_end_time_milliseconds), and whose execution is created in
+  // [node_start_time_milliseconds, node_end_time_milliseconds) and, if
+  // `execution_states` is not empty, is in one of `execution_states`.
+  // Only returns the events of at most `limit` such executions after skipping
+  // `offset` ones, the most recently created first and then by ascending id,
+  // in that order.
+  virtual absl::Status SelectLineageEventByArtifactIDs(
+      absl::Span<const int64_t> artifact_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds,
+      absl::Span<const int> execution_states, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) = 0;
+
+  // Gets the events from the Event table of a collection of execution ids,
+  // whose milliseconds_since_epoch is in [event_start_time_milliseconds,
+  // event_end_time_milliseconds), and whose artifact is created in
+  // [node_start_time_milliseconds, node_end_time_milliseconds).
+  // Only returns the events of at most `limit` such artifacts after skipping
+  // `offset` ones, the most recently created first and then by ascending id,
+  // in that order.
+  virtual absl::Status SelectLineageEventByExecutionIDs(
+      absl::Span<const int64_t> execution_ids,
+      int64_t event_start_time_milliseconds,
+      int64_t event_end_time_milliseconds,
+      int64_t node_start_time_milliseconds,
+      int64_t node_end_time_milliseconds, int64_t limit, int64_t offset,
+      RecordSet* event_record_set) = 0;
+
   // Checks the existence of the EventPath table.
   virtual absl::Status CheckEventPathTable() = 0;
 
@@ -744,6 +1050,14 @@ class QueryExecutor {
   //   with a schema_version != query_schema_version_.
   absl::Status CheckSchemaVersionAlignsWithQueryVersion();
 
+  // Checks the `record_set` of a conditional update of the `node_kind` with
+  // `id`, which has either the number of affected rows or the updated ids.
+  // Returns FAILED_PRECONDITION error, if no row is updated, i.e., the stored
+  // node does not satisfy the `precondition`.
+  static absl::Status CheckConditionalUpdate(
+      absl::string_view node_kind, int64_t id,
+      const UpdatePrecondition& precondition, const RecordSet& record_set);
+
   // Uses the method to document the query branches for earlier schema for
   // ease of cleanup after the temporary branches after the migration.
   // Returns true if |query_schema_version_| = `schema_version`.
@@ -1013,6 +1013,42 @@ TEST_P(QueryExecutorTest, SelectArtifacts) {
   }
 }
 
+TEST_P(QueryExecutorTest, UpdateArtifactWithPreconditionWritesUpdatedColumns) {
+  ASSERT_EQ(absl::OkStatus(), Init());
+  int64_t type_id;
+  MLMD_ASSERT_OK(query_executor_->InsertArtifactType(
+      /*name=*/"test_type", /*version=*/absl::nullopt,
+      /*description=*/absl::nullopt, /*external_id=*/absl::nullopt, &type_id));
+  const absl::Time create_time = absl::Now();
+  int64_t artifact_id;
+  MLMD_ASSERT_OK(query_executor_->InsertArtifact(
+      type_id, /*artifact_uri=*/"stored_uri", Artifact::PENDING,
+      /*name=*/"artifact", /*external_id=*/"stored_external_id", create_time,
+      create_time, &artifact_id));
+  ASSERT_EQ(absl::OkStatus(), AddCommitPointIfNeeded());
+
+  // Only the state is written, although the update carries other values.
+  UpdatePrecondition precondition;
+  precondition.add_states(Artifact::PENDING);
+  MLMD_ASSERT_OK(query_executor_->UpdateArtifactDirect(
+      artifact_id, type_id, /*uri=*/"stale_uri", Artifact::LIVE,
+      /*external_id=*/"stale_external_id", create_time + absl::Seconds(1),
+      precondition, QueryExecutor::kStateColumn));
+  RecordSet record_set;
+  MLMD_ASSERT_OK(
+      query_executor_->SelectArtifactsByID({artifact_id}, &record_set));
+  ASSERT_THAT(record_set.records(), SizeIs(1));
+  EXPECT_EQ(record_set.records(0).values(2), "stored_uri");
+  EXPECT_EQ(record_set.records(0).values(3), absl::StrCat(Artifact::LIVE));
+  EXPECT_EQ(record_set.records(0).values(5), "stored_external_id");
+
+  // The artifact is no longer PENDING.
+  EXPECT_TRUE(absl::IsFailedPrecondition(query_executor_->UpdateArtifactDirect(
+      artifact_id, type_id, /*uri=*/"stored_uri", Artifact::DELETED,
+      /*external_id=*/"stored_external_id", create_time + absl::Seconds(2),
+      precondition, QueryExecutor::kAllColumns)));
+}
+
 TEST_P(QueryExecutorTest, SelectContexts) {
   ASSERT_EQ(absl::OkStatus(), Init());
   // Setup: insert context type
@@ -54,6 +54,7 @@ limitations under the License.
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/simple_types/simple_types_constants.h"
 #include "ml_metadata/util/field_mask_utils.h"
+#include "ml_metadata/util/id_bitmap.h"
 #include "ml_metadata/util/record_parsing_utils.h"
 #include "ml_metadata/util/return_utils.h"
 #include "ml_metadata/util/struct_utils.h"
@@ -88,6 +89,19 @@ std::vector<int64_t> ConvertToIds(const RecordSet& record_set,
   return result;
 }
 
+// Converts a record set of (id, last_update_time_since_epoch) records to a
+// map from id to last_update_time_since_epoch.
+void ConvertRecordSetToLastUpdateTimes(
+    const RecordSet& record_set,
+    absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+  for (const RecordSet::Record& record : record_set.records()) {
+    int64_t id, last_update_time;
+    CHECK(absl::SimpleAtoi(record.values(0), &id));
+    CHECK(absl::SimpleAtoi(record.values(1), &last_update_time));
+    last_update_times[id] = last_update_time;
+  }
+}
+
 // Dedups an id list.
 std::vector<int64_t> DedupIds(absl::Span<const int64_t> ids) {
   std::vector<int64_t> result;
@@ -96,6 +110,17 @@ std::vector<int64_t> DedupIds(absl::Span<const int64_t> ids) {
   return result;
 }
 
+// Returns the keys of `properties`.
+std::vector<std::string> GetPropertyNames(
+    const google::protobuf::Map<std::string, Value>& properties) {
+  std::vector<std::string> names;
+  names.reserve(properties.size());
+  for (const auto& [name, value] : properties) {
+    names.push_back(name);
+  }
+  return names;
+}
+
 // Extracts 2 vectors of ids and corresponding parent ids from parent_{}
 // records.
 void ConvertToIdAndParentIds(const RecordSet& record_set,
@@ -464,6 +489,33 @@ absl::Status CheckCyClicDependency(int64_t child_id, int64_t parent_id,
   return absl::OkStatus();
 }
 
+// Returns the inclusive start and the exclusive end of `time_window`. An unset
+// bound is unbounded.
+std::pair<int64_t, int64_t> GetTimeWindowBounds(
+    const LineageSubgraphQueryOptions::TimeWindow& time_window) {
+  return {time_window.has_start_time_since_epoch()
+              ? time_window.start_time_since_epoch()
+              : std::numeric_limits<int64_t>::min(),
+          time_window.has_end_time_since_epoch()
+              ? time_window.end_time_since_epoch()
+              : std::numeric_limits<int64_t>::max()};
+}
+
+// Returns INVALID_ARGUMENT error, if both bounds of `time_window` are set and
+// the window is empty.
+absl::Status ValidateTimeWindow(
+    absl::string_view name,
+    const LineageSubgraphQueryOptions::TimeWindow& time_window) {
+  if (time_window.has_start_time_since_epoch() &&
+      time_window.has_end_time_since_epoch() &&
+      time_window.start_time_since_epoch() >=
+          time_window.end_time_since_epoch()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        name, " must end after it starts: ", time_window.DebugString()));
+  }
+  return absl::OkStatus();
+}
+
 std::vector<Event> FilterEventsByDirectionAndEventType(
     absl::Span<const Event> events, const bool is_from_artifact,
     LineageSubgraphQueryOptions::Direction direction) {
@@ -517,6 +569,48 @@ std::vector<Event> FilterEventsByDirectionAndEventType(
   }
   return filtered_events;
 }
+
+// Returns the state a node is counted under in the context summaries. Nodes
+// without a state are counted as UNKNOWN, i.e., 0.
+int GetContextSummaryState(const Artifact& artifact) {
+  return artifact.state();
+}
+
+int GetContextSummaryState(const Execution& execution) {
+  return execution.last_known_state();
+}
+
+int GetContextSummaryState(const Context& context) { return 0; }
+
+// Removes the simple types from `types`, as they are invisible to users.
+template <typename Type>
+void RemoveSimpleTypes(std::vector<Type>& types) {
+  types.erase(std::remove_if(types.begin(), types.end(),
+                             [](const Type& type) {
+                               return std::find(kSimpleTypeNames.begin(),
+                                                kSimpleTypeNames.end(),
+                                                type.name()) !=
+                                      kSimpleTypeNames.end();
+                             }),
+              types.end());
+}
+
+// Returns the QueryExecutor::UpdatedColumn bits of the attributes in
+// `fields_mask`, which has no property paths.
+int GetUpdatedColumns(const google::protobuf::FieldMask& fields_mask) {
+  int updated_columns = 0;
+  for (const std::string& path : fields_mask.paths()) {
+    if (path == "uri") {
+      updated_columns |= QueryExecutor::kUriColumn;
+    } else if (path == "state" || path == "last_known_state") {
+      updated_columns |= QueryExecutor::kStateColumn;
+    } else if (path == "external_id") {
+      updated_columns |= QueryExecutor::kExternalIdColumn;
+    }
+  }
+  return updated_columns;
+}
+
 }  // namespace
 
 
@@ -569,7 +663,7 @@ template <>
 absl::Status RDBMSMetadataAccessObject::RetrieveNodesById<Context>(
     absl::Span<const int64_t> ids, RecordSet* header, RecordSet* properties) {
   MLMD_RETURN_IF_ERROR(executor_->SelectContextsByID(ids, header));
-  if (!header->records().empty()) {
+  if (properties != nullptr && !header->records().empty()) {
     MLMD_RETURN_IF_ERROR(
         executor_->SelectContextPropertyByContextID(ids, properties));
   }
@@ -580,7 +674,7 @@ template <>
 absl::Status RDBMSMetadataAccessObject::RetrieveNodesById<Artifact>(
     absl::Span<const int64_t> ids, RecordSet* header, RecordSet* properties) {
   MLMD_RETURN_IF_ERROR(executor_->SelectArtifactsByID(ids, header));
-  if (!header->records().empty()) {
+  if (properties != nullptr && !header->records().empty()) {
     MLMD_RETURN_IF_ERROR(
         executor_->SelectArtifactPropertyByArtifactID(ids, properties));
   }
@@ -591,50 +685,111 @@ template <>
 absl::Status RDBMSMetadataAccessObject::RetrieveNodesById<Execution>(
     absl::Span<const int64_t> ids, RecordSet* header, RecordSet* properties) {
   MLMD_RETURN_IF_ERROR(executor_->SelectExecutionsByID(ids, header));
-  if (!header->records().empty()) {
+  if (properties != nullptr && !header->records().empty()) {
     MLMD_RETURN_IF_ERROR(
         executor_->SelectExecutionPropertyByExecutionID(ids, properties));
   }
   return absl::OkStatus();
 }
 
+template <>
+absl::Status RDBMSMetadataAccessObject::RunNodesLastUpdateTimeUpdate<Artifact>(
+    absl::Span<const int64_t> ids, const absl::Time update_timestamp) {
+  return executor_->UpdateArtifactLastUpdateTime(ids, update_timestamp);
+}
+
+template <>
+absl::Status RDBMSMetadataAccessObject::RunNodesLastUpdateTimeUpdate<Execution>(
+    absl::Span<const int64_t> ids, const absl::Time update_timestamp) {
+  return executor_->UpdateExecutionLastUpdateTime(ids, update_timestamp);
+}
+
+template <>
+absl::Status RDBMSMetadataAccessObject::RunNodesLastUpdateTimeUpdate<Context>(
+    absl::Span<const int64_t> ids, const absl::Time update_timestamp) {
+  return executor_->UpdateContextLastUpdateTime(ids, update_timestamp);
+}
+
+template <>
+absl::Status RDBMSMetadataAccessObject::UpdateContextSummaries<Artifact>(
+    absl::Span<const int64_t> ids, const int64_t delta) {
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->UpdateContextSummariesByArtifacts(ids, delta);
+}
+
+template <>
+absl::Status RDBMSMetadataAccessObject::UpdateContextSummaries<Execution>(
+    absl::Span<const int64_t> ids, const int64_t delta) {
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->UpdateContextSummariesByExecutions(ids, delta);
+}
+
+template <>
+absl::Status RDBMSMetadataAccessObject::UpdateContextSummaries<Context>(
+    absl::Span<const int64_t> ids, const int64_t delta) {
+  return absl::OkStatus();
+}
+
 // Update a Node's assets based on the field mask.
 // If `mask` is empty, update `stored_node` as a whole.
 // If `mask` is not empty, only update fields specified in `mask`.
+// If the update changes the node's state, the node is moved to its new state
+// in the summaries of its contexts.
 template <typename Node>
 absl::Status RDBMSMetadataAccessObject::RunMaskedNodeUpdate(
     const Node& node, Node& stored_node, absl::Time update_timestamp,
-    const google::protobuf::FieldMask& mask) {
+    const google::protobuf::FieldMask& mask,
+    const UpdatePrecondition& precondition) {
+  const int stored_state = GetContextSummaryState(stored_node);
+  const Node* updated_node = &node;
+  int updated_columns = QueryExecutor::kAllColumns;
   if (!mask.paths().empty()) {
     absl::StatusOr<google::protobuf::FieldMask> fields_mask_or =
         GetFieldsSubMaskFromMask(mask, node.GetDescriptor());
     MLMD_RETURN_IF_ERROR(fields_mask_or.status());
+    updated_columns = GetUpdatedColumns(fields_mask_or.value());
     // seperate fields_mask from mask
     google::protobuf::util::FieldMaskUtil::MergeOptions merge_options;
     google::protobuf::util::FieldMaskUtil::MergeMessageTo(node, fields_mask_or.value(),
                                                 merge_options, &stored_node);
-    MLMD_RETURN_IF_ERROR(RunNodeUpdate(stored_node, update_timestamp));
-  } else {
-    MLMD_RETURN_IF_ERROR(RunNodeUpdate(node, update_timestamp));
+    updated_node = &stored_node;
+  }
+  const bool changes_state =
+      GetContextSummaryState(*updated_node) != stored_state;
+  if (changes_state) {
+    MLMD_RETURN_IF_ERROR(
+        UpdateContextSummaries<Node>({node.id()}, /*delta=*/-1));
+  }
+  MLMD_RETURN_IF_ERROR(RunNodeUpdate(*updated_node, update_timestamp,
+                                     precondition, updated_columns));
+  if (changes_state) {
+    MLMD_RETURN_IF_ERROR(
+        UpdateContextSummaries<Node>({node.id()}, /*delta=*/1));
   }
   return absl::OkStatus();
 }
 
 // Update an Artifact's type_id, URI, external_id and last_update_time.
 absl::Status RDBMSMetadataAccessObject::RunNodeUpdate(
-    const Artifact& artifact, const absl::Time update_timestamp) {
+    const Artifact& artifact, const absl::Time update_timestamp,
+    const UpdatePrecondition& precondition, const int updated_columns) {
   return executor_->UpdateArtifactDirect(
       artifact.id(), artifact.type_id(), artifact.uri(),
       artifact.has_state() ? absl::make_optional(artifact.state())
                            : absl::nullopt,
       artifact.has_external_id() ? absl::make_optional(artifact.external_id())
                                  : absl::nullopt,
-      update_timestamp);
+      update_timestamp, precondition, updated_columns);
 }
 
 // Update an Execution's type_id, external_id and last_update_time.
 absl::Status RDBMSMetadataAccessObject::RunNodeUpdate(
-    const Execution& execution, const absl::Time update_timestamp) {
+    const Execution& execution, const absl::Time update_timestamp,
+    const UpdatePrecondition& precondition, const int updated_columns) {
   return executor_->UpdateExecutionDirect(
       execution.id(), execution.type_id(),
       execution.has_last_known_state()
@@ -642,12 +797,17 @@ absl::Status RDBMSMetadataAccessObject::RunNodeUpdate(
           : absl::nullopt,
       execution.has_external_id() ? absl::make_optional(execution.external_id())
                                   : absl::nullopt,
-      update_timestamp);
+      update_timestamp, precondition, updated_columns);
 }
 
 // Update a Context's type id, external_id and name.
 absl::Status RDBMSMetadataAccessObject::RunNodeUpdate(
-    const Context& context, const absl::Time update_timestamp) {
+    const Context& context, const absl::Time update_timestamp,
+    const UpdatePrecondition& precondition, const int updated_columns) {
+  if (precondition.ByteSizeLong() > 0) {
+    return absl::UnimplementedError(
+        "Update preconditions are not supported for contexts.");
+  }
   if (!context.has_name() || context.name().empty()) {
     return absl::InvalidArgumentError("Context name should not be empty");
   }
@@ -706,17 +866,65 @@ absl::Status RDBMSMetadataAccessObject::UpdateProperty(const int64_t node_id,
 
 // Generates a property deletion query for a NodeType.
 template <typename NodeType>
-absl::Status RDBMSMetadataAccessObject::DeleteProperty(const int64_t node_id,
-                                                       absl::string_view name) {
+absl::Status RDBMSMetadataAccessObject::DeleteProperty(
+    const int64_t node_id, absl::string_view name,
+    const bool is_custom_property) {
+  NodeType type;
+  const TypeKind type_kind = ResolveTypeKind(&type);
+  switch (type_kind) {
+    case TypeKind::ARTIFACT_TYPE:
+      return executor_->DeleteArtifactProperty(node_id, name,
+                                               is_custom_property);
+    case TypeKind::EXECUTION_TYPE:
+      return executor_->DeleteExecutionProperty(node_id, name,
+                                                is_custom_property);
+    case TypeKind::CONTEXT_TYPE:
+      return executor_->DeleteContextProperty(node_id, name,
+                                              is_custom_property);
+    default:
+      return absl::InternalError("Unsupported TypeKind.");
+  }
+}
+
+// Runs a property insertion query for all the given nodes of a NodeType.
+template <typename NodeType>
+absl::Status RDBMSMetadataAccessObject::InsertNodesProperty(
+    absl::Span<const int64_t> node_ids, absl::string_view name,
+    const bool is_custom_property, const Value& value) {
+  NodeType type;
+  const TypeKind type_kind = ResolveTypeKind(&type);
+  switch (type_kind) {
+    case TypeKind::ARTIFACT_TYPE:
+      return executor_->InsertArtifactsProperty(node_ids, name,
+                                                is_custom_property, value);
+    case TypeKind::EXECUTION_TYPE:
+      return executor_->InsertExecutionsProperty(node_ids, name,
+                                                 is_custom_property, value);
+    case TypeKind::CONTEXT_TYPE:
+      return executor_->InsertContextsProperty(node_ids, name,
+                                               is_custom_property, value);
+    default:
+      return absl::InternalError("Unsupported TypeKind.");
+  }
+}
+
+// Runs a property deletion query for all the given nodes of a NodeType.
+template <typename NodeType>
+absl::Status RDBMSMetadataAccessObject::DeleteNodesProperties(
+    absl::Span<const int64_t> node_ids, absl::Span<const std::string> names,
+    const bool is_custom_property) {
   NodeType type;
   const TypeKind type_kind = ResolveTypeKind(&type);
   switch (type_kind) {
     case TypeKind::ARTIFACT_TYPE:
-      return executor_->DeleteArtifactProperty(node_id, name);
+      return executor_->DeleteArtifactsProperties(node_ids, names,
+                                                  is_custom_property);
     case TypeKind::EXECUTION_TYPE:
-      return executor_->DeleteExecutionProperty(node_id, name);
+      return executor_->DeleteExecutionsProperties(node_ids, names,
+                                                   is_custom_property);
     case TypeKind::CONTEXT_TYPE:
-      return executor_->DeleteContextProperty(node_id, name);
+      return executor_->DeleteContextsProperties(node_ids, names,
+                                                 is_custom_property);
     default:
       return absl::InternalError("Unsupported TypeKind.");
   }
@@ -762,7 +970,8 @@ absl::StatusOr<int64_t> RDBMSMetadataAccessObject::ModifyProperties(
     if (name_in_previous_properties) {
       if (!name_in_current_properties) {
         // Generate delete clauses for properties in P \ C
-        MLMD_RETURN_IF_ERROR(DeleteProperty<NodeType>(node_id, name));
+        MLMD_RETURN_IF_ERROR(
+            DeleteProperty<NodeType>(node_id, name, is_custom_property));
         output_num_changed_properties++;
       } else {
         // Generate update clauses for properties in the intersection P & C only
@@ -771,7 +980,8 @@ absl::StatusOr<int64_t> RDBMSMetadataAccessObject::ModifyProperties(
                 prev_properties.at(name.data()),
                 curr_properties.at(name.data()))) {
           if (is_custom_property) {
-            MLMD_RETURN_IF_ERROR(DeleteProperty<NodeType>(node_id, name));
+            MLMD_RETURN_IF_ERROR(
+                DeleteProperty<NodeType>(node_id, name, is_custom_property));
             MLMD_RETURN_IF_ERROR(
                 InsertProperty<NodeType>(node_id, name, is_custom_property,
                                          curr_properties.at(name.data())));
@@ -867,7 +1077,7 @@ absl::Status RDBMSMetadataAccessObject::CreateTypeImpl(const Type& type,
     MLMD_RETURN_IF_ERROR(
         executor_->InsertTypeProperty(*type_id, property_name, property_type));
   }
-  return absl::OkStatus();
+  return executor_->UpdateTypeCatalogVersion(*type_id);
 }
 
 // Generates a query to find all type instances.
@@ -1071,6 +1281,7 @@ absl::Status RDBMSMetadataAccessObject::UpdateTypeImpl(const Type& type) {
   // update the list of type properties
   const google::protobuf::Map<std::string, PropertyType>& stored_properties =
       stored_type.properties();
+  bool is_type_changed = false;
   for (const auto& p : type.properties()) {
     const std::string& property_name = p.first;
     const PropertyType property_type = p.second;
@@ -1090,12 +1301,17 @@ absl::Status RDBMSMetadataAccessObject::UpdateTypeImpl(const Type& type) {
     }
     MLMD_RETURN_IF_ERROR(executor_->InsertTypeProperty(
         stored_type.id(), property_name, property_type));
+    is_type_changed = true;
   }
 
   // Update the external_id.
   if (type.has_id() && type.has_external_id()) {
     MLMD_RETURN_IF_ERROR(
         executor_->UpdateTypeExternalIdDirect(type.id(), type.external_id()));
+    is_type_changed |= type.external_id() != stored_type.external_id();
+  }
+  if (is_type_changed) {
+    MLMD_RETURN_IF_ERROR(executor_->UpdateTypeCatalogVersion(stored_type.id()));
   }
   return absl::OkStatus();
 }
@@ -1342,6 +1558,82 @@ absl::Status RDBMSMetadataAccessObject::FindNodeImpl(const int64_t node_id,
   return absl::OkStatus();
 }
 
+// Sets properties of nodes without reading their stored properties.
+// The types of the nodes come with the node rows and are used to validate
+// the given properties. Each property is replaced by a delete and an insert,
+// the same way ModifyProperties replaces a changed custom property, but each
+// query covers all the nodes and the deletes cover all the names.
+template <typename Node, typename NodeType>
+absl::Status RDBMSMetadataAccessObject::SetNodePropertiesImpl(
+    absl::Span<const int64_t> node_ids,
+    const google::protobuf::Map<std::string, Value>& properties,
+    const google::protobuf::Map<std::string, Value>& custom_properties,
+    const absl::Time update_timestamp) {
+  if (node_ids.empty()) {
+    return absl::OkStatus();
+  }
+  const std::vector<int64_t> ids = DedupIds(node_ids);
+  RecordSet header;
+  MLMD_RETURN_IF_ERROR(
+      RetrieveNodesById<Node>(ids, &header, /*properties=*/nullptr));
+  if (header.records_size() != static_cast<int>(ids.size())) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Cannot find all the given ids; found ", header.records_size(), " of ",
+        ids.size(), " nodes."));
+  }
+  if (!properties.empty()) {
+    std::vector<NodeType> types;
+    MLMD_RETURN_IF_ERROR(ParseNodeRecordSetToDedupedTypes(header, types));
+    MLMD_RETURN_IF_ERROR(PopulateTypeProperties(*executor_, types));
+    Node properties_only_node;
+    *properties_only_node.mutable_properties() = properties;
+    for (const NodeType& type : types) {
+      MLMD_RETURN_WITH_CONTEXT_IF_ERROR(
+          ValidatePropertiesWithType(properties_only_node, type),
+          "Cannot validate properties with type ", type.name());
+    }
+  }
+  MLMD_RETURN_IF_ERROR(DeleteNodesProperties<NodeType>(
+      ids, GetPropertyNames(properties), /*is_custom_property=*/false));
+  MLMD_RETURN_IF_ERROR(DeleteNodesProperties<NodeType>(
+      ids, GetPropertyNames(custom_properties), /*is_custom_property=*/true));
+  for (const auto& [name, value] : properties) {
+    MLMD_RETURN_IF_ERROR(InsertNodesProperty<NodeType>(
+        ids, name, /*is_custom_property=*/false, value));
+  }
+  for (const auto& [name, value] : custom_properties) {
+    MLMD_RETURN_IF_ERROR(InsertNodesProperty<NodeType>(
+        ids, name, /*is_custom_property=*/true, value));
+  }
+  return RunNodesLastUpdateTimeUpdate<Node>(ids, update_timestamp);
+}
+
+// Deletes properties of nodes without reading their stored properties.
+template <typename Node, typename NodeType>
+absl::Status RDBMSMetadataAccessObject::DeleteNodePropertiesImpl(
+    absl::Span<const int64_t> node_ids,
+    absl::Span<const std::string> property_names,
+    absl::Span<const std::string> custom_property_names,
+    const absl::Time update_timestamp) {
+  if (node_ids.empty()) {
+    return absl::OkStatus();
+  }
+  const std::vector<int64_t> ids = DedupIds(node_ids);
+  RecordSet header;
+  MLMD_RETURN_IF_ERROR(
+      RetrieveNodesById<Node>(ids, &header, /*properties=*/nullptr));
+  if (header.records_size() != static_cast<int>(ids.size())) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Cannot find all the given ids; found ", header.records_size(), " of ",
+        ids.size(), " nodes."));
+  }
+  MLMD_RETURN_IF_ERROR(DeleteNodesProperties<NodeType>(
+      ids, property_names, /*is_custom_property=*/false));
+  MLMD_RETURN_IF_ERROR(DeleteNodesProperties<NodeType>(
+      ids, custom_property_names, /*is_custom_property=*/true));
+  return RunNodesLastUpdateTimeUpdate<Node>(ids, update_timestamp);
+}
+
 // Updates a `Node` which is one of {`Artifact`, `Execution`, `Context`} under
 // masking.
 // `update_timestamp` should be used as the update time of the Node.
@@ -1354,7 +1646,8 @@ absl::Status RDBMSMetadataAccessObject::FindNodeImpl(const int64_t node_id,
 template <typename Node, typename NodeType>
 absl::Status RDBMSMetadataAccessObject::UpdateNodeImpl(
     const Node& node, const absl::Time update_timestamp, bool force_update_time,
-    const google::protobuf::FieldMask& mask) {
+    const google::protobuf::FieldMask& mask,
+    const UpdatePrecondition& precondition) {
   // validate node
   if (!node.has_id()) return absl::InvalidArgumentError("No id is given.");
 
@@ -1394,6 +1687,18 @@ absl::Status RDBMSMetadataAccessObject::UpdateNodeImpl(
   // `type_id` of stored_node will be updated to 0.
   if (!node.has_type_id()) mutable_node.set_type_id(stored_node.type_id());
 
+  // A conditional update always updates the node, and moves its
+  // last_update_time_since_epoch forward, so that a concurrent writer that
+  // read the same stored node fails on its own precondition.
+  if (precondition.ByteSizeLong() > 0) {
+    return RunMaskedNodeUpdate(
+        mutable_node, stored_node,
+        std::max(update_timestamp,
+                 absl::FromUnixMillis(
+                     stored_node.last_update_time_since_epoch() + 1)),
+        mask, precondition);
+  }
+
   // If `force_update_time` is set to True. Always update node regardless of
   // whether input node is the same as stored node or not.
   if (force_update_time) {
@@ -1666,7 +1971,8 @@ absl::Status RDBMSMetadataAccessObject::CreateParentTypeInheritanceLink(
   if (IsUniqueConstraintViolated(status)) {
     return absl::AlreadyExistsError("The ParentType already exists.");
   }
-  return status;
+  MLMD_RETURN_IF_ERROR(status);
+  return executor_->UpdateTypeCatalogVersion(type.id());
 }
 
 absl::Status RDBMSMetadataAccessObject::CreateParentTypeInheritanceLink(
@@ -1683,7 +1989,8 @@ absl::Status RDBMSMetadataAccessObject::CreateParentTypeInheritanceLink(
   if (IsUniqueConstraintViolated(status)) {
     return absl::AlreadyExistsError("The ParentType already exists.");
   }
-  return status;
+  MLMD_RETURN_IF_ERROR(status);
+  return executor_->UpdateTypeCatalogVersion(type.id());
 }
 
 absl::Status RDBMSMetadataAccessObject::CreateParentTypeInheritanceLink(
@@ -1701,12 +2008,14 @@ absl::Status RDBMSMetadataAccessObject::CreateParentTypeInheritanceLink(
   if (IsUniqueConstraintViolated(status)) {
     return absl::AlreadyExistsError("The ParentType already exists.");
   }
-  return status;
+  MLMD_RETURN_IF_ERROR(status);
+  return executor_->UpdateTypeCatalogVersion(type.id());
 }
 
 absl::Status RDBMSMetadataAccessObject::DeleteParentTypeInheritanceLink(
     int64_t type_id, int64_t parent_type_id) {
-  return executor_->DeleteParentType(type_id, parent_type_id);
+  MLMD_RETURN_IF_ERROR(executor_->DeleteParentType(type_id, parent_type_id));
+  return executor_->UpdateTypeCatalogVersion(type_id);
 }
 
 absl::Status RDBMSMetadataAccessObject::FindParentTypesByTypeId(
@@ -1727,6 +2036,160 @@ absl::Status RDBMSMetadataAccessObject::FindParentTypesByTypeId(
   return FindParentTypesByTypeIdImpl(type_ids, output_parent_types);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindTypeCatalogVersion(
+    int64_t* catalog_version) {
+  return executor_->SelectTypeCatalogVersion(catalog_version);
+}
+
+absl::Status RDBMSMetadataAccessObject::FindTypesChangedAfterCatalogVersion(
+    int64_t catalog_version, std::vector<ArtifactType>* artifact_types,
+    std::vector<ExecutionType>* execution_types,
+    std::vector<ContextType>* context_types) {
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectTypesChangedAfterCatalogVersion(
+      catalog_version, &record_set));
+  std::vector<int64_t> artifact_type_ids, execution_type_ids, context_type_ids;
+  for (const RecordSet::Record& record : record_set.records()) {
+    int64_t type_id;
+    int type_kind;
+    CHECK(absl::SimpleAtoi(record.values(0), &type_id));
+    CHECK(absl::SimpleAtoi(record.values(1), &type_kind));
+    switch (static_cast<TypeKind>(type_kind)) {
+      case TypeKind::ARTIFACT_TYPE:
+        artifact_type_ids.push_back(type_id);
+        break;
+      case TypeKind::EXECUTION_TYPE:
+        execution_type_ids.push_back(type_id);
+        break;
+      case TypeKind::CONTEXT_TYPE:
+        context_type_ids.push_back(type_id);
+        break;
+      default:
+        return absl::InternalError(
+            absl::StrCat("Unknown type_kind: ", type_kind));
+    }
+  }
+  if (!artifact_type_ids.empty()) {
+    MLMD_RETURN_IF_ERROR(FindTypesByIds(artifact_type_ids, *artifact_types));
+    RemoveSimpleTypes(*artifact_types);
+  }
+  if (!execution_type_ids.empty()) {
+    MLMD_RETURN_IF_ERROR(FindTypesByIds(execution_type_ids, *execution_types));
+    RemoveSimpleTypes(*execution_types);
+  }
+  if (!context_type_ids.empty()) {
+    MLMD_RETURN_IF_ERROR(FindTypesByIds(context_type_ids, *context_types));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status RDBMSMetadataAccessObject::IncreaseWriteEpochs(
+    absl::Span<const TypeKind> type_kinds) {
+  return executor_->IncreaseWriteEpochs(type_kinds);
+}
+
+absl::Status RDBMSMetadataAccessObject::FindWriteEpochs(
+    int64_t* artifact_write_epoch, int64_t* execution_write_epoch,
+    int64_t* context_write_epoch) {
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectWriteEpochs(&record_set));
+  *artifact_write_epoch = 0;
+  *execution_write_epoch = 0;
+  *context_write_epoch = 0;
+  for (const RecordSet::Record& record : record_set.records()) {
+    int type_kind;
+    int64_t epoch;
+    if (!absl::SimpleAtoi(record.values(0), &type_kind) ||
+        !absl::SimpleAtoi(record.values(1), &epoch)) {
+      return absl::InternalError(absl::StrCat(
+          "Cannot parse the write epoch record: ", record.DebugString()));
+    }
+    switch (static_cast<TypeKind>(type_kind)) {
+      case TypeKind::ARTIFACT_TYPE:
+        *artifact_write_epoch = epoch;
+        break;
+      case TypeKind::EXECUTION_TYPE:
+        *execution_write_epoch = epoch;
+        break;
+      case TypeKind::CONTEXT_TYPE:
+        *context_write_epoch = epoch;
+        break;
+      default:
+        return absl::InternalError(
+            absl::StrCat("Unknown type_kind: ", type_kind));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status RDBMSMetadataAccessObject::FindContextSummaries(
+    absl::Span<const int64_t> context_ids,
+    std::vector<ContextSummary>* context_summaries) {
+  if (context_summaries == nullptr) {
+    return absl::InvalidArgumentError("context_summaries is null");
+  }
+  context_summaries->clear();
+  if (context_ids.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(
+      executor_->SelectContextSummaries(context_ids, &record_set));
+  context_summaries->resize(context_ids.size());
+  absl::flat_hash_map<int64_t, ContextSummary*> summary_by_context_id;
+  for (int i = 0; i < context_ids.size(); ++i) {
+    (*context_summaries)[i].set_context_id(context_ids[i]);
+    summary_by_context_id[context_ids[i]] = &(*context_summaries)[i];
+  }
+  for (const RecordSet::Record& record : record_set.records()) {
+    int64_t context_id;
+    int type_kind;
+    int64_t type_id;
+    int state;
+    int64_t num_nodes;
+    if (!absl::SimpleAtoi(record.values(0), &context_id) ||
+        !absl::SimpleAtoi(record.values(1), &type_kind) ||
+        !absl::SimpleAtoi(record.values(2), &type_id) ||
+        !absl::SimpleAtoi(record.values(3), &state) ||
+        !absl::SimpleAtoi(record.values(4), &num_nodes)) {
+      return absl::InternalError(absl::StrCat(
+          "Cannot parse the context summary record: ", record.DebugString()));
+    }
+    auto it = summary_by_context_id.find(context_id);
+    if (it == summary_by_context_id.end()) {
+      return absl::InternalError(
+          absl::StrCat("Unexpected context_id: ", context_id));
+    }
+    switch (static_cast<TypeKind>(type_kind)) {
+      case TypeKind::EXECUTION_TYPE: {
+        ContextSummary::ExecutionCount* count =
+            it->second->add_execution_counts();
+        count->set_type_id(type_id);
+        count->set_last_known_state(static_cast<Execution::State>(state));
+        count->set_num_executions(num_nodes);
+        break;
+      }
+      case TypeKind::ARTIFACT_TYPE: {
+        ContextSummary::ArtifactCount* count =
+            it->second->add_artifact_counts();
+        count->set_type_id(type_id);
+        count->set_state(static_cast<Artifact::State>(state));
+        count->set_num_artifacts(num_nodes);
+        break;
+      }
+      default:
+        return absl::InternalError(
+            absl::StrCat("Unknown type_kind: ", type_kind));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status RDBMSMetadataAccessObject::RebuildContextSummaries(
+    absl::Span<const int64_t> context_ids) {
+  return executor_->RebuildContextSummaries(context_ids);
+}
+
 absl::Status RDBMSMetadataAccessObject::CreateArtifact(
     const Artifact& artifact, const bool skip_type_and_property_validation,
     int64_t* artifact_id) {
@@ -1842,6 +2305,19 @@ absl::Status RDBMSMetadataAccessObject::FindArtifactsById(
   return FindNodesWithTypesImpl(artifact_ids, artifacts, artifact_types);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindArtifactLastUpdateTimesById(
+    absl::Span<const int64_t> artifact_ids,
+    absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+  if (artifact_ids.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(
+      executor_->SelectArtifactLastUpdateTimesByID(artifact_ids, &record_set));
+  ConvertRecordSetToLastUpdateTimes(record_set, last_update_times);
+  return absl::OkStatus();
+}
+
 absl::Status RDBMSMetadataAccessObject::FindExecutionsById(
     absl::Span<const int64_t> execution_ids,
     std::vector<Execution>* executions) {
@@ -1852,6 +2328,19 @@ absl::Status RDBMSMetadataAccessObject::FindExecutionsById(
   return FindNodesImpl(execution_ids, /*skipped_ids_ok=*/true, *executions);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindExecutionLastUpdateTimesById(
+    absl::Span<const int64_t> execution_ids,
+    absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+  if (execution_ids.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectExecutionLastUpdateTimesByID(
+      execution_ids, &record_set));
+  ConvertRecordSetToLastUpdateTimes(record_set, last_update_times);
+  return absl::OkStatus();
+}
+
 absl::Status RDBMSMetadataAccessObject::FindContextsById(
     absl::Span<const int64_t> context_ids, std::vector<Context>* contexts) {
   if (context_ids.empty()) {
@@ -1860,6 +2349,19 @@ absl::Status RDBMSMetadataAccessObject::FindContextsById(
   return FindNodesImpl(context_ids, /*skipped_ids_ok=*/true, *contexts);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindContextLastUpdateTimesById(
+    absl::Span<const int64_t> context_ids,
+    absl::flat_hash_map<int64_t, int64_t>& last_update_times) {
+  if (context_ids.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(
+      executor_->SelectContextLastUpdateTimesByID(context_ids, &record_set));
+  ConvertRecordSetToLastUpdateTimes(record_set, last_update_times);
+  return absl::OkStatus();
+}
+
 absl::Status RDBMSMetadataAccessObject::FindArtifactsByExternalIds(
     absl::Span<absl::string_view> external_ids,
     std::vector<Artifact>* artifacts) {
@@ -1981,6 +2483,15 @@ absl::Status RDBMSMetadataAccessObject::UpdateArtifact(
                                                 force_update_time, mask);
 }
 
+absl::Status RDBMSMetadataAccessObject::UpdateArtifact(
+    const Artifact& artifact, const absl::Time update_timestamp,
+    const google::protobuf::FieldMask& mask,
+    const UpdatePrecondition& precondition) {
+  return UpdateNodeImpl<Artifact, ArtifactType>(
+      artifact, update_timestamp, /*force_update_time=*/true, mask,
+      precondition);
+}
+
 absl::Status RDBMSMetadataAccessObject::UpdateExecution(
     const Execution& execution, const absl::Time update_timestamp,
     bool force_update_time) {
@@ -1996,6 +2507,15 @@ absl::Status RDBMSMetadataAccessObject::UpdateExecution(
                                                   force_update_time, mask);
 }
 
+absl::Status RDBMSMetadataAccessObject::UpdateExecution(
+    const Execution& execution, const absl::Time update_timestamp,
+    const google::protobuf::FieldMask& mask,
+    const UpdatePrecondition& precondition) {
+  return UpdateNodeImpl<Execution, ExecutionType>(
+      execution, update_timestamp, /*force_update_time=*/true, mask,
+      precondition);
+}
+
 absl::Status RDBMSMetadataAccessObject::UpdateContext(
     const Context& context, const absl::Time update_timestamp,
     bool force_update_time) {
@@ -2011,6 +2531,100 @@ absl::Status RDBMSMetadataAccessObject::UpdateContext(
                                               force_update_time, mask);
 }
 
+absl::Status RDBMSMetadataAccessObject::SetArtifactProperties(
+    absl::Span<const int64_t> artifact_ids,
+    const google::protobuf::Map<std::string, Value>& properties,
+    const google::protobuf::Map<std::string, Value>& custom_properties,
+    const absl::Time update_timestamp) {
+  return SetNodePropertiesImpl<Artifact, ArtifactType>(
+      artifact_ids, properties, custom_properties, update_timestamp);
+}
+
+absl::Status RDBMSMetadataAccessObject::SetExecutionProperties(
+    absl::Span<const int64_t> execution_ids,
+    const google::protobuf::Map<std::string, Value>& properties,
+    const google::protobuf::Map<std::string, Value>& custom_properties,
+    const absl::Time update_timestamp) {
+  return SetNodePropertiesImpl<Execution, ExecutionType>(
+      execution_ids, properties, custom_properties, update_timestamp);
+}
+
+absl::Status RDBMSMetadataAccessObject::SetContextProperties(
+    absl::Span<const int64_t> context_ids,
+    const google::protobuf::Map<std::string, Value>& properties,
+    const google::protobuf::Map<std::string, Value>& custom_properties,
+    const absl::Time update_timestamp) {
+  return SetNodePropertiesImpl<Context, ContextType>(
+      context_ids, properties, custom_properties, update_timestamp);
+}
+
+absl::Status RDBMSMetadataAccessObject::DeleteArtifactProperties(
+    absl::Span<const int64_t> artifact_ids,
+    absl::Span<const std::string> property_names,
+    absl::Span<const std::string> custom_property_names,
+    const absl::Time update_timestamp) {
+  return DeleteNodePropertiesImpl<Artifact, ArtifactType>(
+      artifact_ids, property_names, custom_property_names, update_timestamp);
+}
+
+absl::Status RDBMSMetadataAccessObject::DeleteExecutionProperties(
+    absl::Span<const int64_t> execution_ids,
+    absl::Span<const std::string> property_names,
+    absl::Span<const std::string> custom_property_names,
+    const absl::Time update_timestamp) {
+  return DeleteNodePropertiesImpl<Execution, ExecutionType>(
+      execution_ids, property_names, custom_property_names, update_timestamp);
+}
+
+absl::Status RDBMSMetadataAccessObject::DeleteContextProperties(
+    absl::Span<const int64_t> context_ids,
+    absl::Span<const std::string> property_names,
+    absl::Span<const std::string> custom_property_names,
+    const absl::Time update_timestamp) {
+  return DeleteNodePropertiesImpl<Context, ContextType>(
+      context_ids, property_names, custom_property_names, update_timestamp);
+}
+
+// Claims executions in a single transaction. The execution rows are locked
+// before the type is read, so that on SQLite the write lock is the first lock
+// taken and a concurrent claim waits for it.
+absl::Status RDBMSMetadataAccessObject::ClaimExecutions(
+    absl::string_view type_name, std::optional<absl::string_view> type_version,
+    const Execution::State current_state, const Execution::State new_state,
+    const int64_t max_num_executions,
+    const google::protobuf::Map<std::string, Value>& lease_properties,
+    const absl::Time update_timestamp, std::vector<Execution>* executions) {
+  executions->clear();
+  MLMD_RETURN_IF_ERROR(executor_->LockExecutionTableForClaim());
+  int64_t type_id;
+  MLMD_RETURN_IF_ERROR(FindTypeIdByNameAndVersion(
+      type_name, type_version, TypeKind::EXECUTION_TYPE, &type_id));
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectExecutionIdsForClaim(
+      type_id, current_state, max_num_executions, &record_set));
+  const std::vector<int64_t> ids = ConvertToIds(record_set);
+  if (ids.empty()) {
+    return absl::OkStatus();
+  }
+  MLMD_RETURN_IF_ERROR(UpdateContextSummaries<Execution>(ids, /*delta=*/-1));
+  MLMD_RETURN_IF_ERROR(
+      executor_->UpdateExecutionsState(ids, new_state, update_timestamp));
+  MLMD_RETURN_IF_ERROR(UpdateContextSummaries<Execution>(ids, /*delta=*/1));
+  for (const int64_t id : ids) {
+    for (const auto& [name, value] : lease_properties) {
+      MLMD_RETURN_IF_ERROR(DeleteProperty<ExecutionType>(
+          id, name, /*is_custom_property=*/true));
+      MLMD_RETURN_IF_ERROR(InsertProperty<ExecutionType>(
+          id, name, /*is_custom_property=*/true, value));
+    }
+  }
+  MLMD_RETURN_IF_ERROR(FindExecutionsById(ids, executions));
+  absl::c_sort(*executions, [](const Execution& a, const Execution& b) {
+    return a.id() < b.id();
+  });
+  return absl::OkStatus();
+}
+
 absl::Status RDBMSMetadataAccessObject::CreateEvent(const Event& event,
                                                     int64_t* event_id) {
   return CreateEvent(event, /*is_already_validated=*/false, event_id);
@@ -2104,6 +2718,49 @@ absl::Status RDBMSMetadataAccessObject::FindEventsByExecutions(
   return FindEventsFromRecordSet(event_record_set, events);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindLineageEvents(
+    bool by_artifacts, absl::Span<const int64_t> node_ids,
+    const LineageSubgraphQueryOptions& options, int64_t max_num_nodes,
+    int64_t offset, std::vector<Event>* events) {
+  if (events == nullptr) {
+    return absl::InvalidArgumentError("Given events is NULL.");
+  }
+  // Without predicates or a limit, the node table does not need to be joined.
+  if (!options.has_event_time_window() &&
+      !options.has_node_create_time_window() &&
+      (!by_artifacts || options.execution_states().empty()) &&
+      max_num_nodes == std::numeric_limits<int64_t>::max() && offset == 0) {
+    return by_artifacts ? FindEventsByArtifacts(node_ids, events)
+                        : FindEventsByExecutions(node_ids, events);
+  }
+
+  const auto [event_start_time_milliseconds, event_end_time_milliseconds] =
+      GetTimeWindowBounds(options.event_time_window());
+  const auto [node_start_time_milliseconds, node_end_time_milliseconds] =
+      GetTimeWindowBounds(options.node_create_time_window());
+  RecordSet event_record_set;
+  if (!node_ids.empty()) {
+    if (by_artifacts) {
+      MLMD_RETURN_IF_ERROR(executor_->SelectLineageEventByArtifactIDs(
+          node_ids, event_start_time_milliseconds, event_end_time_milliseconds,
+          node_start_time_milliseconds, node_end_time_milliseconds,
+          options.execution_states(), max_num_nodes, offset,
+          &event_record_set));
+    } else {
+      MLMD_RETURN_IF_ERROR(executor_->SelectLineageEventByExecutionIDs(
+          node_ids, event_start_time_milliseconds, event_end_time_milliseconds,
+          node_start_time_milliseconds, node_end_time_milliseconds,
+          max_num_nodes, offset, &event_record_set));
+    }
+  }
+
+  if (event_record_set.records_size() == 0) {
+    return absl::NotFoundError(
+        "Cannot find events by given node ids that satisfy the predicates.");
+  }
+  return FindEventsFromRecordSet(event_record_set, events);
+}
+
 absl::Status RDBMSMetadataAccessObject::CreateAssociation(
     const Association& association, int64_t* association_id) {
   return CreateAssociation(association, /*is_already_validated=*/false,
@@ -2145,7 +2802,12 @@ absl::Status RDBMSMetadataAccessObject::CreateAssociation(
         "Given association already exists: ", association.DebugString(),
         status.ToString()));
   }
-  return status;
+  MLMD_RETURN_IF_ERROR(status);
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->IncreaseContextSummaryByAssociation(
+      association.context_id(), association.execution_id());
 }
 
 absl::Status RDBMSMetadataAccessObject::FindAssociationsByContexts(
@@ -2285,7 +2947,12 @@ absl::Status RDBMSMetadataAccessObject::CreateAttribution(
         "Given attribution already exists: ", attribution.DebugString(),
         status.ToString()));
   }
-  return status;
+  MLMD_RETURN_IF_ERROR(status);
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->IncreaseContextSummaryByAttribution(
+      attribution.context_id(), attribution.artifact_id());
 }
 
 absl::Status RDBMSMetadataAccessObject::FindContextsByArtifact(
@@ -2625,6 +3292,23 @@ absl::Status RDBMSMetadataAccessObject::FindArtifactByTypeIdAndArtifactName(
   return absl::OkStatus();
 }
 
+absl::Status RDBMSMetadataAccessObject::FindArtifactsByTypeIdAndArtifactNames(
+    const int64_t type_id, absl::Span<absl::string_view> names,
+    std::vector<Artifact>* artifacts) {
+  if (names.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectArtifactsByTypeIDAndArtifactNames(
+      type_id, names, &record_set));
+  const std::vector<int64_t> ids = ConvertToIds(record_set);
+  if (ids.empty()) {
+    return absl::NotFoundError(absl::StrCat(
+        "No artifacts found for type_id:", type_id, " and names."));
+  }
+  return FindNodesImpl(ids, /*skipped_ids_ok=*/false, *artifacts);
+}
+
 absl::Status RDBMSMetadataAccessObject::FindArtifactsByTypeId(
     const int64_t type_id, std::optional<ListOperationOptions> list_options,
     std::vector<Artifact>* artifacts, std::string* next_page_token) {
@@ -2677,6 +3361,23 @@ absl::Status RDBMSMetadataAccessObject::FindExecutionByTypeIdAndExecutionName(
   return absl::OkStatus();
 }
 
+absl::Status RDBMSMetadataAccessObject::FindExecutionsByTypeIdAndExecutionNames(
+    const int64_t type_id, absl::Span<absl::string_view> names,
+    std::vector<Execution>* executions) {
+  if (names.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectExecutionsByTypeIDAndExecutionNames(
+      type_id, names, &record_set));
+  const std::vector<int64_t> ids = ConvertToIds(record_set);
+  if (ids.empty()) {
+    return absl::NotFoundError(absl::StrCat(
+        "No executions found for type_id:", type_id, " and names."));
+  }
+  return FindNodesImpl(ids, /*skipped_ids_ok=*/false, *executions);
+}
+
 absl::Status RDBMSMetadataAccessObject::FindExecutionsByTypeId(
     const int64_t type_id, std::optional<ListOperationOptions> list_options,
     std::vector<Execution>* executions, std::string* next_page_token) {
@@ -2738,6 +3439,20 @@ absl::Status RDBMSMetadataAccessObject::FindArtifactsByURI(
   return FindNodesImpl(ids, /*skipped_ids_ok=*/false, *artifacts);
 }
 
+absl::Status RDBMSMetadataAccessObject::FindArtifactsByURIs(
+    absl::Span<absl::string_view> uris, std::vector<Artifact>* artifacts) {
+  if (uris.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectArtifactsByURIs(uris, &record_set));
+  const std::vector<int64_t> ids = ConvertToIds(record_set);
+  if (ids.empty()) {
+    return absl::NotFoundError("No artifacts found for uris.");
+  }
+  return FindNodesImpl(ids, /*skipped_ids_ok=*/false, *artifacts);
+}
+
 absl::Status RDBMSMetadataAccessObject::FindContextByTypeIdAndContextName(
     int64_t type_id, absl::string_view name, bool id_only, Context* context) {
   RecordSet record_set;
@@ -2764,6 +3479,23 @@ absl::Status RDBMSMetadataAccessObject::FindContextByTypeIdAndContextName(
   return absl::OkStatus();
 }
 
+absl::Status RDBMSMetadataAccessObject::FindContextsByTypeIdAndContextNames(
+    int64_t type_id, absl::Span<absl::string_view> names,
+    std::vector<Context>* contexts) {
+  if (names.empty()) {
+    return absl::OkStatus();
+  }
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(executor_->SelectContextsByTypeIDAndContextNames(
+      type_id, names, &record_set));
+  const std::vector<int64_t> ids = ConvertToIds(record_set);
+  if (ids.empty()) {
+    return absl::NotFoundError(absl::StrCat(
+        "No contexts found with type_id: ", type_id, " and names."));
+  }
+  return FindNodesImpl(ids, /*skipped_ids_ok=*/false, *contexts);
+}
+
 
 template <typename Node>
 absl::Status RDBMSMetadataAccessObject::FilterBoundaryNodesImpl(
@@ -2795,32 +3527,63 @@ absl::Status RDBMSMetadataAccessObject::FilterBoundaryNodesImpl(
 }
 
 template <typename Node>
-absl::StatusOr<absl::flat_hash_set<int64_t>>
-RDBMSMetadataAccessObject::FindEndingNodeIdsIfExists(
-    const LineageSubgraphQueryOptions::EndingNodes ending_nodes,
-    const absl::flat_hash_set<int64_t>& unvisited_node_ids) {
-  absl::flat_hash_set<int64_t> ending_node_ids;
-  if (!ending_nodes.has_filter_query()) {
-    return ending_node_ids;
-  }
-  const std::vector<int64_t> candidate_ids(unvisited_node_ids.begin(),
-                                           unvisited_node_ids.end());
+absl::StatusOr<IdBitmap> RDBMSMetadataAccessObject::FindNodeIdsByFilterQuery(
+    absl::string_view filter_query, const IdBitmap& candidate_node_ids) {
+  IdBitmap node_ids;
+  const std::vector<int64_t> candidate_ids = candidate_node_ids.ToVector();
   auto list_ids = absl::MakeConstSpan(candidate_ids);
   // Uses batched retrieval to bound query length and list query invariant.
   int64_t batch_size = kDefaultMaxListOperationResultSize;
   for (int offset = 0; offset < candidate_ids.size(); offset += batch_size) {
-    ListOperationOptions boundary_options;
-    boundary_options.set_max_result_size(batch_size);
-    boundary_options.set_filter_query(ending_nodes.filter_query().data());
+    ListOperationOptions list_options;
+    list_options.set_max_result_size(batch_size);
+    list_options.set_filter_query(std::string(filter_query));
     RecordSet record_set;
     MLMD_RETURN_IF_ERROR(ListNodeIds<Node>(
-        boundary_options, list_ids.subspan(offset, batch_size), &record_set));
-    for (int64_t ending_node_id : ConvertToIds(record_set)) {
-      ending_node_ids.insert(ending_node_id);
-    }
+        list_options, list_ids.subspan(offset, batch_size), &record_set));
+    node_ids.UnionWith(IdBitmap::FromIds(ConvertToIds(record_set)));
   }
 
-  return ending_node_ids;
+  return node_ids;
+}
+
+template <typename Node>
+absl::StatusOr<IdBitmap> RDBMSMetadataAccessObject::TruncateNodeIdsByRecency(
+    int64_t max_num_nodes, IdBitmap& node_ids) {
+  static_assert(std::is_same<Node, Artifact>::value ||
+                    std::is_same<Node, Execution>::value,
+                "Only artifacts and executions can be truncated.");
+  if (node_ids.size() <= max_num_nodes) {
+    return IdBitmap();
+  }
+  IdBitmap removed_node_ids = node_ids;
+  if (max_num_nodes <= 0) {
+    node_ids.clear();
+    return removed_node_ids;
+  }
+  const std::vector<int64_t> candidate_ids = node_ids.ToVector();
+  RecordSet record_set;
+  if (std::is_same<Node, Artifact>::value) {
+    MLMD_RETURN_IF_ERROR(executor_->SelectArtifactIDsByRecency(
+        candidate_ids, max_num_nodes, &record_set));
+  } else {
+    MLMD_RETURN_IF_ERROR(executor_->SelectExecutionIDsByRecency(
+        candidate_ids, max_num_nodes, &record_set));
+  }
+  node_ids = IdBitmap::FromIds(ConvertToIds(record_set));
+  removed_node_ids.Subtract(node_ids);
+  return removed_node_ids;
+}
+
+template <typename Node>
+absl::StatusOr<IdBitmap> RDBMSMetadataAccessObject::FindEndingNodeIdsIfExists(
+    const LineageSubgraphQueryOptions::EndingNodes ending_nodes,
+    const IdBitmap& unvisited_node_ids) {
+  if (!ending_nodes.has_filter_query()) {
+    return IdBitmap();
+  }
+  return FindNodeIdsByFilterQuery<Node>(ending_nodes.filter_query(),
+                                        unvisited_node_ids);
 }
 
 absl::Status RDBMSMetadataAccessObject::ExpandLineageGraphImpl(
@@ -2853,9 +3616,17 @@ absl::Status RDBMSMetadataAccessObject::ExpandLineageGraphImpl(
   MLMD_RETURN_IF_ERROR(FilterBoundaryNodesImpl<Execution>(
       boundary_condition, unvisited_execution_ids));
 
-  // Randomly remove extra nodes if more than max_nodes executions are found.
-  while (unvisited_execution_ids.size() > max_nodes) {
-    unvisited_execution_ids.erase(unvisited_execution_ids.begin());
+  // Keeps the most recently created nodes if more than max_nodes executions are
+  // found.
+  if (unvisited_execution_ids.size() > max_nodes) {
+    IdBitmap kept_execution_ids = IdBitmap::FromIds(std::vector<int64_t>(
+        unvisited_execution_ids.begin(), unvisited_execution_ids.end()));
+    MLMD_RETURN_IF_ERROR(
+        TruncateNodeIdsByRecency<Execution>(max_nodes, kept_execution_ids)
+            .status());
+    const std::vector<int64_t> kept_ids = kept_execution_ids.ToVector();
+    unvisited_execution_ids =
+        absl::flat_hash_set<int64_t>(kept_ids.begin(), kept_ids.end());
   }
 
   for (const Event& event : events) {
@@ -2877,72 +3648,124 @@ absl::StatusOr<std::vector<int64_t>>
 RDBMSMetadataAccessObject::ExpandLineageSubgraphImpl(
     const bool expand_from_artifacts,
     const LineageSubgraphQueryOptions& options,
-    absl::Span<const int64_t> input_node_ids,
-    absl::flat_hash_set<int64_t>& visited_output_node_ids,
-    absl::flat_hash_set<int64_t>& output_ending_node_ids,
-    std::vector<Event>& output_events) {
-  // Step 1: filter events by direction.
-  std::vector<Event> candidate_events;
-  absl::Status status =
+    absl::Span<const int64_t> input_node_ids, int64_t max_num_output_nodes,
+    IdBitmap& visited_output_node_ids, IdBitmap& output_ending_node_ids,
+    std::vector<Event>& output_events, bool& is_truncated) {
+  const bool include_ending_nodes =
       expand_from_artifacts
-          ? FindEventsByArtifacts(input_node_ids, &candidate_events)
-          : FindEventsByExecutions(input_node_ids, &candidate_events);
-  std::vector<Event> events = FilterEventsByDirectionAndEventType(
-      candidate_events, /*is_from_artifact=*/expand_from_artifacts,
-      options.direction());
-
-  std::vector<int64_t> output_node_ids;
-  // If no events are found for the given input nodes, directly return.
-  if (absl::IsNotFound(status)) {
-    return output_node_ids;
-  }
-  MLMD_RETURN_IF_ERROR(status);
-
-  // Step 2: collect the new node IDs to visit from filtered events.
-  absl::flat_hash_set<int64_t> unvisited_output_node_ids;
-  for (const Event& event : events) {
-    int64_t output_node_id =
-        expand_from_artifacts ? event.execution_id() : event.artifact_id();
-    // Filter nodes by visited node ids and ending node ids collected so far in
+          ? options.ending_executions().include_ending_nodes()
+          : options.ending_artifacts().include_ending_nodes();
+  // The output nodes are read in pages, the most recently created first, so
+  // that the hop stops reading events once it reaches more than
+  // `max_num_output_nodes` new output nodes. Ending nodes only count if they
+  // are included.
+  std::vector<Event> events;
+  IdBitmap unvisited_output_node_ids;
+  IdBitmap excluded_node_ids;
+  int64_t num_new_output_nodes = 0;
+  int64_t offset = 0;
+  bool is_exhausted = false;
+  bool is_hop_truncated = false;
+  while (!is_exhausted && !is_hop_truncated) {
+    // Reads one more output node than the remaining budget, to tell whether
+    // the hop has to be truncated.
+    const int64_t num_remaining_nodes =
+        max_num_output_nodes - num_new_output_nodes;
+    const int64_t page_size =
+        num_remaining_nodes < std::numeric_limits<int64_t>::max()
+            ? num_remaining_nodes + 1
+            : num_remaining_nodes;
+    // Step 1: filter events by the predicates in `options` and direction. The
+    // output nodes that do not satisfy the node predicates are pruned by the
+    // event query, so they are neither returned nor expanded.
+    std::vector<Event> candidate_events;
+    const absl::Status status = FindLineageEvents(
+        /*by_artifacts=*/expand_from_artifacts, input_node_ids, options,
+        /*max_num_nodes=*/page_size, offset, &candidate_events);
+    // If no more events are found for the given input nodes, stops reading.
+    if (absl::IsNotFound(status)) {
+      break;
+    }
+    MLMD_RETURN_IF_ERROR(status);
+    std::vector<int64_t> page_node_ids;
+    absl::flat_hash_set<int64_t> seen_node_ids;
+    for (const Event& event : candidate_events) {
+      const int64_t output_node_id =
+          expand_from_artifacts ? event.execution_id() : event.artifact_id();
+      if (seen_node_ids.insert(output_node_id).second) {
+        page_node_ids.push_back(output_node_id);
+      }
+    }
+    is_exhausted = static_cast<int64_t>(page_node_ids.size()) < page_size;
+    offset += page_node_ids.size();
+    const std::vector<Event> page_events = FilterEventsByDirectionAndEventType(
+        candidate_events, /*is_from_artifact=*/expand_from_artifacts,
+        options.direction());
+    absl::c_copy(page_events, std::back_inserter(events));
+
+    // Step 2: collect the new node IDs to visit from filtered events,
+    // excluding the visited node ids and ending node ids collected so far in
     // the previous graph expansions.
-    if (!visited_output_node_ids.contains(output_node_id) &&
-        !output_ending_node_ids.contains(output_node_id)) {
-      unvisited_output_node_ids.insert(output_node_id);
+    std::vector<int64_t> neighbor_node_ids;
+    neighbor_node_ids.reserve(page_events.size());
+    for (const Event& event : page_events) {
+      neighbor_node_ids.push_back(expand_from_artifacts ? event.execution_id()
+                                                        : event.artifact_id());
+    }
+    IdBitmap new_node_ids = IdBitmap::FromIds(neighbor_node_ids);
+    new_node_ids.Subtract(visited_output_node_ids);
+    new_node_ids.Subtract(output_ending_node_ids);
+    // Step 3: determine if node IDs are ending nodes and exclude them from
+    // further expansion.
+    IdBitmap ending_node_ids;
+    MLMD_ASSIGN_OR_RETURN(
+        ending_node_ids,
+        expand_from_artifacts
+            ? FindEndingNodeIdsIfExists<Execution>(options.ending_executions(),
+                                                   new_node_ids)
+            : FindEndingNodeIdsIfExists<Artifact>(options.ending_artifacts(),
+                                                  new_node_ids));
+    // Step 4: keep the new nodes of the page, the most recently created
+    // first, until the budget is spent. The other new nodes are excluded.
+    for (const int64_t node_id : page_node_ids) {
+      if (!new_node_ids.Contains(node_id)) {
+        continue;
+      }
+      const bool is_ending_node = ending_node_ids.Contains(node_id);
+      if (is_ending_node && !include_ending_nodes) {
+        output_ending_node_ids.Insert(node_id);
+      } else if (num_new_output_nodes < max_num_output_nodes) {
+        (is_ending_node ? output_ending_node_ids : unvisited_output_node_ids)
+            .Insert(node_id);
+        num_new_output_nodes++;
+      } else {
+        excluded_node_ids.Insert(node_id);
+        is_hop_truncated = true;
+      }
     }
   }
-  // Step 3: determine if node IDs are ending nodes and exclude them from
-  // further expansion.
-  absl::flat_hash_set<int64_t> ending_node_ids;
-  MLMD_ASSIGN_OR_RETURN(
-      ending_node_ids,
-      expand_from_artifacts
-          ? FindEndingNodeIdsIfExists<Execution>(options.ending_executions(),
-                                                 unvisited_output_node_ids)
-          : FindEndingNodeIdsIfExists<Artifact>(options.ending_artifacts(),
-                                                unvisited_output_node_ids));
-  absl::c_copy(ending_node_ids, std::inserter(output_ending_node_ids,
-                                              output_ending_node_ids.end()));
-  // Step 4: Filter unvisited_output_node_ids if ending nodes exist.
-  absl::erase_if(unvisited_output_node_ids,
-                 [&output_ending_node_ids](int64_t id) {
-                   return output_ending_node_ids.contains(id);
-                 });
+  if (is_hop_truncated) {
+    is_truncated = true;
+  }
 
   // Step 5: Filter events by visited nodes and ending nodes if possible.
   for (const Event& event : events) {
     int64_t output_node_id =
         expand_from_artifacts ? event.execution_id() : event.artifact_id();
-    if (!visited_output_node_ids.contains(output_node_id) &&
-        !output_ending_node_ids.contains(output_node_id)) {
+    if (excluded_node_ids.Contains(output_node_id)) {
+      continue;
+    }
+    if (unvisited_output_node_ids.Contains(output_node_id)) {
       output_events.push_back(event);
-    } else if (output_ending_node_ids.contains(output_node_id)) {
+    } else if (output_ending_node_ids.Contains(output_node_id)) {
       if ((expand_from_artifacts &&
            options.ending_executions().include_ending_nodes()) ||
           (!expand_from_artifacts &&
            options.ending_artifacts().include_ending_nodes())) {
         output_events.push_back(event);
       }
-    } else if (visited_output_node_ids.contains(output_node_id)) {
+    } else {
+      // The output node was visited in a previous graph expansion.
       if (options.direction() == LineageSubgraphQueryOptions::UPSTREAM ||
           options.direction() == LineageSubgraphQueryOptions::DOWNSTREAM) {
         // For directional bfs, we should still add the edge even a visited
@@ -2959,10 +3782,8 @@ RDBMSMetadataAccessObject::ExpandLineageSubgraphImpl(
     }
   }
 
-  absl::c_copy(unvisited_output_node_ids, std::back_inserter(output_node_ids));
-  visited_output_node_ids.insert(output_node_ids.begin(),
-                                 output_node_ids.end());
-  return output_node_ids;
+  visited_output_node_ids.UnionWith(unvisited_output_node_ids);
+  return unvisited_output_node_ids.ToVector();
 }
 
 absl::Status RDBMSMetadataAccessObject::ExpandLineageGraphImpl(
@@ -2995,9 +3816,17 @@ absl::Status RDBMSMetadataAccessObject::ExpandLineageGraphImpl(
   MLMD_RETURN_IF_ERROR(FilterBoundaryNodesImpl<Artifact>(
       boundary_condition, unvisited_artifact_ids));
 
-  // Randomly remove extra nodes if more than max_nodes artifacts are found.
-  while (unvisited_artifact_ids.size() > max_nodes) {
-    unvisited_artifact_ids.erase(unvisited_artifact_ids.begin());
+  // Keeps the most recently created nodes if more than max_nodes artifacts are
+  // found.
+  if (unvisited_artifact_ids.size() > max_nodes) {
+    IdBitmap kept_artifact_ids = IdBitmap::FromIds(std::vector<int64_t>(
+        unvisited_artifact_ids.begin(), unvisited_artifact_ids.end()));
+    MLMD_RETURN_IF_ERROR(
+        TruncateNodeIdsByRecency<Artifact>(max_nodes, kept_artifact_ids)
+            .status());
+    const std::vector<int64_t> kept_ids = kept_artifact_ids.ToVector();
+    unvisited_artifact_ids =
+        absl::flat_hash_set<int64_t>(kept_ids.begin(), kept_ids.end());
   }
 
   for (const Event& event : events) {
@@ -3097,7 +3926,9 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageGraph(
 
 absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
     const LineageSubgraphQueryOptions& lineage_subgraph_query_options,
-    const google::protobuf::FieldMask& read_mask, LineageGraph& subgraph) {
+    const google::protobuf::FieldMask& read_mask,
+    std::optional<int64_t> known_type_catalog_version, LineageGraph& subgraph,
+    bool* is_truncated) {
   if (read_mask.paths().empty()) {
     return absl::InvalidArgumentError(
         "Cannot execute QueryLineageSubgraph when `read_mask` is empty.");
@@ -3145,6 +3976,12 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
     }
   }
 
+  MLMD_RETURN_IF_ERROR(ValidateTimeWindow(
+      "event_time_window", lineage_subgraph_query_options.event_time_window()));
+  MLMD_RETURN_IF_ERROR(ValidateTimeWindow(
+      "node_create_time_window",
+      lineage_subgraph_query_options.node_create_time_window()));
+
   // Get ordered ids of starting nodes based on `starting_nodes_filter_query`.
   ListOperationOptions starting_nodes_options;
   starting_nodes_options.set_filter_query(starting_nodes_filter_query);
@@ -3171,57 +4008,85 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
   // Start expanding from the starting artifacts.
   std::vector<int64_t> output_artifact_ids;
   std::vector<int64_t> output_execution_ids;
-  absl::flat_hash_set<int64_t> visited_artifacts_ids;
-  absl::flat_hash_set<int64_t> visited_executions_ids;
+  IdBitmap visited_artifacts_ids;
+  IdBitmap visited_executions_ids;
   std::vector<Event> visited_events;
-  absl::flat_hash_set<int64_t> ending_artifact_ids;
-  absl::flat_hash_set<int64_t> ending_execution_ids;
+  IdBitmap ending_artifact_ids;
+  IdBitmap ending_execution_ids;
+
+  // If `max_nodes` is not positive, sets the nodes budget to max int64_t value
+  // to effectively disable the nodes count limit of the lineage subgraph.
+  const int64_t max_nodes = lineage_subgraph_query_options.max_nodes() > 0
+                                ? lineage_subgraph_query_options.max_nodes()
+                                : std::numeric_limits<int64_t>::max();
+  const bool include_ending_artifacts =
+      lineage_subgraph_query_options.ending_artifacts().include_ending_nodes();
+  const bool include_ending_executions =
+      lineage_subgraph_query_options.ending_executions()
+          .include_ending_nodes();
+  bool truncated = false;
+  IdBitmap starting_node_ids = IdBitmap::FromIds(ConvertToIds(record_set));
+  if (starting_node_ids.size() > max_nodes) {
+    if (is_from_artifacts) {
+      MLMD_RETURN_IF_ERROR(
+          TruncateNodeIdsByRecency<Artifact>(max_nodes, starting_node_ids)
+              .status());
+    } else {
+      MLMD_RETURN_IF_ERROR(
+          TruncateNodeIdsByRecency<Execution>(max_nodes, starting_node_ids)
+              .status());
+    }
+    truncated = true;
+  }
 
   if (is_from_artifacts) {
-    absl::c_copy(ConvertToIds(record_set),
-                 std::back_inserter(output_artifact_ids));
-    absl::c_copy(
-        output_artifact_ids,
-        std::inserter(visited_artifacts_ids, visited_artifacts_ids.end()));
+    output_artifact_ids = starting_node_ids.ToVector();
+    visited_artifacts_ids = starting_node_ids;
     MLMD_ASSIGN_OR_RETURN(ending_artifact_ids,
                           FindEndingNodeIdsIfExists<Artifact>(
                               lineage_subgraph_query_options.ending_artifacts(),
                               visited_artifacts_ids));
-    output_artifact_ids.erase(
-        std::remove_if(
-            output_artifact_ids.begin(), output_artifact_ids.end(),
-            [&](int64_t id) { return ending_artifact_ids.contains(id); }),
-        output_artifact_ids.end());
-
-    absl::erase_if(visited_artifacts_ids, [&](int64_t artifact_id) {
-      return ending_artifact_ids.contains(artifact_id);
-    });
-
+    if (!ending_artifact_ids.empty()) {
+      output_artifact_ids.erase(
+          std::remove_if(
+              output_artifact_ids.begin(), output_artifact_ids.end(),
+              [&](int64_t id) { return ending_artifact_ids.Contains(id); }),
+          output_artifact_ids.end());
+      visited_artifacts_ids.Subtract(ending_artifact_ids);
+    }
   } else {
-    absl::c_copy(ConvertToIds(record_set),
-                 std::back_inserter(output_execution_ids));
-    absl::c_copy(
-        output_execution_ids,
-        std::inserter(visited_executions_ids, visited_executions_ids.end()));
+    output_execution_ids = starting_node_ids.ToVector();
+    visited_executions_ids = starting_node_ids;
     MLMD_ASSIGN_OR_RETURN(
         ending_execution_ids,
         FindEndingNodeIdsIfExists<Execution>(
             lineage_subgraph_query_options.ending_executions(),
             visited_executions_ids));
-    output_execution_ids.erase(
-        std::remove_if(
-            output_execution_ids.begin(), output_execution_ids.end(),
-            [&](int64_t id) { return ending_execution_ids.contains(id); }),
-        output_execution_ids.end());
-
-    absl::erase_if(visited_executions_ids, [&](int64_t execution_id) {
-      return ending_execution_ids.contains(execution_id);
-    });
+    if (!ending_execution_ids.empty()) {
+      output_execution_ids.erase(
+          std::remove_if(
+              output_execution_ids.begin(), output_execution_ids.end(),
+              [&](int64_t id) { return ending_execution_ids.Contains(id); }),
+          output_execution_ids.end());
+      visited_executions_ids.Subtract(ending_execution_ids);
+    }
   }
 
   int64_t curr_distance = 0;
 
   while (curr_distance < max_num_hops) {
+    // The number of nodes the subgraph can still take, as the visited nodes
+    // and the included ending nodes are returned.
+    int64_t num_returned_nodes =
+        visited_artifacts_ids.size() + visited_executions_ids.size();
+    if (include_ending_artifacts) {
+      num_returned_nodes += ending_artifact_ids.size();
+    }
+    if (include_ending_executions) {
+      num_returned_nodes += ending_execution_ids.size();
+    }
+    const int64_t num_remaining_nodes =
+        std::max<int64_t>(max_nodes - num_returned_nodes, 0);
     // If `is_from_artifacts` is true, expand from Artifacts to Executions if
     // `curr_distance` is even, vice versa.
     // If `is_from_artifacts` is false, expand from Executions to Artifacts if
@@ -3235,8 +4100,10 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
               /*expand_from_artifacts=*/expand_from_artifacts,
               /*options=*/lineage_subgraph_query_options,
               /*input_node_ids=*/output_artifact_ids,
+              /*max_num_output_nodes=*/num_remaining_nodes,
               /*visited_output_node_ids=*/visited_executions_ids,
-              /*output_ending_node_ids=*/ending_execution_ids, visited_events));
+              /*output_ending_node_ids=*/ending_execution_ids, visited_events,
+              truncated));
       if (output_execution_ids.empty()) {
         break;
       }
@@ -3247,33 +4114,35 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
               /*expand_from_artifacts=*/expand_from_artifacts,
               /*options=*/lineage_subgraph_query_options,
               /*input_node_ids=*/output_execution_ids,
+              /*max_num_output_nodes=*/num_remaining_nodes,
               /*visited_output_node_ids=*/visited_artifacts_ids,
-              /*output_ending_node_ids=*/ending_artifact_ids, visited_events));
+              /*output_ending_node_ids=*/ending_artifact_ids, visited_events,
+              truncated));
       if (output_artifact_ids.empty()) {
         break;
       }
     }
     curr_distance++;
   }
+  if (is_truncated != nullptr) {
+    *is_truncated = truncated;
+  }
 
   absl::flat_hash_set<std::string> field_mask_paths;
   absl::c_copy(read_mask.paths(),
                std::inserter(field_mask_paths, field_mask_paths.end()));
-  std::vector<int64_t> artifact_ids(visited_artifacts_ids.begin(),
-                                    visited_artifacts_ids.end());
-  std::vector<int64_t> execution_ids(visited_executions_ids.begin(),
-                                     visited_executions_ids.end());
-  // Append ending nodes to return results if possible.
+  // Append ending nodes to return results if possible. Visited nodes and
+  // ending nodes are disjoint, so the union does not introduce duplicates.
   if (lineage_subgraph_query_options.ending_artifacts()
           .include_ending_nodes()) {
-    artifact_ids.insert(artifact_ids.end(), ending_artifact_ids.begin(),
-                        ending_artifact_ids.end());
+    visited_artifacts_ids.UnionWith(ending_artifact_ids);
   }
   if (lineage_subgraph_query_options.ending_executions()
           .include_ending_nodes()) {
-    execution_ids.insert(execution_ids.end(), ending_execution_ids.begin(),
-                         ending_execution_ids.end());
+    visited_executions_ids.UnionWith(ending_execution_ids);
   }
+  const std::vector<int64_t> artifact_ids = visited_artifacts_ids.ToVector();
+  const std::vector<int64_t> execution_ids = visited_executions_ids.ToVector();
   if (field_mask_paths.contains("artifacts")) {
     for (int64_t artifact_id : artifact_ids) {
       subgraph.add_artifacts()->set_id(artifact_id);
@@ -3310,21 +4179,39 @@ absl::Status RDBMSMetadataAccessObject::QueryLineageSubgraph(
     absl::c_copy(associations, google::protobuf::RepeatedFieldBackInserter(
                                    subgraph.mutable_associations()));
   }
+  std::vector<ArtifactType> artifact_types;
+  std::vector<ExecutionType> execution_types;
+  std::vector<ContextType> context_types;
+  if (known_type_catalog_version.has_value()) {
+    // Only reads the types changed after the version, so the cost does not
+    // grow with the size of a type catalog that the client already has.
+    if (field_mask_paths.contains("artifact_types") ||
+        field_mask_paths.contains("execution_types") ||
+        field_mask_paths.contains("context_types")) {
+      MLMD_RETURN_IF_ERROR(FindTypesChangedAfterCatalogVersion(
+          *known_type_catalog_version, &artifact_types, &execution_types,
+          &context_types));
+    }
+  } else {
+    if (field_mask_paths.contains("artifact_types")) {
+      MLMD_RETURN_IF_ERROR(FindTypes(&artifact_types));
+    }
+    if (field_mask_paths.contains("execution_types")) {
+      MLMD_RETURN_IF_ERROR(FindTypes(&execution_types));
+    }
+    if (field_mask_paths.contains("context_types")) {
+      MLMD_RETURN_IF_ERROR(FindTypes(&context_types));
+    }
+  }
   if (field_mask_paths.contains("artifact_types")) {
-    std::vector<ArtifactType> artifact_types;
-    MLMD_RETURN_IF_ERROR(FindTypes(&artifact_types));
     absl::c_copy(artifact_types, google::protobuf::RepeatedFieldBackInserter(
                                      subgraph.mutable_artifact_types()));
   }
   if (field_mask_paths.contains("execution_types")) {
-    std::vector<ExecutionType> execution_types;
-    MLMD_RETURN_IF_ERROR(FindTypes(&execution_types));
     absl::c_copy(execution_types, google::protobuf::RepeatedFieldBackInserter(
                                       subgraph.mutable_execution_types()));
   }
   if (field_mask_paths.contains("context_types")) {
-    std::vector<ContextType> context_types;
-    MLMD_RETURN_IF_ERROR(FindTypes(&context_types));
     absl::c_copy(context_types, google::protobuf::RepeatedFieldBackInserter(
                                     subgraph.mutable_context_types()));
   }
@@ -3336,6 +4223,8 @@ absl::Status RDBMSMetadataAccessObject::DeleteArtifactsById(
   if (artifact_ids.empty()) {
     return absl::OkStatus();
   }
+  MLMD_RETURN_IF_ERROR(
+      UpdateContextSummaries<Artifact>(artifact_ids, /*delta=*/-1));
   return executor_->DeleteArtifactsById(artifact_ids);
 }
 
@@ -3344,6 +4233,8 @@ absl::Status RDBMSMetadataAccessObject::DeleteExecutionsById(
   if (execution_ids.empty()) {
     return absl::OkStatus();
   }
+  MLMD_RETURN_IF_ERROR(
+      UpdateContextSummaries<Execution>(execution_ids, /*delta=*/-1));
   return executor_->DeleteExecutionsById(execution_ids);
 }
 
@@ -3352,7 +4243,11 @@ absl::Status RDBMSMetadataAccessObject::DeleteContextsById(
   if (context_ids.empty()) {
     return absl::OkStatus();
   }
-  return executor_->DeleteContextsById(context_ids);
+  MLMD_RETURN_IF_ERROR(executor_->DeleteContextsById(context_ids));
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->RefreshContextSummaries(context_ids);
 }
 
 absl::Status RDBMSMetadataAccessObject::DeleteEventsByArtifactsId(
@@ -3376,7 +4271,11 @@ absl::Status RDBMSMetadataAccessObject::DeleteAssociationsByContextsId(
   if (context_ids.empty()) {
     return absl::OkStatus();
   }
-  return executor_->DeleteAssociationsByContextsId(context_ids);
+  MLMD_RETURN_IF_ERROR(executor_->DeleteAssociationsByContextsId(context_ids));
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->RefreshContextSummaries(context_ids);
 }
 
 absl::Status RDBMSMetadataAccessObject::DeleteAssociationsByExecutionsId(
@@ -3384,6 +4283,8 @@ absl::Status RDBMSMetadataAccessObject::DeleteAssociationsByExecutionsId(
   if (execution_ids.empty()) {
     return absl::OkStatus();
   }
+  MLMD_RETURN_IF_ERROR(
+      UpdateContextSummaries<Execution>(execution_ids, /*delta=*/-1));
   return executor_->DeleteAssociationsByExecutionsId(execution_ids);
 }
 
@@ -3392,7 +4293,11 @@ absl::Status RDBMSMetadataAccessObject::DeleteAttributionsByContextsId(
   if (context_ids.empty()) {
     return absl::OkStatus();
   }
-  return executor_->DeleteAttributionsByContextsId(context_ids);
+  MLMD_RETURN_IF_ERROR(executor_->DeleteAttributionsByContextsId(context_ids));
+  if (!maintain_context_summaries_) {
+    return absl::OkStatus();
+  }
+  return executor_->RefreshContextSummaries(context_ids);
 }
 
 absl::Status RDBMSMetadataAccessObject::DeleteAttributionsByArtifactsId(
@@ -3400,6 +4305,8 @@ absl::Status RDBMSMetadataAccessObject::DeleteAttributionsByArtifactsId(
   if (artifact_ids.empty()) {
     return absl::OkStatus();
   }
+  MLMD_RETURN_IF_ERROR(
+      UpdateContextSummaries<Artifact>(artifact_ids, /*delta=*/-1));
   return executor_->DeleteAttributionsByArtifactsId(artifact_ids);
 }
 
@@ -40,6 +40,7 @@ limitations under the License.
 #include "ml_metadata/proto/metadata_source.pb.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/util/field_mask_utils.h"
+#include "ml_metadata/util/id_bitmap.h"
 #include "ml_metadata/util/return_utils.h"
 
 namespace ml_metadata {
@@ -266,6 +267,31 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
       absl::Span<const int64_t> type_ids,
       absl::flat_hash_map<int64_t, ContextType>& output_parent_types) final;
 
+  absl::Status FindTypeCatalogVersion(int64_t* catalog_version) final;
+
+  absl::Status FindTypesChangedAfterCatalogVersion(
+      int64_t catalog_version, std::vector<ArtifactType>* artifact_types,
+      std::vector<ExecutionType>* execution_types,
+      std::vector<ContextType>* context_types) final;
+
+  absl::Status IncreaseWriteEpochs(
+      absl::Span<const TypeKind> type_kinds) final;
+
+  absl::Status FindWriteEpochs(int64_t* artifact_write_epoch,
+                               int64_t* execution_write_epoch,
+                               int64_t* context_write_epoch) final;
+
+  absl::Status FindContextSummaries(
+      absl::Span<const int64_t> context_ids,
+      std::vector<ContextSummary>* context_summaries) final;
+
+  absl::Status RebuildContextSummaries(
+      absl::Span<const int64_t> context_ids) final;
+
+  void set_maintain_context_summaries(bool maintain) final {
+    maintain_context_summaries_ = maintain;
+  }
+
   absl::Status CreateArtifact(const Artifact& artifact,
                               bool skip_type_and_property_validation,
                               int64_t* artifact_id) final;
@@ -285,6 +311,10 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
       absl::Span<const int64_t> artifact_ids, std::vector<Artifact>& artifacts,
       std::vector<ArtifactType>& artifact_types) final;
 
+  absl::Status FindArtifactLastUpdateTimesById(
+      absl::Span<const int64_t> artifact_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) final;
+
   absl::Status FindArtifactsByExternalIds(
       absl::Span<absl::string_view> external_ids,
       std::vector<Artifact>* artifacts) final;
@@ -312,9 +342,16 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                                                    absl::string_view name,
                                                    Artifact* artifact) final;
 
+  absl::Status FindArtifactsByTypeIdAndArtifactNames(
+      int64_t type_id, absl::Span<absl::string_view> names,
+      std::vector<Artifact>* artifacts) final;
+
   absl::Status FindArtifactsByURI(absl::string_view uri,
                                   std::vector<Artifact>* artifacts) final;
 
+  absl::Status FindArtifactsByURIs(absl::Span<absl::string_view> uris,
+                                   std::vector<Artifact>* artifacts) final;
+
   absl::Status UpdateArtifact(const Artifact& artifact) final;
 
   absl::Status UpdateArtifact(const Artifact& artifact,
@@ -329,6 +366,11 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                               bool force_update_time,
                               const google::protobuf::FieldMask& mask) final;
 
+  absl::Status UpdateArtifact(const Artifact& artifact,
+                              absl::Time update_timestamp,
+                              const google::protobuf::FieldMask& mask,
+                              const UpdatePrecondition& precondition) final;
+
   absl::Status CreateExecution(const Execution& execution,
                                bool skip_type_and_property_validation,
                                int64_t* execution_id) final;
@@ -344,6 +386,10 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   absl::Status FindExecutionsById(absl::Span<const int64_t> execution_ids,
                                   std::vector<Execution>* executions) final;
 
+  absl::Status FindExecutionLastUpdateTimesById(
+      absl::Span<const int64_t> execution_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) final;
+
   absl::Status FindExecutionsByExternalIds(
       absl::Span<absl::string_view> external_ids,
       std::vector<Execution>* executions) final;
@@ -353,6 +399,10 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   absl::Status FindExecutionByTypeIdAndExecutionName(
       int64_t type_id, absl::string_view name, Execution* execution) final;
 
+  absl::Status FindExecutionsByTypeIdAndExecutionNames(
+      int64_t type_id, absl::Span<absl::string_view> names,
+      std::vector<Execution>* executions) final;
+
   absl::Status FindExecutionsByTypeId(
       int64_t execution_type_id,
       std::optional<ListOperationOptions> list_options,
@@ -373,6 +423,11 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                                bool force_update_time,
                                const google::protobuf::FieldMask& mask) final;
 
+  absl::Status UpdateExecution(const Execution& execution,
+                               absl::Time update_timestamp,
+                               const google::protobuf::FieldMask& mask,
+                               const UpdatePrecondition& precondition) final;
+
   absl::Status CreateContext(const Context& context,
                              bool skip_type_and_property_validation,
                              int64_t* context_id) final;
@@ -387,6 +442,10 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   absl::Status FindContextsById(absl::Span<const int64_t> context_ids,
                                 std::vector<Context>* contexts) final;
 
+  absl::Status FindContextLastUpdateTimesById(
+      absl::Span<const int64_t> context_ids,
+      absl::flat_hash_map<int64_t, int64_t>& last_update_times) final;
+
   absl::Status FindContextsByExternalIds(
       absl::Span<absl::string_view> external_ids,
       std::vector<Context>* contexts) final;
@@ -402,6 +461,10 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                                                  bool id_only,
                                                  Context* context) final;
 
+  absl::Status FindContextsByTypeIdAndContextNames(
+      int64_t type_id, absl::Span<absl::string_view> names,
+      std::vector<Context>* contexts) final;
+
   absl::Status UpdateContext(const Context& context) final;
 
   absl::Status UpdateContext(const Context& context,
@@ -416,6 +479,49 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                              bool force_update_time,
                              const google::protobuf::FieldMask& mask) final;
 
+  absl::Status SetArtifactProperties(
+      absl::Span<const int64_t> artifact_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) final;
+
+  absl::Status SetExecutionProperties(
+      absl::Span<const int64_t> execution_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) final;
+
+  absl::Status SetContextProperties(
+      absl::Span<const int64_t> context_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp) final;
+
+  absl::Status DeleteArtifactProperties(
+      absl::Span<const int64_t> artifact_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) final;
+
+  absl::Status DeleteExecutionProperties(
+      absl::Span<const int64_t> execution_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) final;
+
+  absl::Status DeleteContextProperties(
+      absl::Span<const int64_t> context_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp) final;
+
+  absl::Status ClaimExecutions(
+      absl::string_view type_name, std::optional<absl::string_view> type_version,
+      Execution::State current_state, Execution::State new_state,
+      int64_t max_num_executions,
+      const google::protobuf::Map<std::string, Value>& lease_properties,
+      absl::Time update_timestamp, std::vector<Execution>* executions) final;
+
   absl::Status CreateEvent(const Event& event, int64_t* event_id) final;
 
   absl::Status CreateEvent(const Event& event, bool is_already_validated,
@@ -517,26 +623,35 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   //   away from the starting nodes.
   // b) `direction`: it performs either a single-directional graph traversal or
   //   bidirectional graph traversal based on `direction`.
+  // c) `max_nodes`: it stops adding nodes once the budget is used up, keeping
+  //   the most recently created nodes of the last hop.
   // `read_mask` contains user specified paths of fields that should be included
   // in the output `subgraph`.
   //   If 'artifacts', 'executions', or 'contexts' is specified in `read_mask`,
   //     the dehydrated nodes will be included.
   //   If 'artifact_types', 'execution_types', or 'context_types' is specified
-  //     in `read_mask`, all the node types will be included.
+  //     in `read_mask`, all the node types will be included, or only the
+  //     types changed after `known_type_catalog_version` if it is set.
   //   If 'events', 'associations', or 'attributions' is specified in
   //     `read_mask`, the corresponding edges will be included.
   //   Note: `read_mask` is a mask on fields from `LineageGraph`. Any other
   //   field path such as artifact.id, execution.name will not be supported.
+  // If `is_truncated` is not null, sets it to whether `max_nodes` left out
+  // reachable nodes.
   // Returns INVALID_ARGUMENT error, if no paths are specified in `read_mask`.
   // Returns INVALID_ARGUMENT error, if `starting_nodes` is not specified in
   // `lineage_subgraph_query_options`.
   // Returns INVALID_ARGUMENT error, if `starting_nodes.filter_query` is
   // unspecified or invalid in `lineage_subgraph_query_options`.
+  // Returns FAILED_PRECONDITION error, if `known_type_catalog_version` is set
+  // and the schema has no type catalog.
   // Returns detailed INTERNAL error, if the operation fails.
   absl::Status QueryLineageSubgraph(
       const LineageSubgraphQueryOptions& options,
       const google::protobuf::FieldMask& read_mask,
-      LineageGraph& subgraph) final;
+      std::optional<int64_t> known_type_catalog_version,
+      LineageGraph& subgraph, bool* is_truncated) final;
+  using MetadataAccessObject::QueryLineageSubgraph;
 
 
   // Deletes a list of artifacts by id.
@@ -628,29 +743,54 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   // and can be used to join the information. The 'properties' are returned
   // using the same convention as
   // QueryExecutor::Select{Node}PropertyBy{Node}ID().
+  // If 'properties' is nullptr, the properties are not retrieved.
   template <typename T>
   absl::Status RetrieveNodesById(
       absl::Span<const int64_t> id, RecordSet* header, RecordSet* properties);
 
+  // Sets the last_update_time_since_epoch of the nodes with 'ids' to
+  // 'update_timestamp'.
+  template <typename T>
+  absl::Status RunNodesLastUpdateTimeUpdate(absl::Span<const int64_t> ids,
+                                            absl::Time update_timestamp);
+
+  // Adds `delta` to the counters of the nodes with 'ids' in the summaries of
+  // the contexts they belong to, if the summaries are maintained. Contexts are
+  // not counted in the summaries.
+  template <typename T>
+  absl::Status UpdateContextSummaries(absl::Span<const int64_t> ids,
+                                      int64_t delta);
+
   // Update a Node's assets based on the field mask.
   // If `mask` is empty, update `stored_node` as a whole.
   // If `mask` is not empty, only update fields specified in `mask`.
+  // If `precondition` is not empty, the update is applied only if the stored
+  // node satisfies it, and only writes the attributes in `mask`.
   template <typename Node>
   absl::Status RunMaskedNodeUpdate(
       const Node& node, Node& stored_node, absl::Time update_timestamp,
-      const google::protobuf::FieldMask& mask = {});
+      const google::protobuf::FieldMask& mask = {},
+      const UpdatePrecondition& precondition =
+          UpdatePrecondition::default_instance());
 
   // Update an Artifact's type_id and URI.
   absl::Status RunNodeUpdate(const Artifact& artifact,
-                             absl::Time update_timestamp);
+                             absl::Time update_timestamp,
+                             const UpdatePrecondition& precondition,
+                             int updated_columns);
 
   // Update an Execution's type_id.
   absl::Status RunNodeUpdate(const Execution& execution,
-                             absl::Time update_timestamp);
+                             absl::Time update_timestamp,
+                             const UpdatePrecondition& precondition,
+                             int updated_columns);
 
-  // Update a Context's type id and name.
+  // Update a Context's type id and name. Contexts do not support update
+  // preconditions.
   absl::Status RunNodeUpdate(const Context& context,
-                             absl::Time update_timestamp);
+                             absl::Time update_timestamp,
+                             const UpdatePrecondition& precondition,
+                             int updated_columns);
 
   // Runs a property insertion query for a NodeType.
   template <typename NodeType>
@@ -663,9 +803,26 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   absl::Status UpdateProperty(int64_t node_id, absl::string_view name,
                               const Value& value);
 
-  // Generates a property deletion query for a NodeType.
+  // Generates a property deletion query for a NodeType. Only the property in
+  // the space given by `is_custom_property` is deleted.
   template <typename NodeType>
-  absl::Status DeleteProperty(int64_t node_id, absl::string_view name);
+  absl::Status DeleteProperty(int64_t node_id, absl::string_view name,
+                              bool is_custom_property);
+
+  // Runs one property insertion query for a NodeType, which inserts the
+  // property with the same `value` to all nodes with `node_ids`.
+  template <typename NodeType>
+  absl::Status InsertNodesProperty(absl::Span<const int64_t> node_ids,
+                                   absl::string_view name,
+                                   bool is_custom_property, const Value& value);
+
+  // Runs one property deletion query for a NodeType, which deletes the
+  // properties with `names` in the space given by `is_custom_property` of all
+  // nodes with `node_ids`.
+  template <typename NodeType>
+  absl::Status DeleteNodesProperties(absl::Span<const int64_t> node_ids,
+                                     absl::Span<const std::string> names,
+                                     bool is_custom_property);
 
   // Generates a list of queries for the `curr_properties` (C) based on the
   // given `prev_properties` (P) only for properties associated with names in
@@ -843,6 +1000,27 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
                                       std::vector<Node>& nodes,
                                       std::vector<NodeType>& node_types);
 
+  // Sets properties of the nodes with `node_ids` being one of {`Artifact`,
+  // `Execution`, `Context`}. The stored nodes are read without their
+  // properties to check existence. Their types come with the same read and are
+  // used to validate `properties`. Each property is replaced with one deletion
+  // and one insertion query for all the nodes.
+  template <typename Node, typename NodeType>
+  absl::Status SetNodePropertiesImpl(
+      absl::Span<const int64_t> node_ids,
+      const google::protobuf::Map<std::string, Value>& properties,
+      const google::protobuf::Map<std::string, Value>& custom_properties,
+      absl::Time update_timestamp);
+
+  // Deletes properties of the nodes with `node_ids` being one of {`Artifact`,
+  // `Execution`, `Context`} with one deletion query per property space.
+  template <typename Node, typename NodeType>
+  absl::Status DeleteNodePropertiesImpl(
+      absl::Span<const int64_t> node_ids,
+      absl::Span<const std::string> property_names,
+      absl::Span<const std::string> custom_property_names,
+      absl::Time update_timestamp);
+
   // Updates with masking for a `Node` being one of {`Artifact`, `Execution`,
   // `Context`}.
   // `update_timestamp` should be used as the update time of the Node.
@@ -850,14 +1028,20 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   // updated even if input node is the same as stored node.
   // If `mask` is empty, update the `node` as a whole, otherwise, perform masked
   // update on the `node`.
+  // If `precondition` is not empty, the node is always updated if the stored
+  // node satisfies it, and its `last_update_time_since_epoch` is increased.
   // Returns INVALID_ARGUMENT error, if the node cannot be
   // found Returns INVALID_ARGUMENT error, if the node does not match with its
-  // type Returns detailed INTERNAL error, if query execution fails.
+  // type Returns FAILED_PRECONDITION error, if the stored node does not
+  // satisfy `precondition`. Returns detailed INTERNAL error, if query
+  // execution fails.
   template <typename Node, typename NodeType>
   absl::Status UpdateNodeImpl(const Node& node,
                               absl::Time update_timestamp,
                               bool force_update_time,
-                              const google::protobuf::FieldMask& mask = {});
+                              const google::protobuf::FieldMask& mask = {},
+                              const UpdatePrecondition& precondition =
+                                  UpdatePrecondition::default_instance());
 
   // Takes a record set that has one record per event and for each record:
   //   parses it into an Event object
@@ -866,6 +1050,25 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   absl::Status FindEventsFromRecordSet(const RecordSet& event_record_set,
                                        std::vector<Event>* events);
 
+  // Finds the events of the artifacts with `node_ids` if `by_artifacts` is
+  // true, or of the executions with `node_ids` otherwise, that satisfy the
+  // `event_time_window` in `options`, and whose other node satisfies the
+  // `node_create_time_window` and `execution_states` in `options`. The node
+  // predicates are applied by joining the node table in the event query.
+  // Only finds the events of at most `max_num_nodes` such other nodes after
+  // skipping `offset` ones, the most recently created first and then by
+  // ascending id, and returns them in that order. Without predicates, if
+  // `max_num_nodes` is the max int64_t value, the events of all the other
+  // nodes are found in no particular order.
+  // Returns INVALID_ARGUMENT error, if the `events` is null.
+  // Returns NOT_FOUND error, if no such events are found.
+  // Returns detailed INTERNAL error, if query execution fails.
+  absl::Status FindLineageEvents(bool by_artifacts,
+                                 absl::Span<const int64_t> node_ids,
+                                 const LineageSubgraphQueryOptions& options,
+                                 int64_t max_num_nodes, int64_t offset,
+                                 std::vector<Event>* events);
+
   // Takes a record set that has one record per association and parses it into
   // an Association object for each record.
   // Returns INVALID_ARGUMENT error, if the `associations` is null.
@@ -981,17 +1184,22 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
   //   downsteam hops.
   // If `ending_nodes` is set in `options`, do not expand from those ending
   // nodes.
+  // If `event_time_window`, `node_create_time_window` or `execution_states` is
+  // set in `options`, only follows the events and reaches the output nodes
+  // that satisfy them.
   // Adds events between input nodes and output nodes to `output_events`.
-  // Returns ids of output nodes that are one hop away from input nodes if
-  // expanding the lineage subgraph succeeds.
+  // Returns ids of output nodes that are one hop away from input nodes, in
+  // ascending order, if expanding the lineage subgraph succeeds.
   // Returns an empty list if no events are found for given input nodes.
   // Returns detailed INTERNAL error, if expanding the lineage subgraph fails.
+  // Reaches at most `max_num_output_nodes` new output nodes and included
+  // ending nodes. If more are reachable, keeps the most recently created ones
+  // and sets `is_truncated` to true.
   absl::StatusOr<std::vector<int64_t>> ExpandLineageSubgraphImpl(
       bool expand_from_artifacts, const LineageSubgraphQueryOptions& options,
-      absl::Span<const int64_t> input_node_ids,
-      absl::flat_hash_set<int64_t>& visited_output_node_ids,
-      absl::flat_hash_set<int64_t>& output_ending_node_ids,
-      std::vector<Event>& output_events);
+      absl::Span<const int64_t> input_node_ids, int64_t max_num_output_nodes,
+      IdBitmap& visited_output_node_ids, IdBitmap& output_ending_node_ids,
+      std::vector<Event>& output_events, bool& is_truncated);
 
   // Given `node_filter`, keeps nodes that satisfy the `node_filter`, and
   // removes any nodes that do not satisfy the `node_filter` from
@@ -1004,15 +1212,30 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
       std::optional<absl::string_view> node_filter,
       absl::flat_hash_set<int64_t>& boundary_node_ids);
 
+  // Keeps at most `max_num_nodes` of `node_ids`, preferring the most recently
+  // created nodes and then the smaller ids.
+  // Returns the ids removed from `node_ids`.
+  // Returns detailed INTERNAL error, if query execution fails.
+  template <typename Node>
+  absl::StatusOr<IdBitmap> TruncateNodeIdsByRecency(int64_t max_num_nodes,
+                                                    IdBitmap& node_ids);
+
+  // Given a list of node ids, finds nodes that satisfy `filter_query`.
+  // Returns the ids of those nodes if executing the filter query succeeds.
+  // Returns detailed INTERNAL error, if executing the filter query fails.
+  template <typename Node>
+  absl::StatusOr<IdBitmap> FindNodeIdsByFilterQuery(
+      absl::string_view filter_query, const IdBitmap& candidate_node_ids);
+
   // Given a list of node ids, finds nodes that satisfy the `filter_query` in
   // `ending_nodes`.
   // Returns a list of ending node ids if executing the filter query succeeds.
   // Returns an empty list if no `filter_query` is specified in `ending_nodes`.
   // Returns detailed INTERNAL error, if executing the filter query fails.
   template <typename Node>
-  absl::StatusOr<absl::flat_hash_set<int64_t>> FindEndingNodeIdsIfExists(
+  absl::StatusOr<IdBitmap> FindEndingNodeIdsIfExists(
       const LineageSubgraphQueryOptions::EndingNodes ending_nodes,
-      const absl::flat_hash_set<int64_t>& unvisited_node_ids);
+      const IdBitmap& unvisited_node_ids);
 
   // Find Contexts based on the given artifact_ids and execution_ids.
   // Returns a list of found Contexts if succeeds.
@@ -1023,6 +1246,9 @@ class RDBMSMetadataAccessObject : public MetadataAccessObject {
 
   std::unique_ptr<QueryExecutor> executor_;
 
+  // Whether the writes update the context summaries.
+  bool maintain_context_summaries_ = false;
+
   friend RDBMSMetadataAccessObjectTest;
 };
 
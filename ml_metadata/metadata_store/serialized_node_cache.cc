@@ -0,0 +1,101 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "ml_metadata/metadata_store/constants.h"
+
+namespace ml_metadata {
+
+using ::google::protobuf::internal::WireFormatLite;
+
+std::string SerializedNodeCache::SerializeNode(
+    const google::protobuf::Message& node) {
+  std::string serialized_node;
+  {
+    google::protobuf::io::StringOutputStream string_stream(&serialized_node);
+    google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+    coded_stream.WriteTag(WireFormatLite::MakeTag(
+        kNodesFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+    coded_stream.WriteVarint32(static_cast<uint32_t>(node.ByteSizeLong()));
+    node.SerializeWithCachedSizes(&coded_stream);
+  }
+  return serialized_node;
+}
+
+absl::optional<SerializedNodeCache::CachedNode> SerializedNodeCache::Lookup(
+    TypeKind type_kind, int64_t id) {
+  absl::MutexLock lock(&mutex_);
+  const auto index_it = index_.find(Key(type_kind, id));
+  if (index_it == index_.end()) {
+    num_misses_.fetch_add(1);
+    return absl::nullopt;
+  }
+  num_hits_.fetch_add(1);
+  entries_.splice(entries_.begin(), entries_, index_it->second);
+  return index_it->second->node;
+}
+
+void SerializedNodeCache::Insert(TypeKind type_kind, int64_t id,
+                                 int64_t last_update_time_since_epoch,
+                                 std::shared_ptr<const std::string>
+                                     serialized_node) {
+  const int64_t entry_bytes = serialized_node->size();
+  if (entry_bytes > options_.max_num_bytes) return;
+  Entry entry{Key(type_kind, id), CachedNode{last_update_time_since_epoch,
+                                             std::move(serialized_node)}};
+
+  absl::MutexLock lock(&mutex_);
+  const auto index_it = index_.find(entry.key);
+  if (index_it != index_.end()) {
+    Erase(index_it->second);
+  }
+  while (!entries_.empty() &&
+         num_bytes_ + entry_bytes > options_.max_num_bytes) {
+    Erase(std::prev(entries_.end()));
+  }
+  entries_.push_front(std::move(entry));
+  index_.insert({entries_.front().key, entries_.begin()});
+  num_bytes_ += entry_bytes;
+}
+
+int SerializedNodeCache::num_entries() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+int64_t SerializedNodeCache::num_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return num_bytes_;
+}
+
+void SerializedNodeCache::Erase(EntryList::iterator it) {
+  num_bytes_ -= it->node.serialized_node->size();
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,121 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_SERIALIZED_NODE_CACHE_H_
+#define ML_METADATA_METADATA_STORE_SERIALIZED_NODE_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "google/protobuf/message.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "ml_metadata/metadata_store/constants.h"
+
+namespace ml_metadata {
+
+// Caches the wire format of hydrated nodes, so that responses can be
+// assembled from the cached bytes instead of serializing the nodes again. It
+// is thread-safe.
+//
+// A node is cached together with its last_update_time_since_epoch, which is
+// changed by every update of the node. The cached bytes are only valid if the
+// stored node still has the same last_update_time_since_epoch, which the
+// caller checks before using them. Entries are dropped when the cache is full,
+// least recently used first.
+//
+// Usage example:
+//
+//   SerializedNodeCache cache;
+//   cache.Insert(TypeKind::ARTIFACT_TYPE, artifact.id(),
+//                artifact.last_update_time_since_epoch(),
+//                std::make_shared<const std::string>(
+//                    SerializedNodeCache::SerializeNode(artifact)));
+//   absl::optional<SerializedNodeCache::CachedNode> cached_node =
+//       cache.Lookup(TypeKind::ARTIFACT_TYPE, artifact.id());
+class SerializedNodeCache {
+ public:
+  struct Options {
+    // The maximum total size of the cached nodes.
+    int64_t max_num_bytes = 256 << 20;
+  };
+
+  struct CachedNode {
+    int64_t last_update_time_since_epoch;
+    // The node encoded by SerializeNode.
+    std::shared_ptr<const std::string> serialized_node;
+  };
+
+  // The field number of the nodes in the responses assembled from the cache,
+  // e.g., GetArtifactsByIDResponse.artifacts.
+  static constexpr int kNodesFieldNumber = 1;
+
+  SerializedNodeCache() : SerializedNodeCache(Options()) {}
+  explicit SerializedNodeCache(const Options& options) : options_(options) {}
+
+  // Disallows copy.
+  SerializedNodeCache(const SerializedNodeCache&) = delete;
+  SerializedNodeCache& operator=(const SerializedNodeCache&) = delete;
+
+  // Encodes `node` as the length-delimited field kNodesFieldNumber, so that
+  // the encoded nodes can be appended as is to a serialized response.
+  static std::string SerializeNode(const google::protobuf::Message& node);
+
+  // Returns the cached node of `type_kind` with `id`, if any.
+  absl::optional<CachedNode> Lookup(TypeKind type_kind, int64_t id);
+
+  // Caches `serialized_node`, the encoding of the node of `type_kind` with
+  // `id` and `last_update_time_since_epoch`. Nodes larger than the cache are
+  // not cached.
+  void Insert(TypeKind type_kind, int64_t id,
+              int64_t last_update_time_since_epoch,
+              std::shared_ptr<const std::string> serialized_node);
+
+  int64_t num_hits() const { return num_hits_.load(); }
+  int64_t num_misses() const { return num_misses_.load(); }
+  int num_entries() const;
+  int64_t num_bytes() const;
+
+ private:
+  using Key = std::pair<TypeKind, int64_t>;
+  struct Entry {
+    Key key;
+    CachedNode node;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Drops `it` from the cache.
+  void Erase(EntryList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+
+  std::atomic<int64_t> num_hits_{0};
+  std::atomic<int64_t> num_misses_{0};
+
+  mutable absl::Mutex mutex_;
+  // Ordered by the last use, most recently used first.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<Key, EntryList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_SERIALIZED_NODE_CACHE_H_
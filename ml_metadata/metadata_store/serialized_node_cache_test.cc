@@ -0,0 +1,121 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/serialized_node_cache.h"
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/types/optional.h"
+#include "ml_metadata/metadata_store/constants.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+Artifact ArtifactWithUri(int64_t id, const std::string& uri) {
+  Artifact artifact;
+  artifact.set_id(id);
+  artifact.set_uri(uri);
+  artifact.set_last_update_time_since_epoch(100 + id);
+  return artifact;
+}
+
+TEST(SerializedNodeCacheTest, SerializedNodesAppendToResponses) {
+  GetArtifactsByIDResponse response;
+  response.add_unchanged_artifact_ids(3);
+  std::string serialized_response = response.SerializeAsString();
+  serialized_response += SerializedNodeCache::SerializeNode(
+      ArtifactWithUri(1, "a"));
+  serialized_response += SerializedNodeCache::SerializeNode(
+      ArtifactWithUri(2, "b"));
+
+  GetArtifactsByIDResponse parsed_response;
+  ASSERT_TRUE(parsed_response.ParseFromString(serialized_response));
+  ASSERT_EQ(parsed_response.artifacts_size(), 2);
+  EXPECT_EQ(parsed_response.artifacts(0).uri(), "a");
+  EXPECT_EQ(parsed_response.artifacts(1).uri(), "b");
+  EXPECT_EQ(parsed_response.unchanged_artifact_ids(0), 3);
+
+  GetContextsByIDResponse contexts_response;
+  Context context;
+  context.set_name("c");
+  ASSERT_TRUE(contexts_response.ParseFromString(
+      SerializedNodeCache::SerializeNode(context)));
+  EXPECT_EQ(contexts_response.contexts(0).name(), "c");
+}
+
+TEST(SerializedNodeCacheTest, LookupReturnsInsertedNodes) {
+  SerializedNodeCache cache;
+  EXPECT_EQ(cache.Lookup(TypeKind::ARTIFACT_TYPE, 1), absl::nullopt);
+  const Artifact artifact = ArtifactWithUri(1, "a");
+  cache.Insert(TypeKind::ARTIFACT_TYPE, artifact.id(),
+               artifact.last_update_time_since_epoch(),
+               std::make_shared<const std::string>(
+                   SerializedNodeCache::SerializeNode(artifact)));
+
+  absl::optional<SerializedNodeCache::CachedNode> cached_node =
+      cache.Lookup(TypeKind::ARTIFACT_TYPE, 1);
+  ASSERT_TRUE(cached_node.has_value());
+  EXPECT_EQ(cached_node->last_update_time_since_epoch, 101);
+  EXPECT_EQ(*cached_node->serialized_node,
+            SerializedNodeCache::SerializeNode(artifact));
+  // Nodes of other kinds have their own ids.
+  EXPECT_EQ(cache.Lookup(TypeKind::CONTEXT_TYPE, 1), absl::nullopt);
+  EXPECT_EQ(cache.num_hits(), 1);
+  EXPECT_EQ(cache.num_misses(), 2);
+
+  // Inserting a newer version replaces the node.
+  Artifact updated_artifact = artifact;
+  updated_artifact.set_last_update_time_since_epoch(200);
+  cache.Insert(TypeKind::ARTIFACT_TYPE, updated_artifact.id(),
+               updated_artifact.last_update_time_since_epoch(),
+               std::make_shared<const std::string>(
+                   SerializedNodeCache::SerializeNode(updated_artifact)));
+  EXPECT_EQ(cache.num_entries(), 1);
+  EXPECT_EQ(cache.Lookup(TypeKind::ARTIFACT_TYPE, 1)
+                ->last_update_time_since_epoch,
+            200);
+}
+
+TEST(SerializedNodeCacheTest, DropsLeastRecentlyUsedNodes) {
+  const auto serialized_node = std::make_shared<const std::string>(
+      SerializedNodeCache::SerializeNode(ArtifactWithUri(1, "a")));
+  SerializedNodeCache::Options options;
+  options.max_num_bytes = 2 * serialized_node->size();
+  SerializedNodeCache cache(options);
+  cache.Insert(TypeKind::ARTIFACT_TYPE, 1, 101, serialized_node);
+  cache.Insert(TypeKind::ARTIFACT_TYPE, 2, 102, serialized_node);
+  // Uses node 1, so node 2 is dropped next.
+  ASSERT_TRUE(cache.Lookup(TypeKind::ARTIFACT_TYPE, 1).has_value());
+  cache.Insert(TypeKind::ARTIFACT_TYPE, 3, 103, serialized_node);
+
+  EXPECT_EQ(cache.num_entries(), 2);
+  EXPECT_EQ(cache.num_bytes(), 2 * serialized_node->size());
+  EXPECT_TRUE(cache.Lookup(TypeKind::ARTIFACT_TYPE, 1).has_value());
+  EXPECT_FALSE(cache.Lookup(TypeKind::ARTIFACT_TYPE, 2).has_value());
+  EXPECT_TRUE(cache.Lookup(TypeKind::ARTIFACT_TYPE, 3).has_value());
+
+  // Nodes larger than the cache are not cached.
+  cache.Insert(TypeKind::ARTIFACT_TYPE, 4, 104,
+               std::make_shared<const std::string>(
+                   options.max_num_bytes + 1, 'x'));
+  EXPECT_FALSE(cache.Lookup(TypeKind::ARTIFACT_TYPE, 4).has_value());
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -0,0 +1,156 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/server_stats.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+
+ServerStats::ScopedRequest::ScopedRequest(ScopedRequest&& other)
+    : stats_(other.stats_), id_(other.id_) {
+  other.stats_ = nullptr;
+}
+
+ServerStats::ScopedRequest::~ScopedRequest() {
+  if (stats_ != nullptr) stats_->FinishRequest(id_);
+}
+
+ServerStats::ScopedRequest ServerStats::StartRequest(
+    absl::string_view method, std::vector<std::string> tags) {
+  const absl::Time now = absl::Now();
+  absl::MutexLock lock(&mutex_);
+  const int64_t id = next_request_id_++;
+  in_flight_requests_.insert(
+      {id, Request{std::string(method), now, std::move(tags)}});
+  return ScopedRequest(this, id);
+}
+
+void ServerStats::FinishRequest(int64_t id) {
+  num_served_requests_.fetch_add(1, std::memory_order_relaxed);
+  absl::MutexLock lock(&mutex_);
+  in_flight_requests_.erase(id);
+}
+
+void ServerStats::OnQueryExecuted(absl::string_view query,
+                                  absl::Duration elapsed) {
+  num_executed_statements_.fetch_add(1, std::memory_order_relaxed);
+  const absl::Time now = absl::Now();
+  if (absl::ToInt64Nanoseconds(elapsed) <
+          slow_statement_threshold_nanos_.load(std::memory_order_relaxed) &&
+      absl::ToUnixNanos(now) <
+          slow_statement_threshold_expiry_nanos_.load(
+              std::memory_order_relaxed)) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  const auto position = std::find_if(
+      slowest_statements_.begin(), slowest_statements_.end(),
+      [elapsed](const Statement& s) { return s.elapsed < elapsed; });
+  if (position != slowest_statements_.end() ||
+      slowest_statements_.size() < options_.max_slow_statements) {
+    std::string text(query.substr(0, options_.max_statement_length));
+    if (query.size() > text.size()) {
+      absl::StrAppend(&text, "... (", query.size() - text.size(),
+                      " more bytes)");
+    }
+    slowest_statements_.insert(position,
+                               Statement{std::move(text), elapsed, now});
+    if (slowest_statements_.size() > options_.max_slow_statements) {
+      slowest_statements_.pop_back();
+    }
+  }
+  EvictStatements(now);
+}
+
+void ServerStats::EvictStatements(absl::Time now) {
+  const absl::Time cutoff = now - options_.slow_statement_window;
+  slowest_statements_.erase(
+      std::remove_if(
+          slowest_statements_.begin(), slowest_statements_.end(),
+          [cutoff](const Statement& s) { return s.end_time < cutoff; }),
+      slowest_statements_.end());
+  if (slowest_statements_.size() < options_.max_slow_statements) {
+    slow_statement_threshold_nanos_.store(0, std::memory_order_relaxed);
+    return;
+  }
+  absl::Time earliest_end_time = absl::InfiniteFuture();
+  for (const Statement& statement : slowest_statements_) {
+    earliest_end_time = std::min(earliest_end_time, statement.end_time);
+  }
+  slow_statement_threshold_nanos_.store(
+      absl::ToInt64Nanoseconds(slowest_statements_.back().elapsed),
+      std::memory_order_relaxed);
+  slow_statement_threshold_expiry_nanos_.store(
+      absl::ToUnixNanos(earliest_end_time + options_.slow_statement_window),
+      std::memory_order_relaxed);
+}
+
+void ServerStats::Snapshot(GetServerStatsResponse* response) const {
+  const absl::Time now = absl::Now();
+  response->set_num_served_requests(
+      num_served_requests_.load(std::memory_order_relaxed));
+  response->set_num_executed_statements(
+      num_executed_statements_.load(std::memory_order_relaxed));
+  absl::MutexLock lock(&mutex_);
+  std::vector<std::pair<int64_t, const Request*>> requests;
+  requests.reserve(in_flight_requests_.size());
+  for (const auto& [id, request] : in_flight_requests_) {
+    requests.push_back({id, &request});
+  }
+  // Ids break the ties of requests started at the same time.
+  std::sort(requests.begin(), requests.end(),
+            [](const std::pair<int64_t, const Request*>& a,
+               const std::pair<int64_t, const Request*>& b) {
+              return std::make_pair(a.second->start_time, a.first) <
+                     std::make_pair(b.second->start_time, b.first);
+            });
+  for (const auto& [id, request] : requests) {
+    GetServerStatsResponse::InFlightRequest* in_flight_request =
+        response->add_in_flight_requests();
+    in_flight_request->set_method(request->method);
+    in_flight_request->set_start_time_since_epoch(
+        absl::ToUnixMillis(request->start_time));
+    in_flight_request->set_elapsed_milliseconds(
+        absl::ToInt64Milliseconds(now - request->start_time));
+    for (const std::string& tag : request->tags) {
+      in_flight_request->add_tags(tag);
+    }
+  }
+  response->set_num_open_connections(in_flight_requests_.size());
+  const absl::Time cutoff = now - options_.slow_statement_window;
+  for (const Statement& statement : slowest_statements_) {
+    if (statement.end_time < cutoff) continue;
+    GetServerStatsResponse::Statement* slow_statement =
+        response->add_slowest_statements();
+    slow_statement->set_query(statement.query);
+    slow_statement->set_elapsed_microseconds(
+        absl::ToInt64Microseconds(statement.elapsed));
+    slow_statement->set_end_time_since_epoch(
+        absl::ToUnixMillis(statement.end_time));
+  }
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,135 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_SERVER_STATS_H_
+#define ML_METADATA_METADATA_STORE_SERVER_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+
+// Collects the live state of a metadata store server: the requests being
+// served, and the slowest statements executed recently. It is thread-safe.
+//
+// Usage example:
+//
+//   ServerStats stats;
+//   MetadataSource::SetQueryObserver(&stats);
+//   {
+//     ServerStats::ScopedRequest request =
+//         stats.StartRequest("PutArtifacts", {"my-pipeline"});
+//     // serve the request.
+//   }
+//   GetServerStatsResponse response;
+//   stats.Snapshot(&response);
+class ServerStats : public QueryObserver {
+ public:
+  struct Options {
+    // The maximum number of slowest statements to keep.
+    int max_slow_statements = 20;
+    // Statements executed longer ago than the window are evicted.
+    absl::Duration slow_statement_window = absl::Minutes(10);
+    // Statement text longer than this is truncated.
+    int max_statement_length = 1024;
+  };
+
+  // Marks a request as in-flight until it is destroyed.
+  class ScopedRequest {
+   public:
+    // Creates a request that is not tracked.
+    ScopedRequest() : stats_(nullptr), id_(0) {}
+    ScopedRequest(ScopedRequest&& other);
+    ~ScopedRequest();
+
+    ScopedRequest(const ScopedRequest&) = delete;
+    ScopedRequest& operator=(const ScopedRequest&) = delete;
+    ScopedRequest& operator=(ScopedRequest&&) = delete;
+
+   private:
+    friend class ServerStats;
+    ScopedRequest(ServerStats* stats, int64_t id) : stats_(stats), id_(id) {}
+
+    ServerStats* stats_;
+    int64_t id_;
+  };
+
+  ServerStats() : ServerStats(Options()) {}
+  explicit ServerStats(const Options& options) : options_(options) {}
+
+  // Disallows copy.
+  ServerStats(const ServerStats&) = delete;
+  ServerStats& operator=(const ServerStats&) = delete;
+
+  // Registers a request of gRPC `method` labeled by `tags` as in-flight.
+  ScopedRequest StartRequest(absl::string_view method,
+                             std::vector<std::string> tags);
+
+  void OnQueryExecuted(absl::string_view query,
+                       absl::Duration elapsed) override;
+
+  // Fills `response` with the current state of the server.
+  void Snapshot(GetServerStatsResponse* response) const;
+
+ private:
+  struct Request {
+    std::string method;
+    absl::Time start_time;
+    std::vector<std::string> tags;
+  };
+
+  struct Statement {
+    std::string query;
+    absl::Duration elapsed;
+    absl::Time end_time;
+  };
+
+  void FinishRequest(int64_t id);
+
+  // Drops the statements that ended before `now` - window, and updates the
+  // fast path threshold of OnQueryExecuted.
+  void EvictStatements(absl::Time now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+
+  std::atomic<int64_t> num_served_requests_{0};
+  std::atomic<int64_t> num_executed_statements_{0};
+  // While the slowest list is full and none of it expires, statements faster
+  // than the threshold cannot enter it, so they are counted without taking
+  // the lock.
+  std::atomic<int64_t> slow_statement_threshold_nanos_{0};
+  std::atomic<int64_t> slow_statement_threshold_expiry_nanos_{0};
+
+  mutable absl::Mutex mutex_;
+  int64_t next_request_id_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::flat_hash_map<int64_t, Request> in_flight_requests_
+      ABSL_GUARDED_BY(mutex_);
+  // Sorted by elapsed time, slowest first.
+  std::deque<Statement> slowest_statements_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_SERVER_STATS_H_
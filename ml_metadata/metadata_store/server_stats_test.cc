@@ -0,0 +1,109 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/server_stats.h"
+
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/proto/metadata_store_admin.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+TEST(ServerStatsTest, TracksInFlightRequests) {
+  ServerStats stats;
+  {
+    ServerStats::ScopedRequest put = stats.StartRequest("PutArtifacts", {});
+    ServerStats::ScopedRequest get =
+        stats.StartRequest("GetArtifacts", {"pipeline-a"});
+    GetServerStatsResponse response;
+    stats.Snapshot(&response);
+    ASSERT_EQ(response.in_flight_requests_size(), 2);
+    EXPECT_EQ(response.in_flight_requests(0).method(), "PutArtifacts");
+    EXPECT_EQ(response.in_flight_requests(1).method(), "GetArtifacts");
+    EXPECT_THAT(response.in_flight_requests(1).tags(),
+                ElementsAre("pipeline-a"));
+    EXPECT_EQ(response.num_open_connections(), 2);
+    EXPECT_EQ(response.num_served_requests(), 0);
+  }
+  GetServerStatsResponse response;
+  stats.Snapshot(&response);
+  EXPECT_THAT(response.in_flight_requests(), IsEmpty());
+  EXPECT_EQ(response.num_open_connections(), 0);
+  EXPECT_EQ(response.num_served_requests(), 2);
+}
+
+TEST(ServerStatsTest, MovedRequestFinishesOnce) {
+  ServerStats stats;
+  {
+    ServerStats::ScopedRequest request = stats.StartRequest("PutTypes", {});
+    ServerStats::ScopedRequest moved = std::move(request);
+  }
+  GetServerStatsResponse response;
+  stats.Snapshot(&response);
+  EXPECT_EQ(response.num_served_requests(), 1);
+}
+
+TEST(ServerStatsTest, KeepsSlowestStatements) {
+  ServerStats::Options options;
+  options.max_slow_statements = 2;
+  ServerStats stats(options);
+  stats.OnQueryExecuted("SELECT 1;", absl::Milliseconds(5));
+  stats.OnQueryExecuted("SELECT 2;", absl::Milliseconds(20));
+  stats.OnQueryExecuted("SELECT 3;", absl::Milliseconds(1));
+  stats.OnQueryExecuted("SELECT 4;", absl::Milliseconds(10));
+  GetServerStatsResponse response;
+  stats.Snapshot(&response);
+  EXPECT_EQ(response.num_executed_statements(), 4);
+  ASSERT_EQ(response.slowest_statements_size(), 2);
+  EXPECT_EQ(response.slowest_statements(0).query(), "SELECT 2;");
+  EXPECT_EQ(response.slowest_statements(0).elapsed_microseconds(), 20000);
+  EXPECT_EQ(response.slowest_statements(1).query(), "SELECT 4;");
+}
+
+TEST(ServerStatsTest, TruncatesLongStatements) {
+  ServerStats::Options options;
+  options.max_statement_length = 8;
+  ServerStats stats(options);
+  stats.OnQueryExecuted("SELECT * FROM `Artifact`;", absl::Milliseconds(1));
+  GetServerStatsResponse response;
+  stats.Snapshot(&response);
+  ASSERT_EQ(response.slowest_statements_size(), 1);
+  EXPECT_THAT(response.slowest_statements(0).query(),
+              HasSubstr("SELECT *... (17 more bytes)"));
+}
+
+TEST(ServerStatsTest, EvictsStatementsOutsideWindow) {
+  ServerStats::Options options;
+  options.slow_statement_window = absl::ZeroDuration();
+  ServerStats stats(options);
+  stats.OnQueryExecuted("SELECT 1;", absl::Milliseconds(1));
+  absl::SleepFor(absl::Milliseconds(1));
+  GetServerStatsResponse response;
+  stats.Snapshot(&response);
+  EXPECT_THAT(response.slowest_statements(), IsEmpty());
+  EXPECT_EQ(response.num_executed_statements(), 1);
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -0,0 +1,361 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/snapshot_util.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "ml_metadata/metadata_store/constants.h"
+#include "ml_metadata/metadata_store/metadata_access_object.h"
+#include "ml_metadata/metadata_store/metadata_access_object_factory.h"
+#include "ml_metadata/metadata_store/metadata_source.h"
+#include "ml_metadata/metadata_store/mysql_metadata_source.h"
+#include "ml_metadata/metadata_store/postgresql_metadata_source.h"
+#include "ml_metadata/metadata_store/sqlite_metadata_source.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/util/metadata_source_query_config.h"
+#include "ml_metadata/util/return_utils.h"
+
+namespace ml_metadata {
+namespace {
+
+// The number of rows read from the source and inserted into the snapshot at a
+// time.
+constexpr int kRowsPerBatch = 1000;
+
+// The columns of a table in the snapshot schema.
+struct TableColumns {
+  std::vector<std::string> names;
+  // Whether each column in `names` holds a flag, i.e., it is declared as
+  // BOOLEAN or TINYINT(1).
+  std::vector<bool> is_flag;
+  // Whether each column in `names` is declared as BLOB.
+  std::vector<bool> is_blob;
+  // The indexes in `names` of the primary key columns, in key order.
+  std::vector<int> primary_key;
+};
+
+// Creates the metadata source and sets the query config for `config`.
+absl::Status CreateSourceForConfig(const ConnectionConfig& config,
+                                   std::unique_ptr<MetadataSource>* source,
+                                   MetadataSourceQueryConfig* query_config) {
+  switch (config.config_case()) {
+    case ConnectionConfig::kMysql:
+      *source = std::make_unique<MySqlMetadataSource>(config.mysql());
+      *query_config = util::GetMySqlMetadataSourceQueryConfig();
+      return absl::OkStatus();
+    case ConnectionConfig::kSqlite:
+      *source = std::make_unique<SqliteMetadataSource>(config.sqlite());
+      *query_config = util::GetSqliteMetadataSourceQueryConfig();
+      return absl::OkStatus();
+    case ConnectionConfig::kPostgresql:
+      *source = std::make_unique<PostgreSQLMetadataSource>(config.postgresql());
+      *query_config = util::GetPostgreSQLMetadataSourceQueryConfig();
+      return absl::OkStatus();
+    default:
+      return absl::InvalidArgumentError(
+          "Snapshots can only be created from MySQL, SQLite or PostgreSQL "
+          "stores.");
+  }
+}
+
+// Returns the index of `column_name` in `record_set`.
+absl::StatusOr<int> FindColumn(const RecordSet& record_set,
+                               absl::string_view column_name) {
+  for (int i = 0; i < record_set.column_names_size(); i++) {
+    if (record_set.column_names(i) == column_name) {
+      return i;
+    }
+  }
+  return absl::InternalError(
+      absl::StrCat("Column ", column_name, " is missing in the results."));
+}
+
+// Lists the tables of the sqlite3 database of `snapshot`.
+absl::StatusOr<std::vector<std::string>> ListSnapshotTables(
+    MetadataSource& snapshot) {
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(snapshot.ExecuteQuery(
+      "SELECT `name` FROM `sqlite_master` WHERE `type` = 'table' AND "
+      "`name` NOT LIKE 'sqlite_%' ORDER BY `name`;",
+      &record_set));
+  std::vector<std::string> tables;
+  for (const RecordSet::Record& record : record_set.records()) {
+    tables.push_back(record.values(0));
+  }
+  return tables;
+}
+
+// Reads the columns of `table` from the sqlite3 database of `snapshot`.
+absl::StatusOr<TableColumns> GetSnapshotTableColumns(
+    MetadataSource& snapshot, const std::string& table) {
+  RecordSet record_set;
+  MLMD_RETURN_IF_ERROR(snapshot.ExecuteQuery(
+      absl::StrCat("PRAGMA table_info(`", table, "`);"), &record_set));
+  MLMD_ASSIGN_OR_RETURN(const int name_index, FindColumn(record_set, "name"));
+  MLMD_ASSIGN_OR_RETURN(const int type_index, FindColumn(record_set, "type"));
+  MLMD_ASSIGN_OR_RETURN(const int pk_index, FindColumn(record_set, "pk"));
+  TableColumns columns;
+  // Pairs of (position in the primary key, column index).
+  std::vector<std::pair<int, int>> primary_key;
+  for (const RecordSet::Record& record : record_set.records()) {
+    const int column_index = columns.names.size();
+    columns.names.push_back(record.values(name_index));
+    const std::string& type = record.values(type_index);
+    columns.is_flag.push_back(type == "BOOLEAN" || type == "TINYINT(1)");
+    columns.is_blob.push_back(type == "BLOB");
+    int pk_position = 0;
+    if (!absl::SimpleAtoi(record.values(pk_index), &pk_position)) {
+      return absl::InternalError(
+          absl::StrCat("Invalid primary key position of ", table, ".",
+                       record.values(name_index)));
+    }
+    if (pk_position > 0) {
+      primary_key.push_back({pk_position, column_index});
+    }
+  }
+  std::sort(primary_key.begin(), primary_key.end());
+  for (const auto& [position, column_index] : primary_key) {
+    columns.primary_key.push_back(column_index);
+  }
+  return columns;
+}
+
+// Quotes an identifier for the source. PostgreSQL stores the unquoted
+// identifiers of the MLMD schema in lower case, which unquoted references
+// match.
+std::string QuoteSourceIdentifier(absl::string_view identifier,
+                                  bool is_postgresql) {
+  return is_postgresql ? std::string(identifier)
+                       : absl::StrCat("`", identifier, "`");
+}
+
+// Returns the query that reads the next batch of `table` from the source,
+// following the row `last_record` of the previous batch if it is given. Tables
+// without a primary key are read in one batch.
+std::string BuildSelectBatchQuery(const std::string& table,
+                                  const TableColumns& columns,
+                                  const RecordSet::Record* last_record,
+                                  MetadataSource& source, bool is_postgresql) {
+  std::vector<std::string> column_names;
+  std::vector<std::string> select_list;
+  for (int i = 0; i < columns.names.size(); i++) {
+    column_names.push_back(
+        QuoteSourceIdentifier(columns.names[i], is_postgresql));
+    // PostgreSQL stores bytes as BYTEA, while the other backends store them
+    // in the base64 encoding of MetadataSource::EncodeBytes.
+    select_list.push_back(
+        is_postgresql && columns.is_blob[i]
+            ? absl::StrCat("encode(", column_names.back(), ", 'base64')")
+            : column_names.back());
+  }
+  std::string query =
+      absl::StrCat("SELECT ", absl::StrJoin(select_list, ", "), " FROM ",
+                   QuoteSourceIdentifier(table, is_postgresql));
+  if (columns.primary_key.empty()) {
+    return query;
+  }
+  // Seeks past the last row of the previous batch, i.e., the primary key is
+  // lexicographically greater than the one of `last_record`, so that every
+  // batch is an index range scan.
+  if (last_record != nullptr) {
+    std::vector<std::string> disjuncts;
+    for (int i = 0; i < columns.primary_key.size(); i++) {
+      std::vector<std::string> conjuncts;
+      for (int j = 0; j <= i; j++) {
+        const int column_index = columns.primary_key[j];
+        absl::StrAppend(&conjuncts.emplace_back(),
+                        column_names[column_index], j < i ? " = '" : " > '",
+                        source.EscapeString(last_record->values(column_index)),
+                        "'");
+      }
+      disjuncts.push_back(
+          absl::StrCat("(", absl::StrJoin(conjuncts, " AND "), ")"));
+    }
+    absl::StrAppend(&query, " WHERE ", absl::StrJoin(disjuncts, " OR "));
+  }
+  std::vector<std::string> order_by;
+  for (const int column_index : columns.primary_key) {
+    order_by.push_back(column_names[column_index]);
+  }
+  absl::StrAppend(&query, " ORDER BY ", absl::StrJoin(order_by, ", "),
+                  " LIMIT ", kRowsPerBatch);
+  return query;
+}
+
+// Returns the query that inserts `rows` into `table` of the snapshot.
+std::string BuildInsertQuery(const std::string& table,
+                             const TableColumns& columns,
+                             const RecordSet& rows, MetadataSource& snapshot) {
+  std::vector<std::string> column_names;
+  for (const std::string& name : columns.names) {
+    column_names.push_back(absl::StrCat("`", name, "`"));
+  }
+  std::string query =
+      absl::StrCat("INSERT INTO `", table, "` (",
+                   absl::StrJoin(column_names, ", "), ") VALUES ");
+  for (int i = 0; i < rows.records_size(); i++) {
+    const RecordSet::Record& record = rows.records(i);
+    absl::StrAppend(&query, i > 0 ? ", (" : "(");
+    for (int j = 0; j < record.values_size(); j++) {
+      if (j > 0) {
+        absl::StrAppend(&query, ", ");
+      }
+      const std::string& value = record.values(j);
+      if (value == kMetadataSourceNull) {
+        absl::StrAppend(&query, "NULL");
+      } else if (columns.is_flag[j] && (value == "t" || value == "f")) {
+        // PostgreSQL returns its BOOLEAN columns as 't' and 'f'.
+        absl::StrAppend(&query, value == "t" ? "1" : "0");
+      } else {
+        // Column affinity converts the quoted numbers back to numbers.
+        absl::StrAppend(&query, "'", snapshot.EscapeString(value), "'");
+      }
+    }
+    absl::StrAppend(&query, ")");
+  }
+  absl::StrAppend(&query, ";");
+  return query;
+}
+
+// Replaces the rows of `table` in the snapshot with the rows of the source.
+absl::Status CopyTable(const std::string& table, MetadataSource& source,
+                       bool is_postgresql, MetadataSource& snapshot) {
+  MLMD_ASSIGN_OR_RETURN(const TableColumns columns,
+                        GetSnapshotTableColumns(snapshot, table));
+  // Drops the rows that the schema initialization inserted, e.g., the
+  // MLMDEnv version, which are copied from the source as well.
+  MLMD_RETURN_IF_ERROR(snapshot.ExecuteQuery(
+      absl::StrCat("DELETE FROM `", table, "`;"), nullptr));
+  RecordSet batch;
+  while (true) {
+    const RecordSet::Record* last_record =
+        batch.records_size() > 0
+            ? &batch.records(batch.records_size() - 1)
+            : nullptr;
+    RecordSet next_batch;
+    MLMD_RETURN_IF_ERROR(source.ExecuteQuery(
+        BuildSelectBatchQuery(table, columns, last_record, source,
+                              is_postgresql),
+        &next_batch));
+    if (next_batch.records_size() == 0) {
+      return absl::OkStatus();
+    }
+    MLMD_RETURN_IF_ERROR(snapshot.ExecuteQuery(
+        BuildInsertQuery(table, columns, next_batch, snapshot), nullptr));
+    if (columns.primary_key.empty() ||
+        next_batch.records_size() < kRowsPerBatch) {
+      return absl::OkStatus();
+    }
+    batch = std::move(next_batch);
+  }
+}
+
+// Creates the schema in the empty `snapshot` and copies every table of the
+// source into it. Both sources have open transactions.
+absl::Status CopySchemaAndTables(MetadataSource& source,
+                                 const MetadataSourceQueryConfig& query_config,
+                                 bool is_postgresql,
+                                 MetadataSource& snapshot) {
+  if (is_postgresql) {
+    MLMD_RETURN_IF_ERROR(source.ExecuteQuery(
+        "SET TRANSACTION ISOLATION LEVEL REPEATABLE READ;", nullptr));
+  }
+  std::unique_ptr<MetadataAccessObject> source_access_object;
+  MLMD_RETURN_IF_ERROR(CreateMetadataAccessObject(query_config, &source,
+                                                  &source_access_object));
+  int64_t source_schema_version = 0;
+  const absl::Status schema_status =
+      source_access_object->GetSchemaVersion(&source_schema_version);
+  if (absl::IsNotFound(schema_status)) {
+    return absl::FailedPreconditionError(
+        "The source store has no MLMD schema.");
+  }
+  MLMD_RETURN_IF_ERROR(schema_status);
+  if (source_schema_version != source_access_object->GetLibraryVersion()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "The source store is at schema version ", source_schema_version,
+        ", while the library is at schema version ",
+        source_access_object->GetLibraryVersion(),
+        ". Migrate the source store first."));
+  }
+
+  MLMD_ASSIGN_OR_RETURN(const std::vector<std::string> existing_tables,
+                        ListSnapshotTables(snapshot));
+  if (!existing_tables.empty()) {
+    return absl::FailedPreconditionError(
+        "The snapshot database is not empty.");
+  }
+  std::unique_ptr<MetadataAccessObject> snapshot_access_object;
+  MLMD_RETURN_IF_ERROR(CreateMetadataAccessObject(
+      util::GetSqliteMetadataSourceQueryConfig(), &snapshot,
+      &snapshot_access_object));
+  MLMD_RETURN_IF_ERROR(snapshot_access_object->InitMetadataSource());
+
+  MLMD_ASSIGN_OR_RETURN(const std::vector<std::string> tables,
+                        ListSnapshotTables(snapshot));
+  for (const std::string& table : tables) {
+    MLMD_RETURN_IF_ERROR(CopyTable(table, source, is_postgresql, snapshot));
+  }
+  return snapshot.ExecuteQuery("ANALYZE;", nullptr);
+}
+
+}  // namespace
+
+absl::Status CreateSqliteSnapshot(const ConnectionConfig& source_config,
+                                  const std::string& snapshot_filename_uri) {
+  std::unique_ptr<MetadataSource> source;
+  MetadataSourceQueryConfig query_config;
+  MLMD_RETURN_IF_ERROR(
+      CreateSourceForConfig(source_config, &source, &query_config));
+  const bool is_postgresql =
+      source_config.config_case() == ConnectionConfig::kPostgresql;
+  SqliteMetadataSourceConfig snapshot_config;
+  snapshot_config.set_filename_uri(snapshot_filename_uri);
+  snapshot_config.set_connection_mode(
+      SqliteMetadataSourceConfig::READWRITE_OPENCREATE);
+  SqliteMetadataSource snapshot(snapshot_config);
+
+  MLMD_RETURN_IF_ERROR(source->Connect());
+  MLMD_RETURN_IF_ERROR(snapshot.Connect());
+  MLMD_RETURN_IF_ERROR(source->Begin());
+  absl::Status status = snapshot.Begin();
+  if (!status.ok()) {
+    status.Update(source->Rollback());
+    return status;
+  }
+  status = CopySchemaAndTables(*source, query_config, is_postgresql, snapshot);
+  if (status.ok()) {
+    status = snapshot.Commit();
+  }
+  if (!status.ok()) {
+    status.Update(snapshot.Rollback());
+  }
+  // The source transaction only read, so it is released either way.
+  status.Update(source->Rollback());
+  return status;
+}
+
+}  // namespace ml_metadata
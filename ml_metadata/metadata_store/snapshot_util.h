@@ -0,0 +1,49 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef THIRD_PARTY_ML_METADATA_METADATA_STORE_SNAPSHOT_UTIL_H_
+#define THIRD_PARTY_ML_METADATA_METADATA_STORE_SNAPSHOT_UTIL_H_
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+namespace ml_metadata {
+
+// Copies the store at `source_config` into a new SQLite database at
+// `snapshot_filename_uri`. The snapshot has the same schema as the source, so
+// all the read APIs, filter queries and lineage queries work on it once it is
+// opened with the IMMUTABLE_SNAPSHOT connection mode, which serves the reads
+// from memory-mapped pages without any locking.
+//
+// All the tables are read in one transaction of the source, so the snapshot is
+// consistent as long as the source provides snapshot reads: SQLite and the
+// default REPEATABLE READ isolation of MySQL InnoDB do, and the transaction is
+// switched to REPEATABLE READ for PostgreSQL. Large tables are read in batches
+// ordered by their primary keys, and the snapshot is ANALYZEd before it is
+// committed so that its query plans match the data.
+//
+// Returns INVALID_ARGUMENT error, if `source_config` is not a MySQL, SQLite or
+//   PostgreSQL config.
+// Returns FAILED_PRECONDITION error, if the source schema is not at the schema
+//   version of the library, or if the snapshot database is not empty.
+// Returns detailed INTERNAL error, if connecting or querying either database
+//   fails. The snapshot database is then left empty.
+absl::Status CreateSqliteSnapshot(const ConnectionConfig& source_config,
+                                  const std::string& snapshot_filename_uri);
+
+}  // namespace ml_metadata
+
+#endif  // THIRD_PARTY_ML_METADATA_METADATA_STORE_SNAPSHOT_UTIL_H_
@@ -0,0 +1,218 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/snapshot_util.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/metadata_store_factory.h"
+#include "ml_metadata/metadata_store/test_util.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+namespace ml_metadata {
+namespace testing {
+namespace {
+
+using ::testing::SizeIs;
+
+// More artifacts than rows in a copy batch, so that the tables are copied in
+// several batches.
+constexpr int kNumArtifacts = 2500;
+
+class SnapshotUtilTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    source_filename_ =
+        absl::StrCat(::testing::TempDir(), "/", test_name, "_source.db");
+    snapshot_filename_ =
+        absl::StrCat(::testing::TempDir(), "/", test_name, "_snapshot.db");
+    std::remove(source_filename_.c_str());
+    std::remove(snapshot_filename_.c_str());
+    source_config_.mutable_sqlite()->set_filename_uri(source_filename_);
+    ASSERT_EQ(absl::OkStatus(), CreateMetadataStore(source_config_, &source_));
+  }
+
+  void TearDown() override {
+    source_.reset();
+    std::remove(source_filename_.c_str());
+    std::remove(snapshot_filename_.c_str());
+  }
+
+  // Puts an execution with an input and an output artifact in a context, and
+  // kNumArtifacts more artifacts with properties.
+  void PopulateSource() {
+    PutTypesRequest put_types_request = ParseTextProtoOrDie<PutTypesRequest>(
+        R"pb(
+          artifact_types: {
+            name: 'artifact_type'
+            properties { key: 'p_int' value: INT }
+            properties { key: 'p_bool' value: BOOLEAN }
+          }
+          execution_types: { name: 'execution_type' }
+          context_types: { name: 'context_type' }
+        )pb");
+    PutTypesResponse put_types_response;
+    ASSERT_EQ(absl::OkStatus(),
+              source_->PutTypes(put_types_request, &put_types_response));
+
+    PutExecutionRequest put_execution_request;
+    put_execution_request.mutable_execution()->set_type_id(
+        put_types_response.execution_type_ids(0));
+    put_execution_request.mutable_execution()->set_name("execution");
+    for (const Event::Type event_type : {Event::INPUT, Event::OUTPUT}) {
+      PutExecutionRequest::ArtifactAndEvent* pair =
+          put_execution_request.add_artifact_event_pairs();
+      pair->mutable_artifact()->set_type_id(
+          put_types_response.artifact_type_ids(0));
+      pair->mutable_artifact()->set_uri(
+          absl::StrCat("uri_", Event::Type_Name(event_type)));
+      pair->mutable_event()->set_type(event_type);
+      pair->mutable_event()->mutable_path()->add_steps()->set_key("it's");
+    }
+    Context* context = put_execution_request.add_contexts();
+    context->set_type_id(put_types_response.context_type_ids(0));
+    context->set_name("context");
+    PutExecutionResponse put_execution_response;
+    ASSERT_EQ(absl::OkStatus(), source_->PutExecution(put_execution_request,
+                                                      &put_execution_response));
+
+    PutArtifactsRequest put_artifacts_request;
+    for (int i = 0; i < kNumArtifacts; i++) {
+      Artifact* artifact = put_artifacts_request.add_artifacts();
+      artifact->set_type_id(put_types_response.artifact_type_ids(0));
+      artifact->set_uri(absl::StrCat("uri_", i));
+      (*artifact->mutable_properties())["p_int"].set_int_value(i);
+      (*artifact->mutable_properties())["p_bool"].set_bool_value(i % 2 == 0);
+      (*artifact->mutable_custom_properties())["c_string"].set_string_value(
+          "'quoted'");
+    }
+    PutArtifactsResponse put_artifacts_response;
+    ASSERT_EQ(absl::OkStatus(), source_->PutArtifacts(put_artifacts_request,
+                                                      &put_artifacts_response));
+  }
+
+  // Opens the snapshot with the IMMUTABLE_SNAPSHOT connection mode.
+  std::unique_ptr<MetadataStore> OpenSnapshot() {
+    ConnectionConfig snapshot_config;
+    snapshot_config.mutable_sqlite()->set_filename_uri(snapshot_filename_);
+    snapshot_config.mutable_sqlite()->set_connection_mode(
+        SqliteMetadataSourceConfig::IMMUTABLE_SNAPSHOT);
+    std::unique_ptr<MetadataStore> snapshot;
+    CHECK_EQ(absl::OkStatus(), CreateMetadataStore(snapshot_config, &snapshot));
+    return snapshot;
+  }
+
+  std::string source_filename_;
+  std::string snapshot_filename_;
+  ConnectionConfig source_config_;
+  std::unique_ptr<MetadataStore> source_;
+};
+
+TEST_F(SnapshotUtilTest, SnapshotServesTheSameReads) {
+  PopulateSource();
+  ASSERT_EQ(absl::OkStatus(),
+            CreateSqliteSnapshot(source_config_, snapshot_filename_));
+  std::unique_ptr<MetadataStore> snapshot = OpenSnapshot();
+
+  GetArtifactsResponse source_artifacts, snapshot_artifacts;
+  ASSERT_EQ(absl::OkStatus(), source_->GetArtifacts({}, &source_artifacts));
+  ASSERT_EQ(absl::OkStatus(),
+            snapshot->GetArtifacts({}, &snapshot_artifacts));
+  ASSERT_THAT(snapshot_artifacts.artifacts(), SizeIs(kNumArtifacts + 2));
+  EXPECT_THAT(snapshot_artifacts, EqualsProto(source_artifacts));
+
+  GetEventsByExecutionIDsRequest get_events_request;
+  GetExecutionsResponse executions;
+  ASSERT_EQ(absl::OkStatus(), snapshot->GetExecutions({}, &executions));
+  ASSERT_THAT(executions.executions(), SizeIs(1));
+  get_events_request.add_execution_ids(executions.executions(0).id());
+  GetEventsByExecutionIDsResponse source_events, snapshot_events;
+  ASSERT_EQ(absl::OkStatus(), source_->GetEventsByExecutionIDs(
+                                  get_events_request, &source_events));
+  ASSERT_EQ(absl::OkStatus(), snapshot->GetEventsByExecutionIDs(
+                                  get_events_request, &snapshot_events));
+  EXPECT_THAT(snapshot_events, EqualsProto(source_events));
+
+  const GetArtifactsRequest filter_request =
+      ParseTextProtoOrDie<GetArtifactsRequest>(R"pb(
+        options {
+          max_result_size: 100
+          filter_query: "properties.p_int.int_value < 10 AND "
+                        "properties.p_bool.bool_value = true"
+        }
+      )pb");
+  GetArtifactsResponse source_filtered, snapshot_filtered;
+  ASSERT_EQ(absl::OkStatus(),
+            source_->GetArtifacts(filter_request, &source_filtered));
+  ASSERT_EQ(absl::OkStatus(),
+            snapshot->GetArtifacts(filter_request, &snapshot_filtered));
+  EXPECT_THAT(snapshot_filtered.artifacts(), SizeIs(5));
+  EXPECT_THAT(snapshot_filtered, EqualsProto(source_filtered));
+
+  const GetLineageSubgraphRequest lineage_request =
+      ParseTextProtoOrDie<GetLineageSubgraphRequest>(R"pb(
+        lineage_subgraph_query_options {
+          starting_artifacts { filter_query: "uri = 'uri_INPUT'" }
+          max_num_hops: 2
+        }
+      )pb");
+  GetLineageSubgraphResponse source_lineage, snapshot_lineage;
+  ASSERT_EQ(absl::OkStatus(),
+            source_->GetLineageSubgraph(lineage_request, &source_lineage));
+  ASSERT_EQ(absl::OkStatus(),
+            snapshot->GetLineageSubgraph(lineage_request, &snapshot_lineage));
+  EXPECT_THAT(snapshot_lineage.lineage_subgraph().artifacts(), SizeIs(2));
+  EXPECT_THAT(snapshot_lineage, EqualsProto(source_lineage));
+}
+
+TEST_F(SnapshotUtilTest, SnapshotIsReadOnly) {
+  PopulateSource();
+  ASSERT_EQ(absl::OkStatus(),
+            CreateSqliteSnapshot(source_config_, snapshot_filename_));
+  std::unique_ptr<MetadataStore> snapshot = OpenSnapshot();
+
+  PutArtifactsRequest put_request;
+  put_request.add_artifacts()->set_type_id(1);
+  PutArtifactsResponse put_response;
+  EXPECT_FALSE(snapshot->PutArtifacts(put_request, &put_response).ok());
+}
+
+TEST_F(SnapshotUtilTest, FailsForExistingSnapshot) {
+  ASSERT_EQ(absl::OkStatus(),
+            CreateSqliteSnapshot(source_config_, snapshot_filename_));
+  EXPECT_TRUE(absl::IsFailedPrecondition(
+      CreateSqliteSnapshot(source_config_, snapshot_filename_)));
+}
+
+TEST_F(SnapshotUtilTest, FailsForUnsupportedSource) {
+  ConnectionConfig fake_config;
+  fake_config.mutable_fake_database();
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      CreateSqliteSnapshot(fake_config, snapshot_filename_)));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace ml_metadata
@@ -14,17 +14,25 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/sqlite_metadata_source.h"
 
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <random>
+#include <string>
+#include <utility>
 
 #include <glog/logging.h>
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "ml_metadata/metadata_store/sqlite_metadata_source_util.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/util/return_utils.h"
 #include "sqlite3.h"
 
 namespace ml_metadata {
@@ -41,7 +49,8 @@ constexpr absl::string_view kRollbackTransaction = "ROLLBACK;";
 int GetConnectionFlag(const SqliteMetadataSourceConfig& config) {
   int result = SQLITE_OPEN_URI;
   switch (config.connection_mode()) {
-    case SqliteMetadataSourceConfig::READONLY: {
+    case SqliteMetadataSourceConfig::READONLY:
+    case SqliteMetadataSourceConfig::IMMUTABLE_SNAPSHOT: {
       result |= SQLITE_OPEN_READONLY;
       break;
     }
@@ -59,6 +68,54 @@ int GetConnectionFlag(const SqliteMetadataSourceConfig& config) {
   return result;
 }
 
+// Returns the uri to open the database of `config` with. For
+// IMMUTABLE_SNAPSHOT connections, the `immutable` query parameter is added, and
+// plain filenames are converted to uris first.
+// (see https://www.sqlite.org/uri.html for details)
+std::string GetConnectionUri(const SqliteMetadataSourceConfig& config) {
+  if (config.connection_mode() !=
+      SqliteMetadataSourceConfig::IMMUTABLE_SNAPSHOT) {
+    return config.filename_uri();
+  }
+  std::string uri;
+  if (absl::StartsWith(config.filename_uri(), "file:")) {
+    uri = config.filename_uri();
+  } else {
+    uri = "file:";
+    for (const char c : config.filename_uri()) {
+      switch (c) {
+        case '%':
+          uri += "%25";
+          break;
+        case '?':
+          uri += "%3f";
+          break;
+        case '#':
+          uri += "%23";
+          break;
+        default:
+          uri += c;
+      }
+    }
+  }
+  absl::StrAppend(&uri, absl::StrContains(uri, '?') ? "&" : "?",
+                  "immutable=1");
+  return uri;
+}
+
+// Returns the mmap_size to set for `config`, or -1 to keep the default.
+int64_t GetMmapSize(const SqliteMetadataSourceConfig& config) {
+  if (config.has_mmap_size_bytes()) {
+    return config.mmap_size_bytes();
+  }
+  if (config.connection_mode() ==
+      SqliteMetadataSourceConfig::IMMUTABLE_SNAPSHOT) {
+    // sqlite3 caps the value at its compile-time SQLITE_MAX_MMAP_SIZE.
+    return std::numeric_limits<int64_t>::max();
+  }
+  return -1;
+}
+
 // A set of options when waiting for table locks in a sqlite3_busy_handler.
 // see WaitThenRetry for details.
 struct WaitThenRetryOptions {
@@ -108,12 +165,21 @@ SqliteMetadataSource::SqliteMetadataSource(
         SqliteMetadataSourceConfig::READWRITE_OPENCREATE);
 }
 
+SqliteMetadataSource::SqliteMetadataSource(
+    const SqliteMetadataSourceConfig& config,
+    std::shared_ptr<const std::string> initial_image)
+    : SqliteMetadataSource(config) {
+  if (config_.filename_uri() == kInMemoryConnection) {
+    initial_image_ = std::move(initial_image);
+  }
+}
+
 SqliteMetadataSource::~SqliteMetadataSource() {
   CHECK_EQ(absl::OkStatus(), CloseImpl());
 }
 
 absl::Status SqliteMetadataSource::ConnectImpl() {
-  if (sqlite3_open_v2(config_.filename_uri().c_str(), &db_,
+  if (sqlite3_open_v2(GetConnectionUri(config_).c_str(), &db_,
                       GetConnectionFlag(config_), nullptr) != SQLITE_OK) {
     std::string error_message = sqlite3_errmsg(db_);
     sqlite3_close(db_);
@@ -123,9 +189,65 @@ absl::Status SqliteMetadataSource::ConnectImpl() {
   }
   // required to handle cases when tables are locked when executing queries
   sqlite3_busy_handler(db_, &WaitThenRetry, nullptr);
+  absl::Status status;
+  if (initial_image_ != nullptr) {
+    status = LoadImage(*initial_image_);
+  }
+  const int64_t mmap_size = GetMmapSize(config_);
+  if (status.ok() && mmap_size >= 0) {
+    status = RunStatement(absl::StrCat("PRAGMA mmap_size = ", mmap_size, ";"),
+                          /*results=*/nullptr);
+  }
+  if (!status.ok()) {
+    sqlite3_close(db_);
+    db_ = nullptr;
+  }
+  return status;
+}
+
+absl::Status SqliteMetadataSource::LoadImage(absl::string_view image) {
+  if (image.empty()) {
+    return absl::OkStatus();
+  }
+  // sqlite3 owns the copy from here on, and frees it when the connection is
+  // closed or the image cannot be loaded.
+  auto* buffer = static_cast<unsigned char*>(sqlite3_malloc64(image.size()));
+  if (buffer == nullptr) {
+    return absl::ResourceExhaustedError(
+        "Cannot allocate the sqlite3 database image.");
+  }
+  std::memcpy(buffer, image.data(), image.size());
+  const int error_code = sqlite3_deserialize(
+      db_, "main", buffer, image.size(), image.size(),
+      SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE);
+  if (error_code != SQLITE_OK) {
+    return absl::InternalError(
+        absl::StrCat("Cannot load sqlite3 database image: ",
+                     sqlite3_errstr(error_code)));
+  }
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::string> SqliteMetadataSource::Serialize() {
+  if (db_ == nullptr) {
+    return absl::FailedPreconditionError(
+        "The sqlite3 database is not connected.");
+  }
+  sqlite3_int64 size = 0;
+  unsigned char* data = sqlite3_serialize(db_, "main", &size, /*mFlags=*/0);
+  if (data == nullptr) {
+    // An empty database has no pages to serialize.
+    if (size == 0) {
+      return std::string();
+    }
+    return absl::InternalError(absl::StrCat(
+        "Cannot serialize sqlite3 database: ", sqlite3_errmsg(db_)));
+  }
+  std::string image(reinterpret_cast<const char*>(data), size);
+  sqlite3_free(data);
+  return image;
+}
+
 absl::Status SqliteMetadataSource::CloseImpl() {
   if (db_ != nullptr) {
     int error_code = sqlite3_close(db_);
@@ -140,6 +262,8 @@ absl::Status SqliteMetadataSource::CloseImpl() {
 
 absl::Status SqliteMetadataSource::RunStatement(const std::string& query,
                                                 RecordSet* results = nullptr) {
+  const int64_t total_changes =
+      results != nullptr ? sqlite3_total_changes64(db_) : 0;
   char* error_message;
   if (sqlite3_exec(db_, query.c_str(), &ConvertSqliteResultsToRecordSet,
                    results, &error_message) != SQLITE_OK) {
@@ -152,9 +276,119 @@ absl::Status SqliteMetadataSource::RunStatement(const std::string& query,
     return absl::InternalError(absl::StrCat(
         "Error when executing query: ", error_details, " query: ", query));
   }
+  if (results != nullptr) {
+    const int64_t num_affected_rows =
+        sqlite3_total_changes64(db_) - total_changes;
+    if (num_affected_rows > 0) {
+      results->set_num_affected_rows(num_affected_rows);
+    }
+  }
   return absl::OkStatus();
 }
 
+absl::Status SqliteMetadataSource::Backup(
+    const std::string& destination_filename_uri, const int pages_per_step,
+    const absl::Duration sleep_between_steps, const int max_num_restarts,
+    const BackupProgressCallback& progress_callback, BackupProgress* progress) {
+  if (db_ == nullptr) {
+    return absl::FailedPreconditionError(
+        "The sqlite3 database is not connected.");
+  }
+  if (transaction_open()) {
+    return absl::FailedPreconditionError(
+        "A backup cannot run in a transaction.");
+  }
+  *progress = BackupProgress();
+  RecordSet page_size;
+  MLMD_RETURN_IF_ERROR(RunStatement("PRAGMA page_size;", &page_size));
+  if (page_size.records_size() != 1 ||
+      page_size.records(0).values_size() != 1 ||
+      !absl::SimpleAtoi(page_size.records(0).values(0),
+                        &progress->page_size_bytes)) {
+    return absl::InternalError("Cannot read the sqlite3 page size.");
+  }
+
+  sqlite3* destination = nullptr;
+  if (sqlite3_open_v2(destination_filename_uri.c_str(), &destination,
+                      SQLITE_OPEN_URI | SQLITE_OPEN_READWRITE |
+                          SQLITE_OPEN_CREATE,
+                      nullptr) != SQLITE_OK) {
+    std::string error_message = sqlite3_errmsg(destination);
+    sqlite3_close(destination);
+    return absl::InternalError(absl::StrCat(
+        "Cannot open the backup destination ", destination_filename_uri, ": ",
+        error_message));
+  }
+  // Both names are absolute paths, or empty for in-memory databases.
+  const char* source_filename = sqlite3_db_filename(db_, "main");
+  const char* destination_filename = sqlite3_db_filename(destination, "main");
+  if (source_filename != nullptr && destination_filename != nullptr &&
+      source_filename[0] != '\0' &&
+      std::strcmp(source_filename, destination_filename) == 0) {
+    sqlite3_close(destination);
+    return absl::InvalidArgumentError(absl::StrCat(
+        "The backup destination ", destination_filename_uri,
+        " is the source database."));
+  }
+  sqlite3_backup* backup =
+      sqlite3_backup_init(destination, "main", db_, "main");
+  if (backup == nullptr) {
+    std::string error_message = sqlite3_errmsg(destination);
+    sqlite3_close(destination);
+    return absl::InternalError(
+        absl::StrCat("Cannot start the backup: ", error_message));
+  }
+
+  absl::Status status;
+  const absl::Time start_time = absl::Now();
+  int step_pages = pages_per_step > 0 ? pages_per_step : -1;
+  while (true) {
+    const int64_t previous_num_copied_pages = progress->num_copied_pages;
+    const int error_code = sqlite3_backup_step(backup, step_pages);
+    progress->num_steps++;
+    progress->num_total_pages = sqlite3_backup_pagecount(backup);
+    progress->num_copied_pages =
+        progress->num_total_pages - sqlite3_backup_remaining(backup);
+    progress->elapsed_time = absl::Now() - start_time;
+    // The source or the destination is locked by another connection.
+    const bool locked =
+        error_code == SQLITE_BUSY || error_code == SQLITE_LOCKED;
+    if (error_code != SQLITE_OK && error_code != SQLITE_DONE && !locked) {
+      status = absl::InternalError(absl::StrCat(
+          "Error when backing up sqlite3 database: ",
+          sqlite3_errstr(error_code)));
+      break;
+    }
+    // A step that did not advance the copy started over, as another
+    // connection wrote to the source since the previous step.
+    if (!locked && previous_num_copied_pages > 0 &&
+        progress->num_copied_pages <= previous_num_copied_pages) {
+      progress->num_restarts++;
+      if (progress->num_restarts >= max_num_restarts) {
+        step_pages = -1;
+      }
+    }
+    const bool proceed =
+        progress_callback == nullptr || progress_callback(*progress);
+    if (error_code == SQLITE_DONE) {
+      break;
+    }
+    if (!proceed) {
+      status = absl::CancelledError("The backup is cancelled.");
+      break;
+    }
+    absl::SleepFor(sleep_between_steps);
+  }
+  // Rolls back the destination if the backup did not finish.
+  sqlite3_backup_finish(backup);
+  if (sqlite3_close(destination) != SQLITE_OK && status.ok()) {
+    status = absl::InternalError(
+        absl::StrCat("Cannot close the backup destination ",
+                     destination_filename_uri));
+  }
+  return status;
+}
+
 absl::Status SqliteMetadataSource::ExecuteQueryImpl(const std::string& query,
                                                     RecordSet* results) {
   return RunStatement(query, results);
@@ -177,6 +411,11 @@ std::string SqliteMetadataSource::EscapeString(absl::string_view value) const {
   return SqliteEscapeString(value);
 }
 
+void SqliteMetadataSource::AppendEscapedString(absl::string_view value,
+                                               std::string* output) const {
+  SqliteAppendEscapedString(value, output);
+}
+
 std::string SqliteMetadataSource::EncodeBytes(absl::string_view value) const {
   return SqliteEncodeBytes(value);
 }
@@ -15,8 +15,14 @@ limitations under the License.
 #ifndef ML_METADATA_METADATA_STORE_SQLITE_METADATA_SOURCE_H_
 #define ML_METADATA_METADATA_STORE_SQLITE_METADATA_SOURCE_H_
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "ml_metadata/metadata_store/metadata_source.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "sqlite3.h"
@@ -31,7 +37,33 @@ namespace ml_metadata {
 // same SqliteMetadataSourceConfig to use the same Sqlite3 database.
 class SqliteMetadataSource : public MetadataSource {
  public:
+  // The progress of a Backup().
+  struct BackupProgress {
+    // The number of pages copied so far, out of the pages of the source
+    // database. The copy starts over when another connection writes to the
+    // source, so `num_copied_pages` can go down between steps.
+    int64_t num_copied_pages = 0;
+    int64_t num_total_pages = 0;
+    int64_t page_size_bytes = 0;
+    // The number of steps run so far, including those that found the source
+    // locked.
+    int64_t num_steps = 0;
+    // The number of times the copy started over.
+    int64_t num_restarts = 0;
+    absl::Duration elapsed_time;
+  };
+
+  // Called after each step of a Backup(). Returning false cancels the backup.
+  using BackupProgressCallback = std::function<bool(const BackupProgress&)>;
+
   explicit SqliteMetadataSource(const SqliteMetadataSourceConfig& config);
+
+  // Creates a metadata source whose in-memory database starts as a private copy
+  // of `initial_image`, a database image returned by Serialize(), instead of
+  // an empty database. The image is ignored if `config` uses a database file.
+  SqliteMetadataSource(const SqliteMetadataSourceConfig& config,
+                       std::shared_ptr<const std::string> initial_image);
+
   ~SqliteMetadataSource() override;
 
   // Disallow copy and assign.
@@ -41,6 +73,10 @@ class SqliteMetadataSource : public MetadataSource {
   // Escape strings having single quotes using built-in printf in Sqlite3 C API.
   std::string EscapeString(absl::string_view value) const final;
 
+  // Escapes `value` as EscapeString does directly into `output`.
+  void AppendEscapedString(absl::string_view value,
+                           std::string* output) const final;
+
   // Sqlite doesn't escape certain bytes reliably; this is resolved by
   // base64 encoding bytes for storage and decoding at access
   std::string EncodeBytes(absl::string_view value) const final;
@@ -48,6 +84,35 @@ class SqliteMetadataSource : public MetadataSource {
   // DecodeBytes can return an absl::Status if decoding fails
   absl::StatusOr<std::string> DecodeBytes(absl::string_view value) const final;
 
+  // Returns an image of the connected database in the database file format,
+  // which can be used as the `initial_image` of other metadata sources.
+  // Returns FAILED_PRECONDITION error, if the source is not connected.
+  // Returns INTERNAL error, if sqlite3 fails to serialize the database.
+  absl::StatusOr<std::string> Serialize();
+
+  // Copies the connected database into the database at
+  // `destination_filename_uri` with the sqlite3 online backup API, which
+  // overwrites the destination. The copy runs in steps of `pages_per_step`
+  // pages, or in one step if it is not positive. The source is only locked
+  // while a step runs, and the backup sleeps `sleep_between_steps` between
+  // steps so that writers on other connections can proceed. A write on
+  // another connection restarts the copy, so after `max_num_restarts`
+  // restarts the remaining pages are copied in one step, which blocks the
+  // writers until it is done. `progress` is updated after every step, and
+  // passed to `progress_callback` if given.
+  // Returns INVALID_ARGUMENT error, if the destination is the source database.
+  // Returns FAILED_PRECONDITION error, if the source is not connected, or if a
+  //   transaction is open, which would lock the source for the whole backup.
+  // Returns CANCELLED error, if `progress_callback` cancels the backup.
+  // Returns detailed INTERNAL error, if the destination cannot be opened or
+  //   a step fails.
+  // The destination is left unchanged, unless the backup succeeds.
+  absl::Status Backup(const std::string& destination_filename_uri,
+                      int pages_per_step, absl::Duration sleep_between_steps,
+                      int max_num_restarts,
+                      const BackupProgressCallback& progress_callback,
+                      BackupProgress* progress);
+
  private:
   // Creates an in memory db.
   // If error happens, Returns INTERNAL error.
@@ -73,11 +138,19 @@ class SqliteMetadataSource : public MetadataSource {
   // Util methods to execute query.
   absl::Status RunStatement(const std::string& query, RecordSet* results);
 
+  // Replaces the opened in-memory database with a copy of `image`.
+  // Returns INTERNAL error, if sqlite3 fails to load the image.
+  absl::Status LoadImage(absl::string_view image);
+
   // The sqlite3 handle to a database.
   sqlite3* db_ = nullptr;
 
   // A config including connection parameters.
   SqliteMetadataSourceConfig config_;
+
+  // The image that an in-memory database is loaded from on connection, or
+  // nullptr to start from an empty database.
+  std::shared_ptr<const std::string> initial_image_;
 };
 
 }  // namespace ml_metadata
@@ -14,12 +14,21 @@ limitations under the License.
 ==============================================================================*/
 #include "ml_metadata/metadata_store/sqlite_metadata_source.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <thread>
 
 #include <glog/logging.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "ml_metadata/metadata_store/metadata_source_test_suite.h"
 #include "ml_metadata/metadata_store/test_util.h"
 
@@ -28,6 +37,7 @@ namespace testing {
 
 namespace {
 using ml_metadata::testing::EqualsProto;
+using ml_metadata::testing::ParseTextProtoOrDie;
 
 class SqliteMetadataSourceContainer : public MetadataSourceContainer {
  public:
@@ -86,6 +96,252 @@ TEST(SqliteMetadataSourceExtendedTest, TestEscapeString) {
   EXPECT_EQ(metadata_source->EscapeString("'\"text\"'"), "''\"text\"''");
 }
 
+// Test that sources open private copies of a serialized database.
+TEST(SqliteMetadataSourceExtendedTest, TestSerializeAndLoadImage) {
+  SqliteMetadataSource source((SqliteMetadataSourceConfig()));
+  EXPECT_TRUE(absl::IsFailedPrecondition(source.Serialize().status()));
+  ASSERT_EQ(absl::OkStatus(), source.Connect());
+  ASSERT_EQ(absl::OkStatus(), source.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            source.ExecuteQuery("CREATE TABLE t1 (c1 INT);", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            source.ExecuteQuery("INSERT INTO t1 VALUES (1);", nullptr));
+  ASSERT_EQ(absl::OkStatus(), source.Commit());
+  absl::StatusOr<std::string> image = source.Serialize();
+  ASSERT_EQ(absl::OkStatus(), image.status());
+
+  auto shared_image = std::make_shared<const std::string>(*image);
+  SqliteMetadataSource clone1(SqliteMetadataSourceConfig(), shared_image);
+  SqliteMetadataSource clone2(SqliteMetadataSourceConfig(), shared_image);
+  ASSERT_EQ(absl::OkStatus(), clone1.Connect());
+  ASSERT_EQ(absl::OkStatus(), clone2.Connect());
+  ASSERT_EQ(absl::OkStatus(), clone1.Begin());
+  ASSERT_EQ(absl::OkStatus(), clone2.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            clone1.ExecuteQuery("INSERT INTO t1 VALUES (2);", nullptr));
+
+  RecordSet expected_clone1 = ParseTextProtoOrDie<RecordSet>(
+      R"pb(
+        column_names: "c1"
+        records: { values: "1" }
+        records: { values: "2" }
+      )pb");
+  RecordSet expected_clone2 = ParseTextProtoOrDie<RecordSet>(
+      R"pb(
+        column_names: "c1"
+        records: { values: "1" }
+      )pb");
+  RecordSet actual;
+  ASSERT_EQ(absl::OkStatus(),
+            clone1.ExecuteQuery("SELECT c1 FROM t1 ORDER BY c1;", &actual));
+  EXPECT_THAT(actual, EqualsProto(expected_clone1));
+  actual.Clear();
+  ASSERT_EQ(absl::OkStatus(),
+            clone2.ExecuteQuery("SELECT c1 FROM t1 ORDER BY c1;", &actual));
+  EXPECT_THAT(actual, EqualsProto(expected_clone2));
+  ASSERT_EQ(absl::OkStatus(), clone1.Commit());
+  ASSERT_EQ(absl::OkStatus(), clone2.Commit());
+}
+
+// Test that Backup copies the database in steps and reports its progress.
+TEST(SqliteMetadataSourceExtendedTest, TestBackup) {
+  SqliteMetadataSource source((SqliteMetadataSourceConfig()));
+  ASSERT_EQ(absl::OkStatus(), source.Connect());
+  ASSERT_EQ(absl::OkStatus(), source.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            source.ExecuteQuery("CREATE TABLE t1 (c1 INT, c2 TEXT);", nullptr));
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(absl::OkStatus(),
+              source.ExecuteQuery(
+                  absl::StrCat("INSERT INTO t1 VALUES (", i, ", '",
+                               std::string(1000, 'x'), "');"),
+                  nullptr));
+  }
+  SqliteMetadataSource::BackupProgress progress;
+  EXPECT_TRUE(absl::IsFailedPrecondition(
+      source.Backup("unused.db", /*pages_per_step=*/1, absl::ZeroDuration(),
+                    /*max_num_restarts=*/3, /*progress_callback=*/nullptr,
+                    &progress)));
+  ASSERT_EQ(absl::OkStatus(), source.Commit());
+
+  const std::string destination =
+      absl::StrCat(::testing::TempDir(), "/TestBackup.db");
+  int num_callbacks = 0;
+  auto count_callbacks =
+      [&num_callbacks](
+          const SqliteMetadataSource::BackupProgress& step_progress) {
+        num_callbacks++;
+        return true;
+      };
+  ASSERT_EQ(absl::OkStatus(),
+            source.Backup(destination, /*pages_per_step=*/10,
+                          absl::ZeroDuration(), /*max_num_restarts=*/3,
+                          count_callbacks, &progress));
+  EXPECT_GT(progress.num_total_pages, 10);
+  EXPECT_EQ(progress.num_copied_pages, progress.num_total_pages);
+  EXPECT_GT(progress.page_size_bytes, 0);
+  EXPECT_GT(progress.num_steps, 1);
+  EXPECT_EQ(num_callbacks, progress.num_steps);
+
+  SqliteMetadataSourceConfig backup_config;
+  backup_config.set_filename_uri(destination);
+  backup_config.set_connection_mode(SqliteMetadataSourceConfig::READONLY);
+  SqliteMetadataSource backup(backup_config);
+  ASSERT_EQ(absl::OkStatus(), backup.Connect());
+  ASSERT_EQ(absl::OkStatus(), backup.Begin());
+  RecordSet actual;
+  ASSERT_EQ(absl::OkStatus(),
+            backup.ExecuteQuery("SELECT COUNT(*) FROM t1;", &actual));
+  ASSERT_EQ(absl::OkStatus(), backup.Commit());
+  ASSERT_EQ(actual.records_size(), 1);
+  EXPECT_EQ(actual.records(0).values(0), "100");
+
+  // The callback cancels the backup after the first step.
+  const std::string cancelled_destination =
+      absl::StrCat(::testing::TempDir(), "/TestBackupCancelled.db");
+  EXPECT_TRUE(absl::IsCancelled(source.Backup(
+      cancelled_destination, /*pages_per_step=*/1, absl::ZeroDuration(),
+      /*max_num_restarts=*/3,
+      [](const SqliteMetadataSource::BackupProgress& step_progress) {
+        return false;
+      },
+      &progress)));
+  EXPECT_EQ(progress.num_steps, 1);
+}
+
+// Creates the table t1 with `num_rows` rows of 1KB in `source`.
+void CreateTable(SqliteMetadataSource& source, int num_rows) {
+  ASSERT_EQ(absl::OkStatus(), source.Begin());
+  ASSERT_EQ(absl::OkStatus(),
+            source.ExecuteQuery("DROP TABLE IF EXISTS t1;", nullptr));
+  ASSERT_EQ(absl::OkStatus(),
+            source.ExecuteQuery("CREATE TABLE t1 (c1 INT, c2 TEXT);", nullptr));
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_EQ(absl::OkStatus(),
+              source.ExecuteQuery(
+                  absl::StrCat("INSERT INTO t1 VALUES (", i, ", '",
+                               std::string(1000, 'x'), "');"),
+                  nullptr));
+  }
+  ASSERT_EQ(absl::OkStatus(), source.Commit());
+}
+
+// Inserts a row into t1 of `source` in a transaction of its own.
+absl::Status InsertRow(SqliteMetadataSource& source) {
+  absl::Status status = source.Begin();
+  if (!status.ok()) return status;
+  status = source.ExecuteQuery("INSERT INTO t1 VALUES (-1, 'x');", nullptr);
+  if (status.ok()) status = source.Commit();
+  if (!status.ok()) source.Rollback().IgnoreError();
+  return status;
+}
+
+// Returns the number of rows of t1 in the database at `filename_uri`.
+int64_t CountRows(const std::string& filename_uri) {
+  SqliteMetadataSourceConfig config;
+  config.set_filename_uri(filename_uri);
+  config.set_connection_mode(SqliteMetadataSourceConfig::READONLY);
+  SqliteMetadataSource source(config);
+  CHECK_EQ(absl::OkStatus(), source.Connect());
+  CHECK_EQ(absl::OkStatus(), source.Begin());
+  RecordSet actual;
+  CHECK_EQ(absl::OkStatus(),
+           source.ExecuteQuery("SELECT COUNT(*) FROM t1;", &actual));
+  CHECK_EQ(absl::OkStatus(), source.Commit());
+  int64_t num_rows;
+  CHECK(absl::SimpleAtoi(actual.records(0).values(0), &num_rows));
+  return num_rows;
+}
+
+TEST(SqliteMetadataSourceExtendedTest, TestBackupToSourceIsRejected) {
+  SqliteMetadataSourceConfig config;
+  config.set_filename_uri(
+      absl::StrCat(::testing::TempDir(), "/TestBackupToSource.db"));
+  SqliteMetadataSource source(config);
+  ASSERT_EQ(absl::OkStatus(), source.Connect());
+  CreateTable(source, /*num_rows=*/10);
+  SqliteMetadataSource::BackupProgress progress;
+  EXPECT_TRUE(absl::IsInvalidArgument(source.Backup(
+      absl::StrCat("file:", config.filename_uri()), /*pages_per_step=*/1,
+      absl::ZeroDuration(), /*max_num_restarts=*/3,
+      /*progress_callback=*/nullptr, &progress)));
+  EXPECT_EQ(CountRows(config.filename_uri()), 10);
+}
+
+// Test that writes on another connection restart the backup at most
+// `max_num_restarts` times before the rest is copied in one step.
+TEST(SqliteMetadataSourceExtendedTest, TestBackupCapsRestarts) {
+  SqliteMetadataSourceConfig config;
+  config.set_filename_uri(
+      absl::StrCat(::testing::TempDir(), "/TestBackupCapsRestarts.db"));
+  SqliteMetadataSource source(config);
+  ASSERT_EQ(absl::OkStatus(), source.Connect());
+  CreateTable(source, /*num_rows=*/100);
+  SqliteMetadataSource writer(config);
+  ASSERT_EQ(absl::OkStatus(), writer.Connect());
+
+  // Every step is followed by a write, which restarts the next step.
+  int num_writes = 0;
+  const std::string destination =
+      absl::StrCat(::testing::TempDir(), "/TestBackupCapsRestarts.backup.db");
+  SqliteMetadataSource::BackupProgress progress;
+  ASSERT_EQ(absl::OkStatus(),
+            source.Backup(
+                destination, /*pages_per_step=*/1, absl::ZeroDuration(),
+                /*max_num_restarts=*/2,
+                [&writer, &num_writes](
+                    const SqliteMetadataSource::BackupProgress&) {
+                  num_writes++;
+                  return InsertRow(writer).ok();
+                },
+                &progress));
+  EXPECT_EQ(progress.num_restarts, 2);
+  EXPECT_EQ(progress.num_steps, 4);
+  EXPECT_EQ(progress.num_copied_pages, progress.num_total_pages);
+  // The last write follows the last step.
+  EXPECT_EQ(CountRows(destination), 100 + num_writes - 1);
+}
+
+// Test that a backup completes with a consistent copy while another thread
+// keeps writing to the source.
+TEST(SqliteMetadataSourceExtendedTest, TestBackupWithConcurrentWrites) {
+  SqliteMetadataSourceConfig config;
+  config.set_filename_uri(
+      absl::StrCat(::testing::TempDir(), "/TestBackupWithWrites.db"));
+  SqliteMetadataSource source(config);
+  ASSERT_EQ(absl::OkStatus(), source.Connect());
+  CreateTable(source, /*num_rows=*/100);
+
+  std::atomic<bool> done(false);
+  std::atomic<int64_t> num_writes(0);
+  std::thread writer_thread([&config, &done, &num_writes]() {
+    SqliteMetadataSource writer(config);
+    CHECK_EQ(absl::OkStatus(), writer.Connect());
+    while (!done) {
+      if (InsertRow(writer).ok()) num_writes++;
+    }
+  });
+  // Waits for the writer, so that the backup runs under writes.
+  while (num_writes == 0) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  const std::string destination =
+      absl::StrCat(::testing::TempDir(), "/TestBackupWithWrites.backup.db");
+  SqliteMetadataSource::BackupProgress progress;
+  const absl::Status status = source.Backup(
+      destination, /*pages_per_step=*/1, absl::ZeroDuration(),
+      /*max_num_restarts=*/3, /*progress_callback=*/nullptr, &progress);
+  done = true;
+  writer_thread.join();
+
+  ASSERT_EQ(absl::OkStatus(), status);
+  EXPECT_LE(progress.num_restarts, 3);
+  EXPECT_EQ(progress.num_copied_pages, progress.num_total_pages);
+  const int64_t num_backed_up_rows = CountRows(destination);
+  EXPECT_GE(num_backed_up_rows, 100);
+  EXPECT_LE(num_backed_up_rows, 100 + num_writes);
+}
+
 }  // namespace
 
 INSTANTIATE_TEST_SUITE_P(
@@ -32,6 +32,16 @@ std::string SqliteEscapeString(absl::string_view value) {
   return result;
 }
 
+void SqliteAppendEscapedString(absl::string_view value, std::string* output) {
+  // Same as the `%q` conversion: single quotes are doubled, and the value ends
+  // at the first NUL character.
+  for (const char c : value) {
+    if (c == '\0') break;
+    if (c == '\'') output->push_back('\'');
+    output->push_back(c);
+  }
+}
+
 // Encode bytes to workaround escaping difficulties.
 std::string SqliteEncodeBytes(absl::string_view value) {
   return absl::Base64Escape(value);
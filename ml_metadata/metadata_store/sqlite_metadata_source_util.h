@@ -25,6 +25,10 @@ namespace ml_metadata {
 // Escapes strings having single quotes using built-in printf in Sqlite3 C API.
 std::string SqliteEscapeString(absl::string_view value);
 
+// Appends `value` escaped as SqliteEscapeString does to `output`, without
+// allocating an intermediate buffer.
+void SqliteAppendEscapedString(absl::string_view value, std::string* output);
+
 // Encode bytes values before binding to queries.
 std::string SqliteEncodeBytes(absl::string_view value);
 
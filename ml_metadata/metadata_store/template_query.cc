@@ -0,0 +1,104 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/template_query.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+
+namespace ml_metadata {
+
+CompiledTemplateQuery::CompiledTemplateQuery(
+    const MetadataSourceQueryConfig::TemplateQuery& template_query)
+    : CompiledTemplateQuery(template_query.query(),
+                            template_query.parameter_num()) {}
+
+CompiledTemplateQuery::CompiledTemplateQuery(absl::string_view query,
+                                             int parameter_num)
+    : query_(query), parameter_num_(parameter_num) {
+  size_t literal_begin = 0;
+  for (size_t i = 0; i + 1 < query_.size(); ++i) {
+    if (query_[i] != '$') continue;
+    const char next = query_[i + 1];
+    if (next < '0' || next > '9' || next - '0' >= parameter_num_) continue;
+    if (i > literal_begin) {
+      segments_.push_back({literal_begin, i - literal_begin, -1});
+      literal_size_ += i - literal_begin;
+    }
+    segments_.push_back({i, 2, next - '0'});
+    literal_begin = i + 2;
+    ++i;
+  }
+  if (literal_begin < query_.size()) {
+    segments_.push_back({literal_begin, query_.size() - literal_begin, -1});
+    literal_size_ += query_.size() - literal_begin;
+  }
+}
+
+size_t CompiledTemplateQuery::ComposedSize(
+    absl::Span<const std::string> parameters) const {
+  size_t size = literal_size_;
+  for (const Segment& segment : segments_) {
+    if (segment.parameter_index >= 0) {
+      size += parameters[segment.parameter_index].size();
+    }
+  }
+  return size;
+}
+
+void CompiledTemplateQuery::ComposeInto(
+    absl::Span<const std::string> parameters, std::string* output) const {
+  CHECK_EQ(parameters.size(), parameter_num_);
+  output->clear();
+  output->reserve(ComposedSize(parameters));
+  for (const Segment& segment : segments_) {
+    if (segment.parameter_index >= 0) {
+      output->append(parameters[segment.parameter_index]);
+    } else {
+      output->append(query_, segment.offset, segment.length);
+    }
+  }
+}
+
+CompiledTemplateQueryMap CompileTemplateQueries(
+    const MetadataSourceQueryConfig& query_config) {
+  const google::protobuf::Reflection* reflection =
+      query_config.GetReflection();
+  std::vector<const google::protobuf::FieldDescriptor*> fields;
+  reflection->ListFields(query_config, &fields);
+  CompiledTemplateQueryMap compiled_queries;
+  for (const google::protobuf::FieldDescriptor* field : fields) {
+    if (field->is_repeated() ||
+        field->message_type() !=
+            MetadataSourceQueryConfig::TemplateQuery::descriptor()) {
+      continue;
+    }
+    const auto& template_query =
+        static_cast<const MetadataSourceQueryConfig::TemplateQuery&>(
+            reflection->GetMessage(query_config, field));
+    compiled_queries.emplace(&template_query,
+                             CompiledTemplateQuery(template_query));
+  }
+  return compiled_queries;
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,85 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_TEMPLATE_QUERY_H_
+#define ML_METADATA_METADATA_STORE_TEMPLATE_QUERY_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+
+namespace ml_metadata {
+
+// A TemplateQuery split once into literal and `$n` placeholder segments, so
+// that a query can be composed in a single pass over the segments instead of
+// a search-and-replace over the whole template text.
+//
+// Placeholders are `$0` to `$9` with an index less than `parameter_num`; any
+// other `$` is kept as literal text. A composed query is byte-for-byte equal
+// to absl::StrReplaceAll of the template with {"$i", parameters[i]}.
+class CompiledTemplateQuery {
+ public:
+  explicit CompiledTemplateQuery(
+      const MetadataSourceQueryConfig::TemplateQuery& template_query);
+
+  CompiledTemplateQuery(absl::string_view query, int parameter_num);
+
+  int parameter_num() const { return parameter_num_; }
+
+  // Returns the size in bytes of the query composed with `parameters`.
+  size_t ComposedSize(absl::Span<const std::string> parameters) const;
+
+  // Replaces the content of `output` with the query composed with
+  // `parameters`. The capacity of `output` is reused, so a long-lived buffer
+  // stops allocating once it has grown to the largest composed query.
+  // `parameters` must have exactly parameter_num() elements.
+  void ComposeInto(absl::Span<const std::string> parameters,
+                   std::string* output) const;
+
+ private:
+  // A slice of `query_`, or a placeholder if `parameter_index` is not
+  // negative.
+  struct Segment {
+    size_t offset;
+    size_t length;
+    int parameter_index;
+  };
+
+  std::string query_;
+  int parameter_num_;
+  // Total length of the literal segments.
+  size_t literal_size_ = 0;
+  std::vector<Segment> segments_;
+};
+
+// Compiled templates of a MetadataSourceQueryConfig, keyed by the address of
+// the TemplateQuery field inside the config they were compiled from.
+using CompiledTemplateQueryMap =
+    absl::flat_hash_map<const MetadataSourceQueryConfig::TemplateQuery*,
+                        CompiledTemplateQuery>;
+
+// Compiles every singular TemplateQuery field set in `query_config`. The keys
+// of the returned map point into `query_config`, which must outlive it and
+// must not be modified.
+CompiledTemplateQueryMap CompileTemplateQueries(
+    const MetadataSourceQueryConfig& query_config);
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_TEMPLATE_QUERY_H_
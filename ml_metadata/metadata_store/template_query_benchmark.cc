@@ -0,0 +1,152 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Microbenchmarks of composing the most frequently executed template queries,
+// comparing CompiledTemplateQuery with absl::StrReplaceAll over the template.
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
+#include "ml_metadata/metadata_store/template_query.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+#include "ml_metadata/util/metadata_source_query_config.h"
+
+namespace ml_metadata {
+namespace {
+
+using TemplateQuery = MetadataSourceQueryConfig::TemplateQuery;
+
+const MetadataSourceQueryConfig& QueryConfig() {
+  static const auto* config = new MetadataSourceQueryConfig(
+      util::GetMySqlMetadataSourceQueryConfig());
+  return *config;
+}
+
+// Returns an IN-list of `num_ids` ids, as bound by the query executors.
+std::string IdList(int num_ids) {
+  std::vector<int64_t> ids;
+  for (int64_t i = 0; i < num_ids; ++i) ids.push_back(1000000 + i);
+  return absl::StrJoin(ids, ", ");
+}
+
+void ComposeWithReplaceAll(benchmark::State& state,
+                           const TemplateQuery& template_query,
+                           const std::vector<std::string>& parameters) {
+  for (auto _ : state) {
+    std::vector<std::pair<const std::string, const std::string>> replacements;
+    replacements.reserve(parameters.size());
+    for (int i = 0; i < parameters.size(); i++) {
+      replacements.push_back({absl::StrCat("$", i), parameters[i]});
+    }
+    std::string query =
+        absl::StrReplaceAll(template_query.query(), replacements);
+    benchmark::DoNotOptimize(query);
+  }
+}
+
+void ComposeCompiled(benchmark::State& state,
+                     const TemplateQuery& template_query,
+                     const std::vector<std::string>& parameters) {
+  const CompiledTemplateQuery compiled_query(template_query);
+  std::string buffer;
+  for (auto _ : state) {
+    compiled_query.ComposeInto(parameters, &buffer);
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+
+std::vector<std::string> SelectByIdParameters(const benchmark::State& state) {
+  return {IdList(state.range(0))};
+}
+
+std::vector<std::string> InsertPropertyParameters() {
+  return {"string_value", "1234567", "'span_name'", "0",
+          "'a moderately long custom property value'"};
+}
+
+std::vector<std::string> UpdateArtifactParameters() {
+  return {"1234567", "12", "'gs://bucket/pipeline/run/output/artifact'",
+          "2",       "NULL", "1700000000000"};
+}
+
+void BM_SelectArtifactsById_ReplaceAll(benchmark::State& state) {
+  ComposeWithReplaceAll(state, QueryConfig().select_artifact_by_id(),
+                        SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectArtifactsById_ReplaceAll)->Arg(1)->Arg(100)->Arg(10000);
+
+void BM_SelectArtifactsById_Compiled(benchmark::State& state) {
+  ComposeCompiled(state, QueryConfig().select_artifact_by_id(),
+                  SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectArtifactsById_Compiled)->Arg(1)->Arg(100)->Arg(10000);
+
+void BM_SelectArtifactPropertyById_ReplaceAll(benchmark::State& state) {
+  ComposeWithReplaceAll(
+      state, QueryConfig().select_artifact_property_by_artifact_id(),
+      SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectArtifactPropertyById_ReplaceAll)->Arg(1)->Arg(100);
+
+void BM_SelectArtifactPropertyById_Compiled(benchmark::State& state) {
+  ComposeCompiled(state,
+                  QueryConfig().select_artifact_property_by_artifact_id(),
+                  SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectArtifactPropertyById_Compiled)->Arg(1)->Arg(100);
+
+void BM_InsertArtifactProperty_ReplaceAll(benchmark::State& state) {
+  ComposeWithReplaceAll(state, QueryConfig().insert_artifact_property(),
+                        InsertPropertyParameters());
+}
+BENCHMARK(BM_InsertArtifactProperty_ReplaceAll);
+
+void BM_InsertArtifactProperty_Compiled(benchmark::State& state) {
+  ComposeCompiled(state, QueryConfig().insert_artifact_property(),
+                  InsertPropertyParameters());
+}
+BENCHMARK(BM_InsertArtifactProperty_Compiled);
+
+void BM_UpdateArtifact_ReplaceAll(benchmark::State& state) {
+  ComposeWithReplaceAll(state, QueryConfig().update_artifact(),
+                        UpdateArtifactParameters());
+}
+BENCHMARK(BM_UpdateArtifact_ReplaceAll);
+
+void BM_UpdateArtifact_Compiled(benchmark::State& state) {
+  ComposeCompiled(state, QueryConfig().update_artifact(),
+                  UpdateArtifactParameters());
+}
+BENCHMARK(BM_UpdateArtifact_Compiled);
+
+void BM_SelectEventByArtifactIds_ReplaceAll(benchmark::State& state) {
+  ComposeWithReplaceAll(state, QueryConfig().select_event_by_artifact_ids(),
+                        SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectEventByArtifactIds_ReplaceAll)->Arg(1)->Arg(100);
+
+void BM_SelectEventByArtifactIds_Compiled(benchmark::State& state) {
+  ComposeCompiled(state, QueryConfig().select_event_by_artifact_ids(),
+                  SelectByIdParameters(state));
+}
+BENCHMARK(BM_SelectEventByArtifactIds_Compiled)->Arg(1)->Arg(100);
+
+}  // namespace
+}  // namespace ml_metadata
+
+BENCHMARK_MAIN();
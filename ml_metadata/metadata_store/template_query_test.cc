@@ -0,0 +1,101 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/template_query.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "ml_metadata/proto/metadata_source.pb.h"
+#include "ml_metadata/util/metadata_source_query_config.h"
+
+namespace ml_metadata {
+namespace {
+
+// Composes `query` the way the query executors did before templates were
+// compiled, as the reference for CompiledTemplateQuery.
+std::string ReplaceAll(absl::string_view query,
+                       const std::vector<std::string>& parameters) {
+  std::vector<std::pair<const std::string, const std::string>> replacements;
+  for (int i = 0; i < parameters.size(); i++) {
+    replacements.push_back({absl::StrCat("$", i), parameters[i]});
+  }
+  return absl::StrReplaceAll(query, replacements);
+}
+
+TEST(CompiledTemplateQueryTest, ComposeReplacesPlaceholders) {
+  const CompiledTemplateQuery query(
+      " UPDATE `Artifact` SET `uri` = $1 WHERE id = $0;", 2);
+  std::string output;
+  query.ComposeInto({"7", "'/tmp/a'"}, &output);
+  EXPECT_EQ(output, " UPDATE `Artifact` SET `uri` = '/tmp/a' WHERE id = 7;");
+}
+
+TEST(CompiledTemplateQueryTest, ComposeKeepsNonPlaceholderDollars) {
+  const std::string template_text = "$$0 $1 $a $ $9 $10 $";
+  const std::vector<std::string> parameters = {"x", "$0"};
+  const CompiledTemplateQuery query(template_text, parameters.size());
+  std::string output;
+  query.ComposeInto(parameters, &output);
+  EXPECT_EQ(output, "$x $0 $a $ $9 $00 $");
+  EXPECT_EQ(output, ReplaceAll(template_text, parameters));
+  EXPECT_EQ(query.ComposedSize(parameters), output.size());
+}
+
+TEST(CompiledTemplateQueryTest, ComposeWithoutParameters) {
+  const CompiledTemplateQuery query(" SELECT `id` FROM `Type`; ", 0);
+  std::string output = "previous content";
+  query.ComposeInto({}, &output);
+  EXPECT_EQ(output, " SELECT `id` FROM `Type`; ");
+}
+
+TEST(CompiledTemplateQueryTest, ComposeReusesBuffer) {
+  const CompiledTemplateQuery query("SELECT $0;", 1);
+  std::string output;
+  query.ComposeInto({std::string(100, 'a')}, &output);
+  const char* const buffer = output.data();
+  query.ComposeInto({"1"}, &output);
+  EXPECT_EQ(output, "SELECT 1;");
+  EXPECT_EQ(output.data(), buffer);
+}
+
+TEST(CompileTemplateQueriesTest, MatchesReplaceAllForAllQueryConfigs) {
+  for (const MetadataSourceQueryConfig& config :
+       {util::GetSqliteMetadataSourceQueryConfig(),
+        util::GetMySqlMetadataSourceQueryConfig(),
+        util::GetPostgreSQLMetadataSourceQueryConfig()}) {
+    const CompiledTemplateQueryMap compiled_queries =
+        CompileTemplateQueries(config);
+    EXPECT_THAT(compiled_queries, ::testing::Contains(::testing::Key(
+                                      &config.select_artifact_by_id())));
+    for (const auto& [template_query, compiled_query] : compiled_queries) {
+      std::vector<std::string> parameters;
+      for (int i = 0; i < template_query->parameter_num(); ++i) {
+        parameters.push_back(absl::StrCat("'p", i, "'"));
+      }
+      std::string output;
+      compiled_query.ComposeInto(parameters, &output);
+      EXPECT_EQ(output, ReplaceAll(template_query->query(), parameters))
+          << template_query->DebugString();
+    }
+  }
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -0,0 +1,289 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/metadata_store_factory.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+namespace ml_metadata {
+
+struct TenantStoreManager::Pool {
+  struct IdleStore {
+    std::unique_ptr<MetadataStore> store;
+    absl::Time release_time;
+  };
+
+  ConnectionConfig connection_config;
+  // Ordered by release time, most recently released last.
+  std::deque<IdleStore> idle_stores;
+  // The position in `idle_pools_`, if `idle_stores` is not empty.
+  std::list<Pool*>::iterator idle_pools_position;
+};
+
+TenantStoreManager::ScopedStore::ScopedStore(ScopedStore&& other)
+    : manager_(other.manager_),
+      pool_(other.pool_),
+      store_(std::move(other.store_)) {
+  other.manager_ = nullptr;
+}
+
+TenantStoreManager::ScopedStore& TenantStoreManager::ScopedStore::operator=(
+    ScopedStore&& other) {
+  if (this != &other) {
+    Release();
+    manager_ = other.manager_;
+    pool_ = other.pool_;
+    store_ = std::move(other.store_);
+    other.manager_ = nullptr;
+  }
+  return *this;
+}
+
+TenantStoreManager::ScopedStore::~ScopedStore() { Release(); }
+
+void TenantStoreManager::ScopedStore::Release() {
+  if (manager_ != nullptr && store_ != nullptr) {
+    manager_->Release(pool_, std::move(store_));
+  }
+  manager_ = nullptr;
+  store_.reset();
+}
+
+void TenantStoreManager::ScopedStore::Discard() {
+  if (manager_ != nullptr && store_ != nullptr) {
+    store_.reset();
+    manager_->ReleaseDiscarded();
+  }
+  manager_ = nullptr;
+  store_.reset();
+}
+
+TenantStoreManager::TenantStoreManager(const Options& options)
+    : options_(options) {}
+
+TenantStoreManager::~TenantStoreManager() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopped_ = true;
+    stop_requested_.SignalAll();
+  }
+  if (idle_sweeper_thread_.joinable()) idle_sweeper_thread_.join();
+}
+
+absl::Status TenantStoreManager::Create(
+    const TenantRegistry& registry, const Options& options,
+    std::unique_ptr<TenantStoreManager>* result) {
+  std::unique_ptr<TenantStoreManager> manager(new TenantStoreManager(options));
+  for (const TenantRegistry::Tenant& tenant : registry.tenants()) {
+    if (tenant.name().empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("A tenant has no name: ", tenant.DebugString()));
+    }
+    if (!tenant.has_connection_config()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "The tenant ", tenant.name(), " has no connection_config."));
+    }
+    auto pool = std::make_unique<Pool>();
+    pool->connection_config = tenant.connection_config();
+    absl::MutexLock lock(&manager->mutex_);
+    if (!manager->pools_.insert({tenant.name(), std::move(pool)}).second) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("The tenant ", tenant.name(), " is duplicated."));
+    }
+  }
+  if (options.idle_sweep_interval > absl::ZeroDuration()) {
+    TenantStoreManager* const manager_ptr = manager.get();
+    manager->idle_sweeper_thread_ =
+        std::thread([manager_ptr]() { manager_ptr->RunIdleSweeper(); });
+  }
+  *result = std::move(manager);
+  return absl::OkStatus();
+}
+
+absl::Status TenantStoreManager::Acquire(absl::string_view tenant,
+                                         ScopedStore* store) {
+  // Closes the evicted stores outside of the lock, as closing may be slow.
+  std::vector<std::unique_ptr<MetadataStore>> stores_to_close;
+  Pool* pool;
+  {
+    absl::MutexLock lock(&mutex_);
+    const auto pool_it = pools_.find(tenant);
+    if (pool_it == pools_.end()) {
+      return absl::NotFoundError(absl::StrCat("Unknown tenant: ", tenant));
+    }
+    pool = pool_it->second.get();
+    const absl::Time deadline = absl::Now() + options_.acquire_timeout;
+    while (true) {
+      EvictIdleStores(absl::Now(), stores_to_close);
+      if (!pool->idle_stores.empty()) {
+        std::unique_ptr<MetadataStore> idle_store =
+            std::move(pool->idle_stores.back().store);
+        pool->idle_stores.pop_back();
+        num_idle_connections_--;
+        if (pool->idle_stores.empty()) {
+          idle_pools_.erase(pool->idle_pools_position);
+        } else {
+          TouchPool(pool);
+        }
+        *store = ScopedStore(this, pool, std::move(idle_store));
+        return absl::OkStatus();
+      }
+      if (num_connections_ < options_.max_num_connections) {
+        num_connections_++;
+        break;
+      }
+      if (num_idle_connections_ > 0) {
+        // Makes room by closing an idle store of another tenant.
+        stores_to_close.push_back(TakeLeastRecentlyUsedIdleStore());
+        continue;
+      }
+      if (store_released_.WaitWithDeadline(&mutex_, deadline)) {
+        return absl::ResourceExhaustedError(absl::StrCat(
+            "All the ", options_.max_num_connections,
+            " connections are in use, cannot connect to tenant ", tenant));
+      }
+    }
+  }
+
+  // Connects outside of the lock, as connecting may be slow.
+  std::unique_ptr<MetadataStore> new_store;
+  const absl::Status status =
+      CreateMetadataStore(pool->connection_config, &new_store);
+  if (!status.ok()) {
+    absl::MutexLock lock(&mutex_);
+    num_connections_--;
+    store_released_.Signal();
+    return status;
+  }
+  *store = ScopedStore(this, pool, std::move(new_store));
+  return absl::OkStatus();
+}
+
+void TenantStoreManager::Release(Pool* pool,
+                                 std::unique_ptr<MetadataStore> store) {
+  std::vector<std::unique_ptr<MetadataStore>> stores_to_close;
+  absl::MutexLock lock(&mutex_);
+  pool->idle_stores.push_back({std::move(store), absl::Now()});
+  num_idle_connections_++;
+  if (pool->idle_stores.size() == 1) {
+    idle_pools_.push_front(pool);
+    pool->idle_pools_position = idle_pools_.begin();
+  } else {
+    TouchPool(pool);
+  }
+  EvictIdleStores(absl::Now(), stores_to_close);
+  store_released_.Signal();
+}
+
+void TenantStoreManager::ReleaseDiscarded() {
+  absl::MutexLock lock(&mutex_);
+  num_connections_--;
+  store_released_.Signal();
+}
+
+void TenantStoreManager::EvictIdleStores(
+    absl::Time now,
+    std::vector<std::unique_ptr<MetadataStore>>& stores_to_close) {
+  for (auto it = idle_pools_.begin(); it != idle_pools_.end();) {
+    Pool* pool = *it++;
+    while (!pool->idle_stores.empty() &&
+           now - pool->idle_stores.front().release_time >
+               options_.idle_timeout) {
+      stores_to_close.push_back(std::move(pool->idle_stores.front().store));
+      pool->idle_stores.pop_front();
+      num_idle_connections_--;
+      num_connections_--;
+    }
+    if (pool->idle_stores.empty()) {
+      idle_pools_.erase(pool->idle_pools_position);
+    }
+  }
+  while (num_idle_connections_ > options_.max_num_idle_connections) {
+    stores_to_close.push_back(TakeLeastRecentlyUsedIdleStore());
+  }
+}
+
+std::unique_ptr<MetadataStore>
+TenantStoreManager::TakeLeastRecentlyUsedIdleStore() {
+  Pool* pool = idle_pools_.back();
+  std::unique_ptr<MetadataStore> store =
+      std::move(pool->idle_stores.front().store);
+  pool->idle_stores.pop_front();
+  if (pool->idle_stores.empty()) {
+    idle_pools_.pop_back();
+  }
+  num_idle_connections_--;
+  num_connections_--;
+  return store;
+}
+
+void TenantStoreManager::TouchPool(Pool* pool) {
+  idle_pools_.splice(idle_pools_.begin(), idle_pools_,
+                     pool->idle_pools_position);
+}
+
+void TenantStoreManager::RunIdleSweeper() {
+  while (true) {
+    // Closes the evicted stores outside of the lock, as closing may be slow.
+    std::vector<std::unique_ptr<MetadataStore>> stores_to_close;
+    absl::MutexLock lock(&mutex_);
+    // A spurious wakeup only makes the next sweep early.
+    if (!stopped_) {
+      stop_requested_.WaitWithTimeout(&mutex_, options_.idle_sweep_interval);
+    }
+    if (stopped_) return;
+    EvictIdleStores(absl::Now(), stores_to_close);
+    // The closed stores free connections for the waiting Acquire calls.
+    if (!stores_to_close.empty()) store_released_.SignalAll();
+  }
+}
+
+absl::Status TenantStoreManager::GetConnectionConfig(
+    absl::string_view tenant, ConnectionConfig* connection_config) const {
+  absl::MutexLock lock(&mutex_);
+  const auto pool_it = pools_.find(tenant);
+  if (pool_it == pools_.end()) {
+    return absl::NotFoundError(absl::StrCat("Unknown tenant: ", tenant));
+  }
+  *connection_config = pool_it->second->connection_config;
+  return absl::OkStatus();
+}
+
+int TenantStoreManager::num_connections() const {
+  absl::MutexLock lock(&mutex_);
+  return num_connections_;
+}
+
+int TenantStoreManager::num_idle_connections() const {
+  absl::MutexLock lock(&mutex_);
+  return num_idle_connections_;
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,189 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_TENANT_STORE_MANAGER_H_
+#define ML_METADATA_METADATA_STORE_TENANT_STORE_MANAGER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+
+namespace ml_metadata {
+
+// Lends MetadataStores connected to the databases of many tenants, so that a
+// single server can serve many small databases. It is thread-safe.
+//
+// Each tenant of the TenantRegistry has a pool of idle stores, which are
+// reused by the next requests of the tenant instead of reconnecting. The
+// total number of open stores and of idle stores is capped across the
+// tenants. When a cap is hit, the idle stores of the least recently used
+// tenants are closed first. As every store holds a database connection and
+// its caches, the caps also bound the memory used by the tenants. Idle stores
+// that expired are closed when stores are acquired or released, and by a
+// background thread, so that a server that goes quiet does not keep them.
+//
+// Usage example:
+//
+//   std::unique_ptr<TenantStoreManager> manager;
+//   MLMD_RETURN_IF_ERROR(TenantStoreManager::Create(
+//       registry, TenantStoreManager::Options(), &manager));
+//   TenantStoreManager::ScopedStore store;
+//   MLMD_RETURN_IF_ERROR(manager->Acquire("team-a", &store));
+//   MLMD_RETURN_IF_ERROR(store->GetArtifacts(request, &response));
+class TenantStoreManager {
+ public:
+  struct Options {
+    // The maximum number of open stores, including the ones in use.
+    int max_num_connections = 100;
+    // The maximum number of idle stores kept for reuse.
+    int max_num_idle_connections = 20;
+    // Idle stores are closed once unused for longer than this.
+    absl::Duration idle_timeout = absl::Minutes(5);
+    // How often the background thread closes the expired idle stores. If not
+    // positive, there is no background thread.
+    absl::Duration idle_sweep_interval = absl::Seconds(30);
+    // How long Acquire waits for a store to be released, if
+    // `max_num_connections` stores are in use.
+    absl::Duration acquire_timeout = absl::Seconds(10);
+  };
+
+  // The stores of a tenant.
+  struct Pool;
+
+  // A store lent to a request. The store is given back to the pool of its
+  // tenant when this is destroyed.
+  class ScopedStore {
+   public:
+    // Creates an empty store.
+    ScopedStore() : manager_(nullptr), pool_(nullptr) {}
+    // Creates a store that is not lent by a manager, and is closed when this
+    // is destroyed.
+    explicit ScopedStore(std::unique_ptr<MetadataStore> store)
+        : manager_(nullptr), pool_(nullptr), store_(std::move(store)) {}
+    ScopedStore(ScopedStore&& other);
+    ScopedStore& operator=(ScopedStore&& other);
+    ~ScopedStore();
+
+    ScopedStore(const ScopedStore&) = delete;
+    ScopedStore& operator=(const ScopedStore&) = delete;
+
+    MetadataStore* get() const { return store_.get(); }
+    MetadataStore* operator->() const { return store_.get(); }
+
+    // Closes the store instead of giving it back to the pool, e.g., when its
+    // database connection may be broken after a failed call.
+    void Discard();
+
+   private:
+    friend class TenantStoreManager;
+    ScopedStore(TenantStoreManager* manager, Pool* pool,
+                std::unique_ptr<MetadataStore> store)
+        : manager_(manager), pool_(pool), store_(std::move(store)) {}
+
+    // Gives the store back to `manager_`, if any.
+    void Release();
+
+    TenantStoreManager* manager_;
+    Pool* pool_;
+    std::unique_ptr<MetadataStore> store_;
+  };
+
+  // Stops the background thread, if any.
+  ~TenantStoreManager();
+
+  // Disallows copy.
+  TenantStoreManager(const TenantStoreManager&) = delete;
+  TenantStoreManager& operator=(const TenantStoreManager&) = delete;
+
+  // Validates `registry`, and creates a manager of its tenants in `result`.
+  // Returns INVALID_ARGUMENT error, if a tenant has no name or connection
+  //   config, or if two tenants have the same name.
+  static absl::Status Create(const TenantRegistry& registry,
+                             const Options& options,
+                             std::unique_ptr<TenantStoreManager>* result);
+
+  // Lends a store of `tenant` in `store`. An idle store of the tenant is
+  // reused if any, otherwise a new one is connected.
+  // Returns NOT_FOUND error, if `tenant` is not in the registry.
+  // Returns RESOURCE_EXHAUSTED error, if no store is released within the
+  //   acquire timeout while `max_num_connections` stores are in use.
+  // Returns the error of CreateMetadataStore, if connecting fails.
+  absl::Status Acquire(absl::string_view tenant, ScopedStore* store);
+
+  // Copies the connection config of `tenant` into `connection_config`.
+  // Returns NOT_FOUND error, if `tenant` is not in the registry.
+  absl::Status GetConnectionConfig(absl::string_view tenant,
+                                   ConnectionConfig* connection_config) const;
+
+  int num_connections() const;
+  int num_idle_connections() const;
+
+ private:
+  explicit TenantStoreManager(const Options& options);
+
+  // Gives `store` back to `pool`.
+  void Release(Pool* pool, std::unique_ptr<MetadataStore> store);
+
+  // Frees the connection slot of a store closed by its borrower.
+  void ReleaseDiscarded();
+
+  // Takes out the idle stores that are expired or over the idle cap into
+  // `stores_to_close`, so that they are closed outside of the lock.
+  void EvictIdleStores(absl::Time now,
+                       std::vector<std::unique_ptr<MetadataStore>>&
+                           stores_to_close)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Takes out the oldest idle store of the least recently used pool.
+  std::unique_ptr<MetadataStore> TakeLeastRecentlyUsedIdleStore()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Marks `pool` as the most recently used one.
+  void TouchPool(Pool* pool) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Closes the expired idle stores every `idle_sweep_interval` until stopped.
+  void RunIdleSweeper();
+
+  const Options options_;
+
+  mutable absl::Mutex mutex_;
+  // Signaled when a store is released or closed.
+  absl::CondVar store_released_;
+  // Signaled when the manager is destroyed.
+  absl::CondVar stop_requested_;
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::flat_hash_map<std::string, std::unique_ptr<Pool>> pools_
+      ABSL_GUARDED_BY(mutex_);
+  // The pools with idle stores, most recently used first.
+  std::list<Pool*> idle_pools_ ABSL_GUARDED_BY(mutex_);
+  int num_connections_ ABSL_GUARDED_BY(mutex_) = 0;
+  int num_idle_connections_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::thread idle_sweeper_thread_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_TENANT_STORE_MANAGER_H_
@@ -0,0 +1,199 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/tenant_store_manager.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ml_metadata/metadata_store/metadata_store.h"
+#include "ml_metadata/metadata_store/test_util.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/proto/metadata_store_service.pb.h"
+
+namespace ml_metadata {
+namespace {
+
+using ::ml_metadata::testing::ParseTextProtoOrDie;
+
+// A registry of tenants `a` and `b`, each with its own in-memory database.
+TenantRegistry TwoTenantRegistry() {
+  return ParseTextProtoOrDie<TenantRegistry>(R"pb(
+    tenants { name: 'a' connection_config { fake_database {} } }
+    tenants { name: 'b' connection_config { fake_database {} } }
+  )pb");
+}
+
+TEST(TenantStoreManagerTest, CreateRejectsInvalidRegistries) {
+  std::unique_ptr<TenantStoreManager> manager;
+  EXPECT_TRUE(absl::IsInvalidArgument(TenantStoreManager::Create(
+      ParseTextProtoOrDie<TenantRegistry>(
+          R"pb(tenants { connection_config { fake_database {} } })pb"),
+      TenantStoreManager::Options(), &manager)));
+  EXPECT_TRUE(absl::IsInvalidArgument(TenantStoreManager::Create(
+      ParseTextProtoOrDie<TenantRegistry>(R"pb(tenants { name: 'a' })pb"),
+      TenantStoreManager::Options(), &manager)));
+  EXPECT_TRUE(absl::IsInvalidArgument(TenantStoreManager::Create(
+      ParseTextProtoOrDie<TenantRegistry>(R"pb(
+        tenants { name: 'a' connection_config { fake_database {} } }
+        tenants { name: 'a' connection_config { fake_database {} } }
+      )pb"),
+      TenantStoreManager::Options(), &manager)));
+}
+
+TEST(TenantStoreManagerTest, ReusesReleasedStores) {
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(),
+                                       TenantStoreManager::Options(), &manager),
+            absl::OkStatus());
+  MetadataStore* first_store;
+  {
+    TenantStoreManager::ScopedStore store;
+    ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+    first_store = store.get();
+    PutArtifactTypeRequest request;
+    request.mutable_artifact_type()->set_name("type");
+    PutArtifactTypeResponse response;
+    ASSERT_EQ(store->PutArtifactType(request, &response), absl::OkStatus());
+  }
+  EXPECT_EQ(manager->num_connections(), 1);
+  EXPECT_EQ(manager->num_idle_connections(), 1);
+
+  TenantStoreManager::ScopedStore store;
+  ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+  EXPECT_EQ(store.get(), first_store);
+  EXPECT_EQ(manager->num_idle_connections(), 0);
+  GetArtifactTypeRequest request;
+  request.set_type_name("type");
+  GetArtifactTypeResponse response;
+  ASSERT_EQ(store->GetArtifactType(request, &response), absl::OkStatus());
+  EXPECT_EQ(response.artifact_type().name(), "type");
+
+  TenantStoreManager::ScopedStore unknown_store;
+  EXPECT_TRUE(absl::IsNotFound(manager->Acquire("c", &unknown_store)));
+}
+
+TEST(TenantStoreManagerTest, DoesNotReuseDiscardedStores) {
+  TenantStoreManager::Options options;
+  options.max_num_connections = 1;
+  options.acquire_timeout = absl::Milliseconds(10);
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(), options, &manager),
+            absl::OkStatus());
+  TenantStoreManager::ScopedStore store;
+  ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+  store.Discard();
+  EXPECT_EQ(store.get(), nullptr);
+  EXPECT_EQ(manager->num_connections(), 0);
+  EXPECT_EQ(manager->num_idle_connections(), 0);
+
+  // The connection of the discarded store is free for a new store.
+  ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+  EXPECT_EQ(manager->num_connections(), 1);
+}
+
+TEST(TenantStoreManagerTest, GetsConnectionConfigsOfTenants) {
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(),
+                                       TenantStoreManager::Options(), &manager),
+            absl::OkStatus());
+  ConnectionConfig connection_config;
+  ASSERT_EQ(manager->GetConnectionConfig("a", &connection_config),
+            absl::OkStatus());
+  EXPECT_TRUE(connection_config.has_fake_database());
+  EXPECT_TRUE(absl::IsNotFound(
+      manager->GetConnectionConfig("c", &connection_config)));
+}
+
+TEST(TenantStoreManagerTest, ClosesLeastRecentlyUsedIdleStores) {
+  TenantStoreManager::Options options;
+  options.max_num_connections = 2;
+  options.max_num_idle_connections = 1;
+  options.acquire_timeout = absl::Milliseconds(10);
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(), options, &manager),
+            absl::OkStatus());
+
+  TenantStoreManager::ScopedStore store_a;
+  TenantStoreManager::ScopedStore store_b;
+  ASSERT_EQ(manager->Acquire("a", &store_a), absl::OkStatus());
+  ASSERT_EQ(manager->Acquire("b", &store_b), absl::OkStatus());
+  MetadataStore* const idle_store_b = store_b.get();
+  // No connection is left for another store of `a`.
+  TenantStoreManager::ScopedStore another_store_a;
+  EXPECT_TRUE(absl::IsResourceExhausted(
+      manager->Acquire("a", &another_store_a)));
+
+  // Only the most recently released store is kept idle.
+  store_a = TenantStoreManager::ScopedStore();
+  store_b = TenantStoreManager::ScopedStore();
+  EXPECT_EQ(manager->num_connections(), 1);
+  EXPECT_EQ(manager->num_idle_connections(), 1);
+  ASSERT_EQ(manager->Acquire("b", &store_b), absl::OkStatus());
+  EXPECT_EQ(store_b.get(), idle_store_b);
+
+  // The idle store of `b` is closed to make room for `a`.
+  store_b = TenantStoreManager::ScopedStore();
+  ASSERT_EQ(manager->Acquire("a", &store_a), absl::OkStatus());
+  ASSERT_EQ(manager->Acquire("a", &another_store_a), absl::OkStatus());
+  EXPECT_EQ(manager->num_connections(), 2);
+  EXPECT_EQ(manager->num_idle_connections(), 0);
+}
+
+TEST(TenantStoreManagerTest, ClosesExpiredIdleStores) {
+  TenantStoreManager::Options options;
+  options.idle_timeout = absl::ZeroDuration();
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(), options, &manager),
+            absl::OkStatus());
+  {
+    TenantStoreManager::ScopedStore store;
+    ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+  }
+  absl::SleepFor(absl::Milliseconds(1));
+  TenantStoreManager::ScopedStore store;
+  ASSERT_EQ(manager->Acquire("b", &store), absl::OkStatus());
+  EXPECT_EQ(manager->num_connections(), 1);
+  EXPECT_EQ(manager->num_idle_connections(), 0);
+}
+
+TEST(TenantStoreManagerTest, SweepsExpiredIdleStoresInTheBackground) {
+  TenantStoreManager::Options options;
+  options.idle_timeout = absl::Milliseconds(10);
+  options.idle_sweep_interval = absl::Milliseconds(10);
+  std::unique_ptr<TenantStoreManager> manager;
+  ASSERT_EQ(TenantStoreManager::Create(TwoTenantRegistry(), options, &manager),
+            absl::OkStatus());
+  {
+    TenantStoreManager::ScopedStore store;
+    ASSERT_EQ(manager->Acquire("a", &store), absl::OkStatus());
+  }
+  EXPECT_EQ(manager->num_idle_connections(), 1);
+
+  // No store is acquired or released anymore, so only the background thread
+  // can close the idle store.
+  const absl::Time deadline = absl::Now() + absl::Seconds(10);
+  while (manager->num_connections() > 0 && absl::Now() < deadline) {
+    absl::SleepFor(absl::Milliseconds(10));
+  }
+  EXPECT_EQ(manager->num_connections(), 0);
+  EXPECT_EQ(manager->num_idle_connections(), 0);
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -0,0 +1,66 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/thread_pool.h"
+
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include <glog/logging.h>
+#include "absl/synchronization/mutex.h"
+
+namespace ml_metadata {
+
+ThreadPool::ThreadPool(const int num_threads) {
+  CHECK_GT(num_threads, 0) << "A thread pool needs at least one thread.";
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this]() { Run(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopped_ = true;
+    function_scheduled_.SignalAll();
+  }
+  for (std::thread& thread : threads_) thread.join();
+}
+
+void ThreadPool::Schedule(std::function<void()> function) {
+  absl::MutexLock lock(&mutex_);
+  CHECK(!stopped_) << "The thread pool is being destroyed.";
+  functions_.push_back(std::move(function));
+  function_scheduled_.Signal();
+}
+
+void ThreadPool::Run() {
+  while (true) {
+    std::function<void()> function;
+    {
+      absl::MutexLock lock(&mutex_);
+      while (!stopped_ && functions_.empty()) {
+        function_scheduled_.Wait(&mutex_);
+      }
+      if (functions_.empty()) return;
+      function = std::move(functions_.front());
+      functions_.pop_front();
+    }
+    function();
+  }
+}
+
+}  // namespace ml_metadata
@@ -0,0 +1,62 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_METADATA_STORE_THREAD_POOL_H_
+#define ML_METADATA_METADATA_STORE_THREAD_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace ml_metadata {
+
+// A fixed number of threads that run the scheduled functions in the order
+// they were scheduled. It lets the gRPC callback handlers hand off blocking
+// database work, instead of running it on the threads of the gRPC event
+// loop. It is thread-safe.
+class ThreadPool {
+ public:
+  // Starts `num_threads` threads, which must be positive.
+  explicit ThreadPool(int num_threads);
+
+  // Runs the functions that are already scheduled, then joins the threads.
+  ~ThreadPool();
+
+  // Disallows copy.
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Runs `function` on one of the threads. It must not be called once the
+  // pool is being destroyed.
+  void Schedule(std::function<void()> function);
+
+ private:
+  // Runs the scheduled functions until the pool is stopped and none is left.
+  void Run();
+
+  absl::Mutex mutex_;
+  // Signaled when a function is scheduled or the pool is stopped.
+  absl::CondVar function_scheduled_;
+  std::deque<std::function<void()>> functions_ ABSL_GUARDED_BY(mutex_);
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_METADATA_STORE_THREAD_POOL_H_
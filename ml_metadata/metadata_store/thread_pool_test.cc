@@ -0,0 +1,72 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/metadata_store/thread_pool.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+
+namespace ml_metadata {
+namespace {
+
+TEST(ThreadPoolTest, RunsScheduledFunctionsOnItsThreads) {
+  ThreadPool thread_pool(/*num_threads=*/2);
+  absl::Notification done;
+  std::thread::id thread_id;
+  thread_pool.Schedule([&]() {
+    thread_id = std::this_thread::get_id();
+    done.Notify();
+  });
+  done.WaitForNotification();
+  EXPECT_NE(thread_id, std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, RunsFunctionsConcurrently) {
+  ThreadPool thread_pool(/*num_threads=*/2);
+  // Each function waits for the other, so they only finish if both run at
+  // the same time.
+  absl::Notification first_started, second_started;
+  thread_pool.Schedule([&]() {
+    first_started.Notify();
+    second_started.WaitForNotification();
+  });
+  thread_pool.Schedule([&]() {
+    second_started.Notify();
+    first_started.WaitForNotification();
+  });
+  first_started.WaitForNotification();
+  second_started.WaitForNotification();
+}
+
+TEST(ThreadPoolTest, RunsScheduledFunctionsBeforeDestruction) {
+  absl::Mutex mutex;
+  int num_runs = 0;
+  {
+    ThreadPool thread_pool(/*num_threads=*/1);
+    for (int i = 0; i < 100; ++i) {
+      thread_pool.Schedule([&]() {
+        absl::MutexLock lock(&mutex);
+        ++num_runs;
+      });
+    }
+  }
+  absl::MutexLock lock(&mutex);
+  EXPECT_EQ(num_runs, 100);
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -20,13 +20,10 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
-#include "absl/strings/ascii.h"
-#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
-#include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
-#include "absl/strings/substitute.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/query/filter_query_enum_rewriter.h"
 #include "ml_metadata/util/return_utils.h"
 #include "re2/re2.h"
 
@@ -53,171 +50,17 @@ constexpr absl::string_view kParentContextRE =
     "\\b(parent_contexts_[[:word:]]+)\\.";
 constexpr absl::string_view kEventRE = "\\b(events_[[:word:]]+)\\.";
 
-constexpr absl::string_view kArtifactStatePredicateRE =
-    "\\b(state)[[:space:]]*(=|!=|"
-    "(?i)[[:space:]]NOT[[:space:]]*IN[[:space:]]|(?i)[[:space:]]IN[[:space:]])"
-    "[[:space:]]*([[:word:]]+\\b|\\(([[:space:]]*[[:word:]]+[[:space:]]*[,]*"
-    "[[:space:]]*[[:word:]]+[[:space:]]*)*\\))";
-constexpr absl::string_view kExecutionStatePredicateRE =
-    "\\b(last_known_state)[[:space:]]*(=|!=|"
-    "(?i)[[:space:]]NOT[[:space:]]*IN[[:space:]]|(?i)[[:space:]]IN[[:space:]])"
-    "[[:space:]]*([[:word:]]+\\b|\\(([[:space:]]*[[:word:]]+[[:space:]]*[,]*"
-    "[[:space:]]*[[:word:]]+[[:space:]]*)*\\))";
-constexpr absl::string_view kEventTypePredicateRE =
-    "\\b(events_[[:word:]]+\\.type)[[:space:]]*(=|!=|"
-    "(?i)[[:space:]]NOT[[:space:]]*IN[[:space:]]|(?i)[[:space:]]IN[[:space:]])"
-    "[[:space:]]*([[:word:]]+\\b|\\(([[:space:]]*[[:word:]]+[[:space:]]*[,]*"
-    "[[:space:]]*[[:word:]]+[[:space:]]*)*\\))";
-
-// Returns a map of Artifact state Enums to their corresponding int values. See
-// go/totw/110#the-fix-safe-initialization-no-destruction for more information
-// on why we are using a function instead of a direct variable declaration.
-// Even though gtl::fixed_flat_map_of is preferred, here we use an alternative
-// approach because gtl libraries are not available in OSS.
-static const absl::flat_hash_map<std::string, int>
-GetArtifactStateValueMapping() {
-  static const absl::flat_hash_map<std::string, int>& mapping =
-      *new absl::flat_hash_map<std::string, int>(
-          {{Artifact::State_Name(Artifact::UNKNOWN), Artifact::UNKNOWN},
-           {Artifact::State_Name(Artifact::PENDING), Artifact::PENDING},
-           {Artifact::State_Name(Artifact::LIVE), Artifact::LIVE},
-           {Artifact::State_Name(Artifact::MARKED_FOR_DELETION),
-            Artifact::MARKED_FOR_DELETION},
-           {Artifact::State_Name(Artifact::DELETED), Artifact::DELETED}});
-  return mapping;
-}
-
-// Returns a map of Execution state Enums to their corresponding int values. See
-// go/totw/110#the-fix-safe-initialization-no-destruction for more information
-// on why we are using a function instead of a direct variable declaration.
-// Even though gtl::fixed_flat_map_of is preferred, here we use an alternative
-// approach because gtl libraries are not available in OSS.
-static const absl::flat_hash_map<std::string, int>
-GetExecutionStateValueMapping() {
-  static const absl::flat_hash_map<std::string, int>& mapping =
-      *new absl::flat_hash_map<std::string, int>(
-          {{Execution::State_Name(Execution::UNKNOWN), Execution::UNKNOWN},
-           {Execution::State_Name(Execution::NEW), Execution::NEW},
-           {Execution::State_Name(Execution::RUNNING), Execution::RUNNING},
-           {Execution::State_Name(Execution::COMPLETE), Execution::COMPLETE},
-           {Execution::State_Name(Execution::FAILED), Execution::FAILED},
-           {Execution::State_Name(Execution::CACHED), Execution::CACHED},
-           {Execution::State_Name(Execution::CANCELED), Execution::CANCELED}});
-  return mapping;
-}
-
-// Returns a map of Event state Enums to their corresponding int values. See
-// go/totw/110#the-fix-safe-initialization-no-destruction for more information
-// on why we are using a function instead of a direct variable declaration.
-// Even though gtl::fixed_flat_map_of is preferred, here we use an alternative
-// approach because gtl libraries are not available in OSS.
-static const absl::flat_hash_map<std::string, int> GetEventStateValueMapping() {
-  static const absl::flat_hash_map<std::string, int>& mapping =
-      *new absl::flat_hash_map<std::string, int>({
-          {Event::Type_Name(Event::INPUT), Event::INPUT},
-          {Event::Type_Name(Event::OUTPUT), Event::OUTPUT},
-          {Event::Type_Name(Event::DECLARED_INPUT), Event::DECLARED_INPUT},
-          {Event::Type_Name(Event::DECLARED_OUTPUT), Event::DECLARED_OUTPUT},
-          {Event::Type_Name(Event::INTERNAL_INPUT), Event::INTERNAL_INPUT},
-          {Event::Type_Name(Event::INTERNAL_OUTPUT), Event::INTERNAL_OUTPUT},
-      });
-  return mapping;
-}
-
-// Parses query for enum predicates e.g. state = LIVE and re-writes the query
-// into form state = <int> based on the `enum_value_mapping` provided by the
-// caller. The `enum_predicate_regex` provides the expected state predicate in
-// the query.
-absl::StatusOr<std::string> ParseEnumPredicateAndTransformQuery(
-    absl::string_view query_string, absl::string_view enum_predicate_regex,
-    const absl::flat_hash_map<std::string, int>& enum_value_mapping) {
-  std::string rewritten_query = std::string(query_string);
-  std::string state_string_literal, operator_literal, value_literal;
-  while (RE2::FindAndConsume(&query_string, enum_predicate_regex,
-                             &state_string_literal, &operator_literal,
-                             &value_literal)) {
-    std::string query_subtitute;
-    if (operator_literal == "=" || operator_literal == "!=") {
-      if (!enum_value_mapping.contains(value_literal)) {
-        return absl::InvalidArgumentError(
-            absl::StrCat("Unsupported enum value specified in the query: ",
-                        value_literal));
-      }
-
-      if (operator_literal == "!=") {
-        query_subtitute = absl::Substitute(
-            " (($0 $1 $2) OR ($0 IS NULL)) ", state_string_literal,
-            operator_literal, enum_value_mapping.at(value_literal));
-      } else {
-        query_subtitute = absl::Substitute(
-            " $0 $1 $2 ", state_string_literal, operator_literal,
-            enum_value_mapping.at(value_literal));
-      }
-    } else {
-      if (!absl::StartsWith(value_literal, "(") &&
-          !absl::EndsWith(value_literal, ")")) {
-        return absl::InvalidArgumentError(absl::StrCat(
-            "Expected a list of enum values enclosed in parentheses but got ",
-            value_literal));
-      }
-      std::string value_literal_no_parens =
-          value_literal.substr(1, value_literal.size() - 2);
-      if (value_literal_no_parens.empty()) { continue; }
-      std::vector<std::string> value_literals =
-          absl::StrSplit(value_literal_no_parens, ',');
-      std::vector<int> enum_values;
-      for (std::string& literal : value_literals) {
-        absl::StripAsciiWhitespace(&literal);
-        if (!enum_value_mapping.contains(literal)) {
-          return absl::InvalidArgumentError(
-              absl::StrCat("Unsupported enum value specified in the query: ",
-                           literal));
-        }
-        enum_values.push_back(enum_value_mapping.at(literal));
-      }
-      std::string enum_literal = absl::StrJoin(enum_values, ",");
-      absl::StripAsciiWhitespace(&operator_literal);
-      if (absl::EqualsIgnoreCase(operator_literal, "IN")) {
-        query_subtitute = absl::Substitute(" $0 $1 ($2) ", state_string_literal,
-                                           operator_literal, enum_literal);
-      } else {
-        query_subtitute = absl::Substitute(" (($0 $1 ($2)) OR ($0 IS NULL)) ",
-                                           state_string_literal,
-                                           operator_literal, enum_literal);
-      }
-    }
-    value_literal =
-        absl::StrReplaceAll(value_literal, {{"(", "\\("}, {")", "\\)"}});
-    std::string replace_regex = absl::StrReplaceAll(
-        enum_predicate_regex,
-        {{"([[:word:]]+\\b|\\(([[:space:]]*[[:word:]]+[[:space:]]*[,]*"
-          "[[:space:]]*[[:word:]]+[[:space:]]*)*\\))",
-          value_literal}});
-    if (!RE2::GlobalReplace(&rewritten_query, replace_regex, query_subtitute)) {
-      return absl::InternalError(absl::Substitute(
-          "Query cannot be rewritten successfully for matched enum predicate: "
-          "$0 $1 $2",
-          state_string_literal, operator_literal, value_literal));
-    }
-  }
-
-  return rewritten_query;
-}
-
 absl::StatusOr<std::string> AddArtifactStateAndTransformQuery(
     absl::string_view query_string, zetasql::AnalyzerOptions& analyzer_opts) {
   MLMD_RETURN_IF_ERROR(analyzer_opts.AddExpressionColumn("state", Int64Type()));
-  return ParseEnumPredicateAndTransformQuery(
-      query_string, kArtifactStatePredicateRE, GetArtifactStateValueMapping());
+  return RewriteArtifactStatePredicates(query_string);
 }
 
 absl::StatusOr<std::string> AddExecutionLastKnownStateAndTransformQuery(
     absl::string_view query_string, zetasql::AnalyzerOptions& analyzer_opts) {
   MLMD_RETURN_IF_ERROR(
       analyzer_opts.AddExpressionColumn("last_known_state", Int64Type()));
-  return ParseEnumPredicateAndTransformQuery(query_string,
-                                             kExecutionStatePredicateRE,
-                                             GetExecutionStateValueMapping());
+  return RewriteExecutionStatePredicates(query_string);
 }
 
 // Adds a list of columns corresponding to the node attributes which are
@@ -386,8 +229,7 @@ absl::StatusOr<std::string> AddEvents(absl::string_view query_string,
         analyzer_opts.AddExpressionColumn(matched_event, event_struct_type));
   }
 
-  return ParseEnumPredicateAndTransformQuery(
-      original_query, kEventTypePredicateRE, GetEventStateValueMapping());
+  return RewriteEventTypePredicates(original_query);
 }
 
 absl::Status AddContexts(absl::string_view query_string,
@@ -452,13 +294,9 @@ absl::StatusOr<std::string> AddNeighborhoodNodes<Context>(
   MLMD_RETURN_IF_ERROR(
       AddExecutions(query_string, analyzer_opts, type_factory));
   MLMD_ASSIGN_OR_RETURN(std::string modified_query_string,
-                        ParseEnumPredicateAndTransformQuery(
-                            query_string, kArtifactStatePredicateRE,
-                            GetArtifactStateValueMapping()));
+                        RewriteArtifactStatePredicates(query_string));
   MLMD_ASSIGN_OR_RETURN(modified_query_string,
-                        ParseEnumPredicateAndTransformQuery(
-                            modified_query_string, kExecutionStatePredicateRE,
-                            GetExecutionStateValueMapping()));
+                        RewriteExecutionStatePredicates(modified_query_string));
   return modified_query_string;
 }
 
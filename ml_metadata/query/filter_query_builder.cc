@@ -172,9 +172,9 @@ absl::string_view GetArtifactPropertyJoinTable(int64_t query_version) {
           SELECT artifact_id, int_value, double_value, string_value
           FROM ArtifactProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.artifact_id )sql";
-    // Head version supports queries from v10+
+    // Fat client support for v10 and v11 queries
     case 10:
-    default:
+    case 11:
       // $0 is the base node table. $1 is the property related neighborhood
       // table. $2 is property name. $3 is a boolean for is_custom_property.
       return R"sql(
@@ -182,6 +182,17 @@ absl::string_view GetArtifactPropertyJoinTable(int64_t query_version) {
           SELECT artifact_id, int_value, double_value, string_value, bool_value
           FROM ArtifactProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.artifact_id )sql";
+    // Head version supports queries from v12+
+    default:
+      // $0 is the base node table. $1 is the property related neighborhood
+      // table. $2 is property name. $3 is a boolean for is_custom_property.
+      return R"sql(
+        JOIN (
+          SELECT artifact_id, int_value, double_value, string_value, bool_value
+          FROM ArtifactProperty
+          WHERE name_id = (SELECT id FROM PropertyName WHERE name = "$2")
+            AND is_custom_property = $3
+        ) AS $1 ON $0.id = $1.artifact_id )sql";
   }
 }
 
@@ -202,9 +213,9 @@ absl::string_view GetExecutionPropertyJoinTable(int64_t query_version) {
           SELECT execution_id, int_value, double_value, string_value
           FROM ExecutionProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.execution_id )sql";
-    // Head version supports queries from v10+
+    // Fat client support for v10 and v11 queries
     case 10:
-    default:
+    case 11:
       // $0 is the base node table. $1 is the property related neighborhood
       // table. $2 is property name. $3 is a boolean for is_custom_property.
       return R"sql(
@@ -212,6 +223,17 @@ absl::string_view GetExecutionPropertyJoinTable(int64_t query_version) {
           SELECT execution_id, int_value, double_value, string_value, bool_value
           FROM ExecutionProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.execution_id )sql";
+    // Head version supports queries from v12+
+    default:
+      // $0 is the base node table. $1 is the property related neighborhood
+      // table. $2 is property name. $3 is a boolean for is_custom_property.
+      return R"sql(
+        JOIN (
+          SELECT execution_id, int_value, double_value, string_value, bool_value
+          FROM ExecutionProperty
+          WHERE name_id = (SELECT id FROM PropertyName WHERE name = "$2")
+            AND is_custom_property = $3
+        ) AS $1 ON $0.id = $1.execution_id )sql";
   }
 }
 
@@ -232,9 +254,9 @@ absl::string_view GetContextPropertyJoinTable(int64_t query_version) {
           SELECT context_id, int_value, double_value, string_value
           FROM ContextProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.context_id )sql";
-    // Head version supports queries from v10+
+    // Fat client support for v10 and v11 queries
     case 10:
-    default:
+    case 11:
       // $0 is the base node table. $1 is the property related neighborhood
       // table. $2 is property name. $3 is a boolean for is_custom_property.
       return R"sql(
@@ -242,6 +264,17 @@ absl::string_view GetContextPropertyJoinTable(int64_t query_version) {
           SELECT context_id, int_value, double_value, string_value, bool_value
           FROM ContextProperty WHERE name = "$2" AND is_custom_property = $3
         ) AS $1 ON $0.id = $1.context_id )sql";
+    // Head version supports queries from v12+
+    default:
+      // $0 is the base node table. $1 is the property related neighborhood
+      // table. $2 is property name. $3 is a boolean for is_custom_property.
+      return R"sql(
+        JOIN (
+          SELECT context_id, int_value, double_value, string_value, bool_value
+          FROM ContextProperty
+          WHERE name_id = (SELECT id FROM PropertyName WHERE name = "$2")
+            AND is_custom_property = $3
+        ) AS $1 ON $0.id = $1.context_id )sql";
   }
 }
 
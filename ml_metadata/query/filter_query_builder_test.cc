@@ -21,6 +21,7 @@ limitations under the License.
 #include "ml_metadata/metadata_store/test_util.h"
 #include "ml_metadata/proto/metadata_store.pb.h"
 #include "ml_metadata/query/filter_query_ast_resolver.h"
+#include "ml_metadata/query/native_filter_query_parser.h"
 
 namespace ml_metadata {
 namespace {
@@ -525,16 +526,29 @@ class SQLGenerationTest : public ::testing::TestWithParam<QueryTupleTestCase> {
     EXPECT_EQ(query_builder.GetFromClause(query_version),
               GetParam().GetFromClause<T>(query_version));
     EXPECT_EQ(query_builder.GetWhereClause(), GetParam().where_clause);
+
+    // The native parser generates the same clauses without ZetaSQL.
+    NativeFilterQueryParser<T> native_parser(GetParam().user_query);
+    ASSERT_EQ(absl::OkStatus(), native_parser.Parse());
+    EXPECT_EQ(native_parser.GetFromClause(query_version),
+              GetParam().GetFromClause<T>(query_version));
+    EXPECT_EQ(native_parser.GetWhereClause(), GetParam().where_clause);
   }
 };
 
 TEST_P(SQLGenerationTest, Artifact) {
+  if (GetParam().test_case_nodes.artifact) {
+    VerifyQueryTuple<Artifact>(/*query_version=*/12);
+  }
+}
+
+// TODO(b/257334039): cleanup after migration to v12+
+TEST_P(SQLGenerationTest, ArtifactV10) {
   if (GetParam().test_case_nodes.artifact) {
     VerifyQueryTuple<Artifact>(/*query_version=*/10);
   }
 }
 
-// TODO(b/257334039): cleanup after migration to v10+
 TEST_P(SQLGenerationTest, ArtifactV7) {
   if (GetParam().test_case_nodes.artifact) {
     VerifyQueryTuple<Artifact>(/*query_version=*/7);
@@ -552,12 +566,18 @@ TEST_P(SQLGenerationTest, ArtifactV9) {
 }
 
 TEST_P(SQLGenerationTest, Execution) {
+  if (GetParam().test_case_nodes.execution) {
+    VerifyQueryTuple<Execution>(/*query_version=*/12);
+  }
+}
+
+// TODO(b/257334039): cleanup after migration to v12+
+TEST_P(SQLGenerationTest, ExecutionV10) {
   if (GetParam().test_case_nodes.execution) {
     VerifyQueryTuple<Execution>(/*query_version=*/10);
   }
 }
 
-// TODO(b/257334039): cleanup after migration to v10+
 TEST_P(SQLGenerationTest, ExecutionV7) {
   if (GetParam().test_case_nodes.execution) {
     VerifyQueryTuple<Execution>(/*query_version=*/7);
@@ -575,12 +595,18 @@ TEST_P(SQLGenerationTest, ExecutionV9) {
 }
 
 TEST_P(SQLGenerationTest, Context) {
+  if (GetParam().test_case_nodes.context) {
+    VerifyQueryTuple<Context>(/*query_version=*/12);
+  }
+}
+
+// TODO(b/257334039): cleanup after migration to v12+
+TEST_P(SQLGenerationTest, ContextV10) {
   if (GetParam().test_case_nodes.context) {
     VerifyQueryTuple<Context>(/*query_version=*/10);
   }
 }
 
-// TODO(b/257334039): cleanup after migration to v10+
 TEST_P(SQLGenerationTest, ContextV7) {
   if (GetParam().test_case_nodes.context) {
     VerifyQueryTuple<Context>(/*query_version=*/7);
@@ -0,0 +1,50 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_GOOGLE_QUERY_FILTER_QUERY_ENUM_REWRITER_H
+#define ML_METADATA_GOOGLE_QUERY_FILTER_QUERY_ENUM_REWRITER_H
+
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace ml_metadata {
+
+// The enum predicates of the MLMD filtering query, e.g., `state = LIVE`, are
+// rewritten into predicates on the persisted int values, e.g., `state = 2`,
+// before the query is parsed. The functions are shared by the filtering query
+// parsers, so that they see the same rewritten query.
+//
+// Besides the value substitution, a `!=` or `NOT IN` predicate also matches the
+// nodes without the enum field, e.g., `state != LIVE` is rewritten into
+// `((state != 2) OR (state IS NULL))`.
+//
+// Returns InvalidArgument error if an unknown enum value is used.
+
+// Rewrites the predicates on Artifact.state.
+absl::StatusOr<std::string> RewriteArtifactStatePredicates(
+    absl::string_view query_string);
+
+// Rewrites the predicates on Execution.last_known_state.
+absl::StatusOr<std::string> RewriteExecutionStatePredicates(
+    absl::string_view query_string);
+
+// Rewrites the predicates on the types of the events, e.g., `events_0.type`.
+absl::StatusOr<std::string> RewriteEventTypePredicates(
+    absl::string_view query_string);
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_GOOGLE_QUERY_FILTER_QUERY_ENUM_REWRITER_H
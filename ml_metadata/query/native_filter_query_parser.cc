@@ -0,0 +1,758 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/query/native_filter_query_parser.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/query/filter_query_builder.h"
+#include "ml_metadata/query/filter_query_enum_rewriter.h"
+#include "ml_metadata/util/return_utils.h"
+#include "re2/re2.h"
+
+namespace ml_metadata {
+namespace {
+
+// The prefix for table alias in SQL clauses, the same as FilterQueryBuilder.
+constexpr absl::string_view kTableAliasPrefix = "table_";
+
+// A regular expression for the (custom) properties mentioned in the query,
+// which is a superset of the ones rewritten by FilterQueryAstResolver.
+constexpr absl::string_view kPropertyMentionRE =
+    "properties\\.([[:word:]]+|`[^`]+`)\\.(?:int|double|string|bool)";
+
+// The characters of backquoted property names that FilterQueryAstResolver
+// would treat as regular expression operators when rewriting the query.
+constexpr absl::string_view kRegexOperators = "\\^$|?*+()[]{}";
+
+enum class ColumnType { INT64, DOUBLE, STRING, BOOL };
+
+struct Column {
+  absl::string_view name;
+  ColumnType type;
+};
+
+// The columns of the node attributes and the neighbor fields, which are the
+// same as the ones added to the ZetaSQL analyzer by FilterQueryAstResolver.
+constexpr Column kCommonAttributes[] = {
+    {"id", ColumnType::INT64},
+    {"type_id", ColumnType::INT64},
+    {"type", ColumnType::STRING},
+    {"create_time_since_epoch", ColumnType::INT64},
+    {"last_update_time_since_epoch", ColumnType::INT64},
+    {"name", ColumnType::STRING},
+    {"external_id", ColumnType::STRING}};
+
+constexpr Column kArtifactAttributes[] = {{"uri", ColumnType::STRING},
+                                          {"state", ColumnType::INT64}};
+
+constexpr Column kExecutionAttributes[] = {
+    {"last_known_state", ColumnType::INT64}};
+
+constexpr Column kContextFields[] = {
+    {"id", ColumnType::INT64},
+    {"name", ColumnType::STRING},
+    {"type", ColumnType::STRING},
+    {"create_time_since_epoch", ColumnType::INT64},
+    {"last_update_time_since_epoch", ColumnType::INT64}};
+
+constexpr Column kArtifactFields[] = {
+    {"id", ColumnType::INT64},
+    {"name", ColumnType::STRING},
+    {"type", ColumnType::STRING},
+    {"state", ColumnType::INT64},
+    {"uri", ColumnType::STRING},
+    {"external_id", ColumnType::STRING},
+    {"create_time_since_epoch", ColumnType::INT64},
+    {"last_update_time_since_epoch", ColumnType::INT64}};
+
+constexpr Column kExecutionFields[] = {
+    {"id", ColumnType::INT64},
+    {"name", ColumnType::STRING},
+    {"type", ColumnType::STRING},
+    {"last_known_state", ColumnType::INT64},
+    {"external_id", ColumnType::STRING},
+    {"create_time_since_epoch", ColumnType::INT64},
+    {"last_update_time_since_epoch", ColumnType::INT64}};
+
+constexpr Column kArtifactEventFields[] = {
+    {"type", ColumnType::INT64},
+    {"milliseconds_since_epoch", ColumnType::INT64},
+    {"execution_id", ColumnType::INT64}};
+
+constexpr Column kExecutionEventFields[] = {
+    {"type", ColumnType::INT64},
+    {"milliseconds_since_epoch", ColumnType::INT64},
+    {"artifact_id", ColumnType::INT64}};
+
+constexpr Column kPropertyFields[] = {{"int_value", ColumnType::INT64},
+                                      {"double_value", ColumnType::DOUBLE},
+                                      {"string_value", ColumnType::STRING},
+                                      {"bool_value", ColumnType::BOOL}};
+
+// Returns the type of the column `name` in `columns` if it exists.
+std::optional<ColumnType> FindColumnType(absl::Span<const Column> columns,
+                                         absl::string_view name) {
+  for (const Column& column : columns) {
+    if (column.name == name) {
+      return column.type;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the type of the attribute `name` of the node type T if it exists.
+template <typename T>
+std::optional<ColumnType> FindAttributeType(absl::string_view name) {
+  std::optional<ColumnType> type = FindColumnType(kCommonAttributes, name);
+  if (type) {
+    return type;
+  }
+  if constexpr (std::is_same<T, Artifact>::value) {
+    return FindColumnType(kArtifactAttributes, name);
+  } else if constexpr (std::is_same<T, Execution>::value) {
+    return FindColumnType(kExecutionAttributes, name);
+  }
+  return std::nullopt;
+}
+
+// Rewrites the enum predicates in the same order as FilterQueryAstResolver.
+template <typename T>
+absl::StatusOr<std::string> RewriteEnumPredicates(
+    absl::string_view query_string) {
+  std::string rewritten_query;
+  if constexpr (std::is_same<T, Artifact>::value) {
+    MLMD_ASSIGN_OR_RETURN(rewritten_query,
+                          RewriteArtifactStatePredicates(query_string));
+    return RewriteEventTypePredicates(rewritten_query);
+  } else if constexpr (std::is_same<T, Execution>::value) {
+    MLMD_ASSIGN_OR_RETURN(rewritten_query,
+                          RewriteExecutionStatePredicates(query_string));
+    return RewriteEventTypePredicates(rewritten_query);
+  } else if constexpr (std::is_same<T, Context>::value) {
+    MLMD_ASSIGN_OR_RETURN(rewritten_query,
+                          RewriteArtifactStatePredicates(query_string));
+    return RewriteExecutionStatePredicates(rewritten_query);
+  }
+}
+
+absl::Status UnsupportedQueryError(absl::string_view reason) {
+  return absl::UnimplementedError(
+      absl::StrCat("The filter query is not supported natively: ", reason));
+}
+
+enum class TokenKind {
+  IDENTIFIER,
+  QUOTED_IDENTIFIER,
+  INTEGER,
+  FLOAT,
+  STRING,
+  SYMBOL,
+  END,
+};
+
+struct Token {
+  TokenKind kind;
+  // The identifier, the literal without quotes or the symbol.
+  std::string text;
+  // Whether the token is preceded by whitespace.
+  bool follows_space = false;
+};
+
+bool IsWordChar(char c) { return absl::ascii_isalnum(c) || c == '_'; }
+
+bool IsSymbol(const Token& token, absl::string_view symbol) {
+  return token.kind == TokenKind::SYMBOL && token.text == symbol;
+}
+
+// Splits the query into tokens. Only the literals whose SQL is known to be
+// generated the same way as ZetaSQL are accepted, e.g., strings without
+// escapes or quotes in them, and decimal numbers without exponents.
+absl::StatusOr<std::vector<Token>> Tokenize(absl::string_view query) {
+  std::vector<Token> tokens;
+  bool follows_space = false;
+  size_t i = 0;
+  while (i < query.size()) {
+    const char c = query[i];
+    if (absl::ascii_isspace(c)) {
+      follows_space = true;
+      i++;
+      continue;
+    }
+    Token token;
+    token.follows_space = follows_space;
+    follows_space = false;
+    // The path segments after a dot are identifiers even if they start with
+    // digits, e.g., the property name in `properties.0a.int_value`.
+    const bool follows_dot = !token.follows_space && !tokens.empty() &&
+                             IsSymbol(tokens.back(), ".");
+    if (IsWordChar(c) && (follows_dot || !absl::ascii_isdigit(c))) {
+      size_t end = i;
+      while (end < query.size() && IsWordChar(query[end])) {
+        end++;
+      }
+      token.kind = TokenKind::IDENTIFIER;
+      token.text = std::string(query.substr(i, end - i));
+      i = end;
+    } else if (absl::ascii_isdigit(c)) {
+      size_t end = i;
+      while (end < query.size() && absl::ascii_isdigit(query[end])) {
+        end++;
+      }
+      token.kind = TokenKind::INTEGER;
+      if (end < query.size() && query[end] == '.') {
+        token.kind = TokenKind::FLOAT;
+        end++;
+        while (end < query.size() && absl::ascii_isdigit(query[end])) {
+          end++;
+        }
+      }
+      if ((end < query.size() &&
+           (IsWordChar(query[end]) || query[end] == '.')) ||
+          (c == '0' && i + 1 < end && absl::ascii_isdigit(query[i + 1]))) {
+        return UnsupportedQueryError("numbers must be decimal literals");
+      }
+      token.text = std::string(query.substr(i, end - i));
+      i = end;
+    } else if (c == '`' || c == '\'' || c == '"') {
+      const size_t end = query.find(c, i + 1);
+      if (end == absl::string_view::npos) {
+        return UnsupportedQueryError("unterminated quotes");
+      }
+      token.kind = c == '`' ? TokenKind::QUOTED_IDENTIFIER : TokenKind::STRING;
+      token.text = std::string(query.substr(i + 1, end - i - 1));
+      for (const char text_char : token.text) {
+        if (text_char < 0x20 || text_char > 0x7e || text_char == '\\' ||
+            text_char == '\'' || text_char == '"') {
+          return UnsupportedQueryError(
+              "quoted text must consist of printable characters without "
+              "escapes or quotes");
+        }
+      }
+      if (token.text.empty() && token.kind == TokenKind::QUOTED_IDENTIFIER) {
+        return UnsupportedQueryError("empty quoted identifier");
+      }
+      i = end + 1;
+    } else {
+      token.kind = TokenKind::SYMBOL;
+      const absl::string_view two_chars = query.substr(i, 2);
+      if (two_chars == "!=" || two_chars == "<>" || two_chars == "<=" ||
+          two_chars == ">=") {
+        token.text = std::string(two_chars);
+      } else if (absl::StrContains("(),.=<>", c)) {
+        token.text = std::string(1, c);
+      } else {
+        return UnsupportedQueryError(
+            absl::StrCat("unexpected character ", query.substr(i, 1)));
+      }
+      i += token.text.size();
+    }
+    tokens.push_back(std::move(token));
+  }
+  tokens.push_back({TokenKind::END, "", follows_space});
+  return tokens;
+}
+
+// Returns the SQL of a DOUBLE literal, e.g., `(1.0)`, as ZetaSQL renders it.
+absl::StatusOr<std::string> GetDoubleLiteralSql(double value) {
+  const std::string text = absl::StrFormat("%.15g", value);
+  double parsed_value;
+  if (!absl::SimpleAtod(text, &parsed_value) || parsed_value != value ||
+      !absl::c_all_of(text, [](char c) {
+        return absl::ascii_isdigit(c) || c == '.' || c == '-';
+      })) {
+    return UnsupportedQueryError(
+        absl::StrCat("double literal without a short form: ", text));
+  }
+  return absl::StrCat("(", text, absl::StrContains(text, '.') ? "" : ".0",
+                      ")");
+}
+
+}  // namespace
+
+template <typename T>
+class NativeFilterQueryParser<T>::Parser {
+ public:
+  Parser(std::vector<Token> tokens, NativeFilterQueryParser<T>& output)
+      : tokens_(std::move(tokens)), output_(output) {}
+
+  // Returns the WHERE clause of the query without the enclosing parentheses.
+  absl::StatusOr<std::string> ParseQuery() {
+    MLMD_ASSIGN_OR_RETURN(std::string sql, ParseOr());
+    if (Peek().kind != TokenKind::END) {
+      return UnsupportedQueryError(
+          absl::StrCat("unexpected token ", Peek().text));
+    }
+    return sql;
+  }
+
+  // Returns the string literals in the query.
+  const std::vector<std::string>& string_literals() const {
+    return string_literals_;
+  }
+
+ private:
+  // A column mentioned in a predicate, e.g., `table_1.name`.
+  struct ColumnRef {
+    std::string sql;
+    ColumnType type;
+  };
+
+  // A neighbor that can be mentioned with its name prefix, e.g., `contexts_`.
+  struct Neighbor {
+    absl::string_view prefix;
+    NeighborKind kind;
+    absl::Span<const Column> fields;
+  };
+
+  // Returns the neighbors of the node type T, which are the same as the ones
+  // added to the ZetaSQL analyzer by FilterQueryAstResolver.
+  static std::vector<Neighbor> GetNeighbors() {
+    if constexpr (std::is_same<T, Artifact>::value) {
+      return {{"contexts_", NeighborKind::CONTEXT, kContextFields},
+              {"events_", NeighborKind::EVENT, kArtifactEventFields}};
+    } else if constexpr (std::is_same<T, Execution>::value) {
+      return {{"contexts_", NeighborKind::CONTEXT, kContextFields},
+              {"events_", NeighborKind::EVENT, kExecutionEventFields}};
+    } else if constexpr (std::is_same<T, Context>::value) {
+      return {
+          {"parent_contexts_", NeighborKind::PARENT_CONTEXT, kContextFields},
+          {"child_contexts_", NeighborKind::CHILD_CONTEXT, kContextFields},
+          {"artifacts_", NeighborKind::ARTIFACT, kArtifactFields},
+          {"executions_", NeighborKind::EXECUTION, kExecutionFields}};
+    }
+  }
+
+  const Token& Peek() const { return tokens_[position_]; }
+
+  const Token& Next() {
+    const Token& token = tokens_[position_];
+    if (token.kind != TokenKind::END) {
+      position_++;
+    }
+    return token;
+  }
+
+  // Consumes the next token if it is the (case-insensitive) `keyword`.
+  bool ConsumeKeyword(absl::string_view keyword) {
+    if (Peek().kind == TokenKind::IDENTIFIER &&
+        absl::EqualsIgnoreCase(Peek().text, keyword)) {
+      Next();
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeSymbol(absl::string_view symbol) {
+    if (IsSymbol(Peek(), symbol)) {
+      Next();
+      return true;
+    }
+    return false;
+  }
+
+  // Consumes a dot that directly follows the previous token, as the neighbor
+  // and property mentions are only recognized by ZetaSQL resolver this way.
+  absl::Status ConsumeAdjacentDot() {
+    if (Peek().follows_space || !ConsumeSymbol(".")) {
+      return UnsupportedQueryError("expected `.` in a column path");
+    }
+    return absl::OkStatus();
+  }
+
+  // Returns the alias of a table, which is auto-increased when the table is
+  // first seen, the same as FilterQueryBuilder::GetTableAlias.
+  std::string GetTableAlias(NeighborKind kind, absl::string_view name) {
+    absl::btree_map<std::string, std::string>& aliases =
+        output_.mentioned_alias_[kind];
+    auto it = aliases.find(name);
+    if (it == aliases.end()) {
+      it = aliases
+               .insert({std::string(name),
+                        absl::StrCat(kTableAliasPrefix, ++alias_index_)})
+               .first;
+    }
+    return it->second;
+  }
+
+  std::string GetTypeTableAlias() {
+    if (!output_.type_alias_) {
+      output_.type_alias_ = absl::StrCat(kTableAliasPrefix, ++alias_index_);
+    }
+    return *output_.type_alias_;
+  }
+
+  // Joins the operands of AND or OR, e.g., `(a) AND (b)`.
+  static std::string JoinOperands(const std::vector<std::string>& operands,
+                                  absl::string_view op) {
+    if (operands.size() == 1) {
+      return operands[0];
+    }
+    return absl::StrCat(
+        "(", absl::StrJoin(operands, absl::StrCat(") ", op, " (")), ")");
+  }
+
+  // or_expr := and_expr (OR and_expr)*
+  absl::StatusOr<std::string> ParseOr() {
+    std::vector<std::string> operands;
+    do {
+      MLMD_ASSIGN_OR_RETURN(std::string operand, ParseAnd());
+      operands.push_back(std::move(operand));
+    } while (ConsumeKeyword("OR"));
+    return JoinOperands(operands, "OR");
+  }
+
+  // and_expr := not_expr (AND not_expr)*
+  absl::StatusOr<std::string> ParseAnd() {
+    std::vector<std::string> operands;
+    do {
+      MLMD_ASSIGN_OR_RETURN(std::string operand, ParseNot());
+      operands.push_back(std::move(operand));
+    } while (ConsumeKeyword("AND"));
+    return JoinOperands(operands, "AND");
+  }
+
+  // not_expr := NOT not_expr | '(' or_expr ')' | predicate
+  absl::StatusOr<std::string> ParseNot() {
+    if (ConsumeKeyword("NOT")) {
+      MLMD_ASSIGN_OR_RETURN(std::string operand, ParseNot());
+      return absl::StrCat("NOT (", operand, ")");
+    }
+    if (ConsumeSymbol("(")) {
+      MLMD_ASSIGN_OR_RETURN(std::string operand, ParseOr());
+      if (!ConsumeSymbol(")")) {
+        return UnsupportedQueryError("expected `)`");
+      }
+      return operand;
+    }
+    return ParsePredicate();
+  }
+
+  // predicate := column IS NULL | column LIKE string | column [NOT] IN list
+  //            | column comparison_operator literal
+  absl::StatusOr<std::string> ParsePredicate() {
+    MLMD_ASSIGN_OR_RETURN(const ColumnRef column, ParseColumn());
+    const std::string lhs = absl::StrCat("(", column.sql, ")");
+    if (ConsumeKeyword("IS")) {
+      if (!ConsumeKeyword("NULL")) {
+        return UnsupportedQueryError("only IS NULL is supported");
+      }
+      return absl::StrCat(lhs, " IS NULL");
+    }
+    if (ConsumeKeyword("LIKE")) {
+      if (column.type != ColumnType::STRING ||
+          Peek().kind != TokenKind::STRING) {
+        return UnsupportedQueryError("LIKE requires strings");
+      }
+      MLMD_ASSIGN_OR_RETURN(const std::string pattern,
+                            ParseLiteral(column.type));
+      return absl::StrCat(lhs, " LIKE ", pattern);
+    }
+    const bool is_negated = ConsumeKeyword("NOT");
+    if (ConsumeKeyword("IN")) {
+      MLMD_ASSIGN_OR_RETURN(const std::string values, ParseInList(column));
+      const std::string in_predicate = absl::StrCat(lhs, " IN ", values);
+      return is_negated ? absl::StrCat("NOT (", in_predicate, ")")
+                        : in_predicate;
+    }
+    if (is_negated) {
+      return UnsupportedQueryError("only NOT IN is supported");
+    }
+    const Token& op = Next();
+    if (op.kind != TokenKind::SYMBOL || op.text == "(" || op.text == ")" ||
+        op.text == "," || op.text == ".") {
+      return UnsupportedQueryError("expected a comparison operator");
+    }
+    MLMD_ASSIGN_OR_RETURN(const std::string value, ParseLiteral(column.type));
+    return absl::StrCat(lhs, " ", op.text == "<>" ? "!=" : op.text, " ",
+                        value);
+  }
+
+  // Returns the SQL of a literal compared with a column of `type`.
+  absl::StatusOr<std::string> ParseLiteral(ColumnType type) {
+    const Token& token = Next();
+    if (token.kind == TokenKind::INTEGER &&
+        (type == ColumnType::INT64 || type == ColumnType::DOUBLE)) {
+      int64_t value;
+      if (!absl::SimpleAtoi(token.text, &value)) {
+        return UnsupportedQueryError(
+            absl::StrCat("integer out of range: ", token.text));
+      }
+      if (type == ColumnType::DOUBLE) {
+        // The integer literal is coerced to a DOUBLE literal.
+        return GetDoubleLiteralSql(static_cast<double>(value));
+      }
+      return absl::StrCat(value);
+    }
+    if (token.kind == TokenKind::FLOAT && type == ColumnType::DOUBLE) {
+      double value;
+      if (!absl::SimpleAtod(token.text, &value)) {
+        return UnsupportedQueryError(
+            absl::StrCat("invalid double: ", token.text));
+      }
+      return GetDoubleLiteralSql(value);
+    }
+    if (token.kind == TokenKind::STRING && type == ColumnType::STRING) {
+      string_literals_.push_back(token.text);
+      return absl::StrCat("(\"", token.text, "\")");
+    }
+    return UnsupportedQueryError(
+        absl::StrCat("unsupported literal for the column: ", token.text));
+  }
+
+  // Returns the SQL of the IN list, e.g., `(1, 2)`. Only INT64 values, which
+  // include the rewritten enum values, are supported.
+  absl::StatusOr<std::string> ParseInList(const ColumnRef& column) {
+    if (column.type != ColumnType::INT64 || !ConsumeSymbol("(")) {
+      return UnsupportedQueryError("IN requires a list of integers");
+    }
+    std::vector<std::string> values;
+    do {
+      if (Peek().kind != TokenKind::INTEGER) {
+        return UnsupportedQueryError("IN requires a list of integers");
+      }
+      MLMD_ASSIGN_OR_RETURN(std::string value, ParseLiteral(column.type));
+      values.push_back(std::move(value));
+    } while (ConsumeSymbol(","));
+    if (!ConsumeSymbol(")")) {
+      return UnsupportedQueryError("expected `)`");
+    }
+    return absl::StrCat("(", absl::StrJoin(values, ", "), ")");
+  }
+
+  // column := attribute | neighbor '.' field
+  //         | (properties | custom_properties) '.' name '.' field
+  absl::StatusOr<ColumnRef> ParseColumn() {
+    const Token& token = Next();
+    if (token.kind != TokenKind::IDENTIFIER) {
+      return UnsupportedQueryError("expected a column");
+    }
+    const std::string& name = token.text;
+    if (name == "properties") {
+      return ParsePropertyColumn(NeighborKind::PROPERTY);
+    }
+    if (name == "custom_properties") {
+      return ParsePropertyColumn(NeighborKind::CUSTOM_PROPERTY);
+    }
+    for (const Neighbor& neighbor : GetNeighbors()) {
+      if (name.size() > neighbor.prefix.size() &&
+          absl::StartsWith(name, neighbor.prefix)) {
+        MLMD_RETURN_IF_ERROR(ConsumeAdjacentDot());
+        const Token& field = Next();
+        const std::optional<ColumnType> field_type =
+            field.kind == TokenKind::IDENTIFIER
+                ? FindColumnType(neighbor.fields, field.text)
+                : std::nullopt;
+        if (!field_type) {
+          return UnsupportedQueryError(
+              absl::StrCat("unknown field of ", name, ": ", field.text));
+        }
+        return ColumnRef{
+            absl::StrCat(GetTableAlias(neighbor.kind, name), ".", field.text),
+            *field_type};
+      }
+    }
+    const std::optional<ColumnType> attribute_type = FindAttributeType<T>(name);
+    if (!attribute_type || IsSymbol(Peek(), ".")) {
+      return UnsupportedQueryError(absl::StrCat("unknown column: ", name));
+    }
+    if (name == "type") {
+      return ColumnRef{absl::StrCat(GetTypeTableAlias(), ".type"),
+                       *attribute_type};
+    }
+    return ColumnRef{
+        absl::StrCat(FilterQueryBuilder<T>::kBaseTableAlias, ".", name),
+        *attribute_type};
+  }
+
+  // Parses the rest of `properties.name.field`, where the name is a word or a
+  // backquoted string, e.g., properties.`a b`.int_value.
+  absl::StatusOr<ColumnRef> ParsePropertyColumn(NeighborKind kind) {
+    MLMD_RETURN_IF_ERROR(ConsumeAdjacentDot());
+    const Token& name = Next();
+    if (name.follows_space || (name.kind != TokenKind::IDENTIFIER &&
+                               name.kind != TokenKind::QUOTED_IDENTIFIER)) {
+      return UnsupportedQueryError("expected a property name");
+    }
+    const bool is_quoted = name.kind == TokenKind::QUOTED_IDENTIFIER;
+    if (is_quoted && absl::string_view(name.text).find_first_of(
+                         kRegexOperators) != absl::string_view::npos) {
+      return UnsupportedQueryError(
+          absl::StrCat("unsupported property name: ", name.text));
+    }
+    // FilterQueryAstResolver only rewrites the first form of the property
+    // mentions, so the same property is always quoted or always not quoted.
+    const auto it =
+        quoted_properties_[kind].insert({name.text, is_quoted}).first;
+    if (it->second != is_quoted) {
+      return UnsupportedQueryError(absl::StrCat(
+          "property mentioned with and without quotes: ", name.text));
+    }
+    MLMD_RETURN_IF_ERROR(ConsumeAdjacentDot());
+    const Token& field = Next();
+    const std::optional<ColumnType> field_type =
+        field.kind == TokenKind::IDENTIFIER && !field.follows_space
+            ? FindColumnType(kPropertyFields, field.text)
+            : std::nullopt;
+    if (!field_type) {
+      return UnsupportedQueryError(
+          absl::StrCat("unknown property field: ", field.text));
+    }
+    return ColumnRef{
+        absl::StrCat(GetTableAlias(kind, name.text), ".", field.text),
+        *field_type};
+  }
+
+  const std::vector<Token> tokens_;
+  NativeFilterQueryParser<T>& output_;
+  int position_ = 0;
+  // Auto increased indices used as suffix of different table alias.
+  int alias_index_ = 0;
+  std::vector<std::string> string_literals_;
+  // Whether the mentioned (custom) properties are backquoted.
+  absl::flat_hash_map<NeighborKind, absl::flat_hash_map<std::string, bool>>
+      quoted_properties_;
+};
+
+template <typename T>
+NativeFilterQueryParser<T>::NativeFilterQueryParser(
+    absl::string_view query_string)
+    : raw_query_(query_string) {}
+
+template <typename T>
+absl::Status NativeFilterQueryParser<T>::Parse() {
+  where_clause_.clear();
+  type_alias_.reset();
+  mentioned_alias_.clear();
+  MLMD_ASSIGN_OR_RETURN(const std::string query,
+                        RewriteEnumPredicates<T>(raw_query_));
+  MLMD_ASSIGN_OR_RETURN(std::vector<Token> tokens, Tokenize(query));
+  Parser parser(std::move(tokens), *this);
+  MLMD_ASSIGN_OR_RETURN(where_clause_, parser.ParseQuery());
+
+  // FilterQueryAstResolver rewrites the property mentions in string literals
+  // as well, which changes the literals.
+  static LazyRE2 property_mention_re = {kPropertyMentionRE.data()};
+  absl::string_view remaining_query = query;
+  std::string mentioned_property;
+  while (RE2::FindAndConsume(&remaining_query, *property_mention_re,
+                             &mentioned_property)) {
+    for (const std::string& literal : parser.string_literals()) {
+      if (absl::StrContains(
+              literal, absl::StrCat("properties.", mentioned_property, "."))) {
+        return UnsupportedQueryError(
+            absl::StrCat("property mention in string literal: ", literal));
+      }
+    }
+  }
+  // The column names of ZetaSQL are case-insensitive.
+  for (const auto& [kind, aliases] : mentioned_alias_) {
+    absl::flat_hash_set<std::string> lowercase_names;
+    for (const auto& [name, alias] : aliases) {
+      if (!lowercase_names.insert(absl::AsciiStrToLower(name)).second) {
+        return UnsupportedQueryError(
+            absl::StrCat("names differ only in case: ", name));
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+template <typename T>
+std::string NativeFilterQueryParser<T>::GetWhereClause() const {
+  return absl::StrCat("(", where_clause_, ")");
+}
+
+template <typename T>
+std::string NativeFilterQueryParser<T>::GetFromClause(
+    int64_t query_version) const {
+  using Builder = FilterQueryBuilder<T>;
+  const absl::string_view base_alias = Builder::kBaseTableAlias;
+  std::string result = Builder::GetBaseNodeTable(base_alias);
+  if (type_alias_) {
+    absl::StrAppend(&result,
+                    Builder::GetTypeJoinTable(base_alias, *type_alias_));
+  }
+  // Appends the joins of the mentioned neighbors of `kind`.
+  const auto append_joins = [&](NeighborKind kind, const auto& get_join_table) {
+    const auto it = mentioned_alias_.find(kind);
+    if (it == mentioned_alias_.end()) {
+      return;
+    }
+    for (const auto& [name, alias] : it->second) {
+      absl::StrAppend(&result, get_join_table(name, alias));
+    }
+  };
+  append_joins(NeighborKind::CONTEXT,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetContextJoinTable(base_alias, alias);
+               });
+  append_joins(NeighborKind::ARTIFACT,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetArtifactJoinTable(base_alias, alias,
+                                                      query_version);
+               });
+  append_joins(NeighborKind::EXECUTION,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetExecutionJoinTable(base_alias, alias);
+               });
+  append_joins(NeighborKind::PROPERTY,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetPropertyJoinTable(base_alias, alias, name,
+                                                      query_version);
+               });
+  append_joins(NeighborKind::CUSTOM_PROPERTY,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetCustomPropertyJoinTable(
+                     base_alias, alias, name, query_version);
+               });
+  append_joins(NeighborKind::PARENT_CONTEXT,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetParentContextJoinTable(base_alias, alias);
+               });
+  append_joins(NeighborKind::CHILD_CONTEXT,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetChildContextJoinTable(base_alias, alias);
+               });
+  append_joins(NeighborKind::EVENT,
+               [&](absl::string_view name, absl::string_view alias) {
+                 return Builder::GetEventJoinTable(base_alias, alias);
+               });
+  return result;
+}
+
+// Explicit template instantiation for supported node types.
+template class NativeFilterQueryParser<Artifact>;
+template class NativeFilterQueryParser<Execution>;
+template class NativeFilterQueryParser<Context>;
+
+}  // namespace ml_metadata
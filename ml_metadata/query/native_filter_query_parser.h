@@ -0,0 +1,115 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ML_METADATA_GOOGLE_QUERY_NATIVE_FILTER_QUERY_PARSER_H
+#define ML_METADATA_GOOGLE_QUERY_NATIVE_FILTER_QUERY_PARSER_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "absl/container/btree_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+namespace ml_metadata {
+
+// NativeFilterQueryParser is a lightweight alternative to resolving a filtering
+// query with FilterQueryAstResolver and generating SQL with FilterQueryBuilder.
+// It parses the query with a hand-written recursive descent parser, checks the
+// types of the mentioned columns and literals against the MLMD node schema,
+// and generates the same FROM and WHERE clauses as FilterQueryBuilder, without
+// running the ZetaSQL analyzer. It can be instantiated with MLMD nodes types:
+// Artifact, Execution and Context.
+//
+// The parser supports the common subset of the filtering query syntax:
+// a) predicates between a column and literals: =, !=, <>, <, <=, >, >=, LIKE,
+//    [NOT] IN and IS NULL, where the column is a node attribute, e.g., `uri`,
+//    a field of a neighbor, e.g., `contexts_a.name` or `events_0.type`, or a
+//    (custom) property value, e.g., `properties.x.string_value`.
+// b) the predicates combined with AND, OR, NOT and parentheses.
+// The queries outside of the subset are rejected with UNIMPLEMENTED error, and
+// callers are expected to fall back to the ZetaSQL based resolver and builder,
+// which also report the errors of the invalid queries.
+//
+// Usage example:
+//
+//    NativeFilterQueryParser<Artifact> parser(filter_query);
+//    if (parser.Parse().ok()) {
+//      from_clause = parser.GetFromClause(query_version);
+//      where_clause = parser.GetWhereClause();
+//    } else {
+//      // Resolves and builds the query with ZetaSQL.
+//    }
+template <typename T>
+class NativeFilterQueryParser {
+ public:
+  explicit NativeFilterQueryParser(absl::string_view query_string);
+
+  // Not copyable or movable
+  NativeFilterQueryParser(const NativeFilterQueryParser&) = delete;
+  NativeFilterQueryParser& operator=(const NativeFilterQueryParser&) = delete;
+
+  // Parses and type checks the query string.
+  // Returns UNIMPLEMENTED error if the query is not in the supported subset,
+  //   or is not a valid filtering query.
+  // Returns INVALID_ARGUMENT error if the query uses an unknown enum value.
+  absl::Status Parse();
+
+  // Returns the SQL string that can be used in MLMD node listing WHERE clause.
+  // It is the same as FilterQueryBuilder::GetWhereClause for the query.
+  // Must be called after Parse() succeeded.
+  std::string GetWhereClause() const;
+
+  // Returns the SQL string that can be used in MLMD node listing FROM clause.
+  // It is the same as FilterQueryBuilder::GetFromClause for the query.
+  // Must be called after Parse() succeeded.
+  std::string GetFromClause(int64_t query_version) const;
+
+ private:
+  // The recursive descent parser that generates the clauses.
+  class Parser;
+
+  // The kinds of the neighbor tables joined with the node table.
+  enum class NeighborKind {
+    CONTEXT,
+    ARTIFACT,
+    EXECUTION,
+    PROPERTY,
+    CUSTOM_PROPERTY,
+    PARENT_CONTEXT,
+    CHILD_CONTEXT,
+    EVENT,
+  };
+
+  // The table alias of the mentioned neighbors keyed by their kinds and names.
+  // The names are the neighbor names in the query, e.g., `contexts_a`, or the
+  // property names for (custom) properties, so that the joins are ordered in
+  // the same way as FilterQueryBuilder.
+  using NeighborTableAlias =
+      absl::btree_map<NeighborKind, absl::btree_map<std::string, std::string>>;
+
+  // The user query.
+  const std::string raw_query_;
+  // The generated WHERE clause without the enclosing parentheses.
+  std::string where_clause_;
+  // The alias of the Type table, if `type` is mentioned.
+  std::optional<std::string> type_alias_;
+  // The alias names of the mentioned neighbor tables.
+  NeighborTableAlias mentioned_alias_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // ML_METADATA_GOOGLE_QUERY_NATIVE_FILTER_QUERY_PARSER_H
@@ -0,0 +1,126 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/query/native_filter_query_parser.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+#include "absl/status/status.h"
+#include "ml_metadata/proto/metadata_store.pb.h"
+#include "ml_metadata/query/filter_query_ast_resolver.h"
+#include "ml_metadata/query/filter_query_builder.h"
+
+namespace ml_metadata {
+namespace {
+
+// The query versions whose FROM clauses differ.
+constexpr int64_t kQueryVersions[] = {7, 8, 9, 10, 12};
+
+// Verifies that the native parser generates the same clauses as resolving the
+// `query` with ZetaSQL and building the SQL with FilterQueryBuilder.
+template <typename T>
+void VerifySameClausesAsZetaSql(const std::string& query) {
+  LOG(INFO) << "Testing valid query string: " << query;
+  FilterQueryAstResolver<T> ast_resolver(query);
+  ASSERT_EQ(absl::OkStatus(), ast_resolver.Resolve());
+  FilterQueryBuilder<T> query_builder;
+  ASSERT_EQ(absl::OkStatus(), ast_resolver.GetAst()->Accept(&query_builder));
+
+  NativeFilterQueryParser<T> native_parser(query);
+  ASSERT_EQ(absl::OkStatus(), native_parser.Parse());
+  EXPECT_EQ(native_parser.GetWhereClause(), query_builder.GetWhereClause());
+  for (const int64_t query_version : kQueryVersions) {
+    EXPECT_EQ(native_parser.GetFromClause(query_version),
+              query_builder.GetFromClause(query_version));
+  }
+}
+
+// The queries in addition to the ones of filter_query_builder_test, which
+// already checks the native parser with its test cases.
+TEST(NativeFilterQueryParserTest, SameClausesAsZetaSqlForArtifacts) {
+  const std::vector<std::string> queries = {
+      "id IS NULL",
+      "uri IS NULL OR name = 'a'",
+      "state != LIVE",
+      "state NOT IN (DELETED, LIVE) AND id = 1",
+      "id IN (1, 2, 3)",
+      "id NOT IN (1, 2)",
+      "NOT (type_id = 1 OR id = 2)",
+      "name <> 'a' AND external_id >= 'b'",
+      "create_time_since_epoch <= 10 OR last_update_time_since_epoch < 20",
+      "((type_id = 1))",
+      "type_id = 1 AND (id = 2 AND name = 'x') AND id = 3",
+      "properties.p1.int_value = 1 AND properties.p0.int_value = 2",
+      "properties.p0.double_value = 1.5",
+      "properties.p0.string_value IS NULL",
+      "custom_properties.p0.string_value LIKE '%a%'",
+      "events_0.type != OUTPUT",
+      "contexts_b.id = 1 AND contexts_a.id = 2 AND type = 'x'"};
+  for (const std::string& query : queries) {
+    VerifySameClausesAsZetaSql<Artifact>(query);
+  }
+}
+
+TEST(NativeFilterQueryParserTest, SameClausesAsZetaSqlForExecutions) {
+  const std::vector<std::string> queries = {
+      "last_known_state != COMPLETE",
+      "events_0.artifact_id = 1 AND contexts_a.name LIKE 'a%'"};
+  for (const std::string& query : queries) {
+    VerifySameClausesAsZetaSql<Execution>(query);
+  }
+}
+
+TEST(NativeFilterQueryParserTest, SameClausesAsZetaSqlForContexts) {
+  const std::vector<std::string> queries = {
+      "artifacts_0.state = LIVE AND executions_0.last_known_state IN "
+      "(COMPLETE)",
+      "child_contexts_b.id = 1 OR parent_contexts_a.id IS NULL"};
+  for (const std::string& query : queries) {
+    VerifySameClausesAsZetaSql<Context>(query);
+  }
+}
+
+TEST(NativeFilterQueryParserTest, UnsupportedQueries) {
+  const std::vector<std::string> queries = {
+      // predicates outside of the subset
+      "id IS NOT NULL", "name NOT LIKE 'a'", "1 = id", "type_id = id",
+      "name IN ('a', 'b')",
+      // literals whose SQL may differ from ZetaSQL
+      "id > -1", "id = 0x10", "type_id = 1.5",
+      "properties.p0.double_value = 1e3", "properties.p0.bool_value = true",
+      "name = 'a\\'b'",
+      // mentions that FilterQueryAstResolver resolves differently
+      "ID = 1", "contexts_0 .name = 'a'",
+      "properties.p0.int_value = 1 AND properties.`p0`.int_value = 2",
+      "name = 'properties.p0.int_value'",
+      "contexts_a.id = 1 AND contexts_A.id = 2",
+      // invalid queries
+      "uri = 'a' AND", "last_known_state = 1", "uri = 'a' -- comment"};
+  for (const std::string& query : queries) {
+    NativeFilterQueryParser<Artifact> native_parser(query);
+    EXPECT_TRUE(absl::IsUnimplemented(native_parser.Parse())) << query;
+  }
+}
+
+TEST(NativeFilterQueryParserTest, InvalidEnumValue) {
+  NativeFilterQueryParser<Artifact> native_parser("state = FOO");
+  EXPECT_TRUE(absl::IsInvalidArgument(native_parser.Parse()));
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -0,0 +1,346 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/util/id_bitmap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/numeric/bits.h"
+#include "absl/types/span.h"
+
+namespace ml_metadata {
+namespace {
+
+int64_t HighBits(int64_t id) { return id >> 16; }
+
+uint16_t LowBits(int64_t id) { return static_cast<uint16_t>(id & 0xFFFF); }
+
+int64_t ToId(int64_t high, uint16_t low) {
+  return static_cast<int64_t>((static_cast<uint64_t>(high) << 16) | low);
+}
+
+bool TestBit(const std::vector<uint64_t>& bitset, uint16_t low) {
+  return (bitset[low >> 6] >> (low & 63)) & 1;
+}
+
+void SetBit(std::vector<uint64_t>& bitset, uint16_t low) {
+  bitset[low >> 6] |= uint64_t{1} << (low & 63);
+}
+
+void ClearBit(std::vector<uint64_t>& bitset, uint16_t low) {
+  bitset[low >> 6] &= ~(uint64_t{1} << (low & 63));
+}
+
+int CountBits(const std::vector<uint64_t>& bitset) {
+  int count = 0;
+  for (uint64_t word : bitset) {
+    count += absl::popcount(word);
+  }
+  return count;
+}
+
+}  // namespace
+
+bool IdBitmap::Container::Contains(uint16_t low) const {
+  if (is_bitset()) {
+    return TestBit(bitset, low);
+  }
+  return std::binary_search(array.begin(), array.end(), low);
+}
+
+void IdBitmap::Container::Insert(uint16_t low) {
+  if (is_bitset()) {
+    if (!TestBit(bitset, low)) {
+      SetBit(bitset, low);
+      cardinality++;
+    }
+    return;
+  }
+  auto it = std::lower_bound(array.begin(), array.end(), low);
+  if (it != array.end() && *it == low) {
+    return;
+  }
+  array.insert(it, low);
+  cardinality++;
+  Normalize();
+}
+
+void IdBitmap::Container::UnionWith(const Container& other) {
+  if (is_bitset() && other.is_bitset()) {
+    for (int i = 0; i < kBitsetWords; i++) {
+      bitset[i] |= other.bitset[i];
+    }
+    cardinality = CountBits(bitset);
+    return;
+  }
+  if (is_bitset()) {
+    for (uint16_t low : other.array) {
+      SetBit(bitset, low);
+    }
+    cardinality = CountBits(bitset);
+    return;
+  }
+  if (other.is_bitset()) {
+    std::vector<uint64_t> merged = other.bitset;
+    for (uint16_t low : array) {
+      SetBit(merged, low);
+    }
+    array.clear();
+    bitset = std::move(merged);
+    cardinality = CountBits(bitset);
+    return;
+  }
+  std::vector<uint16_t> merged;
+  merged.reserve(array.size() + other.array.size());
+  std::set_union(array.begin(), array.end(), other.array.begin(),
+                 other.array.end(), std::back_inserter(merged));
+  array = std::move(merged);
+  cardinality = array.size();
+  Normalize();
+}
+
+void IdBitmap::Container::Subtract(const Container& other) {
+  if (is_bitset() && other.is_bitset()) {
+    for (int i = 0; i < kBitsetWords; i++) {
+      bitset[i] &= ~other.bitset[i];
+    }
+    cardinality = CountBits(bitset);
+  } else if (is_bitset()) {
+    for (uint16_t low : other.array) {
+      ClearBit(bitset, low);
+    }
+    cardinality = CountBits(bitset);
+  } else if (other.is_bitset()) {
+    array.erase(std::remove_if(array.begin(), array.end(),
+                               [&other](uint16_t low) {
+                                 return TestBit(other.bitset, low);
+                               }),
+                array.end());
+    cardinality = array.size();
+  } else {
+    std::vector<uint16_t> remaining;
+    remaining.reserve(array.size());
+    std::set_difference(array.begin(), array.end(), other.array.begin(),
+                        other.array.end(), std::back_inserter(remaining));
+    array = std::move(remaining);
+    cardinality = array.size();
+  }
+  Normalize();
+}
+
+void IdBitmap::Container::IntersectWith(const Container& other) {
+  if (is_bitset() && other.is_bitset()) {
+    for (int i = 0; i < kBitsetWords; i++) {
+      bitset[i] &= other.bitset[i];
+    }
+    cardinality = CountBits(bitset);
+  } else if (is_bitset()) {
+    std::vector<uint16_t> kept;
+    for (uint16_t low : other.array) {
+      if (TestBit(bitset, low)) {
+        kept.push_back(low);
+      }
+    }
+    bitset.clear();
+    array = std::move(kept);
+    cardinality = array.size();
+  } else if (other.is_bitset()) {
+    array.erase(std::remove_if(array.begin(), array.end(),
+                               [&other](uint16_t low) {
+                                 return !TestBit(other.bitset, low);
+                               }),
+                array.end());
+    cardinality = array.size();
+  } else {
+    std::vector<uint16_t> kept;
+    std::set_intersection(array.begin(), array.end(), other.array.begin(),
+                          other.array.end(), std::back_inserter(kept));
+    array = std::move(kept);
+    cardinality = array.size();
+  }
+  Normalize();
+}
+
+void IdBitmap::Container::Normalize() {
+  if (!is_bitset() && cardinality > kMaxArraySize) {
+    bitset.assign(kBitsetWords, 0);
+    for (uint16_t low : array) {
+      SetBit(bitset, low);
+    }
+    array.clear();
+    array.shrink_to_fit();
+  } else if (is_bitset() && cardinality <= kMaxArraySize) {
+    array.clear();
+    array.reserve(cardinality);
+    for (int i = 0; i < kBitsetWords; i++) {
+      for (uint64_t word = bitset[i]; word != 0; word &= word - 1) {
+        array.push_back(
+            static_cast<uint16_t>(i * 64 + absl::countr_zero(word)));
+      }
+    }
+    bitset.clear();
+    bitset.shrink_to_fit();
+  }
+}
+
+void IdBitmap::Container::AppendTo(int64_t high,
+                                   std::vector<int64_t>& ids) const {
+  if (!is_bitset()) {
+    for (uint16_t low : array) {
+      ids.push_back(ToId(high, low));
+    }
+    return;
+  }
+  for (int i = 0; i < kBitsetWords; i++) {
+    for (uint64_t word = bitset[i]; word != 0; word &= word - 1) {
+      ids.push_back(ToId(
+          high, static_cast<uint16_t>(i * 64 + absl::countr_zero(word))));
+    }
+  }
+}
+
+IdBitmap IdBitmap::FromIds(absl::Span<const int64_t> ids) {
+  std::vector<int64_t> sorted_ids(ids.begin(), ids.end());
+  absl::c_sort(sorted_ids);
+  sorted_ids.erase(std::unique(sorted_ids.begin(), sorted_ids.end()),
+                   sorted_ids.end());
+  IdBitmap bitmap;
+  for (int64_t id : sorted_ids) {
+    const int64_t high = HighBits(id);
+    if (bitmap.chunks_.empty() || bitmap.chunks_.back().first != high) {
+      bitmap.chunks_.emplace_back(high, Container());
+    }
+    // Ids arrive in ascending order, so appending keeps the array sorted.
+    Container& container = bitmap.chunks_.back().second;
+    container.array.push_back(LowBits(id));
+    container.cardinality++;
+  }
+  for (Chunk& chunk : bitmap.chunks_) {
+    chunk.second.Normalize();
+  }
+  return bitmap;
+}
+
+const IdBitmap::Container* IdBitmap::FindContainer(int64_t high) const {
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), high,
+      [](const Chunk& chunk, int64_t key) { return chunk.first < key; });
+  if (it == chunks_.end() || it->first != high) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void IdBitmap::Insert(int64_t id) {
+  const int64_t high = HighBits(id);
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), high,
+      [](const Chunk& chunk, int64_t key) { return chunk.first < key; });
+  if (it == chunks_.end() || it->first != high) {
+    it = chunks_.emplace(it, high, Container());
+  }
+  it->second.Insert(LowBits(id));
+}
+
+bool IdBitmap::Contains(int64_t id) const {
+  const Container* container = FindContainer(HighBits(id));
+  return container != nullptr && container->Contains(LowBits(id));
+}
+
+int64_t IdBitmap::size() const {
+  int64_t size = 0;
+  for (const Chunk& chunk : chunks_) {
+    size += chunk.second.cardinality;
+  }
+  return size;
+}
+
+void IdBitmap::UnionWith(const IdBitmap& other) {
+  std::vector<Chunk> merged;
+  merged.reserve(chunks_.size() + other.chunks_.size());
+  auto it = chunks_.begin();
+  auto other_it = other.chunks_.begin();
+  while (it != chunks_.end() || other_it != other.chunks_.end()) {
+    if (other_it == other.chunks_.end() ||
+        (it != chunks_.end() && it->first < other_it->first)) {
+      merged.push_back(std::move(*it++));
+    } else if (it == chunks_.end() || other_it->first < it->first) {
+      merged.push_back(*other_it++);
+    } else {
+      it->second.UnionWith(other_it->second);
+      merged.push_back(std::move(*it++));
+      ++other_it;
+    }
+  }
+  chunks_ = std::move(merged);
+}
+
+void IdBitmap::Subtract(const IdBitmap& other) {
+  auto other_it = other.chunks_.begin();
+  for (Chunk& chunk : chunks_) {
+    while (other_it != other.chunks_.end() && other_it->first < chunk.first) {
+      ++other_it;
+    }
+    if (other_it == other.chunks_.end()) {
+      break;
+    }
+    if (other_it->first == chunk.first) {
+      chunk.second.Subtract(other_it->second);
+    }
+  }
+  chunks_.erase(std::remove_if(chunks_.begin(), chunks_.end(),
+                               [](const Chunk& chunk) {
+                                 return chunk.second.cardinality == 0;
+                               }),
+                chunks_.end());
+}
+
+void IdBitmap::IntersectWith(const IdBitmap& other) {
+  auto other_it = other.chunks_.begin();
+  for (Chunk& chunk : chunks_) {
+    while (other_it != other.chunks_.end() && other_it->first < chunk.first) {
+      ++other_it;
+    }
+    if (other_it == other.chunks_.end() || other_it->first != chunk.first) {
+      chunk.second = Container();
+      continue;
+    }
+    chunk.second.IntersectWith(other_it->second);
+  }
+  chunks_.erase(std::remove_if(chunks_.begin(), chunks_.end(),
+                               [](const Chunk& chunk) {
+                                 return chunk.second.cardinality == 0;
+                               }),
+                chunks_.end());
+}
+
+std::vector<int64_t> IdBitmap::ToVector() const {
+  std::vector<int64_t> ids;
+  ids.reserve(size());
+  for (const Chunk& chunk : chunks_) {
+    chunk.second.AppendTo(chunk.first, ids);
+  }
+  return ids;
+}
+
+bool operator==(const IdBitmap& a, const IdBitmap& b) {
+  return a.chunks_ == b.chunks_;
+}
+
+}  // namespace ml_metadata
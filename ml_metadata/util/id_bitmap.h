@@ -0,0 +1,117 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef THIRD_PARTY_ML_METADATA_UTIL_ID_BITMAP_H_
+#define THIRD_PARTY_ML_METADATA_UTIL_ID_BITMAP_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace ml_metadata {
+
+// A compressed set of node ids, laid out in the style of a Roaring bitmap.
+//
+// Ids are partitioned by their high 48 bits into chunks of 2^16 ids. Each
+// non-empty chunk is stored in one container, which is either a sorted array
+// of the low 16 bits (when the chunk holds at most kMaxArraySize ids) or a
+// fixed 8KB bitset. Node ids are allocated densely by the backends, so the
+// ids visited by a lineage traversal cluster in few chunks and set algebra
+// between two bitmaps reduces to merges of short sorted arrays or to
+// word-wise boolean operations on bitsets, instead of one hash probe per id.
+//
+// The class is not thread-safe.
+class IdBitmap {
+ public:
+  // The largest number of ids kept in an array container. Larger containers
+  // are converted to bitsets, which use the same 8KB at this size.
+  static constexpr int kMaxArraySize = 4096;
+
+  IdBitmap() = default;
+
+  // Builds a bitmap from `ids`, which may be unordered and contain duplicates.
+  static IdBitmap FromIds(absl::Span<const int64_t> ids);
+
+  // Adds `id` to the set.
+  void Insert(int64_t id);
+
+  // Returns true if `id` is in the set.
+  bool Contains(int64_t id) const;
+
+  // Returns the number of ids in the set.
+  int64_t size() const;
+
+  bool empty() const { return chunks_.empty(); }
+
+  void clear() { chunks_.clear(); }
+
+  // Adds all ids in `other` to the set.
+  void UnionWith(const IdBitmap& other);
+
+  // Removes all ids in `other` from the set.
+  void Subtract(const IdBitmap& other);
+
+  // Keeps only the ids that are also in `other`.
+  void IntersectWith(const IdBitmap& other);
+
+  // Returns the ids in ascending order.
+  std::vector<int64_t> ToVector() const;
+
+  friend bool operator==(const IdBitmap& a, const IdBitmap& b);
+  friend bool operator!=(const IdBitmap& a, const IdBitmap& b) {
+    return !(a == b);
+  }
+
+ private:
+  static constexpr int kBitsetWords = (1 << 16) / 64;
+
+  // The ids of one chunk. Exactly one of `array` and `bitset` is in use; an
+  // empty `bitset` means the container is an array container.
+  struct Container {
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bitset;
+    int cardinality = 0;
+
+    bool is_bitset() const { return !bitset.empty(); }
+    bool Contains(uint16_t low) const;
+    void Insert(uint16_t low);
+    void UnionWith(const Container& other);
+    void Subtract(const Container& other);
+    void IntersectWith(const Container& other);
+    // Converts between the representations so that the container uses the
+    // cheaper one for its current cardinality.
+    void Normalize();
+    void AppendTo(int64_t high, std::vector<int64_t>& ids) const;
+
+    // Normalize() keeps the representation a function of the cardinality,
+    // so equal containers always share the same representation.
+    friend bool operator==(const Container& a, const Container& b) {
+      return a.array == b.array && a.bitset == b.bitset;
+    }
+  };
+
+  using Chunk = std::pair<int64_t, Container>;
+
+  // Returns the chunk with `high` bits if it exists, nullptr otherwise.
+  const Container* FindContainer(int64_t high) const;
+
+  // Chunks ordered by their high bits.
+  std::vector<Chunk> chunks_;
+};
+
+}  // namespace ml_metadata
+
+#endif  // THIRD_PARTY_ML_METADATA_UTIL_ID_BITMAP_H_
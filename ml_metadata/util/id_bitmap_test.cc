@@ -0,0 +1,143 @@
+/* Copyright 2023 Google LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "ml_metadata/util/id_bitmap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ml_metadata {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+
+TEST(IdBitmap, InsertAndContains) {
+  IdBitmap bitmap;
+  EXPECT_TRUE(bitmap.empty());
+  bitmap.Insert(3);
+  bitmap.Insert(1);
+  bitmap.Insert(3);
+  bitmap.Insert(int64_t{1} << 40);
+  EXPECT_EQ(bitmap.size(), 3);
+  EXPECT_TRUE(bitmap.Contains(1));
+  EXPECT_TRUE(bitmap.Contains(3));
+  EXPECT_TRUE(bitmap.Contains(int64_t{1} << 40));
+  EXPECT_FALSE(bitmap.Contains(2));
+  EXPECT_FALSE(bitmap.Contains(3 + (1 << 16)));
+  EXPECT_THAT(bitmap.ToVector(), ElementsAre(1, 3, int64_t{1} << 40));
+}
+
+TEST(IdBitmap, FromIdsSortsAndDeduplicates) {
+  const IdBitmap bitmap = IdBitmap::FromIds({5, 70000, 2, 5, 70000, 1});
+  EXPECT_EQ(bitmap.size(), 4);
+  EXPECT_THAT(bitmap.ToVector(), ElementsAre(1, 2, 5, 70000));
+  EXPECT_THAT(IdBitmap::FromIds({}).ToVector(), IsEmpty());
+}
+
+TEST(IdBitmap, SetAlgebraOnSparseIds) {
+  IdBitmap a = IdBitmap::FromIds({1, 2, 3, 100000});
+  const IdBitmap b = IdBitmap::FromIds({2, 3, 4, 200000});
+
+  IdBitmap union_ab = a;
+  union_ab.UnionWith(b);
+  EXPECT_THAT(union_ab.ToVector(), ElementsAre(1, 2, 3, 4, 100000, 200000));
+
+  IdBitmap intersection_ab = a;
+  intersection_ab.IntersectWith(b);
+  EXPECT_THAT(intersection_ab.ToVector(), ElementsAre(2, 3));
+
+  a.Subtract(b);
+  EXPECT_THAT(a.ToVector(), ElementsAre(1, 100000));
+  a.Subtract(IdBitmap::FromIds({1, 100000}));
+  EXPECT_TRUE(a.empty());
+}
+
+TEST(IdBitmap, ConvertsBetweenArrayAndBitsetContainers) {
+  std::vector<int64_t> dense_ids;
+  for (int64_t id = 0; id < 3 * IdBitmap::kMaxArraySize; id += 2) {
+    dense_ids.push_back(id);
+  }
+  IdBitmap bitmap = IdBitmap::FromIds(dense_ids);
+  EXPECT_EQ(bitmap.size(), dense_ids.size());
+  EXPECT_THAT(bitmap.ToVector(), ElementsAreArray(dense_ids));
+
+  // Dropping below the array threshold keeps the contents intact.
+  std::vector<int64_t> removed_ids(dense_ids.begin() + 100, dense_ids.end());
+  bitmap.Subtract(IdBitmap::FromIds(removed_ids));
+  EXPECT_THAT(bitmap.ToVector(),
+              ElementsAreArray(dense_ids.begin(), dense_ids.begin() + 100));
+  EXPECT_EQ(bitmap, IdBitmap::FromIds(std::vector<int64_t>(
+                        dense_ids.begin(), dense_ids.begin() + 100)));
+}
+
+TEST(IdBitmap, MatchesStdSetOnRandomOperations) {
+  std::mt19937_64 rng(/*seed=*/42);
+  // Mixes dense and sparse ranges so that every pair of container kinds is
+  // exercised.
+  auto random_ids = [&rng](int count, int64_t range) {
+    std::uniform_int_distribution<int64_t> dist(0, range);
+    std::vector<int64_t> ids;
+    for (int i = 0; i < count; i++) {
+      ids.push_back(dist(rng));
+    }
+    return ids;
+  };
+  for (int round = 0; round < 20; round++) {
+    const std::vector<int64_t> lhs_ids =
+        random_ids(round % 2 == 0 ? 10000 : 50, 1 << 17);
+    const std::vector<int64_t> rhs_ids =
+        random_ids(round % 3 == 0 ? 10000 : 50, 1 << 17);
+    const std::set<int64_t> lhs(lhs_ids.begin(), lhs_ids.end());
+    const std::set<int64_t> rhs(rhs_ids.begin(), rhs_ids.end());
+
+    std::vector<int64_t> expected_union, expected_difference,
+        expected_intersection;
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                   std::back_inserter(expected_union));
+    std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                        std::back_inserter(expected_difference));
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                          std::back_inserter(expected_intersection));
+
+    const IdBitmap rhs_bitmap = IdBitmap::FromIds(rhs_ids);
+    IdBitmap union_bitmap = IdBitmap::FromIds(lhs_ids);
+    union_bitmap.UnionWith(rhs_bitmap);
+    EXPECT_THAT(union_bitmap.ToVector(), ElementsAreArray(expected_union));
+    EXPECT_EQ(union_bitmap.size(), expected_union.size());
+
+    IdBitmap difference_bitmap = IdBitmap::FromIds(lhs_ids);
+    difference_bitmap.Subtract(rhs_bitmap);
+    EXPECT_THAT(difference_bitmap.ToVector(),
+                ElementsAreArray(expected_difference));
+
+    IdBitmap intersection_bitmap = IdBitmap::FromIds(lhs_ids);
+    intersection_bitmap.IntersectWith(rhs_bitmap);
+    EXPECT_THAT(intersection_bitmap.ToVector(),
+                ElementsAreArray(expected_intersection));
+    for (int64_t id : rhs_ids) {
+      EXPECT_EQ(intersection_bitmap.Contains(id), lhs.count(id) > 0);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace ml_metadata
@@ -32,7 +32,7 @@ namespace {
 // a datastore as current approach for schema upgrade/downgrade.
 const std::string kBaseQueryConfig = absl::StrCat(  // NOLINT
 R"pb(
-  schema_version: 10
+  schema_version: 14
   drop_type_table { query: " DROP TABLE IF EXISTS `Type`; " }
   create_type_table {
     query: " CREATE TABLE IF NOT EXISTS `Type` ( "
@@ -233,10 +233,20 @@ R"pb(
            " WHERE A.id IN ($0); "
     parameter_num: 1
   }
+  select_artifact_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Artifact` "
+           " WHERE `id` IN ($0); "
+    parameter_num: 1
+  }
   select_artifact_by_type_id_and_name {
     query: " SELECT `id` from `Artifact` WHERE `type_id` = $0 and `name` = $1; "
     parameter_num: 2
   }
+  select_artifacts_by_type_id_and_names {
+    query: " SELECT `id` from `Artifact` "
+           " WHERE `type_id` = $0 and `name` IN ($1); "
+    parameter_num: 2
+  }
   select_artifacts_by_type_id {
     query: " SELECT `id` from `Artifact` WHERE `type_id` = $0; "
     parameter_num: 1
@@ -245,6 +255,10 @@ R"pb(
     query: " SELECT `id` from `Artifact` WHERE `uri` = $0; "
     parameter_num: 1
   }
+  select_artifacts_by_uris {
+    query: " SELECT `id` from `Artifact` WHERE `uri` IN ($0); "
+    parameter_num: 1
+  }
   select_artifacts_by_external_ids {
     query: " SELECT `id` from `Artifact` WHERE `external_id` IN ($0); "
     parameter_num: 1
@@ -252,17 +266,44 @@ R"pb(
   update_artifact {
     query: " UPDATE `Artifact` "
            " SET `type_id` = $1, `uri` = $2, `state` = $3, `external_id` = $4, "
-           "     `last_update_time_since_epoch` = $5 "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $5 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $5 END "
            " WHERE id = $0;"
     parameter_num: 6
   }
+  update_artifact_last_update_time {
+    query: " UPDATE `Artifact` SET `last_update_time_since_epoch` = "
+           "     CASE WHEN `last_update_time_since_epoch` >= $1 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "     THEN `last_update_time_since_epoch` + 1 ELSE $1 END "
+           " WHERE `id` IN ($0);"
+    parameter_num: 2
+  }
+  update_artifact_with_precondition {
+    query: " UPDATE `Artifact` "
+           " SET `type_id` = $1, "
+           "     `uri` = CASE WHEN ($9 & 1) <> 0 THEN $2 ELSE `uri` END, "
+           "     `state` = CASE WHEN ($9 & 2) <> 0 THEN $3 ELSE `state` END, "
+           "     `external_id` = "
+           "      CASE WHEN ($9 & 4) <> 0 THEN $4 ELSE `external_id` END, "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $5 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $5 END "
+           " WHERE id = $0 "
+           "   AND ($6 IS NULL OR `last_update_time_since_epoch` = $6) "
+           "   AND ($7 = 0 OR COALESCE(`state`, 0) IN ($8));"
+    parameter_num: 10
+  }
   drop_artifact_property_table {
     query: " DROP TABLE IF EXISTS `ArtifactProperty`; "
   }
   create_artifact_property_table {
     query: " CREATE TABLE IF NOT EXISTS `ArtifactProperty` ( "
            "   `artifact_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
+           "   `name_id` INT NOT NULL, "
            "   `is_custom_property` TINYINT(1) NOT NULL, "
            "   `int_value` INT, "
            "   `double_value` DOUBLE, "
@@ -270,39 +311,53 @@ R"pb(
            "   `byte_value` BLOB, "
            "   `proto_value` BLOB, "
            "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`artifact_id`, `name`, `is_custom_property`)); "
+           " PRIMARY KEY (`artifact_id`, `name_id`, `is_custom_property`)); "
   }
   check_artifact_property_table {
-    query: " SELECT `artifact_id`, `name`, `is_custom_property`, "
+    query: " SELECT `artifact_id`, `name_id`, `is_custom_property`, "
            "        `int_value`, `double_value`, `string_value`, `byte_value`, "
            "        `proto_value`, `bool_value` "
            " FROM `ArtifactProperty` LIMIT 1; "
   }
   insert_artifact_property {
     query: " INSERT INTO `ArtifactProperty`( "
-           "   `artifact_id`, `name`, `is_custom_property`, `$0` "
+           "   `artifact_id`, `name_id`, `is_custom_property`, `$0` "
            ") VALUES($1, $2, $3, $4);"
     parameter_num: 5
   }
   select_artifact_property_by_artifact_id {
-    query: " SELECT `artifact_id` as `id`, `name` as `key`, "
-           "        `is_custom_property`, "
-           "        `int_value`, `double_value`, `string_value`, `proto_value`,"
-           "        `bool_value` "
-           " from `ArtifactProperty` "
-           " WHERE `artifact_id` IN ($0); "
+    query: " SELECT AP.`artifact_id` as `id`, PN.`name` as `key`, "
+           "        AP.`is_custom_property`, "
+           "        AP.`int_value`, AP.`double_value`, AP.`string_value`, "
+           "        AP.`proto_value`, AP.`bool_value` "
+           " from `ArtifactProperty` AS AP "
+           " JOIN `PropertyName` AS PN ON (PN.`id` = AP.`name_id`) "
+           " WHERE AP.`artifact_id` IN ($0); "
     parameter_num: 1
   }
   update_artifact_property {
     query: " UPDATE `ArtifactProperty` "
            " SET `$0` = $1 "
-           " WHERE `artifact_id` = $2 and `name` = $3;"
+           " WHERE `artifact_id` = $2 and `name_id` = $3;"
     parameter_num: 4
   }
   delete_artifact_property {
     query: " DELETE FROM `ArtifactProperty` "
-           " WHERE `artifact_id` = $0 and `name` = $1;"
-    parameter_num: 2
+           " WHERE `artifact_id` = $0 and `name_id` = $1 "
+           "   and `is_custom_property` = $2;"
+    parameter_num: 3
+  }
+  insert_artifacts_property {
+    query: " INSERT INTO `ArtifactProperty`( "
+           "   `artifact_id`, `name_id`, `is_custom_property`, `$0` "
+           ") SELECT `id`, $1, $2, $3 FROM `Artifact` WHERE `id` IN ($4);"
+    parameter_num: 5
+  }
+  delete_artifacts_properties {
+    query: " DELETE FROM `ArtifactProperty` "
+           " WHERE `artifact_id` IN ($0) AND `name_id` IN ($1) "
+           "   AND `is_custom_property` = $2;"
+    parameter_num: 3
   }
   delete_artifacts_by_id {
     query: "DELETE FROM `Artifact` WHERE `id` IN ($0); "
@@ -352,10 +407,20 @@ R"pb(
           " WHERE E.id IN ($0); "
     parameter_num: 1
   }
+  select_execution_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Execution` "
+           " WHERE `id` IN ($0); "
+    parameter_num: 1
+  }
   select_execution_by_type_id_and_name {
     query: " SELECT `id` from `Execution` WHERE `type_id` = $0 and `name` = $1;"
     parameter_num: 2
   }
+  select_executions_by_type_id_and_names {
+    query: " SELECT `id` from `Execution` "
+           " WHERE `type_id` = $0 and `name` IN ($1); "
+    parameter_num: 2
+  }
   select_executions_by_type_id {
     query: " SELECT `id` from `Execution` WHERE `type_id` = $0; "
     parameter_num: 1
@@ -368,17 +433,62 @@ R"pb(
     query: " UPDATE `Execution` "
            " SET `type_id` = $1, `last_known_state` = $2, "
            "     `external_id` = $3, "
-           "     `last_update_time_since_epoch` = $4 "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $4 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $4 END "
            " WHERE id = $0;"
     parameter_num: 5
   }
+  update_execution_last_update_time {
+    query: " UPDATE `Execution` SET `last_update_time_since_epoch` = "
+           "     CASE WHEN `last_update_time_since_epoch` >= $1 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "     THEN `last_update_time_since_epoch` + 1 ELSE $1 END "
+           " WHERE `id` IN ($0);"
+    parameter_num: 2
+  }
+  update_execution_with_precondition {
+    query: " UPDATE `Execution` "
+           " SET `type_id` = $1, "
+           "     `last_known_state` = "
+           "      CASE WHEN ($8 & 2) <> 0 THEN $2 ELSE `last_known_state` END, "
+           "     `external_id` = "
+           "      CASE WHEN ($8 & 4) <> 0 THEN $3 ELSE `external_id` END, "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $4 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $4 END "
+           " WHERE id = $0 "
+           "   AND ($5 IS NULL OR `last_update_time_since_epoch` = $5) "
+           "   AND ($6 = 0 OR COALESCE(`last_known_state`, 0) IN ($7));"
+    parameter_num: 9
+  }
+  select_execution_ids_for_claim {
+    query: " SELECT `id` FROM `Execution` "
+           " WHERE `type_id` = $0 "
+           "   AND (`last_known_state` = $1 "
+           "        OR ($1 = 0 AND `last_known_state` IS NULL)) "
+           " ORDER BY `id` LIMIT $2; "
+    parameter_num: 3
+  }
+  update_executions_state {
+    query: " UPDATE `Execution` "
+           " SET `last_known_state` = $1, "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $2 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $2 END "
+           " WHERE `id` IN ($0);"
+    parameter_num: 3
+  }
   drop_execution_property_table {
     query: " DROP TABLE IF EXISTS `ExecutionProperty`; "
   }
   create_execution_property_table {
     query: " CREATE TABLE IF NOT EXISTS `ExecutionProperty` ( "
            "   `execution_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
+           "   `name_id` INT NOT NULL, "
            "   `is_custom_property` TINYINT(1) NOT NULL, "
            "   `int_value` INT, "
            "   `double_value` DOUBLE, "
@@ -386,39 +496,53 @@ R"pb(
            "   `byte_value` BLOB, "
            "   `proto_value` BLOB, "
            "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`execution_id`, `name`, `is_custom_property`)); "
+           " PRIMARY KEY (`execution_id`, `name_id`, `is_custom_property`)); "
   }
   check_execution_property_table {
-    query: " SELECT `execution_id`, `name`, `is_custom_property`, "
+    query: " SELECT `execution_id`, `name_id`, `is_custom_property`, "
            "        `int_value`, `double_value`, `string_value`, `byte_value`, "
            "        `proto_value`, `bool_value` "
            " FROM `ExecutionProperty` LIMIT 1; "
   }
   insert_execution_property {
     query: " INSERT INTO `ExecutionProperty`( "
-           "   `execution_id`, `name`, `is_custom_property`, `$0` "
+           "   `execution_id`, `name_id`, `is_custom_property`, `$0` "
            ") VALUES($1, $2, $3, $4);"
     parameter_num: 5
   }
   select_execution_property_by_execution_id {
-    query: " SELECT `execution_id` as `id`, `name` as `key`, "
-           "        `is_custom_property`, "
-           "        `int_value`, `double_value`, `string_value`, `proto_value`,"
-           "        `bool_value` "
-           " from `ExecutionProperty` "
-           " WHERE `execution_id` IN ($0); "
+    query: " SELECT EP.`execution_id` as `id`, PN.`name` as `key`, "
+           "        EP.`is_custom_property`, "
+           "        EP.`int_value`, EP.`double_value`, EP.`string_value`, "
+           "        EP.`proto_value`, EP.`bool_value` "
+           " from `ExecutionProperty` AS EP "
+           " JOIN `PropertyName` AS PN ON (PN.`id` = EP.`name_id`) "
+           " WHERE EP.`execution_id` IN ($0); "
     parameter_num: 1
   }
   update_execution_property {
     query: " UPDATE `ExecutionProperty` "
            " SET `$0` = $1 "
-           " WHERE `execution_id` = $2 and `name` = $3;"
+           " WHERE `execution_id` = $2 and `name_id` = $3;"
     parameter_num: 4
   }
   delete_execution_property {
     query: " DELETE FROM `ExecutionProperty` "
-           " WHERE `execution_id` = $0 and `name` = $1;"
-    parameter_num: 2
+           " WHERE `execution_id` = $0 and `name_id` = $1 "
+           "   and `is_custom_property` = $2;"
+    parameter_num: 3
+  }
+  insert_executions_property {
+    query: " INSERT INTO `ExecutionProperty`( "
+           "   `execution_id`, `name_id`, `is_custom_property`, `$0` "
+           ") SELECT `id`, $1, $2, $3 FROM `Execution` WHERE `id` IN ($4);"
+    parameter_num: 5
+  }
+  delete_executions_properties {
+    query: " DELETE FROM `ExecutionProperty` "
+           " WHERE `execution_id` IN ($0) AND `name_id` IN ($1) "
+           "   AND `is_custom_property` = $2;"
+    parameter_num: 3
   }
   delete_executions_by_id {
     query: "DELETE FROM `Execution` WHERE `id` IN ($0); "
@@ -465,6 +589,11 @@ R"pb(
            " WHERE C.id IN ($0); "
     parameter_num: 1
   }
+  select_context_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Context` "
+           " WHERE `id` IN ($0); "
+    parameter_num: 1
+  }
   select_contexts_by_type_id {
     query: " SELECT `id` from `Context` WHERE `type_id` = $0; "
     parameter_num: 1
@@ -473,6 +602,11 @@ R"pb(
     query: " SELECT `id` from `Context` WHERE `type_id` = $0 and `name` = $1; "
     parameter_num: 2
   }
+  select_contexts_by_type_id_and_names {
+    query: " SELECT `id` from `Context` "
+           " WHERE `type_id` = $0 and `name` IN ($1); "
+    parameter_num: 2
+  }
   select_contexts_by_external_ids {
     query: " SELECT `id` from `Context` WHERE `external_id` IN ($0); "
     parameter_num: 1
@@ -480,17 +614,28 @@ R"pb(
   update_context {
     query: " UPDATE `Context` "
            " SET `type_id` = $1, `name` = $2, `external_id` = $3, "
-           "     `last_update_time_since_epoch` = $4 "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $4 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $4 END "
            " WHERE id = $0;"
     parameter_num: 5
   }
+  update_context_last_update_time {
+    query: " UPDATE `Context` SET `last_update_time_since_epoch` = "
+           "     CASE WHEN `last_update_time_since_epoch` >= $1 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "     THEN `last_update_time_since_epoch` + 1 ELSE $1 END "
+           " WHERE `id` IN ($0);"
+    parameter_num: 2
+  }
   drop_context_property_table {
     query: " DROP TABLE IF EXISTS `ContextProperty`; "
   }
   create_context_property_table {
     query: " CREATE TABLE IF NOT EXISTS `ContextProperty` ( "
            "   `context_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
+           "   `name_id` INT NOT NULL, "
            "   `is_custom_property` TINYINT(1) NOT NULL, "
            "   `int_value` INT, "
            "   `double_value` DOUBLE, "
@@ -498,39 +643,53 @@ R"pb(
            "   `byte_value` BLOB, "
            "   `proto_value` BLOB, "
            "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`context_id`, `name`, `is_custom_property`)); "
+           " PRIMARY KEY (`context_id`, `name_id`, `is_custom_property`)); "
   }
   check_context_property_table {
-    query: " SELECT `context_id`, `name`, `is_custom_property`, "
+    query: " SELECT `context_id`, `name_id`, `is_custom_property`, "
            "        `int_value`, `double_value`, `string_value`, `byte_value`, "
            "        `proto_value`, `bool_value` "
            " FROM `ContextProperty` LIMIT 1; "
   }
   insert_context_property {
     query: " INSERT INTO `ContextProperty`( "
-           "   `context_id`, `name`, `is_custom_property`, `$0` "
+           "   `context_id`, `name_id`, `is_custom_property`, `$0` "
            ") VALUES($1, $2, $3, $4);"
     parameter_num: 5
   }
   select_context_property_by_context_id {
-    query: " SELECT `context_id` as `id`, `name` as `key`, "
-           "        `is_custom_property`, "
-           "        `int_value`, `double_value`, `string_value`, `proto_value`,"
-           "        `bool_value` "
-           " from `ContextProperty` "
-           " WHERE `context_id` IN ($0); "
+    query: " SELECT CP.`context_id` as `id`, PN.`name` as `key`, "
+           "        CP.`is_custom_property`, "
+           "        CP.`int_value`, CP.`double_value`, CP.`string_value`, "
+           "        CP.`proto_value`, CP.`bool_value` "
+           " from `ContextProperty` AS CP "
+           " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`) "
+           " WHERE CP.`context_id` IN ($0); "
     parameter_num: 1
   }
   update_context_property {
     query: " UPDATE `ContextProperty` "
            " SET `$0` = $1 "
-           " WHERE `context_id` = $2 and `name` = $3;"
+           " WHERE `context_id` = $2 and `name_id` = $3;"
     parameter_num: 4
   }
   delete_context_property {
     query: " DELETE FROM `ContextProperty` "
-           " WHERE `context_id` = $0 and `name` = $1;"
-    parameter_num: 2
+           " WHERE `context_id` = $0 and `name_id` = $1 "
+           "   and `is_custom_property` = $2;"
+    parameter_num: 3
+  }
+  insert_contexts_property {
+    query: " INSERT INTO `ContextProperty`( "
+           "   `context_id`, `name_id`, `is_custom_property`, `$0` "
+           ") SELECT `id`, $1, $2, $3 FROM `Context` WHERE `id` IN ($4);"
+    parameter_num: 5
+  }
+  delete_contexts_properties {
+    query: " DELETE FROM `ContextProperty` "
+           " WHERE `context_id` IN ($0) AND `name_id` IN ($1) "
+           "   AND `is_custom_property` = $2;"
+    parameter_num: 3
   }
   drop_parent_context_table {
     query: " DROP TABLE IF EXISTS `ParentContext`;"
@@ -621,6 +780,65 @@ R"pb(
            " WHERE `execution_id` IN ($0); "
     parameter_num: 1
   }
+  select_lineage_event_by_artifact_ids {
+    query: " SELECT E.`id`, E.`artifact_id`, E.`execution_id`, "
+           "        E.`type`, E.`milliseconds_since_epoch` "
+           " FROM `Event` AS E "
+           " JOIN ( "
+           "   SELECT DISTINCT N.`id`, N.`create_time_since_epoch` "
+           "   FROM `Event` AS NE "
+           "   JOIN `Execution` AS N ON NE.`execution_id` = N.`id` "
+           "   WHERE NE.`artifact_id` IN ($0) "
+           "     AND NE.`milliseconds_since_epoch` >= $1 "
+           "     AND NE.`milliseconds_since_epoch` < $2 "
+           "     AND N.`create_time_since_epoch` >= $3 "
+           "     AND N.`create_time_since_epoch` < $4 "
+           "     AND ($5 = 0 OR N.`last_known_state` IN ($6)) "
+           "   ORDER BY N.`create_time_since_epoch` DESC, N.`id` "
+           "   LIMIT $7 OFFSET $8 "
+           " ) AS P ON E.`execution_id` = P.`id` "
+           " WHERE E.`artifact_id` IN ($0) "
+           "   AND E.`milliseconds_since_epoch` >= $1 "
+           "   AND E.`milliseconds_since_epoch` < $2 "
+           " ORDER BY P.`create_time_since_epoch` DESC, P.`id`, E.`id`; "
+    parameter_num: 9
+  }
+  select_lineage_event_by_execution_ids {
+    query: " SELECT E.`id`, E.`artifact_id`, E.`execution_id`, "
+           "        E.`type`, E.`milliseconds_since_epoch` "
+           " FROM `Event` AS E "
+           " JOIN ( "
+           "   SELECT DISTINCT N.`id`, N.`create_time_since_epoch` "
+           "   FROM `Event` AS NE "
+           "   JOIN `Artifact` AS N ON NE.`artifact_id` = N.`id` "
+           "   WHERE NE.`execution_id` IN ($0) "
+           "     AND NE.`milliseconds_since_epoch` >= $1 "
+           "     AND NE.`milliseconds_since_epoch` < $2 "
+           "     AND N.`create_time_since_epoch` >= $3 "
+           "     AND N.`create_time_since_epoch` < $4 "
+           "   ORDER BY N.`create_time_since_epoch` DESC, N.`id` "
+           "   LIMIT $5 OFFSET $6 "
+           " ) AS P ON E.`artifact_id` = P.`id` "
+           " WHERE E.`execution_id` IN ($0) "
+           "   AND E.`milliseconds_since_epoch` >= $1 "
+           "   AND E.`milliseconds_since_epoch` < $2 "
+           " ORDER BY P.`create_time_since_epoch` DESC, P.`id`, E.`id`; "
+    parameter_num: 7
+  }
+  select_artifact_ids_by_recency {
+    query: " SELECT `id` FROM `Artifact` "
+           " WHERE `id` IN ($0) "
+           " ORDER BY `create_time_since_epoch` DESC, `id` "
+           " LIMIT $1; "
+    parameter_num: 2
+  }
+  select_execution_ids_by_recency {
+    query: " SELECT `id` FROM `Execution` "
+           " WHERE `id` IN ($0) "
+           " ORDER BY `create_time_since_epoch` DESC, `id` "
+           " LIMIT $1; "
+    parameter_num: 2
+  }
   drop_event_path_table { query: " DROP TABLE IF EXISTS `EventPath`; " }
   create_event_path_table {
     query: " CREATE TABLE IF NOT EXISTS `EventPath` ( "
@@ -722,6 +940,179 @@ R"pb(
            " WHERE `artifact_id` IN ($0); "
     parameter_num: 1
   }
+  create_type_catalog_table {
+    query: " CREATE TABLE IF NOT EXISTS `TypeCatalog` ( "
+           "   `type_id` INTEGER PRIMARY KEY, "
+           "   `catalog_version` BIGINT NOT NULL "
+           " ); "
+  }
+  insert_type_catalog {
+    query: " INSERT IGNORE INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+           " VALUES(0, 0); "
+  }
+  increase_type_catalog_version {
+    query: " UPDATE `TypeCatalog` SET `catalog_version` = `catalog_version` + 1 "
+           " WHERE `type_id` = 0; "
+  }
+  select_type_catalog_version {
+    query: " SELECT `catalog_version` FROM `TypeCatalog` WHERE `type_id` = 0; "
+  }
+  upsert_type_catalog_version {
+    query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+           " VALUES($0, $1) "
+           " ON DUPLICATE KEY UPDATE `catalog_version` = $1; "
+    parameter_num: 2
+  }
+  select_types_changed_after_catalog_version {
+    query: " SELECT TC.`type_id`, T.`type_kind` "
+           " FROM `TypeCatalog` AS TC "
+           " JOIN `Type` AS T ON (T.`id` = TC.`type_id`) "
+           " WHERE TC.`catalog_version` > $0; "
+    parameter_num: 1
+  }
+  drop_property_name_table {
+    query: " DROP TABLE IF EXISTS `PropertyName`; "
+  }
+  create_property_name_table {
+    query: " CREATE TABLE IF NOT EXISTS `PropertyName` ( "
+           "   `id` INTEGER PRIMARY KEY AUTOINCREMENT, "
+           "   `name` VARCHAR(255) NOT NULL UNIQUE "
+           " ); "
+  }
+  check_property_name_table {
+    query: " SELECT `id`, `name` FROM `PropertyName` LIMIT 1; "
+  }
+  insert_property_name {
+    query: " INSERT IGNORE INTO `PropertyName`(`name`) VALUES($0); "
+    parameter_num: 1
+  }
+  select_property_name_id {
+    query: " SELECT `id` FROM `PropertyName` WHERE `name` = $0; "
+    parameter_num: 1
+  }
+  create_write_epoch_table {
+    query: " CREATE TABLE IF NOT EXISTS `WriteEpoch` ( "
+           "   `type_kind` INTEGER PRIMARY KEY, "
+           "   `epoch` BIGINT NOT NULL "
+           " ); "
+  }
+  insert_write_epochs {
+    query: " INSERT IGNORE INTO `WriteEpoch`(`type_kind`, `epoch`) "
+           " VALUES(0, 0), (1, 0), (2, 0); "
+  }
+  increase_write_epochs {
+    query: " UPDATE `WriteEpoch` SET `epoch` = `epoch` + 1 "
+           " WHERE `type_kind` IN ($0); "
+    parameter_num: 1
+  }
+  select_write_epochs {
+    query: " SELECT `type_kind`, `epoch` FROM `WriteEpoch`; "
+  }
+  create_context_summary_table {
+    query: " CREATE TABLE IF NOT EXISTS `ContextSummary` ( "
+           "   `context_id` INT NOT NULL, "
+           "   `type_kind` INT NOT NULL, "
+           "   `type_id` INT NOT NULL, "
+           "   `state` INT NOT NULL, "
+           "   `num_nodes` BIGINT NOT NULL, "
+           "   PRIMARY KEY (`context_id`, `type_kind`, `type_id`, `state`) "
+           " ); "
+  }
+  update_context_summaries_by_executions {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT A.`context_id`, 0, E.`type_id`, "
+           "        COALESCE(E.`last_known_state`, 0), $0 * COUNT(*) "
+           " FROM `Association` AS A "
+           "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+           " WHERE E.`id` IN ($1) "
+           " GROUP BY A.`context_id`, E.`type_id`, "
+           "          COALESCE(E.`last_known_state`, 0) "
+           " ON DUPLICATE KEY UPDATE "
+           "   `num_nodes` = `num_nodes` + VALUES(`num_nodes`); "
+    parameter_num: 2
+  }
+  update_context_summaries_by_artifacts {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT T.`context_id`, 1, R.`type_id`, "
+           "        COALESCE(R.`state`, 0), $0 * COUNT(*) "
+           " FROM `Attribution` AS T "
+           "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+           " WHERE R.`id` IN ($1) "
+           " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0) "
+           " ON DUPLICATE KEY UPDATE "
+           "   `num_nodes` = `num_nodes` + VALUES(`num_nodes`); "
+    parameter_num: 2
+  }
+  increase_context_summary_by_association {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT $0, 0, `type_id`, COALESCE(`last_known_state`, 0), 1 "
+           " FROM `Execution` WHERE `id` = $1 "
+           " ON DUPLICATE KEY UPDATE "
+           "   `num_nodes` = `num_nodes` + VALUES(`num_nodes`); "
+    parameter_num: 2
+  }
+  increase_context_summary_by_attribution {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT $0, 1, `type_id`, COALESCE(`state`, 0), 1 "
+           " FROM `Artifact` WHERE `id` = $1 "
+           " ON DUPLICATE KEY UPDATE "
+           "   `num_nodes` = `num_nodes` + VALUES(`num_nodes`); "
+    parameter_num: 2
+  }
+  delete_context_summaries {
+    query: " DELETE FROM `ContextSummary` WHERE `context_id` IN ($0); "
+    parameter_num: 1
+  }
+  insert_context_summaries {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT A.`context_id`, 0, E.`type_id`, "
+           "        COALESCE(E.`last_known_state`, 0), COUNT(*) "
+           " FROM `Association` AS A "
+           "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+           " WHERE A.`context_id` IN ($0) "
+           " GROUP BY A.`context_id`, E.`type_id`, "
+           "          COALESCE(E.`last_known_state`, 0) "
+           " UNION ALL "
+           " SELECT T.`context_id`, 1, R.`type_id`, "
+           "        COALESCE(R.`state`, 0), COUNT(*) "
+           " FROM `Attribution` AS T "
+           "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+           " WHERE T.`context_id` IN ($0) "
+           " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0); "
+    parameter_num: 1
+  }
+  delete_all_context_summaries {
+    query: " DELETE FROM `ContextSummary`; "
+  }
+  insert_all_context_summaries {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT A.`context_id`, 0, E.`type_id`, "
+           "        COALESCE(E.`last_known_state`, 0), COUNT(*) "
+           " FROM `Association` AS A "
+           "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+           " GROUP BY A.`context_id`, E.`type_id`, "
+           "          COALESCE(E.`last_known_state`, 0) "
+           " UNION ALL "
+           " SELECT T.`context_id`, 1, R.`type_id`, "
+           "        COALESCE(R.`state`, 0), COUNT(*) "
+           " FROM `Attribution` AS T "
+           "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+           " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0); "
+  }
+  select_context_summaries {
+    query: " SELECT `context_id`, `type_kind`, `type_id`, `state`, "
+           "        `num_nodes` "
+           " FROM `ContextSummary` "
+           " WHERE `context_id` IN ($0) AND `num_nodes` > 0 "
+           " ORDER BY `context_id`, `type_kind`, `type_id`, `state`; "
+    parameter_num: 1
+  }
   drop_mlmd_env_table { query: " DROP TABLE IF EXISTS `MLMDEnv`; " }
   create_mlmd_env_table {
     query: " CREATE TABLE IF NOT EXISTS `MLMDEnv` ( "
@@ -785,6 +1176,108 @@ R"pb(
            "   ) = 1"
            " ) AS table_exists;"
   }
+  # SQLite does not report the number of updated rows, so the conditional
+  # updates return the ids of the updated rows instead.
+  update_artifact_with_precondition {
+    query: " UPDATE `Artifact` "
+           " SET `type_id` = $1, "
+           "     `uri` = CASE WHEN ($9 & 1) <> 0 THEN $2 ELSE `uri` END, "
+           "     `state` = CASE WHEN ($9 & 2) <> 0 THEN $3 ELSE `state` END, "
+           "     `external_id` = "
+           "      CASE WHEN ($9 & 4) <> 0 THEN $4 ELSE `external_id` END, "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $5 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $5 END "
+           " WHERE id = $0 "
+           "   AND ($6 IS NULL OR `last_update_time_since_epoch` = $6) "
+           "   AND ($7 = 0 OR COALESCE(`state`, 0) IN ($8)) "
+           " RETURNING `id`;"
+    parameter_num: 10
+  }
+  update_execution_with_precondition {
+    query: " UPDATE `Execution` "
+           " SET `type_id` = $1, "
+           "     `last_known_state` = "
+           "      CASE WHEN ($8 & 2) <> 0 THEN $2 ELSE `last_known_state` END, "
+           "     `external_id` = "
+           "      CASE WHEN ($8 & 4) <> 0 THEN $3 ELSE `external_id` END, "
+           "     `last_update_time_since_epoch` = "
+           "         CASE WHEN `last_update_time_since_epoch` >= $4 "
+           "          AND `last_update_time_since_epoch` < 9223372036854775807 "
+           "         THEN `last_update_time_since_epoch` + 1 ELSE $4 END "
+           " WHERE id = $0 "
+           "   AND ($5 IS NULL OR `last_update_time_since_epoch` = $5) "
+           "   AND ($6 = 0 OR COALESCE(`last_known_state`, 0) IN ($7)) "
+           " RETURNING `id`;"
+    parameter_num: 9
+  }
+  lock_execution_table_for_claim {
+    query: " UPDATE `Execution` SET `id` = `id` WHERE 0 = 1; "
+  }
+  insert_type_catalog {
+    query: " INSERT OR IGNORE INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+           " VALUES(0, 0); "
+  }
+  upsert_type_catalog_version {
+    query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+           " VALUES($0, $1) "
+           " ON CONFLICT(`type_id`) DO UPDATE SET `catalog_version` = $1; "
+    parameter_num: 2
+  }
+  insert_property_name {
+    query: " INSERT OR IGNORE INTO `PropertyName`(`name`) VALUES($0); "
+    parameter_num: 1
+  }
+  insert_write_epochs {
+    query: " INSERT OR IGNORE INTO `WriteEpoch`(`type_kind`, `epoch`) "
+           " VALUES(0, 0), (1, 0), (2, 0); "
+  }
+  update_context_summaries_by_executions {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT A.`context_id`, 0, E.`type_id`, "
+           "        COALESCE(E.`last_known_state`, 0), $0 * COUNT(*) "
+           " FROM `Association` AS A "
+           "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+           " WHERE E.`id` IN ($1) "
+           " GROUP BY A.`context_id`, E.`type_id`, "
+           "          COALESCE(E.`last_known_state`, 0) "
+           " ON CONFLICT(`context_id`, `type_kind`, `type_id`, `state`) "
+           " DO UPDATE SET `num_nodes` = `num_nodes` + excluded.`num_nodes`; "
+    parameter_num: 2
+  }
+  update_context_summaries_by_artifacts {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT T.`context_id`, 1, R.`type_id`, "
+           "        COALESCE(R.`state`, 0), $0 * COUNT(*) "
+           " FROM `Attribution` AS T "
+           "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+           " WHERE R.`id` IN ($1) "
+           " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0) "
+           " ON CONFLICT(`context_id`, `type_kind`, `type_id`, `state`) "
+           " DO UPDATE SET `num_nodes` = `num_nodes` + excluded.`num_nodes`; "
+    parameter_num: 2
+  }
+  increase_context_summary_by_association {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT $0, 0, `type_id`, COALESCE(`last_known_state`, 0), 1 "
+           " FROM `Execution` WHERE `id` = $1 "
+           " ON CONFLICT(`context_id`, `type_kind`, `type_id`, `state`) "
+           " DO UPDATE SET `num_nodes` = `num_nodes` + excluded.`num_nodes`; "
+    parameter_num: 2
+  }
+  increase_context_summary_by_attribution {
+    query: " INSERT INTO `ContextSummary`( "
+           "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+           " SELECT $0, 1, `type_id`, COALESCE(`state`, 0), 1 "
+           " FROM `Artifact` WHERE `id` = $1 "
+           " ON CONFLICT(`context_id`, `type_kind`, `type_id`, `state`) "
+           " DO UPDATE SET `num_nodes` = `num_nodes` + excluded.`num_nodes`; "
+    parameter_num: 2
+  }
   # secondary indices in the current schema.
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_artifact_uri` "
@@ -838,47 +1331,56 @@ R"pb(
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_int` "
-           " ON `ArtifactProperty`(`name`, `is_custom_property`, `int_value`) "
+           " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+           "   `int_value`) "
            " WHERE `int_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_double` "
-           " ON `ArtifactProperty`(`name`, `is_custom_property`, `double_value`) "
+           " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+           "   `double_value`) "
            " WHERE `double_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_string` "
-           " ON `ArtifactProperty`(`name`, `is_custom_property`, `string_value`) "
+           " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+           "   `string_value`) "
            " WHERE `string_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_int` "
-           " ON `ExecutionProperty`(`name`, `is_custom_property`, `int_value`) "
+           " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+           "   `int_value`) "
            " WHERE `int_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_double` "
-           " ON `ExecutionProperty`(`name`, `is_custom_property`, `double_value`) "
+           " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+           "   `double_value`) "
            " WHERE `double_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_string` "
-           " ON `ExecutionProperty`(`name`, `is_custom_property`, `string_value`) "
+           " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+           "   `string_value`) "
            " WHERE `string_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_context_property_int` "
-           " ON `ContextProperty`(`name`, `is_custom_property`, `int_value`) "
+           " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+           "   `int_value`) "
            " WHERE `int_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_context_property_double` "
-           " ON `ContextProperty`(`name`, `is_custom_property`, `double_value`) "
+           " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+           "   `double_value`) "
            " WHERE `double_value` IS NOT NULL; "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS `idx_context_property_string` "
-           " ON `ContextProperty`(`name`, `is_custom_property`, `string_value`) "
+           " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+           "   `string_value`) "
            " WHERE `string_value` IS NOT NULL; "
   }
   secondary_indices {
@@ -979,7 +1481,8 @@ R"pb(
                  "   `int_value` INT, "
                  "   `double_value` DOUBLE, "
                  "   `string_value` TEXT, "
-                 " PRIMARY KEY (`execution_id`, `name`, `is_custom_property`)); "
+                 " PRIMARY KEY (`execution_id`, `name`, "
+                 "   `is_custom_property`)); "
         }
         previous_version_setup_queries {
           query: " CREATE TABLE IF NOT EXISTS `Event` ( "
@@ -2866,150 +3369,739 @@ R"pb(
         query: " ALTER TABLE `ContextProperty` "
                " ADD COLUMN `bool_value` BOOLEAN; "
       }
+      downgrade_queries {
+        query: " DROP TABLE IF EXISTS `TypeCatalog`; "
+      }
       db_verification { total_num_indexes: 40 total_num_tables: 15 }
     }
   }
-)pb");
-
-// Template queries for MySQLMetadataSources.
-// no-lint to support vc (C2026) 16380 max length for char[].
-const std::string kMySQLMetadataSourceQueryConfig = absl::StrCat(  // NOLINT
-R"pb(
-  metadata_source_type: MYSQL_METADATA_SOURCE
-  select_last_insert_id { query: " SELECT last_insert_id(); " }
-  select_type_by_name {
-    query: " SELECT `id`, `name`, `version`, `description`, "
-           "        `input_type`, `output_type` FROM `Type` "
-           " WHERE name = $0 AND version IS NULL AND type_kind = $1 "
-           " LOCK IN SHARE MODE; "
-    parameter_num: 2
-  }
-  select_type_by_name_and_version {
-    query: " SELECT `id`, `name`, `version`, `description`, "
-           "        `input_type`, `output_type` FROM `Type` "
-           " WHERE name = $0 AND version = $1 AND type_kind = $2 "
-           " LOCK IN SHARE MODE; "
-    parameter_num: 3
-  }
-  select_types_by_names {
-    query: " SELECT `id`, `name`, `version`, `description`, "
-           "        `input_type`, `output_type` FROM `Type` "
-           " WHERE name IN ($0) AND version IS NULL AND type_kind = $1 "
-           " LOCK IN SHARE MODE; "
-    parameter_num: 2
-    }
-    select_types_by_names_and_versions {
-    query: " SELECT `id`, `name`, `version`, `description`, "
-           "        `input_type`, `output_type` FROM `Type` "
-           " WHERE (name, version) IN ($0) AND type_kind = $1 "
-           " LOCK IN SHARE MODE; "
-    parameter_num: 2
-    }
-  select_context_by_id {
-    query: " SELECT C.id, C.type_id, C.name, C.external_id, "
-           "        C.create_time_since_epoch, C.last_update_time_since_epoch, "
-           "        T.name AS `type`, T.version AS type_version, "
-           "        T.description AS type_description, "
-           "        T.external_id AS type_external_id "
-           " FROM `Context` AS C "
-           " LEFT JOIN `Type` AS T ON (T.id = C.type_id) "
-           " WHERE C.id IN ($0) LOCK IN SHARE MODE; "
-    parameter_num: 1
-  }
-  select_execution_by_id {
-    query: " SELECT E.id, E.type_id, E.last_known_state, E.name, "
-           "        E.external_id, E.create_time_since_epoch, "
-           "        E.last_update_time_since_epoch, "
-           "        T.name AS `type`, T.version AS type_version, "
-           "        T.description AS type_description, "
-           "        T.external_id AS type_external_id "
-           " FROM `Execution` AS E "
-           " LEFT JOIN `Type` AS T "
-           "   ON (T.id = E.type_id) "
-           " WHERE E.id IN ($0) LOCK IN SHARE MODE; "
-    parameter_num: 1
-  }
-  select_artifact_by_id {
-    query: " SELECT A.id, A.type_id, A.uri, A.state, A.name, "
-           "        A.external_id, A.create_time_since_epoch, "
-           "        A.last_update_time_since_epoch, "
-           "        T.name AS `type`, T.version AS type_version, "
-           "        T.description AS type_description, "
-           "        T.external_id AS type_external_id "
-           " FROM `Artifact` AS A "
-           " LEFT JOIN `Type` AS T "
-           "   ON (T.id = A.type_id) "
-           " WHERE A.id IN ($0) LOCK IN SHARE MODE; "
-    parameter_num: 1
-  }
-  select_parent_type_by_type_id {
-    query: " SELECT `type_id`, `parent_type_id` "
-           " FROM `ParentType` WHERE type_id IN ($0) "
-           " LOCK IN SHARE MODE; "
-    parameter_num: 1
-  }
-  create_type_table {
-    query: " CREATE TABLE IF NOT EXISTS `Type` ( "
-           "   `id` INT PRIMARY KEY AUTO_INCREMENT, "
-           "   `name` VARCHAR(255) NOT NULL, "
-           "   `version` VARCHAR(255), "
-           "   `type_kind` TINYINT(1) NOT NULL, "
-           "   `description` TEXT, "
-           "   `input_type` TEXT, "
-           "   `output_type` TEXT, "
-           "   `external_id` VARCHAR(255) UNIQUE "
-           " ); "
-  }
-  create_artifact_table {
-    query: " CREATE TABLE IF NOT EXISTS `Artifact` ( "
-           "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-           "   `type_id` INT NOT NULL, "
-           "   `uri` TEXT, "
-           "   `state` INT, "
-           "   `name` VARCHAR(255), "
-           "   `external_id` VARCHAR(255) UNIQUE, "
-           "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-           "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-           "   CONSTRAINT UniqueArtifactTypeName UNIQUE(`type_id`, `name`) "
-           " ); "
-  }
-  create_artifact_property_table {
-    query: " CREATE TABLE IF NOT EXISTS `ArtifactProperty` ( "
-           "   `artifact_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
-           "   `is_custom_property` TINYINT(1) NOT NULL, "
-           "   `int_value` INT, "
-           "   `double_value` DOUBLE, "
-           "   `string_value` MEDIUMTEXT, "
-           "   `byte_value` MEDIUMBLOB, "
-           "   `proto_value` MEDIUMBLOB, "
-           "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`artifact_id`, `name`, `is_custom_property`)); "
-  }
-  create_execution_table {
-    query: " CREATE TABLE IF NOT EXISTS `Execution` ( "
-           "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-           "   `type_id` INT NOT NULL, "
-           "   `last_known_state` INT, "
-           "   `name` VARCHAR(255), "
-           "   `external_id` VARCHAR(255) UNIQUE, "
-           "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-           "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-           "   CONSTRAINT UniqueExecutionTypeName UNIQUE(`type_id`, `name`) "
-           " ); "
-  }
-  create_execution_property_table {
-    query: " CREATE TABLE IF NOT EXISTS `ExecutionProperty` ( "
-           "   `execution_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
-           "   `is_custom_property` TINYINT(1) NOT NULL, "
-           "   `int_value` INT, "
+  # In v11, we added the TypeCatalog table to version the types.
+  migration_schemes {
+    key: 11
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `TypeCatalog` ( "
+               "   `type_id` INTEGER PRIMARY KEY, "
+               "   `catalog_version` BIGINT NOT NULL "
+               " ); "
+      }
+      # The existing types are in the first version of the catalog.
+      upgrade_queries {
+        query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+               " SELECT `id`, 1 FROM `Type`; "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+               " VALUES(0, 1); "
+      }
+      upgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` (`id`, `name`, `type_kind`) "
+                 " VALUES (1, 'artifact_type', 1), (2, 'execution_type', 0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `TypeCatalog` "
+                 " WHERE `type_id` = 0 AND `catalog_version` = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM `TypeCatalog` "
+                 " WHERE `type_id` IN (1, 2) AND `catalog_version` = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = (SELECT count(*) FROM `Type`) "
+                 " FROM `TypeCatalog` "
+                 " WHERE `type_id` <> 0 AND `catalog_version` = 1; "
+        }
+      }
+      downgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ArtifactPropertyTemp` ( "
+               "   `artifact_id` INT NOT NULL, "
+               "   `name` VARCHAR(255) NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`artifact_id`, `name`, `is_custom_property`)); "
+      }
+      downgrade_queries {
+        query: " INSERT INTO `ArtifactPropertyTemp` "
+               " SELECT AP.`artifact_id`, PN.`name`, AP.`is_custom_property`, "
+               "        AP.`int_value`, AP.`double_value`, AP.`string_value`, "
+               "        AP.`byte_value`, AP.`proto_value`, AP.`bool_value` "
+               " FROM `ArtifactProperty` AS AP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = AP.`name_id`); "
+      }
+      downgrade_queries { query: " DROP TABLE `ArtifactProperty`; " }
+      downgrade_queries {
+        query: " ALTER TABLE `ArtifactPropertyTemp` "
+               "  RENAME TO `ArtifactProperty`; "
+      }
+      downgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ExecutionPropertyTemp` ( "
+               "   `execution_id` INT NOT NULL, "
+               "   `name` VARCHAR(255) NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`execution_id`, `name`, `is_custom_property`)); "
+      }
+      downgrade_queries {
+        query: " INSERT INTO `ExecutionPropertyTemp` "
+               " SELECT EP.`execution_id`, PN.`name`, EP.`is_custom_property`, "
+               "        EP.`int_value`, EP.`double_value`, EP.`string_value`, "
+               "        EP.`byte_value`, EP.`proto_value`, EP.`bool_value` "
+               " FROM `ExecutionProperty` AS EP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = EP.`name_id`); "
+      }
+      downgrade_queries { query: " DROP TABLE `ExecutionProperty`; " }
+      downgrade_queries {
+        query: " ALTER TABLE `ExecutionPropertyTemp` "
+               "  RENAME TO `ExecutionProperty`; "
+      }
+      downgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ContextPropertyTemp` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `name` VARCHAR(255) NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`context_id`, `name`, `is_custom_property`)); "
+      }
+      downgrade_queries {
+        query: " INSERT INTO `ContextPropertyTemp` "
+               " SELECT CP.`context_id`, PN.`name`, CP.`is_custom_property`, "
+               "        CP.`int_value`, CP.`double_value`, CP.`string_value`, "
+               "        CP.`byte_value`, CP.`proto_value`, CP.`bool_value` "
+               " FROM `ContextProperty` AS CP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`); "
+      }
+      downgrade_queries { query: " DROP TABLE `ContextProperty`; " }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextPropertyTemp` "
+               "  RENAME TO `ContextProperty`; "
+      }
+      # recreate the indices that were dropped along with the old tables
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_int` "
+               " ON `ArtifactProperty`(`name`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_double` "
+               " ON `ArtifactProperty`(`name`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_string` "
+               " ON `ArtifactProperty`(`name`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_int` "
+               " ON `ExecutionProperty`(`name`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_double` "
+               " ON `ExecutionProperty`(`name`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_string` "
+               " ON `ExecutionProperty`(`name`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_int` "
+               " ON `ContextProperty`(`name`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_double` "
+               " ON `ContextProperty`(`name`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_string` "
+               " ON `ContextProperty`(`name`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      downgrade_queries { query: " DROP TABLE `PropertyName`; " }
+      # verify that downgrading keeps the property names
+      downgrade_verification {
+        previous_version_setup_queries {
+          query: "DELETE FROM `ArtifactProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `ExecutionProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `ContextProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `PropertyName`;"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `PropertyName` (`id`, `name`) "
+                 " VALUES (1, 'p1'), (2, 'p2'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
+                 "     `is_custom_property`, `name_id`, `string_value`) "
+                 " VALUES (1, 0, 1, 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ExecutionProperty` (`execution_id`, "
+                 "     `is_custom_property`, `name_id`, `int_value`) "
+                 " VALUES (1, 1, 1, 1); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ContextProperty` (`context_id`, "
+                 "     `is_custom_property`, `name_id`, `double_value`) "
+                 " VALUES (1, 0, 2, 1.0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `sqlite_master` "
+                 " WHERE `type` = 'table' AND `name` = 'PropertyName'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
+                 " WHERE `artifact_id` = 1 AND `is_custom_property` = 0 AND "
+                 "       `name` = 'p1' AND `string_value` = 'abc'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
+                 " WHERE `execution_id` = 1 AND `is_custom_property` = 1 AND "
+                 "       `name` = 'p1' AND `int_value` = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ContextProperty` "
+                 " WHERE `context_id` = 1 AND `is_custom_property` = 0 AND "
+                 "       `name` = 'p2' AND `double_value` = 1.0; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ArtifactProperty' "
+                 "       AND `name` LIKE 'idx_artifact_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ExecutionProperty' "
+                 "       AND `name` LIKE 'idx_execution_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ContextProperty' "
+                 "       AND `name` LIKE 'idx_context_property_%'; "
+        }
+      }
+      db_verification { total_num_indexes: 40 total_num_tables: 16 }
+    }
+  }
+)pb",
+R"pb(
+  # In v12, we interned the property names into the PropertyName table, which
+  # the {X}Property tables and their indices refer to by id.
+  migration_schemes {
+    key: 12
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `PropertyName` ( "
+               "   `id` INTEGER PRIMARY KEY AUTOINCREMENT, "
+               "   `name` VARCHAR(255) NOT NULL UNIQUE "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `PropertyName`(`name`) "
+               " SELECT `name` FROM `ArtifactProperty` "
+               " UNION SELECT `name` FROM `ExecutionProperty` "
+               " UNION SELECT `name` FROM `ContextProperty`; "
+      }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ArtifactPropertyTemp` ( "
+               "   `artifact_id` INT NOT NULL, "
+               "   `name_id` INT NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`artifact_id`, `name_id`, "
+               "   `is_custom_property`)); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `ArtifactPropertyTemp` "
+               " SELECT AP.`artifact_id`, PN.`id`, AP.`is_custom_property`, "
+               "        AP.`int_value`, AP.`double_value`, AP.`string_value`, "
+               "        AP.`byte_value`, AP.`proto_value`, AP.`bool_value` "
+               " FROM `ArtifactProperty` AS AP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = AP.`name`); "
+      }
+      upgrade_queries { query: " DROP TABLE `ArtifactProperty`; " }
+      upgrade_queries {
+        query: " ALTER TABLE `ArtifactPropertyTemp` "
+               "  RENAME TO `ArtifactProperty`; "
+      }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ExecutionPropertyTemp` ( "
+               "   `execution_id` INT NOT NULL, "
+               "   `name_id` INT NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`execution_id`, `name_id`, "
+               "   `is_custom_property`)); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `ExecutionPropertyTemp` "
+               " SELECT EP.`execution_id`, PN.`id`, EP.`is_custom_property`, "
+               "        EP.`int_value`, EP.`double_value`, EP.`string_value`, "
+               "        EP.`byte_value`, EP.`proto_value`, EP.`bool_value` "
+               " FROM `ExecutionProperty` AS EP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = EP.`name`); "
+      }
+      upgrade_queries { query: " DROP TABLE `ExecutionProperty`; " }
+      upgrade_queries {
+        query: " ALTER TABLE `ExecutionPropertyTemp` "
+               "  RENAME TO `ExecutionProperty`; "
+      }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ContextPropertyTemp` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `name_id` INT NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               "   `byte_value` BLOB, "
+               "   `proto_value` BLOB, "
+               "   `bool_value` BOOLEAN, "
+               " PRIMARY KEY (`context_id`, `name_id`, `is_custom_property`)); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `ContextPropertyTemp` "
+               " SELECT CP.`context_id`, PN.`id`, CP.`is_custom_property`, "
+               "        CP.`int_value`, CP.`double_value`, CP.`string_value`, "
+               "        CP.`byte_value`, CP.`proto_value`, CP.`bool_value` "
+               " FROM `ContextProperty` AS CP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = CP.`name`); "
+      }
+      upgrade_queries { query: " DROP TABLE `ContextProperty`; " }
+      upgrade_queries {
+        query: " ALTER TABLE `ContextPropertyTemp` "
+               "  RENAME TO `ContextProperty`; "
+      }
+      # recreate the indices that were dropped along with the old tables
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_int` "
+               " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_double` "
+               " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_artifact_property_string` "
+               " ON `ArtifactProperty`(`name_id`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_int` "
+               " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_double` "
+               " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_execution_property_string` "
+               " ON `ExecutionProperty`(`name_id`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_int` "
+               " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+               " `int_value`) "
+               " WHERE `int_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_double` "
+               " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+               " `double_value`) "
+               " WHERE `double_value` IS NOT NULL; "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS `idx_context_property_string` "
+               " ON `ContextProperty`(`name_id`, `is_custom_property`, "
+               " `string_value`) "
+               " WHERE `string_value` IS NOT NULL; "
+      }
+      upgrade_verification {
+        previous_version_setup_queries {
+          query: "DELETE FROM `ArtifactProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `ExecutionProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `ContextProperty`;"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
+                 "     `is_custom_property`, `name`, `string_value`) "
+                 " VALUES (1, 0, 'p1', 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ExecutionProperty` (`execution_id`, "
+                 "     `is_custom_property`, `name`, `int_value`) "
+                 " VALUES (1, 1, 'p1', 1); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ContextProperty` (`context_id`, "
+                 "     `is_custom_property`, `name`, `double_value`) "
+                 " VALUES (1, 0, 'p2', 1.0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM `PropertyName`; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 "
+                 " FROM `ArtifactProperty` AS AP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = AP.`name_id`) "
+                 " WHERE AP.`artifact_id` = 1 AND "
+                 "       AP.`is_custom_property` = 0 AND "
+                 "       PN.`name` = 'p1' AND AP.`string_value` = 'abc'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 "
+                 " FROM `ExecutionProperty` AS EP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = EP.`name_id`) "
+                 " WHERE EP.`execution_id` = 1 AND "
+                 "       EP.`is_custom_property` = 1 AND "
+                 "       PN.`name` = 'p1' AND EP.`int_value` = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 "
+                 " FROM `ContextProperty` AS CP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`) "
+                 " WHERE CP.`context_id` = 1 AND "
+                 "       CP.`is_custom_property` = 0 AND "
+                 "       PN.`name` = 'p2' AND CP.`double_value` = 1.0; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ArtifactProperty' "
+                 "       AND `name` LIKE 'idx_artifact_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ExecutionProperty' "
+                 "       AND `name` LIKE 'idx_execution_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `sqlite_master` "
+                 " WHERE `type` = 'index' AND `tbl_name` = 'ContextProperty' "
+                 "       AND `name` LIKE 'idx_context_property_%'; "
+        }
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `WriteEpoch`; " }
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `sqlite_master` "
+                 " WHERE `tbl_name` = 'WriteEpoch'; "
+        }
+      }
+      db_verification { total_num_indexes: 41 total_num_tables: 17 }
+    }
+  }
+)pb",
+R"pb(
+  # In v13, we added the WriteEpoch table. It counts the committed writes of
+  # each node kind, so that servers can tell whether their cached list results
+  # are stale.
+  migration_schemes {
+    key: 13
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `WriteEpoch` ( "
+               "   `type_kind` INTEGER PRIMARY KEY, "
+               "   `epoch` BIGINT NOT NULL "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `WriteEpoch`(`type_kind`, `epoch`) "
+               " VALUES(0, 0), (1, 0), (2, 0); "
+      }
+      upgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM `WriteEpoch` "
+                 " WHERE `type_kind` IN (0, 1, 2) AND `epoch` = 0; "
+        }
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `ContextSummary`; " }
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `sqlite_master` "
+                 " WHERE `tbl_name` = 'ContextSummary'; "
+        }
+      }
+      db_verification { total_num_indexes: 41 total_num_tables: 18 }
+    }
+  }
+)pb",
+R"pb(
+  # In v14, we added the ContextSummary table. It counts the executions and
+  # artifacts of each type and state in a context, so that the summaries of
+  # contexts are read without listing their nodes.
+  migration_schemes {
+    key: 14
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ContextSummary` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `type_kind` INT NOT NULL, "
+               "   `type_id` INT NOT NULL, "
+               "   `state` INT NOT NULL, "
+               "   `num_nodes` BIGINT NOT NULL, "
+               "   PRIMARY KEY (`context_id`, `type_kind`, `type_id`, `state`) "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `ContextSummary`( "
+               "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+               " SELECT A.`context_id`, 0, E.`type_id`, "
+               "        COALESCE(E.`last_known_state`, 0), COUNT(*) "
+               " FROM `Association` AS A "
+               "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+               " GROUP BY A.`context_id`, E.`type_id`, "
+               "          COALESCE(E.`last_known_state`, 0) "
+               " UNION ALL "
+               " SELECT T.`context_id`, 1, R.`type_id`, "
+               "        COALESCE(R.`state`, 0), COUNT(*) "
+               " FROM `Attribution` AS T "
+               "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+               " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0); "
+      }
+      upgrade_verification {
+        previous_version_setup_queries {
+          query: " INSERT INTO `Execution` "
+                 "     (`id`, `type_id`, `last_known_state`) "
+                 " VALUES (1, 2, 3); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Association`(`context_id`, `execution_id`) "
+                 " VALUES (4, 1); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ContextSummary` "
+                 " WHERE `context_id` = 4 AND `type_kind` = 0 AND "
+                 "       `type_id` = 2 AND `state` = 3 AND `num_nodes` = 1; "
+        }
+      }
+      db_verification { total_num_indexes: 42 total_num_tables: 19 }
+    }
+  }
+)pb");
+
+// Template queries for MySQLMetadataSources.
+// no-lint to support vc (C2026) 16380 max length for char[].
+const std::string kMySQLMetadataSourceQueryConfig = absl::StrCat(  // NOLINT
+R"pb(
+  metadata_source_type: MYSQL_METADATA_SOURCE
+  select_last_insert_id { query: " SELECT last_insert_id(); " }
+  select_type_by_name {
+    query: " SELECT `id`, `name`, `version`, `description`, "
+           "        `input_type`, `output_type` FROM `Type` "
+           " WHERE name = $0 AND version IS NULL AND type_kind = $1 "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 2
+  }
+  select_type_by_name_and_version {
+    query: " SELECT `id`, `name`, `version`, `description`, "
+           "        `input_type`, `output_type` FROM `Type` "
+           " WHERE name = $0 AND version = $1 AND type_kind = $2 "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 3
+  }
+  select_types_by_names {
+    query: " SELECT `id`, `name`, `version`, `description`, "
+           "        `input_type`, `output_type` FROM `Type` "
+           " WHERE name IN ($0) AND version IS NULL AND type_kind = $1 "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 2
+    }
+    select_types_by_names_and_versions {
+    query: " SELECT `id`, `name`, `version`, `description`, "
+           "        `input_type`, `output_type` FROM `Type` "
+           " WHERE (name, version) IN ($0) AND type_kind = $1 "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 2
+    }
+  select_context_by_id {
+    query: " SELECT C.id, C.type_id, C.name, C.external_id, "
+           "        C.create_time_since_epoch, C.last_update_time_since_epoch, "
+           "        T.name AS `type`, T.version AS type_version, "
+           "        T.description AS type_description, "
+           "        T.external_id AS type_external_id "
+           " FROM `Context` AS C "
+           " LEFT JOIN `Type` AS T ON (T.id = C.type_id) "
+           " WHERE C.id IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_context_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Context` "
+           " WHERE `id` IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_execution_by_id {
+    query: " SELECT E.id, E.type_id, E.last_known_state, E.name, "
+           "        E.external_id, E.create_time_since_epoch, "
+           "        E.last_update_time_since_epoch, "
+           "        T.name AS `type`, T.version AS type_version, "
+           "        T.description AS type_description, "
+           "        T.external_id AS type_external_id "
+           " FROM `Execution` AS E "
+           " LEFT JOIN `Type` AS T "
+           "   ON (T.id = E.type_id) "
+           " WHERE E.id IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_execution_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Execution` "
+           " WHERE `id` IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_execution_ids_for_claim {
+    query: " SELECT `id` FROM `Execution` "
+           " WHERE `type_id` = $0 "
+           "   AND (`last_known_state` = $1 "
+           "        OR ($1 = 0 AND `last_known_state` IS NULL)) "
+           " ORDER BY `id` LIMIT $2 FOR UPDATE SKIP LOCKED; "
+    parameter_num: 3
+  }
+  select_artifact_by_id {
+    query: " SELECT A.id, A.type_id, A.uri, A.state, A.name, "
+           "        A.external_id, A.create_time_since_epoch, "
+           "        A.last_update_time_since_epoch, "
+           "        T.name AS `type`, T.version AS type_version, "
+           "        T.description AS type_description, "
+           "        T.external_id AS type_external_id "
+           " FROM `Artifact` AS A "
+           " LEFT JOIN `Type` AS T "
+           "   ON (T.id = A.type_id) "
+           " WHERE A.id IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_artifact_last_update_time_by_id {
+    query: " SELECT `id`, `last_update_time_since_epoch` FROM `Artifact` "
+           " WHERE `id` IN ($0) LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  select_parent_type_by_type_id {
+    query: " SELECT `type_id`, `parent_type_id` "
+           " FROM `ParentType` WHERE type_id IN ($0) "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 1
+  }
+  create_type_table {
+    query: " CREATE TABLE IF NOT EXISTS `Type` ( "
+           "   `id` INT PRIMARY KEY AUTO_INCREMENT, "
+           "   `name` VARCHAR(255) NOT NULL, "
+           "   `version` VARCHAR(255), "
+           "   `type_kind` TINYINT(1) NOT NULL, "
+           "   `description` TEXT, "
+           "   `input_type` TEXT, "
+           "   `output_type` TEXT, "
+           "   `external_id` VARCHAR(255) UNIQUE "
+           " ); "
+  }
+  create_artifact_table {
+    query: " CREATE TABLE IF NOT EXISTS `Artifact` ( "
+           "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+           "   `type_id` INT NOT NULL, "
+           "   `uri` TEXT, "
+           "   `state` INT, "
+           "   `name` VARCHAR(255), "
+           "   `external_id` VARCHAR(255) UNIQUE, "
+           "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+           "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+           "   CONSTRAINT UniqueArtifactTypeName UNIQUE(`type_id`, `name`) "
+           " ); "
+  }
+  create_artifact_property_table {
+    query: " CREATE TABLE IF NOT EXISTS `ArtifactProperty` ( "
+           "   `artifact_id` INT NOT NULL, "
+           "   `name_id` INT NOT NULL, "
+           "   `is_custom_property` TINYINT(1) NOT NULL, "
+           "   `int_value` INT, "
+           "   `double_value` DOUBLE, "
+           "   `string_value` MEDIUMTEXT, "
+           "   `byte_value` MEDIUMBLOB, "
+           "   `proto_value` MEDIUMBLOB, "
+           "   `bool_value` BOOLEAN, "
+           " PRIMARY KEY (`artifact_id`, `name_id`, `is_custom_property`)); "
+  }
+  create_execution_table {
+    query: " CREATE TABLE IF NOT EXISTS `Execution` ( "
+           "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+           "   `type_id` INT NOT NULL, "
+           "   `last_known_state` INT, "
+           "   `name` VARCHAR(255), "
+           "   `external_id` VARCHAR(255) UNIQUE, "
+           "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+           "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+           "   CONSTRAINT UniqueExecutionTypeName UNIQUE(`type_id`, `name`) "
+           " ); "
+  }
+  create_execution_property_table {
+    query: " CREATE TABLE IF NOT EXISTS `ExecutionProperty` ( "
+           "   `execution_id` INT NOT NULL, "
+           "   `name_id` INT NOT NULL, "
+           "   `is_custom_property` TINYINT(1) NOT NULL, "
+           "   `int_value` INT, "
            "   `double_value` DOUBLE, "
            "   `string_value` MEDIUMTEXT, "
            "   `byte_value` MEDIUMBLOB, "
            "   `proto_value` MEDIUMBLOB, "
            "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`execution_id`, `name`, `is_custom_property`)); "
+           " PRIMARY KEY (`execution_id`, `name_id`, `is_custom_property`)); "
   }
   create_context_table {
     query: " CREATE TABLE IF NOT EXISTS `Context` ( "
@@ -3025,7 +4117,7 @@ R"pb(
   create_context_property_table {
     query: " CREATE TABLE IF NOT EXISTS `ContextProperty` ( "
            "   `context_id` INT NOT NULL, "
-           "   `name` VARCHAR(255) NOT NULL, "
+           "   `name_id` INT NOT NULL, "
            "   `is_custom_property` TINYINT(1) NOT NULL, "
            "   `int_value` INT, "
            "   `double_value` DOUBLE, "
@@ -3033,7 +4125,23 @@ R"pb(
            "   `byte_value` MEDIUMBLOB, "
            "   `proto_value` MEDIUMBLOB, "
            "   `bool_value` BOOLEAN, "
-           " PRIMARY KEY (`context_id`, `name`, `is_custom_property`)); "
+           " PRIMARY KEY (`context_id`, `name_id`, `is_custom_property`)); "
+  }
+  # The names are binary strings, so that their uniqueness and lookups are case
+  # sensitive as on the other backends, unlike the default collations.
+  create_property_name_table {
+    query: " CREATE TABLE IF NOT EXISTS `PropertyName` ( "
+           "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+           "   `name` VARBINARY(255) NOT NULL UNIQUE "
+           " ); "
+  }
+  # A locking read sees the names interned by the transactions that committed
+  # after the snapshot of the current one was taken, e.g., the one that made
+  # `insert_property_name` skip a duplicate name.
+  select_property_name_id {
+    query: " SELECT `id` FROM `PropertyName` WHERE `name` = $0 "
+           " LOCK IN SHARE MODE; "
+    parameter_num: 1
   }
   create_event_table {
     query: " CREATE TABLE IF NOT EXISTS `Event` ( "
@@ -3108,47 +4216,47 @@ R"pb(
   secondary_indices {
     query: " ALTER TABLE `ArtifactProperty` "
            "  ADD INDEX `idx_artifact_property_int`( "
-           "    `name`, `is_custom_property`, `int_value`); "
+           "    `name_id`, `is_custom_property`, `int_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ArtifactProperty` "
            "  ADD INDEX `idx_artifact_property_double`( "
-           "    `name`, `is_custom_property`, `double_value`); "
+           "    `name_id`, `is_custom_property`, `double_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ArtifactProperty` "
            "  ADD INDEX `idx_artifact_property_string`( "
-           "    `name`, `is_custom_property`, `string_value`(255)); "
+           "    `name_id`, `is_custom_property`, `string_value`(255)); "
   }
   secondary_indices {
     query: " ALTER TABLE `ExecutionProperty` "
            "  ADD INDEX `idx_execution_property_int`( "
-           "    `name`, `is_custom_property`, `int_value`); "
+           "    `name_id`, `is_custom_property`, `int_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ExecutionProperty` "
            "  ADD INDEX `idx_execution_property_double`( "
-           "    `name`, `is_custom_property`, `double_value`); "
+           "    `name_id`, `is_custom_property`, `double_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ExecutionProperty` "
            "  ADD INDEX `idx_execution_property_string`( "
-           "    `name`, `is_custom_property`, `string_value`(255)); "
+           "    `name_id`, `is_custom_property`, `string_value`(255)); "
   }
   secondary_indices {
     query: " ALTER TABLE `ContextProperty` "
            "  ADD INDEX `idx_context_property_int`( "
-           "    `name`, `is_custom_property`, `int_value`); "
+           "    `name_id`, `is_custom_property`, `int_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ContextProperty` "
            "  ADD INDEX `idx_context_property_double`( "
-           "    `name`, `is_custom_property`, `double_value`); "
+           "    `name_id`, `is_custom_property`, `double_value`); "
   }
   secondary_indices {
     query: " ALTER TABLE `ContextProperty` "
            "  ADD INDEX `idx_context_property_string`( "
-           "    `name`, `is_custom_property`, `string_value`(255)); "
+           "    `name_id`, `is_custom_property`, `string_value`(255)); "
   }
   secondary_indices {
     query: " ALTER TABLE `Type` "
@@ -3168,16 +4276,252 @@ R"pb(
   }
   # downgrade to 0.13.2 (i.e., v0), and drops the MLMDEnv table.
   migration_schemes {
-    key: 0
+    key: 0
+    value: {
+      # downgrade queries from version 1
+      downgrade_queries { query: " DROP TABLE IF EXISTS `MLMDEnv`; " }
+      # check the tables are deleted properly
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'MLMDEnv'; "
+        }
+      }
+    }
+  }
+)pb",
+R"pb(
+  migration_schemes {
+    key: 1
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `MLMDEnv` ( "
+               "   `schema_version` INTEGER PRIMARY KEY "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `MLMDEnv`(`schema_version`) VALUES(0); "
+      }
+      # v0.13.2 release
+      upgrade_verification {
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `Type` ( "
+                 "   `id` INT PRIMARY KEY AUTO_INCREMENT, "
+                 "   `name` VARCHAR(255) NOT NULL, "
+                 "   `is_artifact_type` TINYINT(1) NOT NULL, "
+                 "   `input_type` TEXT, "
+                 "   `output_type` TEXT"
+                 " ); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `TypeProperty` ( "
+                 "   `type_id` INT NOT NULL, "
+                 "   `name` VARCHAR(255) NOT NULL, "
+                 "   `data_type` INT NULL, "
+                 " PRIMARY KEY (`type_id`, `name`)); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `Artifact` ( "
+                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+                 "   `type_id` INT NOT NULL, "
+                 "   `uri` TEXT "
+                 " ); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `ArtifactProperty` ( "
+                 "   `artifact_id` INT NOT NULL, "
+                 "   `name` VARCHAR(255) NOT NULL, "
+                 "   `is_custom_property` TINYINT(1) NOT NULL, "
+                 "   `int_value` INT, "
+                 "   `double_value` DOUBLE, "
+                 "   `string_value` TEXT, "
+                 " PRIMARY KEY (`artifact_id`, `name`, `is_custom_property`)); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `Execution` ( "
+                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+                 "   `type_id` INT NOT NULL "
+                 " ); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `ExecutionProperty` ( "
+                 "   `execution_id` INT NOT NULL, "
+                 "   `name` VARCHAR(255) NOT NULL, "
+                 "   `is_custom_property` TINYINT(1) NOT NULL, "
+                 "   `int_value` INT, "
+                 "   `double_value` DOUBLE, "
+                 "   `string_value` TEXT, "
+                 " PRIMARY KEY (`execution_id`, `name`, "
+                 "   `is_custom_property`)); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `Event` ( "
+                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+                 "   `artifact_id` INT NOT NULL, "
+                 "   `execution_id` INT NOT NULL, "
+                 "   `type` INT NOT NULL, "
+                 "   `milliseconds_since_epoch` BIGINT "
+                 " ); "
+        }
+        previous_version_setup_queries {
+          query: " CREATE TABLE IF NOT EXISTS `EventPath` ( "
+                 "   `event_id` INT NOT NULL, "
+                 "   `is_index_step` TINYINT(1) NOT NULL, "
+                 "   `step_index` INT, "
+                 "   `step_key` TEXT "
+                 " ); "
+        }
+        # check the new table has 1 row
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `MLMDEnv`; "
+        }
+      }
+      # downgrade queries from version 2, drop all ContextTypes and rename
+      # the `type_kind` back to `is_artifact_type` column.
+      downgrade_queries {
+        query: " DELETE FROM `Type` WHERE `type_kind` = 2; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Type` CHANGE COLUMN "
+               " `type_kind` `is_artifact_type` TINYINT(1) NOT NULL; "
+      }
+      # check the tables are deleted properly
+      downgrade_verification {
+        # populate the `Type` table with context types.
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` "
+                 " (`name`, `type_kind`, `input_type`, `output_type`) "
+                 " VALUES ('execution_type', 0, 'input', 'output'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` "
+                 " (`name`, `type_kind`, `input_type`, `output_type`) "
+                 " VALUES ('artifact_type', 1, 'input', 'output'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` "
+                 " (`name`, `type_kind`, `input_type`, `output_type`) "
+                 " VALUES ('context_type', 2, 'input', 'output'); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `Type` "
+                 " WHERE `is_artifact_type` = 2; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `Type` "
+                 " WHERE `is_artifact_type` = 1 AND `name` = 'artifact_type'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `Type` "
+                 " WHERE `is_artifact_type` = 0 AND `name` = 'execution_type'; "
+        }
+      }
+    }
+  }
+)pb",
+R"pb(
+  migration_schemes {
+    key: 2
+    value: {
+      upgrade_queries {
+        query: " ALTER TABLE `Type` CHANGE COLUMN "
+               " `is_artifact_type` `type_kind` TINYINT(1) NOT NULL; "
+      }
+      upgrade_verification {
+        # populate one ArtifactType and one ExecutionType.
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` (`name`, `is_artifact_type`) VALUES "
+                 " ('artifact_type', 1); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` "
+                 " (`name`, `is_artifact_type`, `input_type`, `output_type`) "
+                 " VALUES ('execution_type', 0, 'input', 'output'); "
+        }
+        # check after migration, the existing types are the same including
+        # id.
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `Type` WHERE "
+                 " `id` = 1 AND `type_kind` = 1 AND `name` = 'artifact_type'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `Type` WHERE "
+                 " `id` = 2 AND `type_kind` = 0 AND `name` = 'execution_type' "
+                 " AND `input_type` = 'input' AND `output_type` = 'output'; "
+        }
+      }
+      # downgrade queries from version 3
+      downgrade_queries { query: " DROP TABLE IF EXISTS `Context`; " }
+      downgrade_queries {
+        query: " DROP TABLE IF EXISTS `ContextProperty`; "
+      }
+      # check the tables are deleted properly
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Context'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ContextProperty'; "
+        }
+      }
+    }
+  }
+)pb",
+R"pb(
+  migration_schemes {
+    key: 3
     value: {
-      # downgrade queries from version 1
-      downgrade_queries { query: " DROP TABLE IF EXISTS `MLMDEnv`; " }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `Context` ( "
+               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+               "   `type_id` INT NOT NULL, "
+               "   `name` VARCHAR(255) NOT NULL, "
+               "   UNIQUE(`type_id`, `name`) "
+               " ); "
+      }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ContextProperty` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `name` VARCHAR(255) NOT NULL, "
+               "   `is_custom_property` TINYINT(1) NOT NULL, "
+               "   `int_value` INT, "
+               "   `double_value` DOUBLE, "
+               "   `string_value` TEXT, "
+               " PRIMARY KEY (`context_id`, `name`, `is_custom_property`)); "
+      }
+      upgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `id`, `type_id`, `name` FROM `Context` "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `context_id`, `name`, `is_custom_property`, "
+                 "          `int_value`, `double_value`, `string_value` "
+                 "    FROM `ContextProperty` "
+                 " ) as T2; "
+        }
+      }
+      # downgrade queries from version 4
+      downgrade_queries { query: " DROP TABLE IF EXISTS `Association`; " }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `Attribution`; " }
       # check the tables are deleted properly
       downgrade_verification {
         post_migration_verification_queries {
           query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'MLMDEnv'; "
+                 "       `table_name` = 'Association'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Attribution'; "
         }
       }
     }
@@ -3185,153 +4529,395 @@ R"pb(
 )pb",
 R"pb(
   migration_schemes {
-    key: 1
+    key: 4
     value: {
       upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `MLMDEnv` ( "
-               "   `schema_version` INTEGER PRIMARY KEY "
+        query: " CREATE TABLE IF NOT EXISTS `Association` ( "
+               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+               "   `context_id` INT NOT NULL, "
+               "   `execution_id` INT NOT NULL, "
+               "   UNIQUE(`context_id`, `execution_id`) "
                " ); "
       }
       upgrade_queries {
-        query: " INSERT INTO `MLMDEnv`(`schema_version`) VALUES(0); "
+        query: " CREATE TABLE IF NOT EXISTS `Attribution` ( "
+               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+               "   `context_id` INT NOT NULL, "
+               "   `artifact_id` INT NOT NULL, "
+               "   UNIQUE(`context_id`, `artifact_id`) "
+               " ); "
       }
-      # v0.13.2 release
       upgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `id`, `context_id`, `execution_id` "
+                 "   FROM `Association` "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `id`, `context_id`, `artifact_id` "
+                 "   FROM `Attribution` "
+                 " ) as T1; "
+        }
+      }
+      # downgrade queries from version 5
+      downgrade_queries {
+        query: " ALTER TABLE `Artifact` "
+               " DROP INDEX UniqueArtifactTypeName; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Artifact` "
+               " DROP COLUMN `state`, "
+               " DROP COLUMN `name`, "
+               " DROP COLUMN `create_time_since_epoch`, "
+               " DROP COLUMN `last_update_time_since_epoch`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Execution` "
+               " DROP INDEX UniqueExecutionTypeName; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Execution` "
+               " DROP COLUMN `last_known_state`, "
+               " DROP COLUMN `name`, "
+               " DROP COLUMN `create_time_since_epoch`, "
+               " DROP COLUMN `last_update_time_since_epoch`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Context` "
+               " DROP COLUMN `create_time_since_epoch`, "
+               " DROP COLUMN `last_update_time_since_epoch`; "
+      }
+      # verify if the downgrading keeps the existing columns
+      downgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `Type` ( "
-                 "   `id` INT PRIMARY KEY AUTO_INCREMENT, "
-                 "   `name` VARCHAR(255) NOT NULL, "
-                 "   `is_artifact_type` TINYINT(1) NOT NULL, "
-                 "   `input_type` TEXT, "
-                 "   `output_type` TEXT"
-                 " ); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `type_id`, `uri`, `state`, `name`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 'uri1', 1, NULL, 0, 1); "
         }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `TypeProperty` ( "
-                 "   `type_id` INT NOT NULL, "
-                 "   `name` VARCHAR(255) NOT NULL, "
-                 "   `data_type` INT NULL, "
-                 " PRIMARY KEY (`type_id`, `name`)); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `type_id`, `uri`, `state`, `name`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (2, 3, 'uri2', NULL, 'name2', 1, 0); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `Artifact` ( "
-                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-                 "   `type_id` INT NOT NULL, "
-                 "   `uri` TEXT "
-                 " ); "
+          query: " INSERT INTO `Execution` "
+                 " (`id`, `type_id`, `last_known_state`, `name`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 1, NULL, 0, 1); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `ArtifactProperty` ( "
-                 "   `artifact_id` INT NOT NULL, "
-                 "   `name` VARCHAR(255) NOT NULL, "
-                 "   `is_custom_property` TINYINT(1) NOT NULL, "
-                 "   `int_value` INT, "
-                 "   `double_value` DOUBLE, "
-                 "   `string_value` TEXT, "
-                 " PRIMARY KEY (`artifact_id`, `name`, `is_custom_property`)); "
+          query: " INSERT INTO `Context` "
+                 " (`id`, `type_id`, `name`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 'name1', 1, 0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM `Artifact`; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Artifact` "
+                 "   WHERE `id` = 1 and `type_id` = 2 and `uri` = 'uri1' "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Artifact` "
+                 "   WHERE `id` = 2 and `type_id` = 3 and `uri` = 'uri2' "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `Execution`; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Execution` "
+                 "   WHERE `id` = 1 and `type_id` = 2 "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Context` "
+                 "   WHERE `id` = 1 and `type_id` = 2 "
+                 " ) as T1; "
         }
+      }
+    }
+  }
+)pb",
+R"pb(
+  migration_schemes {
+    key: 5
+    value: {
+      # upgrade Artifact table
+      upgrade_queries {
+        query: " ALTER TABLE `Artifact` ADD ( "
+               "   `state` INT, "
+               "   `name` VARCHAR(255), "
+               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
+               " ), "
+               " ADD CONSTRAINT UniqueArtifactTypeName "
+               " UNIQUE(`type_id`, `name`); "
+      }
+      # upgrade Execution table
+      upgrade_queries {
+        query: " ALTER TABLE `Execution` ADD ( "
+               "   `last_known_state` INT, "
+               "   `name` VARCHAR(255), "
+               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
+               " ), "
+               " ADD CONSTRAINT UniqueExecutionTypeName "
+               " UNIQUE(`type_id`, `name`); "
+      }
+      # upgrade Context table
+      upgrade_queries {
+        query: " ALTER TABLE `Context` ADD ( "
+               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
+               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
+               " ) "
+      }
+      # check the expected table columns are created properly.
+      upgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `Execution` ( "
-                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-                 "   `type_id` INT NOT NULL "
-                 " ); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `type_id`, `uri`) VALUES (1, 2, 'uri1'); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `ExecutionProperty` ( "
-                 "   `execution_id` INT NOT NULL, "
-                 "   `name` VARCHAR(255) NOT NULL, "
-                 "   `is_custom_property` TINYINT(1) NOT NULL, "
-                 "   `int_value` INT, "
-                 "   `double_value` DOUBLE, "
-                 "   `string_value` TEXT, "
-                 " PRIMARY KEY (`execution_id`, `name`, `is_custom_property`)); "
+          query: " INSERT INTO `Execution` "
+                 " (`id`, `type_id`) VALUES (1, 3); "
         }
         previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `Event` ( "
+          query: " CREATE TABLE IF NOT EXISTS `Context` ( "
                  "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-                 "   `artifact_id` INT NOT NULL, "
-                 "   `execution_id` INT NOT NULL, "
-                 "   `type` INT NOT NULL, "
-                 "   `milliseconds_since_epoch` BIGINT "
+                 "   `type_id` INT NOT NULL, "
+                 "   `name` VARCHAR(255) NOT NULL, "
+                 "   UNIQUE(`type_id`, `name`) "
                  " ); "
         }
-        previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `EventPath` ( "
-                 "   `event_id` INT NOT NULL, "
-                 "   `is_index_step` TINYINT(1) NOT NULL, "
-                 "   `step_index` INT, "
-                 "   `step_key` TEXT "
-                 " ); "
+        previous_version_setup_queries {
+          query: " INSERT INTO `Context` "
+                 " (`id`, `type_id`, `name`) VALUES (1, 2, 'name1'); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT `id`, `type_id`, `uri`, `state`, `name`, "
+                 "          `create_time_since_epoch`, "
+                 "          `last_update_time_since_epoch` "
+                 "   FROM `Artifact` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND `uri` = 'uri1' AND "
+                 "         `create_time_since_epoch` = 0 AND "
+                 "         `last_update_time_since_epoch` = 0 "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT `id`, `type_id`, `last_known_state`, `name`, "
+                 "          `create_time_since_epoch`, "
+                 "          `last_update_time_since_epoch` "
+                 "   FROM `Execution` "
+                 "   WHERE `id` = 1 AND `type_id` = 3 AND "
+                 "         `create_time_since_epoch` = 0 AND "
+                 "         `last_update_time_since_epoch` = 0 "
+                 " ) as T1; "
         }
-        # check the new table has 1 row
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `MLMDEnv`; "
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT `id`, `type_id`, `name`, "
+                 "          `create_time_since_epoch`, "
+                 "          `last_update_time_since_epoch` "
+                 "   FROM `Context` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' AND "
+                 "         `create_time_since_epoch` = 0 AND "
+                 "         `last_update_time_since_epoch` = 0 "
+                 " ) as T1; "
         }
       }
-      # downgrade queries from version 2, drop all ContextTypes and rename
-      # the `type_kind` back to `is_artifact_type` column.
+      # downgrade queries from version 6
+      downgrade_queries { query: " DROP TABLE `ParentType`; " }
+      downgrade_queries { query: " DROP TABLE `ParentContext`; " }
       downgrade_queries {
-        query: " DELETE FROM `Type` WHERE `type_kind` = 2; "
+        query: " ALTER TABLE `Type` "
+               " DROP COLUMN `version`, "
+               " DROP COLUMN `description`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Type` CHANGE COLUMN "
-               " `type_kind` `is_artifact_type` TINYINT(1) NOT NULL; "
+        query: " ALTER TABLE `Artifact` "
+               " DROP INDEX `idx_artifact_uri`, "
+               " DROP INDEX `idx_artifact_create_time_since_epoch`, "
+               " DROP INDEX `idx_artifact_last_update_time_since_epoch`; "
       }
-      # check the tables are deleted properly
+      downgrade_queries {
+        query: " ALTER TABLE `Event` "
+               " DROP INDEX `idx_event_artifact_id`, "
+               " DROP INDEX `idx_event_execution_id`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Type` "
+               " DROP INDEX `idx_type_name`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Execution` "
+               " DROP INDEX `idx_execution_create_time_since_epoch`, "
+               " DROP INDEX `idx_execution_last_update_time_since_epoch`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `Context` "
+               " DROP INDEX `idx_context_create_time_since_epoch`, "
+               " DROP INDEX `idx_context_last_update_time_since_epoch`; "
+      }
+      # verify if the downgrading keeps the existing columns
       downgrade_verification {
-        # populate the `Type` table with context types.
+        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
         previous_version_setup_queries {
           query: " INSERT INTO `Type` "
-                 " (`name`, `type_kind`, `input_type`, `output_type`) "
-                 " VALUES ('execution_type', 0, 'input', 'output'); "
+                 " (`id`, `name`, `version`, `type_kind`, "
+                 "  `description`, `input_type`, `output_type`) "
+                 " VALUES (1, 't1', 'v1', 1, 'desc1', 'input1', 'output1'); "
         }
         previous_version_setup_queries {
           query: " INSERT INTO `Type` "
-                 " (`name`, `type_kind`, `input_type`, `output_type`) "
-                 " VALUES ('artifact_type', 1, 'input', 'output'); "
+                 " (`id`, `name`, `version`, `type_kind`, "
+                 "  `description`, `input_type`, `output_type`) "
+                 " VALUES (2, 't2', 'v2', 2, 'desc2', 'input2', 'output2'); "
         }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`name`, `type_kind`, `input_type`, `output_type`) "
-                 " VALUES ('context_type', 2, 'input', 'output'); "
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM `Type`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `Type` "
-                 " WHERE `is_artifact_type` = 2; "
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Type` "
+                 "   WHERE `id` = 1 AND `name` = 't1' AND type_kind = 1 "
+                 "   AND `input_type` = 'input1' AND `output_type` = 'output1'"
+                 " ) as T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type` "
-                 " WHERE `is_artifact_type` = 1 AND `name` = 'artifact_type'; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ParentType'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type` "
-                 " WHERE `is_artifact_type` = 0 AND `name` = 'execution_type'; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ParentContext'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Artifact' AND "
+                 "       `index_name` LIKE 'idx_artifact_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` LIKE 'idx_event_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'ParentContext' AND "
+                 "       `index_name` LIKE 'idx_parentcontext_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Type' AND "
+                 "       `index_name` LIKE 'idx_type_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Execution' AND "
+                 "       `index_name` LIKE 'idx_execution_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Context' AND "
+                 "       `index_name` LIKE 'idx_context_%'; "
         }
       }
     }
   }
 )pb",
 R"pb(
+  # In v6, to support parental type and parental context, we added two
+  # tables `ParentType` and `ParentContext`. In addition, we added `version`
+  # and `description` in the `Type` table for improving type registrations.
+  # We introduce indices on Type.name, Artifact.uri, Event's artifact_id and
+  # execution_id, and create_time_since_epoch, last_update_time_since_epoch
+  # for all nodes.
   migration_schemes {
-    key: 2
+    key: 6
     value: {
       upgrade_queries {
-        query: " ALTER TABLE `Type` CHANGE COLUMN "
-               " `is_artifact_type` `type_kind` TINYINT(1) NOT NULL; "
+        query: " CREATE TABLE IF NOT EXISTS `ParentType` ( "
+               "   `type_id` INT NOT NULL, "
+               "   `parent_type_id` INT NOT NULL, "
+               " PRIMARY KEY (`type_id`, `parent_type_id`)); "
+      }
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ParentContext` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `parent_context_id` INT NOT NULL, "
+               " PRIMARY KEY (`context_id`, `parent_context_id`)); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Type` ADD ( "
+               "   `version` VARCHAR(255), "
+               "   `description` TEXT "
+               " ); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Artifact` "
+               " ADD INDEX `idx_artifact_uri`(`uri`(255)), "
+               "  ADD INDEX `idx_artifact_create_time_since_epoch` "
+               "             (`create_time_since_epoch`), "
+               "  ADD INDEX `idx_artifact_last_update_time_since_epoch` "
+               "             (`last_update_time_since_epoch`); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Event` "
+               " ADD INDEX `idx_event_artifact_id` (`artifact_id`), "
+               " ADD INDEX `idx_event_execution_id` (`execution_id`); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ParentContext` "
+               " ADD INDEX "
+               "  `idx_parentcontext_parent_context_id` (`parent_context_id`);"
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Type` "
+               " ADD INDEX `idx_type_name` (`name`);"
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Execution` "
+               "  ADD INDEX `idx_execution_create_time_since_epoch` "
+               "             (`create_time_since_epoch`), "
+               "  ADD INDEX `idx_execution_last_update_time_since_epoch` "
+               "             (`last_update_time_since_epoch`); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `Context` "
+               "  ADD INDEX `idx_context_create_time_since_epoch` "
+               "             (`create_time_since_epoch`), "
+               "  ADD INDEX `idx_context_last_update_time_since_epoch` "
+               "             (`last_update_time_since_epoch`); "
       }
+      # check the expected table columns are created properly.
       upgrade_verification {
-        # populate one ArtifactType and one ExecutionType.
-        previous_version_setup_queries {
-          query: " INSERT INTO `Type` (`name`, `is_artifact_type`) VALUES "
-                 " ('artifact_type', 1); "
-        }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`name`, `is_artifact_type`, `input_type`, `output_type`) "
-                 " VALUES ('execution_type', 0, 'input', 'output'); "
-        }
-        # check after migration, the existing types are the same including
-        # id.
+        # check existing rows in previous Type table are migrated properly.
         post_migration_verification_queries {
           query: " SELECT count(*) = 1 FROM `Type` WHERE "
                  " `id` = 1 AND `type_kind` = 1 AND `name` = 'artifact_type'; "
@@ -3341,1379 +4927,1375 @@ R"pb(
                  " `id` = 2 AND `type_kind` = 0 AND `name` = 'execution_type' "
                  " AND `input_type` = 'input' AND `output_type` = 'output'; "
         }
-      }
-      # downgrade queries from version 3
-      downgrade_queries { query: " DROP TABLE IF EXISTS `Context`; " }
-      downgrade_queries {
-        query: " DROP TABLE IF EXISTS `ContextProperty`; "
-      }
-      # check the tables are deleted properly
-      downgrade_verification {
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `type_id`, `parent_type_id` "
+                 "   FROM `ParentType` "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM ( "
+                 "   SELECT `context_id`, `parent_context_id` "
+                 "   FROM `ParentContext` "
+                 " ) as T1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Artifact' AND "
+                 "       `index_name` = 'idx_artifact_uri'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Artifact' AND "
+                 "       `index_name` = 'idx_artifact_create_time_since_epoch';"
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Artifact' AND `index_name` = "
+                 "       'idx_artifact_last_update_time_since_epoch';"
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` = 'idx_event_artifact_id'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` = 'idx_event_execution_id'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Context'; "
+                 "       `table_name` = 'ParentContext' AND "
+                 "       `index_name` = 'idx_parentcontext_parent_context_id'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ContextProperty'; "
+                 "       `table_name` = 'Type' AND "
+                 "       `index_name` = 'idx_type_name'; "
         }
-      }
-    }
-  }
-)pb",
-R"pb(
-  migration_schemes {
-    key: 3
-    value: {
-      upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `Context` ( "
-               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-               "   `type_id` INT NOT NULL, "
-               "   `name` VARCHAR(255) NOT NULL, "
-               "   UNIQUE(`type_id`, `name`) "
-               " ); "
-      }
-      upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `ContextProperty` ( "
-               "   `context_id` INT NOT NULL, "
-               "   `name` VARCHAR(255) NOT NULL, "
-               "   `is_custom_property` TINYINT(1) NOT NULL, "
-               "   `int_value` INT, "
-               "   `double_value` DOUBLE, "
-               "   `string_value` TEXT, "
-               " PRIMARY KEY (`context_id`, `name`, `is_custom_property`)); "
-      }
-      upgrade_verification {
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `id`, `type_id`, `name` FROM `Context` "
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Execution' AND `index_name` = "
+                 "       'idx_execution_create_time_since_epoch'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `context_id`, `name`, `is_custom_property`, "
-                 "          `int_value`, `double_value`, `string_value` "
-                 "    FROM `ContextProperty` "
-                 " ) as T2; "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'Execution' AND `index_name` = "
+                 "       'idx_execution_last_update_time_since_epoch'; "
         }
-      }
-      # downgrade queries from version 4
-      downgrade_queries { query: " DROP TABLE IF EXISTS `Association`; " }
-      downgrade_queries { query: " DROP TABLE IF EXISTS `Attribution`; " }
-      # check the tables are deleted properly
-      downgrade_verification {
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Association'; "
+                 "       `table_name` = 'Context' AND "
+                 "       `index_name` = 'idx_context_create_time_since_epoch'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Attribution'; "
+                 "       `table_name` = 'Context' AND `index_name` = "
+                 "       'idx_context_last_update_time_since_epoch'; "
         }
       }
-    }
-  }
-)pb",
-R"pb(
-  migration_schemes {
-    key: 4
-    value: {
-      upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `Association` ( "
-               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-               "   `context_id` INT NOT NULL, "
-               "   `execution_id` INT NOT NULL, "
-               "   UNIQUE(`context_id`, `execution_id`) "
-               " ); "
+      # downgrade queries from version 7
+      # Note v7 for MySQL used mediumtext for string_value, when downgrade
+      # the long text will be truncated to 65536 chars.
+      downgrade_queries {
+        query: " ALTER TABLE `ArtifactProperty` DROP COLUMN `byte_value`; "
       }
-      upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `Attribution` ( "
-               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-               "   `context_id` INT NOT NULL, "
-               "   `artifact_id` INT NOT NULL, "
-               "   UNIQUE(`context_id`, `artifact_id`) "
-               " ); "
+      downgrade_queries {
+        query: " ALTER TABLE `ExecutionProperty` DROP COLUMN `byte_value`; "
       }
-      upgrade_verification {
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `id`, `context_id`, `execution_id` "
-                 "   FROM `Association` "
-                 " ) as T1; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `id`, `context_id`, `artifact_id` "
-                 "   FROM `Attribution` "
-                 " ) as T1; "
-        }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` DROP COLUMN `byte_value`; "
       }
-      # downgrade queries from version 5
       downgrade_queries {
-        query: " ALTER TABLE `Artifact` "
-               " DROP INDEX UniqueArtifactTypeName; "
+        query: " ALTER TABLE `EventPath` DROP INDEX `idx_eventpath_event_id`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Artifact` "
-               " DROP COLUMN `state`, "
-               " DROP COLUMN `name`, "
-               " DROP COLUMN `create_time_since_epoch`, "
-               " DROP COLUMN `last_update_time_since_epoch`; "
+        query: " UPDATE `ArtifactProperty` "
+               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Execution` "
-               " DROP INDEX UniqueExecutionTypeName; "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " MODIFY COLUMN `string_value` TEXT; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Execution` "
-               " DROP COLUMN `last_known_state`, "
-               " DROP COLUMN `name`, "
-               " DROP COLUMN `create_time_since_epoch`, "
-               " DROP COLUMN `last_update_time_since_epoch`; "
+        query: " UPDATE `ExecutionProperty` "
+               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Context` "
-               " DROP COLUMN `create_time_since_epoch`, "
-               " DROP COLUMN `last_update_time_since_epoch`; "
+        query: " ALTER TABLE `ExecutionProperty` "
+               " MODIFY COLUMN `string_value` TEXT; "
+      }
+      downgrade_queries {
+        query: " UPDATE `ContextProperty` "
+               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               " MODIFY COLUMN `string_value` TEXT; "
       }
       # verify if the downgrading keeps the existing columns
       downgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `type_id`, `uri`, `state`, `name`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 'uri1', 1, NULL, 0, 1); "
+          query: "DELETE FROM `ArtifactProperty`;"
         }
         previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `type_id`, `uri`, `state`, `name`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (2, 3, 'uri2', NULL, 'name2', 1, 0); "
+          query: "DELETE FROM `ExecutionProperty`;"
         }
-        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Execution` "
-                 " (`id`, `type_id`, `last_known_state`, `name`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 1, NULL, 0, 1); "
+          query: "DELETE FROM `ContextProperty`;"
         }
-        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Context` "
-                 " (`id`, `type_id`, `name`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 'name1', 1, 0); "
+          query: " INSERT INTO `ArtifactProperty` "
+                 " (`artifact_id`, `name`, `string_value`) "
+                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('a', 160000))), "
+                 "        (1, 'p2', 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ExecutionProperty` "
+                 " (`execution_id`, `name`, `string_value`) "
+                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('e', 160000))), "
+                 "        (1, 'p2', 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ContextProperty` "
+                 " (`context_id`, `name`, `string_value`) "
+                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('c', 160000))), "
+                 "        (1, 'p2', 'abc'); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 2 FROM `Artifact`; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'EventPath' AND "
+                 "       `index_name` = 'idx_eventpath_event_id'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Artifact` "
-                 "   WHERE `id` = 1 and `type_id` = 2 and `uri` = 'uri1' "
-                 " ) as T1; "
+          query: " SELECT count(*) = 3 FROM `information_schema`.`columns` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` IN ('ArtifactProperty', "
+                 "           'ExecutionProperty', 'ContextProperty') AND "
+                 "       `column_name` = 'string_value' AND "
+                 "       `data_type` = 'text'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Artifact` "
-                 "   WHERE `id` = 2 and `type_id` = 3 and `uri` = 'uri2' "
-                 " ) as T1; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`columns` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` IN ('ArtifactProperty', "
+                 "           'ExecutionProperty', 'ContextProperty') AND "
+                 "       `column_name` = 'byte_value'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Execution`; "
+          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
+                 " WHERE `artifact_id` = 1 AND `name` = 'p1' AND "
+                 "   `string_value` = CONCAT('_prefix_', REPEAT('a', 65527)); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Execution` "
-                 "   WHERE `id` = 1 and `type_id` = 2 "
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
+                 " WHERE `artifact_id` = 1 AND `name` = 'p2' AND "
+                 "       `string_value` = 'abc'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Context` "
-                 "   WHERE `id` = 1 and `type_id` = 2 "
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
+                 " WHERE `execution_id` = 1 AND `name` = 'p1' AND "
+                 "   `string_value` = CONCAT('_prefix_', REPEAT('e', 65527)); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
+                 " WHERE `execution_id` = 1 AND `name` = 'p2' AND "
+                 "       `string_value` = 'abc'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ContextProperty` "
+                 " WHERE `context_id` = 1 AND `name` = 'p1' AND "
+                 "   `string_value` = CONCAT('_prefix_', REPEAT('c', 65527)); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM `ContextProperty` "
+                 " WHERE `context_id` = 1 AND `name` = 'p2' AND "
+                 "       `string_value` = 'abc'; "
         }
       }
     }
   }
 )pb",
 R"pb(
+  # In v7, we added byte_value for property tables for better storing binary
+  # property values. For MySQL, we extends string_value column to be
+  # MEDIUMTEXT in order to persist string value with size upto 16MB. In
+  # addition, we added index for `EventPath` to improve Event reads.
   migration_schemes {
-    key: 5
+    key: 7
     value: {
-      # upgrade Artifact table
       upgrade_queries {
-        query: " ALTER TABLE `Artifact` ADD ( "
-               "   `state` INT, "
-               "   `name` VARCHAR(255), "
-               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
-               " ), "
-               " ADD CONSTRAINT UniqueArtifactTypeName "
-               " UNIQUE(`type_id`, `name`); "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
+               " ADD COLUMN `byte_value` MEDIUMBLOB; "
       }
-      # upgrade Execution table
       upgrade_queries {
-        query: " ALTER TABLE `Execution` ADD ( "
-               "   `last_known_state` INT, "
-               "   `name` VARCHAR(255), "
-               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
-               " ), "
-               " ADD CONSTRAINT UniqueExecutionTypeName "
-               " UNIQUE(`type_id`, `name`); "
+        query: " ALTER TABLE `ExecutionProperty` "
+               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
+               " ADD COLUMN `byte_value` MEDIUMBLOB; "
       }
-      # upgrade Context table
       upgrade_queries {
-        query: " ALTER TABLE `Context` ADD ( "
-               "   `create_time_since_epoch` BIGINT NOT NULL DEFAULT 0, "
-               "   `last_update_time_since_epoch` BIGINT NOT NULL DEFAULT 0 "
-               " ) "
+        query: " ALTER TABLE `ContextProperty` "
+               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
+               " ADD COLUMN `byte_value` MEDIUMBLOB; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `EventPath` "
+               " ADD INDEX `idx_eventpath_event_id` (`event_id`); "
       }
       # check the expected table columns are created properly.
       upgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `type_id`, `uri`) VALUES (1, 2, 'uri1'); "
-        }
-        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Execution` "
-                 " (`id`, `type_id`) VALUES (1, 3); "
-        }
-        previous_version_setup_queries {
-          query: " CREATE TABLE IF NOT EXISTS `Context` ( "
-                 "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-                 "   `type_id` INT NOT NULL, "
-                 "   `name` VARCHAR(255) NOT NULL, "
-                 "   UNIQUE(`type_id`, `name`) "
-                 " ); "
+        # check existing rows in previous Type table are migrated properly.
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
+                 " `byte_value` IS NOT NULL; "
         }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Context` "
-                 " (`id`, `type_id`, `name`) VALUES (1, 2, 'name1'); "
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
+                 " `byte_value` IS NOT NULL; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT `id`, `type_id`, `uri`, `state`, `name`, "
-                 "          `create_time_since_epoch`, "
-                 "          `last_update_time_since_epoch` "
-                 "   FROM `Artifact` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND `uri` = 'uri1' AND "
-                 "         `create_time_since_epoch` = 0 AND "
-                 "         `last_update_time_since_epoch` = 0 "
-                 " ) as T1; "
+          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
+                 " `byte_value` IS NOT NULL; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT `id`, `type_id`, `last_known_state`, `name`, "
-                 "          `create_time_since_epoch`, "
-                 "          `last_update_time_since_epoch` "
-                 "   FROM `Execution` "
-                 "   WHERE `id` = 1 AND `type_id` = 3 AND "
-                 "         `create_time_since_epoch` = 0 AND "
-                 "         `last_update_time_since_epoch` = 0 "
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'EventPath' AND "
+                 "       `index_name` = 'idx_eventpath_event_id'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT `id`, `type_id`, `name`, "
-                 "          `create_time_since_epoch`, "
-                 "          `last_update_time_since_epoch` "
-                 "   FROM `Context` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' AND "
-                 "         `create_time_since_epoch` = 0 AND "
-                 "         `last_update_time_since_epoch` = 0 "
-                 " ) as T1; "
+          query: " SELECT count(*) = 3 FROM `information_schema`.`columns` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` IN ('ArtifactProperty', "
+                 "           'ExecutionProperty', 'ContextProperty') AND "
+                 "       `column_name` = 'string_value' AND "
+                 "       `data_type` = 'mediumtext'; "
         }
       }
-      # downgrade queries from version 6
-      downgrade_queries { query: " DROP TABLE `ParentType`; " }
-      downgrade_queries { query: " DROP TABLE `ParentContext`; " }
+      db_verification { total_num_indexes: 45 total_num_tables: 15 }
+      # downgrade queries from version 8
       downgrade_queries {
-        query: " ALTER TABLE `Type` "
-               " DROP COLUMN `version`, "
-               " DROP COLUMN `description`; "
+        query: " ALTER TABLE `Event` "
+               " DROP INDEX UniqueEvent; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Artifact` "
-               " DROP INDEX `idx_artifact_uri`, "
-               " DROP INDEX `idx_artifact_create_time_since_epoch`, "
-               " DROP INDEX `idx_artifact_last_update_time_since_epoch`; "
+        query: " ALTER TABLE `Event` "
+               " ADD INDEX `idx_event_artifact_id` (`artifact_id`); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Event` "
-               " DROP INDEX `idx_event_artifact_id`, "
-               " DROP INDEX `idx_event_execution_id`; "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " DROP INDEX `idx_artifact_property_int`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Type` "
-               " DROP INDEX `idx_type_name`; "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " DROP INDEX `idx_artifact_property_double`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Execution` "
-               " DROP INDEX `idx_execution_create_time_since_epoch`, "
-               " DROP INDEX `idx_execution_last_update_time_since_epoch`; "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " DROP INDEX `idx_artifact_property_string`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Context` "
-               " DROP INDEX `idx_context_create_time_since_epoch`, "
-               " DROP INDEX `idx_context_last_update_time_since_epoch`; "
+        query: " ALTER TABLE `ExecutionProperty` "
+               " DROP INDEX `idx_execution_property_int`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ExecutionProperty` "
+               " DROP INDEX `idx_execution_property_double`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ExecutionProperty` "
+               " DROP INDEX `idx_execution_property_string`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               " DROP INDEX `idx_context_property_int`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               " DROP INDEX `idx_context_property_double`; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               " DROP INDEX `idx_context_property_string`; "
       }
-      # verify if the downgrading keeps the existing columns
       downgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`id`, `name`, `version`, `type_kind`, "
-                 "  `description`, `input_type`, `output_type`) "
-                 " VALUES (1, 't1', 'v1', 1, 'desc1', 'input1', 'output1'); "
+          query: " INSERT INTO `Event` "
+                 " (`id`, `artifact_id`, `execution_id`, `type`, "
+                 " `milliseconds_since_epoch`) "
+                 " VALUES (1, 1, 1, 1, 1); "
         }
         previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`id`, `name`, `version`, `type_kind`, "
-                 "  `description`, `input_type`, `output_type`) "
-                 " VALUES (2, 't2', 'v2', 2, 'desc2', 'input2', 'output2'); "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 2 FROM `Type`; "
+          query: " INSERT INTO `EventPath` "
+                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
+                 " VALUES (1, 1, 1, 'a'); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Type` "
-                 "   WHERE `id` = 1 AND `name` = 't1' AND type_kind = 1 "
-                 "   AND `input_type` = 'input1' AND `output_type` = 'output1'"
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `Event` "
+                 " WHERE `artifact_id` = 1 AND `execution_id` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ParentType'; "
+          query: " SELECT count(*) = 1 FROM `EventPath` "
+                 " WHERE `event_id` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ParentContext'; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` = 'UniqueEvent'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Artifact' AND "
-                 "       `index_name` LIKE 'idx_artifact_%'; "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` = 'idx_event_artifact_id'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
                  "       `table_name` = 'Event' AND "
-                 "       `index_name` LIKE 'idx_event_%'; "
+                 "       `index_name` = 'idx_event_execution_id'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'ParentContext' AND "
-                 "       `index_name` LIKE 'idx_parentcontext_%'; "
+                 "       `table_name` = 'EventPath' AND "
+                 "       `index_name` = 'idx_eventpath_event_id'; "
         }
         post_migration_verification_queries {
           query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Type' AND "
-                 "       `index_name` LIKE 'idx_type_%'; "
+                 "       `table_name` = 'ArtifactProperty' AND "
+                 "       `index_name` LIKE 'idx_artifact_property_%'; "
         }
         post_migration_verification_queries {
           query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Execution' AND "
-                 "       `index_name` LIKE 'idx_execution_%'; "
+                 "       `table_name` = 'ExecutionProperty' AND "
+                 "       `index_name` LIKE 'idx_execution_property_%'; "
         }
         post_migration_verification_queries {
           query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Context' AND "
-                 "       `index_name` LIKE 'idx_context_%'; "
+                 "       `table_name` = 'ContextProperty' AND "
+                 "       `index_name` LIKE 'idx_context_property_%'; "
         }
       }
     }
   }
 )pb",
 R"pb(
-  # In v6, to support parental type and parental context, we added two
-  # tables `ParentType` and `ParentContext`. In addition, we added `version`
-  # and `description` in the `Type` table for improving type registrations.
-  # We introduce indices on Type.name, Artifact.uri, Event's artifact_id and
-  # execution_id, and create_time_since_epoch, last_update_time_since_epoch
-  # for all nodes.
+  # In v8, we added index for `ArtifactProperty`, `ExecutionProperty`,
+  # `ContextProperty` to improve property queries on name.
   migration_schemes {
-    key: 6
+    key: 8
     value: {
       upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `ParentType` ( "
-               "   `type_id` INT NOT NULL, "
-               "   `parent_type_id` INT NOT NULL, "
-               " PRIMARY KEY (`type_id`, `parent_type_id`)); "
+        query: " ALTER TABLE `ArtifactProperty` "
+               "  ADD INDEX `idx_artifact_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ArtifactProperty` "
+               "  ADD INDEX `idx_artifact_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ArtifactProperty` "
+               "  ADD INDEX `idx_artifact_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ExecutionProperty` "
+               "  ADD INDEX `idx_execution_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`); "
       }
       upgrade_queries {
-        query: " CREATE TABLE IF NOT EXISTS `ParentContext` ( "
-               "   `context_id` INT NOT NULL, "
-               "   `parent_context_id` INT NOT NULL, "
-               " PRIMARY KEY (`context_id`, `parent_context_id`)); "
+        query: " ALTER TABLE `ExecutionProperty` "
+               "  ADD INDEX `idx_execution_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Type` ADD ( "
-               "   `version` VARCHAR(255), "
-               "   `description` TEXT "
-               " ); "
+        query: " ALTER TABLE `ExecutionProperty` "
+               "  ADD INDEX `idx_execution_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Artifact` "
-               " ADD INDEX `idx_artifact_uri`(`uri`(255)), "
-               "  ADD INDEX `idx_artifact_create_time_since_epoch` "
-               "             (`create_time_since_epoch`), "
-               "  ADD INDEX `idx_artifact_last_update_time_since_epoch` "
-               "             (`last_update_time_since_epoch`); "
+        query: " ALTER TABLE `ContextProperty` "
+               "  ADD INDEX `idx_context_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Event` "
-               " ADD INDEX `idx_event_artifact_id` (`artifact_id`), "
-               " ADD INDEX `idx_event_execution_id` (`execution_id`); "
+        query: " ALTER TABLE `ContextProperty` "
+               "  ADD INDEX `idx_context_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `ParentContext` "
-               " ADD INDEX "
-               "  `idx_parentcontext_parent_context_id` (`parent_context_id`);"
+        query: " ALTER TABLE `ContextProperty` "
+               "  ADD INDEX `idx_context_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Type` "
-               " ADD INDEX `idx_type_name` (`name`);"
+        query: " CREATE TABLE `EventTemp` ( "
+               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+               "   `artifact_id` INT NOT NULL, "
+               "   `execution_id` INT NOT NULL, "
+               "   `type` INT NOT NULL, "
+               "   `milliseconds_since_epoch` BIGINT, "
+               "   CONSTRAINT UniqueEvent UNIQUE(`artifact_id`, `execution_id`, `type`) "
+               " ); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Execution` "
-               "  ADD INDEX `idx_execution_create_time_since_epoch` "
-               "             (`create_time_since_epoch`), "
-               "  ADD INDEX `idx_execution_last_update_time_since_epoch` "
-               "             (`last_update_time_since_epoch`); "
+        query: " INSERT IGNORE INTO `EventTemp` "
+               " (`id`, `artifact_id`, `execution_id`, `type`, "
+               " `milliseconds_since_epoch`) "
+               " SELECT * FROM `Event` ORDER BY `id` desc; "
       }
+      upgrade_queries { query: " DROP TABLE `Event`; " }
       upgrade_queries {
-        query: " ALTER TABLE `Context` "
-               "  ADD INDEX `idx_context_create_time_since_epoch` "
-               "             (`create_time_since_epoch`), "
-               "  ADD INDEX `idx_context_last_update_time_since_epoch` "
-               "             (`last_update_time_since_epoch`); "
+        query: " ALTER TABLE `EventTemp` RENAME TO `Event`, "
+               " ADD INDEX `idx_event_execution_id` (`execution_id`) ; "
       }
-      # check the expected table columns are created properly.
+      upgrade_queries {
+        query: " DELETE FROM `EventPath` "
+               "   WHERE event_id not in ( SELECT `id` from Event ) "
+      }
+      # check the expected indexes are created properly.
       upgrade_verification {
-        # check existing rows in previous Type table are migrated properly.
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type` WHERE "
-                 " `id` = 1 AND `type_kind` = 1 AND `name` = 'artifact_type'; "
+        previous_version_setup_queries { query: "DELETE FROM `Event`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Event` "
+                 " (`id`, `artifact_id`, `execution_id`, `type`, "
+                 " `milliseconds_since_epoch`) "
+                 " VALUES (1, 1, 1, 1, 1); "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type` WHERE "
-                 " `id` = 2 AND `type_kind` = 0 AND `name` = 'execution_type' "
-                 " AND `input_type` = 'input' AND `output_type` = 'output'; "
+        previous_version_setup_queries {
+          query: " INSERT INTO `Event` "
+                 " (`id`, `artifact_id`, `execution_id`, `type`, "
+                 " `milliseconds_since_epoch`) "
+                 " VALUES (2, 1, 1, 1, 2); "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `type_id`, `parent_type_id` "
-                 "   FROM `ParentType` "
-                 " ) as T1; "
+        previous_version_setup_queries { query: "DELETE FROM `EventPath`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `EventPath` "
+                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
+                 " VALUES (1, 1, 1, 'a'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `EventPath` "
+                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
+                 " VALUES (2, 1, 1, 'b'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `EventPath` "
+                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
+                 " VALUES (2, 1, 2, 'c'); "
         }
+        # check event table unique constraint is applied and event path
+        # records are deleted.
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM ( "
-                 "   SELECT `context_id`, `parent_context_id` "
-                 "   FROM `ParentContext` "
-                 " ) as T1; "
+          query: " SELECT count(*) = 1 FROM `Event` "
+                 " WHERE `artifact_id` = 1 AND `execution_id` = 1 "
+                 "     AND `type` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Artifact' AND "
-                 "       `index_name` = 'idx_artifact_uri'; "
+          query: " SELECT count(*) = 1 FROM `Event` "
+                 "   WHERE `id` = 2 AND `artifact_id` = 1 AND  "
+                 "       `execution_id` = 1 AND `type` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Artifact' AND "
-                 "       `index_name` = 'idx_artifact_create_time_since_epoch';"
+          query: " SELECT count(*) = 2 FROM `EventPath` "
+                 " WHERE `event_id` = 2; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Artifact' AND `index_name` = "
-                 "       'idx_artifact_last_update_time_since_epoch';"
+          query: " SELECT count(*) = 1 FROM `EventPath` "
+                 " WHERE `event_id` = 2 AND `step_key` = 'b'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'idx_event_artifact_id'; "
+          query: " SELECT count(*) = 1 FROM `EventPath` "
+                 " WHERE `event_id` = 2 AND `step_key` = 'c'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'idx_event_execution_id'; "
+          query: " SELECT count(*) = 0 FROM `EventPath` "
+                 " WHERE `event_id` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 3 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ParentContext' AND "
-                 "       `index_name` = 'idx_parentcontext_parent_context_id'; "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` = 'UniqueEvent'; "
         }
         post_migration_verification_queries {
           query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Type' AND "
-                 "       `index_name` = 'idx_type_name'; "
+                 "       `table_name` = 'Event' AND "
+                 "       `index_name` LIKE 'idx_event_execution_%'; "
         }
         post_migration_verification_queries {
           query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Execution' AND `index_name` = "
-                 "       'idx_execution_create_time_since_epoch'; "
+                 "       `table_name` = 'EventPath' AND "
+                 "       `index_name` LIKE 'idx_eventpath_event_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Execution' AND `index_name` = "
-                 "       'idx_execution_last_update_time_since_epoch'; "
+                 "       `table_name` = 'ArtifactProperty' AND "
+                 "       `index_name` LIKE 'idx_artifact_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Context' AND "
-                 "       `index_name` = 'idx_context_create_time_since_epoch'; "
+                 "       `table_name` = 'ExecutionProperty' AND "
+                 "       `index_name` LIKE 'idx_execution_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
                  " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Context' AND `index_name` = "
-                 "       'idx_context_last_update_time_since_epoch'; "
+                 "       `table_name` = 'ContextProperty' AND "
+                 "       `index_name` LIKE 'idx_context_property_%'; "
         }
       }
-      # downgrade queries from version 7
-      # Note v7 for MySQL used mediumtext for string_value, when downgrade
-      # the long text will be truncated to 65536 chars.
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` DROP COLUMN `byte_value`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` DROP COLUMN `byte_value`; "
-      }
+      db_verification { total_num_indexes: 74 total_num_tables: 15 }
+      # downgrade queries from version 9
       downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` DROP COLUMN `byte_value`; "
+        query: " ALTER TABLE `Type` DROP INDEX `idx_type_external_id`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `EventPath` DROP INDEX `idx_eventpath_event_id`; "
+        query: " ALTER TABLE `Artifact` DROP INDEX `idx_artifact_external_id`; "
       }
       downgrade_queries {
-        query: " UPDATE `ArtifactProperty` "
-               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
+        query: " ALTER TABLE `Execution` DROP INDEX `idx_execution_external_id`;"
       }
       downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " MODIFY COLUMN `string_value` TEXT; "
+        query: " ALTER TABLE `Context` DROP INDEX `idx_context_external_id`; "
       }
       downgrade_queries {
-        query: " UPDATE `ExecutionProperty` "
-               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
+        query: " ALTER TABLE `Type` DROP COLUMN `external_id`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " MODIFY COLUMN `string_value` TEXT; "
+        query: " ALTER TABLE `Artifact` DROP COLUMN `external_id`; "
       }
       downgrade_queries {
-        query: " UPDATE `ContextProperty` "
-               " SET `string_value` = SUBSTRING(`string_value`, 1, 65535); "
+        query: " ALTER TABLE `Execution` DROP COLUMN `external_id`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " MODIFY COLUMN `string_value` TEXT; "
+        query: " ALTER TABLE `Context` DROP COLUMN `external_id`; "
       }
       # verify if the downgrading keeps the existing columns
       downgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Type`; " }
         previous_version_setup_queries {
-          query: "DELETE FROM `ArtifactProperty`;"
-        }
-        previous_version_setup_queries {
-          query: "DELETE FROM `ExecutionProperty`;"
-        }
-        previous_version_setup_queries {
-          query: "DELETE FROM `ContextProperty`;"
+          query: " INSERT INTO `Type` "
+                 " (`id`, `name`, `type_kind`, "
+                 "  `description`, `input_type`, `output_type`, `external_id`) "
+                 " VALUES (1, 't1', 1, 'desc1', 'input1', 'output1', "
+                 "         'type_1'); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `ArtifactProperty` "
-                 " (`artifact_id`, `name`, `string_value`) "
-                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('a', 160000))), "
-                 "        (1, 'p2', 'abc'); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `type_id`, `uri`, `state`, `name`, `external_id`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 'uri1', 1, NULL, 'artifact_1', 0, 1); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `ExecutionProperty` "
-                 " (`execution_id`, `name`, `string_value`) "
-                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('e', 160000))), "
-                 "        (1, 'p2', 'abc'); "
+          query: " INSERT INTO `Execution` "
+                 " (`id`, `type_id`, `last_known_state`, `name`, `external_id`,"
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 1, NULL, 'execution_1', 0, 1); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `ContextProperty` "
-                 " (`context_id`, `name`, `string_value`) "
-                 " VALUES (1, 'p1', CONCAT('_prefix_', REPEAT('c', 160000))), "
-                 "        (1, 'p2', 'abc'); "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'EventPath' AND "
-                 "       `index_name` = 'idx_eventpath_event_id'; "
+          query: " INSERT INTO `Context` "
+                 " (`id`, `type_id`, `name`, `external_id`, "
+                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
+                 " VALUES (1, 2, 'name1', 'context_1', 1, 0); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 3 FROM `information_schema`.`columns` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` IN ('ArtifactProperty', "
-                 "           'ExecutionProperty', 'ContextProperty') AND "
-                 "       `column_name` = 'string_value' AND "
-                 "       `data_type` = 'text'; "
+          query: " SELECT count(*) = 1 FROM `Type`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`columns` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` IN ('ArtifactProperty', "
-                 "           'ExecutionProperty', 'ContextProperty') AND "
-                 "       `column_name` = 'byte_value'; "
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Type` "
+                 "   WHERE `id` = 1 AND `name` = 't1' AND type_kind = 1 AND "
+                 "         `input_type` = 'input1' AND "
+                 "         `output_type` = 'output1') AS T1;  "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
-                 " WHERE `artifact_id` = 1 AND `name` = 'p1' AND "
-                 "   `string_value` = CONCAT('_prefix_', REPEAT('a', 65527)); "
+          query: " SELECT COUNT(*) = 1 FROM `Artifact`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
-                 " WHERE `artifact_id` = 1 AND `name` = 'p2' AND "
-                 "       `string_value` = 'abc'; "
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Artifact` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND `uri` = 'uri1' AND "
+                 "         `state` = 1 "
+                 " ) AS T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
-                 " WHERE `execution_id` = 1 AND `name` = 'p1' AND "
-                 "   `string_value` = CONCAT('_prefix_', REPEAT('e', 65527)); "
+          query: " SELECT COUNT(*) = 1 FROM `Execution`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
-                 " WHERE `execution_id` = 1 AND `name` = 'p2' AND "
-                 "       `string_value` = 'abc'; "
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Execution` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 "
+                 " ) AS T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ContextProperty` "
-                 " WHERE `context_id` = 1 AND `name` = 'p1' AND "
-                 "   `string_value` = CONCAT('_prefix_', REPEAT('c', 65527)); "
+          query: " SELECT COUNT(*) = 1 FROM `Context`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `ContextProperty` "
-                 " WHERE `context_id` = 1 AND `name` = 'p2' AND "
-                 "       `string_value` = 'abc'; "
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Context` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' "
+                 " ) as T1; "
         }
       }
     }
   }
 )pb",
 R"pb(
-  # In v7, we added byte_value for property tables for better storing binary
-  # property values. For MySQL, we extends string_value column to be
-  # MEDIUMTEXT in order to persist string value with size upto 16MB. In
-  # addition, we added index for `EventPath` to improve Event reads.
+  # In v9, to store the ids that come from the clients' system (like Vertex
+  # Metadata), we added a new column `external_id` in the `Type`,
+  # `Artifact`, `Execution`, `Context` tables. We introduce unique and
+  # null-filtered indices on Type.external_id, Artifact.external_id,
+  # Execution's external_id and Context's external_id.
   migration_schemes {
-    key: 7
+    key: 9
     value: {
       upgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
-               " ADD COLUMN `byte_value` MEDIUMBLOB; "
+        query: " ALTER TABLE `Type` ADD ( "
+               "   `external_id` VARCHAR(255) "
+               " ), "
+               " ADD CONSTRAINT UniqueTypeExternalId "
+               " UNIQUE(`external_id`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
-               " ADD COLUMN `byte_value` MEDIUMBLOB; "
+        query: " ALTER TABLE `Artifact` ADD ( "
+               "   `external_id` VARCHAR(255) "
+               " ), "
+               " ADD CONSTRAINT UniqueArtifactExternalId "
+               " UNIQUE(`external_id`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " MODIFY COLUMN `string_value` MEDIUMTEXT, "
-               " ADD COLUMN `byte_value` MEDIUMBLOB; "
+        query: " ALTER TABLE `Execution` ADD ( "
+               "   `external_id` VARCHAR(255) "
+               " ), "
+               " ADD CONSTRAINT UniqueExecutionExternalId "
+               " UNIQUE(`external_id`); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `EventPath` "
-               " ADD INDEX `idx_eventpath_event_id` (`event_id`); "
-      }
-      # check the expected table columns are created properly.
-      upgrade_verification {
-        # check existing rows in previous Type table are migrated properly.
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
-                 " `byte_value` IS NOT NULL; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
-                 " `byte_value` IS NOT NULL; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
-                 " `byte_value` IS NOT NULL; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'EventPath' AND "
-                 "       `index_name` = 'idx_eventpath_event_id'; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 3 FROM `information_schema`.`columns` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` IN ('ArtifactProperty', "
-                 "           'ExecutionProperty', 'ContextProperty') AND "
-                 "       `column_name` = 'string_value' AND "
-                 "       `data_type` = 'mediumtext'; "
-        }
-      }
-      db_verification { total_num_indexes: 45 total_num_tables: 15 }
-      # downgrade queries from version 8
-      downgrade_queries {
-        query: " ALTER TABLE `Event` "
-               " DROP INDEX UniqueEvent; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `Event` "
-               " ADD INDEX `idx_event_artifact_id` (`artifact_id`); "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " DROP INDEX `idx_artifact_property_int`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " DROP INDEX `idx_artifact_property_double`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " DROP INDEX `idx_artifact_property_string`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " DROP INDEX `idx_execution_property_int`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " DROP INDEX `idx_execution_property_double`; "
+        query: " ALTER TABLE `Context` ADD ( "
+               "   `external_id` VARCHAR(255) "
+               " ), "
+               " ADD CONSTRAINT UniqueContextExternalId "
+               " UNIQUE(`external_id`); "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " DROP INDEX `idx_execution_property_string`; "
+      upgrade_queries {
+        query: " ALTER TABLE `Type` "
+               " ADD INDEX `idx_type_external_id` (`external_id`); "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " DROP INDEX `idx_context_property_int`; "
+      upgrade_queries {
+        query: " ALTER TABLE `Artifact` "
+               " ADD INDEX `idx_artifact_external_id` (`external_id`); "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " DROP INDEX `idx_context_property_double`; "
+      upgrade_queries {
+        query: " ALTER TABLE `Execution` "
+               " ADD INDEX `idx_execution_external_id` (`external_id`); "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " DROP INDEX `idx_context_property_string`; "
+      upgrade_queries {
+        query: " ALTER TABLE `Context` "
+               " ADD INDEX `idx_context_external_id` (`external_id`); "
       }
-      downgrade_verification {
+      # check the expected table columns are created properly.
+      upgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Event` "
-                 " (`id`, `artifact_id`, `execution_id`, `type`, "
-                 " `milliseconds_since_epoch`) "
-                 " VALUES (1, 1, 1, 1, 1); "
+          query: " INSERT INTO `Type` "
+                 " (`id`, `name`) "
+                 " VALUES (1, 't1'); "
         }
+        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `EventPath` "
-                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
-                 " VALUES (1, 1, 1, 'a'); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `type_id`) "
+                 " VALUES (1, 2); "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Event` "
-                 " WHERE `artifact_id` = 1 AND `execution_id` = 1; "
+        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Execution` "
+                 " (`id`, `type_id`) "
+                 " VALUES (1, 2); "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `EventPath` "
-                 " WHERE `event_id` = 1; "
+        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Context` "
+                 " (`id`, `type_id`, `name`) "
+                 " VALUES (1, 2, 'name1'); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'UniqueEvent'; "
+          query: " SELECT count(*) = 1 FROM `Type`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'idx_event_artifact_id'; "
+          query: " SELECT count(*) = 1 FROM ( "
+                 "   SELECT * FROM `Type` "
+                 "   WHERE `id` = 1 AND `name` = 't1' AND "
+                 "         `external_id` IS NULL "
+                 " ) as T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'idx_event_execution_id'; "
+          query: " SELECT COUNT(*) = 1 FROM `Artifact`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'EventPath' AND "
-                 "       `index_name` = 'idx_eventpath_event_id'; "
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Artifact` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND "
+                 "         `external_id` IS NULL "
+                 " ) AS T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'ArtifactProperty' AND "
-                 "       `index_name` LIKE 'idx_artifact_property_%'; "
+          query: " SELECT COUNT(*) = 1 FROM `Execution`; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'ExecutionProperty' AND "
-                 "       `index_name` LIKE 'idx_execution_property_%'; "
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Execution` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND "
+                 "         `external_id` IS NULL "
+                 " ) AS T1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) AND "
-                 "       `table_name` = 'ContextProperty' AND "
-                 "       `index_name` LIKE 'idx_context_property_%'; "
+          query: " SELECT COUNT(*) = 1 FROM `Context`; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT COUNT(*) = 1 FROM ( "
+                 "   SELECT * FROM `Context` "
+                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' AND "
+                 "         `external_id` IS NULL "
+                 " ) as T1; "
         }
       }
-    }
-  }
-)pb",
-R"pb(
-  # In v8, we added index for `ArtifactProperty`, `ExecutionProperty`,
-  # `ContextProperty` to improve property queries on name.
-  migration_schemes {
-    key: 8
-    value: {
-      upgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               "  ADD INDEX `idx_artifact_property_int`( "
-               "    `name`, `is_custom_property`, `int_value`); "
-      }
-      upgrade_queries {
+      db_verification { total_num_indexes: 82 total_num_tables: 15 }
+      # downgrade queries from version 10
+      downgrade_queries {
         query: " ALTER TABLE `ArtifactProperty` "
-               "  ADD INDEX `idx_artifact_property_double`( "
-               "    `name`, `is_custom_property`, `double_value`); "
+               " DROP COLUMN `proto_value`; "
       }
-      upgrade_queries {
+      downgrade_queries {
         query: " ALTER TABLE `ArtifactProperty` "
-               "  ADD INDEX `idx_artifact_property_string`( "
-               "    `name`, `is_custom_property`, `string_value`(255)); "
-      }
-      upgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               "  ADD INDEX `idx_execution_property_int`( "
-               "    `name`, `is_custom_property`, `int_value`); "
+               " DROP COLUMN `bool_value`; "
       }
-      upgrade_queries {
+      downgrade_queries {
         query: " ALTER TABLE `ExecutionProperty` "
-               "  ADD INDEX `idx_execution_property_double`( "
-               "    `name`, `is_custom_property`, `double_value`); "
+               " DROP COLUMN `proto_value`; "
       }
-      upgrade_queries {
+      downgrade_queries {
         query: " ALTER TABLE `ExecutionProperty` "
-               "  ADD INDEX `idx_execution_property_string`( "
-               "    `name`, `is_custom_property`, `string_value`(255)); "
-      }
-      upgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               "  ADD INDEX `idx_context_property_int`( "
-               "    `name`, `is_custom_property`, `int_value`); "
+               " DROP COLUMN `bool_value`; "
       }
-      upgrade_queries {
+      downgrade_queries {
         query: " ALTER TABLE `ContextProperty` "
-               "  ADD INDEX `idx_context_property_double`( "
-               "    `name`, `is_custom_property`, `double_value`); "
+               " DROP COLUMN `proto_value`; "
       }
-      upgrade_queries {
+      downgrade_queries {
         query: " ALTER TABLE `ContextProperty` "
-               "  ADD INDEX `idx_context_property_string`( "
-               "    `name`, `is_custom_property`, `string_value`(255)); "
-      }
-      upgrade_queries {
-        query: " CREATE TABLE `EventTemp` ( "
-               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
-               "   `artifact_id` INT NOT NULL, "
-               "   `execution_id` INT NOT NULL, "
-               "   `type` INT NOT NULL, "
-               "   `milliseconds_since_epoch` BIGINT, "
-               "   CONSTRAINT UniqueEvent UNIQUE(`artifact_id`, `execution_id`, `type`) "
-               " ); "
-      }
-      upgrade_queries {
-        query: " INSERT IGNORE INTO `EventTemp` "
-               " (`id`, `artifact_id`, `execution_id`, `type`, "
-               " `milliseconds_since_epoch`) "
-               " SELECT * FROM `Event` ORDER BY `id` desc; "
-      }
-      upgrade_queries { query: " DROP TABLE `Event`; " }
-      upgrade_queries {
-        query: " ALTER TABLE `EventTemp` RENAME TO `Event`, "
-               " ADD INDEX `idx_event_execution_id` (`execution_id`) ; "
-      }
-      upgrade_queries {
-        query: " DELETE FROM `EventPath` "
-               "   WHERE event_id not in ( SELECT `id` from Event ) "
+               " DROP COLUMN `bool_value`; "
       }
-      # check the expected indexes are created properly.
-      upgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Event`;" }
+      downgrade_verification {
         previous_version_setup_queries {
-          query: " INSERT INTO `Event` "
-                 " (`id`, `artifact_id`, `execution_id`, `type`, "
-                 " `milliseconds_since_epoch`) "
-                 " VALUES (1, 1, 1, 1, 1); "
+          query: " INSERT INTO `Artifact` "
+                 " (`id`, `name`) "
+                 " VALUES (1, 'artifact-name'); "
         }
         previous_version_setup_queries {
-          query: " INSERT INTO `Event` "
-                 " (`id`, `artifact_id`, `execution_id`, `type`, "
-                 " `milliseconds_since_epoch`) "
-                 " VALUES (2, 1, 1, 1, 2); "
+          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
+                 "     `name`, `is_custom_property`, `string_value`) "
+                 " VALUES (1, 'p-0', false, 'string_property_value'); "
         }
-        previous_version_setup_queries { query: "DELETE FROM `EventPath`;" }
+
         previous_version_setup_queries {
-          query: " INSERT INTO `EventPath` "
-                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
-                 " VALUES (1, 1, 1, 'a'); "
+          query: " INSERT INTO `Execution` "
+                 " (`id`, `name`) "
+                 " VALUES (1, 'execution-name'); "
         }
         previous_version_setup_queries {
-          query: " INSERT INTO `EventPath` "
-                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
-                 " VALUES (2, 1, 1, 'b'); "
+          query: " INSERT INTO `ExecutionProperty` (`execution_id`, "
+                 "     `name`, `is_custom_property`, `string_value`) "
+                 " VALUES (1, 'p-0', false, 'string_property_value'); "
         }
+
         previous_version_setup_queries {
-          query: " INSERT INTO `EventPath` "
-                 " (`event_id`, `is_index_step`, `step_index`, `step_key`) "
-                 " VALUES (2, 1, 2, 'c'); "
-        }
-        # check event table unique constraint is applied and event path
-        # records are deleted.
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Event` "
-                 " WHERE `artifact_id` = 1 AND `execution_id` = 1 "
-                 "     AND `type` = 1; "
+          query: " INSERT INTO `Context` "
+                 " (`id`, `name`) "
+                 " VALUES (1, 'context-name'); "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Event` "
-                 "   WHERE `id` = 2 AND `artifact_id` = 1 AND  "
-                 "       `execution_id` = 1 AND `type` = 1; "
+        previous_version_setup_queries {
+          query: " INSERT INTO `ContextProperty` (`context_id`, "
+                 "     `name`, `is_custom_property`, `string_value`) "
+                 " VALUES (1, 'p-0', false, 'string_property_value'); "
         }
+
         post_migration_verification_queries {
-          query: " SELECT count(*) = 2 FROM `EventPath` "
-                 " WHERE `event_id` = 2; "
+          query: " SELECT COUNT(*) = 1 "
+                 " FROM ArtifactProperty AS AP "
+                 " WHERE AP.artifact_id = 1 "
+                 "   AND AP.name = 'p-0' "
+                 "   AND AP.is_custom_property = false "
+                 "   AND AP.string_value = 'string_property_value'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `EventPath` "
-                 " WHERE `event_id` = 2 AND `step_key` = 'b'; "
+          query: " SELECT COUNT(*) = 1 "
+                 " FROM ExecutionProperty AS EP "
+                 " WHERE EP.execution_id = 1 "
+                 "   AND EP.name = 'p-0' "
+                 "   AND EP.is_custom_property = false "
+                 "   AND EP.string_value = 'string_property_value'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `EventPath` "
-                 " WHERE `event_id` = 2 AND `step_key` = 'c'; "
+          query: " SELECT COUNT(*) = 1 "
+                 " FROM ContextProperty AS CP "
+                 " WHERE CP.context_id = 1 "
+                 "   AND CP.name = 'p-0' "
+                 "   AND CP.is_custom_property = false "
+                 "   AND CP.string_value = 'string_property_value'; "
         }
+      }
+    }
+  }
+)pb",
+R"pb(
+  # In v10, we added proto_value and bool_value for property tables.
+  migration_schemes {
+    key: 10
+    value: {
+      upgrade_queries {
+        query: " ALTER TABLE `ArtifactProperty` "
+               " ADD COLUMN `proto_value` MEDIUMBLOB, "
+               " ADD COLUMN `bool_value` BOOLEAN; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ExecutionProperty` "
+               " ADD COLUMN `proto_value` MEDIUMBLOB, "
+               " ADD COLUMN `bool_value` BOOLEAN; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               " ADD COLUMN `proto_value` MEDIUMBLOB, "
+               " ADD COLUMN `bool_value` BOOLEAN; "
+      }
+      # check the expected table columns are created properly.
+      upgrade_verification {
+        # check existing rows in previous Type table are migrated properly.
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `EventPath` "
-                 " WHERE `event_id` = 1; "
+          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
+                 " `proto_value` IS NOT NULL; "
+        } post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
+                 " `bool_value` IS NOT NULL; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 3 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` = 'UniqueEvent'; "
+          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
+                 " `proto_value` IS NOT NULL; "
+        } post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
+                 " `bool_value` IS NOT NULL; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'Event' AND "
-                 "       `index_name` LIKE 'idx_event_execution_%'; "
+          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
+                 " `proto_value` IS NOT NULL; "
+        } post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
+                 " `bool_value` IS NOT NULL; "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'EventPath' AND "
-                 "       `index_name` LIKE 'idx_eventpath_event_%'; "
+      }
+      downgrade_queries {
+        query: " DROP TABLE IF EXISTS `TypeCatalog`; "
+      }
+      db_verification { total_num_indexes: 82 total_num_tables: 15 }
+    }
+  }
+  # In v11, we added the TypeCatalog table to version the types.
+  migration_schemes {
+    key: 11
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `TypeCatalog` ( "
+               "   `type_id` INTEGER PRIMARY KEY, "
+               "   `catalog_version` BIGINT NOT NULL "
+               " ); "
+      }
+      # The existing types are in the first version of the catalog.
+      upgrade_queries {
+        query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+               " SELECT `id`, 1 FROM `Type`; "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `TypeCatalog`(`type_id`, `catalog_version`) "
+               " VALUES(0, 1); "
+      }
+      upgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Type` (`id`, `name`, `type_kind`) "
+                 " VALUES (1, 'artifact_type', 1), (2, 'execution_type', 0); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ArtifactProperty' AND "
-                 "       `index_name` LIKE 'idx_artifact_property_%'; "
+          query: " SELECT count(*) = 1 FROM `TypeCatalog` "
+                 " WHERE `type_id` = 0 AND `catalog_version` = 1; "
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ExecutionProperty' AND "
-                 "       `index_name` LIKE 'idx_execution_property_%'; "
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM `TypeCatalog` "
+                 " WHERE `type_id` IN (1, 2) AND `catalog_version` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
-                 " WHERE `table_schema` = (SELECT DATABASE()) and "
-                 "       `table_name` = 'ContextProperty' AND "
-                 "       `index_name` LIKE 'idx_context_property_%'; "
+          query: " SELECT count(*) = (SELECT count(*) FROM `Type`) "
+                 " FROM `TypeCatalog` "
+                 " WHERE `type_id` <> 0 AND `catalog_version` = 1; "
         }
       }
-      db_verification { total_num_indexes: 74 total_num_tables: 15 }
-      # downgrade queries from version 9
+      # downgrade queries from version 12
       downgrade_queries {
-        query: " ALTER TABLE `Type` DROP INDEX `idx_type_external_id`; "
+        query: " ALTER TABLE `ArtifactProperty` "
+               " ADD COLUMN `name` VARCHAR(255); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Artifact` DROP INDEX `idx_artifact_external_id`; "
+        query: " UPDATE `ArtifactProperty` AS AP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = AP.`name_id`) "
+               " SET AP.`name` = PN.`name`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Execution` DROP INDEX `idx_execution_external_id`;"
+        query: " ALTER TABLE `ArtifactProperty` "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_artifact_property_int`, "
+               "  DROP INDEX `idx_artifact_property_double`, "
+               "  DROP INDEX `idx_artifact_property_string`, "
+               "  DROP COLUMN `name_id`, "
+               "  MODIFY `name` VARCHAR(255) NOT NULL, "
+               "  ADD PRIMARY KEY (`artifact_id`, `name`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_artifact_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_artifact_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_artifact_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Context` DROP INDEX `idx_context_external_id`; "
+        query: " ALTER TABLE `ExecutionProperty` "
+               " ADD COLUMN `name` VARCHAR(255); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Type` DROP COLUMN `external_id`; "
+        query: " UPDATE `ExecutionProperty` AS EP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = EP.`name_id`) "
+               " SET EP.`name` = PN.`name`; "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Artifact` DROP COLUMN `external_id`; "
+        query: " ALTER TABLE `ExecutionProperty` "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_execution_property_int`, "
+               "  DROP INDEX `idx_execution_property_double`, "
+               "  DROP INDEX `idx_execution_property_string`, "
+               "  DROP COLUMN `name_id`, "
+               "  MODIFY `name` VARCHAR(255) NOT NULL, "
+               "  ADD PRIMARY KEY (`execution_id`, `name`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_execution_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_execution_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_execution_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Execution` DROP COLUMN `external_id`; "
+        query: " ALTER TABLE `ContextProperty` ADD COLUMN `name` VARCHAR(255); "
       }
       downgrade_queries {
-        query: " ALTER TABLE `Context` DROP COLUMN `external_id`; "
+        query: " UPDATE `ContextProperty` AS CP "
+               " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`) "
+               " SET CP.`name` = PN.`name`; "
       }
-      # verify if the downgrading keeps the existing columns
+      downgrade_queries {
+        query: " ALTER TABLE `ContextProperty` "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_context_property_int`, "
+               "  DROP INDEX `idx_context_property_double`, "
+               "  DROP INDEX `idx_context_property_string`, "
+               "  DROP COLUMN `name_id`, "
+               "  MODIFY `name` VARCHAR(255) NOT NULL, "
+               "  ADD PRIMARY KEY (`context_id`, `name`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_context_property_int`( "
+               "    `name`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_context_property_double`( "
+               "    `name`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_context_property_string`( "
+               "    `name`, `is_custom_property`, `string_value`(255)); "
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `PropertyName`; " }
       downgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Type`; " }
         previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`id`, `name`, `type_kind`, "
-                 "  `description`, `input_type`, `output_type`, `external_id`) "
-                 " VALUES (1, 't1', 1, 'desc1', 'input1', 'output1', "
-                 "         'type_1'); "
+          query: "DELETE FROM `ArtifactProperty`;"
         }
-        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `type_id`, `uri`, `state`, `name`, `external_id`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 'uri1', 1, NULL, 'artifact_1', 0, 1); "
+          query: "DELETE FROM `ExecutionProperty`;"
         }
-        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Execution` "
-                 " (`id`, `type_id`, `last_known_state`, `name`, `external_id`,"
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 1, NULL, 'execution_1', 0, 1); "
+          query: "DELETE FROM `ContextProperty`;"
         }
-        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
         previous_version_setup_queries {
-          query: " INSERT INTO `Context` "
-                 " (`id`, `type_id`, `name`, `external_id`, "
-                 "  `create_time_since_epoch`, `last_update_time_since_epoch`) "
-                 " VALUES (1, 2, 'name1', 'context_1', 1, 0); "
+          query: "DELETE FROM `PropertyName`;"
         }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type`; "
+        previous_version_setup_queries {
+          query: " INSERT INTO `PropertyName` (`id`, `name`) "
+                 " VALUES (1, 'p1'), (2, 'p2'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
+                 "     `is_custom_property`, `name_id`, `string_value`) "
+                 " VALUES (1, 0, 1, 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ExecutionProperty` (`execution_id`, "
+                 "     `is_custom_property`, `name_id`, `int_value`) "
+                 " VALUES (1, 1, 1, 1); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `ContextProperty` (`context_id`, "
+                 "     `is_custom_property`, `name_id`, `double_value`) "
+                 " VALUES (1, 0, 2, 1.0); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Type` "
-                 "   WHERE `id` = 1 AND `name` = 't1' AND type_kind = 1 AND "
-                 "         `input_type` = 'input1' AND "
-                 "         `output_type` = 'output1') AS T1;  "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'PropertyName'; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Artifact`; "
+          query: " SELECT count(*) = 1 FROM `ArtifactProperty` "
+                 " WHERE `artifact_id` = 1 AND `is_custom_property` = 0 AND "
+                 "       `name` = 'p1' AND `string_value` = 'abc'; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Artifact` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND `uri` = 'uri1' AND "
-                 "         `state` = 1 "
-                 " ) AS T1; "
+          query: " SELECT count(*) = 1 FROM `ExecutionProperty` "
+                 " WHERE `execution_id` = 1 AND `is_custom_property` = 1 AND "
+                 "       `name` = 'p1' AND `int_value` = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Execution`; "
+          query: " SELECT count(*) = 1 FROM `ContextProperty` "
+                 " WHERE `context_id` = 1 AND `is_custom_property` = 0 AND "
+                 "       `name` = 'p2' AND `double_value` = 1.0; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Execution` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 "
-                 " ) AS T1; "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ArtifactProperty' AND "
+                 "       `index_name` LIKE 'idx_artifact_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Context`; "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ExecutionProperty' AND "
+                 "       `index_name` LIKE 'idx_execution_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Context` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' "
-                 " ) as T1; "
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ContextProperty' AND "
+                 "       `index_name` LIKE 'idx_context_property_%'; "
         }
       }
+      db_verification { total_num_indexes: 83 total_num_tables: 16 }
     }
   }
 )pb",
 R"pb(
-  # In v9, to store the ids that come from the clients' system (like Vertex
-  # Metadata), we added a new column `external_id` in the `Type`,
-  # `Artifact`, `Execution`, `Context` tables. We introduce unique and
-  # null-filtered indices on Type.external_id, Artifact.external_id,
-  # Execution's external_id and Context's external_id.
+  # In v12, we interned the property names into the PropertyName table, which
+  # the {X}Property tables and their indices refer to by id.
   migration_schemes {
-    key: 9
+    key: 12
     value: {
       upgrade_queries {
-        query: " ALTER TABLE `Type` ADD ( "
-               "   `external_id` VARCHAR(255) "
-               " ), "
-               " ADD CONSTRAINT UniqueTypeExternalId "
-               " UNIQUE(`external_id`); "
+        query: " CREATE TABLE IF NOT EXISTS `PropertyName` ( "
+               "   `id` INTEGER PRIMARY KEY AUTO_INCREMENT, "
+               "   `name` VARBINARY(255) NOT NULL UNIQUE "
+               " ); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Artifact` ADD ( "
-               "   `external_id` VARCHAR(255) "
-               " ), "
-               " ADD CONSTRAINT UniqueArtifactExternalId "
-               " UNIQUE(`external_id`); "
+        query: " INSERT INTO `PropertyName`(`name`) "
+               " SELECT BINARY `name` FROM `ArtifactProperty` "
+               " UNION SELECT BINARY `name` FROM `ExecutionProperty` "
+               " UNION SELECT BINARY `name` FROM `ContextProperty`; "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Execution` ADD ( "
-               "   `external_id` VARCHAR(255) "
-               " ), "
-               " ADD CONSTRAINT UniqueExecutionExternalId "
-               " UNIQUE(`external_id`); "
+        query: " ALTER TABLE `ArtifactProperty` ADD COLUMN `name_id` INT; "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Context` ADD ( "
-               "   `external_id` VARCHAR(255) "
-               " ), "
-               " ADD CONSTRAINT UniqueContextExternalId "
-               " UNIQUE(`external_id`); "
+        query: " UPDATE `ArtifactProperty` AS AP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = AP.`name`) "
+               " SET AP.`name_id` = PN.`id`; "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Type` "
-               " ADD INDEX `idx_type_external_id` (`external_id`); "
+        query: " ALTER TABLE `ArtifactProperty` "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_artifact_property_int`, "
+               "  DROP INDEX `idx_artifact_property_double`, "
+               "  DROP INDEX `idx_artifact_property_string`, "
+               "  DROP COLUMN `name`, "
+               "  MODIFY `name_id` INT NOT NULL, "
+               "  ADD PRIMARY KEY (`artifact_id`, `name_id`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_artifact_property_int`( "
+               "    `name_id`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_artifact_property_double`( "
+               "    `name_id`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_artifact_property_string`( "
+               "    `name_id`, `is_custom_property`, `string_value`(255)); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Artifact` "
-               " ADD INDEX `idx_artifact_external_id` (`external_id`); "
+        query: " ALTER TABLE `ExecutionProperty` ADD COLUMN `name_id` INT; "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Execution` "
-               " ADD INDEX `idx_execution_external_id` (`external_id`); "
+        query: " UPDATE `ExecutionProperty` AS EP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = EP.`name`) "
+               " SET EP.`name_id` = PN.`id`; "
       }
       upgrade_queries {
-        query: " ALTER TABLE `Context` "
-               " ADD INDEX `idx_context_external_id` (`external_id`); "
-      }
-      # check the expected table columns are created properly.
-      upgrade_verification {
-        previous_version_setup_queries { query: "DELETE FROM `Type`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Type` "
-                 " (`id`, `name`) "
-                 " VALUES (1, 't1'); "
-        }
-        previous_version_setup_queries { query: "DELETE FROM `Artifact`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `type_id`) "
-                 " VALUES (1, 2); "
-        }
-        previous_version_setup_queries { query: "DELETE FROM `Execution`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Execution` "
-                 " (`id`, `type_id`) "
-                 " VALUES (1, 2); "
-        }
-        previous_version_setup_queries { query: "DELETE FROM `Context`;" }
-        previous_version_setup_queries {
-          query: " INSERT INTO `Context` "
-                 " (`id`, `type_id`, `name`) "
-                 " VALUES (1, 2, 'name1'); "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM `Type`; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ( "
-                 "   SELECT * FROM `Type` "
-                 "   WHERE `id` = 1 AND `name` = 't1' AND "
-                 "         `external_id` IS NULL "
-                 " ) as T1; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Artifact`; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Artifact` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND "
-                 "         `external_id` IS NULL "
-                 " ) AS T1; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Execution`; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Execution` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND "
-                 "         `external_id` IS NULL "
-                 " ) AS T1; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM `Context`; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 FROM ( "
-                 "   SELECT * FROM `Context` "
-                 "   WHERE `id` = 1 AND `type_id` = 2 AND `name` = 'name1' AND "
-                 "         `external_id` IS NULL "
-                 " ) as T1; "
-        }
-      }
-      db_verification { total_num_indexes: 82 total_num_tables: 15 }
-      # downgrade queries from version 10
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " DROP COLUMN `proto_value`; "
-      }
-      downgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " DROP COLUMN `bool_value`; "
-      }
-      downgrade_queries {
         query: " ALTER TABLE `ExecutionProperty` "
-               " DROP COLUMN `proto_value`; "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_execution_property_int`, "
+               "  DROP INDEX `idx_execution_property_double`, "
+               "  DROP INDEX `idx_execution_property_string`, "
+               "  DROP COLUMN `name`, "
+               "  MODIFY `name_id` INT NOT NULL, "
+               "  ADD PRIMARY KEY (`execution_id`, `name_id`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_execution_property_int`( "
+               "    `name_id`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_execution_property_double`( "
+               "    `name_id`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_execution_property_string`( "
+               "    `name_id`, `is_custom_property`, `string_value`(255)); "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " DROP COLUMN `bool_value`; "
+      upgrade_queries {
+        query: " ALTER TABLE `ContextProperty` ADD COLUMN `name_id` INT; "
       }
-      downgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " DROP COLUMN `proto_value`; "
+      upgrade_queries {
+        query: " UPDATE `ContextProperty` AS CP "
+               " JOIN `PropertyName` AS PN ON (PN.`name` = CP.`name`) "
+               " SET CP.`name_id` = PN.`id`; "
       }
-      downgrade_queries {
+      upgrade_queries {
         query: " ALTER TABLE `ContextProperty` "
-               " DROP COLUMN `bool_value`; "
+               "  DROP PRIMARY KEY, "
+               "  DROP INDEX `idx_context_property_int`, "
+               "  DROP INDEX `idx_context_property_double`, "
+               "  DROP INDEX `idx_context_property_string`, "
+               "  DROP COLUMN `name`, "
+               "  MODIFY `name_id` INT NOT NULL, "
+               "  ADD PRIMARY KEY (`context_id`, `name_id`, "
+               "   `is_custom_property`), "
+               "  ADD INDEX `idx_context_property_int`( "
+               "    `name_id`, `is_custom_property`, `int_value`), "
+               "  ADD INDEX `idx_context_property_double`( "
+               "    `name_id`, `is_custom_property`, `double_value`), "
+               "  ADD INDEX `idx_context_property_string`( "
+               "    `name_id`, `is_custom_property`, `string_value`(255)); "
       }
-      downgrade_verification {
+      upgrade_verification {
         previous_version_setup_queries {
-          query: " INSERT INTO `Artifact` "
-                 " (`id`, `name`) "
-                 " VALUES (1, 'artifact-name'); "
+          query: "DELETE FROM `ArtifactProperty`;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM `ExecutionProperty`;"
         }
         previous_version_setup_queries {
-          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
-                 "     `name`, `is_custom_property`, `string_value`) "
-                 " VALUES (1, 'p-0', false, 'string_property_value'); "
+          query: "DELETE FROM `ContextProperty`;"
         }
-
         previous_version_setup_queries {
-          query: " INSERT INTO `Execution` "
-                 " (`id`, `name`) "
-                 " VALUES (1, 'execution-name'); "
+          query: " INSERT INTO `ArtifactProperty` (`artifact_id`, "
+                 "     `is_custom_property`, `name`, `string_value`) "
+                 " VALUES (1, 0, 'p1', 'abc'); "
         }
         previous_version_setup_queries {
           query: " INSERT INTO `ExecutionProperty` (`execution_id`, "
-                 "     `name`, `is_custom_property`, `string_value`) "
-                 " VALUES (1, 'p-0', false, 'string_property_value'); "
+                 "     `is_custom_property`, `name`, `int_value`) "
+                 " VALUES (1, 1, 'p1', 1); "
         }
-
         previous_version_setup_queries {
-          query: " INSERT INTO `Context` "
-                 " (`id`, `name`) "
-                 " VALUES (1, 'context-name'); "
+          query: " INSERT INTO `ContextProperty` (`context_id`, "
+                 "     `is_custom_property`, `name`, `double_value`) "
+                 " VALUES (1, 0, 'p2', 1.0); "
         }
+        # A name that differs from another one only in case.
         previous_version_setup_queries {
           query: " INSERT INTO `ContextProperty` (`context_id`, "
-                 "     `name`, `is_custom_property`, `string_value`) "
-                 " VALUES (1, 'p-0', false, 'string_property_value'); "
+                 "     `is_custom_property`, `name`, `double_value`) "
+                 " VALUES (2, 0, 'P2', 2.0); "
         }
-
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 "
-                 " FROM ArtifactProperty AS AP "
-                 " WHERE AP.artifact_id = 1 "
-                 "   AND AP.name = 'p-0' "
-                 "   AND AP.is_custom_property = false "
-                 "   AND AP.string_value = 'string_property_value'; "
+          query: " SELECT count(*) = 3 FROM `PropertyName`; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 "
-                 " FROM ExecutionProperty AS EP "
-                 " WHERE EP.execution_id = 1 "
-                 "   AND EP.name = 'p-0' "
-                 "   AND EP.is_custom_property = false "
-                 "   AND EP.string_value = 'string_property_value'; "
+          query: " SELECT count(*) = 1 "
+                 " FROM `ArtifactProperty` AS AP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = AP.`name_id`) "
+                 " WHERE AP.`artifact_id` = 1 AND "
+                 "       AP.`is_custom_property` = 0 AND "
+                 "       PN.`name` = 'p1' AND AP.`string_value` = 'abc'; "
         }
         post_migration_verification_queries {
-          query: " SELECT COUNT(*) = 1 "
-                 " FROM ContextProperty AS CP "
-                 " WHERE CP.context_id = 1 "
-                 "   AND CP.name = 'p-0' "
-                 "   AND CP.is_custom_property = false "
-                 "   AND CP.string_value = 'string_property_value'; "
+          query: " SELECT count(*) = 1 "
+                 " FROM `ExecutionProperty` AS EP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = EP.`name_id`) "
+                 " WHERE EP.`execution_id` = 1 AND "
+                 "       EP.`is_custom_property` = 1 AND "
+                 "       PN.`name` = 'p1' AND EP.`int_value` = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 "
+                 " FROM `ContextProperty` AS CP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`) "
+                 " WHERE CP.`context_id` = 1 AND "
+                 "       CP.`is_custom_property` = 0 AND "
+                 "       PN.`name` = 'p2' AND CP.`double_value` = 1.0; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 "
+                 " FROM `ContextProperty` AS CP "
+                 " JOIN `PropertyName` AS PN ON (PN.`id` = CP.`name_id`) "
+                 " WHERE CP.`context_id` = 2 AND "
+                 "       CP.`is_custom_property` = 0 AND "
+                 "       PN.`name` = 'P2' AND CP.`double_value` = 2.0; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ArtifactProperty' AND "
+                 "       `index_name` LIKE 'idx_artifact_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ExecutionProperty' AND "
+                 "       `index_name` LIKE 'idx_execution_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 9 FROM `information_schema`.`statistics` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ContextProperty' AND "
+                 "       `index_name` LIKE 'idx_context_property_%'; "
+        }
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `WriteEpoch`; " }
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'WriteEpoch'; "
         }
       }
+      db_verification { total_num_indexes: 85 total_num_tables: 17 }
     }
   }
 )pb",
 R"pb(
-  # In v10, we added proto_value and bool_value for property tables.
+  # In v13, we added the WriteEpoch table. It counts the committed writes of
+  # each node kind, so that servers can tell whether their cached list results
+  # are stale.
   migration_schemes {
-    key: 10
+    key: 13
     value: {
       upgrade_queries {
-        query: " ALTER TABLE `ArtifactProperty` "
-               " ADD COLUMN `proto_value` MEDIUMBLOB, "
-               " ADD COLUMN `bool_value` BOOLEAN; "
-      }
-      upgrade_queries {
-        query: " ALTER TABLE `ExecutionProperty` "
-               " ADD COLUMN `proto_value` MEDIUMBLOB, "
-               " ADD COLUMN `bool_value` BOOLEAN; "
+        query: " CREATE TABLE IF NOT EXISTS `WriteEpoch` ( "
+               "   `type_kind` INTEGER PRIMARY KEY, "
+               "   `epoch` BIGINT NOT NULL "
+               " ); "
       }
       upgrade_queries {
-        query: " ALTER TABLE `ContextProperty` "
-               " ADD COLUMN `proto_value` MEDIUMBLOB, "
-               " ADD COLUMN `bool_value` BOOLEAN; "
+        query: " INSERT INTO `WriteEpoch`(`type_kind`, `epoch`) "
+               " VALUES(0, 0), (1, 0), (2, 0); "
       }
-      # check the expected table columns are created properly.
       upgrade_verification {
-        # check existing rows in previous Type table are migrated properly.
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
-                 " `proto_value` IS NOT NULL; "
-        } post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ArtifactProperty` WHERE "
-                 " `bool_value` IS NOT NULL; "
+          query: " SELECT count(*) = 3 FROM `WriteEpoch` "
+                 " WHERE `type_kind` IN (0, 1, 2) AND `epoch` = 0; "
         }
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS `ContextSummary`; " }
+      downgrade_verification {
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
-                 " `proto_value` IS NOT NULL; "
-        } post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ExecutionProperty` WHERE "
-                 " `bool_value` IS NOT NULL; "
+          query: " SELECT count(*) = 0 FROM `information_schema`.`tables` "
+                 " WHERE `table_schema` = (SELECT DATABASE()) and "
+                 "       `table_name` = 'ContextSummary'; "
+        }
+      }
+      db_verification { total_num_indexes: 86 total_num_tables: 18 }
+    }
+  }
+)pb",
+R"pb(
+  # In v14, we added the ContextSummary table. It counts the executions and
+  # artifacts of each type and state in a context, so that the summaries of
+  # contexts are read without listing their nodes.
+  migration_schemes {
+    key: 14
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS `ContextSummary` ( "
+               "   `context_id` INT NOT NULL, "
+               "   `type_kind` INT NOT NULL, "
+               "   `type_id` INT NOT NULL, "
+               "   `state` INT NOT NULL, "
+               "   `num_nodes` BIGINT NOT NULL, "
+               "   PRIMARY KEY (`context_id`, `type_kind`, `type_id`, `state`) "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO `ContextSummary`( "
+               "   `context_id`, `type_kind`, `type_id`, `state`, `num_nodes`) "
+               " SELECT A.`context_id`, 0, E.`type_id`, "
+               "        COALESCE(E.`last_known_state`, 0), COUNT(*) "
+               " FROM `Association` AS A "
+               "      JOIN `Execution` AS E ON A.`execution_id` = E.`id` "
+               " GROUP BY A.`context_id`, E.`type_id`, "
+               "          COALESCE(E.`last_known_state`, 0) "
+               " UNION ALL "
+               " SELECT T.`context_id`, 1, R.`type_id`, "
+               "        COALESCE(R.`state`, 0), COUNT(*) "
+               " FROM `Attribution` AS T "
+               "      JOIN `Artifact` AS R ON T.`artifact_id` = R.`id` "
+               " GROUP BY T.`context_id`, R.`type_id`, COALESCE(R.`state`, 0); "
+      }
+      upgrade_verification {
+        previous_version_setup_queries {
+          query: " INSERT INTO `Execution` "
+                 "     (`id`, `type_id`, `last_known_state`) "
+                 " VALUES (1, 2, 3); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO `Association`(`context_id`, `execution_id`) "
+                 " VALUES (4, 1); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
-                 " `proto_value` IS NOT NULL; "
-        } post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM `ContextProperty` WHERE "
-                 " `bool_value` IS NOT NULL; "
+          query: " SELECT count(*) = 1 FROM `ContextSummary` "
+                 " WHERE `context_id` = 4 AND `type_kind` = 0 AND "
+                 "       `type_id` = 2 AND `state` = 3 AND `num_nodes` = 1; "
         }
       }
-      db_verification { total_num_indexes: 82 total_num_tables: 15 }
+      db_verification { total_num_indexes: 87 total_num_tables: 19 }
     }
   }
 )pb");
@@ -4951,10 +6533,19 @@ R"pb(
            " WHERE A.id IN ($0); "
     parameter_num: 1
   }
+  select_artifact_last_update_time_by_id {
+    query: " SELECT id, last_update_time_since_epoch FROM Artifact "
+           " WHERE id IN ($0); "
+    parameter_num: 1
+  }
   select_artifact_by_type_id_and_name {
     query: " SELECT id FROM Artifact WHERE type_id = $0 and name = $1; "
     parameter_num: 2
   }
+  select_artifacts_by_type_id_and_names {
+    query: " SELECT id FROM Artifact WHERE type_id = $0 and name IN ($1); "
+    parameter_num: 2
+  }
   select_artifacts_by_type_id {
     query: " SELECT id FROM Artifact WHERE type_id = $0; "
     parameter_num: 1
@@ -4963,6 +6554,10 @@ R"pb(
     query: " SELECT id FROM Artifact WHERE uri = $0; "
     parameter_num: 1
   }
+  select_artifacts_by_uris {
+    query: " SELECT id FROM Artifact WHERE uri IN ($0); "
+    parameter_num: 1
+  }
   select_artifacts_by_external_ids {
     query: " SELECT id FROM Artifact WHERE external_id IN ($0); "
     parameter_num: 1
@@ -4970,17 +6565,44 @@ R"pb(
   update_artifact {
     query: " UPDATE Artifact "
            " SET type_id = $1, uri = $2, state = $3, external_id = $4, "
-           "     last_update_time_since_epoch = $5 "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $5 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $5 END "
            " WHERE id = $0;"
     parameter_num: 6
   }
+  update_artifact_last_update_time {
+    query: " UPDATE Artifact SET last_update_time_since_epoch = "
+           "     CASE WHEN last_update_time_since_epoch >= $1 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "     THEN last_update_time_since_epoch + 1 ELSE $1 END "
+           " WHERE id IN ($0);"
+    parameter_num: 2
+  }
+  update_artifact_with_precondition {
+    query: " UPDATE Artifact "
+           " SET type_id = $1, "
+           "     uri = CASE WHEN ($9 & 1) <> 0 THEN $2 ELSE uri END, "
+           "     state = CASE WHEN ($9 & 2) <> 0 THEN $3 ELSE state END, "
+           "     external_id = "
+           "      CASE WHEN ($9 & 4) <> 0 THEN $4 ELSE external_id END, "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $5 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $5 END "
+           " WHERE id = $0 "
+           "   AND ($6 IS NULL OR last_update_time_since_epoch = $6) "
+           "   AND ($7 = 0 OR COALESCE(state, 0) IN ($8));"
+    parameter_num: 10
+  }
   drop_artifact_property_table {
     query: " DROP TABLE IF EXISTS ArtifactProperty; "
   }
   create_artifact_property_table {
     query: " CREATE TABLE IF NOT EXISTS ArtifactProperty ( "
            "   artifact_id INT NOT NULL, "
-           "   name VARCHAR(255) NOT NULL, "
+           "   name_id INT NOT NULL, "
            "   is_custom_property BOOLEAN NOT NULL, "
            "   int_value INT, "
            "   double_value DOUBLE PRECISION, "
@@ -4988,14 +6610,14 @@ R"pb(
            "   byte_value BYTEA, "
            "   proto_value BYTEA, "
            "   bool_value BOOLEAN, "
-           " PRIMARY KEY (artifact_id, name, is_custom_property)); "
+           " PRIMARY KEY (artifact_id, name_id, is_custom_property)); "
   }
   check_artifact_property_table {
     query: " SELECT (("
            "   SELECT COUNT(*)"
            "   FROM   information_schema.columns"
            "   WHERE  table_name = 'artifactproperty'"
-           "      AND column_name IN ('artifact_id', 'name', "
+           "      AND column_name IN ('artifact_id', 'name_id', "
            "        'is_custom_property', 'int_value', 'double_value',"
            "        'string_value', 'byte_value', 'proto_value', 'bool_value')"
            "   ) = 9"
@@ -5004,29 +6626,43 @@ R"pb(
   # After insertion, return id for the new inserted ArtifactProperty.
   insert_artifact_property {
     query: " INSERT INTO ArtifactProperty( "
-           "   artifact_id, name, is_custom_property, $0 "
+           "   artifact_id, name_id, is_custom_property, $0 "
            ") VALUES($1, $2, $3, $4)"
     parameter_num: 5
   }
   select_artifact_property_by_artifact_id {
-    query: " SELECT artifact_id as id, name as key, "
-           "        is_custom_property, "
-           "        int_value, double_value, string_value, "
-           "        encode(proto_value, 'base64'), bool_value "
-           " FROM ArtifactProperty "
-           " WHERE artifact_id IN ($0); "
+    query: " SELECT AP.artifact_id as id, PN.name as key, "
+           "        AP.is_custom_property, "
+           "        AP.int_value, AP.double_value, AP.string_value, "
+           "        encode(AP.proto_value, 'base64'), AP.bool_value "
+           " FROM ArtifactProperty AS AP "
+           " JOIN PropertyName AS PN ON (PN.id = AP.name_id) "
+           " WHERE AP.artifact_id IN ($0); "
     parameter_num: 1
   }
   update_artifact_property {
     query: " UPDATE ArtifactProperty "
            " SET $0 = $1 "
-           " WHERE artifact_id = $2 and name = $3;"
+           " WHERE artifact_id = $2 and name_id = $3;"
     parameter_num: 4
   }
   delete_artifact_property {
     query: " DELETE FROM ArtifactProperty "
-           " WHERE artifact_id = $0 and name = $1;"
-    parameter_num: 2
+           " WHERE artifact_id = $0 and name_id = $1 "
+           "   and is_custom_property = $2;"
+    parameter_num: 3
+  }
+  insert_artifacts_property {
+    query: " INSERT INTO ArtifactProperty( "
+           "   artifact_id, name_id, is_custom_property, $0 "
+           ") SELECT id, $1, $2, $3 FROM Artifact WHERE id IN ($4);"
+    parameter_num: 5
+  }
+  delete_artifacts_properties {
+    query: " DELETE FROM ArtifactProperty "
+           " WHERE artifact_id IN ($0) AND name_id IN ($1) "
+           "   AND is_custom_property = $2;"
+    parameter_num: 3
   }
   delete_artifacts_by_id {
     query: "DELETE FROM Artifact WHERE id IN ($0); "
@@ -5082,10 +6718,19 @@ R"pb(
            " WHERE E.id IN ($0);"
     parameter_num: 1
   }
+  select_execution_last_update_time_by_id {
+    query: " SELECT id, last_update_time_since_epoch FROM Execution "
+           " WHERE id IN ($0); "
+    parameter_num: 1
+  }
   select_execution_by_type_id_and_name {
     query: " SELECT id FROM Execution WHERE type_id = $0 and name = $1;"
     parameter_num: 2
   }
+  select_executions_by_type_id_and_names {
+    query: " SELECT id FROM Execution WHERE type_id = $0 and name IN ($1); "
+    parameter_num: 2
+  }
   select_executions_by_type_id {
     query: " SELECT id FROM Execution WHERE type_id = $0; "
     parameter_num: 1
@@ -5098,17 +6743,62 @@ R"pb(
     query: " UPDATE Execution "
            " SET type_id = $1, last_known_state = $2, "
            "     external_id = $3, "
-           "     last_update_time_since_epoch = $4 "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $4 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $4 END "
            " WHERE id = $0;"
     parameter_num: 5
   }
+  update_execution_last_update_time {
+    query: " UPDATE Execution SET last_update_time_since_epoch = "
+           "     CASE WHEN last_update_time_since_epoch >= $1 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "     THEN last_update_time_since_epoch + 1 ELSE $1 END "
+           " WHERE id IN ($0);"
+    parameter_num: 2
+  }
+  update_execution_with_precondition {
+    query: " UPDATE Execution "
+           " SET type_id = $1, "
+           "     last_known_state = "
+           "      CASE WHEN ($8 & 2) <> 0 THEN $2 ELSE last_known_state END, "
+           "     external_id = "
+           "      CASE WHEN ($8 & 4) <> 0 THEN $3 ELSE external_id END, "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $4 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $4 END "
+           " WHERE id = $0 "
+           "   AND ($5 IS NULL OR last_update_time_since_epoch = $5) "
+           "   AND ($6 = 0 OR COALESCE(last_known_state, 0) IN ($7));"
+    parameter_num: 9
+  }
+  select_execution_ids_for_claim {
+    query: " SELECT id FROM Execution "
+           " WHERE type_id = $0 "
+           "   AND (last_known_state = $1 "
+           "        OR ($1 = 0 AND last_known_state IS NULL)) "
+           " ORDER BY id LIMIT $2 FOR UPDATE SKIP LOCKED; "
+    parameter_num: 3
+  }
+  update_executions_state {
+    query: " UPDATE Execution "
+           " SET last_known_state = $1, "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $2 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $2 END "
+           " WHERE id IN ($0);"
+    parameter_num: 3
+  }
   drop_execution_property_table {
     query: " DROP TABLE IF EXISTS ExecutionProperty; "
   }
   create_execution_property_table {
     query: " CREATE TABLE IF NOT EXISTS ExecutionProperty ( "
            "   execution_id INT NOT NULL, "
-           "   name VARCHAR(255) NOT NULL, "
+           "   name_id INT NOT NULL, "
            "   is_custom_property BOOLEAN NOT NULL, "
            "   int_value INT, "
            "   double_value DOUBLE PRECISION, "
@@ -5116,14 +6806,14 @@ R"pb(
            "   byte_value BYTEA, "
            "   proto_value BYTEA, "
            "   bool_value BOOLEAN, "
-           " PRIMARY KEY (execution_id, name, is_custom_property)); "
+           " PRIMARY KEY (execution_id, name_id, is_custom_property)); "
   }
   check_execution_property_table {
     query: " SELECT (("
            "   SELECT COUNT(*)"
            "   FROM   information_schema.columns"
            "   WHERE  table_name = 'executionproperty'"
-           "      AND column_name IN ('execution_id', 'name', "
+           "      AND column_name IN ('execution_id', 'name_id', "
            "        'is_custom_property', 'int_value', 'double_value',"
            "        'string_value', 'byte_value', 'proto_value', 'bool_value')"
            "   ) = 9"
@@ -5131,30 +6821,43 @@ R"pb(
   }
   insert_execution_property {
     query: " INSERT INTO ExecutionProperty( "
-           "   execution_id, name, is_custom_property, $0 "
+           "   execution_id, name_id, is_custom_property, $0 "
            ") VALUES($1, $2, $3, $4)"
     parameter_num: 5
   }
   select_execution_property_by_execution_id {
-    query: " SELECT execution_id as id, name as key, "
-           "        is_custom_property, "
-           "        int_value, double_value, string_value, "
-           "        encode(proto_value, 'base64'),"
-           "        bool_value "
-           " FROM ExecutionProperty "
-           " WHERE execution_id IN ($0); "
+    query: " SELECT EP.execution_id as id, PN.name as key, "
+           "        EP.is_custom_property, "
+           "        EP.int_value, EP.double_value, EP.string_value, "
+           "        encode(EP.proto_value, 'base64'), EP.bool_value "
+           " FROM ExecutionProperty AS EP "
+           " JOIN PropertyName AS PN ON (PN.id = EP.name_id) "
+           " WHERE EP.execution_id IN ($0); "
     parameter_num: 1
   }
   update_execution_property {
     query: " UPDATE ExecutionProperty "
            " SET $0 = $1 "
-           " WHERE execution_id = $2 and name = $3;"
+           " WHERE execution_id = $2 and name_id = $3;"
     parameter_num: 4
   }
   delete_execution_property {
     query: " DELETE FROM ExecutionProperty "
-           " WHERE execution_id = $0 and name = $1;"
-    parameter_num: 2
+           " WHERE execution_id = $0 and name_id = $1 "
+           "   and is_custom_property = $2;"
+    parameter_num: 3
+  }
+  insert_executions_property {
+    query: " INSERT INTO ExecutionProperty( "
+           "   execution_id, name_id, is_custom_property, $0 "
+           ") SELECT id, $1, $2, $3 FROM Execution WHERE id IN ($4);"
+    parameter_num: 5
+  }
+  delete_executions_properties {
+    query: " DELETE FROM ExecutionProperty "
+           " WHERE execution_id IN ($0) AND name_id IN ($1) "
+           "   AND is_custom_property = $2;"
+    parameter_num: 3
   }
   delete_executions_by_id {
     query: " DELETE FROM Execution WHERE id IN ($0); "
@@ -5207,6 +6910,11 @@ R"pb(
            " WHERE C.id IN ($0); "
     parameter_num: 1
   }
+  select_context_last_update_time_by_id {
+    query: " SELECT id, last_update_time_since_epoch FROM Context "
+           " WHERE id IN ($0); "
+    parameter_num: 1
+  }
   select_contexts_by_type_id {
     query: " SELECT id FROM Context WHERE type_id = $0; "
     parameter_num: 1
@@ -5215,6 +6923,10 @@ R"pb(
     query: " SELECT id FROM Context WHERE type_id = $0 and name = $1; "
     parameter_num: 2
   }
+  select_contexts_by_type_id_and_names {
+    query: " SELECT id FROM Context WHERE type_id = $0 and name IN ($1); "
+    parameter_num: 2
+  }
   select_contexts_by_external_ids {
     query: " SELECT id FROM Context WHERE external_id IN ($0); "
     parameter_num: 1
@@ -5222,17 +6934,28 @@ R"pb(
   update_context {
     query: " UPDATE Context "
            " SET type_id = $1, name = $2, external_id = $3, "
-           "     last_update_time_since_epoch = $4 "
+           "     last_update_time_since_epoch = "
+           "         CASE WHEN last_update_time_since_epoch >= $4 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "         THEN last_update_time_since_epoch + 1 ELSE $4 END "
            " WHERE id = $0;"
     parameter_num: 5
   }
+  update_context_last_update_time {
+    query: " UPDATE Context SET last_update_time_since_epoch = "
+           "     CASE WHEN last_update_time_since_epoch >= $1 "
+           "          AND last_update_time_since_epoch < 9223372036854775807 "
+           "     THEN last_update_time_since_epoch + 1 ELSE $1 END "
+           " WHERE id IN ($0);"
+    parameter_num: 2
+  }
   drop_context_property_table {
     query: " DROP TABLE IF EXISTS ContextProperty; "
   }
   create_context_property_table {
     query: " CREATE TABLE IF NOT EXISTS ContextProperty ( "
            "   context_id INT NOT NULL, "
-           "   name VARCHAR(255) NOT NULL, "
+           "   name_id INT NOT NULL, "
            "   is_custom_property BOOLEAN NOT NULL, "
            "   int_value INT, "
            "   double_value DOUBLE PRECISION, "
@@ -5240,14 +6963,14 @@ R"pb(
            "   byte_value BYTEA, "
            "   proto_value BYTEA, "
            "   bool_value BOOLEAN, "
-           " PRIMARY KEY (context_id, name, is_custom_property)); "
+           " PRIMARY KEY (context_id, name_id, is_custom_property)); "
   }
   check_context_property_table {
     query: " SELECT (("
            "   SELECT COUNT(*)"
            "   FROM   information_schema.columns"
            "   WHERE  table_name = 'contextproperty'"
-           "      AND column_name IN ('context_id', 'name', "
+           "      AND column_name IN ('context_id', 'name_id', "
            "        'is_custom_property', 'int_value', 'double_value',"
            "        'string_value', 'byte_value', 'proto_value', 'bool_value')"
            "   ) = 9"
@@ -5255,30 +6978,43 @@ R"pb(
   }
   insert_context_property {
     query: " INSERT INTO ContextProperty( "
-           "   context_id, name, is_custom_property, $0 "
+           "   context_id, name_id, is_custom_property, $0 "
            ") VALUES($1, $2, $3, $4)"
     parameter_num: 5
   }
   select_context_property_by_context_id {
-    query: " SELECT context_id as id, name as key, "
-           "        is_custom_property, "
-           "        int_value, double_value, string_value, "
-           "        encode(proto_value, 'base64'),"
-           "        bool_value "
-           " FROM ContextProperty "
-           " WHERE context_id IN ($0); "
+    query: " SELECT CP.context_id as id, PN.name as key, "
+           "        CP.is_custom_property, "
+           "        CP.int_value, CP.double_value, CP.string_value, "
+           "        encode(CP.proto_value, 'base64'), CP.bool_value "
+           " FROM ContextProperty AS CP "
+           " JOIN PropertyName AS PN ON (PN.id = CP.name_id) "
+           " WHERE CP.context_id IN ($0); "
     parameter_num: 1
   }
   update_context_property {
     query: " UPDATE ContextProperty "
            " SET $0 = $1 "
-           " WHERE context_id = $2 and name = $3;"
+           " WHERE context_id = $2 and name_id = $3;"
     parameter_num: 4
   }
   delete_context_property {
     query: " DELETE FROM ContextProperty "
-           " WHERE context_id = $0 and name = $1;"
-    parameter_num: 2
+           " WHERE context_id = $0 and name_id = $1 "
+           "   and is_custom_property = $2;"
+    parameter_num: 3
+  }
+  insert_contexts_property {
+    query: " INSERT INTO ContextProperty( "
+           "   context_id, name_id, is_custom_property, $0 "
+           ") SELECT id, $1, $2, $3 FROM Context WHERE id IN ($4);"
+    parameter_num: 5
+  }
+  delete_contexts_properties {
+    query: " DELETE FROM ContextProperty "
+           " WHERE context_id IN ($0) AND name_id IN ($1) "
+           "   AND is_custom_property = $2;"
+    parameter_num: 3
   }
   drop_parent_context_table {
     query: " DROP TABLE IF EXISTS ParentContext;"
@@ -5380,6 +7116,65 @@ R"pb(
            " WHERE execution_id IN ($0); "
     parameter_num: 1
   }
+  select_lineage_event_by_artifact_ids {
+    query: " SELECT E.id, E.artifact_id, E.execution_id, "
+           "        E.type, E.milliseconds_since_epoch "
+           " FROM Event AS E "
+           " JOIN ( "
+           "   SELECT DISTINCT N.id, N.create_time_since_epoch "
+           "   FROM Event AS NE "
+           "   JOIN Execution AS N ON NE.execution_id = N.id "
+           "   WHERE NE.artifact_id IN ($0) "
+           "     AND NE.milliseconds_since_epoch >= $1 "
+           "     AND NE.milliseconds_since_epoch < $2 "
+           "     AND N.create_time_since_epoch >= $3 "
+           "     AND N.create_time_since_epoch < $4 "
+           "     AND ($5 = 0 OR N.last_known_state IN ($6)) "
+           "   ORDER BY N.create_time_since_epoch DESC, N.id "
+           "   LIMIT $7 OFFSET $8 "
+           " ) AS P ON E.execution_id = P.id "
+           " WHERE E.artifact_id IN ($0) "
+           "   AND E.milliseconds_since_epoch >= $1 "
+           "   AND E.milliseconds_since_epoch < $2 "
+           " ORDER BY P.create_time_since_epoch DESC, P.id, E.id; "
+    parameter_num: 9
+  }
+  select_lineage_event_by_execution_ids {
+    query: " SELECT E.id, E.artifact_id, E.execution_id, "
+           "        E.type, E.milliseconds_since_epoch "
+           " FROM Event AS E "
+           " JOIN ( "
+           "   SELECT DISTINCT N.id, N.create_time_since_epoch "
+           "   FROM Event AS NE "
+           "   JOIN Artifact AS N ON NE.artifact_id = N.id "
+           "   WHERE NE.execution_id IN ($0) "
+           "     AND NE.milliseconds_since_epoch >= $1 "
+           "     AND NE.milliseconds_since_epoch < $2 "
+           "     AND N.create_time_since_epoch >= $3 "
+           "     AND N.create_time_since_epoch < $4 "
+           "   ORDER BY N.create_time_since_epoch DESC, N.id "
+           "   LIMIT $5 OFFSET $6 "
+           " ) AS P ON E.artifact_id = P.id "
+           " WHERE E.execution_id IN ($0) "
+           "   AND E.milliseconds_since_epoch >= $1 "
+           "   AND E.milliseconds_since_epoch < $2 "
+           " ORDER BY P.create_time_since_epoch DESC, P.id, E.id; "
+    parameter_num: 7
+  }
+  select_artifact_ids_by_recency {
+    query: " SELECT id FROM Artifact "
+           " WHERE id IN ($0) "
+           " ORDER BY create_time_since_epoch DESC, id "
+           " LIMIT $1; "
+    parameter_num: 2
+  }
+  select_execution_ids_by_recency {
+    query: " SELECT id FROM Execution "
+           " WHERE id IN ($0) "
+           " ORDER BY create_time_since_epoch DESC, id "
+           " LIMIT $1; "
+    parameter_num: 2
+  }
   drop_event_path_table { query: " DROP TABLE IF EXISTS EventPath; " }
   create_event_path_table {
     query: " CREATE TABLE IF NOT EXISTS EventPath ( "
@@ -5461,40 +7256,224 @@ R"pb(
            " WHERE execution_id IN ($0); "
     parameter_num: 1
   }
-  drop_attribution_table { query: " DROP TABLE IF EXISTS Attribution; " }
-  create_attribution_table {
-    query: " CREATE TABLE IF NOT EXISTS Attribution ( "
-           "   id SERIAL PRIMARY KEY, "
+  drop_attribution_table { query: " DROP TABLE IF EXISTS Attribution; " }
+  create_attribution_table {
+    query: " CREATE TABLE IF NOT EXISTS Attribution ( "
+           "   id SERIAL PRIMARY KEY, "
+           "   context_id INT NOT NULL, "
+           "   artifact_id INT NOT NULL, "
+           "   UNIQUE(context_id, artifact_id) "
+           " ); "
+  }
+  check_attribution_table {
+    query: " SELECT (("
+           "   SELECT COUNT(*)"
+           "   FROM   information_schema.columns"
+           "   WHERE  table_name = 'attribution'"
+           "      AND column_name IN ('id', 'context_id', 'artifact_id')"
+           "   ) = 3"
+           " )::int AS table_exists;"
+  }
+  insert_attribution {
+    query: " INSERT INTO Attribution( "
+           "   context_id, artifact_id "
+           ") VALUES($0, $1)"
+    parameter_num: 2
+  }
+  select_attribution_by_context_id {
+    query: " SELECT id, context_id, artifact_id "
+           " FROM Attribution "
+           " WHERE context_id = $0; "
+    parameter_num: 1
+  }
+  select_attributions_by_artifact_ids {
+    query: " SELECT id, context_id, artifact_id "
+           " FROM Attribution "
+           " WHERE artifact_id IN ($0); "
+    parameter_num: 1
+  }
+  create_type_catalog_table {
+    query: " CREATE TABLE IF NOT EXISTS TypeCatalog ( "
+           "   type_id INT PRIMARY KEY, "
+           "   catalog_version BIGINT NOT NULL "
+           " ); "
+  }
+  insert_type_catalog {
+    query: " INSERT INTO TypeCatalog(type_id, catalog_version) "
+           " VALUES(0, 0) ON CONFLICT DO NOTHING; "
+  }
+  increase_type_catalog_version {
+    query: " UPDATE TypeCatalog SET catalog_version = catalog_version + 1 "
+           " WHERE type_id = 0; "
+  }
+  select_type_catalog_version {
+    query: " SELECT catalog_version FROM TypeCatalog WHERE type_id = 0; "
+  }
+  upsert_type_catalog_version {
+    query: " INSERT INTO TypeCatalog(type_id, catalog_version) "
+           " VALUES($0, $1) "
+           " ON CONFLICT(type_id) DO UPDATE SET catalog_version = $1; "
+    parameter_num: 2
+  }
+  select_types_changed_after_catalog_version {
+    query: " SELECT TC.type_id, T.type_kind "
+           " FROM TypeCatalog AS TC "
+           " JOIN Type AS T ON (T.id = TC.type_id) "
+           " WHERE TC.catalog_version > $0; "
+    parameter_num: 1
+  }
+  drop_property_name_table {
+    query: " DROP TABLE IF EXISTS PropertyName; "
+  }
+  create_property_name_table {
+    query: " CREATE TABLE IF NOT EXISTS PropertyName ( "
+           "   id SERIAL PRIMARY KEY, "
+           "   name VARCHAR(255) NOT NULL UNIQUE "
+           " ); "
+  }
+  check_property_name_table {
+    query: " SELECT (("
+           "   SELECT COUNT(*)"
+           "   FROM   information_schema.columns"
+           "   WHERE  table_name = 'propertyname'"
+           "      AND column_name IN ('id', 'name')"
+           "   ) = 2"
+           " )::int AS table_exists;"
+  }
+  insert_property_name {
+    query: " INSERT INTO PropertyName(name) VALUES($0) "
+           " ON CONFLICT DO NOTHING; "
+    parameter_num: 1
+  }
+  select_property_name_id {
+    query: " SELECT id FROM PropertyName WHERE name = $0; "
+    parameter_num: 1
+  }
+  create_write_epoch_table {
+    query: " CREATE TABLE IF NOT EXISTS WriteEpoch ( "
+           "   type_kind INTEGER PRIMARY KEY, "
+           "   epoch BIGINT NOT NULL "
+           " ); "
+  }
+  insert_write_epochs {
+    query: " INSERT INTO WriteEpoch(type_kind, epoch) "
+           " VALUES(0, 0), (1, 0), (2, 0) ON CONFLICT DO NOTHING; "
+  }
+  increase_write_epochs {
+    query: " UPDATE WriteEpoch SET epoch = epoch + 1 "
+           " WHERE type_kind IN ($0); "
+    parameter_num: 1
+  }
+  select_write_epochs {
+    query: " SELECT type_kind, epoch FROM WriteEpoch; "
+  }
+  create_context_summary_table {
+    query: " CREATE TABLE IF NOT EXISTS ContextSummary ( "
            "   context_id INT NOT NULL, "
-           "   artifact_id INT NOT NULL, "
-           "   UNIQUE(context_id, artifact_id) "
+           "   type_kind INT NOT NULL, "
+           "   type_id INT NOT NULL, "
+           "   state INT NOT NULL, "
+           "   num_nodes BIGINT NOT NULL, "
+           "   PRIMARY KEY (context_id, type_kind, type_id, state) "
            " ); "
   }
-  check_attribution_table {
-    query: " SELECT (("
-           "   SELECT COUNT(*)"
-           "   FROM   information_schema.columns"
-           "   WHERE  table_name = 'attribution'"
-           "      AND column_name IN ('id', 'context_id', 'artifact_id')"
-           "   ) = 3"
-           " )::int AS table_exists;"
+  update_context_summaries_by_executions {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT A.context_id, 0, E.type_id, "
+           "        COALESCE(E.last_known_state, 0), $0 * COUNT(*) "
+           " FROM Association AS A "
+           "      JOIN Execution AS E ON A.execution_id = E.id "
+           " WHERE E.id IN ($1) "
+           " GROUP BY A.context_id, E.type_id, "
+           "          COALESCE(E.last_known_state, 0) "
+           " ON CONFLICT(context_id, type_kind, type_id, state) "
+           " DO UPDATE SET "
+           "   num_nodes = ContextSummary.num_nodes + EXCLUDED.num_nodes; "
+    parameter_num: 2
   }
-  insert_attribution {
-    query: " INSERT INTO Attribution( "
-           "   context_id, artifact_id "
-           ") VALUES($0, $1)"
+  update_context_summaries_by_artifacts {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT T.context_id, 1, R.type_id, "
+           "        COALESCE(R.state, 0), $0 * COUNT(*) "
+           " FROM Attribution AS T "
+           "      JOIN Artifact AS R ON T.artifact_id = R.id "
+           " WHERE R.id IN ($1) "
+           " GROUP BY T.context_id, R.type_id, COALESCE(R.state, 0) "
+           " ON CONFLICT(context_id, type_kind, type_id, state) "
+           " DO UPDATE SET "
+           "   num_nodes = ContextSummary.num_nodes + EXCLUDED.num_nodes; "
     parameter_num: 2
   }
-  select_attribution_by_context_id {
-    query: " SELECT id, context_id, artifact_id "
-           " FROM Attribution "
-           " WHERE context_id = $0; "
+  increase_context_summary_by_association {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT $0, 0, type_id, COALESCE(last_known_state, 0), 1 "
+           " FROM Execution WHERE id = $1 "
+           " ON CONFLICT(context_id, type_kind, type_id, state) "
+           " DO UPDATE SET "
+           "   num_nodes = ContextSummary.num_nodes + EXCLUDED.num_nodes; "
+    parameter_num: 2
+  }
+  increase_context_summary_by_attribution {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT $0, 1, type_id, COALESCE(state, 0), 1 "
+           " FROM Artifact WHERE id = $1 "
+           " ON CONFLICT(context_id, type_kind, type_id, state) "
+           " DO UPDATE SET "
+           "   num_nodes = ContextSummary.num_nodes + EXCLUDED.num_nodes; "
+    parameter_num: 2
+  }
+  delete_context_summaries {
+    query: " DELETE FROM ContextSummary WHERE context_id IN ($0); "
     parameter_num: 1
   }
-  select_attributions_by_artifact_ids {
-    query: " SELECT id, context_id, artifact_id "
-           " FROM Attribution "
-           " WHERE artifact_id IN ($0); "
+  insert_context_summaries {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT A.context_id, 0, E.type_id, "
+           "        COALESCE(E.last_known_state, 0), COUNT(*) "
+           " FROM Association AS A "
+           "      JOIN Execution AS E ON A.execution_id = E.id "
+           " WHERE A.context_id IN ($0) "
+           " GROUP BY A.context_id, E.type_id, "
+           "          COALESCE(E.last_known_state, 0) "
+           " UNION ALL "
+           " SELECT T.context_id, 1, R.type_id, "
+           "        COALESCE(R.state, 0), COUNT(*) "
+           " FROM Attribution AS T "
+           "      JOIN Artifact AS R ON T.artifact_id = R.id "
+           " WHERE T.context_id IN ($0) "
+           " GROUP BY T.context_id, R.type_id, COALESCE(R.state, 0); "
+    parameter_num: 1
+  }
+  delete_all_context_summaries {
+    query: " DELETE FROM ContextSummary; "
+  }
+  insert_all_context_summaries {
+    query: " INSERT INTO ContextSummary( "
+           "   context_id, type_kind, type_id, state, num_nodes) "
+           " SELECT A.context_id, 0, E.type_id, "
+           "        COALESCE(E.last_known_state, 0), COUNT(*) "
+           " FROM Association AS A "
+           "      JOIN Execution AS E ON A.execution_id = E.id "
+           " GROUP BY A.context_id, E.type_id, "
+           "          COALESCE(E.last_known_state, 0) "
+           " UNION ALL "
+           " SELECT T.context_id, 1, R.type_id, "
+           "        COALESCE(R.state, 0), COUNT(*) "
+           " FROM Attribution AS T "
+           "      JOIN Artifact AS R ON T.artifact_id = R.id "
+           " GROUP BY T.context_id, R.type_id, COALESCE(R.state, 0); "
+  }
+  select_context_summaries {
+    query: " SELECT context_id, type_kind, type_id, state, "
+           "        num_nodes "
+           " FROM ContextSummary "
+           " WHERE context_id IN ($0) AND num_nodes > 0 "
+           " ORDER BY context_id, type_kind, type_id, state; "
     parameter_num: 1
   }
   drop_mlmd_env_table { query: " DROP TABLE IF EXISTS MLMDEnv; " }
@@ -5600,47 +7579,49 @@ R"pb(
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_artifact_property_int "
-           "  ON ArtifactProperty (name, is_custom_property, int_value); "
+           "  ON ArtifactProperty (name_id, is_custom_property, int_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_artifact_property_double "
-           "  ON ArtifactProperty (name, is_custom_property, double_value); "
+           "  ON ArtifactProperty (name_id, is_custom_property, double_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_artifact_property_string "
-           "  ON ArtifactProperty (name, is_custom_property, string_value); "
+           "  ON ArtifactProperty (name_id, is_custom_property, string_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_execution_property_int "
-           "  ON ExecutionProperty (name, is_custom_property, int_value); "
+           "  ON ExecutionProperty (name_id, is_custom_property, int_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_execution_property_double "
-           "  ON ExecutionProperty (name, is_custom_property, double_value); "
+           "  ON ExecutionProperty (name_id, is_custom_property, "
+           "   double_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_execution_property_string "
-           "  ON ExecutionProperty (name, is_custom_property, string_value); "
+           "  ON ExecutionProperty (name_id, is_custom_property, "
+           "   string_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_context_property_int "
-           "  ON ContextProperty (name, is_custom_property, int_value); "
+           "  ON ContextProperty (name_id, is_custom_property, int_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_context_property_double "
-           "  ON ContextProperty (name, is_custom_property, double_value); "
+           "  ON ContextProperty (name_id, is_custom_property, double_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS "
            "  idx_context_property_string "
-           "  ON ContextProperty (name, is_custom_property, string_value); "
+           "  ON ContextProperty (name_id, is_custom_property, string_value); "
   }
   secondary_indices {
     query: " CREATE INDEX IF NOT EXISTS idx_type_external_id "
@@ -6118,27 +8099,27 @@ R"pb(
       # upgrade Artifact table
       upgrade_queries {
         query: "ALTER TABLE Artifact "
-                "ADD COLUMN state INT,"
-                "ADD COLUMN name VARCHAR(255),"
-                "ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
-                "ADD COLUMN "
+                " ADD COLUMN state INT,"
+                " ADD COLUMN name VARCHAR(255),"
+                " ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
+                " ADD COLUMN "
                 " last_update_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
                 "ADD CONSTRAINT UniqueArtifactTypeName UNIQUE (type_id, name);"
       }
       # upgrade Execution table
       upgrade_queries {
         query: "ALTER TABLE Execution "
-            "ADD COLUMN last_known_state INT,"
-            "ADD COLUMN name VARCHAR(255),"
-            "ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
-            "ADD COLUMN last_update_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
+            " ADD COLUMN last_known_state INT,"
+            " ADD COLUMN name VARCHAR(255),"
+            " ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
+            " ADD COLUMN last_update_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
             "ADD CONSTRAINT UniqueExecutionTypeName UNIQUE (type_id, name);"
       }
       # upgrade Context table
       upgrade_queries {
         query: "ALTER TABLE Context "
-            "ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
-            "ADD COLUMN last_update_time_since_epoch BIGINT NOT NULL DEFAULT 0;"
+            " ADD COLUMN create_time_since_epoch BIGINT NOT NULL DEFAULT 0,"
+            " ADD COLUMN last_update_time_since_epoch BIGINT NOT NULL DEFAULT 0;"
       }
       # check the expected table columns are created properly.
       upgrade_verification {
@@ -6332,8 +8313,8 @@ R"pb(
       }
       upgrade_queries {
         query: "ALTER TABLE Type "
-                "ADD COLUMN version VARCHAR(255),"
-                "ADD COLUMN description TEXT;"
+                " ADD COLUMN version VARCHAR(255),"
+                " ADD COLUMN description TEXT;"
       }
       upgrade_queries {
         query: " CREATE INDEX idx_artifact_uri "
@@ -7211,76 +9192,503 @@ R"pb(
                " PRIMARY KEY (context_id, name, is_custom_property)); "
       }
       downgrade_queries {
-        query: " INSERT INTO ContextPropertyTemp "
-               " SELECT context_id, name,  is_custom_property, "
-               "        int_value, double_value, string_value, "
-               "        byte_value "
-               " FROM ContextProperty; "
+        query: " INSERT INTO ContextPropertyTemp "
+               " SELECT context_id, name,  is_custom_property, "
+               "        int_value, double_value, string_value, "
+               "        byte_value "
+               " FROM ContextProperty; "
+      }
+      downgrade_queries { query: " DROP TABLE ContextProperty; " }
+      downgrade_queries {
+        query: " ALTER TABLE ContextPropertyTemp "
+               "  RENAME TO ContextProperty; "
+      }
+      # recreate the indices that were dropped along with the old tables
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_int "
+               " ON ArtifactProperty(name, is_custom_property, "
+               " int_value) "
+               " WHERE int_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_double "
+               " ON ArtifactProperty(name, is_custom_property, "
+               " double_value) "
+               " WHERE double_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_string "
+               " ON ArtifactProperty(name, is_custom_property, "
+               " string_value) "
+               " WHERE string_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_int "
+               " ON ExecutionProperty(name, is_custom_property, "
+               " int_value) "
+               " WHERE int_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_double "
+               " ON ExecutionProperty(name, is_custom_property, "
+               " double_value) "
+               " WHERE double_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_string "
+               " ON ExecutionProperty(name, is_custom_property, "
+               " string_value) "
+               " WHERE string_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_context_property_int "
+               " ON ContextProperty(name, is_custom_property, "
+               " int_value) "
+               " WHERE int_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_context_property_double "
+               " ON ContextProperty(name, is_custom_property, "
+               " double_value) "
+               " WHERE double_value IS NOT NULL; "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS idx_context_property_string "
+               " ON ContextProperty(name, is_custom_property, "
+               " string_value) "
+               " WHERE string_value IS NOT NULL; "
+      }
+)pb",
+R"pb(
+      # verify that downgrading keeps the existing columns
+      downgrade_verification {
+        previous_version_setup_queries {
+          query: "DELETE FROM ArtifactProperty;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM ExecutionProperty;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM ContextProperty;"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ArtifactProperty (artifact_id, "
+                 "     is_custom_property, name, string_value) "
+                 " VALUES (1, false, 'p1', 'abc')"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ExecutionProperty (execution_id, "
+                 "     is_custom_property, name, int_value) "
+                 " VALUES (1, true, 'p1', 1)"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ContextProperty (context_id, "
+                 "     is_custom_property, name, double_value) "
+                 " VALUES (1, false, 'p1', 1.0)"
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ArtifactProperty'"
+                 "   AND column_name = 'proto_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ArtifactProperty'"
+                 "   AND column_name = 'bool_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ExecutionProperty'"
+                 "   AND column_name = 'proto_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ExecutionProperty'"
+                 "   AND column_name = 'bool_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ContextProperty'"
+                 "   AND column_name = 'proto_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM "
+                 "        information_schema.columns "
+                 " WHERE table_name = 'ContextProperty'"
+                 "   AND column_name = 'bool_value'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ArtifactProperty "
+                 " WHERE artifact_id = 1 AND is_custom_property = false AND "
+                 "       name = 'p1' AND string_value = 'abc'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ExecutionProperty "
+                 " WHERE execution_id = 1 AND is_custom_property = true AND "
+                 "        name = 'p1' AND int_value = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ContextProperty "
+                 " WHERE context_id = 1  AND is_custom_property = false AND "
+                 "        name = 'p1' AND double_value = 1.0; "
+        }
+      }
+    }
+  }
+)pb",
+R"pb(
+  # In v10, we added proto_value and bool_value columns to {X}Property tables
+  migration_schemes {
+    key: 10
+    value: {
+      upgrade_queries {
+        query: " ALTER TABLE ArtifactProperty "
+               " ADD COLUMN proto_value BYTEA; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ArtifactProperty "
+               " ADD COLUMN bool_value BOOLEAN; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ExecutionProperty "
+               " ADD COLUMN proto_value BYTEA; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ExecutionProperty "
+               " ADD COLUMN bool_value BOOLEAN; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ContextProperty "
+               " ADD COLUMN proto_value BYTEA;"
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ContextProperty "
+               " ADD COLUMN bool_value BOOLEAN; "
+      }
+      downgrade_queries {
+        query: " DROP TABLE IF EXISTS TypeCatalog; "
+      }
+      db_verification { total_num_indexes: 48 total_num_tables: 15 }
+    }
+  }
+  # In v11, we added the TypeCatalog table to version the types.
+  migration_schemes {
+    key: 11
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS TypeCatalog ( "
+               "   type_id INT PRIMARY KEY, "
+               "   catalog_version BIGINT NOT NULL "
+               " ); "
+      }
+      # The existing types are in the first version of the catalog.
+      upgrade_queries {
+        query: " INSERT INTO TypeCatalog(type_id, catalog_version) "
+               " SELECT id, 1 FROM Type; "
+      }
+      upgrade_queries {
+        query: " INSERT INTO TypeCatalog(type_id, catalog_version) "
+               " VALUES(0, 1); "
+      }
+      upgrade_verification {
+        previous_version_setup_queries { query: "DELETE FROM Type;" }
+        previous_version_setup_queries {
+          query: " INSERT INTO Type (id, name, type_kind) "
+                 " VALUES (1, 'artifact_type', 1), (2, 'execution_type', 0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM TypeCatalog "
+                 " WHERE type_id = 0 AND catalog_version = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 2 FROM TypeCatalog "
+                 " WHERE type_id IN (1, 2) AND catalog_version = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = (SELECT count(*) FROM Type) "
+                 " FROM TypeCatalog "
+                 " WHERE type_id <> 0 AND catalog_version = 1; "
+        }
+      }
+      # downgrade queries from version 12
+      downgrade_queries {
+        query: " ALTER TABLE ArtifactProperty ADD COLUMN name VARCHAR(255); "
+      }
+      downgrade_queries {
+        query: " UPDATE ArtifactProperty AS AP SET name = PN.name "
+               " FROM PropertyName AS PN WHERE PN.id = AP.name_id; "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE ArtifactProperty "
+               "  DROP COLUMN name_id, "
+               "  ALTER COLUMN name SET NOT NULL, "
+               "  ADD PRIMARY KEY (artifact_id, name, is_custom_property); "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_int "
+               "  ON ArtifactProperty (name, is_custom_property, int_value); "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_double "
+               "  ON ArtifactProperty (name, is_custom_property, "
+               "   double_value); "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_string "
+               "  ON ArtifactProperty (name, is_custom_property, "
+               "   string_value); "
+      }
+      downgrade_queries {
+        query: " ALTER TABLE ExecutionProperty ADD COLUMN name VARCHAR(255); "
       }
-      downgrade_queries { query: " DROP TABLE ContextProperty; " }
       downgrade_queries {
-        query: " ALTER TABLE ContextPropertyTemp "
-               "  RENAME TO ContextProperty; "
+        query: " UPDATE ExecutionProperty AS EP SET name = PN.name "
+               " FROM PropertyName AS PN WHERE PN.id = EP.name_id; "
       }
-      # recreate the indices that were dropped along with the old tables
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_int "
-               " ON ArtifactProperty(name, is_custom_property, "
-               " int_value) "
-               " WHERE int_value IS NOT NULL; "
+        query: " ALTER TABLE ExecutionProperty "
+               "  DROP COLUMN name_id, "
+               "  ALTER COLUMN name SET NOT NULL, "
+               "  ADD PRIMARY KEY (execution_id, name, is_custom_property); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_double "
-               " ON ArtifactProperty(name, is_custom_property, "
-               " double_value) "
-               " WHERE double_value IS NOT NULL; "
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_int "
+               "  ON ExecutionProperty (name, is_custom_property, int_value); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_artifact_property_string "
-               " ON ArtifactProperty(name, is_custom_property, "
-               " string_value) "
-               " WHERE string_value IS NOT NULL; "
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_double "
+               "  ON ExecutionProperty (name, is_custom_property, "
+               "   double_value); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_int "
-               " ON ExecutionProperty(name, is_custom_property, "
-               " int_value) "
-               " WHERE int_value IS NOT NULL; "
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_string "
+               "  ON ExecutionProperty (name, is_custom_property, "
+               "   string_value); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_double "
-               " ON ExecutionProperty(name, is_custom_property, "
-               " double_value) "
-               " WHERE double_value IS NOT NULL; "
+        query: " ALTER TABLE ContextProperty ADD COLUMN name VARCHAR(255); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_execution_property_string "
-               " ON ExecutionProperty(name, is_custom_property, "
-               " string_value) "
-               " WHERE string_value IS NOT NULL; "
+        query: " UPDATE ContextProperty AS CP SET name = PN.name "
+               " FROM PropertyName AS PN WHERE PN.id = CP.name_id; "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_context_property_int "
-               " ON ContextProperty(name, is_custom_property, "
-               " int_value) "
-               " WHERE int_value IS NOT NULL; "
+        query: " ALTER TABLE ContextProperty "
+               "  DROP COLUMN name_id, "
+               "  ALTER COLUMN name SET NOT NULL, "
+               "  ADD PRIMARY KEY (context_id, name, is_custom_property); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_context_property_double "
-               " ON ContextProperty(name, is_custom_property, "
-               " double_value) "
-               " WHERE double_value IS NOT NULL; "
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_int "
+               "  ON ContextProperty (name, is_custom_property, int_value); "
       }
       downgrade_queries {
-        query: " CREATE INDEX IF NOT EXISTS idx_context_property_string "
-               " ON ContextProperty(name, is_custom_property, "
-               " string_value) "
-               " WHERE string_value IS NOT NULL; "
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_double "
+               "  ON ContextProperty (name, is_custom_property, double_value); "
+      }
+      downgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_string "
+               "  ON ContextProperty (name, is_custom_property, string_value); "
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS PropertyName; " }
+      downgrade_verification {
+        previous_version_setup_queries {
+          query: "DELETE FROM ArtifactProperty;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM ExecutionProperty;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM ContextProperty;"
+        }
+        previous_version_setup_queries {
+          query: "DELETE FROM PropertyName;"
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO PropertyName (id, name) "
+                 " VALUES (1, 'p1'), (2, 'p2'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ArtifactProperty (artifact_id, "
+                 "     is_custom_property, name_id, string_value) "
+                 " VALUES (1, 0, 1, 'abc'); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ExecutionProperty (execution_id, "
+                 "     is_custom_property, name_id, int_value) "
+                 " VALUES (1, 1, 1, 1); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO ContextProperty (context_id, "
+                 "     is_custom_property, name_id, double_value) "
+                 " VALUES (1, 0, 2, 1.0); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM information_schema.tables "
+                 " WHERE table_schema = 'public' and "
+                 "       table_name = 'propertyname'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ArtifactProperty "
+                 " WHERE artifact_id = 1 AND is_custom_property = 0 AND "
+                 "       name = 'p1' AND string_value = 'abc'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ExecutionProperty "
+                 " WHERE execution_id = 1 AND is_custom_property = 1 AND "
+                 "       name = 'p1' AND int_value = 1; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ContextProperty "
+                 " WHERE context_id = 1 AND is_custom_property = 0 AND "
+                 "       name = 'p2' AND double_value = 1.0; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'artifactproperty' AND "
+                 "       indexname LIKE 'idx_artifact_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'executionproperty' AND "
+                 "       indexname LIKE 'idx_execution_property_%'; "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'contextproperty' AND "
+                 "       indexname LIKE 'idx_context_property_%'; "
+        }
       }
+      db_verification { total_num_indexes: 49 total_num_tables: 16 }
+    }
+  }
 )pb",
 R"pb(
-      # verify that downgrading keeps the existing columns
-      downgrade_verification {
+  # In v12, we interned the property names into the PropertyName table, which
+  # the {X}Property tables and their indices refer to by id.
+  migration_schemes {
+    key: 12
+    value: {
+      upgrade_queries {
+        query: " CREATE TABLE IF NOT EXISTS PropertyName ( "
+               "   id SERIAL PRIMARY KEY, "
+               "   name VARCHAR(255) NOT NULL UNIQUE "
+               " ); "
+      }
+      upgrade_queries {
+        query: " INSERT INTO PropertyName(name) "
+               " SELECT name FROM ArtifactProperty "
+               " UNION SELECT name FROM ExecutionProperty "
+               " UNION SELECT name FROM ContextProperty; "
+      }
+      # dropping the name column drops the primary keys and the indices on it.
+      upgrade_queries {
+        query: " ALTER TABLE ArtifactProperty ADD COLUMN name_id INT; "
+      }
+      upgrade_queries {
+        query: " UPDATE ArtifactProperty AS AP SET name_id = PN.id "
+               " FROM PropertyName AS PN WHERE PN.name = AP.name; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ArtifactProperty "
+               "  DROP COLUMN name, "
+               "  ALTER COLUMN name_id SET NOT NULL, "
+               "  ADD PRIMARY KEY (artifact_id, name_id, is_custom_property); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_int "
+               "  ON ArtifactProperty (name_id, is_custom_property, "
+               "   int_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_double "
+               "  ON ArtifactProperty (name_id, is_custom_property, "
+               "   double_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_artifact_property_string "
+               "  ON ArtifactProperty (name_id, is_custom_property, "
+               "   string_value); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ExecutionProperty ADD COLUMN name_id INT; "
+      }
+      upgrade_queries {
+        query: " UPDATE ExecutionProperty AS EP SET name_id = PN.id "
+               " FROM PropertyName AS PN WHERE PN.name = EP.name; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ExecutionProperty "
+               "  DROP COLUMN name, "
+               "  ALTER COLUMN name_id SET NOT NULL, "
+               "  ADD PRIMARY KEY (execution_id, name_id, is_custom_property); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_int "
+               "  ON ExecutionProperty (name_id, is_custom_property, "
+               "   int_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_double "
+               "  ON ExecutionProperty (name_id, is_custom_property, "
+               "   double_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_execution_property_string "
+               "  ON ExecutionProperty (name_id, is_custom_property, "
+               "   string_value); "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ContextProperty ADD COLUMN name_id INT; "
+      }
+      upgrade_queries {
+        query: " UPDATE ContextProperty AS CP SET name_id = PN.id "
+               " FROM PropertyName AS PN WHERE PN.name = CP.name; "
+      }
+      upgrade_queries {
+        query: " ALTER TABLE ContextProperty "
+               "  DROP COLUMN name, "
+               "  ALTER COLUMN name_id SET NOT NULL, "
+               "  ADD PRIMARY KEY (context_id, name_id, is_custom_property); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_int "
+               "  ON ContextProperty (name_id, is_custom_property, int_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_double "
+               "  ON ContextProperty (name_id, is_custom_property, "
+               "   double_value); "
+      }
+      upgrade_queries {
+        query: " CREATE INDEX IF NOT EXISTS "
+               "  idx_context_property_string "
+               "  ON ContextProperty (name_id, is_custom_property, "
+               "   string_value); "
+      }
+      upgrade_verification {
         previous_version_setup_queries {
           query: "DELETE FROM ArtifactProperty;"
         }
@@ -7293,103 +9701,157 @@ R"pb(
         previous_version_setup_queries {
           query: " INSERT INTO ArtifactProperty (artifact_id, "
                  "     is_custom_property, name, string_value) "
-                 " VALUES (1, false, 'p1', 'abc')"
+                 " VALUES (1, 0, 'p1', 'abc'); "
         }
         previous_version_setup_queries {
           query: " INSERT INTO ExecutionProperty (execution_id, "
                  "     is_custom_property, name, int_value) "
-                 " VALUES (1, true, 'p1', 1)"
+                 " VALUES (1, 1, 'p1', 1); "
         }
         previous_version_setup_queries {
           query: " INSERT INTO ContextProperty (context_id, "
                  "     is_custom_property, name, double_value) "
-                 " VALUES (1, false, 'p1', 1.0)"
+                 " VALUES (1, 0, 'p2', 1.0); "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ArtifactProperty'"
-                 "   AND column_name = 'proto_value'; "
-        }
-        post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ArtifactProperty'"
-                 "   AND column_name = 'bool_value'; "
+          query: " SELECT count(*) = 2 FROM PropertyName; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ExecutionProperty'"
-                 "   AND column_name = 'proto_value'; "
+          query: " SELECT count(*) = 1 "
+                 " FROM ArtifactProperty AS AP "
+                 " JOIN PropertyName AS PN ON (PN.id = AP.name_id) "
+                 " WHERE AP.artifact_id = 1 AND "
+                 "       AP.is_custom_property = 0 AND "
+                 "       PN.name = 'p1' AND AP.string_value = 'abc'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ExecutionProperty'"
-                 "   AND column_name = 'bool_value'; "
+          query: " SELECT count(*) = 1 "
+                 " FROM ExecutionProperty AS EP "
+                 " JOIN PropertyName AS PN ON (PN.id = EP.name_id) "
+                 " WHERE EP.execution_id = 1 AND "
+                 "       EP.is_custom_property = 1 AND "
+                 "       PN.name = 'p1' AND EP.int_value = 1; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ContextProperty'"
-                 "   AND column_name = 'proto_value'; "
+          query: " SELECT count(*) = 1 "
+                 " FROM ContextProperty AS CP "
+                 " JOIN PropertyName AS PN ON (PN.id = CP.name_id) "
+                 " WHERE CP.context_id = 1 AND "
+                 "       CP.is_custom_property = 0 AND "
+                 "       PN.name = 'p2' AND CP.double_value = 1.0; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 0 FROM "
-                 "        information_schema.columns "
-                 " WHERE table_name = 'ContextProperty'"
-                 "   AND column_name = 'bool_value'; "
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'artifactproperty' AND "
+                 "       indexname LIKE 'idx_artifact_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ArtifactProperty "
-                 " WHERE artifact_id = 1 AND is_custom_property = false AND "
-                 "       name = 'p1' AND string_value = 'abc'; "
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'executionproperty' AND "
+                 "       indexname LIKE 'idx_execution_property_%'; "
         }
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ExecutionProperty "
-                 " WHERE execution_id = 1 AND is_custom_property = true AND "
-                 "        name = 'p1' AND int_value = 1; "
+          query: " SELECT count(*) = 3 FROM pg_indexes "
+                 " WHERE tablename = 'contextproperty' AND "
+                 "       indexname LIKE 'idx_context_property_%'; "
         }
+      }
+      downgrade_queries { query: " DROP TABLE IF EXISTS WriteEpoch; " }
+      downgrade_verification {
         post_migration_verification_queries {
-          query: " SELECT count(*) = 1 FROM ContextProperty "
-                 " WHERE context_id = 1  AND is_custom_property = false AND "
-                 "        name = 'p1' AND double_value = 1.0; "
+          query: " SELECT count(*) = 0 FROM information_schema.tables "
+                 " WHERE table_schema = 'public' and "
+                 "       table_name = 'writeepoch'; "
         }
       }
+      db_verification { total_num_indexes: 51 total_num_tables: 17 }
     }
   }
 )pb",
 R"pb(
-  # In v10, we added proto_value and bool_value columns to {X}Property tables
+  # In v13, we added the WriteEpoch table. It counts the committed writes of
+  # each node kind, so that servers can tell whether their cached list results
+  # are stale.
   migration_schemes {
-    key: 10
+    key: 13
     value: {
       upgrade_queries {
-        query: " ALTER TABLE ArtifactProperty "
-               " ADD COLUMN proto_value BYTEA; "
+        query: " CREATE TABLE IF NOT EXISTS WriteEpoch ( "
+               "   type_kind INTEGER PRIMARY KEY, "
+               "   epoch BIGINT NOT NULL "
+               " ); "
       }
       upgrade_queries {
-        query: " ALTER TABLE ArtifactProperty "
-               " ADD COLUMN bool_value BOOLEAN; "
+        query: " INSERT INTO WriteEpoch(type_kind, epoch) "
+               " VALUES(0, 0), (1, 0), (2, 0); "
       }
-      upgrade_queries {
-        query: " ALTER TABLE ExecutionProperty "
-               " ADD COLUMN proto_value BYTEA; "
+      upgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 3 FROM WriteEpoch "
+                 " WHERE type_kind IN (0, 1, 2) AND epoch = 0; "
+        }
       }
-      upgrade_queries {
-        query: " ALTER TABLE ExecutionProperty "
-               " ADD COLUMN bool_value BOOLEAN; "
+      downgrade_queries { query: " DROP TABLE IF EXISTS ContextSummary; " }
+      downgrade_verification {
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 0 FROM information_schema.tables "
+                 " WHERE table_schema = 'public' and "
+                 "       table_name = 'contextsummary'; "
+        }
       }
+      db_verification { total_num_indexes: 52 total_num_tables: 18 }
+    }
+  }
+)pb",
+R"pb(
+  # In v14, we added the ContextSummary table. It counts the executions and
+  # artifacts of each type and state in a context, so that the summaries of
+  # contexts are read without listing their nodes.
+  migration_schemes {
+    key: 14
+    value: {
       upgrade_queries {
-        query: " ALTER TABLE ContextProperty "
-               " ADD COLUMN proto_value BYTEA;"
+        query: " CREATE TABLE IF NOT EXISTS ContextSummary ( "
+               "   context_id INT NOT NULL, "
+               "   type_kind INT NOT NULL, "
+               "   type_id INT NOT NULL, "
+               "   state INT NOT NULL, "
+               "   num_nodes BIGINT NOT NULL, "
+               "   PRIMARY KEY (context_id, type_kind, type_id, state) "
+               " ); "
       }
       upgrade_queries {
-        query: " ALTER TABLE ContextProperty "
-               " ADD COLUMN bool_value BOOLEAN; "
+        query: " INSERT INTO ContextSummary( "
+               "   context_id, type_kind, type_id, state, num_nodes) "
+               " SELECT A.context_id, 0, E.type_id, "
+               "        COALESCE(E.last_known_state, 0), COUNT(*) "
+               " FROM Association AS A "
+               "      JOIN Execution AS E ON A.execution_id = E.id "
+               " GROUP BY A.context_id, E.type_id, "
+               "          COALESCE(E.last_known_state, 0) "
+               " UNION ALL "
+               " SELECT T.context_id, 1, R.type_id, "
+               "        COALESCE(R.state, 0), COUNT(*) "
+               " FROM Attribution AS T "
+               "      JOIN Artifact AS R ON T.artifact_id = R.id "
+               " GROUP BY T.context_id, R.type_id, COALESCE(R.state, 0); "
       }
-      db_verification { total_num_indexes: 48 total_num_tables: 15 }
+      upgrade_verification {
+        previous_version_setup_queries {
+          query: " INSERT INTO Execution(id, type_id, last_known_state) "
+                 " VALUES (1, 2, 3); "
+        }
+        previous_version_setup_queries {
+          query: " INSERT INTO Association(context_id, execution_id) "
+                 " VALUES (4, 1); "
+        }
+        post_migration_verification_queries {
+          query: " SELECT count(*) = 1 FROM ContextSummary "
+                 " WHERE context_id = 4 AND type_kind = 0 AND "
+                 "       type_id = 2 AND state = 3 AND num_nodes = 1; "
+        }
+      }
+      db_verification { total_num_indexes: 53 total_num_tables: 19 }
     }
   }
 )pb");